@@ -125,11 +125,14 @@ namespace sdbus {
          *
          * This function must be called in the destructor of the final adaptor class that implements AdaptorInterfaces.
          *
+         * Interfaces with resources of their own (e.g. DirectChannel_adaptor) release them here as well.
+         *
          * For more information, see underlying @ref IObject::unregister()
          */
         void unregisterAdaptor()
         {
             getObject().unregister();
+            (unregisterInterface<_Interfaces>(), ...);
         }
 
         /*!
@@ -145,6 +148,14 @@ namespace sdbus {
         AdaptorInterfaces(AdaptorInterfaces&&) = delete;
         AdaptorInterfaces& operator=(AdaptorInterfaces&&) = delete;
         ~AdaptorInterfaces() = default;
+
+    private:
+        template <typename _Interface>
+        void unregisterInterface()
+        {
+            if constexpr (requires { _Interface::unregisterAdaptor(); })
+                _Interface::unregisterAdaptor();
+        }
     };
 
 }
@@ -0,0 +1,190 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file AsioEventLoopAdapter.h
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_ASIOEVENTLOOPADAPTER_H_
+#define SDBUS_CXX_ASIOEVENTLOOPADAPTER_H_
+
+#include <sdbus-c++/IConnection.h>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/posix/stream_descriptor.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <poll.h>
+
+namespace sdbus {
+
+    /********************************************//**
+     * @class AsioEventLoopAdapter
+     *
+     * Drives a bus connection from a Boost.Asio io_context, without any extra
+     * thread. The bus fd and the event fd of the connection are waited for
+     * through posix::stream_descriptor objects, and the connection timeout
+     * through a steady_timer. Pending events are processed in bounded batches,
+     * so that a busy connection doesn't starve other handlers of the io_context.
+     *
+     * The connection must not run its own internal event loop, nor be attached
+     * to another event loop, while it is driven by the adapter. The adapter must
+     * be destroyed before the connection; it may be destroyed from within
+     * a callback handler of the connection.
+     *
+     * The adapter is header-only, so this header is not part of sdbus-c++.h and
+     * requires Boost.Asio headers only when included. The adapter shall be
+     * created, used and destroyed in the thread running the io_context. Errors
+     * in processing the connection are thrown as sdbus::Error from io_context::run().
+     *
+     ***********************************************/
+    class AsioEventLoopAdapter
+    {
+    public:
+        static constexpr std::size_t DEFAULT_MAX_EVENTS_PER_BATCH{64};
+        static constexpr std::chrono::microseconds DEFAULT_MAX_BATCH_DURATION{10'000};
+
+        /*!
+         * @brief Starts driving the bus connection from the io_context
+         *
+         * @param[in] ioContext io_context that drives the connection
+         * @param[in] connection Bus connection to be driven, which must outlive the adapter
+         * @param[in] maxEventsPerBatch Maximum number of events processed before other handlers get their turn
+         * @param[in] maxBatchDuration Maximum time spent processing events before other handlers get their turn
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        AsioEventLoopAdapter( boost::asio::io_context& ioContext
+                            , IConnection& connection
+                            , std::size_t maxEventsPerBatch = DEFAULT_MAX_EVENTS_PER_BATCH
+                            , std::chrono::microseconds maxBatchDuration = DEFAULT_MAX_BATCH_DURATION )
+            : state_(std::make_shared<State>(ioContext, connection, maxEventsPerBatch, maxBatchDuration))
+        {
+            state_->arm();
+        }
+
+        AsioEventLoopAdapter(const AsioEventLoopAdapter&) = delete;
+        AsioEventLoopAdapter& operator=(const AsioEventLoopAdapter&) = delete;
+
+        ~AsioEventLoopAdapter()
+        {
+            state_->stop();
+        }
+
+    private:
+        // Completion handlers may run after the adapter is gone, so they keep the state alive on their own
+        struct State : std::enable_shared_from_this<State>
+        {
+            State( boost::asio::io_context& ioContext
+                 , IConnection& connection
+                 , std::size_t maxEventsPerBatch
+                 , std::chrono::microseconds maxBatchDuration )
+                : connection(connection)
+                , maxEventsPerBatch(maxEventsPerBatch)
+                , maxBatchDuration(maxBatchDuration)
+                , busFd(ioContext)
+                , eventFd(ioContext)
+                , timer(ioContext)
+            {
+                const auto pollData = connection.getEventLoopPollData();
+                busFd.assign(pollData.fd);
+                eventFd.assign(pollData.eventFd);
+            }
+
+            ~State()
+            {
+                stop();
+            }
+
+            void arm()
+            {
+                // Waits of the previous round that have completed in the meantime are ignored by their generation
+                busFd.cancel();
+                eventFd.cancel();
+                timer.cancel();
+                const auto currentGeneration = ++generation;
+
+                const auto pollData = connection.getEventLoopPollData();
+                auto onEvent = [self = shared_from_this(), currentGeneration](const boost::system::error_code& error)
+                {
+                    if (error != boost::asio::error::operation_aborted && self->generation == currentGeneration)
+                        self->process();
+                };
+
+                if (pollData.events & POLLIN)
+                    busFd.async_wait(boost::asio::posix::stream_descriptor::wait_read, onEvent);
+                if (pollData.events & POLLOUT)
+                    busFd.async_wait(boost::asio::posix::stream_descriptor::wait_write, onEvent);
+                eventFd.async_wait(boost::asio::posix::stream_descriptor::wait_read, onEvent);
+
+                // Timeout is zero if there are events left pending, e.g. by an exhausted batch
+                const auto timeout = pollData.getRelativeTimeout();
+                if (timeout != std::chrono::microseconds::max())
+                {
+                    timer.expires_after(timeout);
+                    timer.async_wait(std::move(onEvent));
+                }
+            }
+
+            void process()
+            {
+                if (stopped)
+                    return;
+
+                connection.processPendingEvents(maxEventsPerBatch, maxBatchDuration);
+
+                // The adapter may have been destroyed by a handler of the connection
+                if (!stopped)
+                    arm();
+            }
+
+            void stop()
+            {
+                if (stopped)
+                    return;
+                stopped = true;
+
+                // The descriptors are owned by the connection, so they are released instead of being closed
+                timer.cancel();
+                (void)busFd.release();
+                (void)eventFd.release();
+            }
+
+            IConnection& connection;
+            std::size_t maxEventsPerBatch;
+            std::chrono::microseconds maxBatchDuration;
+            boost::asio::posix::stream_descriptor busFd;
+            boost::asio::posix::stream_descriptor eventFd;
+            boost::asio::steady_timer timer;
+            std::uint64_t generation{};
+            bool stopped{};
+        };
+
+        std::shared_ptr<State> state_;
+    };
+
+}
+
+#endif /* SDBUS_CXX_ASIOEVENTLOOPADAPTER_H_ */
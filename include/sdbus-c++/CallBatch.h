@@ -0,0 +1,209 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file CallBatch.h
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_CALLBATCH_H_
+#define SDBUS_CXX_CALLBATCH_H_
+
+#include <sdbus-c++/Error.h>
+#include <sdbus-c++/Message.h>
+#include <sdbus-c++/TypeTraits.h>
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <vector>
+
+// Forward declarations
+namespace sdbus {
+    class CallBatchAwaitable;
+}
+
+namespace sdbus {
+
+    /********************************************//**
+     * @class CallBatch
+     *
+     * Batch of asynchronous D-Bus method calls, possibly to different objects or services,
+     * that are sent out together and complete together. All calls of the batch are made
+     * under one acquisition of the connection lock, with one wake-up of the event loop at most,
+     * so their requests are pipelined on the bus and the whole batch takes about one round trip.
+     * The batch completes once every call has got its reply, error, or timeout, and delivers
+     * the outcomes of all calls at once, in the order the calls were added, to a callback,
+     * a future, or a C++20 coroutine, e.g.:
+     *
+     * @code
+     * sdbus::CallBatch batch;
+     * batch.add(proxy1->createMethodCall(interfaceName, methodName))
+     *      .add(proxy2->createMethodCall(interfaceName, methodName), 500ms);
+     * auto replies = batch.send(sdbus::with_future).get();
+     * @endcode
+     *
+     * All calls of a batch must be made on one connection. Sending empties the batch, so it
+     * can be filled and sent again. The outcomes are delivered in the event loop thread, unless
+     * the batch completes right away (e.g. it's empty, or none of its calls could be made), in
+     * which case they are delivered in the sending thread before send() returns.
+     *
+     ***********************************************/
+    class CallBatch
+    {
+    public:
+        // Outcomes of the calls, in the order of their addition to the batch
+        using Replies = std::vector<Expected<MethodReply>>;
+        using replies_handler = std::function<void(Replies replies)>;
+
+        CallBatch() = default;
+        CallBatch(CallBatch&&) noexcept = default;
+        CallBatch& operator=(CallBatch&&) noexcept = default;
+
+        /*!
+         * @brief Adds a method call to the batch
+         *
+         * @param[in] call Method call message, with its arguments already serialized
+         * @param[in] timeout Method call timeout (in microseconds); 0 means the default timeout of the connection
+         * @return Reference to the batch, for chaining
+         *
+         * @throws sdbus::Error in case the call is invalid, doesn't expect a reply,
+         *         or is to be made on another connection than the calls added before
+         */
+        CallBatch& add(MethodCall call, uint64_t timeout = 0);
+
+        /*!
+         * @copydoc CallBatch::add(MethodCall,uint64_t)
+         */
+        template <typename _Rep, typename _Period>
+        CallBatch& add(MethodCall call, const std::chrono::duration<_Rep, _Period>& timeout);
+
+        [[nodiscard]] std::size_t size() const noexcept;
+        [[nodiscard]] bool empty() const noexcept;
+
+        /*!
+         * @brief Sends out the calls of the batch
+         *
+         * @param[in] callback Handler called with the outcomes of all calls
+         *
+         * The batch is floating, i.e. it lives until it completes. The connection must
+         * therefore have an event loop running, and must outlive the batch.
+         *
+         * A call that couldn't be made is completed with the error of making it,
+         * as are all calls after it in the batch.
+         *
+         * @throws sdbus::Error in case the deadline of the current DeadlineScope has passed already
+         */
+        void send(replies_handler callback);
+
+        /*!
+         * @brief Sends out the calls of the batch
+         *
+         * @param[in] callback Handler called with the outcomes of all calls
+         * @return RAII-style slot handle representing the ownership of the batch
+         *
+         * This method operates the same as the floating variant above, just that destroying
+         * the returned slot before the batch completes cancels all its pending calls, and
+         * the callback is not called. This shall not happen concurrently with replies being
+         * delivered, so one should destroy the slot only from within the event loop thread.
+         * The slot must not outlive the connection.
+         *
+         * @throws sdbus::Error in case the deadline of the current DeadlineScope has passed already
+         */
+        [[nodiscard]] Slot send(replies_handler callback, return_slot_t);
+
+        /*!
+         * @brief Sends out the calls of the batch
+         *
+         * @return Future object providing the outcomes of all calls
+         *
+         * @throws sdbus::Error in case the deadline of the current DeadlineScope has passed already
+         */
+        [[nodiscard]] std::future<Replies> send(with_future_t);
+
+        /*!
+         * @brief Sends out the calls of the batch once awaited
+         *
+         * @return Awaitable providing the outcomes of all calls to a C++20 coroutine
+         *
+         * The calls are sent out when the coroutine gets suspended, and the coroutine is resumed
+         * in the event loop thread.
+         */
+        [[nodiscard]] CallBatchAwaitable send(with_awaitable_t);
+
+    private:
+        std::vector<MethodCall> calls_;
+        std::vector<uint64_t> timeouts_;
+    };
+
+    /********************************************//**
+     * @class CallBatchAwaitable
+     *
+     * CallBatchAwaitable makes the outcomes of a batch of method calls awaitable from
+     * within a C++20 coroutine. It is obtained through CallBatch::send() with the
+     * `with_awaitable` tag, e.g.:
+     *
+     * @code
+     * auto replies = co_await batch.send(sdbus::with_awaitable);
+     * @endcode
+     *
+     * Destroying the awaitable (i.e., destroying the suspended coroutine) cancels the pending
+     * calls of the batch, so one should destroy suspended coroutines only from within the event loop thread.
+     *
+     ***********************************************/
+    class CallBatchAwaitable
+    {
+    public:
+        CallBatchAwaitable(const CallBatchAwaitable&) = delete;
+        CallBatchAwaitable& operator=(const CallBatchAwaitable&) = delete;
+
+        bool await_ready() const noexcept;
+        bool await_suspend(std::coroutine_handle<> handle);
+        CallBatch::Replies await_resume();
+
+    private:
+        friend CallBatch;
+        explicit CallBatchAwaitable(CallBatch batch);
+
+    private:
+        CallBatch batch_;
+        std::coroutine_handle<> handle_;
+        Slot batchSlot_;
+        std::atomic<bool> ready_{}; // Whichever of batch completion and coroutine suspension comes second resumes the coroutine
+        CallBatch::Replies replies_;
+    };
+
+    // Out-of-line member definitions
+
+    template <typename _Rep, typename _Period>
+    inline CallBatch& CallBatch::add(MethodCall call, const std::chrono::duration<_Rep, _Period>& timeout)
+    {
+        auto microsecs = std::chrono::duration_cast<std::chrono::microseconds>(timeout);
+        return add(std::move(call), microsecs.count());
+    }
+
+}
+
+#endif /* SDBUS_CXX_CALLBATCH_H_ */
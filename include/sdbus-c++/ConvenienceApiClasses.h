@@ -27,6 +27,7 @@
 #ifndef SDBUS_CXX_CONVENIENCEAPICLASSES_H_
 #define SDBUS_CXX_CONVENIENCEAPICLASSES_H_
 
+#include <sdbus-c++/Error.h>
 #include <sdbus-c++/Message.h>
 #include <sdbus-c++/TypeTraits.h>
 #include <sdbus-c++/Types.h>
@@ -36,6 +37,7 @@
 #include <cstdint>
 #include <future>
 #include <map>
+#include <new>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -46,6 +48,7 @@ namespace sdbus {
     class IProxy;
     class Error;
     class PendingAsyncCall;
+    template <typename... _Results> class AsyncCallAwaitable;
 }
 
 namespace sdbus {
@@ -99,8 +102,16 @@ namespace sdbus {
         MethodInvoker& withTimeout(uint64_t usec);
         template <typename _Rep, typename _Period>
         MethodInvoker& withTimeout(const std::chrono::duration<_Rep, _Period>& timeout);
+        // Serves the results from the proxy's method result cache, see IProxy::callMethod(). Must precede withArguments(),
+        // otherwise sdbus::Error is thrown, since the arguments make up the cache key.
+        MethodInvoker& cacheResults();
+        MethodInvoker& cacheResultsFor(uint64_t usec);
+        template <typename _Rep, typename _Period>
+        MethodInvoker& cacheResultsFor(const std::chrono::duration<_Rep, _Period>& ttl);
         template <typename... _Args> MethodInvoker& withArguments(_Args&&... args);
         template <typename... _Args> void storeResultsTo(_Args&... args);
+        // Reports D-Bus errors of the call by return value instead of throwing
+        template <typename... _Args> [[nodiscard]] Expected<void> storeResultsTo(std::nothrow_t, _Args&... args);
         void dontExpectReply();
 
         MethodInvoker(MethodInvoker&& other) = default;
@@ -116,6 +127,9 @@ namespace sdbus {
         const char* methodName_;
         uint64_t timeout_{};
         MethodCall method_;
+        uint64_t cacheTtl_{}; // Zero if the results are not cached
+        PlainMessage arguments_; // Arguments of a call with cached results, which make up the cache key
+        bool hasArguments_{};
         int exceptions_{}; // Number of active exceptions when MethodInvoker is constructed
         bool methodCalled_{};
     };
@@ -136,6 +150,8 @@ namespace sdbus {
         //                      or std::future<T> for single D-Bus method return value
         //                      or std::future<std::tuple<...>> for multiple method return values
         template <typename... _Args> std::future<future_return_t<_Args...>> getResultAsFuture();
+        // Returned awaitable yields void, T or std::tuple<...> on co_await, just like the future above
+        template <typename... _Args> [[nodiscard]] AsyncCallAwaitable<_Args...> getResultAsAwaitable();
 
     private:
         friend IProxy;
@@ -156,6 +172,10 @@ namespace sdbus {
         SignalSubscriber& onInterface(const InterfaceName& interfaceName);
         SignalSubscriber& onInterface(const std::string& interfaceName);
         SignalSubscriber& onInterface(const char* interfaceName);
+        template <uint8_t _Index> SignalSubscriber& withArgFilter(std::string value);
+        template <uint8_t _Index> SignalSubscriber& withArgPathFilter(std::string value);
+        SignalSubscriber& withArg0NamespaceFilter(std::string value);
+        SignalSubscriber& withReusableArguments();
         template <typename _Function> void call(_Function&& callback);
         template <typename _Function> [[nodiscard]] Slot call(_Function&& callback, return_slot_t);
 
@@ -164,11 +184,14 @@ namespace sdbus {
         SignalSubscriber(IProxy& proxy, const SignalName& signalName);
         SignalSubscriber(IProxy& proxy, const char* signalName);
         template <typename _Function> signal_handler makeSignalHandler(_Function&& callback);
+        template <typename _Function, typename _Args> static void invokeSignalHandler(_Function& callback, Signal& signal, _Args& signalArgs);
 
     private:
         IProxy& proxy_;
         const char* signalName_;
         const char* interfaceName_{};
+        std::vector<SignalArgFilter> argFilters_;
+        bool reuseArguments_{false};
     };
 
     class PropertyGetter
@@ -194,6 +217,7 @@ namespace sdbus {
         template <typename _Function> PendingAsyncCall uponReplyInvoke(_Function&& callback);
         template <typename _Function> [[nodiscard]] Slot uponReplyInvoke(_Function&& callback, return_slot_t);
         std::future<Variant> getResultAsFuture();
+        [[nodiscard]] AsyncCallAwaitable<Variant> getResultAsAwaitable();
 
     private:
         friend IProxy;
@@ -237,6 +261,7 @@ namespace sdbus {
         template <typename _Function> PendingAsyncCall uponReplyInvoke(_Function&& callback);
         template <typename _Function> [[nodiscard]] Slot uponReplyInvoke(_Function&& callback, return_slot_t);
         std::future<void> getResultAsFuture();
+        [[nodiscard]] AsyncCallAwaitable<> getResultAsAwaitable();
 
     private:
         friend IProxy;
@@ -255,6 +280,9 @@ namespace sdbus {
     {
     public:
         std::map<PropertyName, Variant> onInterface(std::string_view interfaceName);
+        // Decodes the properties right into the members of a struct registered through SDBUSCPP_REGISTER_STRUCT
+        template <typename _Struct> _Struct onInterface(std::string_view interfaceName);
+        template <typename _Struct> void storeResultsTo(std::string_view interfaceName, _Struct& result);
 
     private:
         friend IProxy;
@@ -273,6 +301,7 @@ namespace sdbus {
         template <typename _Function> PendingAsyncCall uponReplyInvoke(_Function&& callback);
         template <typename _Function> [[nodiscard]] Slot uponReplyInvoke(_Function&& callback, return_slot_t);
         std::future<std::map<PropertyName, Variant>> getResultAsFuture();
+        [[nodiscard]] AsyncCallAwaitable<std::map<PropertyName, Variant>> getResultAsAwaitable();
 
     private:
         friend IProxy;
@@ -37,6 +37,7 @@
 
 #include <cassert>
 #include <exception>
+#include <limits>
 #include <string>
 #include <tuple>
 #include <type_traits>
@@ -164,6 +165,12 @@ namespace sdbus {
         // Therefore, we can allow callMethod() to throw even if we are in the destructor.
         // Bottomline is, to be on the safe side, the caller must take care of catching and reacting
         // to the exception thrown from here if the caller is a destructor itself.
+        if (cacheTtl_ != 0)
+        {
+            (void)proxy_.callMethodWithCachedResults(method_, arguments_, timeout_, cacheTtl_).value();
+            return;
+        }
+
         proxy_.callMethod(method_, timeout_);
     }
 
@@ -198,12 +205,42 @@ namespace sdbus {
         return withTimeout(microsecs.count());
     }
 
+    inline MethodInvoker& MethodInvoker::cacheResults()
+    {
+        return cacheResultsFor(std::numeric_limits<uint64_t>::max());
+    }
+
+    inline MethodInvoker& MethodInvoker::cacheResultsFor(uint64_t usec)
+    {
+        assert(method_.isValid()); // onInterface() must be placed/called prior to this function
+        // Arguments already serialized into the call would not make it into the cache key
+        SDBUS_THROW_ERROR_IF(hasArguments_ && usec != 0, "Failed to cache method results: cacheResults() must precede withArguments()", EINVAL);
+
+        cacheTtl_ = usec;
+        if (cacheTtl_ != 0 && !arguments_.isValid())
+            arguments_ = createPlainMessage();
+
+        return *this;
+    }
+
+    template <typename _Rep, typename _Period>
+    inline MethodInvoker& MethodInvoker::cacheResultsFor(const std::chrono::duration<_Rep, _Period>& ttl)
+    {
+        auto microsecs = std::chrono::duration_cast<std::chrono::microseconds>(ttl);
+        return cacheResultsFor(microsecs.count());
+    }
+
     template <typename... _Args>
     inline MethodInvoker& MethodInvoker::withArguments(_Args&&... args)
     {
         assert(method_.isValid()); // onInterface() must be placed/called prior to this function
 
-        detail::serialize_pack(method_, std::forward<_Args>(args)...);
+        // Arguments of calls with cached results are serialized aside, and copied into the call only on a cache miss
+        if (cacheTtl_ != 0)
+            detail::serialize_pack(arguments_, std::forward<_Args>(args)...);
+        else
+            detail::serialize_pack(method_, std::forward<_Args>(args)...);
+        hasArguments_ = true;
 
         return *this;
     }
@@ -213,12 +250,50 @@ namespace sdbus {
     {
         assert(method_.isValid()); // onInterface() must be placed/called prior to this function
 
+        if (cacheTtl_ != 0)
+        {
+            auto results = proxy_.callMethodWithCachedResults(method_, arguments_, timeout_, cacheTtl_).value();
+            methodCalled_ = true;
+
+            detail::deserialize_pack(results, args...);
+            return;
+        }
+
         auto reply = proxy_.callMethod(method_, timeout_);
         methodCalled_ = true;
 
         detail::deserialize_pack(reply, args...);
     }
 
+    template <typename... _Args>
+    inline Expected<void> MethodInvoker::storeResultsTo(std::nothrow_t, _Args&... args)
+    {
+        assert(method_.isValid()); // onInterface() must be placed/called prior to this function
+
+        if (cacheTtl_ != 0)
+        {
+            auto results = proxy_.callMethodWithCachedResults(method_, arguments_, timeout_, cacheTtl_);
+            methodCalled_ = true;
+
+            if (!results)
+                return std::move(results).error();
+
+            detail::deserialize_pack(*results, args...);
+
+            return {};
+        }
+
+        auto reply = proxy_.callMethod(method_, timeout_, std::nothrow);
+        methodCalled_ = true;
+
+        if (!reply)
+            return std::move(reply).error();
+
+        detail::deserialize_pack(*reply, args...);
+
+        return {};
+    }
+
     inline void MethodInvoker::dontExpectReply()
     {
         assert(method_.isValid()); // onInterface() must be placed/called prior to this function
@@ -354,6 +429,90 @@ namespace sdbus {
         return future;
     }
 
+    template <typename... _Args>
+    AsyncCallAwaitable<_Args...> AsyncMethodInvoker::getResultAsAwaitable()
+    {
+        assert(method_.isValid()); // onInterface() must be placed/called prior to this function
+
+        // The call itself is issued only once the awaiting coroutine gets suspended
+        return AsyncCallAwaitable<_Args...>(proxy_, std::move(method_), timeout_);
+    }
+
+    /*** ------------------ ***/
+    /*** AsyncCallAwaitable ***/
+    /*** ------------------ ***/
+
+    template <typename... _Results>
+    inline AsyncCallAwaitable<_Results...>::AsyncCallAwaitable(IProxy& proxy, MethodCall method, uint64_t timeout)
+        : proxy_(proxy)
+        , method_(std::move(method))
+        , timeout_(timeout)
+    {
+    }
+
+    template <typename... _Results>
+    inline AsyncCallAwaitable<_Results...>::~AsyncCallAwaitable()
+    {
+        // The coroutine is being destroyed while still waiting for the reply
+        if (handle_ && !ready_.load(std::memory_order_acquire))
+            pendingCall_.cancel();
+    }
+
+    template <typename... _Results>
+    inline bool AsyncCallAwaitable<_Results...>::await_ready() const noexcept
+    {
+        return false;
+    }
+
+    template <typename... _Results>
+    inline bool AsyncCallAwaitable<_Results...>::await_suspend(std::coroutine_handle<> handle)
+    {
+        handle_ = handle;
+
+        // Capturing just `this` keeps the handler within the callback's inline storage
+        pendingCall_ = proxy_.callMethodAsync( method_
+                                             , [this](MethodReply reply, std::optional<Error> error){ onReply(std::move(reply), std::move(error)); }
+                                             , timeout_ );
+
+        // The reply may have been delivered by the event loop thread already. If so, don't suspend at all.
+        return !ready_.exchange(true, std::memory_order_acq_rel);
+    }
+
+    template <typename... _Results>
+    inline void AsyncCallAwaitable<_Results...>::onReply(MethodReply reply, std::optional<Error> error)
+    {
+        if (!error)
+        {
+            try
+            {
+                reply >> results_;
+            }
+            catch (const Error& e)
+            {
+                // Deserialization errors are delivered to the awaiting coroutine, just like call errors
+                error = e;
+            }
+        }
+        error_ = std::move(error);
+
+        // If the coroutine has been suspended already, resume it right here in the event loop thread.
+        // `this` must not be touched afterwards, as the coroutine may have destroyed the awaitable.
+        if (ready_.exchange(true, std::memory_order_acq_rel))
+            handle_.resume();
+    }
+
+    template <typename... _Results>
+    inline future_return_t<_Results...> AsyncCallAwaitable<_Results...>::await_resume()
+    {
+        if (error_)
+            throw *std::move(error_);
+
+        if constexpr (sizeof...(_Results) == 1)
+            return std::get<0>(std::move(results_));
+        else if constexpr (sizeof...(_Results) > 1)
+            return std::move(results_);
+    }
+
     /*** ---------------- ***/
     /*** SignalSubscriber ***/
     /*** ---------------- ***/
@@ -386,14 +545,54 @@ namespace sdbus {
         return *this;
     }
 
+    template <uint8_t _Index>
+    inline SignalSubscriber& SignalSubscriber::withArgFilter(std::string value)
+    {
+        static_assert(_Index < 64, "D-Bus match rules can filter on the first 64 arguments only");
+
+        argFilters_.push_back({_Index, SignalArgFilter::Kind::Equals, std::move(value)});
+
+        return *this;
+    }
+
+    template <uint8_t _Index>
+    inline SignalSubscriber& SignalSubscriber::withArgPathFilter(std::string value)
+    {
+        static_assert(_Index < 64, "D-Bus match rules can filter on the first 64 arguments only");
+
+        argFilters_.push_back({_Index, SignalArgFilter::Kind::Path, std::move(value)});
+
+        return *this;
+    }
+
+    inline SignalSubscriber& SignalSubscriber::withArg0NamespaceFilter(std::string value)
+    {
+        argFilters_.push_back({0, SignalArgFilter::Kind::Namespace, std::move(value)});
+
+        return *this;
+    }
+
+    inline SignalSubscriber& SignalSubscriber::withReusableArguments()
+    {
+        reuseArguments_ = true;
+
+        return *this;
+    }
+
     template <typename _Function>
     inline void SignalSubscriber::call(_Function&& callback)
     {
         assert(interfaceName_ != nullptr); // onInterface() must be placed/called prior to this function
 
-        proxy_.registerSignalHandler( interfaceName_
-                                    , signalName_
-                                    , makeSignalHandler(std::forward<_Function>(callback)) );
+        if (argFilters_.empty())
+            proxy_.registerSignalHandler( interfaceName_
+                                        , signalName_
+                                        , makeSignalHandler(std::forward<_Function>(callback)) );
+        else
+            proxy_.registerSignalHandler( interfaceName_
+                                        , signalName_
+                                        , argFilters_
+                                        , makeSignalHandler(std::forward<_Function>(callback)) );
     }
 
     template <typename _Function>
@@ -401,8 +600,15 @@ namespace sdbus {
     {
         assert(interfaceName_ != nullptr); // onInterface() must be placed/called prior to this function
 
+        if (argFilters_.empty())
+            return proxy_.registerSignalHandler( interfaceName_
+                                               , signalName_
+                                               , makeSignalHandler(std::forward<_Function>(callback))
+                                               , return_slot );
+
         return proxy_.registerSignalHandler( interfaceName_
                                            , signalName_
+                                           , argFilters_
                                            , makeSignalHandler(std::forward<_Function>(callback))
                                            , return_slot );
     }
@@ -410,43 +616,61 @@ namespace sdbus {
     template <typename _Function>
     inline signal_handler SignalSubscriber::makeSignalHandler(_Function&& callback)
     {
+        if (reuseArguments_)
+        {
+            // The tuple of arguments lives as long as the handler, and is cleared and refilled for each signal,
+            // so that its containers and strings reuse the memory allocated for previous signals.
+            return [ callback = std::forward<_Function>(callback)
+                   , signalArgs = tuple_of_function_input_arg_types_t<_Function>{} ](Signal signal) mutable
+            {
+                detail::clear_for_reuse(signalArgs);
+                invokeSignalHandler(callback, signal, signalArgs);
+            };
+        }
+
         return [callback = std::forward<_Function>(callback)](Signal signal)
         {
             // Create a tuple of callback input arguments' types, which will be used
             // as a storage for the argument values deserialized from the signal message.
             tuple_of_function_input_arg_types_t<_Function> signalArgs;
 
-            // The signal handler can take pure signal parameters only, or an additional `std::optional<Error>` as its first
-            // parameter. In the former case, if the deserialization fails (e.g. due to signature mismatch),
-            // the failure is ignored (and signal simply dropped). In the latter case, the deserialization failure
-            // will be communicated to the client's signal handler as a valid Error object inside the std::optional parameter.
-            if constexpr (has_error_param_v<_Function>)
-            {
-                // Deserialize input arguments from the signal message into the tuple
-                try
-                {
-                    signal >> signalArgs;
-                }
-                catch (const sdbus::Error& e)
-                {
-                    // Pass message deserialization exceptions to the client via callback error parameter,
-                    // instead of propagating them up the message loop call stack.
-                    sdbus::apply(callback, e, signalArgs);
-                    return;
-                }
+            invokeSignalHandler(callback, signal, signalArgs);
+        };
+    }
 
-                // Invoke callback with no error and input arguments from the tuple.
-                sdbus::apply(callback, {}, signalArgs);
-            }
-            else
+    template <typename _Function, typename _Args>
+    inline void SignalSubscriber::invokeSignalHandler(_Function& callback, Signal& signal, _Args& signalArgs)
+    {
+        // The signal handler can take pure signal parameters only, or an additional `std::optional<Error>` as its first
+        // parameter. In the former case, if the deserialization fails (e.g. due to signature mismatch),
+        // the failure is ignored (and signal simply dropped). In the latter case, the deserialization failure
+        // will be communicated to the client's signal handler as a valid Error object inside the std::optional parameter.
+        if constexpr (has_error_param_v<_Function>)
+        {
+            // Deserialize input arguments from the signal message into the tuple
+            try
             {
-                // Deserialize input arguments from the signal message into the tuple
                 signal >> signalArgs;
-
-                // Invoke callback with input arguments from the tuple.
-                sdbus::apply(callback, signalArgs);
             }
-        };
+            catch (const sdbus::Error& e)
+            {
+                // Pass message deserialization exceptions to the client via callback error parameter,
+                // instead of propagating them up the message loop call stack.
+                sdbus::apply(callback, e, signalArgs);
+                return;
+            }
+
+            // Invoke callback with no error and input arguments from the tuple.
+            sdbus::apply(callback, {}, signalArgs);
+        }
+        else
+        {
+            // Deserialize input arguments from the signal message into the tuple
+            signal >> signalArgs;
+
+            // Invoke callback with input arguments from the tuple.
+            sdbus::apply(callback, signalArgs);
+        }
     }
 
     /*** -------------- ***/
@@ -461,6 +685,9 @@ namespace sdbus {
 
     inline Variant PropertyGetter::onInterface(std::string_view interfaceName)
     {
+        if (auto cachedValue = proxy_.getCachedProperty(interfaceName, propertyName_))
+            return std::move(*cachedValue);
+
         Variant var;
         proxy_.callMethod("Get")
               .onInterface(DBUS_PROPERTIES_INTERFACE_NAME)
@@ -524,6 +751,16 @@ namespace sdbus {
                      .getResultAsFuture<Variant>();
     }
 
+    inline AsyncCallAwaitable<Variant> AsyncPropertyGetter::getResultAsAwaitable()
+    {
+        assert(!interfaceName_.empty()); // onInterface() must be placed/called prior to this function
+
+        return proxy_.callMethodAsync("Get")
+                     .onInterface(DBUS_PROPERTIES_INTERFACE_NAME)
+                     .withArguments(interfaceName_, propertyName_)
+                     .getResultAsAwaitable<Variant>();
+    }
+
     /*** -------------- ***/
     /*** PropertySetter ***/
     /*** -------------- ***/
@@ -640,6 +877,16 @@ namespace sdbus {
                      .getResultAsFuture<>();
     }
 
+    inline AsyncCallAwaitable<> AsyncPropertySetter::getResultAsAwaitable()
+    {
+        assert(!interfaceName_.empty()); // onInterface() must be placed/called prior to this function
+
+        return proxy_.callMethodAsync("Set")
+                     .onInterface(DBUS_PROPERTIES_INTERFACE_NAME)
+                     .withArguments(interfaceName_, propertyName_, std::move(value_))
+                     .getResultAsAwaitable<>();
+    }
+
     /*** ------------------- ***/
     /*** AllPropertiesGetter ***/
     /*** ------------------- ***/
@@ -659,6 +906,25 @@ namespace sdbus {
         return props;
     }
 
+    template <typename _Struct>
+    inline _Struct AllPropertiesGetter::onInterface(std::string_view interfaceName)
+    {
+        _Struct result{};
+        storeResultsTo(interfaceName, result);
+        return result;
+    }
+
+    template <typename _Struct>
+    inline void AllPropertiesGetter::storeResultsTo(std::string_view interfaceName, _Struct& result)
+    {
+        // Properties without a counterpart struct member are skipped, and those missing in the reply keep their values
+        from_relaxed_dictionary<_Struct> props{result};
+        proxy_.callMethod("GetAll")
+              .onInterface(DBUS_PROPERTIES_INTERFACE_NAME)
+              .withArguments(std::move(interfaceName))
+              .storeResultsTo(props);
+    }
+
     /*** ------------------------ ***/
     /*** AsyncAllPropertiesGetter ***/
     /*** ------------------------ ***/
@@ -713,6 +979,16 @@ namespace sdbus {
                      .getResultAsFuture<std::map<PropertyName, Variant>>();
     }
 
+    inline AsyncCallAwaitable<std::map<PropertyName, Variant>> AsyncAllPropertiesGetter::getResultAsAwaitable()
+    {
+        assert(!interfaceName_.empty()); // onInterface() must be placed/called prior to this function
+
+        return proxy_.callMethodAsync("GetAll")
+                     .onInterface(DBUS_PROPERTIES_INTERFACE_NAME)
+                     .withArguments(interfaceName_)
+                     .getResultAsAwaitable<std::map<PropertyName, Variant>>();
+    }
+
 } // namespace sdbus
 
 #endif /* SDBUS_CPP_CONVENIENCEAPICLASSES_INL_ */
@@ -0,0 +1,306 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file DynamicValue.h
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef SDBUS_CXX_DYNAMICVALUE_H_
+#define SDBUS_CXX_DYNAMICVALUE_H_
+
+#include <sdbus-c++/Message.h>
+#include <sdbus-c++/Types.h>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Forward declarations
+namespace sdbus {
+    class DynamicBody;
+}
+
+namespace sdbus {
+
+    namespace detail {
+        // Node of a decoded value tree. Strings and arrays of fixed-size elements point into the message.
+        struct DynamicNode
+        {
+            const char* signature; // Complete type of the value, pointing into a signature of the message
+            union
+            {
+                uint64_t u;
+                int64_t i;
+                double d;
+                const char* str;
+                const void* data; // Elements of a fixed-size array
+                uint32_t first;   // Index of the first child link of a container
+            } value;
+            uint32_t count;       // Number of children of a container, elements of a fixed-size array, or string length
+            char type;            // D-Bus type code, `r` for structs and `e` for dictionary entries
+            bool fixedArray;
+        };
+
+        // Decoded value tree of a message body
+        struct DynamicTree
+        {
+            std::optional<Message> msg;
+            std::vector<DynamicNode> nodes; // The last node is the root, a pseudo-struct of the message arguments
+            std::vector<uint32_t> links;    // Node indices of the children of containers, contiguous per container
+            std::string_view signature;
+        };
+    }
+
+    /********************************************//**
+     * @class DynamicValue
+     *
+     * DynamicValue is a read-only view of one value of a message body decoded by
+     * DynamicBody, for code that handles messages whose types are not known at
+     * compile time. Its type is given by the D-Bus type code (`getType()`), with
+     * `r` for structs and `e` for dictionary entries like in Message::peekType().
+     * Elements of arrays, fields of structs, key and value of dictionary entries,
+     * and the content of variants are children of the value.
+     *
+     * The view is cheap to copy, and valid as long as the body it comes from.
+     *
+     ***********************************************/
+    class DynamicValue
+    {
+    public:
+        class iterator;
+
+        DynamicValue() = default;
+
+        [[nodiscard]] char getType() const noexcept;
+        [[nodiscard]] std::string_view getSignature() const noexcept;
+        [[nodiscard]] bool isContainer() const noexcept;
+
+        /*!
+         * @brief Gets the value of a basic type
+         *
+         * @tparam _T One of bool, uint8_t, int16_t, uint16_t, int32_t, uint32_t, int64_t, uint64_t, double,
+         *            std::string_view (for strings, object paths and signatures), or UnixFd (duplicates the descriptor)
+         *
+         * @throws sdbus::Error in case the value is of another type
+         */
+        template <typename _T>
+        [[nodiscard]] _T get() const;
+
+        // Number of children of a container value; zero for values of basic types
+        [[nodiscard]] std::size_t size() const noexcept;
+        [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+        [[nodiscard]] DynamicValue operator[](std::size_t index) const noexcept;
+        [[nodiscard]] iterator begin() const noexcept;
+        [[nodiscard]] iterator end() const noexcept;
+
+    private:
+        friend DynamicBody;
+        DynamicValue(const detail::DynamicTree* tree, const detail::DynamicNode* node) noexcept
+            : tree_(tree), node_(node), signature_(node->signature) {}
+        DynamicValue(const char* signature, const void* element) noexcept
+            : signature_(signature), element_(element) {}
+
+    private:
+        const detail::DynamicTree* tree_{};
+        const detail::DynamicNode* node_{};   // Null for elements of fixed-size arrays
+        const char* signature_{};
+        const void* element_{};               // Element of a fixed-size array
+    };
+
+    class DynamicValue::iterator
+    {
+    public:
+        using value_type = DynamicValue;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        DynamicValue operator*() const { return parent_[index_]; }
+        iterator& operator++() { ++index_; return *this; }
+        iterator operator++(int) { auto it = *this; ++index_; return it; }
+        bool operator==(const iterator& other) const { return index_ == other.index_; }
+
+    private:
+        friend DynamicValue;
+        iterator(const DynamicValue& parent, std::size_t index) : parent_(parent), index_(index) {}
+
+    private:
+        DynamicValue parent_;
+        std::size_t index_{};
+    };
+
+    /********************************************//**
+     * @class DynamicBody
+     *
+     * DynamicBody decodes a whole message body in one go into an immutable tree of
+     * DynamicValue values, guided by the signature of the message. It is meant for
+     * generic tools like bridges, monitors or loggers that handle messages of any type.
+     *
+     * Decoding is considerably cheaper than walking the message with peekType(),
+     * enterContainer() and friends: the nodes of the tree are stored compactly in
+     * one buffer, strings are not copied but point into the message, and arrays of
+     * fixed-size elements are taken from the message as one block. The body keeps
+     * the message alive. Decoding another message into an existing body reuses its
+     * buffers, so a long-lived body decodes messages without allocating. Decoding
+     * invalidates the values obtained from the body before.
+     *
+     ***********************************************/
+    class DynamicBody
+    {
+    public:
+        using iterator = DynamicValue::iterator;
+
+        DynamicBody() = default;
+        DynamicBody(DynamicBody&&) noexcept = default;
+        DynamicBody& operator=(DynamicBody&&) noexcept = default;
+
+        /*!
+         * @brief Decodes the body of the given message
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        explicit DynamicBody(Message msg);
+
+        /*!
+         * @brief Decodes the body of the given message, replacing the current contents
+         *
+         * The message is read from its beginning, and is left at its end.
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        void decode(Message msg);
+
+        // Signature of the whole body, i.e. of all message arguments
+        [[nodiscard]] std::string_view getSignature() const noexcept;
+
+        // Top-level values of the body, i.e. the message arguments
+        [[nodiscard]] std::size_t size() const noexcept { return getRoot().size(); }
+        [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+        [[nodiscard]] DynamicValue operator[](std::size_t index) const noexcept { return getRoot()[index]; }
+        [[nodiscard]] iterator begin() const noexcept { return getRoot().begin(); }
+        [[nodiscard]] iterator end() const noexcept { return getRoot().end(); }
+
+    private:
+        DynamicValue getRoot() const noexcept;
+
+    private:
+        std::unique_ptr<detail::DynamicTree> tree_; // Kept on the heap, so that values stay valid when the body is moved
+    };
+
+    /*!
+     * @brief Writes the body of a message as JSON, streaming it directly from the message
+     *
+     * @param[in] msg Message to read from its beginning
+     * @param[out] output String the JSON text is appended to
+     *
+     * The body is written as a JSON array of the message arguments. Arrays and structs
+     * become JSON arrays, dictionaries become JSON objects (with keys of non-string
+     * types written as strings), variants are written as their contents, strings,
+     * object paths and signatures become JSON strings, booleans and numbers are written
+     * as such (non-finite doubles as null), and Unix fds as their descriptor numbers.
+     *
+     * @throws sdbus::Error in case of failure
+     */
+    void writeJson(Message& msg, std::string& output);
+
+    // Out-of-line member definitions
+
+    inline char DynamicValue::getType() const noexcept
+    {
+        // Elements of fixed-size arrays are always of basic types
+        return node_ != nullptr ? node_->type : *signature_;
+    }
+
+    inline bool DynamicValue::isContainer() const noexcept
+    {
+        const auto type = getType();
+        return type == 'a' || type == 'r' || type == 'e' || type == 'v';
+    }
+
+    inline std::size_t DynamicValue::size() const noexcept
+    {
+        return node_ != nullptr && isContainer() ? node_->count : 0;
+    }
+
+    inline DynamicValue DynamicValue::operator[](std::size_t index) const noexcept
+    {
+        assert(index < size());
+
+        if (node_->fixedArray)
+        {
+            const auto* elementSignature = signature_ + 1;
+            std::size_t elementSize{};
+            switch (*elementSignature)
+            {
+                case 'y': elementSize = 1; break;
+                case 'n': case 'q': elementSize = 2; break;
+                case 'b': case 'i': case 'u': elementSize = 4; break;
+                default: elementSize = 8; break;
+            }
+            return {elementSignature, static_cast<const char*>(node_->value.data) + index * elementSize};
+        }
+
+        return {tree_, &tree_->nodes[tree_->links[node_->value.first + index]]};
+    }
+
+    inline DynamicValue::iterator DynamicValue::begin() const noexcept
+    {
+        return {*this, 0};
+    }
+
+    inline DynamicValue::iterator DynamicValue::end() const noexcept
+    {
+        return {*this, size()};
+    }
+
+    inline std::string_view DynamicBody::getSignature() const noexcept
+    {
+        return tree_ != nullptr ? tree_->signature : std::string_view{};
+    }
+
+    inline DynamicValue DynamicBody::getRoot() const noexcept
+    {
+        if (tree_ == nullptr || tree_->nodes.empty())
+            return {};
+        return {tree_.get(), &tree_->nodes.back()};
+    }
+
+    template <> bool DynamicValue::get<bool>() const;
+    template <> uint8_t DynamicValue::get<uint8_t>() const;
+    template <> int16_t DynamicValue::get<int16_t>() const;
+    template <> uint16_t DynamicValue::get<uint16_t>() const;
+    template <> int32_t DynamicValue::get<int32_t>() const;
+    template <> uint32_t DynamicValue::get<uint32_t>() const;
+    template <> int64_t DynamicValue::get<int64_t>() const;
+    template <> uint64_t DynamicValue::get<uint64_t>() const;
+    template <> double DynamicValue::get<double>() const;
+    template <> std::string_view DynamicValue::get<std::string_view>() const;
+    template <> UnixFd DynamicValue::get<UnixFd>() const;
+
+}
+
+#endif /* SDBUS_CXX_DYNAMICVALUE_H_ */
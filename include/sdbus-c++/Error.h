@@ -28,8 +28,11 @@
 #define SDBUS_CXX_ERROR_H_
 
 #include <errno.h>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <utility>
+#include <variant>
 
 namespace sdbus {
 
@@ -93,6 +96,102 @@ namespace sdbus {
     Error createError(int errNo, std::string customMsg);
 
     inline const Error::Name SDBUSCPP_ERROR_NAME{"org.sdbuscpp.Error"};
+
+    // Names of standard D-Bus errors, commonly returned by D-Bus services
+    inline const Error::Name DBUS_ERROR_FAILED{"org.freedesktop.DBus.Error.Failed"};
+    inline const Error::Name DBUS_ERROR_NO_REPLY{"org.freedesktop.DBus.Error.NoReply"};
+    inline const Error::Name DBUS_ERROR_TIMEOUT{"org.freedesktop.DBus.Error.Timeout"};
+    inline const Error::Name DBUS_ERROR_NOT_SUPPORTED{"org.freedesktop.DBus.Error.NotSupported"};
+    inline const Error::Name DBUS_ERROR_ACCESS_DENIED{"org.freedesktop.DBus.Error.AccessDenied"};
+    inline const Error::Name DBUS_ERROR_INVALID_ARGS{"org.freedesktop.DBus.Error.InvalidArgs"};
+    inline const Error::Name DBUS_ERROR_SERVICE_UNKNOWN{"org.freedesktop.DBus.Error.ServiceUnknown"};
+    inline const Error::Name DBUS_ERROR_NAME_HAS_NO_OWNER{"org.freedesktop.DBus.Error.NameHasNoOwner"};
+    inline const Error::Name DBUS_ERROR_UNKNOWN_OBJECT{"org.freedesktop.DBus.Error.UnknownObject"};
+    inline const Error::Name DBUS_ERROR_UNKNOWN_INTERFACE{"org.freedesktop.DBus.Error.UnknownInterface"};
+    inline const Error::Name DBUS_ERROR_UNKNOWN_METHOD{"org.freedesktop.DBus.Error.UnknownMethod"};
+    inline const Error::Name DBUS_ERROR_UNKNOWN_PROPERTY{"org.freedesktop.DBus.Error.UnknownProperty"};
+    inline const Error::Name DBUS_ERROR_PROPERTY_READ_ONLY{"org.freedesktop.DBus.Error.PropertyReadOnly"};
+
+    /********************************************//**
+     * @class Expected
+     *
+     * Holds either a value of the given type, or an sdbus::Error. This is the result
+     * type of non-throwing (std::nothrow-tagged) sdbus-c++ API variants, which report
+     * D-Bus errors by return value instead of throwing, and of method handlers which
+     * reply with a D-Bus error without throwing. It mimics C++23 std::expected.
+     *
+     ***********************************************/
+    template <typename _Value>
+    class Expected
+    {
+    public:
+        using value_type = _Value;
+        using error_type = Error;
+
+        Expected(const _Value& value) : storage_(std::in_place_index<0>, value) {}
+        Expected(_Value&& value) : storage_(std::in_place_index<0>, std::move(value)) {}
+        Expected(Error error) : storage_(std::in_place_index<1>, std::move(error)) {}
+
+        [[nodiscard]] bool has_value() const noexcept { return storage_.index() == 0; }
+        explicit operator bool() const noexcept { return has_value(); }
+
+        // Accessing the value of an Expected holding an error throws the error
+        [[nodiscard]] _Value& value() & { throwIfError(); return *std::get_if<0>(&storage_); }
+        [[nodiscard]] const _Value& value() const & { throwIfError(); return *std::get_if<0>(&storage_); }
+        [[nodiscard]] _Value&& value() && { throwIfError(); return std::move(*std::get_if<0>(&storage_)); }
+        template <typename _Default>
+        [[nodiscard]] _Value value_or(_Default&& defaultValue) const &
+        {
+            return has_value() ? *std::get_if<0>(&storage_) : static_cast<_Value>(std::forward<_Default>(defaultValue));
+        }
+
+        // Accessing the error of an Expected holding a value is undefined behavior
+        [[nodiscard]] const Error& error() const & noexcept { return *std::get_if<1>(&storage_); }
+        [[nodiscard]] Error&& error() && noexcept { return std::move(*std::get_if<1>(&storage_)); }
+
+        // Accessing the value of an Expected holding an error is undefined behavior
+        [[nodiscard]] _Value& operator*() & noexcept { return *std::get_if<0>(&storage_); }
+        [[nodiscard]] const _Value& operator*() const & noexcept { return *std::get_if<0>(&storage_); }
+        [[nodiscard]] _Value&& operator*() && noexcept { return std::move(*std::get_if<0>(&storage_)); }
+        [[nodiscard]] _Value* operator->() noexcept { return std::get_if<0>(&storage_); }
+        [[nodiscard]] const _Value* operator->() const noexcept { return std::get_if<0>(&storage_); }
+
+    private:
+        void throwIfError() const
+        {
+            if (!has_value())
+                throw error();
+        }
+
+    private:
+        std::variant<_Value, Error> storage_;
+    };
+
+    template <>
+    class Expected<void>
+    {
+    public:
+        using value_type = void;
+        using error_type = Error;
+
+        Expected() = default;
+        Expected(Error error) : error_(std::move(error)) {}
+
+        [[nodiscard]] bool has_value() const noexcept { return !error_.has_value(); }
+        explicit operator bool() const noexcept { return has_value(); }
+
+        void value() const
+        {
+            if (!has_value())
+                throw *error_;
+        }
+
+        [[nodiscard]] const Error& error() const & noexcept { return *error_; }
+        [[nodiscard]] Error&& error() && noexcept { return std::move(*error_); }
+
+    private:
+        std::optional<Error> error_;
+    };
 }
 
 #define SDBUS_THROW_ERROR(_MSG, _ERRNO)                         \
@@ -40,6 +40,7 @@ namespace sdbus {
         {    DEPRECATED = 0
         ,    METHOD_NO_REPLY = 1
         ,    PRIVILEGED = 2
+        ,    HIGH_PRIORITY = 7
         };
 
         enum PropertyUpdateBehaviorFlags : uint8_t
@@ -50,7 +51,7 @@ namespace sdbus {
         };
 
         enum : uint8_t
-        {   FLAG_COUNT = 7
+        {   FLAG_COUNT = 8
         };
 
         Flags()
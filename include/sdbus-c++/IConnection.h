@@ -29,11 +29,23 @@
 
 #include <sdbus-c++/TypeTraits.h>
 
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <coroutine>
+#include <cstddef>
 #include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <map>
 #include <memory>
+#include <memory_resource>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <vector>
 
 // Forward declarations
 struct sd_bus;
@@ -43,6 +55,10 @@ namespace sdbus {
     class ObjectPath;
     class BusName;
     using ServiceName = BusName;
+    class NameRequestAwaitable;
+    class IObject;
+    class ITracer;
+    struct ObjectRegistration;
 }
 
 namespace sdbus {
@@ -61,6 +77,53 @@ namespace sdbus {
     {
     public:
         struct PollData;
+        struct Metrics;
+        struct OutboundQueueLimits;
+        struct MethodCallAdmissionLimits;
+        struct HandlerProfile;
+        struct SlowHandlerWatchdog;
+        struct StartupProfile;
+        struct ResourceUsage;
+
+        // Key by which the order of method calls dispatched to the worker thread pool is preserved
+        enum class DispatchOrdering
+        {
+            PerObjectPath,  // Method calls on the same object path are handled sequentially
+            PerSender       // Method calls from the same sender are handled sequentially
+        };
+
+        // What happens to signals emitted while the outbound (write) queue of the connection is over its limit
+        enum class OutboundQueueOverflowPolicy
+        {
+            Enqueue,                    // Signals are queued as usual, the overflow is only reported
+            Block,                      // The emitting thread blocks until the event loop drains the queue to the low watermark
+            DropSignals,                // Signals are dropped until the queue falls to the low watermark
+            CoalescePropertiesChanged   // PropertiesChanged emissions are deferred and merged, other signals are queued
+        };
+
+        // What happens to method calls of a sender that is over its rate limit
+        enum class MethodCallOverloadPolicy
+        {
+            Reject, // Calls are answered with the org.freedesktop.DBus.Error.LimitsExceeded error right away
+            Defer   // Calls wait in the sender's queue until the rate limit lets them through
+        };
+
+        // Kind of object handler whose wall time is attributed in handler profiles
+        enum class HandlerKind
+        {
+            Method,         // Method call handler
+            PropertyGet,    // Property getter
+            PropertySet     // Property setter
+        };
+
+        // Phase of bringing a service up on the connection, whose time is attributed in the startup profile
+        enum class StartupPhase
+        {
+            VTablePreparation,          // Building vtable descriptors and handler records of objects
+            VTableRegistration,         // Registering vtables with sd-bus, under the bus lock
+            NameRequest,                // Requesting well-known names (synchronously)
+            SignalMatchInstallation     // Installing match rules of signal handlers (synchronously)
+        };
 
         virtual ~IConnection() = default;
 
@@ -82,6 +145,61 @@ namespace sdbus {
          */
         virtual void enterEventLoopAsync() = 0;
 
+        /*!
+         * @brief Makes the connection hand incoming D-Bus method calls over to a pool of worker threads
+         *
+         * @param[in] threadCount Number of worker threads in the pool
+         * @param[in] ordering Key by which the order of handling of method calls is preserved
+         *
+         * By default, all D-Bus method handlers are invoked in the thread running the event loop,
+         * so one slow handler delays all other method calls, signals and replies on the connection.
+         * With the dispatch pool, the event loop thread only reads incoming method calls and passes
+         * them to worker threads, which invoke method handlers and send the replies back through
+         * the connection. Method calls with the same ordering key (i.e. the same object path or
+         * the same sender, depending on @p ordering) are always handled by the same worker thread,
+         * in the order of their arrival.
+         *
+         * Calls of methods flagged Flags::HIGH_PRIORITY (see MethodVTableItem::withHighPriority())
+         * are handled by one more worker thread, dedicated to them, so that they don't wait behind
+         * slow calls being handled. They are handled in the order of their arrival among themselves,
+         * but they are not serialized with other calls of the same ordering key.
+         *
+         * Property get/set handlers, signal handlers and async call reply handlers keep on being
+         * invoked in the event loop thread. Method handlers must be thread-safe. When an object is
+         * unregistered or destroyed, its method calls still pending in the pool are failed with
+         * org.freedesktop.DBus.Error.UnknownObject, and its handlers being invoked by other worker
+         * threads are waited for to finish. Except when the object is destroyed from a callback in
+         * the event loop thread (e.g. a signal handler): the worker threads then need the bus lock
+         * held by that thread, so its handlers are not waited for, and must not rely on the object
+         * any more. Their replies are replaced by the UnknownObject error.
+         *
+         * The pool must be enabled before the event loop is entered, and can be enabled only once.
+         * Worker threads are stopped and joined when the connection is destroyed.
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        virtual void enableMethodCallDispatchPool( std::size_t threadCount
+                                                 , DispatchOrdering ordering = DispatchOrdering::PerObjectPath ) = 0;
+
+        /*!
+         * @brief Makes the internal I/O event loop busy-poll for incoming events before it goes to sleep
+         *
+         * @param[in] duration How long the event loop spins for the next event before blocking in poll(); zero turns spinning off
+         *
+         * By default, the event loop blocks in poll() as soon as there is nothing to process, and each
+         * incoming message then costs a wake-up of the event loop thread. For lowest latencies, e.g. when
+         * the event loop thread has a dedicated CPU core, the event loop may instead keep on processing
+         * the bus connection without blocking for up to @p duration after the last event, and only then
+         * block. This trades CPU time for latency. On TCP bus connections, SO_BUSY_POLL with the same
+         * duration is additionally requested on the bus socket, on a best-effort basis.
+         *
+         * Applies to enterEventLoop() and enterEventLoopAsync(), not to external event loops.
+         * The duration may be changed at any time; the change takes effect with the next wait.
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        virtual void setEventLoopBusyPollDuration(std::chrono::microseconds duration) = 0;
+
         /*!
          * @brief Leaves the I/O event loop running on this bus connection
          *
@@ -175,6 +293,36 @@ namespace sdbus {
          */
         virtual bool processPendingEvent() = 0;
 
+        /*!
+         * @brief Processes a batch of pending events
+         *
+         * @param[in] maxCount Maximum number of events to process
+         * @param[in] maxDuration Maximum time to spend processing events
+         * @return Number of events processed
+         *
+         * This function calls processPendingEvent() repeatedly until there are no more
+         * pending operations, until @p maxCount events have been processed, or until
+         * @p maxDuration has elapsed (the check is done after each processed event),
+         * whichever comes first. This saves re-arming the poll between individual
+         * messages when many of them are queued (e.g. under heavy signal traffic).
+         *
+         * If the returned value is less than @p maxCount and the time budget has not
+         * been exhausted, then no operations are pending any more and the caller should
+         * poll for I/O events (with fresh getEventLoopPollData()) before calling this
+         * function again. Otherwise, there may still be pending events and the caller
+         * may call this function again right away, after having dealt with its other duties.
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        virtual std::size_t processPendingEvents( std::size_t maxCount
+                                                , std::chrono::microseconds maxDuration = std::chrono::microseconds::max() ) = 0;
+
+        /*!
+         * @copydoc IConnection::processPendingEvents(std::size_t,std::chrono::microseconds)
+         */
+        template <typename _Rep, typename _Period>
+        std::size_t processPendingEvents(std::size_t maxCount, const std::chrono::duration<_Rep, _Period>& maxDuration);
+
         /*!
          * @brief Provides access to the currently processed D-Bus message
          *
@@ -221,6 +369,391 @@ namespace sdbus {
          */
         [[nodiscard]] virtual uint64_t getMethodCallTimeout() const = 0;
 
+        /*!
+         * @brief Enables or disables collection of performance metrics on the connection
+         *
+         * @param[in] enabled True to start collecting metrics, false to stop
+         *
+         * Metrics are not collected by default. When disabled, the only overhead on the hot
+         * paths of the connection is a relaxed load of an atomic flag. When enabled, clock
+         * readings and atomic counter updates are added around bus processing and handler
+         * invocations, and the bus read/write queue depths are sampled after each processed
+         * event. Already collected values are kept when collection is disabled.
+         *
+         * See Metrics for the list of provided metrics, and getMetrics() to read them.
+         */
+        virtual void enableMetrics(bool enabled = true) = 0;
+
+        /*!
+         * @brief Enables or disables profiling of contention on the sd-bus lock of the connection
+         *
+         * @param[in] enabled True to start profiling, false to stop
+         * @param[in] samplingInterval Every how many acquisitions of a thread the lock times are measured
+         *
+         * All calls into sd-bus made by the connection, by its objects and proxies, and by threads using
+         * them, are serialized by one lock per connection. With profiling enabled, acquisitions of the lock
+         * are counted per sd-bus function taking it (sd_bus_process, sd_bus_send, sd_bus_message_ref and
+         * so on), and in every `samplingInterval'-th acquisition of each thread, the time waited for the
+         * lock and the time it was held are measured. That shows which calls serialize the threads of the
+         * process. The profiles are reported in Metrics::busLockProfiles by getMetrics(), and dropped by
+         * resetMetrics(), independently of enableMetrics().
+         *
+         * Profiling is disabled by default, which costs one relaxed atomic load per lock acquisition.
+         * Already collected profiles are kept when profiling is disabled.
+         *
+         * @throws sdbus::Error in case of zero sampling interval
+         */
+        virtual void enableBusLockProfiling(bool enabled = true, uint32_t samplingInterval = 16) = 0;
+
+        /*!
+         * @brief Enables or disables caching of message sender credentials on the connection
+         *
+         * @param[in] enabled True to start caching credentials, false to stop and drop the cache
+         *
+         * On a bus connection, querying the credentials of a message sender (Message::getCreds(),
+         * Message::getCredsUid() etc.) costs a round trip to the bus daemon. With the cache enabled,
+         * credentials are queried once per sender unique name and reused for subsequent messages
+         * of that sender. A cache entry is dropped when the bus daemon announces, through
+         * NameOwnerChanged signal, that the sender has disconnected.
+         *
+         * Credentials are thus those of the sender at the time of the first query. Don't enable
+         * the cache if senders may change their effective credentials during their connection
+         * lifetime and your authorization decisions depend on that. Caching is disabled by default.
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        virtual void enableCredentialsCache(bool enabled = true) = 0;
+
+        /*!
+         * @brief Enables or disables caching of introspection data of objects of the connection
+         *
+         * @param[in] enabled True to start answering Introspect calls from the cache, false to leave them to sd-bus again
+         *
+         * sd-bus generates the XML reply to `org.freedesktop.DBus.Introspectable.Introspect` on every call,
+         * by walking all vtables registered at the object path and all nodes under it. With the cache
+         * enabled, the XML of an object path is generated once, the way sd-bus does it, and reused until
+         * vtables or object managers are added or removed at the path, or its child nodes change.
+         *
+         * Paths served by subtree vtables (IObject::addSubtreeVTable()) or subtree enumerators, or located
+         * under such paths, are resolved dynamically, so their Introspect calls are always left to sd-bus.
+         *
+         * The cache keeps track of registrations only while enabled, so enable it before registering objects.
+         * As long as any object registered while the cache was disabled is still registered, Introspect calls
+         * are left to sd-bus. Caching is disabled by default.
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        virtual void enableIntrospectionCache(bool enabled = true) = 0;
+
+        /*!
+         * @brief Enables or disables caching of replies to GetManagedObjects of object managers of the connection
+         *
+         * @param[in] enabled True to start answering GetManagedObjects calls from the cache, false to leave them to sd-bus again
+         *
+         * sd-bus answers `org.freedesktop.DBus.ObjectManager.GetManagedObjects` by walking all objects under
+         * the object manager and invoking all their property getters, on every call. With the cache enabled,
+         * properties of each interface of an object are serialized once, the way sd-bus does it, and reused
+         * until the interface is announced (emitInterfacesAddedSignal()), removed (emitInterfacesRemovedSignal())
+         * or its properties change (emitPropertiesChangedSignal()). A call thus only invokes getters of interfaces
+         * that have changed since the previous one. Objects appearing and disappearing are reflected right away.
+         *
+         * Values of properties that change without emitPropertiesChangedSignal() being called for them, e.g.
+         * properties marked with EMITS_NO_SIGNAL, are served stale. Object managers with subtree vtables or
+         * subtree enumerators at, above or below their path are always left to sd-bus. Caching is disabled by default.
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        virtual void enableManagedObjectsCache(bool enabled = true) = 0;
+
+        /*!
+         * @brief Enables or disables in-process dispatch of method calls between connections of the process
+         *
+         * @param[in] enabled True to start dispatching method calls locally, false to send them over the bus again
+         *
+         * Proxies and objects living in the same process normally talk to each other through the bus daemon,
+         * with a socket round trip and a full unmarshalling and marshalling on the daemon's side for both the call
+         * and its reply. Connections with local dispatch enabled skip the daemon: a method call of this connection
+         * destined to a unique or well-known name owned by another such connection of the process, for a method
+         * of an object registered there, is copied right into that connection's bus and handed over to its event
+         * loop, which invokes the method handler just as if the call came from the bus. The reply is handed back
+         * the same way, to the waiting caller or to the event loop of this connection for asynchronous calls.
+         *
+         * Method calls get the same treatment as on the bus: the handler runs in the event loop thread (or in the
+         * dispatch pool) of the object's connection, the call has the caller's unique name as its sender, errors and
+         * timeouts are reported to the caller like those coming from the bus, IObject::getCurrentlyProcessedMessage()
+         * works, and calls of one connection are handled in the order they were made. Calls the local dispatch
+         * can't serve, like those to standard D-Bus interfaces, to objects with subtree vtables, to objects of the
+         * same connection, or calls with mismatching arguments, keep going over the bus, so their ordering relative
+         * to the locally dispatched ones is not guaranteed. Signals always go over the bus, as they are broadcast.
+         * Hence a signal emitted by a method handler before it returns is sent out before the reply is handed back,
+         * but it travels through the bus daemon while the reply doesn't, so the caller may receive the reply first.
+         * Callers relying on seeing such a signal before the reply must not use local dispatch for the call.
+         *
+         * Both the calling and the called connection must have local dispatch enabled. It is disabled by default.
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        virtual void enableLocalDispatch(bool enabled = true) = 0;
+
+        /*!
+         * @brief Enables or disables the submission queue for messages sent from threads other than the event loop thread
+         *
+         * @param[in] enabled True to queue messages sent from other threads, false to send them right away again
+         *
+         * Sending a message takes the sd-bus lock of the connection for writing the message to the socket, and often
+         * wakes up the event loop, so many worker threads sending method replies (e.g. from asynchronous method handlers)
+         * or signals contend for the lock with one another and with the event loop processing incoming messages. With
+         * the submission queue enabled, method replies and signals sent from threads other than the one processing the
+         * connection's events are pushed to a lock-free queue instead, and the event loop sends them out in batches,
+         * under one lock acquisition per batch. Only the first message of a batch wakes up the event loop. Senders still
+         * take the sd-bus lock once per sent message (or batch of messages), but only to reference the messages, as
+         * sd-bus reference counts are not atomic.
+         *
+         * Messages of one thread are sent in the order they were submitted. Messages sent from the event loop thread,
+         * as well as method calls, are sent right away, so they may overtake messages waiting in the queue. A failure
+         * to send a queued message is not reported to its sender. The connection must run an event loop, internal or
+         * external, for queued messages to be sent out. Messages still queued when the submission queue is disabled,
+         * or when the connection is destroyed, are sent out right away. It is disabled by default.
+         */
+        virtual void enableSubmissionQueue(bool enabled = true) = 0;
+
+        /*!
+         * @brief Sets the memory resource for internal bookkeeping objects of the connection
+         *
+         * @param[in] resource Memory resource to use, or nullptr to go back to the default one
+         *
+         * Per-call and per-subscription bookkeeping objects (those of asynchronous method calls,
+         * signal handlers and match rules) are allocated from a memory resource of the connection.
+         * By default, it's a thread-safe pool, owned by the connection, that recycles blocks of memory
+         * instead of returning them to the global allocator. Any other resource can be plugged in here.
+         * Objects already allocated are given back to the resource they came from.
+         *
+         * The resource must be thread-safe if the connection is used from multiple threads, and it must
+         * outlive the connection and all proxies, objects, slots and pending async call handles created
+         * upon it. This function is not thread-safe; call it before the connection is put to use.
+         */
+        virtual void setMemoryResource(std::pmr::memory_resource* resource) = 0;
+
+        /*!
+         * @brief Returns a snapshot of performance metrics collected on the connection
+         *
+         * @return Current values of all metrics
+         *
+         * The values are cumulative since the metrics were enabled for the first time,
+         * or since the last resetMetrics() call, so they can be pulled periodically and
+         * exported to monitoring systems (e.g. as Prometheus counters and histograms).
+         * The function is thread-safe. Individual values in the snapshot are consistent,
+         * but the snapshot as a whole is not taken atomically.
+         */
+        [[nodiscard]] virtual Metrics getMetrics() const = 0;
+
+        /*!
+         * @brief Resets all collected performance metrics to zero
+         */
+        virtual void resetMetrics() = 0;
+
+        /*!
+         * @brief Returns counts and approximate memory footprint of the bookkeeping of the connection
+         *
+         * @return Current resource usage of the connection
+         *
+         * Reports what the connection itself holds on to: floating match rules and name requests
+         * (those whose lifetime is tied to the connection), watched names, async calls pending
+         * over all proxies, cached credentials, method calls queued for admission or for the
+         * dispatch pool, and the depths of the sd-bus read and write queues. A count that only
+         * grows over the lifetime of a long-running process hints at a leak, typically floating
+         * registrations made over and over again.
+         *
+         * The function only takes the locks of the respective containers briefly, and doesn't
+         * talk to the bus daemon, so it's cheap enough to be called periodically in production.
+         * It's thread-safe. The values are not taken atomically as a whole.
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        [[nodiscard]] virtual ResourceUsage getResourceUsage() const = 0;
+
+        /*!
+         * @brief Limits the outbound queue of the connection for emitted signals
+         *
+         * @param[in] limits Watermarks, overflow policy and overflow handler
+         *
+         * sd-bus queues outgoing messages that cannot be written to the socket right away without
+         * any limit, so a stalled bus or a slow peer make the queue, and the memory of the process,
+         * grow unboundedly. With limits set, the queue enters the overflow state once it holds
+         * `highWatermark' messages, and leaves it once it's drained down to `lowWatermark' messages.
+         * Signals emitted in the overflow state are treated according to the overflow policy.
+         * The overflow handler, if any, is invoked each time the queue enters the overflow state.
+         *
+         * Method calls and replies are never subject to the limits. A high watermark of 0 (the default)
+         * means no limits. When limits are set, the queue length is queried on each signal emission.
+         *
+         * With the CoalescePropertiesChanged policy, PropertiesChanged emissions in the overflow state are
+         * not sent, but recorded per object and interface. Repeated emissions for the same properties
+         * collapse into one, and the recorded emissions are sent once the queue leaves the overflow state.
+         *
+         * With the Block policy, a thread emitting a signal in the overflow state waits until the event
+         * loop of the connection writes the queue out down to the low watermark, so the connection must
+         * run an event loop in another thread. Emitting from the event loop thread itself throws then.
+         *
+         * @throws sdbus::Error in case the low watermark is higher than the high watermark
+         */
+        virtual void setOutboundQueueLimits(OutboundQueueLimits limits) = 0;
+
+        /*!
+         * @brief Puts admission control and fair scheduling in front of method handlers of the connection
+         *
+         * @param[in] limits Queue capacity, per-sender rate limit, overload policy and interface weights
+         *
+         * By default, incoming method calls are handled in the order they arrive in, so a client flooding
+         * the service with calls delays the calls of all other clients. With limits set, method calls
+         * are read off the bus ahead of their handling and queued per sender. Each sender has a token
+         * bucket refilled at `callsPerSecond' up to `burst' tokens, and each call of the sender takes a
+         * token. Calls over the rate limit are either rejected with `org.freedesktop.DBus.Error.LimitsExceeded',
+         * or deferred until the bucket refills, depending on the overload policy.
+         *
+         * Queued calls are handled in a weighted round robin over senders, so every sender gets an equal
+         * share of the handling regardless of how many calls it has queued. A call on an interface of weight
+         * `w' takes 1/w of the sender's turn (the default weight is 1). Calls of one sender are still handled
+         * in the order of their arrival. The queue holds at most `maxQueuedCalls' calls in total; when it's
+         * full, the newest call of the sender with most queued calls is rejected to make room.
+         *
+         * The limits apply to method handlers of registered objects, with or without the dispatch pool
+         * (see enableMethodCallDispatchPool()). With the pool, calls are handed over to worker threads
+         * only as they get free, so that queued calls keep on being scheduled fairly. Standard interfaces
+         * handled by sd-bus itself, like Properties or Introspectable, are not subject to the limits.
+         *
+         * Calls of methods flagged Flags::HIGH_PRIORITY (see MethodVTableItem::withHighPriority()) are queued
+         * apart and handled as soon as they are read, ahead of all other queued calls, without rate limiting.
+         * With the dispatch pool, they are handed over to its worker dedicated to high priority calls.
+         *
+         * A `maxQueuedCalls' of 0 (the default) turns admission control off. Calls queued at that time
+         * are still handled.
+         *
+         * @throws sdbus::Error in case of invalid limits
+         */
+        virtual void setMethodCallAdmissionLimits(MethodCallAdmissionLimits limits) = 0;
+
+        /*!
+         * @brief Enables or disables profiling of method and property handlers of objects of the connection
+         *
+         * @param[in] enabled True to start profiling, false to stop
+         *
+         * With profiling enabled, the wall time of each method handler, property getter and property setter
+         * invocation is attributed to the handler's object path, interface and member, and kept in a histogram
+         * per member, in whichever thread the handler runs (the event loop thread or a dispatch pool worker).
+         * Each invocation costs two clock readings and a lookup of the member under a shared lock. Profiling is
+         * disabled by default. Already collected profiles are kept when profiling is disabled.
+         *
+         * See getHandlerProfiles() to read the profiles, and exposeHandlerProfiles() to make them available
+         * over D-Bus.
+         */
+        virtual void enableHandlerProfiling(bool enabled = true) = 0;
+
+        /*!
+         * @brief Sets budgets of method and property handlers, and the callback reporting handlers that exceed them
+         *
+         * @param[in] watchdog Default budget, budgets of specific members, and the slow handler callback
+         *
+         * Handlers that take longer than their budget are reported to the callback, right after they return,
+         * in the thread they ran in. Budgets are measured regardless of whether profiling is enabled, and
+         * with profiling enabled, the profile of the member also counts the invocations over budget.
+         * A default budget of 0 and no member budgets (the default) turn the watchdog off.
+         *
+         * @throws sdbus::Error in case of invalid budgets
+         */
+        virtual void setSlowHandlerWatchdog(SlowHandlerWatchdog watchdog) = 0;
+
+        /*!
+         * @brief Returns profiles of method and property handlers of objects of the connection
+         *
+         * @return Profile of each member whose handler was invoked while profiling was enabled
+         *
+         * The values are cumulative since profiling was enabled for the first time, or since
+         * the last resetHandlerProfiles() call. The function is thread-safe.
+         */
+        [[nodiscard]] virtual std::vector<HandlerProfile> getHandlerProfiles() const = 0;
+
+        /*!
+         * @brief Drops all collected handler profiles
+         */
+        virtual void resetHandlerProfiles() = 0;
+
+        /*!
+         * @brief Exposes handler profiles of the connection over D-Bus
+         *
+         * @param[in] objectPath Object path at which the profiles are exposed
+         * @return RAII-style slot handle representing the ownership of the exposing object
+         *
+         * Registers an object implementing the `org.sdbuscpp.Debug.Stats' interface at the given path. Its
+         * `GetHandlerStats' method returns the profiles as `a(ssssttttat)' array of structs with the handler
+         * kind ("method", "get" or "set"), object path, interface name, member name, invocation count, total
+         * and maximum duration in nanoseconds, count of invocations over budget and the histogram buckets,
+         * and its `Reset' method drops the profiles. The object is unregistered when the slot is destroyed.
+         *
+         * Profiles reveal internals of the service, so consider carefully before exposing them on the system bus.
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        [[nodiscard]] virtual Slot exposeHandlerProfiles(const ObjectPath& objectPath, return_slot_t) = 0;
+
+        /*!
+         * @brief Enables or disables profiling of the startup of services on the connection
+         *
+         * @param[in] enabled True to start profiling, false to stop
+         *
+         * With profiling enabled, the time spent in each phase of bringing services up (see StartupPhase)
+         * is summed up, and the time spent in preparing and registering vtables is also attributed to their
+         * object paths. This tells which objects and which phases make a slow startup slow. Each measured
+         * step costs two clock readings and a map update under a lock, which is negligible next to the
+         * steps themselves. Profiling is disabled by default, so enable it right after the connection
+         * is created. Already collected profile is kept when profiling is disabled.
+         */
+        virtual void enableStartupProfiling(bool enabled = true) = 0;
+
+        /*!
+         * @brief Returns the startup profile of the connection
+         *
+         * @return Time spent in the startup phases and per object path while profiling was enabled
+         *
+         * The function is thread-safe.
+         */
+        [[nodiscard]] virtual StartupProfile getStartupProfile() const = 0;
+
+        /*!
+         * @brief Installs a tracer of method calls issued and handled on the connection
+         *
+         * @param[in] tracer Tracer to install, or nullptr to uninstall the current one
+         *
+         * The tracer is called at sending of method calls by proxies and at receiving of their
+         * replies, and at entry and exit of method handlers of objects. See ITracer for details.
+         * With no tracer installed (the default), tracing costs one branch per method call.
+         *
+         * Spans opened before the tracer is replaced or uninstalled are still closed by the tracer
+         * that opened them, which is kept alive until then.
+         *
+         * The function is thread-safe.
+         */
+        virtual void setTracer(std::shared_ptr<ITracer> tracer) = 0;
+
+        /*!
+         * @brief Starts recording messages received by the connection into a traffic capture file
+         *
+         * @param[in] filePath Path to the capture file, which is created or truncated
+         * @return RAII-style slot handle representing the ownership of the capture
+         *
+         * Every message read from the bus (method calls, replies, errors and signals) is recorded together
+         * with its header fields, arguments and a timestamp taken before it is dispatched, in a compact binary
+         * format. Messages sent by the connection are not recorded. The capture ends, and the file is flushed
+         * and closed, when the slot is destroyed. Read the capture back with sdbus::TrafficCaptureReader, e.g.
+         * to replay recorded method calls against an object offline (see sdbus-c++-perf-tests-replay).
+         *
+         * Recording costs an extra deserialization pass over each received message, so it's meant
+         * for debugging sessions rather than for permanent use.
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        [[nodiscard]] virtual Slot captureTraffic(const std::string& filePath, return_slot_t) = 0;
+
         /*!
          * @brief Adds an ObjectManager at the specified D-Bus object path
          * @param[in] objectPath Object path at which the ObjectManager interface shall be installed
@@ -256,6 +789,53 @@ namespace sdbus {
          */
         [[nodiscard]] virtual Slot addObjectManager(const ObjectPath& objectPath, return_slot_t) = 0;
 
+        /*!
+         * @brief Registers vtables of many objects and announces the objects in one go
+         *
+         * @param[in] batch Vtables to be registered, along with their objects and interfaces
+         *
+         * This is meant for creating objects in bulk, e.g. thousands of them at once. It is like
+         * calling `object.addVTable(vtable).forInterface(interfaceName)` for each item of the batch,
+         * followed by `object.emitInterfacesAddedSignal(interfaces)` for each of the objects, with
+         * interfaces of its vtables from the batch. However, all of that happens under a single
+         * acquisition of the connection's bus lock, and the event loop is woken up at most once
+         * for the whole batch. The InterfacesAdded signals require an ObjectManager at an object
+         * path which is a prefix of the objects' paths.
+         *
+         * The registrations are floating, their lifetime is tied to the lifetime of the object,
+         * like in case of IObject::addVTable(). All objects must have been created on this connection.
+         *
+         * If a registration or emission fails, none of the vtables of the batch remain registered,
+         * but InterfacesAdded signals that have been emitted until then are not taken back.
+         *
+         * Preparation of the vtables (building their descriptors and handler records, see
+         * StartupPhase::VTablePreparation) needs no bus lock. With more than one preparation thread,
+         * the batch is split into that many parts, prepared in parallel by the calling thread and
+         * by temporary worker threads (of ThreadRole::VTablePreparation), and then registered with
+         * sd-bus in one go as usual. This pays off for batches of many large vtables.
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        virtual void registerObjects(std::vector<ObjectRegistration> batch, std::size_t preparationThreads = 1) = 0;
+
+        /*!
+         * @brief Announces removal of many objects and unregisters them in one go
+         *
+         * @param[in] objects Objects to be removed from the bus
+         *
+         * This is the counterpart of registerObjects(). It is like calling
+         * `object.emitInterfacesRemovedSignal()` followed by `object.unregister()` for each
+         * of the objects, but under a single acquisition of the connection's bus lock, and
+         * with at most one wake-up of the event loop. The InterfacesRemoved signals require
+         * an ObjectManager at an object path which is a prefix of the objects' paths.
+         *
+         * The objects are unregistered even if emitting of a signal fails. Vtables registered
+         * with `return_slot' are not affected, their slots still own the registrations.
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        virtual void unregisterObjects(std::span<IObject* const> objects) = 0;
+
         /*!
          * @brief Installs a floating match rule for messages received on this bus connection
          *
@@ -351,6 +931,48 @@ namespace sdbus {
                                                 , message_handler installCallback
                                                 , return_slot_t ) = 0;
 
+        /*!
+         * @brief Starts tracking the owner of a well-known bus name, for the lifetime of the connection
+         *
+         * @param[in] name Well-known name to watch
+         *
+         * The connection resolves the current owner of the name and then follows its changes
+         * through NameOwnerChanged signals of the bus broker. While a name is watched, method calls
+         * created on the connection for that destination (including those of proxies) are addressed
+         * directly to the unique name of the owner, sparing the broker the name lookup per message,
+         * and a call to a name that currently has no owner fails right away with
+         * `org.freedesktop.DBus.Error.ServiceUnknown` error, instead of being sent out. Note that
+         * this bypasses D-Bus service activation for the name.
+         *
+         * Owner changes are processed in the event loop, so the connection must have one running.
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        virtual void watchName(const ServiceName& name) = 0;
+
+        /*!
+         * @brief Starts tracking the owner of a well-known bus name
+         *
+         * @param[in] name Well-known name to watch
+         * @return RAII-style slot handle representing the ownership of the watch
+         *
+         * This method operates the same as `watchName()` above, just that the name is watched
+         * as long as the returned slot instance (or any other watch of the name) lives.
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        [[nodiscard]] virtual Slot watchName(const ServiceName& name, return_slot_t) = 0;
+
+        /*!
+         * @brief Returns the current owner of a watched name, as last seen by the connection
+         *
+         * @param[in] name Watched well-known name
+         * @return Unique name of the owner, or an empty name if the name has no owner
+         *
+         * @throws sdbus::Error in case of failure, e.g. when the name is not watched
+         */
+        [[nodiscard]] virtual BusName getWatchedNameOwner(const ServiceName& name) const = 0;
+
         /*!
          * @brief Retrieves the unique name of a connection. E.g. ":1.xx"
          *
@@ -367,6 +989,58 @@ namespace sdbus {
          */
         virtual void requestName(const ServiceName& name) = 0;
 
+        /*!
+         * @brief Asynchronously requests a well-known D-Bus service name on a bus
+         *
+         * @param[in] name Name to request
+         * @param[in] callback Handler called with the outcome of the request, i.e. with no error if the name has been acquired
+         *
+         * This method operates the same as `requestName()` above, just that it sends the request to the broker
+         * without waiting for the reply, so many names (on many connections) can be requested in parallel.
+         * The callback is invoked from the event loop once the reply arrives, so the connection must have
+         * an event loop running. The request is floating, i.e. bound to the lifetime of the connection.
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        virtual void requestNameAsync(const ServiceName& name, name_request_handler callback) = 0;
+
+        /*!
+         * @brief Asynchronously requests a well-known D-Bus service name on a bus
+         *
+         * @param[in] name Name to request
+         * @param[in] callback Handler called with the outcome of the request, i.e. with no error if the name has been acquired
+         * @return RAII-style slot handle representing the ownership of the request
+         *
+         * This method operates the same as the floating variant above, just that destroying the returned slot
+         * before the reply arrives stops the callback from being called. It doesn't withdraw the request itself.
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        [[nodiscard]] virtual Slot requestNameAsync(const ServiceName& name, name_request_handler callback, return_slot_t) = 0;
+
+        /*!
+         * @brief Asynchronously requests a well-known D-Bus service name on a bus
+         *
+         * @param[in] name Name to request
+         * @return Future object providing the outcome of the request
+         *
+         * The future throws sdbus::Error if the name could not be acquired.
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        [[nodiscard]] std::future<void> requestNameAsync(const ServiceName& name, with_future_t);
+
+        /*!
+         * @brief Asynchronously requests a well-known D-Bus service name on a bus
+         *
+         * @param[in] name Name to request
+         * @return Awaitable providing the outcome of the request to a C++20 coroutine
+         *
+         * The request is sent out when the coroutine gets suspended, and the coroutine is resumed in
+         * the event loop thread. co_await throws sdbus::Error if the name could not be acquired.
+         */
+        [[nodiscard]] NameRequestAwaitable requestNameAsync(const ServiceName& name, with_awaitable_t);
+
         /*!
          * @brief Releases an acquired well-known D-Bus service name on a bus
          *
@@ -424,8 +1098,304 @@ namespace sdbus {
              */
             [[nodiscard]] int getPollTimeout() const;
         };
+
+        /*!
+         * @struct Metrics
+         *
+         * Carries performance metrics of the connection's hot paths.
+         *
+         * See enableMetrics() and getMetrics() for more info.
+         */
+        struct Metrics
+        {
+            /*!
+             * Distribution of measured durations in buckets with exponentially growing upper bounds.
+             *
+             * Bucket i counts durations shorter than 2^i microseconds, which are not counted by
+             * a lower bucket. The last bucket counts all durations that do not fit into lower buckets.
+             */
+            struct Histogram
+            {
+                static constexpr std::size_t BUCKET_COUNT{32};
+
+                std::array<uint64_t, BUCKET_COUNT> buckets{};
+                uint64_t count{};
+                std::chrono::nanoseconds sum{};
+
+                /*!
+                 * Returns the exclusive upper bound of the given bucket,
+                 * or std::chrono::microseconds::max() for the last bucket.
+                 */
+                [[nodiscard]] static std::chrono::microseconds getBucketUpperBound(std::size_t index);
+            };
+
+            /*!
+             * Number of bus processing steps (sd_bus_process() calls) done by processPendingEvent().
+             */
+            uint64_t processingSteps{};
+
+            /*!
+             * Number of those processing steps that dispatched a message or another event.
+             */
+            uint64_t processedEvents{};
+
+            /*!
+             * Time spent in the bus processing steps, including handlers invoked from within.
+             */
+            Histogram processingDuration;
+
+            /*!
+             * Time spent inside user-provided method, property, signal and async reply handlers
+             * invoked in the event loop thread.
+             */
+            Histogram handlerDuration;
+
+            /*!
+             * Number of wake-ups of the internal event loop from poll(2).
+             */
+            uint64_t pollWakeups{};
+
+            /*!
+             * Depths of the bus read and write queues, as sampled after the last processing step.
+             */
+            uint64_t readQueueDepth{};
+            uint64_t writeQueueDepth{};
+
+            /*!
+             * Maximum depths of the bus read and write queues seen in the samples.
+             */
+            uint64_t maxReadQueueDepth{};
+            uint64_t maxWriteQueueDepth{};
+
+            /*!
+             * Time from issuing an asynchronous method call until its reply handler is invoked.
+             */
+            Histogram asyncCallRoundTrip;
+
+            /*!
+             * Contention on the sd-bus lock of the connection caused by one wrapped sd-bus function.
+             *
+             * Wait and hold durations are measured in sampled acquisitions only, so their counts are
+             * a fraction of all acquisitions. The hold duration of sd_bus_process includes handlers
+             * invoked from within.
+             */
+            struct BusLockProfile
+            {
+                std::string function;       // Name of the sd-bus function, e.g. "sd_bus_send"
+                uint64_t acquisitions{};    // Number of acquisitions of the lock by the function
+                Histogram waitDuration;     // Time waited for the lock
+                Histogram holdDuration;     // Time the lock was held
+            };
+
+            /*!
+             * Contention on the sd-bus lock per function acquiring it, collected while bus lock profiling
+             * is enabled (see enableBusLockProfiling()).
+             */
+            std::vector<BusLockProfile> busLockProfiles;
+        };
+
+        /*!
+         * @struct OutboundQueueLimits
+         *
+         * Limits of the outbound queue of the connection.
+         *
+         * See setOutboundQueueLimits() for more info.
+         */
+        struct OutboundQueueLimits
+        {
+            uint64_t highWatermark{}; // Number of queued messages at which the overflow state is entered. 0 means no limits.
+            uint64_t lowWatermark{};  // Number of queued messages at which the overflow state is left
+            OutboundQueueOverflowPolicy policy{OutboundQueueOverflowPolicy::Enqueue};
+            std::function<void(uint64_t queuedMessages)> overflowHandler;
+        };
+
+        /*!
+         * @struct MethodCallAdmissionLimits
+         *
+         * Limits of admission of incoming method calls of the connection.
+         *
+         * See setMethodCallAdmissionLimits() for more info.
+         */
+        struct MethodCallAdmissionLimits
+        {
+            std::size_t maxQueuedCalls{}; // Calls waiting to be handled, over all senders. 0 means no admission control.
+            double callsPerSecond{};      // Rate at which the token bucket of each sender refills. 0 means no rate limit.
+            std::size_t burst{1};         // Capacity of the token bucket of each sender
+            MethodCallOverloadPolicy policy{MethodCallOverloadPolicy::Reject};
+            std::map<std::string, unsigned> interfaceWeights; // Weights of interfaces other than 1, each at least 1
+        };
+
+        /*!
+         * @struct HandlerProfile
+         *
+         * Carries the profile of a method or property handler of an object.
+         *
+         * See enableHandlerProfiling() and getHandlerProfiles() for more info.
+         */
+        struct HandlerProfile
+        {
+            HandlerKind kind{};
+            std::string objectPath;
+            std::string interfaceName;
+            std::string memberName;             // Method name or property name
+            Metrics::Histogram duration;        // Wall time of the handler invocations
+            std::chrono::nanoseconds maxDuration{};
+            uint64_t overBudgetCount{};         // Invocations that took longer than the budget of the handler
+        };
+
+        /*!
+         * @struct StartupProfile
+         *
+         * Carries the time spent in bringing services up on the connection, per phase and per object path.
+         * Durations measured in parallel threads are summed up, so they may exceed the wall time.
+         *
+         * See enableStartupProfiling() and getStartupProfile() for more info.
+         */
+        struct StartupProfile
+        {
+            struct PhaseProfile
+            {
+                StartupPhase phase{};
+                uint64_t count{};                   // Measured steps, e.g. vtables prepared or names requested
+                std::chrono::nanoseconds duration{};
+            };
+
+            struct ObjectProfile
+            {
+                std::string objectPath;
+                uint64_t vtables{};                 // Vtables prepared for the object
+                std::chrono::nanoseconds vtablePreparationDuration{};
+                // Vtables registered in batches through registerObjects() are registered in a single step,
+                // whose time is attributed to the registration phase only, not to their objects
+                std::chrono::nanoseconds vtableRegistrationDuration{};
+            };
+
+            std::vector<PhaseProfile> phases;       // One entry per StartupPhase, in the order of their declaration
+            std::vector<ObjectProfile> objects;     // Sorted by object path
+        };
+
+        /*!
+         * @struct SlowHandlerWatchdog
+         *
+         * Budgets of method and property handlers, and the callback reporting handlers over budget.
+         *
+         * See setSlowHandlerWatchdog() for more info.
+         */
+        struct SlowHandlerWatchdog
+        {
+            std::chrono::microseconds budget{}; // Budget of every handler. 0 means no default budget.
+            std::map<std::string, std::chrono::microseconds> memberBudgets; // Budgets keyed by "interface.member", overriding the default one
+            std::function<void( HandlerKind kind
+                              , std::string_view objectPath
+                              , std::string_view interfaceName
+                              , std::string_view memberName
+                              , std::chrono::nanoseconds duration )> callback;
+        };
+
+        /*!
+         * @struct ResourceUsage
+         *
+         * Carries counts of bookkeeping records held by the connection, and their approximate size.
+         *
+         * See getResourceUsage() for more info.
+         */
+        struct ResourceUsage
+        {
+            std::size_t floatingMatchRules{};   // Match rules and name watches owned by the connection
+            std::size_t floatingNameRequests{}; // Asynchronous name requests owned by the connection
+            std::size_t watchedNames{};         // Distinct names watched for their owners
+            std::size_t pendingAsyncCalls{};    // Async method calls waiting for their replies, over all proxies
+            std::size_t cachedCredentials{};    // Entries of the sender credentials cache
+            std::size_t deferredPropertiesChanges{}; // PropertiesChanged emissions deferred or coalesced, per object and interface
+            std::size_t queuedMethodCalls{};    // Incoming method calls in the admission queue or waiting for the dispatch pool
+            uint64_t readQueueDepth{};          // Messages in the sd-bus read queue
+            uint64_t writeQueueDepth{};         // Messages in the sd-bus write queue
+            // Memory held by the records above, as far as sdbus-c++ allocates it. Memory of sd-bus
+            // (its queues, match and slot objects) and of captures of user callbacks is not included.
+            std::size_t approximateBytes{};
+        };
+    };
+
+    /********************************************//**
+     * @class NameRequestAwaitable
+     *
+     * NameRequestAwaitable makes the outcome of an asynchronous request for a well-known
+     * bus name awaitable from within a C++20 coroutine. It is obtained through
+     * IConnection::requestNameAsync() with the `with_awaitable` tag, e.g.:
+     *
+     * @code
+     * co_await connection->requestNameAsync(serviceName, sdbus::with_awaitable);
+     * @endcode
+     *
+     * Destroying the awaitable (i.e., destroying the suspended coroutine) cancels the delivery
+     * of the outcome, so one should destroy suspended coroutines only from within the event loop thread.
+     *
+     ***********************************************/
+    class NameRequestAwaitable
+    {
+    public:
+        NameRequestAwaitable(const NameRequestAwaitable&) = delete;
+        NameRequestAwaitable& operator=(const NameRequestAwaitable&) = delete;
+
+        bool await_ready() const noexcept;
+        bool await_suspend(std::coroutine_handle<> handle);
+        void await_resume();
+
+    private:
+        friend IConnection;
+        NameRequestAwaitable(IConnection& connection, std::string name);
+
+    private:
+        IConnection& connection_;
+        std::string name_;
+        std::coroutine_handle<> handle_;
+        Slot request_;
+        std::atomic<bool> ready_{}; // Whichever of reply delivery and coroutine suspension comes second resumes the coroutine
+        std::exception_ptr error_;
+    };
+
+    /********************************************//**
+     * @class DeadlineScope
+     *
+     * RAII scope setting a deadline for D-Bus method calls made by the current thread
+     * while the scope is alive. Timeouts of both synchronous and asynchronous method calls
+     * made within the scope are shortened to the time remaining until the deadline, and
+     * calls made after the deadline has passed fail right away with an ETIMEDOUT error,
+     * without being sent at all. Scopes can be nested; an inner scope can only shorten,
+     * never extend, the deadline of an outer scope.
+     *
+     * D-Bus messages carry no deadline, so a service propagates the deadline of a request
+     * to the downstream calls it makes by opening a scope in the method handler, e.g. with
+     * the timeout its clients are known to use. The service then stops calling downstream
+     * on behalf of clients that have already given up.
+     *
+     ***********************************************/
+    class DeadlineScope
+    {
+    public:
+        explicit DeadlineScope(std::chrono::steady_clock::time_point deadline);
+        template <typename _Rep, typename _Period>
+        explicit DeadlineScope(const std::chrono::duration<_Rep, _Period>& timeout);
+        ~DeadlineScope();
+
+        DeadlineScope(const DeadlineScope&) = delete;
+        DeadlineScope& operator=(const DeadlineScope&) = delete;
+
+        /*!
+         * @brief Returns the deadline of the innermost scope of the current thread, if any
+         */
+        [[nodiscard]] static std::optional<std::chrono::steady_clock::time_point> current();
+
+    private:
+        std::optional<std::chrono::steady_clock::time_point> previous_;
     };
 
+    template <typename _Rep, typename _Period>
+    inline DeadlineScope::DeadlineScope(const std::chrono::duration<_Rep, _Period>& timeout)
+        : DeadlineScope(std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout))
+    {
+    }
+
     template <typename _Rep, typename _Period>
     inline void IConnection::setMethodCallTimeout(const std::chrono::duration<_Rep, _Period>& timeout)
     {
@@ -433,6 +1403,13 @@ namespace sdbus {
         return setMethodCallTimeout(microsecs.count());
     }
 
+    template <typename _Rep, typename _Period>
+    inline std::size_t IConnection::processPendingEvents(std::size_t maxCount, const std::chrono::duration<_Rep, _Period>& maxDuration)
+    {
+        auto microsecs = std::chrono::duration_cast<std::chrono::microseconds>(maxDuration);
+        return processPendingEvents(maxCount, microsecs);
+    }
+
     /*!
      * @brief Creates/opens D-Bus session bus connection when in a user context, and a system bus connection, otherwise.
      *
@@ -452,6 +1429,27 @@ namespace sdbus {
      */
     [[nodiscard]] std::unique_ptr<sdbus::IConnection> createBusConnection(const ServiceName& name);
 
+    /*!
+     * @brief Creates/opens D-Bus session bus connection when in a user context, and a system bus connection, otherwise, in the background
+     *
+     * @return Future object providing the connection instance
+     *
+     * The connection is opened, including the handshake with the bus broker, in a newly started thread,
+     * so that a process can open several connections in parallel. The future throws sdbus::Error
+     * in case of failure.
+     */
+    [[nodiscard]] std::future<std::unique_ptr<sdbus::IConnection>> createBusConnectionAsync();
+
+    /*!
+     * @brief Creates/opens D-Bus session bus connection with a name when in a user context, and a system bus connection with a name, otherwise, in the background
+     *
+     * @param[in] name Name to request on the connection after its opening
+     * @return Future object providing the connection instance
+     *
+     * Like createBusConnectionAsync() above, with the name being requested in the newly started thread as well.
+     */
+    [[nodiscard]] std::future<std::unique_ptr<sdbus::IConnection>> createBusConnectionAsync(const ServiceName& name);
+
     /*!
      * @brief Creates/opens D-Bus system bus connection
      *
@@ -471,6 +1469,25 @@ namespace sdbus {
      */
     [[nodiscard]] std::unique_ptr<sdbus::IConnection> createSystemBusConnection(const ServiceName& name);
 
+    /*!
+     * @brief Creates/opens D-Bus system bus connection in the background
+     *
+     * @return Future object providing the connection instance
+     *
+     * @see createBusConnectionAsync()
+     */
+    [[nodiscard]] std::future<std::unique_ptr<sdbus::IConnection>> createSystemBusConnectionAsync();
+
+    /*!
+     * @brief Creates/opens D-Bus system bus connection with a name in the background
+     *
+     * @param[in] name Name to request on the connection after its opening
+     * @return Future object providing the connection instance
+     *
+     * @see createBusConnectionAsync(const ServiceName&)
+     */
+    [[nodiscard]] std::future<std::unique_ptr<sdbus::IConnection>> createSystemBusConnectionAsync(const ServiceName& name);
+
     /*!
      * @brief Creates/opens D-Bus session bus connection
      *
@@ -490,6 +1507,25 @@ namespace sdbus {
      */
     [[nodiscard]] std::unique_ptr<sdbus::IConnection> createSessionBusConnection(const ServiceName& name);
 
+    /*!
+     * @brief Creates/opens D-Bus session bus connection in the background
+     *
+     * @return Future object providing the connection instance
+     *
+     * @see createBusConnectionAsync()
+     */
+    [[nodiscard]] std::future<std::unique_ptr<sdbus::IConnection>> createSessionBusConnectionAsync();
+
+    /*!
+     * @brief Creates/opens D-Bus session bus connection with a name in the background
+     *
+     * @param[in] name Name to request on the connection after its opening
+     * @return Future object providing the connection instance
+     *
+     * @see createBusConnectionAsync(const ServiceName&)
+     */
+    [[nodiscard]] std::future<std::unique_ptr<sdbus::IConnection>> createSessionBusConnectionAsync(const ServiceName& name);
+
     /*!
      * @brief Creates/opens D-Bus session bus connection at a custom address
      *
@@ -579,6 +1615,47 @@ namespace sdbus {
      * @endcode
      */
     [[nodiscard]] std::unique_ptr<sdbus::IConnection> createBusConnection(sd_bus *bus);
+
+    /*!
+     * @brief Kinds of threads created by sdbus-c++
+     */
+    enum class ThreadRole
+    {
+        EventLoop,          // Event loop thread of a connection (see IConnection::enterEventLoopAsync()) or of an IEventLoop
+        MethodCallDispatch, // Worker of a method call dispatch pool (see IConnection::enableMethodCallDispatchPool())
+        ConnectionSetup,    // Thread opening a connection in the background (see createBusConnectionAsync())
+        VTablePreparation   // Worker preparing vtables of a batch of objects (see IConnection::registerObjects())
+    };
+
+    /*!
+     * @struct ThreadAttributes
+     *
+     * Attributes applied to a thread created by sdbus-c++ before the thread starts its work.
+     * Unset attributes are left at what the thread inherits from its creator.
+     */
+    struct ThreadAttributes
+    {
+        std::string name;                       // Thread name. Only first 15 characters are used.
+        std::vector<unsigned int> cpuAffinity;  // CPUs the thread is allowed to run on
+        std::optional<int> schedulingPolicy;    // E.g. SCHED_OTHER, SCHED_FIFO or SCHED_RR
+        int schedulingPriority{};               // Static priority for the scheduling policy, e.g. 1-99 for SCHED_FIFO
+    };
+
+    using thread_creation_policy_t = std::function<ThreadAttributes(ThreadRole role)>;
+
+    /*!
+     * @brief Sets the policy for threads created by sdbus-c++
+     *
+     * @param[in] policy Callback returning attributes of a thread of the given role, or an empty function to reset the policy
+     *
+     * The policy applies to all threads sdbus-c++ creates from now on, including event loop threads of connections
+     * created implicitly, e.g. by proxies which are not given a connection. The callback is invoked in the creating
+     * thread, and the attributes are applied before the new thread does anything. Raising the scheduling policy
+     * or priority typically requires the CAP_SYS_NICE capability.
+     *
+     * @throws sdbus::Error at thread creation in case the attributes can't be applied
+     */
+    void setThreadCreationPolicy(thread_creation_policy_t policy);
 }
 
 #endif /* SDBUS_CXX_ICONNECTION_H_ */
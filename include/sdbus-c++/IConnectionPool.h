@@ -0,0 +1,125 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file IConnectionPool.h
+ *
+ * Created on: Oct 14, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_ICONNECTIONPOOL_H_
+#define SDBUS_CXX_ICONNECTIONPOOL_H_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+// Forward declarations
+namespace sdbus {
+    class IConnection;
+    class ObjectPath;
+}
+
+namespace sdbus {
+
+    /********************************************//**
+     * @class IConnectionPool
+     *
+     * A pool of bus connections to the same bus, for processes with many proxies.
+     * Instead of each proxy opening its own connection with its own event loop
+     * thread, or all proxies serializing on one shared connection, proxies are
+     * sharded across a fixed number of pooled connections, which gives parallel
+     * socket I/O. The pooled connections are driven by a smaller number of shared
+     * event loops (see IEventLoop), each running in its own thread.
+     *
+     * Proxies are assigned to connections by consistent hashing of their object
+     * paths, so a given object path always maps to the same connection, and thus
+     * calls and signals of one remote object stay ordered.
+     *
+     * Objects created upon pooled connections must be destroyed before the pool.
+     * All methods in this class are thread-safe.
+     *
+     ***********************************************/
+    class IConnectionPool
+    {
+    public:
+        virtual ~IConnectionPool() = default;
+
+        /*!
+         * @brief Returns the pooled connection that the given object path is sharded to
+         *
+         * @param[in] objectPath Object path of the proxy to be created upon the connection
+         * @return Reference to the pooled connection
+         */
+        [[nodiscard]] virtual IConnection& getConnection(const ObjectPath& objectPath) = 0;
+
+        /*!
+         * @brief Returns the pooled connection at the given position
+         *
+         * @param[in] index Position of the connection, lower than getConnectionCount()
+         * @return Reference to the pooled connection
+         *
+         * @throws sdbus::Error in case the index is out of range
+         */
+        [[nodiscard]] virtual IConnection& getConnection(std::size_t index) = 0;
+
+        /*!
+         * @brief Returns the number of pooled connections
+         */
+        [[nodiscard]] virtual std::size_t getConnectionCount() const = 0;
+    };
+
+    /*!
+     * @brief Creates a pool of connections to the default bus
+     *
+     * @param[in] connectionCount Number of pooled connections
+     * @param[in] eventLoopCount Number of event loop threads shared by the connections
+     * @return Connection pool instance
+     *
+     * The default bus is the same as the one createBusConnection() connects to.
+     *
+     * @throws sdbus::Error in case of failure
+     *
+     * Code example:
+     * @code
+     * auto pool = sdbus::createConnectionPool(8, 2);
+     * auto proxy = sdbus::createProxy(pool->getConnection(objectPath), destination, objectPath);
+     * @endcode
+     */
+    [[nodiscard]] std::unique_ptr<sdbus::IConnectionPool> createConnectionPool(std::size_t connectionCount, std::size_t eventLoopCount = 1);
+
+    /*!
+     * @brief Creates a pool of connections created by the given factory
+     *
+     * @param[in] connectionCount Number of pooled connections
+     * @param[in] eventLoopCount Number of event loop threads shared by the connections
+     * @param[in] connectionFactory Function creating a connection to be pooled, e.g. a lambda calling createSystemBusConnection()
+     * @return Connection pool instance
+     *
+     * The created connections must not run their own event loops.
+     *
+     * @throws sdbus::Error in case of failure
+     */
+    [[nodiscard]] std::unique_ptr<sdbus::IConnectionPool> createConnectionPool( std::size_t connectionCount
+                                                                              , std::size_t eventLoopCount
+                                                                              , std::function<std::unique_ptr<sdbus::IConnection>()> connectionFactory );
+}
+
+#endif /* SDBUS_CXX_ICONNECTIONPOOL_H_ */
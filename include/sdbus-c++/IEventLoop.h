@@ -0,0 +1,133 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file IEventLoop.h
+ *
+ * Created on: Oct 14, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_IEVENTLOOP_H_
+#define SDBUS_CXX_IEVENTLOOP_H_
+
+#include <memory>
+
+// Forward declarations
+namespace sdbus {
+    class IConnection;
+}
+
+namespace sdbus {
+
+    /********************************************//**
+     * @class IEventLoop
+     *
+     * An interface to a shared I/O event loop that drives many bus connections
+     * in a single thread. Instead of running one internal event loop thread per
+     * connection, connections are attached to the event loop, which multiplexes
+     * their file descriptors and timeouts through one epoll(7) instance.
+     *
+     * The event loop uses the same contract as external event loops do, i.e.
+     * IConnection::getEventLoopPollData() and IConnection::processPendingEvents().
+     * A connection attached to the event loop must therefore not run its own
+     * internal event loop, nor be attached to an sd-event loop at the same time.
+     *
+     * All methods throw sdbus::Error in case of failure. All methods in
+     * this class are thread-safe.
+     *
+     ***********************************************/
+    class IEventLoop
+    {
+    public:
+        virtual ~IEventLoop() = default;
+
+        /*!
+         * @brief Attaches a bus connection to the event loop
+         *
+         * @param[in] connection Bus connection to be driven by this event loop
+         *
+         * The connection can be attached at any time, also while the event
+         * loop is running. It must be detached before it's destroyed.
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        virtual void attach(IConnection& connection) = 0;
+
+        /*!
+         * @brief Detaches a bus connection from the event loop
+         *
+         * @param[in] connection Bus connection previously attached to this event loop
+         *
+         * Once the call returns, the event loop doesn't touch the connection anymore,
+         * so it may be safely destroyed. The method may also be called from within
+         * a callback handler of any connection of this event loop.
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        virtual void detach(IConnection& connection) = 0;
+
+        /*!
+         * @brief Runs the event loop
+         *
+         * Processes I/O events of all attached connections. The method blocks
+         * indefinitely, until unblocked through stop().
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        virtual void run() = 0;
+
+        /*!
+         * @brief Runs the event loop in a separate thread
+         *
+         * The same as run(), except that it doesn't block
+         * because it runs the loop in a separate, internally managed thread.
+         */
+        virtual void runAsync() = 0;
+
+        /*!
+         * @brief Stops the event loop
+         *
+         * Makes run() return, and joins with the internal event loop
+         * thread, if the loop was started through runAsync().
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        virtual void stop() = 0;
+    };
+
+    /*!
+     * @brief Creates an epoll-based event loop for driving multiple bus connections
+     *
+     * @return Event loop instance
+     *
+     * @throws sdbus::Error in case of failure
+     *
+     * Code example:
+     * @code
+     * auto loop = sdbus::createEventLoop();
+     * loop->attach(*systemBusConnection);
+     * loop->attach(*sessionBusConnection);
+     * loop->runAsync();
+     * @endcode
+     */
+    [[nodiscard]] std::unique_ptr<sdbus::IEventLoop> createEventLoop();
+}
+
+#endif /* SDBUS_CXX_IEVENTLOOP_H_ */
@@ -0,0 +1,169 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file IMessageBridge.h
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_IMESSAGEBRIDGE_H_
+#define SDBUS_CXX_IMESSAGEBRIDGE_H_
+
+#include <sdbus-c++/Message.h>
+#include <sdbus-c++/TypeTraits.h>
+#include <sdbus-c++/Types.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+// Forward declarations
+namespace sdbus {
+    class IConnection;
+}
+
+namespace sdbus {
+
+    /********************************************//**
+     * @class IMessageBridge
+     *
+     * Relays messages received on a source bus connection to a target bus
+     * connection, e.g. from the system bus to a private bus. A relayed message
+     * is re-addressed by building a new message header on the target connection,
+     * while its body is copied as is, without deserializing and serializing
+     * the contained values again. Arrays of fixed-size elements are copied
+     * as single blocks of memory.
+     *
+     * Replies to relayed method calls, including error replies, are routed
+     * back to the original callers automatically. Calls that are still pending
+     * when the bridge is destroyed are replied to with an error.
+     *
+     * Messages are relayed by the event loop of the connection they are sent
+     * on: method calls and signals by the loop of the target connection, and
+     * replies by the loop of the source connection. Both connections must thus
+     * run an event loop, either each its own thread or a shared one (see
+     * IEventLoop). Both connections must outlive the bridge, and the bridge
+     * must outlive the slots of its routes.
+     *
+     * All methods throw sdbus::Error in case of failure. All methods in
+     * this class are thread-safe.
+     *
+     ***********************************************/
+    class IMessageBridge
+    {
+    public:
+        virtual ~IMessageBridge() = default;
+
+        /*!
+         * @brief Relays a signal received on the source connection to the target connection
+         *
+         * @param[in] signal Signal received on the source connection
+         * @param[in] objectPath Path of the object emitting the relayed signal
+         *
+         * The relayed signal keeps the interface and the member name of the original one.
+         * The signal is relayed by the event loop of the target connection, which drops
+         * it in case of failure.
+         */
+        virtual void forwardSignal(const Signal& signal, const ObjectPath& objectPath) = 0;
+
+        /*!
+         * @brief Relays a method call received on the source connection to the target connection
+         *
+         * @param[in] call Method call received on the source connection, e.g. in a method callback
+         * @param[in] destination Bus name of the service the call is relayed to
+         * @param[in] objectPath Path of the object the call is relayed to
+         *
+         * The relayed call keeps the interface and the member name of the original one. Once the
+         * reply arrives, it's sent back as the reply to the original call, so the caller of this
+         * function must not reply to the original call itself. The call is relayed by the event
+         * loop of the target connection. If it cannot be relayed, the original call is replied to
+         * with the error, unless it expects no reply, in which case the failure is dropped.
+         */
+        virtual void forwardMethodCall(const MethodCall& call, const ServiceName& destination, const ObjectPath& objectPath) = 0;
+
+        /*!
+         * @brief Relays all signals matching the given match rule to the target connection
+         *
+         * @param[in] match Match rule of the signals to relay, received on the source connection
+         * @return RAII-style slot handle representing the ownership of the route
+         *
+         * The signals are relayed under their original object paths. The route is removed
+         * when the returned slot is destroyed.
+         *
+         * Code example:
+         * @code
+         * auto route = bridge->forwardSignals("type='signal',sender='org.sdbuscpp.sensors',interface='org.sdbuscpp.Sensor'", sdbus::return_slot);
+         * @endcode
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        [[nodiscard]] virtual Slot forwardSignals(const std::string& match, return_slot_t) = 0;
+
+        /*!
+         * @brief Relays all method calls to objects under the given path prefix to the target connection
+         *
+         * @param[in] sourcePrefix Object path prefix the method calls arrive at on the source connection
+         * @param[in] destination Bus name of the service the calls are relayed to
+         * @param[in] targetPrefix Object path prefix the calls are relayed to, replacing the source prefix
+         * @return RAII-style slot handle representing the ownership of the route
+         *
+         * Method calls to the source prefix itself and to any object path below it are relayed,
+         * e.g. a call to `/org/sdbuscpp/bridge/sensors/1` is relayed to `/org/sdbuscpp/sensors/1`
+         * for the source prefix `/org/sdbuscpp/bridge` and the target prefix `/org/sdbuscpp`.
+         * Objects registered on the source connection under the prefix take precedence over the route.
+         * The route is removed when the returned slot is destroyed.
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        [[nodiscard]] virtual Slot forwardMethodCalls( const ObjectPath& sourcePrefix
+                                                     , const ServiceName& destination
+                                                     , const ObjectPath& targetPrefix
+                                                     , return_slot_t ) = 0;
+
+        /*!
+         * @brief Returns the number of relayed method calls waiting for their replies
+         */
+        [[nodiscard]] virtual std::size_t getPendingCallCount() const = 0;
+    };
+
+    /*!
+     * @brief Creates a bridge relaying messages from one bus connection to another
+     *
+     * @param[in] source Connection the relayed messages are received on
+     * @param[in] target Connection the relayed messages are sent on
+     * @return Message bridge instance
+     *
+     * @throws sdbus::Error in case of failure
+     *
+     * Code example:
+     * @code
+     * auto bridge = sdbus::createMessageBridge(*systemBusConnection, *privateBusConnection);
+     * auto route = bridge->forwardMethodCalls( sdbus::ObjectPath{"/org/sdbuscpp/bridge"}
+     *                                        , sdbus::ServiceName{"org.sdbuscpp.backend"}
+     *                                        , sdbus::ObjectPath{"/org/sdbuscpp"}
+     *                                        , sdbus::return_slot );
+     * @endcode
+     */
+    [[nodiscard]] std::unique_ptr<sdbus::IMessageBridge> createMessageBridge(IConnection& source, IConnection& target);
+
+}
+
+#endif /* SDBUS_CXX_IMESSAGEBRIDGE_H_ */
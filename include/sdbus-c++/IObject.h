@@ -32,8 +32,10 @@
 #include <sdbus-c++/TypeTraits.h>
 #include <sdbus-c++/VTableItems.h>
 
+#include <chrono>
 #include <functional>
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -62,6 +64,8 @@ namespace sdbus {
     class IObject
     {
     public: // High-level, convenience API
+        struct ResourceUsage;
+
         virtual ~IObject() = default;
 
         /*!
@@ -193,6 +197,29 @@ namespace sdbus {
          */
         virtual void emitPropertiesChangedSignal(const char* interfaceName) = 0;
 
+        /*!
+         * @brief Turns on coalescing of PropertiesChanged signals emitted by this object
+         *
+         * @param[in] interval Time over which property changes are collected before they're emitted
+         *
+         * With coalescing on, emitPropertiesChangedSignal() doesn't emit the signal right away, but marks
+         * the properties as changed. Once the interval since the first unemitted change of an interface
+         * elapses, a single PropertiesChanged signal is emitted for the interface from the event loop
+         * of the connection, carrying all properties changed in the meantime, with their current values.
+         * An interval of zero emits the merged signal in the next event loop iteration.
+         *
+         * This is useful for properties that change much more often than clients need to know about.
+         * The connection must be running an event loop for coalesced signals to be emitted.
+         */
+        virtual void enablePropertiesChangedCoalescing(std::chrono::microseconds interval = {}) = 0;
+
+        /*!
+         * @brief Turns off coalescing of PropertiesChanged signals
+         *
+         * Changes that have already been collected are still emitted when their interval elapses.
+         */
+        virtual void disablePropertiesChangedCoalescing() = 0;
+
         /*!
          * @brief Emits InterfacesAdded signal on this object path
          *
@@ -297,6 +324,18 @@ namespace sdbus {
          */
         [[nodiscard]] virtual Message getCurrentlyProcessedMessage() const = 0;
 
+        /*!
+         * @brief Returns counts and approximate memory footprint of the registrations of the object
+         *
+         * @return Current resource usage of the object
+         *
+         * Reports vtables and subtree enumerators whose lifetime is tied to the object, the methods,
+         * signals and properties they declare, and the entries of the property value cache.
+         * Registrations owned by returned slots are not included. The function is thread-safe,
+         * and cheap enough to be called periodically in production.
+         */
+        [[nodiscard]] virtual ResourceUsage getResourceUsage() const = 0;
+
         /*!
          * @brief Unregisters object's API and removes object from the bus
          *
@@ -390,6 +429,107 @@ namespace sdbus {
          */
         [[nodiscard]] virtual Slot addVTable(InterfaceName interfaceName, std::vector<VTableItem> vtable, return_slot_t) = 0;
 
+        /*!
+         * @brief Adds a vtable of a prepared static layout, implemented by the given handlers
+         *
+         * @param[in] vtable Static vtable layout, which must outlive the registration
+         * @param[in] handlers Handlers of the methods and properties of the layout, in the order of their layout items
+         *
+         * This is a counterpart of addVTable(InterfaceName, std::vector<VTableItem>) for services registering
+         * many objects of the same kind, typically through generated adaptors. The layout is shared, so only
+         * the handlers are taken over for each object, and the registration amounts to handing them over to sd-bus.
+         *
+         * Handlers are created by implementMethod() for methods and by implementProperty() for properties.
+         * Writable properties require a setter.
+         *
+         * The function provides strong exception guarantee. The state of the object remains
+         * unmodified in face of an exception.
+         *
+         * @throws sdbus::Error in case of failure, or if the handlers don't match the layout
+         */
+        virtual void addVTable(const StaticVTable& vtable, std::vector<VTableHandler> handlers) = 0;
+
+        /*!
+         * @copydoc IObject::addVTable(const StaticVTable&,std::vector<VTableHandler>)
+         *
+         * The internal registration slot is returned to the caller, who should destroy it once the vtable
+         * is not needed anymore.
+         */
+        [[nodiscard]] virtual Slot addVTable(const StaticVTable& vtable, std::vector<VTableHandler> handlers, return_slot_t) = 0;
+
+        /*!
+         * @brief Adds a vtable shared by the whole object subtree rooted at the path of this object
+         *
+         * @param[in] interfaceName Name of an interface the the vtable is registered for
+         * @param[in] vtable A list of individual descriptions in the form of VTable item instances
+         * @param[in] finder Callback telling whether an object exists at the given path in the subtree
+         *
+         * This is the lazy counterpart of addVTable() for large object trees. Instead of registering
+         * one vtable per object, a single vtable serves the object at this object's path and all objects
+         * below it (the subtree), for which the `finder' returns true. The finder is consulted by sd-bus
+         * lazily, on each incoming call and introspection request, so the existence of objects as well as
+         * their state are resolved only when they are accessed. An empty finder accepts every path.
+         *
+         * Callback handlers of the vtable learn the path of the actual object being accessed from
+         * the currently processed message (see getCurrentlyProcessedMessage(), or MethodCall::getPath()).
+         *
+         * Consult manual pages for the underlying `sd_bus_add_fallback_vtable` function for more information.
+         *
+         * The method can be called at any time during object's lifetime. For each vtable an internal
+         * registration slot is created and its lifetime is tied to the lifetime of the Object instance.
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        virtual void addSubtreeVTable(InterfaceName interfaceName, std::vector<VTableItem> vtable, object_finder finder) = 0;
+
+        /*!
+         * @brief Adds a vtable shared by the whole object subtree rooted at the path of this object
+         *
+         * @param[in] interfaceName Name of an interface the the vtable is registered for
+         * @param[in] vtable A list of individual descriptions in the form of VTable item instances
+         * @param[in] finder Callback telling whether an object exists at the given path in the subtree
+         * @return Slot handle owning the registration
+         *
+         * See the floating variant of addSubtreeVTable() for details. The lifetime of the vtable
+         * registration is bound to the lifetime of the returned slot instance.
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        [[nodiscard]] virtual Slot addSubtreeVTable( InterfaceName interfaceName
+                                                   , std::vector<VTableItem> vtable
+                                                   , object_finder finder
+                                                   , return_slot_t ) = 0;
+
+        /*!
+         * @brief Adds an enumerator of objects in the subtree rooted at the path of this object
+         *
+         * @param[in] enumerator Callback returning paths of existing objects under the given prefix
+         *
+         * Objects served by subtree vtables (see addSubtreeVTable()) don't exist as individual
+         * registrations, so sd-bus calls the enumerator to list them lazily for introspection
+         * of their parent nodes and for the ObjectManager's GetManagedObjects method.
+         *
+         * Consult manual pages for the underlying `sd_bus_add_node_enumerator` function for more information.
+         *
+         * The lifetime of the registration is tied to the lifetime of the Object instance.
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        virtual void addSubtreeEnumerator(object_enumerator enumerator) = 0;
+
+        /*!
+         * @brief Adds an enumerator of objects in the subtree rooted at the path of this object
+         *
+         * @param[in] enumerator Callback returning paths of existing objects under the given prefix
+         * @return Slot handle owning the registration
+         *
+         * See the floating variant of addSubtreeEnumerator() for details. The lifetime of the
+         * registration is bound to the lifetime of the returned slot instance.
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        [[nodiscard]] virtual Slot addSubtreeEnumerator(object_enumerator enumerator, return_slot_t) = 0;
+
         /*!
          * @brief Creates a signal message
          *
@@ -405,6 +545,13 @@ namespace sdbus {
          */
         [[nodiscard]] virtual Signal createSignal(const InterfaceName& interfaceName, const SignalName& signalName) const = 0;
 
+        /*!
+         * @copydoc IObject::createSignal(const InterfaceName&,const SignalName&)
+         *
+         * This overload takes non-owning names (e.g. constexpr constants), so no names are allocated.
+         */
+        [[nodiscard]] Signal createSignal(InterfaceNameView interfaceName, SignalNameView signalName) const;
+
         /*!
          * @brief Emits signal for this object path
          *
@@ -416,14 +563,73 @@ namespace sdbus {
          */
         virtual void emitSignal(const sdbus::Signal& message) = 0;
 
+        /*!
+         * @brief Emits a batch of signals for this object path
+         *
+         * @param[in] messages Signal messages to be sent out, in order
+         *
+         * This is meant for bursts of many signals. Compared to calling emitSignal() for each
+         * of them, all the signals are queued for sending under a single acquisition of the
+         * connection's bus lock, and the event loop is woken up at most once for the whole batch.
+         * The signals shall have been created by this object (or on its connection).
+         *
+         * If sending of a signal fails, the error is thrown and signals following it are
+         * not sent. Signals preceding it have been sent already.
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        virtual void emitSignals(std::span<const sdbus::Signal> messages) = 0;
+
     protected: // Internal API for efficiency reasons used by high-level API helper classes
         friend SignalEmitter;
 
         [[nodiscard]] virtual Signal createSignal(const char* interfaceName, const char* signalName) const = 0;
+
+    public:
+        /*!
+         * @struct ResourceUsage
+         *
+         * Carries counts of registrations held by the object, and their approximate size.
+         *
+         * See getResourceUsage() for more info.
+         */
+        struct ResourceUsage
+        {
+            std::size_t vtables{};              // Registered vtables, including subtree vtables
+            std::size_t methods{};              // Methods declared by the vtables
+            std::size_t signals{};              // Signals declared by the vtables
+            std::size_t properties{};           // Properties declared by the vtables
+            std::size_t subtreeEnumerators{};   // Registered subtree enumerators
+            std::size_t cachedPropertyValues{}; // Entries of the property value cache
+            // Memory held by the records above, as far as sdbus-c++ allocates it for the object. Vtable
+            // descriptors, shared by all objects registering vtables of the same shape, memory of sd-bus
+            // and captures of user callbacks are not included.
+            std::size_t approximateBytes{};
+        };
+    };
+
+    /********************************************//**
+     * @struct ObjectRegistration
+     *
+     * A vtable to be registered for an object at a given interface, as an item
+     * of a bulk registration through IConnection::registerObjects(). The vtable
+     * has the same form as that of IObject::addVTable().
+     *
+     ***********************************************/
+    struct ObjectRegistration
+    {
+        IObject& object;
+        InterfaceName interfaceName;
+        std::vector<VTableItem> vtable;
     };
 
     // Out-of-line member definitions
 
+    inline Signal IObject::createSignal(InterfaceNameView interfaceName, SignalNameView signalName) const
+    {
+        return createSignal(interfaceName.c_str(), signalName.c_str());
+    }
+
     inline SignalEmitter IObject::emitSignal(const SignalName& signalName)
     {
         return SignalEmitter(*this, signalName);
@@ -0,0 +1,213 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file IPeerServer.h
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_IPEERSERVER_H_
+#define SDBUS_CXX_IPEERSERVER_H_
+
+#include <sdbus-c++/Message.h>
+#include <sdbus-c++/Types.h>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+// Forward declarations
+namespace sdbus {
+    class IConnection;
+    class IEventLoop;
+}
+
+namespace sdbus {
+
+    /********************************************//**
+     * @class IBroadcastGroup
+     *
+     * A group of bus connections that signals are broadcast to, typically
+     * the per-client connections of a direct peer-to-peer server. The signal
+     * arguments are serialized only once per broadcast, and the serialized
+     * body is then copied into a signal message for each member connection,
+     * instead of serializing the arguments anew for each connection.
+     *
+     * Member connections are not owned by the group. A member connection
+     * destroyed without having been removed leaves the group on its own
+     * at the beginning of its destruction. Members are meant to be
+     * driven by one shared event loop (see IEventLoop); broadcasting from
+     * handlers of connections running their own event loop threads may
+     * deadlock on the per-connection sd-bus locks.
+     *
+     * All methods throw sdbus::Error in case of failure. All methods in
+     * this class are thread-safe.
+     *
+     ***********************************************/
+    class IBroadcastGroup
+    {
+    public:
+        virtual ~IBroadcastGroup() = default;
+
+        /*!
+         * @brief Adds a bus connection to the group
+         *
+         * @throws sdbus::Error in case the connection is already a member, or is not a real sdbus-c++ connection
+         */
+        virtual void add(IConnection& connection) = 0;
+
+        /*!
+         * @brief Removes a bus connection from the group
+         *
+         * Once the call returns, no broadcast touches the connection anymore. The call waits for broadcasts in progress that
+         * may still be sending to the connection, so it must not be called from
+         * within a callback handler of a member connection.
+         *
+         * @throws sdbus::Error in case the connection is not a member
+         */
+        virtual void remove(IConnection& connection) = 0;
+
+        /*!
+         * @brief Returns the number of member connections
+         */
+        [[nodiscard]] virtual std::size_t getConnectionCount() const = 0;
+
+        /*!
+         * @brief Broadcasts a signal with pre-serialized arguments to all member connections
+         *
+         * @param[in] objectPath Path of the object emitting the signal
+         * @param[in] interfaceName Interface the signal belongs to
+         * @param[in] signalName Name of the signal
+         * @param[in] arguments Message holding the serialized signal arguments, e.g. created by createPlainMessage()
+         * @return Number of member connections the signal was sent to
+         *
+         * The arguments message gets sealed by the first broadcast, and may then be broadcast again.
+         * Connections closed by their peers in the meantime are skipped.
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        virtual std::size_t broadcast( const ObjectPath& objectPath
+                                     , const InterfaceName& interfaceName
+                                     , const SignalName& signalName
+                                     , PlainMessage& arguments ) = 0;
+
+        /*!
+         * @brief Serializes the given signal arguments once and broadcasts the signal to all member connections
+         *
+         * @return Number of member connections the signal was sent to
+         *
+         * Code example:
+         * @code
+         * group.broadcastSignal(objectPath, interfaceName, sdbus::SignalName{"measured"}, sensorId, value);
+         * @endcode
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        template <typename... _Args>
+        std::size_t broadcastSignal( const ObjectPath& objectPath
+                                   , const InterfaceName& interfaceName
+                                   , const SignalName& signalName
+                                   , const _Args&... args );
+    };
+
+    /********************************************//**
+     * @class IPeerServer
+     *
+     * A direct peer-to-peer D-Bus server. It accepts clients on a listening
+     * socket, creates a server bus connection for each of them, and drives all
+     * these connections in a shared event loop (see IEventLoop), so that hundreds
+     * of clients don't need hundreds of event loop threads. Each client connection
+     * is a member of the server's broadcast group until the client disconnects.
+     *
+     * The peer handlers are invoked in the event loop thread, except that the
+     * disconnected handler is invoked for clients still connected when the server
+     * gets destroyed in the destroying thread. Objects created upon a client
+     * connection in the connected handler must be destroyed in the disconnected
+     * handler at the latest.
+     *
+     * All methods in this class are thread-safe.
+     *
+     ***********************************************/
+    class IPeerServer
+    {
+    public:
+        virtual ~IPeerServer() = default;
+
+        /*!
+         * @brief Returns the broadcast group of all connected clients
+         */
+        [[nodiscard]] virtual IBroadcastGroup& getBroadcastGroup() = 0;
+
+        /*!
+         * @brief Returns the number of connected clients
+         */
+        [[nodiscard]] virtual std::size_t getPeerCount() const = 0;
+    };
+
+    using peer_handler = std::function<void(IConnection& connection)>;
+
+    /*!
+     * @brief Creates a broadcast group
+     *
+     * @return Broadcast group instance
+     */
+    [[nodiscard]] std::unique_ptr<sdbus::IBroadcastGroup> createBroadcastGroup();
+
+    /*!
+     * @brief Creates a direct peer-to-peer server accepting clients on the given socket
+     *
+     * @param[in] listeningFd Listening socket, which stays owned by the caller and must outlive the server
+     * @param[in] eventLoop Event loop created by createEventLoop(), which drives the server and must outlive it
+     * @param[in] onPeerConnected Handler invoked with the connection of each newly accepted client
+     * @param[in] onPeerDisconnected Handler invoked with the connection of each client that has disconnected, before it's destroyed
+     * @return Server instance
+     *
+     * @throws sdbus::Error in case of failure
+     *
+     * Code example:
+     * @code
+     * auto eventLoop = sdbus::createEventLoop();
+     * auto server = sdbus::createPeerServer(listeningFd, *eventLoop, [&](sdbus::IConnection& connection){ registerObjects(connection); }
+     *                                                                 , [&](sdbus::IConnection& connection){ unregisterObjects(connection); });
+     * eventLoop->runAsync();
+     * server->getBroadcastGroup().broadcastSignal(objectPath, interfaceName, sdbus::SignalName{"changed"}, state);
+     * @endcode
+     */
+    [[nodiscard]] std::unique_ptr<sdbus::IPeerServer> createPeerServer( int listeningFd
+                                                                       , IEventLoop& eventLoop
+                                                                       , peer_handler onPeerConnected = {}
+                                                                       , peer_handler onPeerDisconnected = {} );
+
+    template <typename... _Args>
+    inline std::size_t IBroadcastGroup::broadcastSignal( const ObjectPath& objectPath
+                                                       , const InterfaceName& interfaceName
+                                                       , const SignalName& signalName
+                                                       , const _Args&... args )
+    {
+        auto arguments = createPlainMessage();
+        (void)(arguments << ... << args);
+
+        return broadcast(objectPath, interfaceName, signalName, arguments);
+    }
+
+}
+
+#endif /* SDBUS_CXX_IPEERSERVER_H_ */
@@ -28,14 +28,22 @@
 #define SDBUS_CXX_IPROXY_H_
 
 #include <sdbus-c++/ConvenienceApiClasses.h>
+#include <sdbus-c++/Error.h>
 #include <sdbus-c++/TypeTraits.h>
 
+#include <atomic>
 #include <chrono>
+#include <coroutine>
+#include <cstddef>
 #include <functional>
 #include <future>
 #include <memory>
+#include <new>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <tuple>
+#include <vector>
 
 // Forward declarations
 namespace sdbus {
@@ -44,6 +52,7 @@ namespace sdbus {
     class IConnection;
     class ObjectPath;
     class PendingAsyncCall;
+    class PreparedMethodCall;
     namespace internal {
         class Proxy;
     }
@@ -68,6 +77,8 @@ namespace sdbus {
     class IProxy
     {
     public: // High-level, convenience API
+        struct ResourceUsage;
+
         virtual ~IProxy() = default;
 
         /*!
@@ -88,6 +99,19 @@ namespace sdbus {
          * object_.callMethod(multiply).onInterface(INTERFACE_NAME).withArguments(a, b).storeResultsTo(result);
          * @endcode
          *
+         * Results of methods that never change within the lifetime of the remote service (e.g. version
+         * or capabilities queries) can be cached by the proxy, so that repeated calls cost no bus traffic.
+         * With cacheResults() or cacheResultsFor(ttl) placed before withArguments(), successful results
+         * are kept per interface, method and serialized arguments, either until the owner of the destination
+         * service name changes, or for the given time-to-live at most. Errors are never cached, and
+         * calls with unix fd arguments always go to the remote object. Detecting the owner change relies
+         * on an event loop processing incoming signals on the proxy's connection.
+         *
+         * @code
+         * std::string version;
+         * object_.callMethod("GetVersion").onInterface(INTERFACE_NAME).cacheResults().storeResultsTo(version);
+         * @endcode
+         *
          * @throws sdbus::Error in case of failure
          */
         [[nodiscard]] MethodInvoker callMethod(const MethodName& methodName);
@@ -290,6 +314,14 @@ namespace sdbus {
          * auto props = object.getAllProperties().onInterface("com.kistler.foo");
          * @endcode
          *
+         * The properties can also be decoded right into the members of a user-defined struct
+         * registered through SDBUSCPP_REGISTER_STRUCT, with no intermediate map and variants.
+         * Properties that have no counterpart struct member are skipped then:
+         * @code
+         * auto props = object.getAllProperties().onInterface<FooProperties>("com.kistler.foo");
+         * object.getAllProperties().storeResultsTo("com.kistler.foo", existingFooProperties);
+         * @endcode
+         *
          * @throws sdbus::Error in case of failure
          */
         [[nodiscard]] AllPropertiesGetter getAllProperties();
@@ -339,6 +371,105 @@ namespace sdbus {
          */
         [[nodiscard]] virtual Message getCurrentlyProcessedMessage() const = 0;
 
+        /*!
+         * @brief Limits the number of async method calls that may be in flight at the same time
+         *
+         * @param[in] maxCount Maximum number of pending async calls, or 0 for no limit (the default)
+         *
+         * Async calls are pipelined: they are sent out immediately, without waiting for replies
+         * to calls issued earlier. Once @p maxCount calls are pending, any further callMethodAsync()
+         * invocation on this proxy throws sdbus::Error (with EBUSY errno) instead of sending
+         * the message, until a pending call completes or is cancelled. This provides backpressure
+         * to clients that issue calls faster than the remote side is able to serve them.
+         *
+         * A call stops being pending right before its reply callback is invoked, so a new call
+         * may be issued from within the callback.
+         */
+        virtual void setMaxPendingAsyncCalls(std::size_t maxCount) = 0;
+
+        /*!
+         * @brief Returns the number of async method calls of this proxy currently waiting for a reply
+         */
+        [[nodiscard]] virtual std::size_t getPendingAsyncCallCount() const = 0;
+
+        /*!
+         * @brief Returns counts and approximate memory footprint of the bookkeeping of the proxy
+         *
+         * @return Current resource usage of the proxy
+         *
+         * Reports signal handlers and async calls whose lifetime is tied to the proxy, async
+         * calls pending overall, and the entries of the property and method result caches.
+         * The function only takes the locks of the respective containers briefly, so it's cheap
+         * enough to be called periodically in production. It's thread-safe. The values are not
+         * taken atomically as a whole.
+         */
+        [[nodiscard]] virtual ResourceUsage getResourceUsage() const = 0;
+
+        /*!
+         * @brief Makes the proxy serve all signal handlers of one interface through one D-Bus match rule
+         *
+         * @param[in] enabled Whether signal handlers registered from now on are aggregated
+         *
+         * By default, each signal handler registration installs its own match rule, both in
+         * the bus daemon and in the local sd-bus match list, which is scanned linearly for
+         * each incoming message. With aggregation enabled, the first handler for an interface
+         * installs one match for all signals of that interface (from the proxy's destination
+         * and object path), and incoming signals are dispatched to their handlers in-process
+         * by a hash lookup of the signal name. This saves daemon match rules and per-message
+         * matching cost for proxies subscribing to many signals of the same interface.
+         *
+         * The setting affects signal handlers registered after the call, so generated proxies
+         * should enable it before calling registerProxy(). Slots returned for aggregated
+         * handlers must not outlive the proxy.
+         */
+        virtual void enableSignalMatchAggregation(bool enabled = true) = 0;
+
+        /*!
+         * @brief Makes the proxy install D-Bus match rules of its signal handlers asynchronously
+         *
+         * @param[in] enabled Whether match rules of signal handlers registered from now on are installed asynchronously
+         * @param[in] installHandler Optional callback reporting that the match rules being installed are in place
+         *
+         * By default, registering a signal handler waits for the bus daemon to confirm the installation
+         * of its match rule (the AddMatch call), so a proxy subscribing to many signals makes as many
+         * blocking round trips in its construction. With asynchronous installation enabled, registration
+         * only sends out the AddMatch call, so match rules of all signal handlers of the proxy (and of
+         * all proxies on the connection) are installed in a pipelined fashion. Signals emitted before
+         * the installation of a match rule completes are not received, though.
+         *
+         * The install handler, if provided, is invoked in the event loop thread of the connection each
+         * time the last of the installations in progress completes. It's given the first error of the
+         * installations that failed since its previous invocation, if any. A signal handler unregistered
+         * before the installation of its match rule completes is not waited for. If it was the last one
+         * in progress, the handler is invoked for the installations that did complete, in the thread
+         * unregistering the signal handler.
+         *
+         * The setting affects signal handlers registered after the call, so generated proxies
+         * should enable it before calling registerProxy(). It requires an event loop running on
+         * the connection.
+         */
+        virtual void enableAsyncSignalMatchInstallation(bool enabled = true, signal_match_install_handler installHandler = {}) = 0;
+
+        /*!
+         * @brief Makes the proxy answer property reads from a client-side cache of the remote object's properties
+         *
+         * @param[in] enabled Whether property reads are served from the cache
+         *
+         * With the cache enabled, the first read of a property of an interface fetches all properties
+         * of that interface in one GetAll call, and further reads through getProperty() (and thus through
+         * Properties_proxy::Get() and generated property getters) are answered locally. The cache is kept
+         * up to date by the PropertiesChanged signal of the remote object. A property reported as
+         * invalidated is re-fetched by a Get call upon its next read, and the whole cache is dropped when
+         * the owner of the destination service name changes.
+         *
+         * The cache is only suitable for properties which announce their changes via PropertiesChanged,
+         * and it relies on an event loop processing incoming signals on the proxy's connection.
+         * Asynchronous property reads always go to the remote object. Disabling the cache drops it.
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        virtual void enablePropertyCache(bool enabled = true) = 0;
+
         /*!
          * @brief Unregisters proxy's signal handlers and stops receiving replies to pending async calls
          *
@@ -366,6 +497,29 @@ namespace sdbus {
          */
         [[nodiscard]] virtual MethodCall createMethodCall(const InterfaceName& interfaceName, const MethodName& methodName) const = 0;
 
+        /*!
+         * @copydoc IProxy::createMethodCall(const InterfaceName&,const MethodName&)
+         *
+         * This overload takes non-owning names (e.g. constexpr constants), so no names are allocated.
+         */
+        [[nodiscard]] MethodCall createMethodCall(InterfaceNameView interfaceName, MethodNameView methodName) const;
+
+        /*!
+         * @brief Prepares a reusable template for creating method call messages of a given method
+         *
+         * @param[in] interfaceName Name of an interface that provides a given method
+         * @param[in] methodName Name of the method
+         * @return A prepared method call object
+         *
+         * The interface and method names are validated once here, and are kept by the returned
+         * object, so that method call messages for a frequently invoked method can be created
+         * repeatedly through PreparedMethodCall::createMethodCall() without constructing and
+         * passing the names again. The prepared method call must not outlive the proxy.
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        [[nodiscard]] virtual PreparedMethodCall prepareMethodCall(InterfaceName interfaceName, MethodName methodName) const = 0;
+
         /*!
          * @brief Calls method on the remote D-Bus object
          *
@@ -379,7 +533,11 @@ namespace sdbus {
          * or until the call times out.
          *
          * While blocking, other concurrent operations (in other threads) on the underlying bus
-         * connection are stalled until the call returns. This is not an issue in vast majority of
+         * connection are stalled until the call returns, unless the connection runs its event loop
+         * in an internal thread (see IConnection::enterEventLoopAsync()) and the call is made from
+         * another thread. The reply is then received by the event loop thread, and the connection
+         * keeps serving other messages, including concurrent synchronous calls, in the meantime.
+         * Otherwise, this is not an issue in vast majority of
          * (simple, single-threaded) applications. In asynchronous, multi-threaded designs involving
          * shared bus connections, this may be an issue. It is advised to instead use an asynchronous
          * callMethod() function overload, which does not block the bus connection, or do the synchronous
@@ -410,7 +568,11 @@ namespace sdbus {
          * or until the call times out.
          *
          * While blocking, other concurrent operations (in other threads) on the underlying bus
-         * connection are stalled until the call returns. This is not an issue in vast majority of
+         * connection are stalled until the call returns, unless the connection runs its event loop
+         * in an internal thread (see IConnection::enterEventLoopAsync()) and the call is made from
+         * another thread. The reply is then received by the event loop thread, and the connection
+         * keeps serving other messages, including concurrent synchronous calls, in the meantime.
+         * Otherwise, this is not an issue in vast majority of
          * (simple, single-threaded) applications. In asynchronous, multi-threaded designs involving
          * shared bus connections, this may be an issue. It is advised to instead use an asynchronous
          * callMethod() function overload, which does not block the bus connection, or do the synchronous
@@ -433,6 +595,41 @@ namespace sdbus {
         template <typename _Rep, typename _Period>
         MethodReply callMethod(const MethodCall& message, const std::chrono::duration<_Rep, _Period>& timeout);
 
+        /*!
+         * @brief Calls method on the remote D-Bus object, without throwing in case of an error
+         *
+         * @param[in] message Message representing a method call
+         * @return A method reply message, or an error
+         *
+         * This is a non-throwing variant of callMethod(const MethodCall&). D-Bus errors returned
+         * by the remote side, as well as local failures, are returned in the result instead of being
+         * thrown. This spares the cost of exception unwinding where errors are a common outcome.
+         *
+         * The default D-Bus method call timeout is used. See IConnection::getMethodCallTimeout().
+         */
+        virtual Expected<MethodReply> callMethod(const MethodCall& message, std::nothrow_t) = 0;
+
+        /*!
+         * @brief Calls method on the remote D-Bus object, without throwing in case of an error
+         *
+         * @param[in] message Message representing a method call
+         * @param[in] timeout Method call timeout (in microseconds)
+         * @return A method reply message, or an error
+         *
+         * This is a non-throwing variant of callMethod(const MethodCall&,uint64_t). D-Bus errors returned
+         * by the remote side, as well as local failures, are returned in the result instead of being
+         * thrown. This spares the cost of exception unwinding where errors are a common outcome.
+         *
+         * If timeout is zero, the default D-Bus method call timeout is used. See IConnection::getMethodCallTimeout().
+         */
+        virtual Expected<MethodReply> callMethod(const MethodCall& message, uint64_t timeout, std::nothrow_t) = 0;
+
+        /*!
+         * @copydoc IProxy::callMethod(const MethodCall&,uint64_t,std::nothrow_t)
+         */
+        template <typename _Rep, typename _Period>
+        Expected<MethodReply> callMethod(const MethodCall& message, const std::chrono::duration<_Rep, _Period>& timeout, std::nothrow_t);
+
         /*!
          * @brief Calls method on the D-Bus object asynchronously
          *
@@ -647,10 +844,72 @@ namespace sdbus {
                                                         , signal_handler signalHandler
                                                         , return_slot_t ) = 0;
 
+        /*!
+         * @copydoc IProxy::registerSignalHandler(const InterfaceName&,const SignalName&,signal_handler)
+         *
+         * This overload takes non-owning names (e.g. constexpr constants), so no names are allocated.
+         */
+        void registerSignalHandler( InterfaceNameView interfaceName
+                                  , SignalNameView signalName
+                                  , signal_handler signalHandler );
+
+        /*!
+         * @copydoc IProxy::registerSignalHandler(const InterfaceName&,const SignalName&,signal_handler,return_slot_t)
+         *
+         * This overload takes non-owning names (e.g. constexpr constants), so no names are allocated.
+         */
+        [[nodiscard]] Slot registerSignalHandler( InterfaceNameView interfaceName
+                                                , SignalNameView signalName
+                                                , signal_handler signalHandler
+                                                , return_slot_t );
+
+        /*!
+         * @brief Registers a handler for the desired signal emitted by the D-Bus object, filtered by its arguments
+         *
+         * @param[in] interfaceName Name of an interface that the signal belongs to
+         * @param[in] signalName Name of the signal
+         * @param[in] argFilters Conditions on the signal arguments, all of which must be satisfied
+         * @param[in] signalHandler Callback that implements the body of the signal handler
+         *
+         * This method operates the same as the unfiltered registerSignalHandler() above, just that
+         * the filters are added to the match rule of the subscription as `argN`, `argNpath` and
+         * `arg0namespace` items. The bus broker then doesn't deliver signals not satisfying them.
+         * Filtered subscriptions are never aggregated (see enableSignalMatchAggregation()).
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        virtual void registerSignalHandler( const InterfaceName& interfaceName
+                                          , const SignalName& signalName
+                                          , const std::vector<SignalArgFilter>& argFilters
+                                          , signal_handler signalHandler ) = 0;
+
+        /*!
+         * @brief Registers a handler for the desired signal emitted by the D-Bus object, filtered by its arguments
+         *
+         * @param[in] interfaceName Name of an interface that the signal belongs to
+         * @param[in] signalName Name of the signal
+         * @param[in] argFilters Conditions on the signal arguments, all of which must be satisfied
+         * @param[in] signalHandler Callback that implements the body of the signal handler
+         *
+         * @return RAII-style slot handle representing the ownership of the subscription
+         *
+         * This method operates the same as the floating variant above, just that the lifetime
+         * of the subscription is bound to the lifetime of the slot object.
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        [[nodiscard]] virtual Slot registerSignalHandler( const InterfaceName& interfaceName
+                                                        , const SignalName& signalName
+                                                        , const std::vector<SignalArgFilter>& argFilters
+                                                        , signal_handler signalHandler
+                                                        , return_slot_t ) = 0;
+
     protected: // Internal API for efficiency reasons used by high-level API helper classes
         friend MethodInvoker;
         friend AsyncMethodInvoker;
         friend SignalSubscriber;
+        friend PreparedMethodCall;
+        friend PropertyGetter;
 
         [[nodiscard]] virtual MethodCall createMethodCall(const char* interfaceName, const char* methodName) const = 0;
         virtual void registerSignalHandler( const char* interfaceName
@@ -660,6 +919,43 @@ namespace sdbus {
                                                         , const char* signalName
                                                         , signal_handler signalHandler
                                                         , return_slot_t ) = 0;
+        virtual void registerSignalHandler( const char* interfaceName
+                                          , const char* signalName
+                                          , const std::vector<SignalArgFilter>& argFilters
+                                          , signal_handler signalHandler ) = 0;
+        [[nodiscard]] virtual Slot registerSignalHandler( const char* interfaceName
+                                                        , const char* signalName
+                                                        , const std::vector<SignalArgFilter>& argFilters
+                                                        , signal_handler signalHandler
+                                                        , return_slot_t ) = 0;
+        // Returns the property value served by the property cache, or nullopt if not served by it (e.g. the cache is disabled)
+        [[nodiscard]] virtual std::optional<Variant> getCachedProperty(std::string_view interfaceName, std::string_view propertyName) = 0;
+        // Returns the results of the call from the method result cache, or calls the method with the given arguments and caches its results for ttl microseconds
+        [[nodiscard]] virtual Expected<Message> callMethodWithCachedResults( const MethodCall& message
+                                                                           , PlainMessage& arguments
+                                                                           , uint64_t timeout
+                                                                           , uint64_t ttl ) = 0;
+
+    public:
+        /*!
+         * @struct ResourceUsage
+         *
+         * Carries counts of bookkeeping records held by the proxy, and their approximate size.
+         *
+         * See getResourceUsage() for more info.
+         */
+        struct ResourceUsage
+        {
+            std::size_t floatingSignalHandlers{};   // Signal handlers registered without returning a slot
+            std::size_t aggregatedSignalHandlers{}; // Signal handlers served by aggregated match rules, see enableSignalMatchAggregation()
+            std::size_t floatingAsyncCalls{};       // Pending async calls whose lifetime is tied to the proxy
+            std::size_t pendingAsyncCalls{};        // All pending async calls, including those owned by returned slots
+            std::size_t cachedProperties{};         // Property values in the property cache
+            std::size_t cachedMethodResults{};      // Entries of the method result cache
+            // Memory held by the records above, as far as sdbus-c++ allocates it. Memory of sd-bus
+            // and of captures of user callbacks is not included.
+            std::size_t approximateBytes{};
+        };
     };
 
     /********************************************//**
@@ -704,6 +1000,94 @@ namespace sdbus {
         std::weak_ptr<void> callInfo_;
     };
 
+    /********************************************//**
+     * @class PreparedMethodCall
+     *
+     * PreparedMethodCall is a lightweight, copyable template for method call
+     * messages of one particular method of a remote D-Bus object. It is
+     * obtained through IProxy::prepareMethodCall(), which validates the
+     * interface and method names once, and is meant for hot RPCs that are
+     * invoked at high rates.
+     *
+     * The prepared method call keeps a reference to the originating proxy,
+     * so it must not outlive it.
+     *
+     ***********************************************/
+    class PreparedMethodCall
+    {
+    public:
+        /*!
+         * @brief Creates a new method call message of the prepared method
+         *
+         * @return A method call message, ready for serialization of method arguments
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        [[nodiscard]] MethodCall createMethodCall() const;
+
+        [[nodiscard]] const InterfaceName& getInterfaceName() const noexcept;
+        [[nodiscard]] const MethodName& getMethodName() const noexcept;
+
+    private:
+        friend internal::Proxy;
+        PreparedMethodCall(const IProxy& proxy, InterfaceName interfaceName, MethodName methodName);
+
+    private:
+        const IProxy* proxy_;
+        InterfaceName interfaceName_;
+        MethodName methodName_;
+    };
+
+    /********************************************//**
+     * @class AsyncCallAwaitable
+     *
+     * AsyncCallAwaitable makes the result of an asynchronous D-Bus method call
+     * awaitable from within a C++20 coroutine. It is obtained through the
+     * getResultAsAwaitable() function of the convenience API classes, e.g.:
+     *
+     * @code
+     * int result = co_await proxy.callMethodAsync("multiply").onInterface(INTERFACE_NAME).withArguments(a, b).getResultAsAwaitable<int>();
+     * @endcode
+     *
+     * The D-Bus call is issued when the coroutine gets suspended, and the coroutine is resumed
+     * from within the reply handler, i.e. in the context of the connection's event loop thread.
+     * No std::promise/std::future shared state is involved. co_await yields void for no
+     * D-Bus method return value, T for single return value, and std::tuple<...> for multiple
+     * return values. sdbus::Error is thrown from co_await if the call failed.
+     *
+     * Destroying the awaitable (i.e., destroying the suspended coroutine) cancels the delivery
+     * of the call result. This shall not happen concurrently with the reply being delivered,
+     * so one should destroy suspended coroutines only from within the event loop thread.
+     *
+     ***********************************************/
+    template <typename... _Results>
+    class AsyncCallAwaitable
+    {
+    public:
+        AsyncCallAwaitable(const AsyncCallAwaitable&) = delete;
+        AsyncCallAwaitable& operator=(const AsyncCallAwaitable&) = delete;
+        ~AsyncCallAwaitable();
+
+        bool await_ready() const noexcept;
+        bool await_suspend(std::coroutine_handle<> handle);
+        future_return_t<_Results...> await_resume();
+
+    private:
+        friend AsyncMethodInvoker;
+        AsyncCallAwaitable(IProxy& proxy, MethodCall method, uint64_t timeout);
+        void onReply(MethodReply reply, std::optional<Error> error);
+
+    private:
+        IProxy& proxy_;
+        MethodCall method_;
+        uint64_t timeout_;
+        std::coroutine_handle<> handle_;
+        PendingAsyncCall pendingCall_;
+        std::atomic<bool> ready_{}; // Whichever of reply delivery and coroutine suspension comes second resumes the coroutine
+        std::optional<Error> error_;
+        std::tuple<_Results...> results_;
+    };
+
     // Out-of-line member definitions
 
     template <typename _Rep, typename _Period>
@@ -713,6 +1097,35 @@ namespace sdbus {
         return callMethod(message, microsecs.count());
     }
 
+    inline MethodCall IProxy::createMethodCall(InterfaceNameView interfaceName, MethodNameView methodName) const
+    {
+        return createMethodCall(interfaceName.c_str(), methodName.c_str());
+    }
+
+    inline void IProxy::registerSignalHandler( InterfaceNameView interfaceName
+                                             , SignalNameView signalName
+                                             , signal_handler signalHandler )
+    {
+        registerSignalHandler(interfaceName.c_str(), signalName.c_str(), std::move(signalHandler));
+    }
+
+    inline Slot IProxy::registerSignalHandler( InterfaceNameView interfaceName
+                                             , SignalNameView signalName
+                                             , signal_handler signalHandler
+                                             , return_slot_t )
+    {
+        return registerSignalHandler(interfaceName.c_str(), signalName.c_str(), std::move(signalHandler), return_slot);
+    }
+
+    template <typename _Rep, typename _Period>
+    inline Expected<MethodReply> IProxy::callMethod( const MethodCall& message
+                                                   , const std::chrono::duration<_Rep, _Period>& timeout
+                                                   , std::nothrow_t )
+    {
+        auto microsecs = std::chrono::duration_cast<std::chrono::microseconds>(timeout);
+        return callMethod(message, microsecs.count(), std::nothrow);
+    }
+
     template <typename _Rep, typename _Period>
     inline PendingAsyncCall IProxy::callMethodAsync( const MethodCall& message
                                                    , async_reply_handler asyncReplyCallback
@@ -836,6 +1249,28 @@ namespace sdbus {
         return AsyncAllPropertiesGetter(*this);
     }
 
+    inline PreparedMethodCall::PreparedMethodCall(const IProxy& proxy, InterfaceName interfaceName, MethodName methodName)
+        : proxy_(&proxy)
+        , interfaceName_(std::move(interfaceName))
+        , methodName_(std::move(methodName))
+    {
+    }
+
+    inline MethodCall PreparedMethodCall::createMethodCall() const
+    {
+        return proxy_->createMethodCall(interfaceName_.c_str(), methodName_.c_str());
+    }
+
+    inline const InterfaceName& PreparedMethodCall::getInterfaceName() const noexcept
+    {
+        return interfaceName_;
+    }
+
+    inline const MethodName& PreparedMethodCall::getMethodName() const noexcept
+    {
+        return methodName_;
+    }
+
     /*!
      * @brief Creates a proxy object for a specific remote D-Bus object
      *
@@ -974,6 +1409,33 @@ namespace sdbus {
      */
     [[nodiscard]] std::unique_ptr<sdbus::IProxy> createLightWeightProxy(ServiceName destination, ObjectPath objectPath);
 
+    /*!
+     * @brief Creates a proxy object for a remote D-Bus object, reached over a direct peer-to-peer channel if possible
+     *
+     * @param[in] busConnection D-Bus connection to the bus the service is on
+     * @param[in] destination Bus name that provides the remote D-Bus object
+     * @param[in] objectPath Path of the remote D-Bus object
+     * @return Pointer to the object proxy instance
+     *
+     * The remote object is asked over the bus to open a direct channel (see DirectChannel_adaptor).
+     * If it does, the proxy talks to the service over a private connection, which skips the bus daemon
+     * hop on every message. The proxy then owns that connection, and runs an event loop upon it in
+     * a separate internal thread. If the service doesn't offer a direct channel, or the channel can't
+     * be set up (e.g. the bus doesn't support passing file descriptors), the proxy falls back to the
+     * provided bus connection, like createProxy(IConnection&, ServiceName, ObjectPath) does.
+     *
+     * Once a direct channel is closed by the service, calls through the proxy fail; a new proxy
+     * created by this function then negotiates a new channel, or falls back to the bus.
+     *
+     * Code example:
+     * @code
+     * auto proxy = sdbus::createDirectChannelProxy(*connection, "com.kistler.foo", "/com/kistler/foo");
+     * @endcode
+     */
+    [[nodiscard]] std::unique_ptr<sdbus::IProxy> createDirectChannelProxy( sdbus::IConnection& busConnection
+                                                                         , ServiceName destination
+                                                                         , ObjectPath objectPath );
+
 }
 
 #include <sdbus-c++/ConvenienceApiClasses.inl>
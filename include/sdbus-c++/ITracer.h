@@ -0,0 +1,111 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file ITracer.h
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_ITRACER_H_
+#define SDBUS_CXX_ITRACER_H_
+
+// Forward declarations
+namespace sdbus {
+    class MethodCall;
+    class Error;
+}
+
+namespace sdbus {
+
+    /********************************************//**
+     * @class ITracer
+     *
+     * Hooks for distributed tracing of method calls, e.g. by an OpenTelemetry tracer.
+     * A tracer is installed on a connection through IConnection::setTracer(). It then
+     * sees every method call issued by proxies of the connection, and every method
+     * call handled by objects of the connection.
+     *
+     * On the client side, onMethodCallSent() is called right before a method call is sent,
+     * and onMethodCallCompleted() once its reply or error is received (or, in case of
+     * asynchronous calls, right before the reply handler is invoked). On the server side,
+     * onMethodCallReceived() is called right before the method handler is invoked, and
+     * onMethodCallHandled() right after it returns, in the thread the handler runs in.
+     * The span returned by the opening hook is opaque to sdbus-c++, and is passed to the
+     * matching closing hook as is.
+     *
+     * D-Bus messages have no room for custom header fields, and an additional argument
+     * would break method signatures, so the trace context travels via a side channel: the
+     * sender's unique bus name together with the message cookie identify a method call
+     * on the bus uniquely. The client side learns the cookie in onMethodCallCompleted()
+     * (MethodCall::getCookie(), the call is sent by then), and the server side sees the same
+     * pair in onMethodCallReceived() (Message::getSender() and MethodCall::getCookie()),
+     * so the spans of both sides can be linked by these two attributes.
+     *
+     * Hooks are invoked concurrently from the event loop thread, dispatch pool threads and
+     * threads issuing method calls, so they must be thread-safe. They must not throw.
+     *
+     ***********************************************/
+    class ITracer
+    {
+    public:
+        virtual ~ITracer() = default;
+
+        /*!
+         * @brief Opens a client span of the method call, which is about to be sent
+         *
+         * @param[in] call Method call to be sent
+         * @return Span of the call, passed to onMethodCallCompleted()
+         */
+        virtual void* onMethodCallSent(const MethodCall& call) noexcept = 0;
+
+        /*!
+         * @brief Closes the client span of the method call
+         *
+         * @param[in] span Span returned by onMethodCallSent()
+         * @param[in] call The method call, already sent
+         * @param[in] error The error the call failed with, nullptr on success
+         */
+        virtual void onMethodCallCompleted(void* span, const MethodCall& call, const Error* error) noexcept = 0;
+
+        /*!
+         * @brief Opens a server span of the method call, whose handler is about to be invoked
+         *
+         * @param[in] call Received method call
+         * @return Span of the call, passed to onMethodCallHandled()
+         */
+        virtual void* onMethodCallReceived(const MethodCall& call) noexcept = 0;
+
+        /*!
+         * @brief Closes the server span of the method call
+         *
+         * @param[in] span Span returned by onMethodCallReceived()
+         * @param[in] call The handled method call
+         * @param[in] error The error the handler failed with, nullptr if it succeeded
+         *
+         * Method handlers that reply asynchronously (see sdbus::Result) return before their reply is sent,
+         * so the span covers the synchronous part of the handler only.
+         */
+        virtual void onMethodCallHandled(void* span, const MethodCall& call, const Error* error) noexcept = 0;
+    };
+
+}
+
+#endif /* SDBUS_CXX_ITRACER_H_ */
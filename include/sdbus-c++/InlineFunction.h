@@ -0,0 +1,293 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file InlineFunction.h
+ *
+ * Created on: Oct 14, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_INLINEFUNCTION_H_
+#define SDBUS_CXX_INLINEFUNCTION_H_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sdbus {
+
+    // Default inline capacity of callback handlers -- fits e.g. a member function pointer bound to an object,
+    // or a lambda capturing a few pointers or references, together with sdbus-c++'s own wrapping lambdas.
+    inline constexpr std::size_t DEFAULT_CALLBACK_INLINE_SIZE = 32;
+
+    template <typename _Signature, std::size_t _InlineSize = DEFAULT_CALLBACK_INLINE_SIZE>
+    class InlineFunction;
+
+    /********************************************//**
+     * @class InlineFunction
+     *
+     * Type-erased callable wrapper with a drop-in std::function interface, used for storing
+     * callback handlers in sdbus-c++. Unlike std::function, whose small buffer only fits
+     * a couple of pointers, it stores callables of up to `_InlineSize` bytes in place,
+     * without allocating, and only larger callables are allocated on the heap.
+     *
+     ***********************************************/
+    template <typename _R, typename... _Args, std::size_t _InlineSize>
+    class InlineFunction<_R(_Args...), _InlineSize>
+    {
+    public:
+        using result_type = _R;
+
+        InlineFunction() noexcept = default;
+        InlineFunction(std::nullptr_t) noexcept {}
+
+        template < typename _Function
+                 , typename = std::enable_if_t< !std::is_same_v<std::decay_t<_Function>, InlineFunction>
+                                             && std::is_invocable_r_v<_R, std::decay_t<_Function>&, _Args...> > >
+        InlineFunction(_Function&& function)
+        {
+            using Callable = std::decay_t<_Function>;
+
+            if (isEmpty(function))
+                return;
+
+            if constexpr (fitsInline<Callable>())
+            {
+                ::new (static_cast<void*>(&storage_)) Callable(std::forward<_Function>(function));
+                ops_ = &inlineOps<Callable>;
+            }
+            else
+            {
+                ::new (static_cast<void*>(&storage_)) Callable*(new Callable(std::forward<_Function>(function)));
+                ops_ = &heapOps<Callable>;
+            }
+        }
+
+        InlineFunction(const InlineFunction& other)
+        {
+            // The ops are taken over only once the callable is copied, so a throwing copy leaves nothing to destroy
+            if (other.ops_ != nullptr)
+            {
+                other.ops_->copy(&other.storage_, &storage_);
+                ops_ = other.ops_;
+            }
+        }
+
+        InlineFunction(InlineFunction&& other) noexcept
+            : ops_(other.ops_)
+        {
+            if (ops_ != nullptr)
+            {
+                ops_->move(&other.storage_, &storage_);
+                other.ops_ = nullptr;
+            }
+        }
+
+        InlineFunction& operator=(const InlineFunction& other)
+        {
+            // Copied aside first, so that a throwing copy leaves this function as it was
+            if (this != &other)
+                InlineFunction(other).swap(*this);
+            return *this;
+        }
+
+        InlineFunction& operator=(InlineFunction&& other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                if (other.ops_ != nullptr)
+                {
+                    other.ops_->move(&other.storage_, &storage_);
+                    ops_ = std::exchange(other.ops_, nullptr);
+                }
+            }
+            return *this;
+        }
+
+        InlineFunction& operator=(std::nullptr_t) noexcept
+        {
+            reset();
+            return *this;
+        }
+
+        template < typename _Function
+                 , typename = std::enable_if_t< !std::is_same_v<std::decay_t<_Function>, InlineFunction>
+                                             && std::is_invocable_r_v<_R, std::decay_t<_Function>&, _Args...> > >
+        InlineFunction& operator=(_Function&& function)
+        {
+            InlineFunction(std::forward<_Function>(function)).swap(*this);
+            return *this;
+        }
+
+        ~InlineFunction()
+        {
+            reset();
+        }
+
+        void swap(InlineFunction& other) noexcept
+        {
+            InlineFunction tmp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(tmp);
+        }
+
+        _R operator()(_Args... args) const
+        {
+            if (ops_ == nullptr)
+                throw std::bad_function_call{};
+            return ops_->invoke(const_cast<Storage*>(&storage_), std::forward<_Args>(args)...);
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return ops_ != nullptr;
+        }
+
+        friend bool operator==(const InlineFunction& function, std::nullptr_t) noexcept
+        {
+            return !function;
+        }
+
+    private:
+        struct Storage
+        {
+            alignas(std::max_align_t) std::byte bytes[_InlineSize];
+        };
+
+        struct Ops
+        {
+            _R (*invoke)(Storage* storage, _Args&&... args);
+            void (*copy)(const Storage* from, Storage* to);
+            void (*move)(Storage* from, Storage* to) noexcept;
+            void (*destroy)(Storage* storage) noexcept;
+        };
+
+        template <typename _Callable>
+        static constexpr bool fitsInline()
+        {
+            return sizeof(_Callable) <= _InlineSize
+                && alignof(_Callable) <= alignof(std::max_align_t)
+                && std::is_nothrow_move_constructible_v<_Callable>;
+        }
+
+        // Like std::function, the wrapper is empty when constructed from a null pointer or an empty function wrapper
+        template <typename _Function>
+        static bool isEmpty(const _Function& function)
+        {
+            if constexpr (std::is_pointer_v<_Function> || std::is_member_pointer_v<_Function>)
+                return function == nullptr;
+            else
+                return false;
+        }
+
+        template <typename _Signature>
+        static bool isEmpty(const std::function<_Signature>& function)
+        {
+            return !function;
+        }
+
+        template <typename _Signature, std::size_t _Size>
+        static bool isEmpty(const InlineFunction<_Signature, _Size>& function)
+        {
+            return !function;
+        }
+
+        template <typename _Callable>
+        static _R invokeTarget(_Callable& callable, _Args&&... args)
+        {
+            if constexpr (std::is_void_v<_R>)
+                std::invoke(callable, std::forward<_Args>(args)...);
+            else
+                return std::invoke(callable, std::forward<_Args>(args)...);
+        }
+
+        template <typename _Callable>
+        static _Callable* inlineTarget(Storage* storage)
+        {
+            return std::launder(reinterpret_cast<_Callable*>(storage));
+        }
+
+        template <typename _Callable>
+        static _Callable* heapTarget(Storage* storage)
+        {
+            return *std::launder(reinterpret_cast<_Callable**>(storage));
+        }
+
+        template <typename _Callable>
+        static constexpr Ops inlineOps
+        {
+            [](Storage* storage, _Args&&... args) -> _R
+            {
+                return invokeTarget(*inlineTarget<_Callable>(storage), std::forward<_Args>(args)...);
+            },
+            [](const Storage* from, Storage* to)
+            {
+                ::new (static_cast<void*>(to)) _Callable(*inlineTarget<_Callable>(const_cast<Storage*>(from)));
+            },
+            [](Storage* from, Storage* to) noexcept
+            {
+                ::new (static_cast<void*>(to)) _Callable(std::move(*inlineTarget<_Callable>(from)));
+                inlineTarget<_Callable>(from)->~_Callable();
+            },
+            [](Storage* storage) noexcept
+            {
+                inlineTarget<_Callable>(storage)->~_Callable();
+            }
+        };
+
+        template <typename _Callable>
+        static constexpr Ops heapOps
+        {
+            [](Storage* storage, _Args&&... args) -> _R
+            {
+                return invokeTarget(*heapTarget<_Callable>(storage), std::forward<_Args>(args)...);
+            },
+            [](const Storage* from, Storage* to)
+            {
+                ::new (static_cast<void*>(to)) _Callable*(new _Callable(*heapTarget<_Callable>(const_cast<Storage*>(from))));
+            },
+            [](Storage* from, Storage* to) noexcept
+            {
+                ::new (static_cast<void*>(to)) _Callable*(heapTarget<_Callable>(from));
+            },
+            [](Storage* storage) noexcept
+            {
+                delete heapTarget<_Callable>(storage);
+            }
+        };
+
+        void reset() noexcept
+        {
+            if (ops_ != nullptr)
+                std::exchange(ops_, nullptr)->destroy(&storage_);
+        }
+
+    private:
+        Storage storage_;
+        const Ops* ops_{};
+    };
+
+}
+
+#endif /* SDBUS_CXX_INLINEFUNCTION_H_ */
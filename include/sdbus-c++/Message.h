@@ -32,12 +32,19 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <cstdint>
 #include <cstring>
 #include <functional>
+#include <iterator>
 #include <map>
+#include <new>
+#include <optional>
 #ifdef __has_include
+#  if __has_include(<ranges>)
+#    include <ranges>
+#  endif
 #  if __has_include(<span>)
 #    include <span>
 #  endif
@@ -55,15 +62,69 @@ namespace sdbus {
     class ObjectPath;
     class Signature;
     template <typename... _ValueTypes> class Struct;
+    template <typename... _ValueTypes> class Columns;
+    template <typename... _ValueTypes> class ColumnsView;
     class UnixFd;
+    class SharedUnixFd;
+    class SharedBuffer;
+    class CompressedBytes;
     class MethodReply;
+    template <typename _Element> class LazyArray;
     namespace internal {
         class IConnection;
     }
 }
 
+#ifdef __cpp_lib_ranges
+namespace sdbus::detail {
+
+    // Input ranges other than the types that have a D-Bus signature and thus serialization of their own
+    template <typename _Range>
+    concept serializable_range = std::ranges::input_range<_Range>
+                              && !signature_of<std::remove_cvref_t<_Range>>::is_valid
+                              && !std::is_convertible_v<_Range, std::string_view>;
+
+    template <typename _T>
+    constexpr bool is_pair_v = false;
+
+    template <typename _T1, typename _T2>
+    constexpr bool is_pair_v<std::pair<_T1, _T2>> = true;
+
+}
+#endif
+
 namespace sdbus {
 
+    /********************************************//**
+     * @struct Credentials
+     *
+     * Credentials of the sender of a message, as obtained in one go by
+     * Message::getCreds(). Fields that were not requested, or that are
+     * not available for the sender, are left empty.
+     *
+     ***********************************************/
+    struct Credentials
+    {
+        enum Field : uint64_t
+        {
+            Pid = 1 << 0,
+            Uid = 1 << 1,
+            Euid = 1 << 2,
+            Gid = 1 << 3,
+            Egid = 1 << 4,
+            SupplementaryGids = 1 << 5,
+            SELinuxContext = 1 << 6
+        };
+
+        std::optional<pid_t> pid;
+        std::optional<uid_t> uid;
+        std::optional<uid_t> euid;
+        std::optional<gid_t> gid;
+        std::optional<gid_t> egid;
+        std::optional<std::vector<gid_t>> supplementaryGids;
+        std::optional<std::string> selinuxContext;
+    };
+
     /********************************************//**
      * @class Message
      *
@@ -97,6 +158,8 @@ namespace sdbus {
         Message& operator<<(double item);
         Message& operator<<(const char *item);
         Message& operator<<(const std::string &item);
+        template <typename _Allocator>
+        Message& operator<<(const std::basic_string<char, std::char_traits<char>, _Allocator>& item);
         Message& operator<<(std::string_view item);
         Message& operator<<(const Variant &item);
         template <typename ...Elements>
@@ -104,6 +167,9 @@ namespace sdbus {
         Message& operator<<(const ObjectPath &item);
         Message& operator<<(const Signature &item);
         Message& operator<<(const UnixFd &item);
+        Message& operator<<(const SharedUnixFd &item);
+        Message& operator<<(const SharedBuffer &item);
+        Message& operator<<(const CompressedBytes &item);
         template <typename _Element, typename _Allocator>
         Message& operator<<(const std::vector<_Element, _Allocator>& items);
         template <typename _Element, std::size_t _Size>
@@ -111,6 +177,12 @@ namespace sdbus {
 #ifdef __cpp_lib_span
         template <typename _Element, std::size_t _Extent>
         Message& operator<<(const std::span<_Element, _Extent>& items);
+#endif
+#ifdef __cpp_lib_ranges
+        // Serializes any other input range, e.g. a view or a custom container, in place without copying it into
+        // a std::vector first: as a dictionary if its elements are std::pairs, or as an array otherwise
+        template <detail::serializable_range _Range>
+        Message& operator<<(_Range&& items);
 #endif
         template <typename _Enum, typename = std::enable_if_t<std::is_enum_v<_Enum>>>
         Message& operator<<(const _Enum& item);
@@ -120,10 +192,18 @@ namespace sdbus {
         Message& operator<<(const std::map<_Key, _Value, _Compare, _Allocator>& items);
         template <typename _Key, typename _Value, typename _Hash, typename _KeyEqual, typename _Allocator>
         Message& operator<<(const std::unordered_map<_Key, _Value, _Hash, _KeyEqual, _Allocator>& items);
+        template <typename _Container> requires dbus_array_container_v<_Container>
+        Message& operator<<(const _Container& items);
+        template <typename _Container> requires dbus_dictionary_container_v<_Container>
+        Message& operator<<(const _Container& items);
         template <typename... _ValueTypes>
         Message& operator<<(const Struct<_ValueTypes...>& item);
         template <typename... _ValueTypes>
         Message& operator<<(const std::tuple<_ValueTypes...>& item);
+        template <typename... _ValueTypes>
+        Message& operator<<(const Columns<_ValueTypes...>& item);
+        template <typename... _ValueTypes>
+        Message& operator<<(const ColumnsView<_ValueTypes...>& item);
 
         Message& operator>>(bool& item);
         Message& operator>>(int16_t& item);
@@ -136,12 +216,18 @@ namespace sdbus {
         Message& operator>>(double& item);
         Message& operator>>(char*& item);
         Message& operator>>(std::string &item);
+        template <typename _Allocator> // E.g. std::pmr::string, keeping its own memory resource
+        Message& operator>>(std::basic_string<char, std::char_traits<char>, _Allocator>& item);
+        Message& operator>>(std::string_view& item); // Zero-copy: the view points into the message, valid while the message lives
         Message& operator>>(Variant &item);
         template <typename ...Elements>
         Message& operator>>(std::variant<Elements...>& value);
         Message& operator>>(ObjectPath &item);
         Message& operator>>(Signature &item);
         Message& operator>>(UnixFd &item);
+        Message& operator>>(SharedUnixFd &item);
+        Message& operator>>(SharedBuffer &item);
+        Message& operator>>(CompressedBytes &item);
         template <typename _Element, typename _Allocator>
         Message& operator>>(std::vector<_Element, _Allocator>& items);
         template <typename _Element, std::size_t _Size>
@@ -149,6 +235,8 @@ namespace sdbus {
 #ifdef __cpp_lib_span
         template <typename _Element, std::size_t _Extent>
         Message& operator>>(std::span<_Element, _Extent>& items);
+        template <typename _Element> // Zero-copy: the view points into the message, valid while the message lives
+        Message& operator>>(std::span<const _Element>& items);
 #endif
         template <typename _Enum, typename = std::enable_if_t<std::is_enum_v<_Enum>>>
         Message& operator>>(_Enum& item);
@@ -158,10 +246,18 @@ namespace sdbus {
         Message& operator>>(std::map<_Key, _Value, _Compare, _Allocator>& items);
         template <typename _Key, typename _Value, typename _Hash, typename _KeyEqual, typename _Allocator>
         Message& operator>>(std::unordered_map<_Key, _Value, _Hash, _KeyEqual, _Allocator>& items);
+        template <typename _Container> requires dbus_array_container_v<_Container>
+        Message& operator>>(_Container& items);
+        template <typename _Container> requires dbus_dictionary_container_v<_Container>
+        Message& operator>>(_Container& items);
         template <typename... _ValueTypes>
         Message& operator>>(Struct<_ValueTypes...>& item);
         template <typename... _ValueTypes>
         Message& operator>>(std::tuple<_ValueTypes...>& item);
+        template <typename... _ValueTypes>
+        Message& operator>>(Columns<_ValueTypes...>& item);
+        template <typename... _ValueTypes> // Zero-copy: the columns point into the message, valid while the message lives
+        Message& operator>>(ColumnsView<_ValueTypes...>& item);
 
         template <typename _ElementType>
         Message& openContainer();
@@ -184,6 +280,7 @@ namespace sdbus {
         Message& enterContainer();
         Message& enterContainer(const char* signature);
         Message& exitContainer();
+        Message& skipToContainerEnd();
         template <typename _KeyType, typename _ValueType>
         Message& enterDictEntry();
         Message& enterDictEntry(const char* signature);
@@ -198,7 +295,13 @@ namespace sdbus {
         Message& exitStruct();
 
         Message& appendArray(char type, const void *ptr, size_t size);
+        // Appends an array of fixed-size elements (except bool) of given size in bytes in one step, to be filled in place through ptr
+        Message& appendArraySpace(char type, size_t size, void **ptr);
         Message& readArray(char type, const void **ptr, size_t *size);
+        // Appends an array of strings in one step. All elements are validated up front, so on error nothing is appended.
+        Message& appendStringArray(const std::string* items, size_t count);
+        Message& appendTrivialStruct(const char* signature, ...);
+        Message& readTrivialStruct(const char* signature, ...);
 
         template <typename _Key, typename _Value, typename _Callback>
         Message& serializeDictionary(const _Callback& callback);
@@ -206,6 +309,11 @@ namespace sdbus {
         Message& serializeDictionary(const std::initializer_list<DictEntry<_Key, _Value>>& dictEntries);
         template <typename _Key, typename _Value, typename _Callback>
         Message& deserializeDictionary(const _Callback& callback);
+        template <typename _Key, typename _Value, typename _Allocator, typename _Callback>
+        Message& deserializeDictionary(const _Allocator& allocator, const _Callback& callback);
+        // Returns an input range decoding array elements one at a time, e.g. for huge arrays to be processed with constant memory
+        template <typename _Element>
+        LazyArray<_Element> readArrayLazy();
 
         explicit operator bool() const;
         void clearFlags();
@@ -215,6 +323,10 @@ namespace sdbus {
         const char* getSender() const;
         const char* getPath() const;
         const char* getDestination() const;
+        // Serial number of the message on the bus connection of its sender, or 0 if the message hasn't been sent yet
+        uint64_t getCookie() const;
+        // Cookie of the method call the message replies to, or 0 if it's not a reply
+        uint64_t getReplyCookie() const;
         // TODO: short docs in whole Message API
         std::pair<char, const char*> peekType() const;
         bool isValid() const;
@@ -223,6 +335,8 @@ namespace sdbus {
 
         void copyTo(Message& destination, bool complete) const;
         void seal();
+        // Whether the message is sealed, i.e. sent or sealed explicitly, so that it can be read but no longer appended to
+        bool isSealed() const;
         void rewind(bool complete);
 
         pid_t getCredsPid() const;
@@ -232,6 +346,7 @@ namespace sdbus {
         gid_t getCredsEgid() const;
         std::vector<gid_t> getCredsSupplementaryGids() const;
         std::string getSELinuxContext() const;
+        Credentials getCreds(uint64_t fields) const;
 
         class Factory;
 
@@ -257,10 +372,79 @@ namespace sdbus {
 
         friend Factory;
 
+    private:
+        struct SharedRefs;
+        SharedRefs* acquireSharedRefs() const noexcept;
+        void releaseMessage() noexcept;
+
     protected:
         void* msg_{};
         internal::IConnection* connection_{};
         mutable bool ok_{true};
+
+    private:
+        // Copies of a message share one reference to the underlying sd-bus message. Set up on the first copy.
+        mutable std::atomic<SharedRefs*> sharedRefs_{};
+    };
+
+    /********************************************//**
+     * @class LazyArray
+     *
+     * LazyArray is an input range over a D-Bus array being deserialized from
+     * a message. It is obtained through Message::readArrayLazy(), and decodes
+     * the array elements one at a time as it's iterated, instead of materializing
+     * the whole container. The elements can also be dictionary entries
+     * (DictEntry<_Key, _Value>), for lazy iteration of D-Bus dictionaries.
+     *
+     * The range shall be iterated only once, and it must not outlive the message
+     * it reads from. The message can be read further on once the range has been
+     * iterated through, or destroyed.
+     *
+     ***********************************************/
+    template <typename _Element>
+    class LazyArray
+    {
+    public:
+        class iterator
+        {
+        public:
+            using value_type = _Element;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+            _Element& operator*() const { return array_->element_; }
+            _Element* operator->() const { return &array_->element_; }
+            iterator& operator++() { array_->readNext(); return *this; }
+            void operator++(int) { ++*this; }
+            friend bool operator==(const iterator& it, std::default_sentinel_t) { return it.isAtEnd(); }
+
+        private:
+            friend LazyArray;
+            explicit iterator(LazyArray* array) : array_(array) {}
+            bool isAtEnd() const { return array_ == nullptr || array_->atEnd_; }
+
+        private:
+            LazyArray* array_{};
+        };
+
+        LazyArray(const LazyArray&) = delete;
+        LazyArray& operator=(const LazyArray&) = delete;
+        ~LazyArray();
+
+        iterator begin();
+        std::default_sentinel_t end() const noexcept { return {}; }
+
+    private:
+        friend Message;
+        explicit LazyArray(Message& msg);
+        void readNext();
+        void finish();
+
+    private:
+        Message& msg_;
+        _Element element_{};
+        bool started_{};
+        bool atEnd_{true};
     };
 
     class MethodCall : public Message
@@ -272,6 +456,7 @@ namespace sdbus {
         MethodCall() = default;
 
         MethodReply send(uint64_t timeout) const;
+        [[nodiscard]] Expected<MethodReply> send(uint64_t timeout, std::nothrow_t) const;
         [[nodiscard]] Slot send(void* callback, void* userData, uint64_t timeout, return_slot_t) const;
 
         MethodReply createReply() const;
@@ -353,6 +538,12 @@ namespace sdbus {
         return *this;
     }
 
+    template <typename _Allocator>
+    inline Message& Message::operator<<(const std::basic_string<char, std::char_traits<char>, _Allocator>& item)
+    {
+        return *this << item.c_str();
+    }
+
     template <typename _Element, typename _Allocator>
     inline Message& Message::operator<<(const std::vector<_Element, _Allocator>& items)
     {
@@ -379,6 +570,53 @@ namespace sdbus {
     }
 #endif
 
+#ifdef __cpp_lib_ranges
+    template <detail::serializable_range _Range>
+    inline Message& Message::operator<<(_Range&& items)
+    {
+        using ElementType = std::ranges::range_value_t<_Range>;
+        constexpr bool isTrivialElement = signature_of<ElementType>::is_trivial_dbus_type && !std::is_same_v<ElementType, bool>;
+
+        if constexpr (detail::is_pair_v<ElementType>)
+        {
+            using KeyType = std::remove_const_t<typename ElementType::first_type>;
+            using ValueType = typename ElementType::second_type;
+            serializeDictionary<KeyType, ValueType>([&items](Message& msg){ for (auto&& item : items) msg << item; });
+        }
+        // Contiguous elements of trivial D-Bus types except bool are serialized in one step
+        else if constexpr (isTrivialElement && std::ranges::contiguous_range<_Range> && std::ranges::sized_range<_Range>)
+        {
+            constexpr auto signature = as_null_terminated(signature_of_v<ElementType>);
+            appendArray(*signature.data(), std::ranges::data(items), std::ranges::size(items) * sizeof(ElementType));
+        }
+        // Other sized ranges of such elements are copied right into the array space reserved in the message
+        else if constexpr (isTrivialElement && std::ranges::sized_range<_Range>)
+        {
+            constexpr auto signature = as_null_terminated(signature_of_v<ElementType>);
+            void* space{};
+            appendArraySpace(*signature.data(), std::ranges::size(items) * sizeof(ElementType), &space);
+            auto* element = static_cast<ElementType*>(space);
+            for (auto&& item : items)
+                *element++ = item;
+        }
+        else if constexpr (std::is_same_v<ElementType, std::string> && std::ranges::contiguous_range<_Range> && std::ranges::sized_range<_Range>)
+        {
+            appendStringArray(std::ranges::data(items), std::ranges::size(items));
+        }
+        else
+        {
+            openContainer<ElementType>();
+
+            for (auto&& item : items)
+                *this << item;
+
+            closeContainer();
+        }
+
+        return *this;
+    }
+#endif
+
     template <typename _Enum, typename>
     inline Message& Message::operator<<(const _Enum &item)
     {
@@ -397,6 +635,11 @@ namespace sdbus {
             constexpr auto signature = as_null_terminated(signature_of_v<ElementType>);
             appendArray(*signature.data(), items.data(), items.size() * sizeof(ElementType));
         }
+        // Strings are validated in bulk and copied directly into the message, bypassing per-element checks in sd-bus
+        else if constexpr (std::is_same_v<ElementType, std::string>)
+        {
+            appendStringArray(items.data(), items.size());
+        }
         else
         {
             openContainer<ElementType>();
@@ -435,6 +678,49 @@ namespace sdbus {
         return *this;
     }
 
+    template <typename _Container> requires dbus_array_container_v<_Container>
+    inline Message& Message::operator<<(const _Container& items)
+    {
+        using ElementType = typename _Container::value_type;
+
+        // Contiguous containers take the same one-step paths as std::vector
+        if constexpr (requires { items.data(); items.size(); })
+        {
+            serializeArray(items);
+        }
+        else
+        {
+            openContainer<ElementType>();
+
+            for (const auto& item : items)
+                *this << item;
+
+            closeContainer();
+        }
+
+        return *this;
+    }
+
+    template <typename _Container> requires dbus_dictionary_container_v<_Container>
+    inline Message& Message::operator<<(const _Container& items)
+    {
+        using KeyType = typename _Container::key_type;
+        using ValueType = typename _Container::mapped_type;
+
+        // Flat maps iterate over proxies of keys and values, hence each entry is written member-wise
+        serializeDictionary<KeyType, ValueType>([&items](Message& msg)
+        {
+            for (const auto& [key, value] : items)
+            {
+                msg.openDictEntry<KeyType, ValueType>();
+                msg << key << value;
+                msg.closeDictEntry();
+            }
+        });
+
+        return *this;
+    }
+
     template <typename _Key, typename _Value>
     inline Message& Message::serializeDictionary(const std::initializer_list<DictEntry<_Key, _Value>>& items)
     {
@@ -468,14 +754,33 @@ namespace sdbus {
         {
             serialize_pack(msg, std::get<_Is>(t)...);
         }
+
+        template <class _Tuple, std::size_t... _Is>
+        void serialize_trivial_struct( Message& msg
+                                     , const char* signature
+                                     , const _Tuple& t
+                                     , std::index_sequence<_Is...>)
+        {
+            msg.appendTrivialStruct(signature, std::get<_Is>(t)...);
+        }
     }
 
     template <typename... _ValueTypes>
     inline Message& Message::operator<<(const Struct<_ValueTypes...>& item)
     {
-        openStruct<_ValueTypes...>();
-        detail::serialize_tuple(*this, item, std::index_sequence_for<_ValueTypes...>{});
-        closeStruct();
+        // Use faster, one-step serialization of structs of fixed-size basic types (e.g. elements of a(idt) arrays),
+        // otherwise open the struct and serialize its fields one by one.
+        if constexpr (is_trivial_dbus_struct_v<Struct<_ValueTypes...>>)
+        {
+            constexpr auto signature = as_null_terminated(signature_of_v<Struct<_ValueTypes...>>);
+            detail::serialize_trivial_struct(*this, signature.data(), item, std::index_sequence_for<_ValueTypes...>{});
+        }
+        else
+        {
+            openStruct<_ValueTypes...>();
+            detail::serialize_tuple(*this, item, std::index_sequence_for<_ValueTypes...>{});
+            closeStruct();
+        }
 
         return *this;
     }
@@ -487,6 +792,32 @@ namespace sdbus {
         return *this;
     }
 
+    namespace detail
+    {
+        template <typename _Column, typename... _Columns>
+        bool have_equal_lengths(const _Column& column, const _Columns&... columns)
+        {
+            return ((std::size(columns) == std::size(column)) && ...);
+        }
+    }
+
+    template <typename... _ValueTypes>
+    inline Message& Message::operator<<(const Columns<_ValueTypes...>& item)
+    {
+        return *this << ColumnsView<_ValueTypes...>{item};
+    }
+
+    template <typename... _ValueTypes>
+    inline Message& Message::operator<<(const ColumnsView<_ValueTypes...>& item)
+    {
+        // Each column goes as an array of trivial D-Bus type, i.e. in a single step
+        openStruct<std::vector<_ValueTypes>...>();
+        detail::serialize_tuple(*this, item.columns_, std::index_sequence_for<_ValueTypes...>{});
+        closeStruct();
+
+        return *this;
+    }
+
     namespace detail
     {
         template <typename _Element, typename... _Elements>
@@ -514,6 +845,41 @@ namespace sdbus {
         return *this;
     }
 
+    template <typename _Allocator>
+    inline Message& Message::operator>>(std::basic_string<char, std::char_traits<char>, _Allocator>& item)
+    {
+        char* str{};
+        (*this) >> str;
+
+        if (str != nullptr)
+            item.assign(str);
+
+        return *this;
+    }
+
+    namespace detail
+    {
+        template <typename _Type>
+        struct is_pair : std::false_type {};
+        template <typename _First, typename _Second>
+        struct is_pair<std::pair<_First, _Second>> : std::true_type {};
+
+        // Creates an empty element of a container with an allocator derived from the container's one, where
+        // the element supports that, so that e.g. a std::pmr container propagates its memory resource to nested
+        // strings and containers, and the elements are then moved into the container without reallocation.
+        template <typename _Element, typename _Allocator>
+        _Element make_element(const _Allocator& allocator)
+        {
+            if constexpr (is_pair<_Element>::value)
+                return _Element{ make_element<typename _Element::first_type>(allocator)
+                               , make_element<typename _Element::second_type>(allocator) };
+            else if constexpr (std::uses_allocator_v<_Element, _Allocator> && std::is_constructible_v<_Element, const _Allocator&>)
+                return _Element(allocator);
+            else
+                return _Element{};
+        }
+    }
+
     template <typename _Element, typename _Allocator>
     inline Message& Message::operator>>(std::vector<_Element, _Allocator>& items)
     {
@@ -538,6 +904,23 @@ namespace sdbus {
 
         return *this;
     }
+
+    template <typename _Element>
+    inline Message& Message::operator>>(std::span<const _Element>& items)
+    {
+        static_assert( signature_of<_Element>::is_trivial_dbus_type && !std::is_same_v<_Element, bool>
+                     , "Array views are only supported for arrays of trivial D-Bus types except bool" );
+
+        size_t arraySize{};
+        const _Element* arrayPtr{};
+
+        constexpr auto signature = as_null_terminated(sdbus::signature_of_v<_Element>);
+        readArray(*signature.data(), (const void**)&arrayPtr, &arraySize);
+
+        items = std::span<const _Element>{arrayPtr, arraySize / sizeof(_Element)};
+
+        return *this;
+    }
 #endif
 
     template <typename _Enum, typename>
@@ -623,7 +1006,7 @@ namespace sdbus {
 
         while (true)
         {
-            _Element elem;
+            auto elem = detail::make_element<_Element>(items.get_allocator());
             if (*this >> elem)
                 items.emplace_back(std::move(elem));
             else
@@ -649,7 +1032,7 @@ namespace sdbus {
     template <typename _Key, typename _Value, typename _Compare, typename _Allocator>
     inline Message& Message::operator>>(std::map<_Key, _Value, _Compare, _Allocator>& items)
     {
-        deserializeDictionary<_Key, _Value>([&items](auto dictEntry){ items.insert(std::move(dictEntry)); });
+        deserializeDictionary<_Key, _Value>(items.get_allocator(), [&items](auto dictEntry){ items.insert(std::move(dictEntry)); });
 
         return *this;
     }
@@ -657,20 +1040,87 @@ namespace sdbus {
     template <typename _Key, typename _Value, typename _Hash, typename _KeyEqual, typename _Allocator>
     inline Message& Message::operator>>(std::unordered_map<_Key, _Value, _Hash, _KeyEqual, _Allocator>& items)
     {
-        deserializeDictionary<_Key, _Value>([&items](auto dictEntry){ items.insert(std::move(dictEntry)); });
+        deserializeDictionary<_Key, _Value>(items.get_allocator(), [&items](auto dictEntry){ items.insert(std::move(dictEntry)); });
+
+        return *this;
+    }
+
+    template <typename _Container> requires dbus_array_container_v<_Container>
+    inline Message& Message::operator>>(_Container& items)
+    {
+        using ElementType = typename _Container::value_type;
+
+        if constexpr (signature_of<ElementType>::is_trivial_dbus_type && !std::is_same_v<ElementType, bool>)
+        {
+            size_t arraySize{};
+            const ElementType* arrayPtr{};
+
+            constexpr auto signature = as_null_terminated(sdbus::signature_of_v<ElementType>);
+            readArray(*signature.data(), (const void**)&arrayPtr, &arraySize);
+
+            // The element count is known upfront, so the container grows at most once
+            const auto elementsInMsg = arraySize / sizeof(ElementType);
+            if constexpr (requires { items.reserve(elementsInMsg); })
+                items.reserve(items.size() + elementsInMsg);
+            items.insert(items.end(), arrayPtr, arrayPtr + elementsInMsg);
+        }
+        else
+        {
+            if (!enterContainer<ElementType>())
+                return *this;
+
+            while (true)
+            {
+                auto elem = [&items]
+                {
+                    if constexpr (requires { items.get_allocator(); })
+                        return detail::make_element<ElementType>(items.get_allocator());
+                    else
+                        return ElementType{};
+                }();
+                if (*this >> elem)
+                    items.emplace_back(std::move(elem));
+                else
+                    break;
+            }
+
+            clearFlags();
+
+            exitContainer();
+        }
+
+        return *this;
+    }
+
+    template <typename _Container> requires dbus_dictionary_container_v<_Container>
+    inline Message& Message::operator>>(_Container& items)
+    {
+        using KeyType = typename _Container::key_type;
+        using ValueType = typename _Container::mapped_type;
+
+        // Entries are inserted in one go, so that flat maps sort once instead of shifting elements upon each insertion
+        std::vector<DictEntry<KeyType, ValueType>> entries;
+        deserializeDictionary<KeyType, ValueType>([&entries](auto dictEntry){ entries.push_back(std::move(dictEntry)); });
+        items.insert(std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()));
 
         return *this;
     }
 
     template <typename _Key, typename _Value, typename _Callback>
     inline Message& Message::deserializeDictionary(const _Callback& callback)
+    {
+        return deserializeDictionary<_Key, _Value>(std::allocator<DictEntry<_Key, _Value>>{}, callback);
+    }
+
+    template <typename _Key, typename _Value, typename _Allocator, typename _Callback>
+    inline Message& Message::deserializeDictionary(const _Allocator& allocator, const _Callback& callback)
     {
         if (!enterContainer<DictEntry<_Key, _Value>>())
             return *this;
 
         while (true)
         {
-            DictEntry<_Key, _Value> dictEntry;
+            auto dictEntry = detail::make_element<DictEntry<_Key, _Value>>(allocator);
             *this >> dictEntry;
             if (!*this)
                 break;
@@ -683,6 +1133,63 @@ namespace sdbus {
         return *this;
     }
 
+    template <typename _Element>
+    inline LazyArray<_Element> Message::readArrayLazy()
+    {
+        return LazyArray<_Element>(*this);
+    }
+
+    template <typename _Element>
+    inline LazyArray<_Element>::LazyArray(Message& msg)
+        : msg_(msg)
+    {
+        // Not entering the container (there is no array at the current position) yields an empty range
+        atEnd_ = !msg_.enterContainer<_Element>();
+        if (atEnd_)
+            msg_.clearFlags();
+    }
+
+    template <typename _Element>
+    inline LazyArray<_Element>::~LazyArray()
+    {
+        // Abandoned in the middle of the array, so the rest of the array is skipped
+        if (!atEnd_)
+        {
+            try { msg_.skipToContainerEnd(); finish(); }
+            catch (const Error&) {} // The message is left inconsistent for further reading, but destructors shall not throw
+        }
+    }
+
+    template <typename _Element>
+    inline typename LazyArray<_Element>::iterator LazyArray<_Element>::begin()
+    {
+        assert(!started_); // Input ranges can be iterated only once
+        if (!started_)
+        {
+            started_ = true;
+            if (!atEnd_)
+                readNext();
+        }
+
+        return iterator{this};
+    }
+
+    template <typename _Element>
+    inline void LazyArray<_Element>::readNext()
+    {
+        element_ = _Element{};
+        if (!(msg_ >> element_))
+            finish();
+    }
+
+    template <typename _Element>
+    inline void LazyArray<_Element>::finish()
+    {
+        atEnd_ = true;
+        msg_.clearFlags();
+        msg_.exitContainer();
+    }
+
     namespace detail
     {
         template <typename... _Args>
@@ -698,17 +1205,36 @@ namespace sdbus {
         {
             deserialize_pack(msg, std::get<_Is>(t)...);
         }
+
+        template <class _Tuple, std::size_t... _Is>
+        void deserialize_trivial_struct( Message& msg
+                                       , const char* signature
+                                       , _Tuple& t
+                                       , std::index_sequence<_Is...> )
+        {
+            msg.readTrivialStruct(signature, &std::get<_Is>(t)...);
+        }
     }
 
     template <typename... _ValueTypes>
     inline Message& Message::operator>>(Struct<_ValueTypes...>& item)
     {
-        if (!enterStruct<_ValueTypes...>())
-            return *this;
+        // Use faster, one-step deserialization of structs of fixed-size basic types,
+        // otherwise enter the struct and deserialize its fields one by one.
+        if constexpr (is_trivial_dbus_struct_v<Struct<_ValueTypes...>>)
+        {
+            constexpr auto signature = as_null_terminated(signature_of_v<Struct<_ValueTypes...>>);
+            detail::deserialize_trivial_struct(*this, signature.data(), item, std::index_sequence_for<_ValueTypes...>{});
+        }
+        else
+        {
+            if (!enterStruct<_ValueTypes...>())
+                return *this;
 
-        detail::deserialize_tuple(*this, item, std::index_sequence_for<_ValueTypes...>{});
+            detail::deserialize_tuple(*this, item, std::index_sequence_for<_ValueTypes...>{});
 
-        exitStruct();
+            exitStruct();
+        }
 
         return *this;
     }
@@ -720,6 +1246,40 @@ namespace sdbus {
         return *this;
     }
 
+    template <typename... _ValueTypes>
+    inline Message& Message::operator>>(Columns<_ValueTypes...>& item)
+    {
+        if (!enterStruct<std::vector<_ValueTypes>...>())
+            return *this;
+
+        // Columns are refilled in place, so their memory is reused by batches read repeatedly into them
+        item.clear();
+        detail::deserialize_tuple(*this, item.columns_, std::index_sequence_for<_ValueTypes...>{});
+
+        exitStruct();
+
+        auto equalLengths = std::apply([](const auto&... columns){ return detail::have_equal_lengths(columns...); }, item.columns_);
+        SDBUS_THROW_ERROR_IF(!equalLengths, "Failed to deserialize columns: columns differ in length", EINVAL);
+
+        return *this;
+    }
+
+    template <typename... _ValueTypes>
+    inline Message& Message::operator>>(ColumnsView<_ValueTypes...>& item)
+    {
+        if (!enterStruct<std::vector<_ValueTypes>...>())
+            return *this;
+
+        detail::deserialize_tuple(*this, item.columns_, std::index_sequence_for<_ValueTypes...>{});
+
+        exitStruct();
+
+        auto equalLengths = std::apply([](const auto&... columns){ return detail::have_equal_lengths(columns...); }, item.columns_);
+        SDBUS_THROW_ERROR_IF(!equalLengths, "Failed to deserialize columns: columns differ in length", EINVAL);
+
+        return *this;
+    }
+
     template <typename _ElementType>
     inline Message& Message::openContainer()
     {
@@ -27,13 +27,18 @@
 #ifndef SDBUS_CXX_METHODRESULT_H_
 #define SDBUS_CXX_METHODRESULT_H_
 
+#include <sdbus-c++/Error.h>
 #include <sdbus-c++/Message.h>
 
 #include <cassert>
+#include <coroutine>
+#include <exception>
+#include <tuple>
+#include <utility>
 
 // Forward declarations
-namespace sdbus {
-    class Error;
+namespace sdbus::detail {
+    template <typename _Function> method_callback make_method_callback(_Function&& callback);
 }
 
 namespace sdbus {
@@ -88,6 +93,164 @@ namespace sdbus {
         reply.send();
     }
 
+    namespace detail {
+
+        // Provides co_return support of Task promise types for the given number of method results
+        template <typename... _Results>
+        class TaskPromiseBase
+        {
+        public:
+            void return_value(const std::tuple<_Results...>& results)
+            {
+                std::apply([this](const _Results&... values){ result_.returnResults(values...); }, results);
+            }
+
+        protected:
+            Result<_Results...> result_;
+        };
+
+        template <typename _Result>
+        class TaskPromiseBase<_Result>
+        {
+        public:
+            void return_value(const _Result& value)
+            {
+                result_.returnResults(value);
+            }
+
+        protected:
+            Result<_Result> result_;
+        };
+
+        template <>
+        class TaskPromiseBase<>
+        {
+        public:
+            void return_void()
+            {
+                result_.returnResults();
+            }
+
+        protected:
+            Result<> result_;
+        };
+
+    }
+
+    /********************************************//**
+     * @class Task
+     *
+     * Represents a C++20 coroutine implementing a server-side method.
+     * A method handler returning Task<_Results...> may co_await (e.g.
+     * downstream asynchronous D-Bus calls) without blocking any thread.
+     * sdbus-c++ starts the coroutine upon the method call, keeps the call
+     * and sends the reply once the coroutine co_returns the method return
+     * value(s) -- a single value, or a std::tuple for multiple values --, or
+     * an error reply if the coroutine exits with an exception.
+     *
+     * The coroutine parameters shall be taken by value, as the storage
+     * of deserialized method call arguments does not outlive the first
+     * suspension of the coroutine.
+     *
+     ***********************************************/
+    template <typename... _Results>
+    class Task
+    {
+    public:
+        class promise_type : public detail::TaskPromiseBase<_Results...>
+        {
+        public:
+            Task get_return_object() noexcept;
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            std::suspend_never final_suspend() const noexcept { return {}; }
+            void unhandled_exception() noexcept;
+
+        private:
+            friend Task;
+        };
+
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+        Task(Task&& other) noexcept;
+        Task& operator=(Task&& other) = delete;
+        ~Task();
+
+    private:
+        template <typename _Function> friend method_callback detail::make_method_callback(_Function&& callback);
+        explicit Task(std::coroutine_handle<promise_type> handle) noexcept;
+        void start(MethodCall call) &&;
+
+    private:
+        std::coroutine_handle<promise_type> handle_;
+    };
+
+    template <typename... _Results>
+    inline Task<_Results...> Task<_Results...>::promise_type::get_return_object() noexcept
+    {
+        return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+
+    template <typename... _Results>
+    inline void Task<_Results...>::promise_type::unhandled_exception() noexcept
+    {
+        // An exception leaving this function would leave the coroutine frame behind, so sending
+        // the error reply must not throw. There is nobody else to report a send failure to anyway.
+        try
+        {
+            try
+            {
+                throw;
+            }
+            catch (const Error& e)
+            {
+                this->result_.returnError(e);
+            }
+            catch (const std::exception& e)
+            {
+                this->result_.returnError(Error{SDBUSCPP_ERROR_NAME, e.what()});
+            }
+            catch (...)
+            {
+                this->result_.returnError(Error{SDBUSCPP_ERROR_NAME, "Unknown error occurred"});
+            }
+        }
+        catch (...)
+        {
+        }
+    }
+
+    template <typename... _Results>
+    inline Task<_Results...>::Task(std::coroutine_handle<promise_type> handle) noexcept
+        : handle_(handle)
+    {
+    }
+
+    template <typename... _Results>
+    inline Task<_Results...>::Task(Task&& other) noexcept
+        : handle_(std::exchange(other.handle_, {}))
+    {
+    }
+
+    template <typename... _Results>
+    inline Task<_Results...>::~Task()
+    {
+        // Destroy the coroutine that has never been started
+        if (handle_)
+            handle_.destroy();
+    }
+
+    template <typename... _Results>
+    inline void Task<_Results...>::start(MethodCall call) &&
+    {
+        assert(handle_);
+        auto handle = std::exchange(handle_, {});
+        handle.promise().result_ = Result<_Results...>{std::move(call)};
+
+        // Runs up to the first suspension point. The frame is destroyed upon completion by itself.
+        handle.resume();
+    }
+
 }
 
 #endif /* SDBUS_CXX_METHODRESULT_H_ */
@@ -173,6 +173,19 @@ namespace sdbus {
         {
         }
 
+        /*!
+         * @brief Creates native-like proxy object instance
+         *
+         * @param[in] proxy Proxy object to work upon, e.g. one created by createDirectChannelProxy()
+         *
+         * The native-like proxy object becomes an owner of the provided proxy object.
+         */
+        explicit ProxyInterfaces(std::unique_ptr<IProxy>&& proxy)
+            : ProxyObjectHolder(std::move(proxy))
+            , _Interfaces(getProxy())...
+        {
+        }
+
         /*!
          * @brief Registers handlers for D-Bus signals of the remote object
          *
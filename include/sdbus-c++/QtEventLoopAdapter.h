@@ -0,0 +1,190 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file QtEventLoopAdapter.h
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_QTEVENTLOOPADAPTER_H_
+#define SDBUS_CXX_QTEVENTLOOPADAPTER_H_
+
+#include <sdbus-c++/Error.h>
+#include <sdbus-c++/IConnection.h>
+
+#include <QObject>
+#include <QSocketNotifier>
+#include <QTimer>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <poll.h>
+
+namespace sdbus {
+
+    /********************************************//**
+     * @class QtEventLoopAdapter
+     *
+     * Drives a bus connection from the Qt event loop of the current thread,
+     * without any extra thread. The bus fd and the event fd of the connection
+     * are watched through QSocketNotifier objects, and the connection timeout
+     * through a single-shot QTimer. Pending events are processed in bounded
+     * batches, so that a busy connection doesn't starve other events of the loop.
+     *
+     * The connection must not run its own internal event loop, nor be attached
+     * to another event loop, while it is driven by the adapter. The adapter must
+     * be destroyed before the connection; it may be destroyed from within
+     * a callback handler of the connection.
+     *
+     * The adapter is header-only, so this header is not part of sdbus-c++.h and
+     * requires Qt only when included. It needs no moc processing. The adapter shall
+     * be created, used and destroyed in the thread whose event loop drives it.
+     * Exceptions must not propagate through the Qt event loop, so an error in
+     * processing the connection stops the adapter from driving the connection,
+     * and is reported to the error handler instead.
+     *
+     ***********************************************/
+    class QtEventLoopAdapter
+    {
+    public:
+        static constexpr std::size_t DEFAULT_MAX_EVENTS_PER_BATCH{64};
+        static constexpr std::chrono::microseconds DEFAULT_MAX_BATCH_DURATION{10'000};
+
+        /*!
+         * @brief Starts driving the bus connection from the Qt event loop of the current thread
+         *
+         * @param[in] connection Bus connection to be driven, which must outlive the adapter
+         * @param[in] maxEventsPerBatch Maximum number of events processed before other events get their turn
+         * @param[in] maxBatchDuration Maximum time spent processing events before other events get their turn
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        explicit QtEventLoopAdapter( IConnection& connection
+                                   , std::size_t maxEventsPerBatch = DEFAULT_MAX_EVENTS_PER_BATCH
+                                   , std::chrono::microseconds maxBatchDuration = DEFAULT_MAX_BATCH_DURATION )
+            : connection_(connection)
+            , maxEventsPerBatch_(maxEventsPerBatch)
+            , maxBatchDuration_(maxBatchDuration)
+        {
+            const auto pollData = connection_.getEventLoopPollData();
+            busReadNotifier_ = std::make_unique<QSocketNotifier>(pollData.fd, QSocketNotifier::Read);
+            busWriteNotifier_ = std::make_unique<QSocketNotifier>(pollData.fd, QSocketNotifier::Write);
+            eventNotifier_ = std::make_unique<QSocketNotifier>(pollData.eventFd, QSocketNotifier::Read);
+            timer_ = std::make_unique<QTimer>();
+            timer_->setSingleShot(true);
+            timer_->setTimerType(Qt::PreciseTimer);
+
+            // The notifiers are the context objects, so the connections go away with them
+            QObject::connect(busReadNotifier_.get(), &QSocketNotifier::activated, busReadNotifier_.get(), [this](){ process(); });
+            QObject::connect(busWriteNotifier_.get(), &QSocketNotifier::activated, busWriteNotifier_.get(), [this](){ process(); });
+            QObject::connect(eventNotifier_.get(), &QSocketNotifier::activated, eventNotifier_.get(), [this](){ process(); });
+            QObject::connect(timer_.get(), &QTimer::timeout, timer_.get(), [this](){ process(); });
+
+            arm(pollData);
+        }
+
+        QtEventLoopAdapter(const QtEventLoopAdapter&) = delete;
+        QtEventLoopAdapter& operator=(const QtEventLoopAdapter&) = delete;
+
+        ~QtEventLoopAdapter()
+        {
+            // The notifiers and the timer are deleted right away, even from within their own signal, which Qt allows
+            *alive_ = false;
+        }
+
+        /*!
+         * @brief Sets the handler of errors in processing the connection
+         *
+         * @param[in] errorHandler Handler invoked in the loop thread with the error, after which the adapter
+         *                         doesn't drive the connection anymore. The handler may destroy the adapter.
+         */
+        void setErrorHandler(std::function<void(const Error&)> errorHandler)
+        {
+            errorHandler_ = std::move(errorHandler);
+        }
+
+    private:
+        void arm(const IConnection::PollData& pollData)
+        {
+            busReadNotifier_->setEnabled((pollData.events & POLLIN) != 0);
+            busWriteNotifier_->setEnabled((pollData.events & POLLOUT) != 0);
+            eventNotifier_->setEnabled(true);
+
+            // Timeout is zero if there are events left pending, e.g. by an exhausted batch
+            const auto timeout = pollData.getPollTimeout();
+            if (timeout >= 0)
+                timer_->start(timeout);
+            else
+                timer_->stop();
+        }
+
+        void process()
+        {
+            // The adapter may be destroyed by a handler of the connection
+            auto alive = alive_;
+
+            try
+            {
+                connection_.processPendingEvents(maxEventsPerBatch_, maxBatchDuration_);
+
+                if (*alive)
+                    arm(connection_.getEventLoopPollData());
+            }
+            catch (const Error& e)
+            {
+                if (*alive)
+                    fail(e);
+            }
+            catch (const std::exception& e)
+            {
+                if (*alive)
+                    fail(Error{SDBUSCPP_ERROR_NAME, e.what()});
+            }
+        }
+
+        void fail(const Error& error)
+        {
+            busReadNotifier_->setEnabled(false);
+            busWriteNotifier_->setEnabled(false);
+            eventNotifier_->setEnabled(false);
+            timer_->stop();
+
+            // The handler may destroy the adapter, so it's invoked on a copy
+            if (auto handler = errorHandler_)
+                handler(error);
+        }
+
+        IConnection& connection_;
+        std::size_t maxEventsPerBatch_;
+        std::chrono::microseconds maxBatchDuration_;
+        std::function<void(const Error&)> errorHandler_;
+        std::unique_ptr<QSocketNotifier> busReadNotifier_;
+        std::unique_ptr<QSocketNotifier> busWriteNotifier_;
+        std::unique_ptr<QSocketNotifier> eventNotifier_;
+        std::unique_ptr<QTimer> timer_;
+        std::shared_ptr<bool> alive_{std::make_shared<bool>(true)};
+    };
+
+}
+
+#endif /* SDBUS_CXX_QTEVENTLOOPADAPTER_H_ */
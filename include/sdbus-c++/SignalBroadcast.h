@@ -0,0 +1,190 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file SignalBroadcast.h
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_SIGNALBROADCAST_H_
+#define SDBUS_CXX_SIGNALBROADCAST_H_
+
+#include <sdbus-c++/Error.h>
+#include <sdbus-c++/IProxy.h>
+#include <sdbus-c++/Message.h>
+#include <sdbus-c++/TypeTraits.h>
+#include <sdbus-c++/Types.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sdbus {
+
+    /********************************************//**
+     * @class SignalBroadcast
+     *
+     * Fans a D-Bus signal out to any number of local subscribers. The broadcast subscribes to
+     * the signal only once, through the given proxy, and deserializes the arguments of each
+     * signal only once, into an immutable value shared by all subscribers. Subscribers may keep
+     * the value beyond their invocation without copying it.
+     *
+     * Subscribers are invoked in the event loop thread, in the order of subscription, unless
+     * an executor is given. The executor is then handed one task per subscriber and signal, and
+     * may run them e.g. on a worker pool. Signals whose arguments can't be deserialized into
+     * `_Args...` are dropped.
+     *
+     * The broadcast must not outlive the proxy. Subscription slots may outlive the broadcast.
+     *
+     ***********************************************/
+    template <typename... _Args>
+    class SignalBroadcast
+    {
+    public:
+        using value_type = std::tuple<_Args...>;
+        using value_ptr = std::shared_ptr<const value_type>;
+        using executor = std::function<void(std::function<void()>)>;
+
+        SignalBroadcast( IProxy& proxy
+                       , const InterfaceName& interfaceName
+                       , const SignalName& signalName
+                       , executor taskExecutor = {} )
+            : state_(std::make_shared<State>())
+        {
+            state_->taskExecutor = std::move(taskExecutor);
+            signalSlot_ = proxy.registerSignalHandler( interfaceName
+                                                     , signalName
+                                                     , [state = state_](Signal signal){ state->broadcast(signal); }
+                                                     , return_slot );
+        }
+
+        SignalBroadcast(const SignalBroadcast&) = delete;
+        SignalBroadcast& operator=(const SignalBroadcast&) = delete;
+
+        /*!
+         * @brief Subscribes a local handler to the signal
+         *
+         * @param[in] callback Handler taking either the shared signal value (`const value_ptr&`), or the signal arguments (`const _Args&...`)
+         *
+         * @return RAII-style slot handle; the subscriber is unsubscribed by letting go of it
+         *
+         * Once unsubscribed, the subscriber is not invoked anymore, except by an executor task
+         * that is already running at that moment.
+         */
+        template <typename _Function>
+        [[nodiscard]] Slot subscribe(_Function&& callback)
+        {
+            auto subscriber = std::make_shared<Subscriber>();
+            if constexpr (std::is_invocable_v<_Function, const value_ptr&>)
+                subscriber->callback = std::forward<_Function>(callback);
+            else
+                subscriber->callback = [callback = std::forward<_Function>(callback)](const value_ptr& value){ std::apply(callback, *value); };
+
+            state_->add(subscriber);
+
+            return {subscriber.get(), [weakState = std::weak_ptr<State>(state_), subscriber](void*)
+            {
+                subscriber->active.store(false, std::memory_order_relaxed);
+                if (auto state = weakState.lock())
+                    state->remove(subscriber.get());
+            }};
+        }
+
+    private:
+        struct Subscriber
+        {
+            std::function<void(const value_ptr&)> callback;
+            std::atomic<bool> active{true};
+        };
+        using Subscribers = std::vector<std::shared_ptr<Subscriber>>;
+
+        struct State
+        {
+            void add(std::shared_ptr<Subscriber> subscriber)
+            {
+                std::lock_guard lock(mutex);
+                auto updated = std::make_shared<Subscribers>(*subscribers);
+                updated->push_back(std::move(subscriber));
+                subscribers = std::move(updated);
+            }
+
+            void remove(const Subscriber* subscriber)
+            {
+                std::lock_guard lock(mutex);
+                auto updated = std::make_shared<Subscribers>(*subscribers);
+                updated->erase(std::remove_if(updated->begin(), updated->end(), [subscriber](const auto& s){ return s.get() == subscriber; }), updated->end());
+                subscribers = std::move(updated);
+            }
+
+            void broadcast(Signal& signal)
+            {
+                // Subscribers may (un)subscribe from their handlers, so they are invoked on a snapshot of the list
+                std::shared_ptr<const Subscribers> current;
+                {
+                    std::lock_guard lock(mutex);
+                    current = subscribers;
+                }
+                if (current->empty())
+                    return;
+
+                auto value = std::make_shared<value_type>();
+                try
+                {
+                    signal >> *value;
+                }
+                catch (const Error&)
+                {
+                    return; // Signal with unexpected arguments
+                }
+                value_ptr sharedValue = std::move(value);
+
+                for (const auto& subscriber : *current)
+                {
+                    auto task = [subscriber, sharedValue]()
+                    {
+                        if (subscriber->active.load(std::memory_order_relaxed))
+                            subscriber->callback(sharedValue);
+                    };
+                    if (taskExecutor)
+                        taskExecutor(std::move(task));
+                    else
+                        task();
+                }
+            }
+
+            executor taskExecutor;
+            std::mutex mutex;
+            std::shared_ptr<const Subscribers> subscribers{std::make_shared<Subscribers>()};
+        };
+
+        std::shared_ptr<State> state_;
+        Slot signalSlot_;
+    };
+
+}
+
+#endif /* SDBUS_CXX_SIGNALBROADCAST_H_ */
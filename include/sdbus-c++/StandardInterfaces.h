@@ -27,12 +27,18 @@
 #ifndef SDBUS_CXX_STANDARDINTERFACES_H_
 #define SDBUS_CXX_STANDARDINTERFACES_H_
 
+#include <sdbus-c++/IConnection.h>
 #include <sdbus-c++/IObject.h>
 #include <sdbus-c++/IProxy.h>
 #include <sdbus-c++/Types.h>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 namespace sdbus {
@@ -254,6 +260,12 @@ namespace sdbus {
             return m_proxy.getAllProperties().onInterface(interfaceName);
         }
 
+        template <typename _Struct>
+        _Struct GetAll(std::string_view interfaceName)
+        {
+            return m_proxy.getAllProperties().onInterface<_Struct>(interfaceName);
+        }
+
         template <typename _Function>
         PendingAsyncCall GetAllAsync(const InterfaceName& interfaceName, _Function&& callback)
         {
@@ -348,6 +360,238 @@ namespace sdbus {
         sdbus::IProxy& m_proxy;
     };
 
+    /********************************************//**
+     * @class ObjectManagerMirror
+     *
+     * Client-side replica of the object tree of a remote D-Bus object manager, i.e. of
+     * object paths, their interfaces and properties. The mirror is seeded once by
+     * GetManagedObjects, and from then on kept current by InterfacesAdded, InterfacesRemoved
+     * and PropertiesChanged signals, without re-enumerating the objects. Objects are indexed
+     * by path in a hash table, so their lookup doesn't depend on the number of objects.
+     *
+     * All properties changed under the object manager's path are received through a single
+     * match rule. Signals are processed by the event loop of the given connection, which
+     * must thus be running. When the service name loses its owner, the mirror is emptied;
+     * resync() seeds it again. The mirror is thread-safe; getters return copies of the data.
+     *
+     ***********************************************/
+    class ObjectManagerMirror
+    {
+        static inline const char* OBJECT_MANAGER_INTERFACE_NAME = "org.freedesktop.DBus.ObjectManager";
+        static inline const char* PROPERTIES_INTERFACE_NAME = "org.freedesktop.DBus.Properties";
+
+    public:
+        using Properties = std::map<PropertyName, sdbus::Variant, std::less<>>;
+        using Interfaces = std::map<InterfaceName, Properties, std::less<>>;
+
+        ObjectManagerMirror(sdbus::IConnection& connection, ServiceName destination, ObjectPath objectManagerPath)
+            : m_proxy(sdbus::createProxy(connection, destination, objectManagerPath))
+        {
+            // Subscribe before seeding, so that no change gets lost in between
+            m_slots.push_back(m_proxy->uponSignal("InterfacesAdded")
+                                      .onInterface(OBJECT_MANAGER_INTERFACE_NAME)
+                                      .call([this](const sdbus::ObjectPath& objectPath, const Interfaces& interfaces)
+                                            {
+                                                update([this, objectPath, interfaces](){ applyInterfacesAdded(objectPath, interfaces); });
+                                            }, return_slot));
+            m_slots.push_back(m_proxy->uponSignal("InterfacesRemoved")
+                                      .onInterface(OBJECT_MANAGER_INTERFACE_NAME)
+                                      .call([this](const sdbus::ObjectPath& objectPath, const std::vector<sdbus::InterfaceName>& interfaces)
+                                            {
+                                                update([this, objectPath, interfaces](){ applyInterfacesRemoved(objectPath, interfaces); });
+                                            }, return_slot));
+
+            auto propertiesMatch = "type='signal',sender='" + destination + "',interface='" + PROPERTIES_INTERFACE_NAME
+                                 + "',member='PropertiesChanged',path_namespace='" + objectManagerPath + "'";
+            m_slots.push_back(connection.addMatch(propertiesMatch, [this](sdbus::Message msg)
+            {
+                sdbus::ObjectPath objectPath{msg.getPath()};
+                sdbus::InterfaceName interfaceName;
+                Properties changedProperties;
+                std::vector<PropertyName> invalidatedProperties;
+                msg >> interfaceName >> changedProperties >> invalidatedProperties;
+                update([this, objectPath, interfaceName, changedProperties, invalidatedProperties]()
+                {
+                    applyPropertiesChanged(objectPath, interfaceName, changedProperties, invalidatedProperties);
+                });
+            }, return_slot));
+
+            auto ownerChangedMatch = "type='signal',sender='org.freedesktop.DBus',path='/org/freedesktop/DBus',"
+                                     "interface='org.freedesktop.DBus',member='NameOwnerChanged',arg0='" + destination + "'";
+            m_slots.push_back(connection.addMatch(ownerChangedMatch, [this](sdbus::Message msg)
+            {
+                std::string name, oldOwner, newOwner;
+                msg >> name >> oldOwner >> newOwner;
+                if (newOwner.empty())
+                    update([this](){ m_objects.clear(); });
+            }, return_slot));
+
+            resync();
+        }
+
+        ObjectManagerMirror(const ObjectManagerMirror&) = delete;
+        ObjectManagerMirror& operator=(const ObjectManagerMirror&) = delete;
+        ObjectManagerMirror(ObjectManagerMirror&&) = delete;
+        ObjectManagerMirror& operator=(ObjectManagerMirror&&) = delete;
+
+        ~ObjectManagerMirror()
+        {
+            // Stop receiving signals before the mirrored data go away
+            m_slots.clear();
+            m_proxy.reset();
+        }
+
+        /*!
+         * @brief Re-seeds the mirror by GetManagedObjects
+         *
+         * Changes signalled while the objects are being enumerated are applied on top of the result.
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        void resync()
+        {
+            {
+                std::lock_guard lock(m_mutex);
+                m_seeding = true;
+            }
+
+            std::map<sdbus::ObjectPath, Interfaces> objects;
+            try
+            {
+                m_proxy->callMethod("GetManagedObjects").onInterface(OBJECT_MANAGER_INTERFACE_NAME).storeResultsTo(objects);
+            }
+            catch (...)
+            {
+                std::lock_guard lock(m_mutex);
+                finishSeeding();
+                throw;
+            }
+
+            std::lock_guard lock(m_mutex);
+            m_objects.clear();
+            for (auto& [objectPath, interfaces] : objects)
+                m_objects.emplace(objectPath, std::move(interfaces));
+            finishSeeding();
+        }
+
+        [[nodiscard]] std::size_t size() const
+        {
+            std::lock_guard lock(m_mutex);
+            return m_objects.size();
+        }
+
+        [[nodiscard]] bool hasObject(std::string_view objectPath) const
+        {
+            std::lock_guard lock(m_mutex);
+            return m_objects.find(objectPath) != m_objects.end();
+        }
+
+        [[nodiscard]] std::optional<Interfaces> getObject(std::string_view objectPath) const
+        {
+            std::lock_guard lock(m_mutex);
+            if (auto it = m_objects.find(objectPath); it != m_objects.end())
+                return it->second;
+            return std::nullopt;
+        }
+
+        [[nodiscard]] std::optional<sdbus::Variant> getProperty( std::string_view objectPath
+                                                               , std::string_view interfaceName
+                                                               , std::string_view propertyName ) const
+        {
+            std::lock_guard lock(m_mutex);
+            auto objectIt = m_objects.find(objectPath);
+            if (objectIt == m_objects.end())
+                return std::nullopt;
+            auto interfaceIt = objectIt->second.find(interfaceName);
+            if (interfaceIt == objectIt->second.end())
+                return std::nullopt;
+            auto propertyIt = interfaceIt->second.find(propertyName);
+            if (propertyIt == interfaceIt->second.end())
+                return std::nullopt;
+            return propertyIt->second;
+        }
+
+        [[nodiscard]] std::vector<sdbus::ObjectPath> getObjectPaths() const
+        {
+            std::lock_guard lock(m_mutex);
+            std::vector<sdbus::ObjectPath> objectPaths;
+            objectPaths.reserve(m_objects.size());
+            for (const auto& [objectPath, interfaces] : m_objects)
+                objectPaths.emplace_back(objectPath);
+            return objectPaths;
+        }
+
+    private:
+        struct StringHash
+        {
+            using is_transparent = void;
+            std::size_t operator()(std::string_view str) const noexcept { return std::hash<std::string_view>{}(str); }
+        };
+
+        // Applies the update to the mirror, or queues it up while the mirror is being seeded
+        void update(std::function<void()> change)
+        {
+            std::lock_guard lock(m_mutex);
+            if (m_seeding)
+                m_pendingChanges.push_back(std::move(change));
+            else
+                change();
+        }
+
+        void finishSeeding()
+        {
+            // Replaying changes which precede the enumeration result is harmless, since signals come in order
+            for (const auto& change : m_pendingChanges)
+                change();
+            m_pendingChanges.clear();
+            m_seeding = false;
+        }
+
+        void applyInterfacesAdded(const sdbus::ObjectPath& objectPath, const Interfaces& interfaces)
+        {
+            auto& objectInterfaces = m_objects[objectPath];
+            for (const auto& [interfaceName, properties] : interfaces)
+                objectInterfaces[interfaceName] = properties;
+        }
+
+        void applyInterfacesRemoved(const sdbus::ObjectPath& objectPath, const std::vector<sdbus::InterfaceName>& interfaces)
+        {
+            auto objectIt = m_objects.find(objectPath);
+            if (objectIt == m_objects.end())
+                return;
+            for (const auto& interfaceName : interfaces)
+                objectIt->second.erase(interfaceName);
+            if (objectIt->second.empty())
+                m_objects.erase(objectIt);
+        }
+
+        void applyPropertiesChanged( const sdbus::ObjectPath& objectPath
+                                   , const sdbus::InterfaceName& interfaceName
+                                   , const Properties& changedProperties
+                                   , const std::vector<PropertyName>& invalidatedProperties )
+        {
+            auto objectIt = m_objects.find(objectPath);
+            if (objectIt == m_objects.end())
+                return; // Not a managed object
+            auto interfaceIt = objectIt->second.find(interfaceName);
+            if (interfaceIt == objectIt->second.end())
+                return;
+            auto& properties = interfaceIt->second;
+            for (const auto& [propertyName, value] : changedProperties)
+                properties[propertyName] = value;
+            for (const auto& propertyName : invalidatedProperties)
+                properties.erase(propertyName);
+        }
+
+    private:
+        mutable std::mutex m_mutex;
+        std::unordered_map<std::string, Interfaces, StringHash, std::equal_to<>> m_objects;
+        bool m_seeding{false};
+        std::vector<std::function<void()>> m_pendingChanges;
+        std::unique_ptr<sdbus::IProxy> m_proxy;
+        std::vector<sdbus::Slot> m_slots;
+    };
+
     // Adaptors for the above-listed standard D-Bus interfaces are not necessary because the functionality
     // is provided by underlying libsystemd implementation. The exception is Properties_adaptor,
     // ObjectManager_adaptor and ManagedObject_adaptor, which provide convenience functionality to emit signals.
@@ -508,6 +752,60 @@ namespace sdbus {
         sdbus::IObject& m_object;
     };
 
+    /*!
+     * @brief Direct Channel Convenience Adaptor
+     *
+     * Adding this class as _Interfaces.. template parameter of class AdaptorInterfaces implements
+     * the *Open()* method of the org.sdbuscpp.DirectChannel interface, through which proxies created
+     * by createDirectChannelProxy() upgrade to a direct peer-to-peer channel with this service.
+     * Messages over the channel skip the bus daemon.
+     *
+     * A channel is a socket pair. One end is served by a new server bus connection with its own
+     * event loop thread, the other one is passed to the peer in the reply. Objects reachable over
+     * the channel are exported on the channel's connection by onDirectChannelOpened(), typically
+     * as another adaptor of the same backend at the same object path. The returned handle keeps
+     * them alive until the peer closes the channel, or until this adaptor is destroyed.
+     */
+    class DirectChannel_adaptor
+    {
+    protected:
+        explicit DirectChannel_adaptor(sdbus::IObject& object);
+
+        DirectChannel_adaptor(const DirectChannel_adaptor&) = delete;
+        DirectChannel_adaptor& operator=(const DirectChannel_adaptor&) = delete;
+        DirectChannel_adaptor(DirectChannel_adaptor&&) = delete;
+        DirectChannel_adaptor& operator=(DirectChannel_adaptor&&) = delete;
+
+        ~DirectChannel_adaptor();
+
+        void registerAdaptor();
+
+        /*!
+         * @brief Closes the channels, aborting those still being set up
+         *
+         * Invoked by AdaptorInterfaces::unregisterAdaptor(), i.e. while the final adaptor class
+         * is still alive. Once it returns, onDirectChannelOpened() is not invoked any more.
+         */
+        void unregisterAdaptor();
+
+        /*!
+         * @brief Exports objects to be served over a newly opened direct channel
+         *
+         * @param[in] connection Connection of the channel
+         * @return Handle that keeps the exported objects alive for the life time of the channel
+         *
+         * Invoked in a thread of its own, once the peer has connected to the channel. The connection's
+         * event loop is started after the function returns, so no message is dispatched before that.
+         */
+        virtual std::shared_ptr<void> onDirectChannelOpened(sdbus::IConnection& connection) = 0;
+
+    private:
+        class Channels; // Implemented in the library, so that threads and sockets stay out of this header
+
+        sdbus::IObject& m_object;
+        std::unique_ptr<Channels> m_channels;
+    };
+
 }
 
 #endif /* SDBUS_CXX_STANDARDINTERFACES_H_ */
@@ -0,0 +1,234 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file SubtreeSignalSubscription.h
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef SDBUS_CXX_SUBTREESIGNALSUBSCRIPTION_H_
+#define SDBUS_CXX_SUBTREESIGNALSUBSCRIPTION_H_
+
+#include <sdbus-c++/Error.h>
+#include <sdbus-c++/IConnection.h>
+#include <sdbus-c++/Message.h>
+#include <sdbus-c++/TypeTraits.h>
+#include <sdbus-c++/Types.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace sdbus {
+
+    /********************************************//**
+     * @class SubtreeSignalSubscription
+     *
+     * Subscribes to a D-Bus signal emitted by any object in a subtree of the object path
+     * hierarchy, and dispatches each signal to the handlers of its emitting object. The
+     * subscription installs a single `path_namespace` match rule on the bus, however many
+     * objects of the subtree are watched, and finds the handlers of an object through
+     * an in-process hash map keyed by object path. Thus the matching load of the bus daemon
+     * and the memory taken by match rules stay constant, whereas watching each object through
+     * its own proxy would cost one match rule per object.
+     *
+     * Handlers are invoked in the event loop thread, in the order of their subscription.
+     * Signals from objects without handlers are dropped, as are signals whose arguments
+     * can't be deserialized into the arguments of a typed handler.
+     *
+     * The subscription must not outlive the connection. Handler slots may outlive the subscription.
+     *
+     ***********************************************/
+    class SubtreeSignalSubscription
+    {
+    public:
+        /*!
+         * @brief Subscribes to the signal within the given subtree of objects
+         *
+         * @param[in] connection Bus connection to subscribe on
+         * @param[in] sender Bus name of the signal emitter; empty name means any sender
+         * @param[in] pathNamespace Root of the subtree; signals of the root object itself are included
+         * @param[in] interfaceName Interface the signal belongs to
+         * @param[in] signalName Name of the signal; empty name means any signal of the interface
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        SubtreeSignalSubscription( IConnection& connection
+                                 , const ServiceName& sender
+                                 , const ObjectPath& pathNamespace
+                                 , const InterfaceName& interfaceName
+                                 , const SignalName& signalName = {} )
+            : state_(std::make_shared<State>())
+        {
+            std::string match = "type='signal'";
+            if (!sender.empty())
+                match += ",sender='" + sender + "'";
+            match += ",path_namespace='" + pathNamespace + "'";
+            match += ",interface='" + interfaceName + "'";
+            if (!signalName.empty())
+                match += ",member='" + signalName + "'";
+
+            matchSlot_ = connection.addMatch(match, [state = state_](Message msg){ state->dispatch(msg); }, return_slot);
+        }
+
+        SubtreeSignalSubscription(const SubtreeSignalSubscription&) = delete;
+        SubtreeSignalSubscription& operator=(const SubtreeSignalSubscription&) = delete;
+
+        /*!
+         * @brief Subscribes a handler to the signal of one object of the subtree
+         *
+         * @param[in] objectPath Path of the object whose signals the handler gets
+         * @param[in] callback Handler taking either the signal message (`sdbus::Message`), or the signal arguments
+         *
+         * @return RAII-style slot handle; the handler is unsubscribed by letting go of it
+         *
+         * Any number of handlers may be subscribed for one object.
+         */
+        template <typename _Function>
+        [[nodiscard]] Slot subscribe(const ObjectPath& objectPath, _Function&& callback)
+        {
+            auto handler = std::make_shared<Handler>();
+            if constexpr (std::is_invocable_v<_Function, Message>)
+            {
+                handler->callback = std::forward<_Function>(callback);
+            }
+            else
+            {
+                handler->callback = [callback = std::forward<_Function>(callback)](Message msg)
+                {
+                    tuple_of_function_input_arg_types_t<_Function> signalArgs;
+                    try
+                    {
+                        msg >> signalArgs;
+                    }
+                    catch (const Error&)
+                    {
+                        return; // Signal with unexpected arguments
+                    }
+                    std::apply(callback, std::move(signalArgs));
+                };
+            }
+
+            state_->add(objectPath, handler);
+
+            return {handler.get(), [weakState = std::weak_ptr<State>(state_), objectPath, handler](void*)
+            {
+                handler->active.store(false, std::memory_order_relaxed);
+                if (auto state = weakState.lock())
+                    state->remove(objectPath, handler.get());
+            }};
+        }
+
+        /*!
+         * @brief Returns the number of objects that have a handler subscribed
+         */
+        [[nodiscard]] std::size_t getObjectCount() const
+        {
+            std::lock_guard lock(state_->mutex);
+            return state_->handlers.size();
+        }
+
+    private:
+        struct Handler
+        {
+            std::function<void(Message)> callback;
+            std::atomic<bool> active{true};
+        };
+        using Handlers = std::vector<std::shared_ptr<Handler>>;
+
+        struct StringHash
+        {
+            using is_transparent = void;
+            std::size_t operator()(std::string_view str) const noexcept { return std::hash<std::string_view>{}(str); }
+        };
+
+        struct State
+        {
+            void add(const ObjectPath& objectPath, std::shared_ptr<Handler> handler)
+            {
+                std::lock_guard lock(mutex);
+                auto& current = handlers[objectPath];
+                auto updated = current ? std::make_shared<Handlers>(*current) : std::make_shared<Handlers>();
+                updated->push_back(std::move(handler));
+                current = std::move(updated);
+            }
+
+            void remove(const ObjectPath& objectPath, const Handler* handler)
+            {
+                std::lock_guard lock(mutex);
+                auto it = handlers.find(objectPath);
+                if (it == handlers.end())
+                    return;
+                auto updated = std::make_shared<Handlers>(*it->second);
+                updated->erase(std::remove_if(updated->begin(), updated->end(), [handler](const auto& h){ return h.get() == handler; }), updated->end());
+                if (updated->empty())
+                    handlers.erase(it);
+                else
+                    it->second = std::move(updated);
+            }
+
+            void dispatch(Message& msg)
+            {
+                const auto* path = msg.getPath();
+                if (path == nullptr)
+                    return;
+
+                // Handlers may (un)subscribe from within their invocation, so they are invoked on a snapshot of the object's handlers
+                std::shared_ptr<const Handlers> current;
+                {
+                    std::lock_guard lock(mutex);
+                    auto it = handlers.find(std::string_view{path});
+                    if (it == handlers.end())
+                        return;
+                    current = it->second;
+                }
+
+                for (const auto& handler : *current)
+                {
+                    if (!handler->active.load(std::memory_order_relaxed))
+                        continue;
+                    msg.rewind(true);
+                    handler->callback(msg);
+                }
+            }
+
+            mutable std::mutex mutex;
+            std::unordered_map<std::string, std::shared_ptr<const Handlers>, StringHash, std::equal_to<>> handlers;
+        };
+
+        std::shared_ptr<State> state_;
+        Slot matchSlot_;
+    };
+
+}
+
+#endif /* SDBUS_CXX_SUBTREESIGNALSUBSCRIPTION_H_ */
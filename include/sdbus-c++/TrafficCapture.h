@@ -0,0 +1,124 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file TrafficCapture.h
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_TRAFFICCAPTURE_H_
+#define SDBUS_CXX_TRAFFICCAPTURE_H_
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <string>
+
+// Forward declarations
+namespace sdbus {
+    class Message;
+}
+
+namespace sdbus {
+
+    /********************************************//**
+     * @struct CapturedMessage
+     *
+     * A message read from a traffic capture file, recorded by IConnection::captureTraffic().
+     *
+     * The arguments of the message are kept in the capture's own compact encoding in @c body.
+     * They can be serialized into a real message with appendCapturedArguments(), e.g. into
+     * a method call created through IProxy::createMethodCall() to replay the recorded call.
+     *
+     ***********************************************/
+    struct CapturedMessage
+    {
+        // Same values as D-Bus message types on the wire
+        enum class Type : uint8_t
+        {
+            MethodCall = 1,
+            MethodReturn = 2,
+            MethodError = 3,
+            Signal = 4
+        };
+
+        std::chrono::nanoseconds timestamp{}; // Time the message was received at, since the start of the capture
+        Type type{};
+        std::string path;
+        std::string interfaceName;
+        std::string memberName;
+        std::string sender;
+        std::string destination;
+        std::string signature;
+        std::string body;
+    };
+
+    /********************************************//**
+     * @class TrafficCaptureReader
+     *
+     * Sequential reader of a traffic capture file, recorded by IConnection::captureTraffic().
+     * Messages are read in the order they were received by the capturing connection.
+     *
+     ***********************************************/
+    class TrafficCaptureReader
+    {
+    public:
+        /*!
+         * @brief Opens a traffic capture file
+         *
+         * @param[in] filePath Path to the capture file
+         *
+         * @throws sdbus::Error in case the file cannot be opened or is not a traffic capture
+         */
+        explicit TrafficCaptureReader(const std::string& filePath);
+
+        /*!
+         * @brief Reads the next message from the capture
+         *
+         * @return The next message, or std::nullopt at the end of the capture
+         *
+         * A record truncated by an interrupted capture is treated as the end of the capture.
+         *
+         * @throws sdbus::Error in case the record is corrupted
+         */
+        [[nodiscard]] std::optional<CapturedMessage> next();
+
+    private:
+        std::ifstream file_;
+    };
+
+    /*!
+     * @brief Serializes the arguments of a captured message into the given message
+     *
+     * @param[in] message Message to append the arguments to
+     * @param[in] captured Captured message
+     *
+     * Unix file descriptors are not recorded in the capture, so each of them is
+     * replaced with a descriptor of /dev/null.
+     *
+     * @throws sdbus::Error in case of failure
+     */
+    void appendCapturedArguments(Message& message, const CapturedMessage& captured);
+
+}
+
+#endif /* SDBUS_CXX_TRAFFICCAPTURE_H_ */
@@ -28,6 +28,7 @@
 #define SDBUS_CXX_TYPETRAITS_H_
 
 #include <sdbus-c++/Error.h>
+#include <sdbus-c++/InlineFunction.h>
 
 #include <array>
 #include <cstdint>
@@ -39,6 +40,9 @@
 #  if __has_include(<span>)
 #    include <span>
 #  endif
+#  if __has_include(<flat_map>)
+#    include <flat_map>
+#  endif
 #endif
 #include <string>
 #include <string_view>
@@ -53,9 +57,14 @@
 namespace sdbus {
     class Variant;
     template <typename... _ValueTypes> class Struct;
+    template <typename... _ValueTypes> class Columns;
+    template <typename... _ValueTypes> class ColumnsView;
     class ObjectPath;
     class Signature;
     class UnixFd;
+    class SharedUnixFd;
+    class SharedBuffer;
+    class CompressedBytes;
     template<typename _T1, typename _T2> using DictEntry = std::pair<_T1, _T2>;
     class BusName;
     class InterfaceName;
@@ -67,19 +76,25 @@ namespace sdbus {
     class PropertySetCall;
     class PropertyGetReply;
     template <typename... _Results> class Result;
+    template <typename... _Results> class Task;
     class Error;
+    template <typename _Value> class Expected;
     template <typename _T, typename _Enable = void> struct signature_of;
 }
 
 namespace sdbus {
 
     // Callbacks from sdbus-c++
-    using method_callback = std::function<void(MethodCall msg)>;
-    using async_reply_handler = std::function<void(MethodReply reply, std::optional<Error> error)>;
-    using signal_handler = std::function<void(Signal signal)>;
-    using message_handler = std::function<void(Message msg)>;
-    using property_set_callback = std::function<void(PropertySetCall msg)>;
-    using property_get_callback = std::function<void(PropertyGetReply& reply)>;
+    using method_callback = InlineFunction<void(MethodCall msg)>;
+    using async_reply_handler = InlineFunction<void(MethodReply reply, std::optional<Error> error)>;
+    using signal_handler = InlineFunction<void(Signal signal)>;
+    using message_handler = InlineFunction<void(Message msg)>;
+    using name_request_handler = InlineFunction<void(std::optional<Error> error)>;
+    using signal_match_install_handler = InlineFunction<void(std::optional<Error> error)>;
+    using property_set_callback = InlineFunction<void(PropertySetCall msg)>;
+    using property_get_callback = InlineFunction<void(PropertyGetReply& reply)>;
+    using object_finder = std::function<bool(std::string_view objectPath)>;
+    using object_enumerator = std::function<std::vector<ObjectPath>(std::string_view prefix)>;
 
     // Type-erased RAII-style handle to callbacks/subscriptions registered to sdbus-c++
     using Slot = std::unique_ptr<void, std::function<void(void*)>>;
@@ -103,12 +118,18 @@ namespace sdbus {
     // Tag denoting an asynchronous call that returns std::future as a handle
     struct with_future_t { explicit with_future_t() = default; };
     inline constexpr with_future_t with_future{};
+    // Tag denoting an asynchronous call that returns an awaitable for C++20 coroutines as a handle
+    struct with_awaitable_t { explicit with_awaitable_t() = default; };
+    inline constexpr with_awaitable_t with_awaitable{};
     // Tag denoting a call where the reply shouldn't be waited for
     struct dont_expect_reply_t { explicit dont_expect_reply_t() = default; };
     inline constexpr dont_expect_reply_t dont_expect_reply{};
     // Tag denoting that the variant shall embed the other variant as its value, instead of creating a copy
     struct embed_variant_t { explicit embed_variant_t() = default; };
     inline constexpr embed_variant_t embed_variant{};
+    // Tag denoting a name that shall be taken as is, without validation
+    struct unchecked_name_t { explicit unchecked_name_t() = default; };
+    inline constexpr unchecked_name_t unchecked_name{};
 
     // Helper for static assert
     template <class... _T> constexpr bool always_false = false;
@@ -117,6 +138,17 @@ namespace sdbus {
     template <typename _T, std::size_t _N1, std::size_t _N2>
     constexpr std::array<_T, _N1 + _N2> operator+(std::array<_T, _N1> lhs, std::array<_T, _N2> rhs);
 
+    // Customization points for third-party containers (small_vector, static_vector, flat_map, ...). Specialize
+    // `dbus_array_container_v` to true for a sequence container to (de)serialize it as a D-Bus array of its
+    // `value_type`; the container shall provide begin()/end(), emplace_back() and a range insert(pos, first, last),
+    // and may provide data()/size() and reserve() for bulk copies. Specialize `dbus_dictionary_container_v` to true
+    // for an associative container to (de)serialize it as a D-Bus dictionary of its `key_type` to its `mapped_type`;
+    // the container shall provide begin()/end() and a range insert(first, last).
+    template <typename _Container>
+    constexpr bool dbus_array_container_v = false;
+    template <typename _Container>
+    constexpr bool dbus_dictionary_container_v = false;
+
     // Template specializations for getting D-Bus signatures from C++ types
     template <typename _T>
     constexpr auto signature_of_v = signature_of<_T>::value;
@@ -239,6 +271,10 @@ namespace sdbus {
         static constexpr bool is_trivial_dbus_type = false;
     };
 
+    template <typename _Allocator> // E.g. std::pmr::string
+    struct signature_of<std::basic_string<char, std::char_traits<char>, _Allocator>> : signature_of<std::string>
+    {};
+
     template <>
     struct signature_of<std::string_view> : signature_of<std::string>
     {};
@@ -281,6 +317,32 @@ namespace sdbus {
         static constexpr bool is_trivial_dbus_type = false;
     };
 
+    // Column-oriented batches go as structs of arrays, one array per column
+    template <typename... _ValueTypes>
+    struct signature_of<Columns<_ValueTypes...>> : signature_of<Struct<std::vector<_ValueTypes>...>>
+    {};
+
+    template <typename... _ValueTypes>
+    struct signature_of<ColumnsView<_ValueTypes...>> : signature_of<Columns<_ValueTypes...>>
+    {};
+
+    // Struct made up solely of fixed-size arithmetic D-Bus types except bool, whose fields
+    // can be (de)serialized in a single step, without walking them one by one
+    template <typename _T>
+    struct is_trivial_dbus_struct : std::false_type
+    {};
+
+    template <typename... _ValueTypes>
+    struct is_trivial_dbus_struct<Struct<_ValueTypes...>>
+        : std::bool_constant<( sizeof...(_ValueTypes) > 0
+                            && ((  std::is_arithmetic_v<std::remove_cvref_t<_ValueTypes>>
+                                && !std::is_same_v<std::remove_cvref_t<_ValueTypes>, bool>
+                                && signature_of<std::remove_cvref_t<_ValueTypes>>::is_trivial_dbus_type ) && ...) )>
+    {};
+
+    template <typename _T>
+    inline constexpr bool is_trivial_dbus_struct_v = is_trivial_dbus_struct<_T>::value;
+
     template <>
     struct signature_of<Variant>
     {
@@ -317,6 +379,28 @@ namespace sdbus {
         static constexpr bool is_trivial_dbus_type = false;
     };
 
+    template <>
+    struct signature_of<SharedUnixFd> : signature_of<UnixFd>
+    {};
+
+    template <>
+    struct signature_of<SharedBuffer>
+    {
+        static constexpr std::array value{'(', 'h', 't', ')'};
+        static constexpr char type_value{'r'}; /* Not actually used in signatures on D-Bus, see specs */
+        static constexpr bool is_valid = true;
+        static constexpr bool is_trivial_dbus_type = false;
+    };
+
+    template <>
+    struct signature_of<CompressedBytes>
+    {
+        static constexpr std::array value{'(', 'u', 'y', 'a', 'y', ')'};
+        static constexpr char type_value{'r'}; /* Not actually used in signatures on D-Bus, see specs */
+        static constexpr bool is_valid = true;
+        static constexpr bool is_trivial_dbus_type = false;
+    };
+
     template <typename _T1, typename _T2>
     struct signature_of<DictEntry<_T1, _T2>>
     {
@@ -365,10 +449,28 @@ namespace sdbus {
     {
     };
 
+    template <typename _Container>
+    struct signature_of<_Container, std::enable_if_t<dbus_array_container_v<_Container>>>
+        : signature_of<std::vector<typename _Container::value_type>>
+    {
+    };
+
+    template <typename _Container>
+    struct signature_of<_Container, std::enable_if_t<dbus_dictionary_container_v<_Container>>>
+        : signature_of<std::map<typename _Container::key_type, typename _Container::mapped_type>>
+    {
+    };
+
+#ifdef __cpp_lib_flat_map
+    template <typename _Key, typename _Value, typename _Compare, typename _KeyContainer, typename _ValueContainer>
+    constexpr bool dbus_dictionary_container_v<std::flat_map<_Key, _Value, _Compare, _KeyContainer, _ValueContainer>> = true;
+#endif
+
     template <typename... _Types>
     struct signature_of<std::tuple<_Types...>> // A simple concatenation of signatures of _Types
     {
-        static constexpr std::array value = (std::array<char, 0>{} + ... + signature_of_v<_Types>);
+        // References are stripped, as tuples of references (e.g. from std::forward_as_tuple) get probed for signature validity too
+        static constexpr std::array value = (std::array<char, 0>{} + ... + signature_of_v<std::remove_cvref_t<_Types>>);
         static constexpr bool is_valid = false;
         static constexpr bool is_trivial_dbus_type = false;
     };
@@ -428,6 +530,9 @@ namespace sdbus {
 
         template <size_t _Idx>
         using arg_t = typename arg<_Idx>::type;
+
+        static constexpr bool is_coroutine = false;
+        static constexpr bool returns_expected = false;
     };
 
     template <typename _ReturnType, typename... _Args>
@@ -457,6 +562,24 @@ namespace sdbus {
         using async_result_t = Result<_Results...>;
     };
 
+    template <typename... _Args, typename _Value>
+    struct function_traits<Expected<_Value>(_Args...)> : function_traits_base<_Value, _Args...>
+    {
+        static constexpr bool is_async = false;
+        static constexpr bool has_error_param = false;
+        static constexpr bool returns_expected = true;
+    };
+
+    template <typename... _Args, typename... _Results>
+    struct function_traits<Task<_Results...>(_Args...)> : function_traits_base<std::tuple<_Results...>, _Args...>
+    {
+        static constexpr bool is_async = false;
+        static constexpr bool is_coroutine = true;
+        static constexpr bool has_error_param = false;
+        static constexpr bool has_reference_params = std::disjunction_v<std::is_reference<_Args>...>;
+        using task_t = Task<_Results...>;
+    };
+
     template <typename _ReturnType, typename... _Args>
     struct function_traits<_ReturnType(*)(_Args...)> : function_traits<_ReturnType(_Args...)>
     {};
@@ -489,12 +612,22 @@ namespace sdbus {
     struct function_traits<std::function<FunctionType>> : function_traits<FunctionType>
     {};
 
+    template <typename FunctionType, std::size_t InlineSize>
+    struct function_traits<InlineFunction<FunctionType, InlineSize>> : function_traits<FunctionType>
+    {};
+
     template <class _Function>
     constexpr auto is_async_method_v = function_traits<_Function>::is_async;
 
     template <class _Function>
     constexpr auto has_error_param_v = function_traits<_Function>::has_error_param;
 
+    template <class _Function>
+    constexpr auto is_coroutine_method_v = function_traits<_Function>::is_coroutine;
+
+    template <class _Function>
+    constexpr auto returns_expected_v = function_traits<_Function>::returns_expected;
+
     template <typename _FunctionType>
     using function_arguments_t = typename function_traits<_FunctionType>::arguments_type;
 
@@ -587,6 +720,17 @@ namespace sdbus {
         const _Struct& m_struct;
     };
 
+    // Wrapper (tag) denoting we want to deserialize user-defined struct from a D-Bus message
+    // dictionary of strings to variants in relaxed mode, i.e. skipping keys that have no counterpart
+    // member in the struct, regardless of the struct's strict_dict_as_struct_deserialization_v setting.
+    // Suitable for results of org.freedesktop.DBus.Properties.GetAll, which may carry more properties than we care about.
+    template <typename _Struct>
+    struct from_relaxed_dictionary
+    {
+        explicit from_relaxed_dictionary(_Struct& s) : m_struct(s) {}
+        _Struct& m_struct;
+    };
+
     template <typename _Type>
     const _Type& as_dictionary_if_struct(const _Type& object)
     {
@@ -608,6 +752,12 @@ namespace sdbus {
     template <typename _Struct>
     constexpr auto nested_struct_as_dict_serialization_v = false;
 
+    // Gives access to members of a user-defined struct. SDBUSCPP_REGISTER_STRUCT specializes it with a static
+    // `tie(STRUCT&)' function returning a tuple of references to the registered members.
+    template <typename _Struct>
+    struct struct_members
+    {};
+
     namespace detail
     {
         template <class _Function, class _Tuple, typename... _Args, std::size_t... _I>
@@ -674,6 +824,52 @@ namespace sdbus {
                                  , std::make_index_sequence<std::tuple_size<std::decay_t<_Tuple>>::value>{} );
     }
 
+    namespace detail
+    {
+        // Gives tuple `t' as an rvalue if its values can be moved into function of type `_Function', i.e. unless
+        // the function takes some of them by non-const lvalue reference, in which case it gives it as an lvalue
+        template <class _Function, typename... _Args>
+        constexpr decltype(auto) forward_args_for(std::tuple<_Args...>& t)
+        {
+            if constexpr (std::is_invocable_v<_Function, _Args&&...>)
+                return std::move(t);
+            else
+                return (t);
+        }
+    }
+
+    // Invoke function `f' with the values of tuple `t' moved in, so that by-value parameters take them
+    // over without a copy. A function taking some of them by non-const lvalue reference gets lvalues.
+    template <class _Function, typename... _Args>
+    constexpr decltype(auto) apply_moving(_Function&& f, std::tuple<_Args...>& t)
+    {
+        return sdbus::apply(std::forward<_Function>(f), detail::forward_args_for<_Function>(t));
+    }
+
+    namespace detail
+    {
+        // Empties a deserialization target kept for reuse, so that the next deserialization refills it. Containers
+        // (and other types with clear()) are cleared, keeping their capacity, structs registered with
+        // SDBUSCPP_REGISTER_STRUCT, sdbus::Structs and tuples are emptied field by field, and values of other types
+        // are reset to their default value. That matters for structs deserialized from a{sv} dictionaries, which
+        // only set the members whose keys are present.
+        template <typename _T>
+        void clear_for_reuse(_T& value)
+        {
+            if constexpr (requires { value.clear(); })
+                value.clear();
+            else if constexpr (requires { struct_members<_T>::tie(value); })
+            {
+                auto members = struct_members<_T>::tie(value);
+                clear_for_reuse(members);
+            }
+            else if constexpr (requires { std::tuple_size<_T>::value; } && !requires { value.begin(); })
+                std::apply([](auto&... fields){ (clear_for_reuse(fields), ...); }, value);
+            else if constexpr (std::is_default_constructible_v<_T> && std::is_move_assignable_v<_T>)
+                value = _T{};
+        }
+    }
+
     // Convenient concatenation of arrays
     template <typename _T, std::size_t _N1, std::size_t _N2>
     constexpr std::array<_T, _N1 + _N2> operator+(std::array<_T, _N1> lhs, std::array<_T, _N2> rhs)
@@ -32,12 +32,18 @@
 
 #include <cstring>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
 #include <memory>
+#include <span>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <type_traits>
 #include <typeinfo>
 #include <utility>
+#include <vector>
 
 namespace sdbus {
 
@@ -59,15 +65,25 @@ namespace sdbus {
         Variant();
 
         template <typename _ValueType>
-        explicit Variant(const _ValueType& value) : Variant()
+        explicit Variant(const _ValueType& value)
         {
-            msg_.openVariant<_ValueType>();
-            msg_ << value;
-            msg_.closeVariant();
-            msg_.seal();
+            if constexpr (is_inline_type_v<_ValueType>)
+            {
+                inlineSignature_[0] = signature_of_v<_ValueType>[0];
+                std::memcpy(&inlineValue_, &value, sizeof(value));
+            }
+            else
+            {
+                msg_ = createPlainMessage();
+                msg_.openVariant<_ValueType>();
+                msg_ << value;
+                msg_.closeVariant();
+                msg_.seal();
+            }
         }
 
-        Variant(const Variant& value, embed_variant_t) : Variant()
+        Variant(const Variant& value, embed_variant_t)
+            : msg_(createPlainMessage())
         {
             msg_.openVariant<Variant>();
             msg_ << value;
@@ -76,7 +92,8 @@ namespace sdbus {
         }
 
         template <typename _Struct>
-        explicit Variant(const as_dictionary<_Struct>& value) : Variant()
+        explicit Variant(const as_dictionary<_Struct>& value)
+            : msg_(createPlainMessage())
         {
             msg_.openVariant<std::map<std::string, Variant>>();
             msg_ << as_dictionary(value.m_struct);
@@ -86,7 +103,7 @@ namespace sdbus {
 
         template <typename... _Elements>
         Variant(const std::variant<_Elements...>& value)
-            : Variant()
+            : msg_(createPlainMessage())
         {
             msg_ << value;
             msg_.seal();
@@ -95,6 +112,17 @@ namespace sdbus {
         template <typename _ValueType>
         _ValueType get() const
         {
+            if constexpr (is_inline_type_v<_ValueType>)
+            {
+                if (inlineSignature_[0] == signature_of_v<_ValueType>[0])
+                {
+                    _ValueType val;
+                    std::memcpy(&val, &inlineValue_, sizeof(val));
+                    return val;
+                }
+            }
+
+            materialize();
             msg_.rewind(false);
 
             msg_.enterVariant<_ValueType>();
@@ -115,16 +143,63 @@ namespace sdbus {
         operator std::variant<_Elements...>() const
         {
             std::variant<_Elements...> result;
+            materialize();
             msg_.rewind(false);
             msg_ >> result;
             return result;
         }
 
+        /*!
+         * @brief Provides the value of the variant, decoding it only once
+         *
+         * @return Reference to the decoded value
+         *
+         * The value is decoded upon the first call and kept, so subsequent calls for the same
+         * type cost nothing. The reference is valid until another type is asked for, or until
+         * the variant is deserialized into or destroyed. Copies of the variant share the decoded value.
+         *
+         * @throws sdbus::Error in case the variant does not contain a value of type `_ValueType`
+         */
+        template <typename _ValueType>
+        const _ValueType& getCached() const
+        {
+            if (decodedType_ == nullptr || *decodedType_ != typeid(_ValueType))
+            {
+                decodedValue_ = std::make_shared<const _ValueType>(get<_ValueType>());
+                decodedType_ = &typeid(_ValueType);
+            }
+            return *static_cast<const _ValueType*>(decodedValue_.get());
+        }
+
+        /*!
+         * @brief Invokes the visitor with the value of the variant, if it is one of the given types
+         *
+         * @param[in] visitor Callable (e.g. a set of overloaded lambdas) invocable with each of `const _ValueTypes&`
+         *
+         * @return True if the variant contained a value of one of `_ValueTypes`, false otherwise
+         *
+         * The type is looked up by comparing type tags, and the value is passed as decoded by getCached().
+         */
+        template <typename... _ValueTypes, typename _Visitor>
+        bool visit(_Visitor&& visitor) const
+        {
+            return ((containsValueOfType<_ValueTypes>() && (visitValue<_ValueTypes>(visitor), true)) || ...);
+        }
+
         template <typename _Type>
         bool containsValueOfType() const
         {
             constexpr auto signature = as_null_terminated(signature_of_v<_Type>);
-            return std::strcmp(signature.data(), peekValueType()) == 0;
+            constexpr auto typeTag = typeTagOf({signature.data(), signature.size() - 1});
+            if constexpr (typeTag != LONG_SIGNATURE_TAG)
+            {
+                return valueTypeTag() == typeTag;
+            }
+            else
+            {
+                const auto* valueType = peekValueType();
+                return valueType != nullptr && std::strcmp(signature.data(), valueType) == 0;
+            }
         }
 
         bool isEmpty() const;
@@ -134,7 +209,51 @@ namespace sdbus {
         const char* peekValueType() const;
 
     private:
-        mutable PlainMessage msg_{};
+        // Values of fixed-size basic D-Bus types are stored inline, without any underlying message
+        template <typename _ValueType>
+        static constexpr bool is_inline_type_v = std::is_arithmetic_v<_ValueType> && signature_of<_ValueType>::is_trivial_dbus_type;
+
+        // Signatures of up to 8 characters are packed into an integer tag, so that type checks need no string comparison
+        static constexpr uint64_t LONG_SIGNATURE_TAG{~uint64_t{}};
+        static constexpr uint64_t typeTagOf(std::string_view signature)
+        {
+            if (signature.size() > sizeof(uint64_t))
+                return LONG_SIGNATURE_TAG;
+            uint64_t tag{};
+            for (char c : signature)
+                tag = (tag << 8) | static_cast<uint8_t>(c);
+            return tag;
+        }
+
+        uint64_t valueTypeTag() const
+        {
+            if (inlineSignature_[0] != '\0')
+                return static_cast<uint8_t>(inlineSignature_[0]);
+            if (valueTypeTag_ != 0 && msg_.isValid())
+                return valueTypeTag_;
+            return cacheValueTypeTag();
+        }
+        uint64_t cacheValueTypeTag() const;
+
+        template <typename _ValueType, typename _Visitor>
+        void visitValue(_Visitor& visitor) const
+        {
+            if constexpr (is_inline_type_v<_ValueType>)
+                visitor(get<_ValueType>());
+            else
+                visitor(getCached<_ValueType>());
+        }
+
+        // Moves the inline value, if any, into the underlying message
+        void materialize() const;
+
+    private:
+        mutable PlainMessage msg_{}; // Created lazily, only for values that cannot be stored inline
+        mutable char inlineSignature_[2]{}; // D-Bus signature of the inline value, empty if there is none
+        mutable uint64_t inlineValue_{};
+        mutable uint64_t valueTypeTag_{}; // Type tag of the value in the message, zero until looked up
+        mutable std::shared_ptr<const void> decodedValue_; // Value decoded by getCached(), shared by copies
+        mutable const std::type_info* decodedType_{};
     };
 
     /********************************************//**
@@ -292,6 +411,244 @@ namespace sdbus {
         using std::string::operator=;
     };
 
+    namespace detail {
+
+        constexpr bool isNameCharacter(char c, bool allowDigit, bool allowDash = false)
+        {
+            return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '_'
+                || (allowDigit && c >= '0' && c <= '9') || (allowDash && c == '-');
+        }
+
+        // Validates a sequence of at least `minElements' non-empty elements separated by `separator'
+        constexpr bool areValidNameElements( std::string_view name
+                                           , char separator
+                                           , std::size_t minElements
+                                           , bool allowLeadingDigit
+                                           , bool allowDash )
+        {
+            std::size_t elements = 0;
+            std::size_t elementLength = 0;
+            for (auto c : name)
+            {
+                if (c == separator)
+                {
+                    if (elementLength == 0)
+                        return false;
+                    ++elements;
+                    elementLength = 0;
+                }
+                else if (!isNameCharacter(c, allowLeadingDigit || elementLength > 0, allowDash))
+                    return false;
+                else
+                    ++elementLength;
+            }
+            return elementLength > 0 && elements + 1 >= minElements;
+        }
+
+        constexpr bool isValidObjectPath(std::string_view path)
+        {
+            if (path == "/")
+                return true;
+            return path.size() > 1 && path.front() == '/' && areValidNameElements(path.substr(1), '/', 1, true, false);
+        }
+
+        constexpr bool isValidBusName(std::string_view name)
+        {
+            if (name.empty() || name.size() > 255)
+                return false;
+            if (name.front() == ':')
+                return areValidNameElements(name.substr(1), '.', 2, true, true);
+            return areValidNameElements(name, '.', 2, false, true);
+        }
+
+        constexpr bool isValidInterfaceName(std::string_view name)
+        {
+            return name.size() <= 255 && areValidNameElements(name, '.', 2, false, false);
+        }
+
+        constexpr bool isValidMemberName(std::string_view name)
+        {
+            return name.size() <= 255 && name.find('.') == std::string_view::npos && areValidNameElements(name, '.', 1, false, false);
+        }
+
+        constexpr bool isBasicTypeCode(char c)
+        {
+            return std::string_view{"ybnqiuxtdsogh"}.find(c) != std::string_view::npos;
+        }
+
+        // Parses one complete type starting at `pos', returning the position right after it, or npos if malformed
+        constexpr std::size_t parseCompleteType( std::string_view signature
+                                               , std::size_t pos
+                                               , std::size_t arrayDepth
+                                               , std::size_t structDepth )
+        {
+            constexpr std::size_t MAX_DEPTH = 32;
+            if (pos >= signature.size())
+                return std::string_view::npos;
+
+            const auto c = signature[pos];
+            if (isBasicTypeCode(c) || c == 'v')
+                return pos + 1;
+
+            if (c == 'a')
+            {
+                if (arrayDepth >= MAX_DEPTH || pos + 1 >= signature.size())
+                    return std::string_view::npos;
+                if (signature[pos + 1] != '{')
+                    return parseCompleteType(signature, pos + 1, arrayDepth + 1, structDepth);
+
+                // Dict entries may only appear as array elements, with a basic key and exactly one value
+                if (structDepth >= MAX_DEPTH || pos + 2 >= signature.size() || !isBasicTypeCode(signature[pos + 2]))
+                    return std::string_view::npos;
+                auto next = parseCompleteType(signature, pos + 3, arrayDepth + 1, structDepth + 1);
+                if (next == std::string_view::npos || next >= signature.size() || signature[next] != '}')
+                    return std::string_view::npos;
+                return next + 1;
+            }
+
+            if (c == '(')
+            {
+                if (structDepth >= MAX_DEPTH || pos + 1 >= signature.size() || signature[pos + 1] == ')')
+                    return std::string_view::npos;
+                ++pos;
+                while (pos < signature.size() && signature[pos] != ')')
+                {
+                    pos = parseCompleteType(signature, pos, arrayDepth, structDepth + 1);
+                    if (pos == std::string_view::npos)
+                        return pos;
+                }
+                return pos < signature.size() ? pos + 1 : std::string_view::npos;
+            }
+
+            return std::string_view::npos;
+        }
+
+        // Validates the signature against the full D-Bus type grammar, including container nesting limits
+        constexpr bool isValidSignature(std::string_view signature)
+        {
+            if (signature.size() > 255)
+                return false;
+            std::size_t pos = 0;
+            while (pos < signature.size())
+            {
+                pos = parseCompleteType(signature, pos, 0, 0);
+                if (pos == std::string_view::npos)
+                    return false;
+            }
+            return true;
+        }
+
+        /********************************************//**
+         * @class NameView
+         *
+         * Non-owning, null-terminated counterpart of a strong string-based name type.
+         * Unlike the owning name types, it never allocates, and it can be constexpr.
+         * A NameView constructed from a string literal is validated at compile time,
+         * so a malformed name is a compilation error.
+         *
+         ***********************************************/
+        template <typename _Name, bool (*_IsValid)(std::string_view)>
+        class NameView
+        {
+        public:
+            template <std::size_t _N>
+            consteval NameView(const char (&literal)[_N])
+                : value_(literal)
+                , size_(_N - 1)
+            {
+                if (!_IsValid(std::string_view{value_, size_}))
+                    throw "Malformed D-Bus name literal"; // Fails compilation
+            }
+            NameView(const _Name& name) noexcept
+                : value_(name.c_str())
+                , size_(name.size())
+            {}
+            // Takes the name as is, without validation. A plain `const char*' constructor would be
+            // a better match for string literals than the validating one, hence the tag.
+            constexpr NameView(const char* value, unchecked_name_t) noexcept
+                : value_(value)
+                , size_(std::char_traits<char>::length(value))
+            {}
+
+            [[nodiscard]] constexpr const char* c_str() const noexcept { return value_; }
+            [[nodiscard]] constexpr std::size_t size() const noexcept { return size_; }
+            [[nodiscard]] constexpr bool empty() const noexcept { return size_ == 0; }
+            [[nodiscard]] constexpr std::string_view view() const noexcept { return {value_, size_}; }
+            constexpr operator const char*() const noexcept { return value_; }
+            constexpr operator std::string_view() const noexcept { return view(); }
+
+            // Names compare by their contents, not by their addresses
+            template <typename _String>
+                requires std::is_convertible_v<const _String&, std::string_view>
+            friend constexpr bool operator==(const NameView& lhs, const _String& rhs)
+            {
+                return lhs.view() == std::string_view{rhs};
+            }
+            friend constexpr bool operator==(const NameView& lhs, const NameView& rhs)
+            {
+                return lhs.view() == rhs.view();
+            }
+
+        private:
+            const char* value_;
+            std::size_t size_;
+        };
+
+        const char* internName(std::string_view name);
+    }
+
+    using ObjectPathView = detail::NameView<ObjectPath, detail::isValidObjectPath>;
+    using BusNameView = detail::NameView<BusName, detail::isValidBusName>;
+    using ServiceNameView = BusNameView;
+    using InterfaceNameView = detail::NameView<InterfaceName, detail::isValidInterfaceName>;
+    using MemberNameView = detail::NameView<MemberName, detail::isValidMemberName>;
+    using MethodNameView = MemberNameView;
+    using SignalNameView = MemberNameView;
+    using PropertyNameView = MemberNameView;
+    using SignatureView = detail::NameView<Signature, detail::isValidSignature>;
+
+    /*!
+     * @brief Interns the name in the process-wide table of names
+     *
+     * @param[in] name Name to intern
+     * @return View of the interned name
+     *
+     * Equal names share a single copy in the table, which is never released, so the returned view
+     * stays valid until the end of the program (including static destruction). This is meant for
+     * long-lived names like those of interfaces and members, that are known only at run time,
+     * so that they can be passed around and stored as views, without allocation.
+     *
+     * This function is thread-safe.
+     */
+    [[nodiscard]] inline ObjectPathView intern(const ObjectPath& name) { return ObjectPathView{detail::internName(name), unchecked_name}; }
+    [[nodiscard]] inline BusNameView intern(const BusName& name) { return BusNameView{detail::internName(name), unchecked_name}; }
+    [[nodiscard]] inline InterfaceNameView intern(const InterfaceName& name) { return InterfaceNameView{detail::internName(name), unchecked_name}; }
+    [[nodiscard]] inline MemberNameView intern(const MemberName& name) { return MemberNameView{detail::internName(name), unchecked_name}; }
+    [[nodiscard]] inline SignatureView intern(const Signature& name) { return SignatureView{detail::internName(name), unchecked_name}; }
+
+    /********************************************//**
+     * @struct SignalArgFilter
+     *
+     * Condition on a string argument of a D-Bus signal, which becomes an `argN`,
+     * `argNpath` or `arg0namespace` item of the match rule of a signal subscription.
+     * The condition is evaluated by the bus broker, so signals not satisfying it
+     * aren't delivered to the subscriber at all.
+     *
+     ***********************************************/
+    struct SignalArgFilter
+    {
+        enum class Kind
+        {
+            Equals,     // `argN`: the argument is a string equal to the value
+            Path,       // `argNpath`: the argument equals the value, or either of them is a prefix of the other ending with '/'
+            Namespace   // `arg0namespace`: the argument is a bus or interface name equal to the value, or within its namespace
+        };
+
+        uint8_t index{};  // Index of the argument, up to 63; only argument 0 can be filtered by namespace
+        Kind kind{Kind::Equals};
+        std::string value;
+    };
+
     /********************************************//**
      * @struct UnixFd
      *
@@ -391,6 +748,409 @@ namespace sdbus {
         int fd_ = -1;
     };
 
+    /********************************************//**
+     * @class SharedUnixFd
+     *
+     * SharedUnixFd is a representation of file descriptor D-Bus type whose copies
+     * share one underlying fd, which is closed when the last copy goes out of scope.
+     *
+     * Copying a UnixFd duplicates the fd, whereas copying a SharedUnixFd only updates
+     * a reference count, so it suits fds passed around in handlers, Variants and
+     * containers. The fd is duplicated at the D-Bus boundary only: by sd-bus when
+     * it's serialized into a message, and when it's deserialized from a message.
+     *
+     ***********************************************/
+    class SharedUnixFd
+    {
+    public:
+        SharedUnixFd() = default;
+
+        explicit SharedUnixFd(int fd)
+            : SharedUnixFd(UnixFd{fd})
+        {
+        }
+
+        SharedUnixFd(int fd, adopt_fd_t)
+            : SharedUnixFd(UnixFd{fd, adopt_fd})
+        {
+        }
+
+        explicit SharedUnixFd(UnixFd fd)
+            : fd_(fd.isValid() ? std::make_shared<const UnixFd>(std::move(fd)) : nullptr)
+        {
+        }
+
+        [[nodiscard]] int get() const
+        {
+            return fd_ != nullptr ? fd_->get() : -1;
+        }
+
+        void reset()
+        {
+            fd_.reset();
+        }
+
+        /// Returns a UnixFd owning a duplicate of the shared fd
+        [[nodiscard]] UnixFd duplicate() const
+        {
+            return UnixFd{get()};
+        }
+
+        [[nodiscard]] bool isValid() const
+        {
+            return fd_ != nullptr;
+        }
+
+    private:
+        std::shared_ptr<const UnixFd> fd_; // Closed with the last copy
+    };
+
+    /********************************************//**
+     * @class SharedBuffer
+     *
+     * Representation of a read-only block of bytes kept in sealed shared memory
+     * (a memfd), for transferring large payloads without copying them through
+     * the bus. On D-Bus, it's passed as a struct of the memfd and the payload
+     * size, i.e. with signature (ht). The receiving side maps the memory read-only.
+     *
+     * The memfd is sealed against writing, shrinking and growing before it's
+     * sent, and the receiver refuses a memfd without these seals, so neither
+     * side can change the data under the other's hands.
+     *
+     * Copies of a SharedBuffer share the memory mapping.
+     *
+     ***********************************************/
+    class SharedBuffer
+    {
+    public:
+        SharedBuffer() = default;
+
+        /// Creates a shared buffer holding a copy of the given data
+        explicit SharedBuffer(std::span<const std::byte> data);
+
+        /// Creates a shared buffer of the given size, whose content is written in place by the fill function
+        SharedBuffer(std::size_t size, const std::function<void(std::span<std::byte>)>& fill);
+
+        /// Creates a shared buffer upon a sealed memfd received from the peer, throws sdbus::Error if not sealed
+        SharedBuffer(UnixFd fd, std::size_t size);
+
+        [[nodiscard]] std::span<const std::byte> data() const
+        {
+            return {mapping_.get(), size_};
+        }
+
+        [[nodiscard]] std::size_t size() const
+        {
+            return size_;
+        }
+
+        [[nodiscard]] const UnixFd& getFd() const
+        {
+            return fd_;
+        }
+
+        [[nodiscard]] bool isValid() const
+        {
+            return fd_.isValid();
+        }
+
+    private:
+        UnixFd fd_;
+        std::size_t size_{};
+        std::shared_ptr<const std::byte> mapping_; // Unmapped with the last copy of the buffer
+    };
+
+    /********************************************//**
+     * @class CompressedBytes
+     *
+     * Representation of a block of bytes transferred compressed, for passing
+     * large payloads over links where bandwidth is the bottleneck, e.g. remote
+     * bus connections tunneled through SSH. On D-Bus, it's passed as a struct
+     * of the original size, the codec and the data, i.e. with signature (uyay).
+     * The data is compressed upon serialization and decompressed upon
+     * deserialization.
+     *
+     * Blocks smaller than the threshold, blocks that don't shrink, and blocks
+     * whose codec is not available in this build of sdbus-c++ are passed
+     * uncompressed. Deserialization of a block compressed by a codec not
+     * available in this build fails.
+     *
+     ***********************************************/
+    class CompressedBytes
+    {
+    public:
+        enum class Codec : std::uint8_t
+        {
+            None = 0,
+            Lz4 = 1,
+            Zstd = 2
+        };
+
+        static constexpr std::size_t DEFAULT_THRESHOLD = 4096;
+
+        CompressedBytes() = default;
+
+        /// Holds the given data, to be compressed by the codec upon serialization if it's at least threshold bytes long
+        explicit CompressedBytes(std::vector<std::uint8_t> data, Codec codec = Codec::Zstd, std::size_t threshold = DEFAULT_THRESHOLD)
+            : data_(std::move(data)), codec_(codec), threshold_(threshold)
+        {
+        }
+
+        [[nodiscard]] const std::vector<std::uint8_t>& data() const &
+        {
+            return data_;
+        }
+
+        [[nodiscard]] std::vector<std::uint8_t> data() &&
+        {
+            return std::move(data_);
+        }
+
+        [[nodiscard]] Codec getCodec() const
+        {
+            return codec_;
+        }
+
+        [[nodiscard]] std::size_t getThreshold() const
+        {
+            return threshold_;
+        }
+
+        /// Tells whether the codec is available in this build of sdbus-c++ (None always is)
+        [[nodiscard]] static bool isCodecAvailable(Codec codec);
+
+    private:
+        std::vector<std::uint8_t> data_;
+        Codec codec_{Codec::Zstd};
+        std::size_t threshold_{DEFAULT_THRESHOLD};
+    };
+
+    namespace detail
+    {
+        // Columns are (de)serialized as contiguous blocks, which D-Bus allows for fixed-size basic types except bool
+        template <typename _Value>
+        constexpr bool is_column_value_v = signature_of<_Value>::is_trivial_dbus_type && !std::is_same_v<_Value, bool>;
+
+        // Random access iterator over rows of a column-oriented batch, yielding tuples of references to row values
+        template <typename _Columns, typename _Reference>
+        class column_row_iterator
+        {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = typename std::remove_const_t<_Columns>::row_type;
+            using difference_type = std::ptrdiff_t;
+            using reference = _Reference;
+            using pointer = void;
+
+            column_row_iterator() = default;
+            column_row_iterator(_Columns* columns, std::size_t row) : columns_(columns), row_(row) {}
+
+            reference operator*() const { return (*columns_)[row_]; }
+            reference operator[](difference_type n) const { return (*columns_)[row_ + n]; }
+
+            column_row_iterator& operator++() { ++row_; return *this; }
+            column_row_iterator operator++(int) { auto it = *this; ++row_; return it; }
+            column_row_iterator& operator--() { --row_; return *this; }
+            column_row_iterator operator--(int) { auto it = *this; --row_; return it; }
+            column_row_iterator& operator+=(difference_type n) { row_ += n; return *this; }
+            column_row_iterator& operator-=(difference_type n) { row_ -= n; return *this; }
+
+            friend column_row_iterator operator+(column_row_iterator it, difference_type n) { return it += n; }
+            friend column_row_iterator operator+(difference_type n, column_row_iterator it) { return it += n; }
+            friend column_row_iterator operator-(column_row_iterator it, difference_type n) { return it -= n; }
+            friend difference_type operator-(const column_row_iterator& lhs, const column_row_iterator& rhs)
+            {
+                return static_cast<difference_type>(lhs.row_) - static_cast<difference_type>(rhs.row_);
+            }
+            friend bool operator==(const column_row_iterator& lhs, const column_row_iterator& rhs) { return lhs.row_ == rhs.row_; }
+            friend auto operator<=>(const column_row_iterator& lhs, const column_row_iterator& rhs) { return lhs.row_ <=> rhs.row_; }
+
+        private:
+            _Columns* columns_{};
+            std::size_t row_{};
+        };
+    }
+
+    /********************************************//**
+     * @class Columns
+     *
+     * Column-oriented batch of rows of fixed-size basic D-Bus types (except
+     * bool), e.g. of high-rate telemetry samples. Values of each row field
+     * are kept contiguous in a column of their own, ready for vectorized
+     * processing. On D-Bus, the batch is passed as a struct of arrays, e.g.
+     * Columns<uint64_t, double, double> with signature (atadad), so each
+     * column is (de)serialized in a single step, unlike an array of structs
+     * a(tdd), whose fields are walked one by one.
+     *
+     * Rows can be appended, indexed and iterated as tuples of references to
+     * their values. Deserialization reuses memory of the columns, and fails
+     * if the columns in the message differ in length.
+     *
+     ***********************************************/
+    template <typename... _ValueTypes>
+    class Columns
+    {
+        static_assert( sizeof...(_ValueTypes) > 0 && (detail::is_column_value_v<_ValueTypes> && ...)
+                     , "Columns are only supported for fixed-size basic D-Bus types except bool" );
+
+    public:
+        using row_type = std::tuple<_ValueTypes...>;
+        using reference = std::tuple<_ValueTypes&...>;
+        using const_reference = std::tuple<const _ValueTypes&...>;
+        using iterator = detail::column_row_iterator<Columns, reference>;
+        using const_iterator = detail::column_row_iterator<const Columns, const_reference>;
+
+        Columns() = default;
+
+        /// Takes over the given columns, which shall be of the same length
+        explicit Columns(std::vector<_ValueTypes>... columns)
+            : columns_(std::move(columns)...)
+        {
+            SDBUS_THROW_ERROR_IF( !std::apply([](const auto&... cols){ return detail::have_equal_lengths(cols...); }, columns_)
+                                , "Failed to create columns: columns differ in length"
+                                , EINVAL );
+        }
+
+        void push_back(const _ValueTypes&... values)
+        {
+            std::apply([&](auto&... columns){ (columns.push_back(values), ...); }, columns_);
+        }
+
+        void push_back(const row_type& row)
+        {
+            std::apply([this](const auto&... values){ push_back(values...); }, row);
+        }
+
+        void reserve(std::size_t rows)
+        {
+            std::apply([rows](auto&... columns){ (columns.reserve(rows), ...); }, columns_);
+        }
+
+        /// Removes all rows, keeping memory of the columns for reuse
+        void clear()
+        {
+            std::apply([](auto&... columns){ (columns.clear(), ...); }, columns_);
+        }
+
+        [[nodiscard]] std::size_t size() const
+        {
+            return std::get<0>(columns_).size();
+        }
+
+        [[nodiscard]] bool empty() const
+        {
+            return size() == 0;
+        }
+
+        reference operator[](std::size_t row)
+        {
+            return std::apply([row](auto&... columns){ return reference{columns[row]...}; }, columns_);
+        }
+
+        const_reference operator[](std::size_t row) const
+        {
+            return std::apply([row](const auto&... columns){ return const_reference{columns[row]...}; }, columns_);
+        }
+
+        iterator begin() { return {this, 0}; }
+        iterator end() { return {this, size()}; }
+        const_iterator begin() const { return {this, 0}; }
+        const_iterator end() const { return {this, size()}; }
+
+        /// Values of the field _I of all rows, contiguous in memory
+        template <std::size_t _I>
+        [[nodiscard]] std::span<std::tuple_element_t<_I, row_type>> column()
+        {
+            return std::get<_I>(columns_);
+        }
+
+        template <std::size_t _I>
+        [[nodiscard]] std::span<const std::tuple_element_t<_I, row_type>> column() const
+        {
+            return std::get<_I>(columns_);
+        }
+
+    private:
+        friend Message;
+
+        std::tuple<std::vector<_ValueTypes>...> columns_;
+    };
+
+    /********************************************//**
+     * @class ColumnsView
+     *
+     * Read-only counterpart of Columns, viewing columns kept elsewhere. Upon
+     * deserialization, the columns point straight into the message, which
+     * must outlive the view, sparing any copies. On serialization, columns
+     * kept in other containers are sent without copying them into Columns
+     * first.
+     *
+     ***********************************************/
+    template <typename... _ValueTypes>
+    class ColumnsView
+    {
+        static_assert( sizeof...(_ValueTypes) > 0 && (detail::is_column_value_v<_ValueTypes> && ...)
+                     , "Columns are only supported for fixed-size basic D-Bus types except bool" );
+
+    public:
+        using row_type = std::tuple<_ValueTypes...>;
+        using reference = std::tuple<const _ValueTypes&...>;
+        using const_reference = reference;
+        using iterator = detail::column_row_iterator<const ColumnsView, const_reference>;
+        using const_iterator = iterator;
+
+        ColumnsView() = default;
+
+        /// Views the given columns, which shall be of the same length
+        explicit ColumnsView(std::span<const _ValueTypes>... columns)
+            : columns_(columns...)
+        {
+            SDBUS_THROW_ERROR_IF( !detail::have_equal_lengths(columns...)
+                                , "Failed to create columns view: columns differ in length"
+                                , EINVAL );
+        }
+
+        ColumnsView(const Columns<_ValueTypes...>& columns)
+            : ColumnsView(columns, std::index_sequence_for<_ValueTypes...>{})
+        {
+        }
+
+        [[nodiscard]] std::size_t size() const
+        {
+            return std::get<0>(columns_).size();
+        }
+
+        [[nodiscard]] bool empty() const
+        {
+            return size() == 0;
+        }
+
+        const_reference operator[](std::size_t row) const
+        {
+            return std::apply([row](const auto&... columns){ return const_reference{columns[row]...}; }, columns_);
+        }
+
+        const_iterator begin() const { return {this, 0}; }
+        const_iterator end() const { return {this, size()}; }
+
+        template <std::size_t _I>
+        [[nodiscard]] std::span<const std::tuple_element_t<_I, row_type>> column() const
+        {
+            return std::get<_I>(columns_);
+        }
+
+    private:
+        template <std::size_t... _Is>
+        ColumnsView(const Columns<_ValueTypes...>& columns, std::index_sequence<_Is...>)
+            : columns_(columns.template column<_Is>()...)
+        {
+        }
+
+        friend Message;
+
+        std::tuple<std::span<const _ValueTypes>...> columns_;
+    };
+
     /********************************************//**
      * @typedef DictEntry
      *
@@ -401,6 +1161,101 @@ namespace sdbus {
     template<typename _T1, typename _T2>
     using DictEntry = std::pair<_T1, _T2>;
 
+    namespace detail
+    {
+        // Members of type Variant or std::variant are the value of the dictionary entry themselves
+        template <typename _Value>
+        constexpr bool is_variant_v = std::is_same_v<_Value, Variant>;
+
+        template <typename... _Elements>
+        constexpr bool is_variant_v<std::variant<_Elements...>> = true;
+
+        template <typename _Value>
+        constexpr bool is_struct_as_dictionary_v = false;
+
+        template <typename _Struct>
+        constexpr bool is_struct_as_dictionary_v<as_dictionary<_Struct>> = true;
+
+        // Writes the struct member as an a{sv} dictionary entry in place, sparing an intermediate Variant
+        template <typename _Value>
+        void serialize_struct_member_as_dict_entry(Message& msg, const char* name, const _Value& value)
+        {
+            msg.openDictEntry<std::string, Variant>();
+            msg << name;
+            if constexpr (is_struct_as_dictionary_v<_Value>)
+            {
+                msg.openVariant<std::map<std::string, Variant>>();
+                msg << value;
+                msg.closeVariant();
+            }
+            else if constexpr (is_variant_v<_Value>)
+            {
+                msg << value;
+            }
+            else
+            {
+                msg.openVariant<_Value>();
+                msg << value;
+                msg.closeVariant();
+            }
+            msg.closeDictEntry();
+        }
+
+        // Reads the value of an a{sv} dictionary entry into the struct member in place, sparing an intermediate Variant
+        template <typename _Value>
+        void deserialize_struct_member_from_dict_entry(Message& msg, _Value& value)
+        {
+            if constexpr (is_variant_v<_Value>)
+            {
+                msg >> value;
+            }
+            else if constexpr (signature_of_v<_Value>.front() == '(')
+            {
+                // A struct may come as a D-Bus struct or as a dictionary, and its deserialization tells the two apart
+                msg.enterVariant(msg.peekType().second);
+                msg >> value;
+                msg.exitVariant();
+            }
+            else
+            {
+                msg.enterVariant<_Value>();
+                msg >> value;
+                msg.exitVariant();
+            }
+        }
+
+        template <typename _Struct, typename _MemberDeserializer>
+        Message& deserialize_struct_from_dictionary( Message& msg
+                                                   , const char* structName
+                                                   , const _MemberDeserializer& deserializeMember
+                                                   , bool strict = strict_dict_as_struct_deserialization_v<_Struct> )
+        {
+            if (!msg.enterContainer<DictEntry<std::string, Variant>>())
+                return msg;
+
+            while (msg.enterDictEntry<std::string, Variant>())
+            {
+                char* key{};
+                msg >> key;
+                if (!deserializeMember(std::string_view{key}))
+                {
+                    using namespace std::string_literals;
+                    SDBUS_THROW_ERROR_IF( strict
+                                        , ((("Failed to deserialize struct from a dictionary: could not find field '"s += key) += "' in struct '") += structName) += "'"
+                                        , EINVAL );
+                    Variant unknownValue; // Consumes the value of the unknown field
+                    msg >> unknownValue;
+                }
+                msg.exitDictEntry();
+            }
+            msg.clearFlags();
+
+            msg.exitContainer();
+
+            return msg;
+        }
+    }
+
 }
 
 // Making sdbus::Struct implement the tuple-protocol, i.e. be a tuple-like type
@@ -460,6 +1315,15 @@ struct std::tuple_size<sdbus::Struct<_ValueTypes...>>
             : signature_of<sdbus::Struct<SDBUSCPP_STRUCT_MEMBER_TYPES(STRUCT, __VA_ARGS__)>>                                                            \
         {};                                                                                                                                             \
                                                                                                                                                         \
+        template <>                                                                                                                                     \
+        struct struct_members<STRUCT>                                                                                                                   \
+        {                                                                                                                                               \
+            static auto tie(STRUCT& s)                                                                                                                  \
+            {                                                                                                                                           \
+                return std::forward_as_tuple(SDBUSCPP_STRUCT_MEMBERS(s, __VA_ARGS__));                                                                  \
+            }                                                                                                                                           \
+        };                                                                                                                                              \
+                                                                                                                                                        \
         inline auto as_dictionary_if_struct(const STRUCT& object)                                                                                       \
         {                                                                                                                                               \
             return as_dictionary<STRUCT>(object);                                                                                                       \
@@ -472,10 +1336,18 @@ struct std::tuple_size<sdbus::Struct<_ValueTypes...>>
                                                                                                                                                         \
         inline Message& operator<<(Message& msg, const as_dictionary<STRUCT>& s)                                                                        \
         {                                                                                                                                               \
-            if constexpr (!nested_struct_as_dict_serialization_v<STRUCT>)                                                                               \
-                return msg.serializeDictionary<std::string, Variant>({SDBUSCPP_STRUCT_MEMBERS_AS_DICT_ENTRIES(s.m_struct, __VA_ARGS__)});               \
-            else                                                                                                                                        \
-                return msg.serializeDictionary<std::string, Variant>({SDBUSCPP_STRUCT_MEMBERS_AS_NESTED_DICT_ENTRIES(s.m_struct, __VA_ARGS__)});        \
+            constexpr bool nested = nested_struct_as_dict_serialization_v<STRUCT>;                                                                      \
+            msg.openContainer<DictEntry<std::string, Variant>>();                                                                                       \
+            SDBUSCPP_SERIALIZE_STRUCT_MEMBERS_AS_DICT_ENTRIES(s.m_struct, __VA_ARGS__)                                                                  \
+            return msg.closeContainer();                                                                                                                \
+        }                                                                                                                                               \
+                                                                                                                                                        \
+        inline bool find_and_deserialize_struct_member(Message& msg, STRUCT& s, std::string_view key)                                                   \
+        {                                                                                                                                               \
+            /* This also handles members which are structs serialized as dict of strings to variants, recursively */                                    \
+            SDBUSCPP_FIND_AND_DESERIALIZE_STRUCT_MEMBERS(s, __VA_ARGS__)                                                                                \
+                return false;                                                                                                                           \
+            return true;                                                                                                                                \
         }                                                                                                                                               \
                                                                                                                                                         \
         inline Message& operator>>(Message& msg, STRUCT& s)                                                                                             \
@@ -489,18 +1361,18 @@ struct std::tuple_size<sdbus::Struct<_ValueTypes...>>
                                                                                                                                                         \
             /* Otherwise try to deserialize as a dictionary of strings to variants */                                                                   \
                                                                                                                                                         \
-            return msg.deserializeDictionary<std::string, Variant>([&s](const auto& dictEntry)                                                          \
+            return detail::deserialize_struct_from_dictionary<STRUCT>(msg, #STRUCT, [&msg, &s](std::string_view key)                                    \
             {                                                                                                                                           \
-                const std::string& key = dictEntry.first; /* Intentionally not using structured bindings */                                             \
-                const Variant& value = dictEntry.second;                                                                                                \
-                                                                                                                                                        \
-                using namespace std::string_literals;                                                                                                   \
-                /* This also handles members which are structs serialized as dict of strings to variants, recursively */                                \
-                SDBUSCPP_FIND_AND_DESERIALIZE_STRUCT_MEMBERS(s, __VA_ARGS__)                                                                            \
-                SDBUS_THROW_ERROR_IF( strict_dict_as_struct_deserialization_v<STRUCT>                                                                   \
-                                    , ("Failed to deserialize struct from a dictionary: could not find field '"s += key) += "' in struct 'my::Struct'"  \
-                                    , EINVAL );                                                                                                         \
+                return find_and_deserialize_struct_member(msg, s, key);                                                                                 \
             });                                                                                                                                         \
+        }                                                                                                                                               \
+                                                                                                                                                        \
+        inline Message& operator>>(Message& msg, from_relaxed_dictionary<STRUCT>& s)                                                                    \
+        {                                                                                                                                               \
+            return detail::deserialize_struct_from_dictionary<STRUCT>(msg, #STRUCT, [&msg, &s](std::string_view key)                                    \
+            {                                                                                                                                           \
+                return find_and_deserialize_struct_member(msg, s.m_struct, key);                                                                        \
+            }, false);                                                                                                                                  \
         }                                                                                                                                               \
     }                                                                                                                                                   \
     /**/
@@ -554,20 +1426,20 @@ struct std::tuple_size<sdbus::Struct<_ValueTypes...>>
     /**/
 #define SDBUSCPP_STRUCT_MEMBER_TYPE(STRUCT, MEMBER) decltype(STRUCT::MEMBER)
 
-#define SDBUSCPP_STRUCT_MEMBERS_AS_DICT_ENTRIES(STRUCT, ...)                                                                                                    \
-    SDBUSCPP_PP_CAT(SDBUSCPP_FOR_EACH_, SDBUSCPP_PP_NARG(__VA_ARGS__))(SDBUSCPP_STRUCT_MEMBER_AS_DICT_ENTRY, SDBUSCPP_PP_COMMA, STRUCT, __VA_ARGS__)            \
+#define SDBUSCPP_SERIALIZE_STRUCT_MEMBERS_AS_DICT_ENTRIES(STRUCT, ...)                                                                                          \
+    SDBUSCPP_PP_CAT(SDBUSCPP_FOR_EACH_, SDBUSCPP_PP_NARG(__VA_ARGS__))(SDBUSCPP_SERIALIZE_STRUCT_MEMBER_AS_DICT_ENTRY, SDBUSCPP_PP_SPACE, STRUCT, __VA_ARGS__)  \
     /**/
-#define SDBUSCPP_STRUCT_MEMBER_AS_DICT_ENTRY(STRUCT, MEMBER) {#MEMBER, Variant{STRUCT.MEMBER}}
-
-#define SDBUSCPP_STRUCT_MEMBERS_AS_NESTED_DICT_ENTRIES(STRUCT, ...)                                                                                             \
-    SDBUSCPP_PP_CAT(SDBUSCPP_FOR_EACH_, SDBUSCPP_PP_NARG(__VA_ARGS__))(SDBUSCPP_STRUCT_MEMBER_AS_NESTED_DICT_ENTRY, SDBUSCPP_PP_COMMA, STRUCT, __VA_ARGS__)     \
+#define SDBUSCPP_SERIALIZE_STRUCT_MEMBER_AS_DICT_ENTRY(STRUCT, MEMBER)                                                                                          \
+    if constexpr (nested)                                                                                                                                       \
+        detail::serialize_struct_member_as_dict_entry(msg, #MEMBER, as_dictionary_if_struct(STRUCT.MEMBER));                                                    \
+    else                                                                                                                                                        \
+        detail::serialize_struct_member_as_dict_entry(msg, #MEMBER, STRUCT.MEMBER);                                                                             \
     /**/
-#define SDBUSCPP_STRUCT_MEMBER_AS_NESTED_DICT_ENTRY(STRUCT, MEMBER) {#MEMBER, Variant{as_dictionary_if_struct(STRUCT.MEMBER)}}
 
 #define SDBUSCPP_FIND_AND_DESERIALIZE_STRUCT_MEMBERS(STRUCT, ...)                                                                                               \
     SDBUSCPP_PP_CAT(SDBUSCPP_FOR_EACH_, SDBUSCPP_PP_NARG(__VA_ARGS__))(SDBUSCPP_FIND_AND_DESERIALIZE_STRUCT_MEMBER, SDBUSCPP_PP_SPACE, STRUCT, __VA_ARGS__)     \
     /**/
-#define SDBUSCPP_FIND_AND_DESERIALIZE_STRUCT_MEMBER(STRUCT, MEMBER) if (key == #MEMBER) STRUCT.MEMBER = value.get<decltype(STRUCT.MEMBER)>(); else
+#define SDBUSCPP_FIND_AND_DESERIALIZE_STRUCT_MEMBER(STRUCT, MEMBER) if (key == #MEMBER) detail::deserialize_struct_member_from_dict_entry(msg, STRUCT.MEMBER); else
 
 #define SDBUSCPP_FOR_EACH_1(M, D, S, M1) M(S, M1)
 #define SDBUSCPP_FOR_EACH_2(M, D, S, M1, M2) M(S, M1) D M(S, M2)
@@ -0,0 +1,260 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file UvEventLoopAdapter.h
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_UVEVENTLOOPADAPTER_H_
+#define SDBUS_CXX_UVEVENTLOOPADAPTER_H_
+
+#include <sdbus-c++/Error.h>
+#include <sdbus-c++/IConnection.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <poll.h>
+#include <uv.h>
+
+namespace sdbus {
+
+    /********************************************//**
+     * @class UvEventLoopAdapter
+     *
+     * Drives a bus connection from a libuv loop, without any extra thread.
+     * The bus fd and the event fd of the connection are watched through
+     * uv_poll_t handles, and the connection timeout through a uv_timer_t handle.
+     * Pending events are processed in bounded batches, so that a busy connection
+     * doesn't starve other handles of the loop.
+     *
+     * The connection must not run its own internal event loop, nor be attached
+     * to another event loop, while it is driven by the adapter. The adapter must
+     * be destroyed before the connection; it may be destroyed from within
+     * a callback handler of the connection. Its handles are closed then, and
+     * freed once the loop has run their close callbacks.
+     *
+     * The adapter is header-only, so this header is not part of sdbus-c++.h and
+     * requires libuv only when included. The adapter shall be created, used and
+     * destroyed in the thread running the loop. Exceptions must not propagate
+     * through libuv, so an error in processing the connection stops the adapter
+     * from driving the connection, and is reported to the error handler instead.
+     *
+     ***********************************************/
+    class UvEventLoopAdapter
+    {
+    public:
+        static constexpr std::size_t DEFAULT_MAX_EVENTS_PER_BATCH{64};
+        static constexpr std::chrono::microseconds DEFAULT_MAX_BATCH_DURATION{10'000};
+
+        /*!
+         * @brief Starts driving the bus connection from the libuv loop
+         *
+         * @param[in] loop libuv loop that drives the connection
+         * @param[in] connection Bus connection to be driven, which must outlive the adapter
+         * @param[in] maxEventsPerBatch Maximum number of events processed before other handles get their turn
+         * @param[in] maxBatchDuration Maximum time spent processing events before other handles get their turn
+         *
+         * @throws sdbus::Error in case of failure
+         */
+        UvEventLoopAdapter( uv_loop_t* loop
+                          , IConnection& connection
+                          , std::size_t maxEventsPerBatch = DEFAULT_MAX_EVENTS_PER_BATCH
+                          , std::chrono::microseconds maxBatchDuration = DEFAULT_MAX_BATCH_DURATION )
+            : state_(new State{connection, maxEventsPerBatch, maxBatchDuration})
+        {
+            try
+            {
+                state_->init(loop);
+                state_->arm();
+            }
+            catch (const Error&)
+            {
+                state_->stop();
+                throw;
+            }
+        }
+
+        UvEventLoopAdapter(const UvEventLoopAdapter&) = delete;
+        UvEventLoopAdapter& operator=(const UvEventLoopAdapter&) = delete;
+
+        ~UvEventLoopAdapter()
+        {
+            state_->stop();
+        }
+
+        /*!
+         * @brief Sets the handler of errors in processing the connection
+         *
+         * @param[in] errorHandler Handler invoked in the loop thread with the error, after which the adapter
+         *                         doesn't drive the connection anymore. The handler may destroy the adapter.
+         */
+        void setErrorHandler(std::function<void(const Error&)> errorHandler)
+        {
+            state_->errorHandler = std::move(errorHandler);
+        }
+
+    private:
+        // Handles are closed asynchronously by libuv, so the state deletes itself after the last close callback
+        struct State
+        {
+            void init(uv_loop_t* loop)
+            {
+                const auto pollData = connection.getEventLoopPollData();
+
+                auto r = uv_poll_init(loop, &busPoll, pollData.fd);
+                SDBUS_THROW_ERROR_IF(r < 0, "Failed to initialize libuv poll handle for bus fd", -r);
+                busPoll.data = this;
+                ++openHandles;
+
+                r = uv_poll_init(loop, &eventPoll, pollData.eventFd);
+                SDBUS_THROW_ERROR_IF(r < 0, "Failed to initialize libuv poll handle for event fd", -r);
+                eventPoll.data = this;
+                ++openHandles;
+
+                r = uv_timer_init(loop, &timer);
+                SDBUS_THROW_ERROR_IF(r < 0, "Failed to initialize libuv timer handle", -r);
+                timer.data = this;
+                ++openHandles;
+            }
+
+            void arm()
+            {
+                const auto pollData = connection.getEventLoopPollData();
+
+                int events{};
+                if (pollData.events & POLLIN)
+                    events |= UV_READABLE;
+                if (pollData.events & POLLOUT)
+                    events |= UV_WRITABLE;
+
+                // Restarting a poll handle just updates the events it watches for
+                auto r = uv_poll_start(&busPoll, events, &State::onPollEvent);
+                SDBUS_THROW_ERROR_IF(r < 0, "Failed to start polling bus fd", -r);
+                r = uv_poll_start(&eventPoll, UV_READABLE, &State::onPollEvent);
+                SDBUS_THROW_ERROR_IF(r < 0, "Failed to start polling event fd", -r);
+
+                // Timeout is zero if there are events left pending, e.g. by an exhausted batch
+                (void)uv_timer_stop(&timer);
+                const auto timeout = pollData.getPollTimeout();
+                if (timeout >= 0)
+                {
+                    r = uv_timer_start(&timer, &State::onTimeout, static_cast<std::uint64_t>(timeout), 0);
+                    SDBUS_THROW_ERROR_IF(r < 0, "Failed to start libuv timer", -r);
+                }
+            }
+
+            void process()
+            {
+                if (stopped)
+                    return;
+
+                // Closing of the handles is deferred to the loop, so the state survives its adapter being destroyed here
+                try
+                {
+                    connection.processPendingEvents(maxEventsPerBatch, maxBatchDuration);
+
+                    if (!stopped)
+                        arm();
+                }
+                catch (const Error& e)
+                {
+                    fail(e);
+                }
+                catch (const std::exception& e)
+                {
+                    fail(Error{SDBUSCPP_ERROR_NAME, e.what()});
+                }
+            }
+
+            void fail(const Error& error)
+            {
+                // Nobody to report to if the adapter has been destroyed meanwhile
+                if (stopped)
+                    return;
+
+                (void)uv_poll_stop(&busPoll);
+                (void)uv_poll_stop(&eventPoll);
+                (void)uv_timer_stop(&timer);
+
+                // The handler may destroy the adapter, which closes the handles, but the state lives until they are closed
+                if (auto handler = errorHandler)
+                    handler(error);
+            }
+
+            void stop()
+            {
+                if (stopped)
+                    return;
+                stopped = true;
+
+                // The handles are initialized in this order, and the descriptors stay open, as libuv doesn't own them
+                const auto handlesToClose = openHandles;
+                if (handlesToClose == 0)
+                {
+                    delete this;
+                    return;
+                }
+                uv_close(reinterpret_cast<uv_handle_t*>(&busPoll), &State::onClosed);
+                if (handlesToClose > 1)
+                    uv_close(reinterpret_cast<uv_handle_t*>(&eventPoll), &State::onClosed);
+                if (handlesToClose > 2)
+                    uv_close(reinterpret_cast<uv_handle_t*>(&timer), &State::onClosed);
+            }
+
+            static void onPollEvent(uv_poll_t* handle, int /*status*/, int /*events*/)
+            {
+                // Errors of polling are left to the connection to detect and report when processing
+                static_cast<State*>(handle->data)->process();
+            }
+
+            static void onTimeout(uv_timer_t* handle)
+            {
+                static_cast<State*>(handle->data)->process();
+            }
+
+            static void onClosed(uv_handle_t* handle)
+            {
+                auto* state = static_cast<State*>(handle->data);
+                if (--state->openHandles == 0)
+                    delete state;
+            }
+
+            IConnection& connection;
+            std::size_t maxEventsPerBatch;
+            std::chrono::microseconds maxBatchDuration;
+            std::function<void(const Error&)> errorHandler{};
+            uv_poll_t busPoll{};
+            uv_poll_t eventPoll{};
+            uv_timer_t timer{};
+            std::size_t openHandles{};
+            bool stopped{};
+        };
+
+        State* state_;
+    };
+
+}
+
+#endif /* SDBUS_CXX_UVEVENTLOOPADAPTER_H_ */
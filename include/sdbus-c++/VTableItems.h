@@ -30,15 +30,24 @@
 #include <sdbus-c++/Types.h>
 #include <sdbus-c++/TypeTraits.h>
 
+#include <chrono>
+#include <memory>
 #include <string>
 #include <variant>
 #include <vector>
 
+// Forward declarations
+namespace sdbus::internal {
+    class Object;
+}
+
 namespace sdbus {
 
     struct MethodVTableItem
     {
         template <typename _Function> MethodVTableItem& implementedAs(_Function&& callback);
+        // Sets the signatures implementedAs() would deduce from a callback of the given type, e.g. in StaticVTable layouts
+        template <typename _Function> MethodVTableItem& withSignatureOf();
         MethodVTableItem& withInputParamNames(std::vector<std::string> names);
         template <typename... _String> MethodVTableItem& withInputParamNames(_String... names);
         MethodVTableItem& withOutputParamNames(std::vector<std::string> names);
@@ -46,6 +55,7 @@ namespace sdbus {
         MethodVTableItem& markAsDeprecated();
         MethodVTableItem& markAsPrivileged();
         MethodVTableItem& withNoReply();
+        MethodVTableItem& withHighPriority();
 
         MethodName name;
         Signature inputSignature;
@@ -79,15 +89,21 @@ namespace sdbus {
     {
         template <typename _Function> PropertyVTableItem& withGetter(_Function&& callback);
         template <typename _Function> PropertyVTableItem& withSetter(_Function&& callback);
+        // Set the signature and writability a getter and a setter would imply, e.g. in StaticVTable layouts
+        template <typename _Value> PropertyVTableItem& withValueType();
+        PropertyVTableItem& markAsWritable();
         PropertyVTableItem& markAsDeprecated();
         PropertyVTableItem& markAsPrivileged();
         PropertyVTableItem& withUpdateBehavior(Flags::PropertyUpdateBehaviorFlags behavior);
+        PropertyVTableItem& withValueCaching(std::chrono::microseconds timeToLive);
 
         PropertyName name;
         Signature signature;
         property_get_callback getter;
         property_set_callback setter;
         Flags flags;
+        std::chrono::microseconds valueCacheTimeToLive{}; // Zero means the getter is invoked on every read
+        bool writable{}; // Implied by a setter
     };
 
     PropertyVTableItem registerProperty(PropertyName propertyName);
@@ -98,6 +114,7 @@ namespace sdbus {
         InterfaceFlagsVTableItem& markAsDeprecated();
         InterfaceFlagsVTableItem& markAsPrivileged();
         InterfaceFlagsVTableItem& withNoReplyMethods();
+        InterfaceFlagsVTableItem& withHighPriorityMethods();
         InterfaceFlagsVTableItem& withPropertyUpdateBehavior(Flags::PropertyUpdateBehaviorFlags behavior);
 
         Flags flags;
@@ -107,6 +124,51 @@ namespace sdbus {
 
     using VTableItem = std::variant<MethodVTableItem, SignalVTableItem, PropertyVTableItem, InterfaceFlagsVTableItem>;
 
+    /********************************************//**
+     * @class StaticVTable
+     *
+     * Layout of a vtable -- interface name, names, signatures and flags of its
+     * members -- prepared once and shared by all objects registering it, typically
+     * as a static object of a generated adaptor class. Objects register the layout
+     * with just their handlers (see IObject::addVTable(const StaticVTable&, std::vector<VTableHandler>)),
+     * so the vtable structure for sd-bus isn't assembled anew for each object.
+     *
+     * The layout is given by regular vtable items, whose callbacks, if any, are ignored.
+     * Signatures of methods and properties without callbacks are set by withSignatureOf()
+     * and withValueType(), and properties with setters are marked by markAsWritable().
+     *
+     ***********************************************/
+    class StaticVTable
+    {
+    public:
+        /*!
+         * @brief Prepares the vtable layout for the given interface
+         *
+         * @throws sdbus::Error in case of an invalid interface name or vtable item
+         */
+        StaticVTable(InterfaceName interfaceName, std::vector<VTableItem> layout);
+
+        [[nodiscard]] const InterfaceName& getInterfaceName() const;
+
+    private:
+        friend internal::Object;
+
+        InterfaceName interfaceName_;
+        std::shared_ptr<const void> layout_; // Internal representation, shared with objects registering the vtable
+    };
+
+    // Handlers of a method or a property of an object registering a StaticVTable
+    struct VTableHandler
+    {
+        method_callback method;
+        property_get_callback getter;
+        property_set_callback setter;
+    };
+
+    template <typename _Function> VTableHandler implementMethod(_Function&& callback);
+    template <typename _Getter> VTableHandler implementProperty(_Getter&& getter);
+    template <typename _Getter, typename _Setter> VTableHandler implementProperty(_Getter&& getter, _Setter&& setter);
+
 } // namespace sdbus
 
 #endif /* SDBUS_CXX_VTABLEITEMS_H_ */
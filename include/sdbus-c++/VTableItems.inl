@@ -30,6 +30,7 @@
 #include <sdbus-c++/TypeTraits.h>
 
 #include <string>
+#include <tuple>
 #include <type_traits>
 #include <vector>
 
@@ -39,37 +40,107 @@ namespace sdbus {
     /***  Method VTable Item  ***/
     /*** -------------------- ***/
 
+    namespace detail {
+        template <typename _Function>
+        method_callback make_method_callback(_Function&& callback)
+        {
+            return [callback = std::forward<_Function>(callback)](MethodCall call)
+            {
+                // Create a tuple of callback input arguments' types, which will be used
+                // as a storage for the argument values deserialized from the message.
+                tuple_of_function_input_arg_types_t<_Function> inputArgs;
+
+                // Deserialize input arguments from the message into the tuple.
+                call >> inputArgs;
+
+                if constexpr (is_coroutine_method_v<_Function>)
+                {
+                    static_assert( !function_traits<_Function>::has_reference_params
+                                 , "Coroutine method handlers must take their parameters by value" );
+
+                    // Create the coroutine with input arguments from the tuple, and start it. It will send
+                    // the reply (or an error reply) itself, once it completes.
+                    auto task = sdbus::apply(callback, std::move(inputArgs));
+                    std::move(task).start(std::move(call));
+                }
+                else if constexpr (returns_expected_v<_Function>)
+                {
+                    // Invoke callback with input arguments moved from the tuple. An error it returns
+                    // is sent back as an error reply, without the cost of throwing it.
+                    auto ret = std::apply(callback, detail::forward_args_for<decltype((callback))>(inputArgs));
+                    if (!ret)
+                    {
+                        call.createErrorReply(ret.error()).send();
+                        return;
+                    }
+
+                    auto reply = call.createReply();
+                    if constexpr (!std::is_void_v<typename decltype(ret)::value_type>)
+                        reply << *std::move(ret);
+                    reply.send();
+                }
+                else if constexpr (!is_async_method_v<_Function>)
+                {
+                    // Invoke callback with input arguments moved from the tuple, so that by-value parameters don't copy them.
+                    auto ret = sdbus::apply_moving(callback, inputArgs);
+
+                    // Store output arguments to the reply message and send it back.
+                    auto reply = call.createReply();
+                    reply << ret;
+                    reply.send();
+                }
+                else
+                {
+                    // Invoke callback with input arguments from the tuple and with result object to be set later
+                    using AsyncResult = typename function_traits<_Function>::async_result_t;
+                    sdbus::apply(callback, AsyncResult{std::move(call)}, std::move(inputArgs));
+                }
+            };
+        }
+
+        template <typename _Function>
+        property_get_callback make_property_get_callback(_Function&& callback)
+        {
+            return [callback = std::forward<_Function>(callback)](PropertyGetReply& reply)
+            {
+                // Get the propety value and serialize it into the pre-constructed reply message
+                reply << callback();
+            };
+        }
+
+        template <typename _Function>
+        property_set_callback make_property_set_callback(_Function&& callback)
+        {
+            return [callback = std::forward<_Function>(callback)](PropertySetCall call)
+            {
+                // Default-construct property value
+                using property_type = function_argument_t<_Function, 0>;
+                std::decay_t<property_type> property;
+
+                // Deserialize property value from the incoming call message
+                call >> property;
+
+                // Invoke setter with the value
+                callback(property);
+            };
+        }
+    }
+
     template <typename _Function>
     MethodVTableItem& MethodVTableItem::implementedAs(_Function&& callback)
     {
         inputSignature = signature_of_function_input_arguments_v<_Function>;
         outputSignature = signature_of_function_output_arguments_v<_Function>;
-        callbackHandler = [callback = std::forward<_Function>(callback)](MethodCall call)
-        {
-            // Create a tuple of callback input arguments' types, which will be used
-            // as a storage for the argument values deserialized from the message.
-            tuple_of_function_input_arg_types_t<_Function> inputArgs;
+        callbackHandler = detail::make_method_callback(std::forward<_Function>(callback));
 
-            // Deserialize input arguments from the message into the tuple.
-            call >> inputArgs;
+        return *this;
+    }
 
-            if constexpr (!is_async_method_v<_Function>)
-            {
-                // Invoke callback with input arguments from the tuple.
-                auto ret = sdbus::apply(callback, inputArgs);
-
-                // Store output arguments to the reply message and send it back.
-                auto reply = call.createReply();
-                reply << ret;
-                reply.send();
-            }
-            else
-            {
-                // Invoke callback with input arguments from the tuple and with result object to be set later
-                using AsyncResult = typename function_traits<_Function>::async_result_t;
-                sdbus::apply(callback, AsyncResult{std::move(call)}, std::move(inputArgs));
-            }
-        };
+    template <typename _Function>
+    MethodVTableItem& MethodVTableItem::withSignatureOf()
+    {
+        inputSignature = signature_of_function_input_arguments_v<_Function>;
+        outputSignature = signature_of_function_output_arguments_v<_Function>;
 
         return *this;
     }
@@ -125,6 +196,13 @@ namespace sdbus {
         return *this;
     }
 
+    inline MethodVTableItem& MethodVTableItem::withHighPriority()
+    {
+        flags.set(Flags::HIGH_PRIORITY);
+
+        return *this;
+    }
+
     inline MethodVTableItem registerMethod(MethodName methodName)
     {
         return {std::move(methodName), {}, {}, {}, {}, {}, {}};
@@ -194,11 +272,7 @@ namespace sdbus {
         if (signature.empty())
             signature = signature_of_function_output_arguments_v<_Function>;
 
-        getter = [callback = std::forward<_Function>(callback)](PropertyGetReply& reply)
-        {
-            // Get the propety value and serialize it into the pre-constructed reply message
-            reply << callback();
-        };
+        getter = detail::make_property_get_callback(std::forward<_Function>(callback));
 
         return *this;
     }
@@ -212,18 +286,22 @@ namespace sdbus {
         if (signature.empty())
             signature = signature_of_function_input_arguments_v<_Function>;
 
-        setter = [callback = std::forward<_Function>(callback)](PropertySetCall call)
-        {
-            // Default-construct property value
-            using property_type = function_argument_t<_Function, 0>;
-            std::decay_t<property_type> property;
+        setter = detail::make_property_set_callback(std::forward<_Function>(callback));
 
-            // Deserialize property value from the incoming call message
-            call >> property;
+        return *this;
+    }
 
-            // Invoke setter with the value
-            callback(property);
-        };
+    template <typename _Value>
+    inline PropertyVTableItem& PropertyVTableItem::withValueType()
+    {
+        signature = signature_of_function_output_arguments_v<_Value()>;
+
+        return *this;
+    }
+
+    inline PropertyVTableItem& PropertyVTableItem::markAsWritable()
+    {
+        writable = true;
 
         return *this;
     }
@@ -249,9 +327,16 @@ namespace sdbus {
         return *this;
     }
 
+    inline PropertyVTableItem& PropertyVTableItem::withValueCaching(std::chrono::microseconds timeToLive)
+    {
+        valueCacheTimeToLive = timeToLive;
+
+        return *this;
+    }
+
     inline PropertyVTableItem registerProperty(PropertyName propertyName)
     {
-        return {std::move(propertyName), {}, {}, {}, {}};
+        return {std::move(propertyName), {}, {}, {}, {}, {}, {}};
     }
 
     inline PropertyVTableItem registerProperty(std::string propertyName)
@@ -259,6 +344,37 @@ namespace sdbus {
         return registerProperty(PropertyName{std::move(propertyName)});
     }
 
+    /*** -------------------- ***/
+    /***    VTable Handler    ***/
+    /*** -------------------- ***/
+
+    template <typename _Function>
+    inline VTableHandler implementMethod(_Function&& callback)
+    {
+        return {detail::make_method_callback(std::forward<_Function>(callback)), {}, {}};
+    }
+
+    template <typename _Getter>
+    inline VTableHandler implementProperty(_Getter&& getter)
+    {
+        static_assert(function_argument_count_v<_Getter> == 0, "Property getter function must not take any arguments");
+        static_assert(!std::is_void<function_result_t<_Getter>>::value, "Property getter function must return property value");
+
+        return {{}, detail::make_property_get_callback(std::forward<_Getter>(getter)), {}};
+    }
+
+    template <typename _Getter, typename _Setter>
+    inline VTableHandler implementProperty(_Getter&& getter, _Setter&& setter)
+    {
+        static_assert(function_argument_count_v<_Setter> == 1, "Property setter function must take one parameter - the property value");
+        static_assert(std::is_void<function_result_t<_Setter>>::value, "Property setter function must not return any value");
+
+        auto handler = implementProperty(std::forward<_Getter>(getter));
+        handler.setter = detail::make_property_set_callback(std::forward<_Setter>(setter));
+
+        return handler;
+    }
+
     /*** --------------------------- ***/
     /*** Interface Flags VTable Item ***/
     /*** --------------------------- ***/
@@ -284,6 +400,13 @@ namespace sdbus {
         return *this;
     }
 
+    inline InterfaceFlagsVTableItem& InterfaceFlagsVTableItem::withHighPriorityMethods()
+    {
+        flags.set(Flags::HIGH_PRIORITY);
+
+        return *this;
+    }
+
     inline InterfaceFlagsVTableItem& InterfaceFlagsVTableItem::withPropertyUpdateBehavior(Flags::PropertyUpdateBehaviorFlags behavior)
     {
         flags.set(behavior);
@@ -24,14 +24,25 @@
  * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <sdbus-c++/CallBatch.h>
 #include <sdbus-c++/IConnection.h>
+#include <sdbus-c++/IConnectionPool.h>
+#include <sdbus-c++/InlineFunction.h>
+#include <sdbus-c++/IEventLoop.h>
+#include <sdbus-c++/IMessageBridge.h>
 #include <sdbus-c++/IObject.h>
+#include <sdbus-c++/IPeerServer.h>
 #include <sdbus-c++/IProxy.h>
+#include <sdbus-c++/ITracer.h>
 #include <sdbus-c++/AdaptorInterfaces.h>
 #include <sdbus-c++/ProxyInterfaces.h>
 #include <sdbus-c++/StandardInterfaces.h>
 #include <sdbus-c++/Message.h>
+#include <sdbus-c++/DynamicValue.h>
 #include <sdbus-c++/MethodResult.h>
+#include <sdbus-c++/SignalBroadcast.h>
+#include <sdbus-c++/SubtreeSignalSubscription.h>
+#include <sdbus-c++/TrafficCapture.h>
 #include <sdbus-c++/Types.h>
 #include <sdbus-c++/TypeTraits.h>
 #include <sdbus-c++/Error.h>
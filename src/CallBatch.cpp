@@ -0,0 +1,251 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file CallBatch.cpp
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sdbus-c++/CallBatch.h"
+
+#include "sdbus-c++/Error.h"
+#include "sdbus-c++/Message.h"
+
+#include "IConnection.h"
+#include "MessageUtils.h"
+#include "Utils.h"
+
+#include <cassert>
+#include <memory>
+#include <optional>
+#include SDBUS_HEADER
+#include <utility>
+
+namespace sdbus {
+
+namespace {
+
+    // Shared by the calls of a sent batch. Each call stores its outcome at its own index, and the last one completes the batch.
+    struct BatchState
+    {
+        struct Call
+        {
+            BatchState* batch;
+            std::size_t index;
+        };
+
+        BatchState(internal::IConnection* connection, std::size_t count, CallBatch::replies_handler callback)
+            : connection(connection)
+            , calls(count)
+            , replies(count)
+            , pending(count + 1)
+            , callback(std::move(callback))
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                calls[i] = Call{this, i};
+        }
+
+        void release(std::size_t count)
+        {
+            if (pending.fetch_sub(count, std::memory_order_acq_rel) == count)
+                complete();
+        }
+
+        void complete()
+        {
+            // A floating batch lives until the end of its completion
+            auto self = std::move(floatingSelf);
+
+            // All calls have completed, so their resources are released right away, including the call being dispatched now
+            {
+                auto completedSlots = std::move(slots);
+            }
+
+            CallBatch::Replies results;
+            results.reserve(replies.size());
+            for (auto& reply : replies)
+                results.push_back(*std::move(reply));
+
+            // The batch may be destroyed from within the callback (by destroying its slot), so it's not touched afterwards
+            auto handler = std::move(callback);
+            handler(std::move(results));
+        }
+
+        internal::IConnection* connection;
+        std::vector<Call> calls; // User data of the calls, stable for the lifetime of the batch
+        std::vector<std::optional<Expected<MethodReply>>> replies;
+        // The sending thread holds one extra count while making the calls, so the batch can't complete in the meantime
+        std::atomic<std::size_t> pending;
+        CallBatch::replies_handler callback;
+        std::vector<Slot> slots;
+        std::shared_ptr<BatchState> floatingSelf;
+    };
+
+    int sdbus_batch_reply_handler(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError)
+    {
+        auto* call = static_cast<BatchState::Call*>(userData);
+        assert(call != nullptr);
+        auto& batch = *call->batch;
+
+        const auto* error = sd_bus_message_get_error(sdbusMessage);
+        if (error != nullptr)
+            batch.replies[call->index].emplace(Error(Error::Name{error->name}, error->message));
+        else
+            batch.replies[call->index].emplace(Message::Factory::create<MethodReply>(sdbusMessage, batch.connection));
+
+        auto ok = internal::invokeHandlerAndCatchErrors([&](){ batch.release(1); }, retError);
+
+        return ok ? 0 : -1;
+    }
+
+    std::shared_ptr<BatchState> sendBatch( std::vector<MethodCall> calls
+                                         , std::vector<uint64_t> timeouts
+                                         , CallBatch::replies_handler callback
+                                         , bool floating )
+    {
+        const auto count = calls.size();
+        auto* connection = count > 0 ? Message::Factory::getConnection(calls.front()) : nullptr;
+        auto batch = std::make_shared<BatchState>(connection, count, std::move(callback));
+
+        int r{};
+        if (count > 0)
+        {
+            std::vector<sd_bus_message*> sdbusMsgs(count);
+            std::vector<void*> userData(count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                sdbusMsgs[i] = static_cast<sd_bus_message*>(Message::Factory::getSdBusMessage(calls[i]));
+                userData[i] = &batch->calls[i];
+            }
+
+            r = connection->callMethodsAsync( sdbusMsgs.data()
+                                            , timeouts.data()
+                                            , &sdbus_batch_reply_handler
+                                            , userData.data()
+                                            , count
+                                            , batch->slots );
+        }
+
+        // Calls that couldn't be made complete with the error right away
+        const auto made = batch->slots.size();
+        for (auto i = made; i < count; ++i)
+            batch->replies[i].emplace(createError(-r, "Failed to call method asynchronously"));
+
+        if (floating)
+            batch->floatingSelf = batch;
+
+        batch->release(count - made + 1);
+
+        return batch;
+    }
+
+}
+
+CallBatch& CallBatch::add(MethodCall call, uint64_t timeout)
+{
+    SDBUS_THROW_ERROR_IF(!call.isValid(), "Invalid method call message provided", EINVAL);
+    SDBUS_THROW_ERROR_IF(call.doesntExpectReply(), "Method calls of a batch must expect a reply", EINVAL);
+    SDBUS_THROW_ERROR_IF( !calls_.empty() && Message::Factory::getConnection(call) != Message::Factory::getConnection(calls_.front())
+                        , "Method calls of a batch must be made on one connection"
+                        , EINVAL );
+
+    calls_.push_back(std::move(call));
+    timeouts_.push_back(timeout);
+
+    return *this;
+}
+
+std::size_t CallBatch::size() const noexcept
+{
+    return calls_.size();
+}
+
+bool CallBatch::empty() const noexcept
+{
+    return calls_.empty();
+}
+
+void CallBatch::send(replies_handler callback)
+{
+    (void)sendBatch(std::exchange(calls_, {}), std::exchange(timeouts_, {}), std::move(callback), /*floating*/ true);
+}
+
+Slot CallBatch::send(replies_handler callback, return_slot_t)
+{
+    auto batch = sendBatch(std::exchange(calls_, {}), std::exchange(timeouts_, {}), std::move(callback), /*floating*/ false);
+
+    auto* batchPtr = batch.get();
+    return {batchPtr, [batch = std::move(batch)](void*) mutable { batch.reset(); }};
+}
+
+std::future<CallBatch::Replies> CallBatch::send(with_future_t)
+{
+    auto promise = std::make_shared<std::promise<Replies>>();
+    auto future = promise->get_future();
+
+    send([promise = std::move(promise)](Replies replies)
+    {
+        promise->set_value(std::move(replies));
+    });
+
+    return future;
+}
+
+CallBatchAwaitable CallBatch::send(with_awaitable_t)
+{
+    // The calls are made only once the awaiting coroutine gets suspended
+    return CallBatchAwaitable{std::exchange(*this, {})};
+}
+
+CallBatchAwaitable::CallBatchAwaitable(CallBatch batch)
+    : batch_(std::move(batch))
+{
+}
+
+bool CallBatchAwaitable::await_ready() const noexcept
+{
+    return false;
+}
+
+bool CallBatchAwaitable::await_suspend(std::coroutine_handle<> handle)
+{
+    handle_ = handle;
+
+    batchSlot_ = batch_.send([this](CallBatch::Replies replies)
+    {
+        replies_ = std::move(replies);
+
+        // If the coroutine has been suspended already, resume it right here in the event loop thread.
+        // `this` must not be touched afterwards, as the coroutine may have destroyed the awaitable.
+        if (ready_.exchange(true, std::memory_order_acq_rel))
+            handle_.resume();
+    }, return_slot);
+
+    // The batch may have completed already. If so, don't suspend at all.
+    return !ready_.exchange(true, std::memory_order_acq_rel);
+}
+
+CallBatch::Replies CallBatchAwaitable::await_resume()
+{
+    return std::move(replies_);
+}
+
+}
@@ -0,0 +1,164 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file Compression.cpp
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Compression.h"
+
+#include "sdbus-c++/Error.h"
+
+#include <cerrno>
+#include <climits>
+#include <string>
+#ifdef SDBUS_WITH_LZ4
+#include <lz4.h>
+#endif
+#ifdef SDBUS_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+namespace sdbus::internal {
+
+namespace {
+    // Compression level trading ratio for speed, as suitable for data sent on the fly
+    [[maybe_unused]] constexpr int ZSTD_COMPRESSION_LEVEL = 3;
+
+    // Upper bounds of the ratio of decompressed to compressed size the codecs can reach, which the original size
+    // announced by the peer is checked against before allocating for it. LZ4 encodes at most 255 more bytes of
+    // a match per byte of its length, zstd at most a block of 128 KiB by an RLE block of 4 bytes.
+    constexpr std::size_t LZ4_MAX_EXPANSION_RATIO = 255;
+    constexpr std::size_t ZSTD_MAX_EXPANSION_RATIO = 128 * 1024 / 4;
+}
+
+bool isCompressionCodecAvailable(CompressedBytes::Codec codec) noexcept
+{
+    switch (codec)
+    {
+        case CompressedBytes::Codec::None:
+            return true;
+#ifdef SDBUS_WITH_LZ4
+        case CompressedBytes::Codec::Lz4:
+            return true;
+#endif
+#ifdef SDBUS_WITH_ZSTD
+        case CompressedBytes::Codec::Zstd:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+std::optional<std::vector<std::uint8_t>> compressBytes(CompressedBytes::Codec codec, std::span<const std::uint8_t> data)
+{
+    std::vector<std::uint8_t> compressed;
+    std::size_t compressedSize{};
+
+    switch (codec)
+    {
+#ifdef SDBUS_WITH_LZ4
+        case CompressedBytes::Codec::Lz4:
+        {
+            if (data.size() > static_cast<std::size_t>(LZ4_MAX_INPUT_SIZE))
+                return std::nullopt;
+            compressed.resize(static_cast<std::size_t>(LZ4_compressBound(static_cast<int>(data.size()))));
+            auto r = LZ4_compress_default( reinterpret_cast<const char*>(data.data())
+                                         , reinterpret_cast<char*>(compressed.data())
+                                         , static_cast<int>(data.size())
+                                         , static_cast<int>(compressed.size()) );
+            SDBUS_THROW_ERROR_IF(r <= 0, "Failed to compress data by LZ4", EINVAL);
+            compressedSize = static_cast<std::size_t>(r);
+            break;
+        }
+#endif
+#ifdef SDBUS_WITH_ZSTD
+        case CompressedBytes::Codec::Zstd:
+        {
+            compressed.resize(ZSTD_compressBound(data.size()));
+            auto r = ZSTD_compress(compressed.data(), compressed.size(), data.data(), data.size(), ZSTD_COMPRESSION_LEVEL);
+            SDBUS_THROW_ERROR_IF(ZSTD_isError(r), "Failed to compress data by zstd: " + std::string(ZSTD_getErrorName(r)), EINVAL);
+            compressedSize = r;
+            break;
+        }
+#endif
+        default:
+            return std::nullopt;
+    }
+
+    if (compressedSize >= data.size())
+        return std::nullopt;
+
+    compressed.resize(compressedSize);
+    return compressed;
+}
+
+std::vector<std::uint8_t> decompressBytes(CompressedBytes::Codec codec, [[maybe_unused]] std::span<const std::uint8_t> data, std::size_t originalSize)
+{
+    SDBUS_THROW_ERROR_IF( codec == CompressedBytes::Codec::None || !isCompressionCodecAvailable(codec)
+                        , "Data compressed by a codec unavailable in this build of sdbus-c++"
+                        , ENOTSUP );
+    SDBUS_THROW_ERROR_IF(originalSize > MAX_DECOMPRESSED_SIZE, "Compressed data announces too large original size", EMSGSIZE);
+    const auto maxExpansionRatio = codec == CompressedBytes::Codec::Lz4 ? LZ4_MAX_EXPANSION_RATIO : ZSTD_MAX_EXPANSION_RATIO;
+    SDBUS_THROW_ERROR_IF( originalSize > data.size() * maxExpansionRatio
+                        , "Compressed data announces original size it can't decompress to"
+                        , EBADMSG );
+#ifdef SDBUS_WITH_ZSTD
+    // Zstd frames carry their content size, which must match the announced one
+    SDBUS_THROW_ERROR_IF( codec == CompressedBytes::Codec::Zstd && ZSTD_getFrameContentSize(data.data(), data.size()) != originalSize
+                        , "Compressed data announces original size other than its zstd frame"
+                        , EBADMSG );
+#endif
+
+    std::vector<std::uint8_t> decompressed(originalSize);
+
+    switch (codec)
+    {
+#ifdef SDBUS_WITH_LZ4
+        case CompressedBytes::Codec::Lz4:
+        {
+            SDBUS_THROW_ERROR_IF(data.size() > INT_MAX || originalSize > INT_MAX, "Data compressed by LZ4 are too large", EMSGSIZE);
+            auto r = LZ4_decompress_safe( reinterpret_cast<const char*>(data.data())
+                                        , reinterpret_cast<char*>(decompressed.data())
+                                        , static_cast<int>(data.size())
+                                        , static_cast<int>(originalSize) );
+            SDBUS_THROW_ERROR_IF(r < 0 || static_cast<std::size_t>(r) != originalSize, "Failed to decompress data by LZ4", EBADMSG);
+            break;
+        }
+#endif
+#ifdef SDBUS_WITH_ZSTD
+        case CompressedBytes::Codec::Zstd:
+        {
+            auto r = ZSTD_decompress(decompressed.data(), decompressed.size(), data.data(), data.size());
+            SDBUS_THROW_ERROR_IF(ZSTD_isError(r) || r != originalSize, "Failed to decompress data by zstd", EBADMSG);
+            break;
+        }
+#endif
+        default:
+            break;
+    }
+
+    return decompressed;
+}
+
+}
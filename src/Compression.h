@@ -0,0 +1,56 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file Compression.h
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_INTERNAL_COMPRESSION_H_
+#define SDBUS_CXX_INTERNAL_COMPRESSION_H_
+
+#include "sdbus-c++/Types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace sdbus::internal {
+
+    // Upper bound of the original size of a compressed block a peer may announce, so that a malicious
+    // or broken peer can't make the receiver allocate arbitrary amounts of memory
+    constexpr std::size_t MAX_DECOMPRESSED_SIZE = std::size_t{1} << 30;
+
+    // Tells whether the codec was enabled in this build (by SDBUSCPP_WITH_LZ4 and SDBUSCPP_WITH_ZSTD options)
+    bool isCompressionCodecAvailable(CompressedBytes::Codec codec) noexcept;
+
+    // Compresses the data by an available codec, returns nullopt if the compressed block wouldn't be smaller
+    std::optional<std::vector<std::uint8_t>> compressBytes(CompressedBytes::Codec codec, std::span<const std::uint8_t> data);
+
+    // Decompresses the block into the given original size, throws sdbus::Error if the codec is unavailable
+    // or the block doesn't decompress into exactly that size
+    std::vector<std::uint8_t> decompressBytes(CompressedBytes::Codec codec, std::span<const std::uint8_t> data, std::size_t originalSize);
+
+}
+
+#endif /* SDBUS_CXX_INTERNAL_COMPRESSION_H_ */
@@ -27,16 +27,28 @@
 #include "Connection.h"
 
 #include "sdbus-c++/Error.h"
+#include "sdbus-c++/ITracer.h"
 #include "sdbus-c++/Message.h"
 #include "sdbus-c++/Types.h"
 
+#include "MemoryResource.h"
 #include "MessageUtils.h"
+#include "Object.h"
 #include "ScopeGuard.h"
 #include "SdBus.h"
+#include "ThreadPolicy.h"
 #include "Utils.h"
 
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <limits>
 #include <poll.h>
+#include <string_view>
 #include <sys/eventfd.h>
+#include <sys/socket.h>
 #include SDBUS_HEADER
 #ifndef SDBUS_basu // sd_event integration is not supported in basu-based sdbus-c++
 #include <systemd/sd-event.h>
@@ -48,6 +60,7 @@ namespace sdbus::internal {
 Connection::Connection(std::unique_ptr<ISdBus>&& interface, const BusFactory& busFactory)
     : sdbus_(std::move(interface))
     , bus_(openBus(busFactory))
+    , asyncCallTimers_(now())
 {
     assert(sdbus_ != nullptr);
 }
@@ -80,16 +93,19 @@ Connection::Connection(std::unique_ptr<ISdBus>&& interface, remote_system_bus_t,
 Connection::Connection(std::unique_ptr<ISdBus>&& interface, private_bus_t, const std::string& address)
     : Connection(std::move(interface), [&](sd_bus** bus) { return sdbus_->sd_bus_open_direct(bus, address.c_str()); })
 {
+    isPeerToPeer_ = true;
 }
 
 Connection::Connection(std::unique_ptr<ISdBus>&& interface, private_bus_t, int fd)
         : Connection(std::move(interface), [&](sd_bus** bus) { return sdbus_->sd_bus_open_direct(bus, fd); })
 {
+    isPeerToPeer_ = true;
 }
 
 Connection::Connection(std::unique_ptr<ISdBus>&& interface, server_bus_t, int fd)
     : Connection(std::move(interface), [&](sd_bus** bus) { return sdbus_->sd_bus_open_server(bus, fd); })
 {
+    isPeerToPeer_ = true;
 }
 
 Connection::Connection(std::unique_ptr<ISdBus>&& interface, sdbus_bus_t, sd_bus *bus)
@@ -100,32 +116,75 @@ Connection::Connection(std::unique_ptr<ISdBus>&& interface, sdbus_bus_t, sd_bus
 Connection::Connection(std::unique_ptr<ISdBus>&& interface, pseudo_bus_t)
     : sdbus_(std::move(interface))
     , bus_(openPseudoBus())
+    , asyncCallTimers_(now())
 {
     assert(sdbus_ != nullptr);
 }
 
 Connection::~Connection()
 {
+    invokeDestructionHandlers();
+    Connection::enableLocalDispatch(false);
     Connection::leaveEventLoop();
+    Connection::enableSubmissionQueue(false);
+    freeReleasedAsyncCalls();
+    clearCredentialsCache();
 }
 
 void Connection::requestName(const ServiceName& name)
 {
     SDBUS_CHECK_SERVICE_NAME(name.c_str());
 
-    auto r = sdbus_->sd_bus_request_name(bus_.get(), name.c_str(), 0);
+    auto r = startupProfiler_.measure(StartupPhase::NameRequest, {}, [&]
+    {
+        return sdbus_->sd_bus_request_name(bus_.get(), name.c_str(), 0);
+    });
     SDBUS_THROW_ERROR_IF(r < 0, "Failed to request bus name", -r);
 
+    {
+        std::lock_guard lock(localDispatchMutex_);
+        ownedNames_.insert(name);
+    }
+
     // In some cases we need to explicitly notify the event loop
     // to process messages that may have arrived while executing the call
     wakeUpEventLoopIfMessagesInQueue();
 }
 
+void Connection::requestNameAsync(const ServiceName& name, name_request_handler callback)
+{
+    auto slot = Connection::requestNameAsync(name, std::move(callback), return_slot);
+
+    std::lock_guard lock(floatingNameRequestsMutex_);
+    floatingNameRequests_.push_back(std::move(slot));
+}
+
+Slot Connection::requestNameAsync(const ServiceName& name, name_request_handler callback, return_slot_t)
+{
+    SDBUS_CHECK_SERVICE_NAME(name.c_str());
+
+    // The same request as sd_bus_request_name() with no flags sends, just that the reply is not waited for
+    constexpr uint32_t DBUS_NAME_FLAG_DO_NOT_QUEUE{4};
+    auto call = createMethodCall("org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus", "RequestName");
+    call << name.c_str() << DBUS_NAME_FLAG_DO_NOT_QUEUE;
+
+    auto request = makePooled<NameRequest>(*memoryResource_, name, std::move(callback), *this, Slot{});
+    request->slot = call.send((void*)&Connection::sdbus_name_request_reply_handler, request.get(), 0, return_slot);
+
+    return {request.release(), [deleter = request.get_deleter()](void *ptr){ deleter(static_cast<NameRequest*>(ptr)); }};
+}
+
 void Connection::releaseName(const ServiceName& name)
 {
     auto r = sdbus_->sd_bus_release_name(bus_.get(), name.c_str());
     SDBUS_THROW_ERROR_IF(r < 0, "Failed to release bus name", -r);
 
+    {
+        std::lock_guard lock(localDispatchMutex_);
+        if (auto it = ownedNames_.find(name); it != ownedNames_.end())
+            ownedNames_.erase(it);
+    }
+
     // In some cases we need to explicitly notify the event loop
     // to process messages that may have arrived while executing the call
     wakeUpEventLoopIfMessagesInQueue();
@@ -139,12 +198,129 @@ BusName Connection::getUniqueName() const
     return BusName{name};
 }
 
+void Connection::watchName(const ServiceName& name)
+{
+    auto slot = watchName(name, return_slot);
+
+    std::lock_guard lock(floatingMatchRulesMutex_);
+    floatingMatchRules_.push_back(std::move(slot));
+}
+
+Slot Connection::watchName(const ServiceName& name, return_slot_t)
+{
+    SDBUS_CHECK_SERVICE_NAME(name.c_str());
+
+    auto watchSlot = [this, name]() -> Slot { return {this, [this, name](void*){ unwatchName(name); }}; };
+
+    {
+        std::lock_guard lock(watchedNamesMutex_);
+        hasWatchedNames_ = true;
+        if (watchedNames_[name].watchCount++ > 0)
+            return watchSlot();
+    }
+
+    try
+    {
+        // The match is installed before the owner is queried, so no owner change gets lost in between
+        auto ownerChangedMatch = "type='signal',sender='org.freedesktop.DBus',path='/org/freedesktop/DBus',"
+                                 "interface='org.freedesktop.DBus',member='NameOwnerChanged',arg0='" + name + "'";
+        auto match = addMatch(ownerChangedMatch, [this](Message msg)
+        {
+            std::string changedName, oldOwner, newOwner;
+            msg >> changedName >> oldOwner >> newOwner;
+            std::lock_guard lock(watchedNamesMutex_);
+            if (auto it = watchedNames_.find(changedName); it != watchedNames_.end())
+                it->second.owner = std::move(newOwner);
+        }, return_slot);
+        auto owner = queryNameOwner(name);
+
+        std::lock_guard lock(watchedNamesMutex_);
+        auto& watchedName = watchedNames_[name];
+        watchedName.ownerChangedMatch = std::move(match);
+        if (!watchedName.owner) // Unless an owner change has already been processed meanwhile
+            watchedName.owner = std::move(owner);
+    }
+    catch (...)
+    {
+        unwatchName(name);
+        throw;
+    }
+
+    return watchSlot();
+}
+
+BusName Connection::getWatchedNameOwner(const ServiceName& name) const
+{
+    std::lock_guard lock(watchedNamesMutex_);
+    auto it = watchedNames_.find(name);
+    SDBUS_THROW_ERROR_IF(it == watchedNames_.end(), "Failed to get owner of name that is not watched", EINVAL);
+    return BusName{it->second.owner.value_or(std::string{})};
+}
+
+void Connection::unwatchName(const std::string& name)
+{
+    Slot ownerChangedMatch;
+    {
+        std::lock_guard lock(watchedNamesMutex_);
+        auto it = watchedNames_.find(name);
+        if (it == watchedNames_.end() || --it->second.watchCount > 0)
+            return;
+        ownerChangedMatch = std::move(it->second.ownerChangedMatch);
+        watchedNames_.erase(it);
+        hasWatchedNames_ = !watchedNames_.empty();
+    }
+
+    // Releasing the match slot acquires global sd-bus mutex, so we must do it out of the `watchedNamesMutex_' critical section
+}
+
+std::string Connection::queryNameOwner(const std::string& name) const
+{
+    auto call = createMethodCall("org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus", "GetNameOwner");
+    call << name;
+
+    try
+    {
+        std::string owner;
+        call.send(0) >> owner;
+        return owner;
+    }
+    catch (const Error& e)
+    {
+        if (e.getName() != SD_BUS_ERROR_NAME_HAS_NO_OWNER)
+            throw;
+        return {};
+    }
+}
+
+bool Connection::resolveWatchedName(const char* name, std::string& owner) const
+{
+    std::lock_guard lock(watchedNamesMutex_);
+    auto it = watchedNames_.find(name);
+    if (it == watchedNames_.end() || !it->second.owner)
+        return false;
+
+    if (it->second.owner->empty())
+        throw Error(Error::Name{SD_BUS_ERROR_SERVICE_UNKNOWN}, "The name " + it->first + " currently has no owner");
+
+    owner = *it->second.owner;
+    return true;
+}
+
 void Connection::enterEventLoop()
 {
+    eventLoopState_.store(EventLoopState::Processing, std::memory_order_relaxed);
+    SCOPE_EXIT{ eventLoopState_.store(EventLoopState::NotRunning, std::memory_order_relaxed); };
+
     while (true)
     {
-        // Process one pending event
-        (void)processPendingEvent();
+        // Process pending events in a batch, so that we don't re-arm poll between individual messages
+        (void)processPendingEvents(MAX_EVENTS_PER_BATCH, MAX_BATCH_DURATION);
+
+        // In the low-latency mode, keep on processing events as they come for a while before going to sleep
+        busyPollForEvents();
+
+        if (isClosedByPeer_.load(std::memory_order_relaxed))
+            break; // The other end of the direct connection is gone, there's nothing more to process
 
         // And go to poll(), which wakes us up right away
         // if there's another pending event, or sleeps otherwise.
@@ -157,7 +333,41 @@ void Connection::enterEventLoop()
 void Connection::enterEventLoopAsync()
 {
     if (!asyncLoopThread_.joinable())
-        asyncLoopThread_ = std::thread([this](){ enterEventLoop(); });
+    {
+        std::lock_guard lock(syncCallsViaEventLoopMutex_);
+        asyncLoopThread_ = startThread(ThreadRole::EventLoop, [this]()
+        {
+            enterEventLoop();
+            abandonSyncCallsViaEventLoop();
+        });
+        asyncLoopThreadId_ = asyncLoopThread_.get_id();
+    }
+}
+
+void Connection::enableMethodCallDispatchPool(std::size_t threadCount, DispatchOrdering ordering)
+{
+    SDBUS_THROW_ERROR_IF(threadCount == 0, "Invalid number of dispatch pool threads", EINVAL);
+    SDBUS_THROW_ERROR_IF(dispatchPool_ != nullptr, "Method call dispatch pool is already enabled", EALREADY);
+
+    dispatchPool_ = std::make_unique<MethodCallDispatchPool>(threadCount, ordering, *this);
+}
+
+void Connection::setEventLoopBusyPollDuration(std::chrono::microseconds duration)
+{
+    SDBUS_THROW_ERROR_IF(duration < std::chrono::microseconds::zero(), "Invalid event loop busy-poll duration", EINVAL);
+
+    busyPollDuration_.store(duration, std::memory_order_relaxed);
+
+#ifdef SO_BUSY_POLL
+    // Best effort only: the kernel busy-polls the device queue for sockets of network devices, i.e. on TCP bus
+    // connections, and raising the value above net.core.busy_read requires CAP_NET_ADMIN. Unix sockets ignore it.
+    ISdBus::PollData pollData{};
+    if (sdbus_->sd_bus_get_poll_data(bus_.get(), &pollData) >= 0)
+    {
+        auto usec = static_cast<int>(std::min<std::chrono::microseconds::rep>(duration.count(), std::numeric_limits<int>::max()));
+        (void)setsockopt(pollData.fd, SOL_SOCKET, SO_BUSY_POLL, &usec, sizeof(usec));
+    }
+#endif
 }
 
 void Connection::leaveEventLoop()
@@ -176,6 +386,42 @@ Connection::PollData Connection::getEventLoopPollData() const
 
     auto timeout = pollData.timeout_usec == UINT64_MAX ? std::chrono::microseconds::max() : std::chrono::microseconds(pollData.timeout_usec);
 
+    // Async call timeouts are not known to sd-bus, the event loop has to wake up for the nearest one of them, too
+    std::chrono::nanoseconds asyncCallDeadline;
+    {
+        std::lock_guard lock(asyncCallTimersMutex_);
+        asyncCallDeadline = asyncCallTimers_.nextDeadline();
+        polledAsyncCallDeadline_.store(asyncCallDeadline, std::memory_order_relaxed);
+    }
+    if (asyncCallDeadline != std::chrono::nanoseconds::max())
+        timeout = std::min(timeout, std::chrono::ceil<std::chrono::microseconds>(asyncCallDeadline));
+
+    // Likewise for the nearest due time of coalesced PropertiesChanged signals
+    auto coalescedPropertiesChangeDue = nextCoalescedPropertiesChangeDue_.load(std::memory_order_relaxed);
+    if (coalescedPropertiesChangeDue != std::chrono::nanoseconds::max())
+        timeout = std::min(timeout, std::chrono::ceil<std::chrono::microseconds>(coalescedPropertiesChangeDue));
+
+    // Likewise for method calls waiting in the admission queue, unless they wait for a dispatch pool worker to get free
+    if (hasScheduledMethodCalls_.load(std::memory_order_relaxed) && canHandleScheduledMethodCall())
+    {
+        std::chrono::nanoseconds scheduledMethodCallReady;
+        {
+            std::lock_guard lock(methodCallSchedulerMutex_);
+            scheduledMethodCallReady = methodCallScheduler_.nextReadyTime(now());
+        }
+        if (scheduledMethodCallReady != std::chrono::nanoseconds::max())
+            timeout = std::min(timeout, std::chrono::ceil<std::chrono::microseconds>(scheduledMethodCallReady));
+    }
+
+    // Async calls released by other threads are to be freed right away, local method calls and replies handled right away,
+    // and submitted messages sent out and posted work done right away
+    if ( releasedAsyncCalls_.load(std::memory_order_relaxed) != nullptr
+      || submittedMessages_.load(std::memory_order_relaxed) != nullptr
+      || hasPostedWork_.load(std::memory_order_relaxed)
+      || hasLocalMethodCalls_.load(std::memory_order_relaxed)
+      || hasLocalReplies_.load(std::memory_order_relaxed) )
+        timeout = std::chrono::microseconds::zero();
+
     return {pollData.fd, pollData.events, timeout, eventFd_.fd};
 }
 
@@ -184,6 +430,9 @@ void Connection::addObjectManager(const ObjectPath& objectPath)
     auto r = sdbus_->sd_bus_add_object_manager(bus_.get(), nullptr, objectPath.c_str());
 
     SDBUS_THROW_ERROR_IF(r < 0, "Failed to add object manager", -r);
+
+    introspectionCache_.addObjectManager(objectPath, nullptr);
+    managedObjectsCache_.addObjectManager(objectPath, nullptr);
 }
 
 Slot Connection::addObjectManager(const ObjectPath& objectPath, return_slot_t)
@@ -194,7 +443,27 @@ Slot Connection::addObjectManager(const ObjectPath& objectPath, return_slot_t)
 
     SDBUS_THROW_ERROR_IF(r < 0, "Failed to add object manager", -r);
 
-    return {slot, [this](void *slot){ sdbus_->sd_bus_slot_unref((sd_bus_slot*)slot); }};
+    introspectionCache_.addObjectManager(objectPath, slot);
+    managedObjectsCache_.addObjectManager(objectPath, slot);
+
+    return {slot, [this, objectPath](void *slot)
+    {
+        introspectionCache_.remove(objectPath, slot);
+        managedObjectsCache_.remove(objectPath, slot);
+        sdbus_->sd_bus_slot_unref((sd_bus_slot*)slot);
+    }};
+}
+
+void Connection::registerObjects(std::vector<ObjectRegistration> batch, std::size_t preparationThreads)
+{
+    SDBUS_THROW_ERROR_IF(preparationThreads == 0, "Invalid number of vtable preparation threads", EINVAL);
+
+    Object::registerObjects(*this, std::move(batch), preparationThreads);
+}
+
+void Connection::unregisterObjects(std::span<IObject* const> objects)
+{
+    Object::unregisterObjects(*this, objects);
 }
 
 void Connection::setMethodCallTimeout(uint64_t timeout)
@@ -215,182 +484,598 @@ uint64_t Connection::getMethodCallTimeout() const
     return timeout;
 }
 
-void Connection::addMatch(const std::string& match, message_handler callback)
+void Connection::enableMetrics(bool enabled)
 {
-    floatingMatchRules_.push_back(addMatch(match, std::move(callback), return_slot));
+    metrics_.enable(enabled);
 }
 
-Slot Connection::addMatch(const std::string& match, message_handler callback, return_slot_t)
+void Connection::enableBusLockProfiling(bool enabled, uint32_t samplingInterval)
 {
-    SDBUS_THROW_ERROR_IF(!callback, "Invalid match callback handler provided", EINVAL);
-
-    auto matchInfo = std::make_unique<MatchInfo>(MatchInfo{std::move(callback), {}, *this, {}});
-
-    sd_bus_slot *slot{};
-    auto r = sdbus_->sd_bus_add_match(bus_.get(), &slot, match.c_str(), &Connection::sdbus_match_callback, matchInfo.get());
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to add match", -r);
+    SDBUS_THROW_ERROR_IF(samplingInterval == 0, "Invalid bus lock profiling sampling interval", EINVAL);
 
-    matchInfo->slot = {slot, [this](void *slot){ sdbus_->sd_bus_slot_unref((sd_bus_slot*)slot); }};
-
-    return {matchInfo.release(), [](void *ptr){ delete static_cast<MatchInfo*>(ptr); }};
+    sdbus_->enableLockProfiling(enabled, samplingInterval);
 }
 
-void Connection::addMatchAsync(const std::string& match, message_handler callback, message_handler installCallback)
+void Connection::enableCredentialsCache(bool enabled)
 {
-    floatingMatchRules_.push_back(addMatchAsync(match, std::move(callback), std::move(installCallback), return_slot));
+    if (!enabled)
+    {
+        credentialsCacheEnabled_ = false;
+        credentialsCacheInvalidation_.reset();
+        clearCredentialsCache();
+        return;
+    }
+
+    // Senders of direct connections carry no unique name, so there is nothing to cache nor to invalidate
+    if (!isPeerToPeer_ && !credentialsCacheInvalidation_)
+    {
+        credentialsCacheInvalidation_ = addMatchAsync( "type='signal',sender='org.freedesktop.DBus',path='/org/freedesktop/DBus',"
+                                                       "interface='org.freedesktop.DBus',member='NameOwnerChanged'"
+                                                     , [this](Message msg)
+                                                       {
+                                                           std::string name, oldOwner, newOwner;
+                                                           msg >> name >> oldOwner >> newOwner;
+                                                           if (newOwner.empty())
+                                                               dropCachedCredentials(name);
+                                                       }
+                                                     , {}
+                                                     , return_slot );
+    }
+    credentialsCacheEnabled_ = true;
 }
 
-Slot Connection::addMatchAsync( const std::string& match
-                              , message_handler callback
-                              , message_handler installCallback
-                              , return_slot_t )
+void Connection::enableIntrospectionCache(bool enabled)
 {
-    SDBUS_THROW_ERROR_IF(!callback, "Invalid match callback handler provided", EINVAL);
+    if (!enabled)
+    {
+        introspectionFilter_.reset();
+        introspectionCache_.enable(false);
+        return;
+    }
 
-    sd_bus_message_handler_t sdbusInstallCallback = installCallback ? &Connection::sdbus_match_install_callback : nullptr;
-    auto matchInfo = std::make_unique<MatchInfo>(MatchInfo{std::move(callback), std::move(installCallback), *this, {}});
+    if (introspectionFilter_)
+        return;
 
-    sd_bus_slot *slot{};
-    auto r = sdbus_->sd_bus_add_match_async( bus_.get()
-                                           , &slot
-                                           , match.c_str()
-                                           , &Connection::sdbus_match_callback
-                                           , sdbusInstallCallback
-                                           , matchInfo.get());
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to add match", -r);
+    // Untrusted buses get privileged methods and properties annotated in introspection data
+    trustedBus_.store(sdbus_->sd_bus_is_trusted(bus_.get()) > 0, std::memory_order_relaxed);
 
-    matchInfo->slot = {slot, [this](void *slot){ sdbus_->sd_bus_slot_unref((sd_bus_slot*)slot); }};
+    sd_bus_slot *slot{};
+    auto r = sdbus_->sd_bus_add_filter(bus_.get(), &slot, &Connection::sdbus_introspection_filter, this);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to add introspection filter", -r);
 
-    return {matchInfo.release(), [](void *ptr){ delete static_cast<MatchInfo*>(ptr); }};
+    introspectionFilter_ = {slot, [this](void *slot){ sdbus_->sd_bus_slot_unref((sd_bus_slot*)slot); }};
+    introspectionCache_.enable(true);
 }
 
-void Connection::attachSdEventLoop(sd_event *event, int priority)
+void Connection::enableManagedObjectsCache(bool enabled)
 {
-#ifndef SDBUS_basu
-    auto pollData = getEventLoopPollData();
+    if (!enabled)
+    {
+        managedObjectsCacheEnabled_.store(false, std::memory_order_relaxed);
+        managedObjectsFilter_.reset();
+        managedObjectsCache_.clear();
+        return;
+    }
 
-    auto sdEvent = createSdEventSlot(event);
-    auto sdTimeEventSource = createSdTimeEventSourceSlot(event, priority);
-    auto sdIoEventSource = createSdIoEventSourceSlot(event, pollData.fd, priority);
-    auto sdInternalEventSource = createSdInternalEventSourceSlot(event, pollData.eventFd, priority);
+    if (managedObjectsFilter_)
+        return;
 
-    sdEvent_ = std::make_unique<SdEvent>(SdEvent{ std::move(sdEvent)
-                                                , std::move(sdTimeEventSource)
-                                                , std::move(sdIoEventSource)
-                                                , std::move(sdInternalEventSource) });
-#else
-    (void)event;
-    (void)priority;
-    SDBUS_THROW_ERROR("sd_event integration is not supported on this platform", EOPNOTSUPP);
-#endif
-}
+    sd_bus_slot *slot{};
+    auto r = sdbus_->sd_bus_add_filter(bus_.get(), &slot, &Connection::sdbus_managed_objects_filter, this);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to add managed objects filter", -r);
 
-void Connection::detachSdEventLoop()
-{
-    sdEvent_.reset();
+    managedObjectsFilter_ = {slot, [this](void *slot){ sdbus_->sd_bus_slot_unref((sd_bus_slot*)slot); }};
+    managedObjectsCacheEnabled_.store(true, std::memory_order_relaxed);
 }
 
-sd_event *Connection::getSdEventLoop()
+void Connection::invalidateManagedObjects(std::string_view objectPath, std::string_view interfaceName)
 {
-    return sdEvent_ ? static_cast<sd_event*>(sdEvent_->sdEvent.get()) : nullptr;
+    // Properties are cached only while the cache is enabled, and disabling it drops them
+    if (managedObjectsCacheEnabled_.load(std::memory_order_relaxed))
+        managedObjectsCache_.invalidate(objectPath, interfaceName);
 }
 
-#ifndef SDBUS_basu
-
-Slot Connection::createSdEventSlot(sd_event *event)
+void Connection::enableLocalDispatch(bool enabled)
 {
-    // Get default event if no event is provided by the caller
-    if (event != nullptr)
-        event = sd_event_ref(event);
-    else
-        (void)sd_event_default(&event);
-    SDBUS_THROW_ERROR_IF(!event, "Invalid sd_event handle", EINVAL);
+    if (enabled)
+    {
+        auto uniqueName = getUniqueName();
+
+        std::lock_guard registryLock(localDispatchRegistryMutex_);
+        if (isInLocalDispatchRegistry(this))
+            return;
+        localUniqueName_ = std::move(uniqueName);
+        localDispatchRegistry_.push_back(this);
+        localDispatchEnabled_.store(true, std::memory_order_relaxed);
+        return;
+    }
 
-    return Slot{event, [](void* event){ sd_event_unref((sd_event*)event); }};
+    {
+        std::lock_guard registryLock(localDispatchRegistryMutex_);
+        auto it = std::find(localDispatchRegistry_.begin(), localDispatchRegistry_.end(), this);
+        if (it == localDispatchRegistry_.end())
+            return;
+        localDispatchRegistry_.erase(it);
+        localDispatchEnabled_.store(false, std::memory_order_relaxed);
+    }
+
+    // No calls nor replies are handed over to us anymore, so those in progress are failed
+    failLocalCalls();
 }
 
-Slot Connection::createSdTimeEventSourceSlot(sd_event *event, int priority)
+void Connection::enableSubmissionQueue(bool enabled)
 {
-    sd_event_source *timeEventSource{};
-    auto r = sd_event_add_time(event, &timeEventSource, CLOCK_MONOTONIC, 0, 0, onSdTimerEvent, this);
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to add timer event", -r);
-    Slot sdTimeEventSource{timeEventSource, [](void* source){ deleteSdEventSource((sd_event_source*)source); }};
+    submissionQueueEnabled_.store(enabled, std::memory_order_seq_cst);
+    if (enabled)
+        return;
 
-    r = sd_event_source_set_priority(timeEventSource, priority);
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to set time event priority", -r);
+    // Submitters which saw the queue enabled are waited for, so that no message is pushed after the queue is drained.
+    // They don't take any lock while counted, so this can't deadlock even if we hold the sd-bus lock.
+    while (activeSubmitters_.load(std::memory_order_seq_cst) != 0)
+        std::this_thread::yield();
 
-    r = sd_event_source_set_description(timeEventSource, "bus-time");
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to set time event description", -r);
+    // Messages submitted before are sent out right away, as there may be no event loop to send them anymore
+    if (sendSubmittedMessages())
+        wakeUpEventLoopIfMessagesInQueue();
+}
 
-    return sdTimeEventSource;
+// Creds are unref'd, which takes the bus lock, only after releasing the cache mutex. The bus lock may already be held
+// by the caller (e.g. the NameOwnerChanged handler run by sd_bus_process()), so it must never be taken under the mutex.
+void Connection::dropCachedCredentials(const std::string& uniqueName)
+{
+    sd_bus_creds* creds{};
+    {
+        std::lock_guard lock(credentialsCacheMutex_);
+        if (auto it = credentialsCache_.find(uniqueName); it != credentialsCache_.end())
+        {
+            creds = it->second.creds;
+            credentialsCache_.erase(it);
+        }
+    }
+
+    if (creds != nullptr)
+        sdbus_->sd_bus_creds_unref(creds);
 }
 
-Slot Connection::createSdIoEventSourceSlot(sd_event *event, int fd, int priority)
+void Connection::clearCredentialsCache()
 {
-    sd_event_source *ioEventSource{};
-    auto r = sd_event_add_io(event, &ioEventSource, fd, 0, onSdIoEvent, this);
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to add io event", -r);
-    Slot sdIoEventSource{ioEventSource, [](void* source){ deleteSdEventSource((sd_event_source*)source); }};
+    decltype(credentialsCache_) credentialsCache;
+    {
+        std::lock_guard lock(credentialsCacheMutex_);
+        credentialsCache.swap(credentialsCache_);
+    }
 
-    r = sd_event_source_set_prepare(ioEventSource, onSdEventPrepare);
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to set prepare callback for IO event", -r);
+    for (auto& [name, cached] : credentialsCache)
+        sdbus_->sd_bus_creds_unref(cached.creds);
+}
 
-    r = sd_event_source_set_priority(ioEventSource, priority);
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to set priority for IO event", -r);
+Connection::Metrics Connection::getMetrics() const
+{
+    auto metrics = metrics_.getSnapshot();
+    metrics.busLockProfiles = sdbus_->getLockProfiles();
 
-    r = sd_event_source_set_description(ioEventSource, "bus-input");
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to set priority for IO event", -r);
+    return metrics;
+}
 
-    return sdIoEventSource;
+void Connection::resetMetrics()
+{
+    metrics_.reset();
+    sdbus_->resetLockProfiles();
 }
 
-Slot Connection::createSdInternalEventSourceSlot(sd_event *event, int fd, int priority)
+Connection::ResourceUsage Connection::getResourceUsage() const
 {
-    sd_event_source *internalEventSource{};
-    auto r = sd_event_add_io(event, &internalEventSource, fd, 0, onSdInternalEvent, this);
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to add internal event", -r);
-    Slot sdInternalEventSource{internalEventSource, [](void* source){ deleteSdEventSource((sd_event_source*)source); }};
+    // Rough size of a node of a node-based container, on top of its value
+    constexpr std::size_t NODE_OVERHEAD{4 * sizeof(void*)};
 
-    // sd-event loop calls prepare callbacks for all event sources, not just for the one that fired now.
-    // So since onSdEventPrepare is already registered on ioEventSource, we don't need to duplicate it here.
-    //r = sd_event_source_set_prepare(internalEventSource, onSdEventPrepare);
-    //SDBUS_THROW_ERROR_IF(r < 0, "Failed to set prepare callback for internal event", -r);
+    ResourceUsage usage;
+    std::size_t bytes{};
 
-    r = sd_event_source_set_priority(internalEventSource, priority);
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to set priority for internal event", -r);
+    {
+        std::lock_guard lock(floatingMatchRulesMutex_);
+        usage.floatingMatchRules = floatingMatchRules_.size();
+        bytes += floatingMatchRules_.capacity() * sizeof(Slot) + usage.floatingMatchRules * sizeof(MatchInfo);
+    }
+    {
+        std::lock_guard lock(floatingNameRequestsMutex_);
+        usage.floatingNameRequests = floatingNameRequests_.size();
+        bytes += floatingNameRequests_.capacity() * sizeof(Slot) + usage.floatingNameRequests * sizeof(NameRequest);
+    }
+    {
+        std::lock_guard lock(watchedNamesMutex_);
+        usage.watchedNames = watchedNames_.size();
+        for (const auto& [name, watchedName] : watchedNames_)
+            bytes += NODE_OVERHEAD + sizeof(watchedName) + name.capacity() + (watchedName.owner ? watchedName.owner->capacity() : 0) + sizeof(MatchInfo);
+    }
 
-    r = sd_event_source_set_description(internalEventSource, "internal-event");
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to set priority for IO event", -r);
+    usage.pendingAsyncCalls = asyncCallCount_.load(std::memory_order_relaxed);
+    bytes += usage.pendingAsyncCalls * sizeof(AsyncCall);
 
-    return sdInternalEventSource;
+    {
+        std::lock_guard lock(credentialsCacheMutex_);
+        usage.cachedCredentials = credentialsCache_.size();
+        for (const auto& [sender, credentials] : credentialsCache_)
+            bytes += NODE_OVERHEAD + sizeof(credentials) + sender.capacity();
+    }
+    {
+        std::lock_guard lock(outboundQueueMutex_);
+        usage.deferredPropertiesChanges = deferredPropertiesChanges_.size();
+        for (const auto& [key, names] : deferredPropertiesChanges_)
+            bytes += NODE_OVERHEAD + sizeof(key) + sizeof(names) + key.first.capacity() + key.second.capacity() + names.size() * (NODE_OVERHEAD + sizeof(std::string));
+    }
+    {
+        std::lock_guard lock(coalescedPropertiesChangesMutex_);
+        usage.deferredPropertiesChanges += coalescedPropertiesChanges_.size();
+        for (const auto& [key, change] : coalescedPropertiesChanges_)
+            bytes += NODE_OVERHEAD + sizeof(key) + sizeof(change) + key.first.capacity() + key.second.capacity() + change.names.size() * (NODE_OVERHEAD + sizeof(std::string));
+    }
+    {
+        std::lock_guard lock(methodCallSchedulerMutex_);
+        usage.queuedMethodCalls = methodCallScheduler_.size();
+    }
+    if (dispatchPool_ != nullptr)
+        usage.queuedMethodCalls += dispatchPool_->pendingJobs();
+    bytes += usage.queuedMethodCalls * sizeof(ScheduledMethodCall);
+
+    auto r = sdbus_->sd_bus_get_n_queued(bus_.get(), &usage.readQueueDepth, &usage.writeQueueDepth);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to get number of pending messages in sd-bus queues", -r);
+
+    usage.approximateBytes = bytes;
+
+    return usage;
 }
 
-int Connection::onSdTimerEvent(sd_event_source */*s*/, uint64_t /*usec*/, void *userdata)
+void Connection::setOutboundQueueLimits(OutboundQueueLimits limits)
 {
-    auto connection = static_cast<Connection*>(userdata);
-    assert(connection != nullptr);
+    SDBUS_THROW_ERROR_IF(limits.lowWatermark > limits.highWatermark, "Invalid outbound queue watermarks provided", EINVAL);
 
-    (void)connection->processPendingEvent();
+    DeferredPropertiesChanges deferredChanges;
+    {
+        std::lock_guard lock(outboundQueueMutex_);
+        outboundQueueLimits_ = std::move(limits);
+        outboundQueueLimited_ = outboundQueueLimits_.highWatermark > 0;
+        if (!outboundQueueLimited_)
+        {
+            outboundQueueOverflown_ = false;
+            deferredChanges.swap(deferredPropertiesChanges_);
+            outboundQueueDrained_.notify_all();
+        }
+    }
 
-    return 1;
+    emitDeferredPropertiesChanges(deferredChanges);
 }
 
-int Connection::onSdIoEvent(sd_event_source */*s*/, int /*fd*/, uint32_t /*revents*/, void *userdata)
+void Connection::setMethodCallAdmissionLimits(MethodCallAdmissionLimits limits)
 {
-    auto connection = static_cast<Connection*>(userdata);
-    assert(connection != nullptr);
+    SDBUS_THROW_ERROR_IF(limits.callsPerSecond < 0.0, "Invalid method call rate limit provided", EINVAL);
+    SDBUS_THROW_ERROR_IF(limits.callsPerSecond > 0.0 && limits.burst == 0, "Invalid method call burst limit provided", EINVAL);
+    for (const auto& [interfaceName, weight] : limits.interfaceWeights)
+        SDBUS_THROW_ERROR_IF(weight == 0, "Invalid weight of interface " + interfaceName + " provided", EINVAL);
 
-    (void)connection->processPendingEvent();
+    std::lock_guard lock(methodCallSchedulerMutex_);
+    methodCallScheduler_.setLimits(limits);
+    methodCallReadAheadLimit_ = limits.maxQueuedCalls;
+    methodCallAdmission_.store(limits.maxQueuedCalls > 0, std::memory_order_relaxed);
+}
 
-    return 1;
+namespace {
+    constexpr const char* DEBUG_STATS_INTERFACE_NAME{"org.sdbuscpp.Debug.Stats"};
+
+    std::string toString(IConnection::HandlerKind kind)
+    {
+        switch (kind)
+        {
+            case IConnection::HandlerKind::Method: return "method";
+            case IConnection::HandlerKind::PropertyGet: return "get";
+            case IConnection::HandlerKind::PropertySet: return "set";
+        }
+        return {};
+    }
 }
 
-int Connection::onSdInternalEvent(sd_event_source */*s*/, int /*fd*/, uint32_t /*revents*/, void *userdata)
+void Connection::enableHandlerProfiling(bool enabled)
 {
-    auto connection = static_cast<Connection*>(userdata);
-    assert(connection != nullptr);
+    handlerProfiler_.enable(enabled);
+}
 
-    // It's not really necessary to processPendingEvent() here. We just clear the event fd.
+void Connection::setSlowHandlerWatchdog(SlowHandlerWatchdog watchdog)
+{
+    handlerProfiler_.setWatchdog(std::move(watchdog));
+}
+
+std::vector<IConnection::HandlerProfile> Connection::getHandlerProfiles() const
+{
+    return handlerProfiler_.getProfiles();
+}
+
+void Connection::resetHandlerProfiles()
+{
+    handlerProfiler_.reset();
+}
+
+Slot Connection::exposeHandlerProfiles(const ObjectPath& objectPath, return_slot_t)
+{
+    using HandlerStats = std::vector<Struct<std::string, std::string, std::string, std::string, uint64_t, uint64_t, uint64_t, uint64_t, std::vector<uint64_t>>>;
+
+    auto object = std::make_unique<Object>(*this, objectPath);
+    object->addVTable( InterfaceName{DEBUG_STATS_INTERFACE_NAME}
+                     , { registerMethod("GetHandlerStats").withOutputParamNames("stats").implementedAs([this]()
+                         {
+                             HandlerStats stats;
+                             for (const auto& profile : handlerProfiler_.getProfiles())
+                             {
+                                 stats.emplace_back( toString(profile.kind)
+                                                   , profile.objectPath
+                                                   , profile.interfaceName
+                                                   , profile.memberName
+                                                   , profile.duration.count
+                                                   , static_cast<uint64_t>(profile.duration.sum.count())
+                                                   , static_cast<uint64_t>(profile.maxDuration.count())
+                                                   , profile.overBudgetCount
+                                                   , std::vector<uint64_t>(profile.duration.buckets.begin(), profile.duration.buckets.end()) );
+                             }
+                             return stats;
+                         })
+                       , registerMethod("Reset").implementedAs([this](){ handlerProfiler_.reset(); }) } );
+
+    return {object.release(), [](void *object){ delete static_cast<Object*>(object); }};
+}
+
+void Connection::enableStartupProfiling(bool enabled)
+{
+    startupProfiler_.enable(enabled);
+}
+
+IConnection::StartupProfile Connection::getStartupProfile() const
+{
+    return startupProfiler_.getProfile();
+}
+
+void Connection::setTracer(std::shared_ptr<ITracer> tracer)
+{
+    {
+        std::lock_guard lock(tracerMutex_);
+        tracer_.swap(tracer);
+        tracerPtr_.store(tracer_.get(), std::memory_order_relaxed);
+    }
+    // The previous tracer goes away here, unless spans still in flight hold it
+}
+
+Slot Connection::captureTraffic(const std::string& filePath, return_slot_t)
+{
+    auto capture = std::unique_ptr<TrafficCaptureInfo>(new TrafficCaptureInfo{TrafficRecorder{filePath}, *this, Slot{}});
+
+    sd_bus_slot *slot{};
+    auto r = sdbus_->sd_bus_add_filter(bus_.get(), &slot, &Connection::sdbus_traffic_capture_filter, capture.get());
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to add traffic capture filter", -r);
+
+    capture->slot = {slot, [this](void *slot){ sdbus_->sd_bus_slot_unref((sd_bus_slot*)slot); }};
+
+    return {capture.release(), [](void *ptr){ delete static_cast<TrafficCaptureInfo*>(ptr); }};
+}
+
+MetricsCollector& Connection::getMetricsCollector()
+{
+    return metrics_;
+}
+
+HandlerProfiler& Connection::getHandlerProfiler()
+{
+    return handlerProfiler_;
+}
+
+StartupProfiler& Connection::getStartupProfiler()
+{
+    return startupProfiler_;
+}
+
+std::shared_ptr<ITracer> Connection::getTracer() const
+{
+    if (tracerPtr_.load(std::memory_order_relaxed) == nullptr)
+        return {};
+
+    std::lock_guard lock(tracerMutex_);
+    return tracer_;
+}
+
+void Connection::setMemoryResource(std::pmr::memory_resource* resource)
+{
+    if (resource == nullptr)
+        memoryResource_ = defaultMemoryResource_;
+    else
+        memoryResource_ = std::shared_ptr<std::pmr::memory_resource>(resource, [](std::pmr::memory_resource*){}); // Not owned
+}
+
+const std::shared_ptr<std::pmr::memory_resource>& Connection::getMemoryResource() const
+{
+    return memoryResource_;
+}
+
+void Connection::addMatch(const std::string& match, message_handler callback)
+{
+    auto slot = addMatch(match, std::move(callback), return_slot);
+
+    std::lock_guard lock(floatingMatchRulesMutex_);
+    floatingMatchRules_.push_back(std::move(slot));
+}
+
+Slot Connection::addMatch(const std::string& match, message_handler callback, return_slot_t)
+{
+    SDBUS_THROW_ERROR_IF(!callback, "Invalid match callback handler provided", EINVAL);
+
+    auto matchInfo = makePooled<MatchInfo>(*memoryResource_, std::move(callback), message_handler{}, *this, Slot{});
+
+    sd_bus_slot *slot{};
+    auto r = startupProfiler_.measure(StartupPhase::SignalMatchInstallation, {}, [&]
+    {
+        return sdbus_->sd_bus_add_match(bus_.get(), &slot, match.c_str(), &Connection::sdbus_match_callback, matchInfo.get());
+    });
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to add match", -r);
+
+    matchInfo->slot = {slot, [this](void *slot){ sdbus_->sd_bus_slot_unref((sd_bus_slot*)slot); }};
+
+    return {matchInfo.release(), [deleter = matchInfo.get_deleter()](void *ptr){ deleter(static_cast<MatchInfo*>(ptr)); }};
+}
+
+void Connection::addMatchAsync(const std::string& match, message_handler callback, message_handler installCallback)
+{
+    auto slot = addMatchAsync(match, std::move(callback), std::move(installCallback), return_slot);
+
+    std::lock_guard lock(floatingMatchRulesMutex_);
+    floatingMatchRules_.push_back(std::move(slot));
+}
+
+Slot Connection::addMatchAsync( const std::string& match
+                              , message_handler callback
+                              , message_handler installCallback
+                              , return_slot_t )
+{
+    SDBUS_THROW_ERROR_IF(!callback, "Invalid match callback handler provided", EINVAL);
+
+    sd_bus_message_handler_t sdbusInstallCallback = installCallback ? &Connection::sdbus_match_install_callback : nullptr;
+    auto matchInfo = makePooled<MatchInfo>(*memoryResource_, std::move(callback), std::move(installCallback), *this, Slot{});
+
+    sd_bus_slot *slot{};
+    auto r = sdbus_->sd_bus_add_match_async( bus_.get()
+                                           , &slot
+                                           , match.c_str()
+                                           , &Connection::sdbus_match_callback
+                                           , sdbusInstallCallback
+                                           , matchInfo.get());
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to add match", -r);
+
+    matchInfo->slot = {slot, [this](void *slot){ sdbus_->sd_bus_slot_unref((sd_bus_slot*)slot); }};
+
+    return {matchInfo.release(), [deleter = matchInfo.get_deleter()](void *ptr){ deleter(static_cast<MatchInfo*>(ptr)); }};
+}
+
+void Connection::attachSdEventLoop(sd_event *event, int priority)
+{
+#ifndef SDBUS_basu
+    auto pollData = getEventLoopPollData();
+
+    auto sdEvent = createSdEventSlot(event);
+    auto sdTimeEventSource = createSdTimeEventSourceSlot(event, priority);
+    auto sdIoEventSource = createSdIoEventSourceSlot(event, pollData.fd, priority);
+    auto sdInternalEventSource = createSdInternalEventSourceSlot(event, pollData.eventFd, priority);
+
+    sdEvent_ = std::make_unique<SdEvent>(SdEvent{ std::move(sdEvent)
+                                                , std::move(sdTimeEventSource)
+                                                , std::move(sdIoEventSource)
+                                                , std::move(sdInternalEventSource) });
+#else
+    (void)event;
+    (void)priority;
+    SDBUS_THROW_ERROR("sd_event integration is not supported on this platform", EOPNOTSUPP);
+#endif
+}
+
+void Connection::detachSdEventLoop()
+{
+    sdEvent_.reset();
+}
+
+sd_event *Connection::getSdEventLoop()
+{
+    return sdEvent_ ? static_cast<sd_event*>(sdEvent_->sdEvent.get()) : nullptr;
+}
+
+#ifndef SDBUS_basu
+
+Slot Connection::createSdEventSlot(sd_event *event)
+{
+    // Get default event if no event is provided by the caller
+    if (event != nullptr)
+        event = sd_event_ref(event);
+    else
+        (void)sd_event_default(&event);
+    SDBUS_THROW_ERROR_IF(!event, "Invalid sd_event handle", EINVAL);
+
+    return Slot{event, [](void* event){ sd_event_unref((sd_event*)event); }};
+}
+
+Slot Connection::createSdTimeEventSourceSlot(sd_event *event, int priority)
+{
+    sd_event_source *timeEventSource{};
+    auto r = sd_event_add_time(event, &timeEventSource, CLOCK_MONOTONIC, 0, 0, onSdTimerEvent, this);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to add timer event", -r);
+    Slot sdTimeEventSource{timeEventSource, [](void* source){ deleteSdEventSource((sd_event_source*)source); }};
+
+    r = sd_event_source_set_priority(timeEventSource, priority);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to set time event priority", -r);
+
+    r = sd_event_source_set_description(timeEventSource, "bus-time");
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to set time event description", -r);
+
+    return sdTimeEventSource;
+}
+
+Slot Connection::createSdIoEventSourceSlot(sd_event *event, int fd, int priority)
+{
+    sd_event_source *ioEventSource{};
+    auto r = sd_event_add_io(event, &ioEventSource, fd, 0, onSdIoEvent, this);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to add io event", -r);
+    Slot sdIoEventSource{ioEventSource, [](void* source){ deleteSdEventSource((sd_event_source*)source); }};
+
+    r = sd_event_source_set_prepare(ioEventSource, onSdEventPrepare);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to set prepare callback for IO event", -r);
+
+    r = sd_event_source_set_priority(ioEventSource, priority);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to set priority for IO event", -r);
+
+    r = sd_event_source_set_description(ioEventSource, "bus-input");
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to set priority for IO event", -r);
+
+    return sdIoEventSource;
+}
+
+Slot Connection::createSdInternalEventSourceSlot(sd_event *event, int fd, int priority)
+{
+    sd_event_source *internalEventSource{};
+    auto r = sd_event_add_io(event, &internalEventSource, fd, 0, onSdInternalEvent, this);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to add internal event", -r);
+    Slot sdInternalEventSource{internalEventSource, [](void* source){ deleteSdEventSource((sd_event_source*)source); }};
+
+    // sd-event loop calls prepare callbacks for all event sources, not just for the one that fired now.
+    // So since onSdEventPrepare is already registered on ioEventSource, we don't need to duplicate it here.
+    //r = sd_event_source_set_prepare(internalEventSource, onSdEventPrepare);
+    //SDBUS_THROW_ERROR_IF(r < 0, "Failed to set prepare callback for internal event", -r);
+
+    r = sd_event_source_set_priority(internalEventSource, priority);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to set priority for internal event", -r);
+
+    r = sd_event_source_set_description(internalEventSource, "internal-event");
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to set priority for IO event", -r);
+
+    return sdInternalEventSource;
+}
+
+int Connection::onSdTimerEvent(sd_event_source */*s*/, uint64_t /*usec*/, void *userdata)
+{
+    auto connection = static_cast<Connection*>(userdata);
+    assert(connection != nullptr);
+
+    (void)connection->processPendingEvent();
+
+    return 1;
+}
+
+int Connection::onSdIoEvent(sd_event_source */*s*/, int /*fd*/, uint32_t /*revents*/, void *userdata)
+{
+    auto connection = static_cast<Connection*>(userdata);
+    assert(connection != nullptr);
+
+    (void)connection->processPendingEvent();
+
+    return 1;
+}
+
+int Connection::onSdInternalEvent(sd_event_source */*s*/, int /*fd*/, uint32_t /*revents*/, void *userdata)
+{
+    auto connection = static_cast<Connection*>(userdata);
+    assert(connection != nullptr);
+
+    // It's not really necessary to processPendingEvent() here. We just clear the event fd.
     // The sd-event loop will before the next poll call prepare callbacks for all event sources,
     // including I/O bus fd. This will get up-to-date poll timeout, which will be zero if there
     // are pending D-Bus messages in the read queue, which will immediately wake up next poll
@@ -400,314 +1085,2068 @@ int Connection::onSdInternalEvent(sd_event_source */*s*/, int /*fd*/, uint32_t /
     // the solution is simpler for clients -- we don't provide an extra method for just clearing
     // the event fd. There is one method for both fd's -- and that's processPendingEvent().
 
-    // Kept here so that potential readers know what to do in their custom external event loops.
-    //(void)connection->processPendingEvent();
+    // Kept here so that potential readers know what to do in their custom external event loops.
+    //(void)connection->processPendingEvent();
+
+    connection->eventFd_.clear();
+
+    return 1;
+}
+
+int Connection::onSdEventPrepare(sd_event_source */*s*/, void *userdata)
+{
+    auto connection = static_cast<Connection*>(userdata);
+    assert(connection != nullptr);
+
+    auto sdbusPollData = connection->getEventLoopPollData();
+
+    // Set poll events to watch out for on I/O fd
+    auto* sdIoEventSource = static_cast<sd_event_source*>(connection->sdEvent_->sdIoEventSource.get());
+    auto r = sd_event_source_set_io_events(sdIoEventSource, sdbusPollData.events);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to set poll events for IO event source", -r);
+
+    // Set poll events to watch out for on internal event fd
+    auto* sdInternalEventSource = static_cast<sd_event_source*>(connection->sdEvent_->sdInternalEventSource.get());
+    r = sd_event_source_set_io_events(sdInternalEventSource, POLLIN);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to set poll events for internal event source", -r);
+
+    // Set current timeout to the time event source (it may be zero if there are messages in the sd-bus queues to be processed)
+    auto* sdTimeEventSource = static_cast<sd_event_source*>(connection->sdEvent_->sdTimeEventSource.get());
+    r = sd_event_source_set_time(sdTimeEventSource, static_cast<uint64_t>(sdbusPollData.timeout.count()));
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to set timeout for time event source", -r);
+    // In case the timeout is infinite, we disable the timer in the sd_event loop.
+    // This prevents a syscall error, where `timerfd_settime` returns `EINVAL`,
+    // because the value is too big. See #324 for details
+    r = sd_event_source_set_enabled(sdTimeEventSource, sdbusPollData.timeout != sdbusPollData.timeout.max() ? SD_EVENT_ONESHOT : SD_EVENT_OFF);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to enable time event source", -r);
+
+    return 1;
+}
+
+void Connection::deleteSdEventSource(sd_event_source *s)
+{
+#if LIBSYSTEMD_VERSION>=243
+    sd_event_source_disable_unref(s);
+#else
+    sd_event_source_set_enabled(s, SD_EVENT_OFF);
+    sd_event_source_unref(s);
+#endif
+}
+
+#endif // SDBUS_basu
+
+Slot Connection::addObjectVTable( const ObjectPath& objectPath
+                                , const InterfaceName& interfaceName
+                                , const sd_bus_vtable* vtable
+                                , void* userData
+                                , return_slot_t )
+{
+    sd_bus_slot *slot{};
+
+    auto r = startupProfiler_.measure(StartupPhase::VTableRegistration, objectPath, [&]
+    {
+        return sdbus_->sd_bus_add_object_vtable( bus_.get()
+                                               , &slot
+                                               , objectPath.c_str()
+                                               , interfaceName.c_str()
+                                               , vtable
+                                               , userData );
+    });
+
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to register object vtable", -r);
+
+    introspectionCache_.addVTable(objectPath, slot, interfaceName, vtable);
+    managedObjectsCache_.addVTable(objectPath, slot, interfaceName, vtable, userData);
+
+    return {slot, [this, objectPath](void *slot)
+    {
+        introspectionCache_.remove(objectPath, slot);
+        managedObjectsCache_.remove(objectPath, slot);
+        sdbus_->sd_bus_slot_unref((sd_bus_slot*)slot);
+    }};
+}
+
+std::vector<Slot> Connection::addObjectVTables(std::span<const ObjectVTable> vtables, return_slot_t)
+{
+    std::vector<ISdBus::ObjectVTable> sdbusVTables;
+    sdbusVTables.reserve(vtables.size());
+
+    // One InterfacesAdded signal per object path, in the order of first appearance of the path
+    std::vector<const char*> paths;
+    std::vector<std::vector<char*>> interfaces;
+    std::unordered_map<std::string_view, std::size_t> pathIndices;
+
+    for (const auto& vtable : vtables)
+    {
+        sdbusVTables.push_back({vtable.objectPath.c_str(), vtable.interfaceName.c_str(), vtable.vtable, vtable.userData});
+
+        auto [it, inserted] = pathIndices.try_emplace(vtable.objectPath, paths.size());
+        if (inserted)
+        {
+            paths.push_back(vtable.objectPath.c_str());
+            interfaces.emplace_back();
+        }
+
+        auto& objectInterfaces = interfaces[it->second];
+        auto* interfaceName = const_cast<char*>(vtable.interfaceName.c_str());
+        if (std::none_of(objectInterfaces.begin(), objectInterfaces.end(), [=](const char* name){ return std::strcmp(name, interfaceName) == 0; }))
+            objectInterfaces.push_back(interfaceName);
+    }
+
+    std::vector<char**> interfaceLists;
+    interfaceLists.reserve(interfaces.size());
+    for (auto& objectInterfaces : interfaces)
+    {
+        objectInterfaces.push_back(nullptr);
+        interfaceLists.push_back(objectInterfaces.data());
+    }
+
+    std::vector<sd_bus_slot*> sdbusSlots(vtables.size());
+
+    auto r = startupProfiler_.measure(StartupPhase::VTableRegistration, {}, [&]
+    {
+        return sdbus_->sd_bus_add_objects( bus_.get()
+                                         , sdbusVTables.data()
+                                         , sdbusSlots.data()
+                                         , sdbusVTables.size()
+                                         , paths.data()
+                                         , interfaceLists.data()
+                                         , paths.size() );
+    });
+
+    // Slots of vtables registered before a failure are released when leaving, together with the returned slots
+    std::vector<Slot> slots;
+    slots.reserve(sdbusSlots.size());
+    for (std::size_t i = 0; i < sdbusSlots.size(); ++i)
+    {
+        if (sdbusSlots[i] != nullptr)
+        {
+            introspectionCache_.addVTable(vtables[i].objectPath, sdbusSlots[i], vtables[i].interfaceName, vtables[i].vtable);
+            managedObjectsCache_.addVTable(vtables[i].objectPath, sdbusSlots[i], vtables[i].interfaceName, vtables[i].vtable, vtables[i].userData);
+        }
+        slots.emplace_back(sdbusSlots[i], [this, objectPath = vtables[i].objectPath](void *slot)
+        {
+            introspectionCache_.remove(objectPath, slot);
+            managedObjectsCache_.remove(objectPath, slot);
+            sdbus_->sd_bus_slot_unref((sd_bus_slot*)slot);
+        });
+    }
+
+    // One wake-up for all the signals, for the event loop to continue dispatching what hasn't yet been fully sent
+    wakeUpEventLoopIfMessagesInQueue();
+
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to register objects", -r);
+
+    return slots;
+}
+
+void Connection::removeObjects(std::span<const char* const> objectPaths, std::span<sd_bus_slot* const> slots)
+{
+    introspectionCache_.remove(objectPaths, slots);
+    for (const auto* objectPath : objectPaths)
+        managedObjectsCache_.remove(objectPath, slots);
+
+    auto r = sdbus_->sd_bus_remove_objects(bus_.get(), objectPaths.data(), objectPaths.size(), slots.data(), slots.size());
+
+    wakeUpEventLoopIfMessagesInQueue();
+
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to emit InterfacesRemoved signals", -r);
+}
+
+Slot Connection::addFallbackVTable( const ObjectPath& prefix
+                                  , const InterfaceName& interfaceName
+                                  , const sd_bus_vtable* vtable
+                                  , sd_bus_object_find_t find
+                                  , void* userData
+                                  , return_slot_t )
+{
+    sd_bus_slot *slot{};
+
+    auto r = startupProfiler_.measure(StartupPhase::VTableRegistration, prefix, [&]
+    {
+        return sdbus_->sd_bus_add_fallback_vtable( bus_.get()
+                                                 , &slot
+                                                 , prefix.c_str()
+                                                 , interfaceName.c_str()
+                                                 , vtable
+                                                 , find
+                                                 , userData );
+    });
+
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to register fallback vtable", -r);
+
+    introspectionCache_.addSubtreeRegistration(prefix, slot);
+    managedObjectsCache_.addSubtreeRegistration(prefix, slot);
+
+    return {slot, [this, prefix](void *slot)
+    {
+        introspectionCache_.remove(prefix, slot);
+        managedObjectsCache_.remove(prefix, slot);
+        sdbus_->sd_bus_slot_unref((sd_bus_slot*)slot);
+    }};
+}
+
+Slot Connection::addNodeEnumerator( const ObjectPath& prefix
+                                  , sd_bus_node_enumerator_t callback
+                                  , void* userData
+                                  , return_slot_t )
+{
+    sd_bus_slot *slot{};
+
+    auto r = sdbus_->sd_bus_add_node_enumerator(bus_.get(), &slot, prefix.c_str(), callback, userData);
+
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to register node enumerator", -r);
+
+    introspectionCache_.addSubtreeRegistration(prefix, slot);
+    managedObjectsCache_.addSubtreeRegistration(prefix, slot);
+
+    return {slot, [this, prefix](void *slot)
+    {
+        introspectionCache_.remove(prefix, slot);
+        managedObjectsCache_.remove(prefix, slot);
+        sdbus_->sd_bus_slot_unref((sd_bus_slot*)slot);
+    }};
+}
+
+Slot Connection::addFallbackHandler( const ObjectPath& prefix
+                                   , sd_bus_message_handler_t callback
+                                   , void* userData
+                                   , return_slot_t )
+{
+    sd_bus_slot *slot{};
+
+    auto r = sdbus_->sd_bus_add_fallback(bus_.get(), &slot, prefix.c_str(), callback, userData);
+
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to register fallback handler", -r);
+
+    return {slot, [this](void *slot){ sdbus_->sd_bus_slot_unref((sd_bus_slot*)slot); }};
+}
+
+PlainMessage Connection::createPlainMessage() const
+{
+    sd_bus_message* sdbusMsg{};
+
+    auto r = sdbus_->sd_bus_message_new(bus_.get(), &sdbusMsg, _SD_BUS_MESSAGE_TYPE_INVALID);
+
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to create a plain message", -r);
+
+    return Message::Factory::create<PlainMessage>(sdbusMsg, const_cast<Connection*>(this), adopt_message);
+}
+
+MethodCall Connection::createMethodCall( const ServiceName& destination
+                                       , const ObjectPath& objectPath
+                                       , const InterfaceName& interfaceName
+                                       , const MethodName& methodName ) const
+{
+    return Connection::createMethodCall(destination.c_str(), objectPath.c_str(), interfaceName.c_str(), methodName.c_str());
+}
+
+MethodCall Connection::createMethodCall( const char* destination
+                                       , const char* objectPath
+                                       , const char* interfaceName
+                                       , const char* methodName ) const
+{
+    std::string owner;
+    if (*destination != ':' && hasWatchedNames_.load(std::memory_order_relaxed) && resolveWatchedName(destination, owner))
+        destination = owner.c_str();
+
+    sd_bus_message *sdbusMsg{};
+
+    auto r = sdbus_->sd_bus_message_new_method_call( bus_.get()
+                                                   , &sdbusMsg
+                                                   , !*destination ? nullptr : destination
+                                                   , objectPath
+                                                   , interfaceName
+                                                   , methodName);
+
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to create method call", -r);
+
+    return Message::Factory::create<MethodCall>(sdbusMsg, const_cast<Connection*>(this), adopt_message);
+}
+
+Signal Connection::createSignal( const ObjectPath& objectPath
+                               , const InterfaceName& interfaceName
+                               , const SignalName& signalName ) const
+{
+    return Connection::createSignal(objectPath.c_str(), interfaceName.c_str(), signalName.c_str());
+}
+
+Signal Connection::createSignal( const char* objectPath
+                               , const char* interfaceName
+                               , const char* signalName ) const
+{
+    sd_bus_message *sdbusMsg{};
+
+    auto r = sdbus_->sd_bus_message_new_signal(bus_.get(), &sdbusMsg, objectPath, interfaceName, signalName);
+
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to create signal", -r);
+
+    return Message::Factory::create<Signal>(sdbusMsg, const_cast<Connection*>(this), adopt_message);
+}
+
+void Connection::emitPropertiesChangedSignal( const ObjectPath& objectPath
+                                            , const InterfaceName& interfaceName
+                                            , const std::vector<PropertyName>& propNames )
+{
+    Connection::emitPropertiesChangedSignal(objectPath.c_str(), interfaceName.c_str(), propNames);
+}
+
+void Connection::emitPropertiesChangedSignal( const char* objectPath
+                                            , const char* interfaceName
+                                            , const std::vector<PropertyName>& propNames )
+{
+    // Values are re-read on the next GetManagedObjects call, even if the signal itself gets dropped
+    invalidateManagedObjects(objectPath, interfaceName);
+
+    auto admission = admitSignal(true);
+    if (admission == SignalAdmission::Drop)
+        return;
+    if (admission == SignalAdmission::Defer && deferPropertiesChange(objectPath, interfaceName, propNames))
+        return;
+
+    doEmitPropertiesChangedSignal(objectPath, interfaceName, propNames);
+}
+
+void Connection::doEmitPropertiesChangedSignal( const char* objectPath
+                                              , const char* interfaceName
+                                              , const std::vector<PropertyName>& propNames )
+{
+    auto names = to_strv(propNames);
+
+    auto r = sdbus_->sd_bus_emit_properties_changed_strv( bus_.get()
+                                                        , objectPath
+                                                        , interfaceName
+                                                        , propNames.empty() ? nullptr : &names[0] );
+
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to emit PropertiesChanged signal", -r);
+}
+
+void Connection::emitInterfacesAddedSignal(const ObjectPath& objectPath)
+{
+    invalidateManagedObjects(objectPath);
+
+    auto r = sdbus_->sd_bus_emit_object_added(bus_.get(), objectPath.c_str());
+
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to emit InterfacesAdded signal for all registered interfaces", -r);
+}
+
+void Connection::emitInterfacesAddedSignal( const ObjectPath& objectPath
+                                          , const std::vector<InterfaceName>& interfaces )
+{
+    for (const auto& interfaceName : interfaces)
+        invalidateManagedObjects(objectPath, interfaceName);
+    if (interfaces.empty())
+        invalidateManagedObjects(objectPath);
+
+    auto names = to_strv(interfaces);
+
+    auto r = sdbus_->sd_bus_emit_interfaces_added_strv( bus_.get()
+                                                      , objectPath.c_str()
+                                                      , interfaces.empty() ? nullptr : &names[0] );
+
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to emit InterfacesAdded signal", -r);
+}
+
+void Connection::emitInterfacesRemovedSignal(const ObjectPath& objectPath)
+{
+    invalidateManagedObjects(objectPath);
+
+    auto r = sdbus_->sd_bus_emit_object_removed(bus_.get(), objectPath.c_str());
+
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to emit InterfacesRemoved signal for all registered interfaces", -r);
+}
+
+void Connection::emitInterfacesRemovedSignal( const ObjectPath& objectPath
+                                            , const std::vector<InterfaceName>& interfaces )
+{
+    for (const auto& interfaceName : interfaces)
+        invalidateManagedObjects(objectPath, interfaceName);
+    if (interfaces.empty())
+        invalidateManagedObjects(objectPath);
+
+    auto names = to_strv(interfaces);
+
+    auto r = sdbus_->sd_bus_emit_interfaces_removed_strv( bus_.get()
+                                                        , objectPath.c_str()
+                                                        , interfaces.empty() ? nullptr : &names[0] );
+
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to emit InterfacesRemoved signal", -r);
+}
+
+Slot Connection::registerSignalHandler( const char* sender
+                                      , const char* objectPath
+                                      , const char* interfaceName
+                                      , const char* signalName
+                                      , sd_bus_message_handler_t callback
+                                      , sd_bus_message_handler_t installCallback
+                                      , void* userData
+                                      , return_slot_t )
+{
+    sd_bus_slot *slot{};
+
+    auto r = installCallback == nullptr
+           ? sdbus_->sd_bus_match_signal( bus_.get()
+                                        , &slot
+                                        , !*sender ? nullptr : sender
+                                        , !*objectPath ? nullptr : objectPath
+                                        , !*interfaceName ? nullptr : interfaceName
+                                        , !*signalName ? nullptr : signalName
+                                        , callback
+                                        , userData )
+           : sdbus_->sd_bus_match_signal_async( bus_.get()
+                                              , &slot
+                                              , !*sender ? nullptr : sender
+                                              , !*objectPath ? nullptr : objectPath
+                                              , !*interfaceName ? nullptr : interfaceName
+                                              , !*signalName ? nullptr : signalName
+                                              , callback
+                                              , installCallback
+                                              , userData );
+
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to register signal handler", -r);
+
+    return {slot, [this](void *slot){ sdbus_->sd_bus_slot_unref((sd_bus_slot*)slot); }};
+}
+
+namespace {
+    // Values of match rules are quoted with apostrophes, and an apostrophe itself can only be escaped outside of quotes
+    void appendMatchRuleItem(std::string& rule, std::string_view key, std::string_view value)
+    {
+        rule += ',';
+        rule += key;
+        rule += "='";
+        for (auto c : value)
+        {
+            if (c == '\'')
+                rule += "'\\''";
+            else
+                rule += c;
+        }
+        rule += '\'';
+    }
+}
+
+Slot Connection::registerSignalHandler( const char* sender
+                                      , const char* objectPath
+                                      , const char* interfaceName
+                                      , const char* signalName
+                                      , const std::vector<SignalArgFilter>& argFilters
+                                      , sd_bus_message_handler_t callback
+                                      , sd_bus_message_handler_t installCallback
+                                      , void* userData
+                                      , return_slot_t )
+{
+    std::string match{"type='signal'"};
+    if (*sender)
+        appendMatchRuleItem(match, "sender", sender);
+    if (*objectPath)
+        appendMatchRuleItem(match, "path", objectPath);
+    if (*interfaceName)
+        appendMatchRuleItem(match, "interface", interfaceName);
+    if (*signalName)
+        appendMatchRuleItem(match, "member", signalName);
+    for (const auto& filter : argFilters)
+    {
+        SDBUS_THROW_ERROR_IF(filter.index > 63, "Invalid signal argument filter index provided", EINVAL);
+        SDBUS_THROW_ERROR_IF( filter.kind == SignalArgFilter::Kind::Namespace && filter.index != 0
+                            , "Only the first signal argument can be filtered by namespace"
+                            , EINVAL );
+        switch (filter.kind)
+        {
+            case SignalArgFilter::Kind::Equals: appendMatchRuleItem(match, "arg" + std::to_string(filter.index), filter.value); break;
+            case SignalArgFilter::Kind::Path: appendMatchRuleItem(match, "arg" + std::to_string(filter.index) + "path", filter.value); break;
+            case SignalArgFilter::Kind::Namespace: appendMatchRuleItem(match, "arg0namespace", filter.value); break;
+        }
+    }
+
+    sd_bus_slot *slot{};
+
+    auto r = installCallback == nullptr
+           ? startupProfiler_.measure(StartupPhase::SignalMatchInstallation, {}, [&]
+             {
+                 return sdbus_->sd_bus_add_match(bus_.get(), &slot, match.c_str(), callback, userData);
+             })
+           : sdbus_->sd_bus_add_match_async(bus_.get(), &slot, match.c_str(), callback, installCallback, userData);
+
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to register signal handler", -r);
+
+    return {slot, [this](void *slot){ sdbus_->sd_bus_slot_unref((sd_bus_slot*)slot); }};
+}
+
+sd_bus_message* Connection::incrementMessageRefCount(sd_bus_message* sdbusMsg)
+{
+    return sdbus_->sd_bus_message_ref(sdbusMsg);
+}
+
+sd_bus_message* Connection::decrementMessageRefCount(sd_bus_message* sdbusMsg)
+{
+    return sdbus_->sd_bus_message_unref(sdbusMsg);
+}
+
+int Connection::querySenderCredentials(sd_bus_message* sdbusMsg, uint64_t mask, sd_bus_creds **creds)
+{
+    const char* sender = credentialsCacheEnabled_ ? sdbus_->sd_bus_message_get_sender(sdbusMsg) : nullptr;
+    if (sender == nullptr)
+        return sdbus_->sd_bus_query_sender_creds(sdbusMsg, mask, creds);
+
+    // Creds are (un)ref'd, which takes the bus lock, only outside of the cache mutex (see dropCachedCredentials()).
+    // On a hit, the cache's reference is moved out to the caller, and the entry is put back with a new reference.
+    // Fields cached for the sender are queried anew along with the missing ones, so the entry keeps covering them.
+    {
+        std::unique_lock lock(credentialsCacheMutex_);
+        if (auto it = credentialsCache_.find(sender); it != credentialsCache_.end())
+        {
+            if ((it->second.mask & mask) == mask)
+            {
+                const auto cachedMask = it->second.mask;
+                *creds = it->second.creds;
+                credentialsCache_.erase(it);
+                lock.unlock();
+
+                if (auto* dropped = cacheCredentials(sender, sdbus_->sd_bus_creds_ref(*creds), cachedMask))
+                    sdbus_->sd_bus_creds_unref(dropped);
+                return 0;
+            }
+            mask |= it->second.mask;
+        }
+    }
+
+    auto r = sdbus_->sd_bus_query_sender_creds(sdbusMsg, mask, creds);
+    if (r < 0)
+        return r;
+
+    if (auto* dropped = cacheCredentials(sender, sdbus_->sd_bus_creds_ref(*creds), mask))
+        sdbus_->sd_bus_creds_unref(dropped);
+
+    return r;
+}
+
+sd_bus_creds* Connection::cacheCredentials(const char* sender, sd_bus_creds* creds, uint64_t mask)
+{
+    // Returns the reference the cache has dropped to make room for the new one, for the caller to unref unlocked
+    std::lock_guard lock(credentialsCacheMutex_);
+    if (auto it = credentialsCache_.find(sender); it != credentialsCache_.end())
+        return std::exchange(it->second, CachedCredentials{creds, mask}).creds;
+
+    sd_bus_creds* dropped{};
+    if (credentialsCache_.size() >= MAX_CACHED_CREDENTIALS)
+    {
+        dropped = credentialsCache_.begin()->second.creds;
+        credentialsCache_.erase(credentialsCache_.begin());
+    }
+    credentialsCache_.emplace(sender, CachedCredentials{creds, mask});
+
+    return dropped;
+}
+
+sd_bus_creds* Connection::incrementCredsRefCount(sd_bus_creds* creds)
+{
+    return sdbus_->sd_bus_creds_ref(creds);
+}
+
+sd_bus_creds* Connection::decrementCredsRefCount(sd_bus_creds* creds)
+{
+    return sdbus_->sd_bus_creds_unref(creds);
+}
+
+sd_bus_message* Connection::callMethod(sd_bus_message* sdbusMsg, uint64_t timeout)
+{
+    timeout = applyCallDeadline(timeout);
+
+    sd_bus_error sdbusError = SD_BUS_ERROR_NULL;
+    SCOPE_EXIT{ sd_bus_error_free(&sdbusError); };
+
+    sd_bus_message* sdbusReply{};
+    auto r = doCallMethod(sdbusMsg, timeout, &sdbusError, &sdbusReply);
+
+    if (sd_bus_error_is_set(&sdbusError))
+        throw Error(Error::Name{sdbusError.name}, sdbusError.message);
+
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to call method", -r);
+
+    return sdbusReply;
+}
+
+int Connection::callMethod(sd_bus_message* sdbusMsg, uint64_t timeout, sd_bus_error* sdbusError, sd_bus_message** sdbusReply)
+{
+    auto clampedTimeout = clampToCallDeadline(timeout);
+    if (!clampedTimeout)
+        return -ETIMEDOUT;
+
+    return doCallMethod(sdbusMsg, *clampedTimeout, sdbusError, sdbusReply);
+}
+
+int Connection::doCallMethod(sd_bus_message* sdbusMsg, uint64_t timeout, sd_bus_error* sdbusError, sd_bus_message** sdbusReply)
+{
+    if (localDispatchEnabled_.load(std::memory_order_relaxed))
+    {
+        LocalSyncCall syncCall;
+        if (auto cookie = dispatchMethodCallLocally(sdbusMsg, LocalCallWaiter{nullptr, &syncCall, nullptr}))
+            return awaitLocalReply(sdbusMsg, *cookie, syncCall, timeout, sdbusError, sdbusReply);
+    }
+
+    // With the event loop running in its own thread, the reply is received by that thread, and the bus connection
+    // keeps serving other messages, including replies to concurrent calls from other threads, in the meantime.
+    // The event loop thread itself can't wait for the reply that way, so it falls back to the blocking call below.
+    const auto loopThreadId = asyncLoopThreadId_.load(std::memory_order_relaxed);
+    if (loopThreadId != std::thread::id{} && loopThreadId != std::this_thread::get_id())
+        return doCallMethodViaEventLoop(sdbusMsg, timeout, sdbusError, sdbusReply);
+
+    // This call will block the bus connection from serving other messages
+    // until the reply arrives or the call times out.
+    auto r = sdbus_->sd_bus_call(nullptr, sdbusMsg, timeout, sdbusError, sdbusReply);
+
+    // Wake up event loop to process messages that may have arrived in the meantime,
+    // or to dispatch the outbound message that hasn't yet been fully sent out.
+    if (r >= 0)
+        wakeUpEventLoopIfMessagesInQueue();
+
+    return r;
+}
+
+int Connection::doCallMethodViaEventLoop(sd_bus_message* sdbusMsg, uint64_t timeout, sd_bus_error* sdbusError, sd_bus_message** sdbusReply)
+{
+    if (timeout == 0)
+        timeout = getMethodCallTimeout();
+
+    SyncCall syncCall{{}, {}, nullptr, *this};
+    {
+        // The loop thread may have exited since the caller checked, in which case the call is made directly
+        std::unique_lock lock(syncCallsViaEventLoopMutex_);
+        if (asyncLoopThreadId_.load(std::memory_order_relaxed) == std::thread::id{})
+        {
+            lock.unlock();
+            auto r = sdbus_->sd_bus_call(nullptr, sdbusMsg, timeout, sdbusError, sdbusReply);
+            if (r >= 0)
+                wakeUpEventLoopIfMessagesInQueue();
+            return r;
+        }
+        syncCallsViaEventLoop_.push_back(&syncCall);
+    }
+    SCOPE_EXIT
+    {
+        std::lock_guard lock(syncCallsViaEventLoopMutex_);
+        std::erase(syncCallsViaEventLoop_, &syncCall);
+    };
+
+    Slot slot;
+    auto r = doCallMethodAsync(sdbusMsg, &Connection::sdbus_sync_call_reply_handler, &syncCall, timeout, slot);
+    if (r < 0)
+        return r;
+
+    {
+        // The event loop times the call out itself, or fails it when it exits
+        std::unique_lock lock(syncCall.mutex);
+        auto isDone = [&](){ return syncCall.reply != nullptr || syncCall.abandoned; };
+        if (timeout < MAX_TRACKED_TIMEOUT)
+            (void)syncCall.cond.wait_for(lock, std::chrono::microseconds(timeout) + std::chrono::seconds(1), isDone);
+        else
+            syncCall.cond.wait(lock, isDone);
+    }
+
+    // Waits for the reply handler to return, if it's still in progress in the event loop thread
+    slot.reset();
+
+    if (syncCall.reply == nullptr && syncCall.abandoned)
+        return sd_bus_error_set(sdbusError, SD_BUS_ERROR_NO_REPLY, "Event loop was left before the method call was replied");
+    if (syncCall.reply == nullptr)
+        return sd_bus_error_set(sdbusError, SD_BUS_ERROR_NO_REPLY, "Method call timed out");
+
+    if (sd_bus_message_is_method_error(syncCall.reply, nullptr))
+    {
+        // Report the error the same way sd_bus_call() does
+        r = sd_bus_error_copy(sdbusError, sd_bus_message_get_error(syncCall.reply));
+        sdbus_->sd_bus_message_unref(syncCall.reply);
+        return r;
+    }
+
+    if (sdbusReply != nullptr)
+        *sdbusReply = syncCall.reply;
+    else
+        sdbus_->sd_bus_message_unref(syncCall.reply);
+
+    return 1;
+}
+
+Slot Connection::callMethodAsync(sd_bus_message* sdbusMsg, sd_bus_message_handler_t callback, void* userData, uint64_t timeout, return_slot_t)
+{
+    Slot slot;
+    auto r = doCallMethodAsync(sdbusMsg, callback, userData, applyCallDeadline(timeout), slot);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to call method asynchronously", -r);
+
+    return slot;
+}
+
+int Connection::doCallMethodAsync(sd_bus_message* sdbusMsg, sd_bus_message_handler_t callback, void* userData, uint64_t timeout, Slot& slot)
+{
+    if (timeout == 0)
+        timeout = getMethodCallTimeout();
+
+    auto asyncCall = makePooled<AsyncCall>(*memoryResource_, callback, userData, *this, *memoryResource_);
+
+    // The call is registered with no timeout in sd-bus. Its timeout is tracked by the connection's timer wheel instead.
+    // The call message is kept for creating the timeout error reply, so it isn't needed for calls with untracked timeouts.
+    // The call, the message reference and the check of the queues are done under one sd-bus lock acquisition.
+    const bool isTimeoutTracked = timeout < MAX_TRACKED_TIMEOUT;
+    uint64_t queuedMessages{};
+    int r{1};
+    if (!callMethodAsyncLocally(sdbusMsg, *asyncCall))
+    {
+        sd_bus_slot *sdbusSlot{};
+        r = sdbus_->sd_bus_call_async_get_n_queued( nullptr
+                                                  , &sdbusSlot
+                                                  , sdbusMsg
+                                                  , &Connection::sdbus_async_call_reply_handler
+                                                  , asyncCall.get()
+                                                  , UINT64_MAX
+                                                  , isTimeoutTracked ? &asyncCall->call : nullptr
+                                                  , &queuedMessages );
+        if (r < 0)
+            return r;
+        asyncCall->slot = sdbusSlot;
+    }
+
+    // An event loop may wait in poll for deadline `t1', while in another thread an async call is made with
+    // deadline `t2'. If `t2' < `t1', then we have to wake up the event loop thread to update its poll timeout.
+    // We also have to wake up the event loop to process the messages that may be in the read/write queues.
+    bool precedesPolledDeadline{};
+    if (isTimeoutTracked)
+    {
+        const auto deadline = now() + std::chrono::microseconds(timeout);
+        std::lock_guard lock(asyncCallTimersMutex_);
+        asyncCallTimers_.schedule(*asyncCall, deadline);
+        precedesPolledDeadline = asyncCallTimers_.nextDeadline() < polledAsyncCallDeadline_.load(std::memory_order_relaxed);
+    }
+    if (precedesPolledDeadline || queuedMessages > 0)
+        notifyEventLoopToWakeUpFromPoll();
+
+    slot = Slot{asyncCall.release(), [this](void *ptr){ releaseAsyncCall(static_cast<AsyncCall*>(ptr)); }};
+
+    return r;
+}
+
+int Connection::callMethodsAsync( sd_bus_message** sdbusMsgs
+                                , const uint64_t* timeouts
+                                , sd_bus_message_handler_t callback
+                                , void** userData
+                                , std::size_t count
+                                , std::vector<Slot>& slots )
+{
+    // Deadlines are applied up front, so an expired deadline fails the batch before any of its calls is made
+    std::vector<uint64_t> effectiveTimeouts(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        effectiveTimeouts[i] = applyCallDeadline(timeouts[i]);
+        if (effectiveTimeouts[i] == 0)
+            effectiveTimeouts[i] = getMethodCallTimeout();
+    }
+
+    // With local dispatch, the calls are made one by one, in order, so that each of them can be dispatched locally
+    if (localDispatchEnabled_.load(std::memory_order_relaxed))
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            Slot slot;
+            auto r = doCallMethodAsync(sdbusMsgs[i], callback, userData[i], effectiveTimeouts[i], slot);
+            if (r < 0)
+                return r;
+            slots.push_back(std::move(slot));
+        }
+        return 1;
+    }
+
+    std::vector<PooledPtr<AsyncCall>> asyncCalls;
+    std::vector<void*> asyncCallPtrs;
+    asyncCalls.reserve(count);
+    asyncCallPtrs.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        asyncCalls.push_back(makePooled<AsyncCall>(*memoryResource_, callback, userData[i], *this, *memoryResource_));
+        asyncCallPtrs.push_back(asyncCalls.back().get());
+    }
+
+    // Like in doCallMethodAsync(), but the calls, the references to their messages and the check of the queues are done
+    // under one sd-bus lock acquisition for the whole batch. All call messages are kept, for simplicity.
+    std::vector<sd_bus_slot*> sdbusSlots(count);
+    std::vector<sd_bus_message*> calls(count);
+    uint64_t queuedMessages{};
+    auto r = sdbus_->sd_bus_call_async_many( nullptr
+                                           , sdbusSlots.data()
+                                           , sdbusMsgs
+                                           , &Connection::sdbus_async_call_reply_handler
+                                           , asyncCallPtrs.data()
+                                           , UINT64_MAX
+                                           , count
+                                           , calls.data()
+                                           , &queuedMessages );
+
+    std::size_t made{};
+    while (made < count && sdbusSlots[made] != nullptr)
+    {
+        asyncCalls[made]->slot = sdbusSlots[made];
+        asyncCalls[made]->call = calls[made];
+        ++made;
+    }
+
+    bool precedesPolledDeadline{};
+    if (made > 0)
+    {
+        const auto callTime = now();
+        std::lock_guard lock(asyncCallTimersMutex_);
+        for (std::size_t i = 0; i < made; ++i)
+            if (effectiveTimeouts[i] < MAX_TRACKED_TIMEOUT)
+                asyncCallTimers_.schedule(*asyncCalls[i], callTime + std::chrono::microseconds(effectiveTimeouts[i]));
+        precedesPolledDeadline = asyncCallTimers_.nextDeadline() < polledAsyncCallDeadline_.load(std::memory_order_relaxed);
+    }
+    if (precedesPolledDeadline || queuedMessages > 0)
+        notifyEventLoopToWakeUpFromPoll();
+
+    slots.reserve(slots.size() + made);
+    for (std::size_t i = 0; i < made; ++i)
+        slots.emplace_back(asyncCalls[i].release(), [this](void *ptr){ releaseAsyncCall(static_cast<AsyncCall*>(ptr)); });
+
+    return r;
+}
+
+uint64_t Connection::applyCallDeadline(uint64_t timeout) const
+{
+    auto clampedTimeout = clampToCallDeadline(timeout);
+    SDBUS_THROW_ERROR_IF(!clampedTimeout, "Deadline of the method call has already passed", ETIMEDOUT);
+
+    return *clampedTimeout;
+}
+
+std::optional<uint64_t> Connection::clampToCallDeadline(uint64_t timeout) const
+{
+    auto deadline = DeadlineScope::current();
+    if (!deadline)
+        return timeout;
+
+    auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(*deadline - std::chrono::steady_clock::now());
+    if (remaining.count() <= 0)
+        return std::nullopt;
+
+    if (timeout == 0)
+        timeout = getMethodCallTimeout();
+
+    return std::min(timeout, static_cast<uint64_t>(remaining.count()));
+}
+
+void Connection::releaseAsyncCall(AsyncCall* asyncCall)
+{
+    // Released from within its own dispatch, which is typical of completed calls
+    if (dispatchedAsyncCall_ == asyncCall)
+    {
+        dispatchedAsyncCall_ = nullptr;
+        freeAsyncCall(asyncCall);
+        return;
+    }
+
+    // Otherwise, the call is handed over to the event loop, which frees released calls in batches. No lock is taken here,
+    // so cancelling many calls doesn't contend for the sd-bus lock with the event loop thread, nor with one another.
+    auto state = asyncCall->state.load(std::memory_order_relaxed);
+    while (state != AsyncCall::State::Dispatching)
+    {
+        if (!asyncCall->state.compare_exchange_weak(state, AsyncCall::State::Released, std::memory_order_acq_rel))
+            continue;
+
+        auto* head = releasedAsyncCalls_.load(std::memory_order_relaxed);
+        do
+            asyncCall->nextReleased = head;
+        while (!releasedAsyncCalls_.compare_exchange_weak(head, asyncCall, std::memory_order_release, std::memory_order_relaxed));
+
+        // Only the first call of a batch needs to wake up the event loop
+        if (head == nullptr)
+            notifyEventLoopToWakeUpFromPoll();
+        return;
+    }
+
+    // The call is being dispatched in another thread right now, so its resources are freed once the dispatch is over
+    freeAsyncCall(asyncCall);
+}
+
+void Connection::freeAsyncCall(AsyncCall* asyncCall)
+{
+    {
+        // Wait for the completion of a timed-out call, or of a local reply, possibly in progress in the event loop thread
+        std::lock_guard expiryLock(asyncCallExpiryMutex_);
+        if (asyncCall->localCookie != 0)
+            abandonLocalCall(asyncCall->localCookie);
+        std::lock_guard lock(asyncCallTimersMutex_);
+        asyncCallTimers_.cancel(*asyncCall);
+    }
+
+    // Release sd-bus resources outside of the locks
+    if (asyncCall->slot != nullptr)
+        sdbus_->sd_bus_slot_unref(asyncCall->slot);
+    if (asyncCall->call != nullptr)
+        sdbus_->sd_bus_message_unref(asyncCall->call);
+    deleteObject(asyncCall->memoryResource, asyncCall);
+}
+
+void Connection::freeReleasedAsyncCalls()
+{
+    if (releasedAsyncCalls_.load(std::memory_order_relaxed) == nullptr)
+        return;
+
+    std::lock_guard expiryLock(asyncCallExpiryMutex_);
+    auto* asyncCall = releasedAsyncCalls_.exchange(nullptr, std::memory_order_acquire);
+
+    std::vector<AsyncCall*> asyncCalls;
+    {
+        std::lock_guard lock(asyncCallTimersMutex_);
+        for (; asyncCall != nullptr; asyncCall = asyncCall->nextReleased)
+        {
+            asyncCallTimers_.cancel(*asyncCall);
+            asyncCalls.push_back(asyncCall);
+        }
+    }
+
+    for (auto* call : asyncCalls)
+        if (call->localCookie != 0)
+            abandonLocalCall(call->localCookie);
+
+    // All the sd-bus resources of the batch are released under one sd-bus lock acquisition
+    std::vector<sd_bus_slot*> slots(asyncCalls.size());
+    std::vector<sd_bus_message*> messages(asyncCalls.size());
+    for (std::size_t i = 0; i < asyncCalls.size(); ++i)
+    {
+        slots[i] = asyncCalls[i]->slot;
+        messages[i] = asyncCalls[i]->call;
+    }
+    sdbus_->sd_bus_unref_many(slots.data(), messages.data(), asyncCalls.size());
+
+    for (auto* call : asyncCalls)
+        deleteObject(call->memoryResource, call);
+}
+
+bool Connection::beginAsyncCallDispatch(AsyncCall& asyncCall)
+{
+    auto expected = AsyncCall::State::Pending;
+    if (!asyncCall.state.compare_exchange_strong(expected, AsyncCall::State::Dispatching, std::memory_order_acquire))
+        return false; // Released by another thread, the call is waiting to be freed
+
+    dispatchedAsyncCall_ = &asyncCall;
+    return true;
+}
+
+void Connection::endAsyncCallDispatch(AsyncCall& asyncCall)
+{
+    // If the handler has released the call, it's been freed already, and only its address is compared here
+    if (std::exchange(dispatchedAsyncCall_, nullptr) == &asyncCall)
+        asyncCall.state.store(AsyncCall::State::Completed, std::memory_order_release);
+}
+
+bool Connection::expireAsyncCalls()
+{
+    std::lock_guard expiryLock(asyncCallExpiryMutex_);
+
+    {
+        std::lock_guard lock(asyncCallTimersMutex_);
+        if (asyncCallTimers_.size() == 0)
+            return false;
+        asyncCallTimers_.advance(now());
+    }
+
+    bool expired{};
+    while (true)
+    {
+        AsyncCall* asyncCall{};
+        {
+            // One call at a time, as the completion of one call may release another one
+            std::lock_guard lock(asyncCallTimersMutex_);
+            asyncCall = static_cast<AsyncCall*>(asyncCallTimers_.popExpired());
+        }
+        if (asyncCall == nullptr)
+            break;
+
+        timeOutAsyncCall(*asyncCall);
+        expired = true;
+    }
+
+    return expired;
+}
+
+void Connection::timeOutAsyncCall(AsyncCall& asyncCall)
+{
+    // The same error sd-bus would reply with, had it tracked the timeout itself
+    const sd_bus_error timeoutError = SD_BUS_ERROR_MAKE_CONST("org.freedesktop.DBus.Error.NoReply", "Method call timed out");
+
+    sd_bus_message* sdbusErrorReply{};
+    auto r = sdbus_->sd_bus_message_new_method_error(asyncCall.call, &sdbusErrorReply, &timeoutError);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to create method call timeout error reply", -r);
+    SCOPE_EXIT{ sdbus_->sd_bus_message_unref(sdbusErrorReply); };
+
+    if (!beginAsyncCallDispatch(asyncCall))
+        return; // Released by another thread, the call is waiting to be freed
+
+    // Cancel the call on the sd-bus side, so that a late reply is dropped
+    sdbus_->sd_bus_slot_unref(std::exchange(asyncCall.slot, nullptr));
+
+    // The reply handler may release the call, so it must not be touched anymore after the invocation
+    sd_bus_error sdbusError = SD_BUS_ERROR_NULL;
+    SCOPE_EXIT{ sd_bus_error_free(&sdbusError); };
+    asyncCall.callback(sdbusErrorReply, asyncCall.userData, &sdbusError);
+    endAsyncCallDispatch(asyncCall);
+}
+
+int Connection::sdbus_async_call_reply_handler(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError)
+{
+    auto* asyncCall = static_cast<AsyncCall*>(userData);
+    assert(asyncCall != nullptr);
+    assert(asyncCall->callback != nullptr);
+    auto& connection = asyncCall->connection;
+
+    if (!connection.beginAsyncCallDispatch(*asyncCall))
+        return 0; // A late reply to a released call
+
+    {
+        std::lock_guard lock(connection.asyncCallTimersMutex_);
+        connection.asyncCallTimers_.cancel(*asyncCall);
+    }
+
+    auto r = asyncCall->callback(sdbusMessage, asyncCall->userData, retError);
+    connection.endAsyncCallDispatch(*asyncCall);
+
+    return r;
+}
+
+void Connection::abandonSyncCallsViaEventLoop()
+{
+    // Called by the loop thread on its exit. Calls registered from now on are made directly.
+    std::lock_guard lock(syncCallsViaEventLoopMutex_);
+    asyncLoopThreadId_ = std::thread::id{};
+    for (auto* syncCall : syncCallsViaEventLoop_)
+    {
+        std::lock_guard callLock(syncCall->mutex);
+        syncCall->abandoned = true;
+        syncCall->cond.notify_one();
+    }
+}
+
+int Connection::sdbus_sync_call_reply_handler(sd_bus_message *sdbusMessage, void *userData, sd_bus_error */*retError*/)
+{
+    auto* syncCall = static_cast<SyncCall*>(userData);
+    assert(syncCall != nullptr);
+
+    std::lock_guard lock(syncCall->mutex);
+    syncCall->reply = syncCall->connection.sdbus_->sd_bus_message_ref(sdbusMessage);
+    syncCall->cond.notify_one();
+
+    return 1;
+}
+
+namespace {
+    // Error replied to method calls cancelled by the unregistration of their object
+    Error createCancelledMethodCallError()
+    {
+        return Error{Error::Name{SD_BUS_ERROR_UNKNOWN_OBJECT}, "Object was unregistered before the method call was handled"};
+    }
+}
+
+void Connection::sendMessage(sd_bus_message* sdbusMsg)
+{
+    // The late reply of a pooled call cancelled without waiting for it is replaced, see cancelMethodCalls()
+    if (const auto* cancelledCall = MethodCallDispatchPool::takeCancelledCall(sdbusMsg))
+    {
+        cancelledCall->createErrorReply(createCancelledMethodCallError()).send();
+        return;
+    }
+
+    // Replies to locally dispatched calls are handed back to the caller instead
+    if (hasLocalCallsAwaitingReply_.load(std::memory_order_relaxed) && replyLocally(sdbusMsg))
+        return;
+
+    if (submitMessages(&sdbusMsg, 1))
+        return;
+
+    auto r = sdbus_->sd_bus_send(nullptr, sdbusMsg, nullptr);
+
+    // Wake up event loop to continue dispatching the (fairly large) outbound message that hasn't yet been fully sent
+    wakeUpEventLoopIfMessagesInQueue();
+
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to send D-Bus message", -r);
+}
+
+void Connection::sendMessages(sd_bus_message** sdbusMsgs, std::size_t count)
+{
+    if (submitMessages(sdbusMsgs, count))
+        return;
+
+    auto r = sdbus_->sd_bus_send_many(nullptr, sdbusMsgs, count);
+
+    // One wake-up for the whole batch, for the event loop to continue dispatching what hasn't yet been fully sent
+    wakeUpEventLoopIfMessagesInQueue();
+
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to send D-Bus messages", -r);
+}
+
+bool Connection::submitMessages(sd_bus_message** sdbusMsgs, std::size_t count)
+{
+    // The event loop thread sends its messages right away, it would be the one to send them anyway
+    if (!submissionQueueEnabled_.load(std::memory_order_relaxed) || processingConnection_ == this || count == 0)
+        return false;
+
+    // The entries are linked most recent first, ready to be pushed onto the stack. The messages are referenced
+    // under one sd-bus lock acquisition per batch, since sd-bus reference counts are not atomic. That's the only
+    // time the sender takes the lock, it neither writes to the socket nor wakes up the event loop under it.
+    auto& memoryResource = *memoryResource_;
+    SubmittedMessage* first{};
+    SubmittedMessage* last{};
+    SCOPE_EXIT_FAILURE
+    {
+        while (first != nullptr)
+            deleteObject(memoryResource, std::exchange(first, first->next));
+    };
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        first = newObject<SubmittedMessage>(memoryResource, sdbusMsgs[i], memoryResource, first);
+        if (last == nullptr)
+            last = first;
+    }
+    sdbus_->sd_bus_message_ref_many(sdbusMsgs, count);
+
+    // The queue is checked again while counted as a submitter, since it may have been disabled and drained meanwhile
+    activeSubmitters_.fetch_add(1, std::memory_order_seq_cst);
+    if (!submissionQueueEnabled_.load(std::memory_order_seq_cst))
+    {
+        activeSubmitters_.fetch_sub(1, std::memory_order_release);
+        while (first != nullptr)
+        {
+            sdbus_->sd_bus_message_unref(first->message);
+            deleteObject(memoryResource, std::exchange(first, first->next));
+        }
+        return false;
+    }
+
+    auto* head = submittedMessages_.load(std::memory_order_relaxed);
+    do
+        last->next = head;
+    while (!submittedMessages_.compare_exchange_weak(head, first, std::memory_order_release, std::memory_order_relaxed));
+    activeSubmitters_.fetch_sub(1, std::memory_order_release);
+
+    // Only the first message of a batch needs to wake up the event loop
+    if (head == nullptr)
+        notifyEventLoopToWakeUpFromPoll();
+
+    return true;
+}
+
+bool Connection::sendSubmittedMessages()
+{
+    if (submittedMessages_.load(std::memory_order_relaxed) == nullptr)
+        return false;
+
+    // Batches are taken and sent under the sd-bus lock, so that they go out in the order they were taken
+    (void)sdbus_->sd_bus_process_locally(bus_.get(), [this]()
+    {
+        // The stack holds the most recent message first, so it's reversed to send the messages in submission order
+        SubmittedMessage* batch{};
+        for (auto* entry = submittedMessages_.exchange(nullptr, std::memory_order_acquire); entry != nullptr;)
+        {
+            auto* next = std::exchange(entry->next, batch);
+            batch = std::exchange(entry, next);
+        }
+
+        while (batch != nullptr)
+        {
+            // There is no one to report a failure to anymore, the sender has moved on
+            auto* entry = std::exchange(batch, batch->next);
+            (void)sdbus_->sd_bus_send(nullptr, entry->message, nullptr);
+            sdbus_->sd_bus_message_unref(entry->message);
+            deleteObject(entry->memoryResource, entry);
+        }
+        return 0;
+    });
+
+    return true;
+}
+
+void Connection::post(std::function<void()> work)
+{
+    {
+        std::lock_guard lock(postedWorkMutex_);
+        postedWork_.push_back(std::move(work));
+        hasPostedWork_.store(true, std::memory_order_relaxed);
+    }
+
+    notifyEventLoopToWakeUpFromPoll();
+}
+
+Slot Connection::addDestructionHandler(std::function<void()> handler)
+{
+    std::lock_guard lock(destructionHandlersMutex_);
+
+    const auto id = ++lastDestructionHandlerId_;
+    destructionHandlers_.emplace(id, std::move(handler));
+
+    return {reinterpret_cast<void*>(id), [this](void* slot)
+    {
+        std::lock_guard lock(destructionHandlersMutex_);
+        destructionHandlers_.erase(reinterpret_cast<std::uint64_t>(slot)); // Gone already if invoked on destruction
+    }};
+}
+
+void Connection::invokeDestructionHandlers()
+{
+    std::map<std::uint64_t, std::function<void()>> handlers;
+    {
+        std::lock_guard lock(destructionHandlersMutex_);
+        handlers.swap(destructionHandlers_);
+    }
+
+    // Invoked without the lock held, since the handlers typically destroy their slots
+    for (auto& [id, handler] : handlers)
+        handler();
+}
+
+bool Connection::doPostedWork()
+{
+    if (!hasPostedWork_.load(std::memory_order_relaxed))
+        return false;
+
+    std::vector<std::function<void()>> work;
+    {
+        std::lock_guard lock(postedWorkMutex_);
+        work.swap(postedWork_);
+        hasPostedWork_.store(false, std::memory_order_relaxed);
+    }
+
+    // Work posted meanwhile, e.g. by the work itself, is done in the next processing step
+    for (auto& item : work)
+        item();
+
+    return true;
+}
+
+void Connection::sendSignal(sd_bus_message* sdbusMsg)
+{
+    if (admitSignal(false) == SignalAdmission::Drop)
+        return;
+
+    sendMessage(sdbusMsg);
+}
+
+void Connection::sendSignals(sd_bus_message** sdbusMsgs, std::size_t count)
+{
+    if (admitSignal(false) == SignalAdmission::Drop)
+        return;
+
+    sendMessages(sdbusMsgs, count);
+}
+
+std::optional<uint32_t> Connection::dispatchMethodCallLocally(sd_bus_message* sdbusMsg, LocalCallWaiter waiter)
+{
+    // Calls not expecting a reply, calls sealed already (i.e. sent before), and calls passing unix fds go over the bus
+    uint64_t sealedCookie{};
+    const auto* signature = sd_bus_message_get_signature(sdbusMsg, true);
+    if ( sd_bus_message_get_expect_reply(sdbusMsg) <= 0
+      || sd_bus_message_get_cookie(sdbusMsg, &sealedCookie) >= 0
+      || signature == nullptr || std::strchr(signature, SD_BUS_TYPE_UNIX_FD) != nullptr )
+        return std::nullopt;
+
+    const auto* destination = sd_bus_message_get_destination(sdbusMsg);
+    const auto* objectPath = sd_bus_message_get_path(sdbusMsg);
+    const auto* interfaceName = sd_bus_message_get_interface(sdbusMsg);
+    const auto* methodName = sd_bus_message_get_member(sdbusMsg);
+    if (destination == nullptr || objectPath == nullptr || interfaceName == nullptr || methodName == nullptr)
+        return std::nullopt;
+
+    std::string sender;
+    waiter.target = findLocalDispatchTarget(destination, objectPath, interfaceName, methodName, signature, sender);
+    if (waiter.target == nullptr)
+        return std::nullopt;
+
+    uint32_t cookie{};
+    do
+        cookie = nextLocalCallCookie_.fetch_sub(1, std::memory_order_relaxed);
+    while (cookie == 0);
+
+    // The call is sealed as if it was sent, for its arguments to be read, and for its reply to be created from it later
+    auto r = sdbus_->sd_bus_message_seal(sdbusMsg, cookie, 0);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to seal the method call", -r);
+    auto call = Message::Factory::create<MethodCall>(sdbusMsg, this);
+    call.rewind(true);
+
+    LocalMethodCall localCall{cookie, this, std::move(sender), destination, objectPath, interfaceName, methodName, sdbus::createPlainMessage()};
+    call.copyTo(localCall.arguments, true);
+    localCall.arguments.seal();
+
+    {
+        std::lock_guard lock(localDispatchMutex_);
+        localCallWaiters_.emplace(cookie, waiter);
+    }
+
+    std::lock_guard registryLock(localDispatchRegistryMutex_);
+    auto& target = *waiter.target;
+    if (!isInLocalDispatchRegistry(&target))
+    {
+        // The called connection has left in the meantime, which is like its disconnecting from the bus
+        completeLocalCall(cookie, LocalReply{Error{Error::Name{SD_BUS_ERROR_NO_REPLY}, "Message recipient disconnected from message bus without replying"}, {}});
+        return cookie;
+    }
+
+    {
+        std::lock_guard lock(target.localDispatchMutex_);
+        target.localMethodCalls_.push_back(std::move(localCall));
+        target.hasLocalMethodCalls_.store(true, std::memory_order_relaxed);
+    }
+    target.notifyEventLoopToWakeUpFromPoll();
+
+    return cookie;
+}
+
+Connection* Connection::findLocalDispatchTarget( const char* destination
+                                               , const char* objectPath
+                                               , const char* interfaceName
+                                               , const char* methodName
+                                               , const char* signature
+                                               , std::string& sender )
+{
+    std::lock_guard registryLock(localDispatchRegistryMutex_);
+    if (!isInLocalDispatchRegistry(this))
+        return nullptr;
+
+    for (auto* connection : localDispatchRegistry_)
+    {
+        if (connection == this || !connection->isLocalDispatchTarget(destination))
+            continue;
+
+        // Calls sd-bus would reply to with an error (unknown method, invalid arguments) go over the bus to get it
+        if (!connection->managedObjectsCache_.hasMethod(objectPath, interfaceName, methodName, signature))
+            return nullptr;
+
+        sender = localUniqueName_;
+        return connection;
+    }
+
+    return nullptr;
+}
+
+bool Connection::isLocalDispatchTarget(std::string_view name) const
+{
+    if (name == localUniqueName_)
+        return true;
+
+    std::lock_guard lock(localDispatchMutex_);
+    return ownedNames_.contains(name);
+}
+
+bool Connection::isInLocalDispatchRegistry(const Connection* connection)
+{
+    return std::find(localDispatchRegistry_.begin(), localDispatchRegistry_.end(), connection) != localDispatchRegistry_.end();
+}
+
+bool Connection::callMethodAsyncLocally(sd_bus_message* sdbusMsg, AsyncCall& asyncCall)
+{
+    if (!localDispatchEnabled_.load(std::memory_order_relaxed))
+        return false;
+
+    // The call message is kept for creating the reply, so it must be in place before the reply may come
+    asyncCall.call = sdbus_->sd_bus_message_ref(sdbusMsg);
+    SCOPE_EXIT_FAILURE{ sdbus_->sd_bus_message_unref(std::exchange(asyncCall.call, nullptr)); };
 
-    connection->eventFd_.clear();
+    auto cookie = dispatchMethodCallLocally(sdbusMsg, LocalCallWaiter{nullptr, nullptr, &asyncCall});
+    if (!cookie)
+    {
+        sdbus_->sd_bus_message_unref(std::exchange(asyncCall.call, nullptr));
+        return false;
+    }
 
-    return 1;
+    asyncCall.localCookie = *cookie;
+    return true;
 }
 
-int Connection::onSdEventPrepare(sd_event_source */*s*/, void *userdata)
+int Connection::awaitLocalReply( sd_bus_message* sdbusMsg
+                               , uint32_t cookie
+                               , LocalSyncCall& syncCall
+                               , uint64_t timeout
+                               , sd_bus_error* sdbusError
+                               , sd_bus_message** sdbusReply )
 {
-    auto connection = static_cast<Connection*>(userdata);
-    assert(connection != nullptr);
+    if (timeout == 0)
+        timeout = getMethodCallTimeout();
 
-    auto sdbusPollData = connection->getEventLoopPollData();
+    {
+        std::unique_lock lock(syncCall.mutex);
+        auto isReplied = [&](){ return syncCall.reply.has_value(); };
+        if (timeout < MAX_TRACKED_TIMEOUT)
+            (void)syncCall.cond.wait_for(lock, std::chrono::microseconds(timeout), isReplied);
+        else
+            syncCall.cond.wait(lock, isReplied);
+    }
 
-    // Set poll events to watch out for on I/O fd
-    auto* sdIoEventSource = static_cast<sd_event_source*>(connection->sdEvent_->sdIoEventSource.get());
-    auto r = sd_event_source_set_io_events(sdIoEventSource, sdbusPollData.events);
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to set poll events for IO event source", -r);
+    // Once the call is abandoned, its reply is either in place already, or it won't come anymore
+    abandonLocalCall(cookie);
 
-    // Set poll events to watch out for on internal event fd
-    auto* sdInternalEventSource = static_cast<sd_event_source*>(connection->sdEvent_->sdInternalEventSource.get());
-    r = sd_event_source_set_io_events(sdInternalEventSource, POLLIN);
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to set poll events for internal event source", -r);
+    if (!syncCall.reply)
+        return sd_bus_error_set(sdbusError, SD_BUS_ERROR_NO_REPLY, "Method call timed out");
 
-    // Set current timeout to the time event source (it may be zero if there are messages in the sd-bus queues to be processed)
-    auto* sdTimeEventSource = static_cast<sd_event_source*>(connection->sdEvent_->sdTimeEventSource.get());
-    r = sd_event_source_set_time(sdTimeEventSource, static_cast<uint64_t>(sdbusPollData.timeout.count()));
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to set timeout for time event source", -r);
-    // In case the timeout is infinite, we disable the timer in the sd_event loop.
-    // This prevents a syscall error, where `timerfd_settime` returns `EINVAL`,
-    // because the value is too big. See #324 for details
-    r = sd_event_source_set_enabled(sdTimeEventSource, sdbusPollData.timeout != sdbusPollData.timeout.max() ? SD_EVENT_ONESHOT : SD_EVENT_OFF);
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to enable time event source", -r);
+    // Report the error the same way sd_bus_call() does
+    if (const auto& error = syncCall.reply->error)
+        return sd_bus_error_set(sdbusError, error->getName().c_str(), error->getMessage().c_str());
+
+    auto* reply = createLocalCallReply(sdbusMsg, *syncCall.reply);
+    if (sdbusReply != nullptr)
+        *sdbusReply = reply;
+    else
+        sdbus_->sd_bus_message_unref(reply);
 
     return 1;
 }
 
-void Connection::deleteSdEventSource(sd_event_source *s)
+void Connection::abandonLocalCall(uint32_t cookie)
 {
-#if LIBSYSTEMD_VERSION>=243
-    sd_event_source_disable_unref(s);
-#else
-    sd_event_source_set_enabled(s, SD_EVENT_OFF);
-    sd_event_source_unref(s);
-#endif
-}
+    Connection* target{};
+    {
+        std::lock_guard lock(localDispatchMutex_);
+        auto it = localCallWaiters_.find(cookie);
+        if (it == localCallWaiters_.end())
+            return;
+        target = it->second.target;
+        localCallWaiters_.erase(it);
+    }
 
-#endif // SDBUS_basu
+    // The called connection doesn't have to route the reply back anymore. The call is still handled, like one from the bus would be.
+    std::lock_guard registryLock(localDispatchRegistryMutex_);
+    if (!isInLocalDispatchRegistry(target))
+        return;
+    std::lock_guard lock(target->localDispatchMutex_);
+    target->localCallsAwaitingReply_.erase(cookie);
+    target->hasLocalCallsAwaitingReply_.store(!target->localCallsAwaitingReply_.empty(), std::memory_order_relaxed);
+}
 
-Slot Connection::addObjectVTable( const ObjectPath& objectPath
-                                , const InterfaceName& interfaceName
-                                , const sd_bus_vtable* vtable
-                                , void* userData
-                                , return_slot_t )
+bool Connection::handleLocalMethodCall()
 {
-    sd_bus_slot *slot{};
+    if (!hasLocalMethodCalls_.load(std::memory_order_relaxed))
+        return false;
 
-    auto r = sdbus_->sd_bus_add_object_vtable( bus_.get()
-                                             , &slot
-                                             , objectPath.c_str()
-                                             , interfaceName.c_str()
-                                             , vtable
-                                             , userData );
+    std::optional<LocalMethodCall> localCall;
+    {
+        std::lock_guard lock(localDispatchMutex_);
+        if (localMethodCalls_.empty())
+            return false;
+        localCall = std::move(localMethodCalls_.front());
+        localMethodCalls_.pop_front();
+        hasLocalMethodCalls_.store(!localMethodCalls_.empty(), std::memory_order_relaxed);
+
+        // Registered before the handler is invoked, since the handler may well reply right away
+        localCallsAwaitingReply_.emplace(localCall->cookie, LocalCallOrigin{localCall->caller, localCall->sender});
+        hasLocalCallsAwaitingReply_.store(true, std::memory_order_relaxed);
+    }
 
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to register object vtable", -r);
+    // The handler is invoked under the sd-bus lock like for a call read off the bus, so the object can't be unregistered meanwhile
+    std::optional<Error> error;
+    try
+    {
+        auto r = sdbus_->sd_bus_process_locally(bus_.get(), [&](){ return invokeLocalMethodCall(*localCall); });
+        SDBUS_THROW_ERROR_IF(r < 0, "Failed to dispatch local method call", -r);
+    }
+    catch (const Error& e)
+    {
+        error = e;
+    }
 
-    return {slot, [this](void *slot){ sdbus_->sd_bus_slot_unref((sd_bus_slot*)slot); }};
+    // The call couldn't be handed over to its handler, so the caller gets the error instead
+    if (error)
+    {
+        bool isAwaited{};
+        {
+            std::lock_guard lock(localDispatchMutex_);
+            isAwaited = localCallsAwaitingReply_.erase(localCall->cookie) > 0;
+            hasLocalCallsAwaitingReply_.store(!localCallsAwaitingReply_.empty(), std::memory_order_relaxed);
+        }
+        if (isAwaited)
+            deliverLocalReply(localCall->caller, localCall->cookie, LocalReply{std::move(error), {}});
+    }
+
+    return true;
 }
 
-PlainMessage Connection::createPlainMessage() const
+int Connection::invokeLocalMethodCall(LocalMethodCall& localCall)
 {
-    sd_bus_message* sdbusMsg{};
-
-    auto r = sdbus_->sd_bus_message_new(bus_.get(), &sdbusMsg, _SD_BUS_MESSAGE_TYPE_INVALID);
+    // The call is recreated on our bus as if it came from the bus, sent by the caller, with the cookie the caller knows it by
+    sd_bus_message* sdbusCall{};
+    auto r = sdbus_->sd_bus_message_new_method_call( bus_.get()
+                                                   , &sdbusCall
+                                                   , localCall.destination.c_str()
+                                                   , localCall.objectPath.c_str()
+                                                   , localCall.interfaceName.c_str()
+                                                   , localCall.methodName.c_str() );
+    if (r < 0)
+        return r;
+    auto call = Message::Factory::create<MethodCall>(sdbusCall, this, adopt_message);
+
+    r = sdbus_->sd_bus_message_set_sender(sdbusCall, localCall.sender.c_str());
+    if (r < 0)
+        return r;
+    localCall.arguments.rewind(true);
+    localCall.arguments.copyTo(call, true);
+    r = sdbus_->sd_bus_message_seal(sdbusCall, localCall.cookie, 0);
+    if (r < 0)
+        return r;
+    call.rewind(true);
+
+    // Looked up anew, since the method may have been unregistered since the call was made
+    sd_bus_error sdbusError = SD_BUS_ERROR_NULL;
+    SCOPE_EXIT{ sd_bus_error_free(&sdbusError); };
+    if (auto method = managedObjectsCache_.findMethod(localCall.objectPath, localCall.interfaceName, localCall.methodName))
+    {
+        locallyDispatchedMessage_ = &call;
+        SCOPE_EXIT{ locallyDispatchedMessage_ = nullptr; };
+        r = method->handler(sdbusCall, method->userData, &sdbusError);
+    }
+    else
+    {
+        r = sd_bus_error_setf( &sdbusError
+                             , SD_BUS_ERROR_UNKNOWN_METHOD
+                             , "Unknown method %s or interface %s."
+                             , localCall.methodName.c_str()
+                             , localCall.interfaceName.c_str() );
+    }
 
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to create a plain message", -r);
+    // Failures of the handler are replied with the way sd-bus does it
+    if (r < 0 || sd_bus_error_is_set(&sdbusError))
+    {
+        if (!sd_bus_error_is_set(&sdbusError))
+            sd_bus_error_set_errno(&sdbusError, r);
+        call.createErrorReply(Error{Error::Name{sdbusError.name}, sdbusError.message}).send();
+    }
 
-    return Message::Factory::create<PlainMessage>(sdbusMsg, const_cast<Connection*>(this), adopt_message);
+    return 1;
 }
 
-MethodCall Connection::createMethodCall( const ServiceName& destination
-                                       , const ObjectPath& objectPath
-                                       , const InterfaceName& interfaceName
-                                       , const MethodName& methodName ) const
+bool Connection::replyLocally(sd_bus_message* sdbusMsg)
 {
-    return Connection::createMethodCall(destination.c_str(), objectPath.c_str(), interfaceName.c_str(), methodName.c_str());
-}
+    uint64_t replyCookie{};
+    const auto* destination = sd_bus_message_get_destination(sdbusMsg);
+    if (destination == nullptr || sd_bus_message_get_reply_cookie(sdbusMsg, &replyCookie) < 0 || replyCookie > UINT32_MAX)
+        return false;
 
-MethodCall Connection::createMethodCall( const char* destination
-                                       , const char* objectPath
-                                       , const char* interfaceName
-                                       , const char* methodName ) const
-{
-    sd_bus_message *sdbusMsg{};
+    const auto cookie = static_cast<uint32_t>(replyCookie);
+    Connection* caller{};
+    {
+        std::lock_guard lock(localDispatchMutex_);
+        auto it = localCallsAwaitingReply_.find(cookie);
+        if (it == localCallsAwaitingReply_.end() || it->second.sender != destination)
+            return false;
+        caller = it->second.caller;
+        localCallsAwaitingReply_.erase(it);
+        hasLocalCallsAwaitingReply_.store(!localCallsAwaitingReply_.empty(), std::memory_order_relaxed);
+    }
 
-    auto r = sdbus_->sd_bus_message_new_method_call( bus_.get()
-                                                   , &sdbusMsg
-                                                   , !*destination ? nullptr : destination
-                                                   , objectPath
-                                                   , interfaceName
-                                                   , methodName);
+    LocalReply reply;
+    if (const auto* sdbusError = sd_bus_message_get_error(sdbusMsg); sdbusError != nullptr)
+    {
+        reply.error = Error(Error::Name{sdbusError->name}, sdbusError->message);
+    }
+    else
+    {
+        // Sealed like when sent, for its arguments to be read
+        auto message = Message::Factory::create<MethodReply>(sdbusMsg, this);
+        message.seal();
+        message.rewind(true);
+        reply.body = sdbus::createPlainMessage();
+        message.copyTo(reply.body, true);
+        reply.body.seal();
+    }
 
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to create method call", -r);
+    // Signals the handler emitted and left in the submission queue go out before the reply is handed over
+    (void)sendSubmittedMessages();
 
-    return Message::Factory::create<MethodCall>(sdbusMsg, const_cast<Connection*>(this), adopt_message);
+    deliverLocalReply(caller, cookie, std::move(reply));
+
+    return true;
 }
 
-Signal Connection::createSignal( const ObjectPath& objectPath
-                               , const InterfaceName& interfaceName
-                               , const SignalName& signalName ) const
+void Connection::deliverLocalReply(Connection* caller, uint32_t cookie, LocalReply reply)
 {
-    return Connection::createSignal(objectPath.c_str(), interfaceName.c_str(), signalName.c_str());
+    std::lock_guard registryLock(localDispatchRegistryMutex_);
+    if (isInLocalDispatchRegistry(caller))
+        caller->completeLocalCall(cookie, std::move(reply));
 }
 
-Signal Connection::createSignal( const char* objectPath
-                               , const char* interfaceName
-                               , const char* signalName ) const
+void Connection::completeLocalCall(uint32_t cookie, LocalReply reply)
 {
-    sd_bus_message *sdbusMsg{};
-
-    auto r = sdbus_->sd_bus_message_new_signal(bus_.get(), &sdbusMsg, objectPath, interfaceName, signalName);
-
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to create signal", -r);
+    {
+        std::lock_guard lock(localDispatchMutex_);
+        auto it = localCallWaiters_.find(cookie);
+        if (it == localCallWaiters_.end())
+            return; // Abandoned by the caller, e.g. timed out
+
+        if (auto* syncCall = it->second.syncCall; syncCall != nullptr)
+        {
+            localCallWaiters_.erase(it);
+            std::lock_guard syncLock(syncCall->mutex);
+            syncCall->reply = std::move(reply);
+            syncCall->cond.notify_one();
+            return;
+        }
+
+        // The async call stays registered until its reply handler is invoked by the event loop
+        localReplies_.emplace_back(cookie, std::move(reply));
+        hasLocalReplies_.store(true, std::memory_order_relaxed);
+    }
 
-    return Message::Factory::create<Signal>(sdbusMsg, const_cast<Connection*>(this), adopt_message);
+    notifyEventLoopToWakeUpFromPoll();
 }
 
-void Connection::emitPropertiesChangedSignal( const ObjectPath& objectPath
-                                            , const InterfaceName& interfaceName
-                                            , const std::vector<PropertyName>& propNames )
+bool Connection::dispatchLocalReplies()
 {
-    Connection::emitPropertiesChangedSignal(objectPath.c_str(), interfaceName.c_str(), propNames);
+    if (!hasLocalReplies_.load(std::memory_order_relaxed))
+        return false;
+
+    std::vector<std::pair<uint32_t, LocalReply>> replies;
+    {
+        std::lock_guard lock(localDispatchMutex_);
+        replies.swap(localReplies_);
+        hasLocalReplies_.store(false, std::memory_order_relaxed);
+    }
+
+    // Async calls are freed under the expiry lock, so a call still registered stays alive throughout the dispatch of its reply
+    std::lock_guard expiryLock(asyncCallExpiryMutex_);
+    for (auto& [cookie, reply] : replies)
+    {
+        AsyncCall* asyncCall{};
+        {
+            std::lock_guard lock(localDispatchMutex_);
+            if (auto it = localCallWaiters_.find(cookie); it != localCallWaiters_.end())
+            {
+                asyncCall = it->second.asyncCall;
+                localCallWaiters_.erase(it);
+            }
+        }
+        if (asyncCall == nullptr)
+            continue;
+
+        auto* sdbusReply = createLocalCallReply(asyncCall->call, reply);
+        SCOPE_EXIT{ sdbus_->sd_bus_message_unref(sdbusReply); };
+        sd_bus_error sdbusError = SD_BUS_ERROR_NULL;
+        SCOPE_EXIT{ sd_bus_error_free(&sdbusError); };
+        (void)sdbus_async_call_reply_handler(sdbusReply, asyncCall, &sdbusError);
+    }
+
+    return !replies.empty();
 }
 
-void Connection::emitPropertiesChangedSignal( const char* objectPath
-                                            , const char* interfaceName
-                                            , const std::vector<PropertyName>& propNames )
+sd_bus_message* Connection::createLocalCallReply(sd_bus_message* sdbusCall, LocalReply& reply)
 {
-    auto names = to_strv(propNames);
+    auto* sdbusReply = reply.error ? createErrorReplyMessage(sdbusCall, *reply.error) : createMethodReply(sdbusCall);
+    auto message = Message::Factory::create<MethodReply>(sdbusReply, this, adopt_message);
+    if (!reply.error)
+    {
+        reply.body.rewind(true);
+        reply.body.copyTo(message, true);
+    }
 
-    auto r = sdbus_->sd_bus_emit_properties_changed_strv( bus_.get()
-                                                        , objectPath
-                                                        , interfaceName
-                                                        , propNames.empty() ? nullptr : &names[0] );
+    // Sealed like a reply read off the bus
+    message.seal();
+    message.rewind(true);
 
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to emit PropertiesChanged signal", -r);
+    return sdbus_->sd_bus_message_ref(sdbusReply);
 }
 
-void Connection::emitInterfacesAddedSignal(const ObjectPath& objectPath)
+void Connection::failLocalCalls()
 {
-    auto r = sdbus_->sd_bus_emit_object_added(bus_.get(), objectPath.c_str());
+    std::deque<LocalMethodCall> queuedCalls;
+    std::unordered_map<uint32_t, LocalCallOrigin> handledCalls;
+    std::vector<uint32_t> ownCalls;
+    {
+        std::lock_guard lock(localDispatchMutex_);
+        queuedCalls.swap(localMethodCalls_);
+        handledCalls.swap(localCallsAwaitingReply_);
+        for (const auto& [cookie, waiter] : localCallWaiters_)
+            ownCalls.push_back(cookie);
+        hasLocalMethodCalls_.store(false, std::memory_order_relaxed);
+        hasLocalCallsAwaitingReply_.store(false, std::memory_order_relaxed);
+    }
 
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to emit InterfacesAdded signal for all registered interfaces", -r);
+    // Callers get the error the bus daemon replies with when the called peer disconnects
+    const Error disconnectedError{Error::Name{SD_BUS_ERROR_NO_REPLY}, "Message recipient disconnected from message bus without replying"};
+    for (const auto& call : queuedCalls)
+        deliverLocalReply(call.caller, call.cookie, LocalReply{disconnectedError, {}});
+    for (const auto& [cookie, origin] : handledCalls)
+        deliverLocalReply(origin.caller, cookie, LocalReply{disconnectedError, {}});
+
+    const Error disabledError{Error::Name{SD_BUS_ERROR_NO_REPLY}, "Local dispatch disabled before the reply came"};
+    for (auto cookie : ownCalls)
+        completeLocalCall(cookie, LocalReply{disabledError, {}});
 }
 
-void Connection::emitInterfacesAddedSignal( const ObjectPath& objectPath
-                                          , const std::vector<InterfaceName>& interfaces )
+uint64_t Connection::getOutboundQueueSize() const
 {
-    auto names = to_strv(interfaces);
+    uint64_t readQueueSize{};
+    uint64_t writeQueueSize{};
 
-    auto r = sdbus_->sd_bus_emit_interfaces_added_strv( bus_.get()
-                                                      , objectPath.c_str()
-                                                      , interfaces.empty() ? nullptr : &names[0] );
+    auto r = sdbus_->sd_bus_get_n_queued(bus_.get(), &readQueueSize, &writeQueueSize);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to get number of pending messages in sd-bus queues", -r);
 
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to emit InterfacesAdded signal", -r);
+    return writeQueueSize;
 }
 
-void Connection::emitInterfacesRemovedSignal(const ObjectPath& objectPath)
+Connection::OutboundQueueState Connection::refreshOutboundQueueState()
 {
-    auto r = sdbus_->sd_bus_emit_object_removed(bus_.get(), objectPath.c_str());
+    const auto queueSize = getOutboundQueueSize();
 
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to emit InterfacesRemoved signal for all registered interfaces", -r);
+    OutboundQueueState state;
+    std::function<void(uint64_t)> overflowHandler;
+    DeferredPropertiesChanges deferredChanges;
+    {
+        std::lock_guard lock(outboundQueueMutex_);
+        if (!outboundQueueLimited_)
+            return state;
+
+        // Hysteresis between the watermarks keeps the state from flapping with each message sent
+        if (!outboundQueueOverflown_ && queueSize >= outboundQueueLimits_.highWatermark)
+        {
+            outboundQueueOverflown_ = true;
+            overflowHandler = outboundQueueLimits_.overflowHandler;
+        }
+        else if (outboundQueueOverflown_ && queueSize <= outboundQueueLimits_.lowWatermark)
+        {
+            outboundQueueOverflown_ = false;
+            deferredChanges.swap(deferredPropertiesChanges_);
+            outboundQueueDrained_.notify_all();
+        }
+
+        state.overflown = outboundQueueOverflown_;
+        state.policy = outboundQueueLimits_.policy;
+    }
+
+    // Both are invoked outside the lock, so that they can emit signals themselves
+    if (overflowHandler)
+        overflowHandler(queueSize);
+    emitDeferredPropertiesChanges(deferredChanges);
+
+    return state;
 }
 
-void Connection::emitInterfacesRemovedSignal( const ObjectPath& objectPath
-                                            , const std::vector<InterfaceName>& interfaces )
+Connection::SignalAdmission Connection::admitSignal(bool isPropertiesChanged)
 {
-    auto names = to_strv(interfaces);
+    if (!outboundQueueLimited_.load(std::memory_order_relaxed))
+        return SignalAdmission::Send;
 
-    auto r = sdbus_->sd_bus_emit_interfaces_removed_strv( bus_.get()
-                                                        , objectPath.c_str()
-                                                        , interfaces.empty() ? nullptr : &names[0] );
+    auto state = refreshOutboundQueueState();
+    if (!state.overflown)
+        return SignalAdmission::Send;
 
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to emit InterfacesRemoved signal", -r);
+    switch (state.policy)
+    {
+        case OutboundQueueOverflowPolicy::Block:
+        {
+            // The queue is written out by the event loop, which could never do that while we'd be blocking it here
+            SDBUS_THROW_ERROR_IF( processingConnection_ == this
+                                , "Failed to emit signal: outbound queue overflown in the event loop thread"
+                                , EDEADLK );
+
+            // The loop shall poll for the socket getting writable, which it may not be doing if the queue filled up from other threads
+            notifyEventLoopToWakeUpFromPoll();
+            std::unique_lock lock(outboundQueueMutex_);
+            outboundQueueDrained_.wait(lock, [this](){ return !outboundQueueOverflown_; });
+            return SignalAdmission::Send;
+        }
+        case OutboundQueueOverflowPolicy::DropSignals:
+            return SignalAdmission::Drop;
+        case OutboundQueueOverflowPolicy::CoalescePropertiesChanged:
+            return isPropertiesChanged ? SignalAdmission::Defer : SignalAdmission::Send;
+        case OutboundQueueOverflowPolicy::Enqueue:
+        default:
+            return SignalAdmission::Send;
+    }
 }
 
-Slot Connection::registerSignalHandler( const char* sender
-                                      , const char* objectPath
-                                      , const char* interfaceName
-                                      , const char* signalName
-                                      , sd_bus_message_handler_t callback
-                                      , void* userData
-                                      , return_slot_t )
+bool Connection::deferPropertiesChange(const char* objectPath, const char* interfaceName, const std::vector<PropertyName>& propNames)
 {
-    sd_bus_slot *slot{};
+    std::lock_guard lock(outboundQueueMutex_);
 
-    auto r = sdbus_->sd_bus_match_signal( bus_.get()
-                                        , &slot
-                                        , !*sender ? nullptr : sender
-                                        , !*objectPath ? nullptr : objectPath
-                                        , !*interfaceName ? nullptr : interfaceName
-                                        , !*signalName ? nullptr : signalName
-                                        , callback
-                                        , userData );
+    // The overflow state may have been left in the meantime, with deferred changes already emitted
+    if (!outboundQueueOverflown_)
+        return false;
 
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to register signal handler", -r);
+    auto [it, inserted] = deferredPropertiesChanges_.try_emplace({objectPath, interfaceName}, propNames.begin(), propNames.end());
+    if (!inserted)
+        mergePropertyNames(it->second, propNames);
 
-    return {slot, [this](void *slot){ sdbus_->sd_bus_slot_unref((sd_bus_slot*)slot); }};
+    return true;
 }
 
-sd_bus_message* Connection::incrementMessageRefCount(sd_bus_message* sdbusMsg)
+void Connection::mergePropertyNames(std::set<std::string>& names, const std::vector<PropertyName>& propNames)
 {
-    return sdbus_->sd_bus_message_ref(sdbusMsg);
+    if (names.empty())
+        return; // Already all properties
+    if (propNames.empty())
+        names.clear(); // Changes of all properties subsume changes of particular ones
+    else
+        names.insert(propNames.begin(), propNames.end());
 }
 
-sd_bus_message* Connection::decrementMessageRefCount(sd_bus_message* sdbusMsg)
+void Connection::coalescePropertiesChangedSignal( const char* objectPath
+                                                , const char* interfaceName
+                                                , const std::vector<PropertyName>& propNames
+                                                , std::chrono::microseconds interval )
 {
-    return sdbus_->sd_bus_message_unref(sdbusMsg);
+    invalidateManagedObjects(objectPath, interfaceName);
+
+    const auto due = now() + interval;
+    bool isNextDue{};
+    {
+        std::lock_guard lock(coalescedPropertiesChangesMutex_);
+        auto [it, inserted] = coalescedPropertiesChanges_.try_emplace( {objectPath, interfaceName}
+                                                                     , CoalescedPropertiesChange{{propNames.begin(), propNames.end()}, due} );
+        if (!inserted)
+            mergePropertyNames(it->second.names, propNames);
+        else if (due < nextCoalescedPropertiesChangeDue_.load(std::memory_order_relaxed))
+        {
+            nextCoalescedPropertiesChangeDue_.store(due, std::memory_order_relaxed);
+            isNextDue = true;
+        }
+    }
+
+    // The event loop has to re-enter poll with a timeout covering the new due time
+    if (isNextDue)
+        notifyEventLoopToWakeUpFromPoll();
 }
 
-int Connection::querySenderCredentials(sd_bus_message* sdbusMsg, uint64_t mask, sd_bus_creds **creds)
+bool Connection::emitDueCoalescedPropertiesChanges()
 {
-    return sdbus_->sd_bus_query_sender_creds(sdbusMsg, mask, creds);
+    if (nextCoalescedPropertiesChangeDue_.load(std::memory_order_relaxed) == std::chrono::nanoseconds::max())
+        return false;
+
+    const auto currentTime = now();
+    std::vector<std::pair<std::pair<std::string, std::string>, std::set<std::string>>> dueChanges;
+    {
+        std::lock_guard lock(coalescedPropertiesChangesMutex_);
+        auto nextDue = std::chrono::nanoseconds::max();
+        for (auto it = coalescedPropertiesChanges_.begin(); it != coalescedPropertiesChanges_.end();)
+        {
+            if (it->second.due <= currentTime)
+            {
+                dueChanges.emplace_back(it->first, std::move(it->second.names));
+                it = coalescedPropertiesChanges_.erase(it);
+            }
+            else
+            {
+                nextDue = std::min(nextDue, it->second.due);
+                ++it;
+            }
+        }
+        nextCoalescedPropertiesChangeDue_.store(nextDue, std::memory_order_relaxed);
+    }
+
+    for (const auto& [key, names] : dueChanges)
+    {
+        // The object, or its interface, may have been removed since the changes were collected
+        if (!managedObjectsCache_.hasInterface(key.first, key.second))
+            continue;
+
+        try
+        {
+            Connection::emitPropertiesChangedSignal(key.first.c_str(), key.second.c_str(), {names.begin(), names.end()});
+        }
+        catch (const Error&)
+        {
+            // Removed by another thread only after the check above
+        }
+    }
+
+    return !dueChanges.empty();
 }
 
-sd_bus_creds* Connection::incrementCredsRefCount(sd_bus_creds* creds)
+void Connection::emitDeferredPropertiesChanges(const DeferredPropertiesChanges& changes)
 {
-    return sdbus_->sd_bus_creds_ref(creds);
+    for (const auto& [key, names] : changes)
+        doEmitPropertiesChangedSignal(key.first.c_str(), key.second.c_str(), {names.begin(), names.end()});
 }
 
-sd_bus_creds* Connection::decrementCredsRefCount(sd_bus_creds* creds)
+sd_bus_message* Connection::createMethodReply(sd_bus_message* sdbusMsg)
 {
-    return sdbus_->sd_bus_creds_unref(creds);
+    sd_bus_message* sdbusReply{};
+
+    auto r = sdbus_->sd_bus_message_new_method_return(sdbusMsg, &sdbusReply);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to create method reply", -r);
+
+    return sdbusReply;
 }
 
-sd_bus_message* Connection::callMethod(sd_bus_message* sdbusMsg, uint64_t timeout)
+sd_bus_message* Connection::createErrorReplyMessage(sd_bus_message* sdbusMsg, const Error& error)
 {
     sd_bus_error sdbusError = SD_BUS_ERROR_NULL;
     SCOPE_EXIT{ sd_bus_error_free(&sdbusError); };
+    sd_bus_error_set(&sdbusError, error.getName().c_str(), error.getMessage().c_str());
 
-    // This call will block the bus connection from serving other messages
-    // until the reply arrives or the call times out.
-    sd_bus_message* sdbusReply{};
-    auto r = sdbus_->sd_bus_call(nullptr, sdbusMsg, timeout, &sdbusError, &sdbusReply);
+    sd_bus_message* sdbusErrorReply{};
+    auto r = sdbus_->sd_bus_message_new_method_error(sdbusMsg, &sdbusErrorReply, &sdbusError);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to create method error reply", -r);
 
-    if (sd_bus_error_is_set(&sdbusError))
-        throw Error(Error::Name{sdbusError.name}, sdbusError.message);
+    return sdbusErrorReply;
+}
 
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to call method", -r);
+bool Connection::dispatchMethodCall(MethodCall& call, const method_callback& callback, const void* owner, bool isHighPriority)
+{
+    // Admitted calls are handled, or handed over to the dispatch pool, by the event loop later on
+    if (methodCallAdmission_.load(std::memory_order_relaxed))
+    {
+        admitMethodCall(call, callback, owner, isHighPriority);
+        return true;
+    }
+
+    if (dispatchPool_ == nullptr)
+        return false;
+
+    dispatchPool_->dispatch(std::move(call), callback, owner, isHighPriority);
+
+    return true;
+}
+
+void Connection::cancelMethodCalls(const void* owner)
+{
+    std::vector<ScheduledMethodCall> scheduled; // Destroyed, with the copies of the owner's callbacks, outside of the lock
+    std::vector<MethodCall> cancelled;
+    {
+        std::unique_lock lock(methodCallSchedulerMutex_);
+        scheduled = methodCallScheduler_.removeIf([owner](const ScheduledMethodCall& call){ return call.owner == owner; }, now());
+        hasScheduledMethodCalls_.store(methodCallScheduler_.size() > 0, std::memory_order_relaxed);
+        for (auto& call : scheduled)
+            cancelled.push_back(std::move(call.call));
+
+        // A queued call handled in place by the event loop runs outside of sd-bus processing, so the owner's
+        // unregistration from sd-bus doesn't wait for it, unlike for calls handled right in sd-bus callbacks
+        if (handledScheduledCallThread_ != std::this_thread::get_id())
+            scheduledCallHandled_.wait(lock, [&](){ return handledScheduledCallOwner_ != owner; });
+    }
 
-    // Wake up event loop to process messages that may have arrived in the meantime,
-    // or to dispatch the outbound message that hasn't yet been fully sent out.
-    wakeUpEventLoopIfMessagesInQueue();
+    // Scheduled calls are handed over to the pool under the scheduler lock, so none can slip into the pool past us here.
+    // The owner's calls being handled by the workers are waited for, unless we are in a callback of sd-bus processing,
+    // e.g. an object destroyed from a signal handler. The workers need the sd-bus lock held by us to send their replies
+    // then, so they are let finish on their own, and their late replies are replaced by the cancellation error.
+    if (dispatchPool_ != nullptr)
+    {
+        auto pooled = dispatchPool_->cancel(owner, !sdbus_->isProcessingInCurrentThread());
+        if (!pooled.empty())
+            onPooledMethodCallDone();
+        std::move(pooled.begin(), pooled.end(), std::back_inserter(cancelled));
+    }
 
-    return sdbusReply;
+    for (auto& call : cancelled)
+    {
+        try
+        {
+            call.createErrorReply(createCancelledMethodCallError()).send();
+        }
+        catch (const Error&)
+        {
+            // The sender may be gone already. We are called on object destruction here, so nothing may be thrown.
+        }
+    }
 }
 
-Slot Connection::callMethodAsync(sd_bus_message* sdbusMsg, sd_bus_message_handler_t callback, void* userData, uint64_t timeout, return_slot_t)
+void Connection::admitMethodCall(MethodCall& call, const method_callback& callback, const void* owner, bool isHighPriority)
 {
-    sd_bus_slot *slot{};
+    const auto* sender = call.getSender();
+    const auto* interfaceName = call.getInterfaceName();
 
-    // TODO: Think of ways of optimizing these three locking/unlocking of sdbus mutex (merge into one call?)
-    auto timeoutBefore = getEventLoopPollData().timeout;
-    auto r = sdbus_->sd_bus_call_async(nullptr, &slot, sdbusMsg, (sd_bus_message_handler_t)callback, userData, timeout);
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to call method asynchronously", -r);
-    auto timeoutAfter = getEventLoopPollData().timeout;
+    std::optional<ScheduledMethodCall> rejected;
+    {
+        std::lock_guard lock(methodCallSchedulerMutex_);
+        rejected = methodCallScheduler_.submit( sender != nullptr ? sender : ""
+                                              , interfaceName != nullptr ? interfaceName : ""
+                                              , ScheduledMethodCall{std::move(call), callback, owner, isHighPriority}
+                                              , now()
+                                              , isHighPriority );
+        hasScheduledMethodCalls_.store(methodCallScheduler_.size() > 0, std::memory_order_relaxed);
+    }
 
-    // An event loop may wait in poll with timeout `t1', while in another thread an async call is made with
-    // timeout `t2'. If `t2' < `t1', then we have to wake up the event loop thread to update its poll timeout.
-    // We also have to wake up the event loop to process the messages that may be in the read/write queues.
-    if (timeoutAfter < timeoutBefore || arePendingMessagesInQueues())
-        notifyEventLoopToWakeUpFromPoll();
+    if (!rejected)
+        return;
 
-    return {slot, [this](void *slot){ sdbus_->sd_bus_slot_unref((sd_bus_slot*)slot); }};
+    try
+    {
+        rejected->call.createErrorReply(Error{Error::Name{SD_BUS_ERROR_LIMITS_EXCEEDED}, "Too many method calls from the sender"}).send();
+    }
+    catch (const Error&)
+    {
+        // The sender may be gone already. We are inside sd-bus callback here, so nothing may be thrown.
+    }
 }
 
-void Connection::sendMessage(sd_bus_message* sdbusMsg)
+bool Connection::handleScheduledMethodCall(bool isBusIdle)
 {
-    auto r = sdbus_->sd_bus_send(nullptr, sdbusMsg, nullptr);
+    if (!hasScheduledMethodCalls_.load(std::memory_order_relaxed))
+        return false;
 
-    // Wake up event loop to continue dispatching the (fairly large) outbound message that hasn't yet been fully sent
-    wakeUpEventLoopIfMessagesInQueue();
+    std::optional<ScheduledMethodCall> scheduled;
+    {
+        std::lock_guard lock(methodCallSchedulerMutex_);
+
+        // Calls are read off the bus ahead of their handling, so that queued calls of all senders compete for their turn.
+        // The read-ahead ends when the queue is full, or after a queue length's worth of processing steps, lest a flood
+        // of incoming messages starves the queued calls. High priority calls are handled as soon as they are read.
+        const bool hasHighPriorityCalls = methodCallScheduler_.hasHighPriorityCalls();
+        if (!isBusIdle && !methodCallScheduler_.isFull() && !hasHighPriorityCalls && ++methodCallReadAheadSteps_ < methodCallReadAheadLimit_)
+            return false;
+        if (!hasHighPriorityCalls && !canHandleScheduledMethodCall())
+            return false;
+
+        scheduled = methodCallScheduler_.next(now());
+        if (!scheduled)
+            return false;
+
+        methodCallReadAheadSteps_ = 0;
+        hasScheduledMethodCalls_.store(methodCallScheduler_.size() > 0, std::memory_order_relaxed);
+
+        // The call is handed over to the pool under the lock, lest it escapes cancelMethodCalls() on its way there.
+        // A high priority call doesn't wait for a worker to get free, it goes to the worker dedicated to such calls.
+        if (dispatchPool_ != nullptr && (scheduled->isHighPriority || canHandleScheduledMethodCall()))
+        {
+            dispatchPool_->dispatch(std::move(scheduled->call), std::move(scheduled->callback), scheduled->owner, scheduled->isHighPriority);
+            return true;
+        }
+
+        handledScheduledCallOwner_ = scheduled->owner;
+        handledScheduledCallThread_ = std::this_thread::get_id();
+    }
 
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to send D-Bus message", -r);
+    SCOPE_EXIT
+    {
+        scheduled.reset(); // Along with its copy of the callback, before the owner stops counting as being handled
+        std::lock_guard lock(methodCallSchedulerMutex_);
+        handledScheduledCallOwner_ = nullptr;
+        scheduledCallHandled_.notify_all();
+    };
+
+    (void)metrics_.measureHandler([&]
+    {
+        handleDispatchedMethodCall(scheduled->call, scheduled->callback);
+        return true;
+    });
+
+    return true;
 }
 
-sd_bus_message* Connection::createMethodReply(sd_bus_message* sdbusMsg)
+bool Connection::canHandleScheduledMethodCall() const
 {
-    sd_bus_message* sdbusReply{};
-
-    auto r = sdbus_->sd_bus_message_new_method_return(sdbusMsg, &sdbusReply);
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to create method reply", -r);
+    // Calls are handed over to the dispatch pool only as its workers get free, so that the rest stay in the fair queue
+    return dispatchPool_ == nullptr || dispatchPool_->hasFreeWorker();
+}
 
-    return sdbusReply;
+void Connection::onPooledMethodCallDone()
+{
+    if (hasScheduledMethodCalls_.load(std::memory_order_relaxed))
+        notifyEventLoopToWakeUpFromPoll();
 }
 
-sd_bus_message* Connection::createErrorReplyMessage(sd_bus_message* sdbusMsg, const Error& error)
+void Connection::handleDispatchedMethodCall(MethodCall& call, const method_callback& callback)
 {
-    sd_bus_error sdbusError = SD_BUS_ERROR_NULL;
-    SCOPE_EXIT{ sd_bus_error_free(&sdbusError); };
-    sd_bus_error_set(&sdbusError, error.getName().c_str(), error.getMessage().c_str());
+    auto tracer = getTracer();
+    void* span = tracer != nullptr ? tracer->onMethodCallReceived(call) : nullptr;
 
-    sd_bus_message* sdbusErrorReply{};
-    auto r = sdbus_->sd_bus_message_new_method_error(sdbusMsg, &sdbusErrorReply, &sdbusError);
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to create method error reply", -r);
+    auto error = handlerProfiler_.measure(HandlerKind::Method, call, [&]
+    {
+        return MethodCallDispatchPool::handle(call, callback);
+    });
 
-    return sdbusErrorReply;
+    if (tracer != nullptr)
+        tracer->onMethodCallHandled(span, call, error ? &*error : nullptr);
 }
 
 Connection::BusPtr Connection::openBus(const BusFactory& busFactory)
@@ -758,6 +3197,14 @@ void Connection::notifyEventLoopToExit()
 
 void Connection::notifyEventLoopToWakeUpFromPoll()
 {
+    // The internal event loop reads fresh poll data before each poll, so there is no need to wake it up while
+    // it's processing. The fence pairs with the one in waitForNextEvent(): either the loop sees the changes made
+    // before this call in its poll data, or we see it polling (or about to) here. External event loops, whose
+    // state we don't know, are always woken up.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (eventLoopState_.load(std::memory_order_relaxed) == EventLoopState::Processing)
+        return;
+
     eventFd_.notify();
 }
 
@@ -778,7 +3225,10 @@ void Connection::wakeUpEventLoopIfMessagesInQueue()
 void Connection::joinWithEventLoop()
 {
     if (asyncLoopThread_.joinable())
+    {
         asyncLoopThread_.join();
+        asyncLoopThreadId_ = std::thread::id{};
+    }
 }
 
 bool Connection::processPendingEvent()
@@ -786,16 +3236,70 @@ bool Connection::processPendingEvent()
     auto bus = bus_.get();
     assert(bus != nullptr);
 
+    const bool isMeasured = metrics_.isEnabled();
+    const auto start = isMeasured ? now() : std::chrono::nanoseconds{};
+
+    // Messages sent by handlers invoked here go out right away, not through the submission queue
+    auto* previousProcessingConnection = std::exchange(processingConnection_, this);
+    SCOPE_EXIT{ processingConnection_ = previousProcessingConnection; };
+
+    freeReleasedAsyncCalls();
+    auto expired = expireAsyncCalls();
+    expired |= emitDueCoalescedPropertiesChanges();
+    auto handled = sendSubmittedMessages();
+    handled |= doPostedWork();
+
     int r = sdbus_->sd_bus_process(bus, nullptr);
+    // sd-bus dispatches the Disconnected signal and fails pending calls first, and reports the reset once it's done
+    if (r == -ECONNRESET && isPeerToPeer_)
+    {
+        isClosedByPeer_.store(true, std::memory_order_relaxed);
+        return false;
+    }
     SDBUS_THROW_ERROR_IF(r < 0, "Failed to process bus requests", -r);
 
+    handled |= handleScheduledMethodCall(r == 0);
+    handled |= handleLocalMethodCall();
+    handled |= dispatchLocalReplies();
+
+    // Writing out queued messages may have drained the outbound queue enough to leave the overflow state
+    if (outboundQueueLimited_.load(std::memory_order_relaxed))
+        (void)refreshOutboundQueueState();
+
+    if (isMeasured)
+    {
+        metrics_.recordProcessingStep(now() - start, r > 0 || handled);
+
+        uint64_t readQueueSize{};
+        uint64_t writeQueueSize{};
+        if (sdbus_->sd_bus_get_n_queued(bus, &readQueueSize, &writeQueueSize) >= 0)
+            metrics_.recordQueueDepths(readQueueSize, writeQueueSize);
+    }
+
     // In correct use of sdbus-c++ API, r can be 0 only when processPendingEvent()
     // is called from an external event loop as a reaction to event fd being signalled.
     // If there are no more D-Bus messages to process, we know we have to clear event fd.
-    if (r == 0)
+    if (r == 0 && !expired && !handled)
         eventFd_.clear();
 
-    return r > 0;
+    return r > 0 || expired || handled;
+}
+
+std::size_t Connection::processPendingEvents(std::size_t maxCount, std::chrono::microseconds maxDuration)
+{
+    // Avoid overflow of the deadline, and clock reads altogether, when there is no time limit
+    const bool isTimeLimited = maxDuration != std::chrono::microseconds::max();
+    const auto deadline = isTimeLimited ? now() + maxDuration : std::chrono::nanoseconds::max();
+
+    std::size_t count{};
+    while (count < maxCount && processPendingEvent())
+    {
+        ++count;
+        if (isTimeLimited && now() >= deadline)
+            break;
+    }
+
+    return count;
 }
 
 bool Connection::waitForNextEvent()
@@ -804,6 +3308,10 @@ bool Connection::waitForNextEvent()
     assert(loopExitFd_.fd >= 0);
     assert(eventFd_.fd >= 0);
 
+    // From now on, other threads have to wake us up for their changes to be taken into account (see notifyEventLoopToWakeUpFromPoll())
+    eventLoopState_.store(EventLoopState::Polling, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
     auto sdbusPollData = getEventLoopPollData();
     struct pollfd fds[] = { {sdbusPollData.fd, sdbusPollData.events, 0}
                           , {eventFd_.fd, POLLIN, 0}
@@ -814,12 +3322,16 @@ bool Connection::waitForNextEvent()
     // Are there pending messages in the outbound queue? Then sd-bus will add POLLOUT to events, so poll() will wake up right away.
     auto timeout = sdbusPollData.getPollTimeout();
     auto r = poll(fds, fdsCount, timeout);
+    eventLoopState_.store(EventLoopState::Processing, std::memory_order_relaxed);
 
     if (r < 0 && errno == EINTR)
         return true; // Try again
 
     SDBUS_THROW_ERROR_IF(r < 0, "Failed to wait on the bus", -errno);
 
+    if (metrics_.isEnabled())
+        metrics_.recordPollWakeup();
+
     // Wake up notification, in order that we re-enter poll with freshly read PollData (namely, new poll timeout thereof)
     if (fds[1].revents & POLLIN)
     {
@@ -839,6 +3351,25 @@ bool Connection::waitForNextEvent()
     return true;
 }
 
+void Connection::busyPollForEvents()
+{
+    const auto duration = busyPollDuration_.load(std::memory_order_relaxed);
+    if (duration == std::chrono::microseconds::zero())
+        return;
+
+    // The loop stays in the processing state meanwhile, so other threads don't signal the event fd and their changes
+    // are picked up simply by processing. Only the exit notification is checked for here, and left for poll() to handle.
+    struct pollfd exitFd{loopExitFd_.fd, POLLIN, 0};
+    auto deadline = now() + duration;
+    while (!isClosedByPeer_.load(std::memory_order_relaxed) && poll(&exitFd, 1, 0) == 0)
+    {
+        if (processPendingEvent())
+            deadline = now() + duration; // Spin for the whole duration again after each event
+        else if (now() >= deadline)
+            break;
+    }
+}
+
 bool Connection::arePendingMessagesInQueues() const
 {
     uint64_t readQueueSize{};
@@ -852,6 +3383,13 @@ bool Connection::arePendingMessagesInQueues() const
 
 Message Connection::getCurrentlyProcessedMessage() const
 {
+    // Method handlers invoked in the dispatch pool threads run outside of sd_bus_process()
+    if (const auto* dispatchedMsg = MethodCallDispatchPool::getCurrentlyDispatchedMessage())
+        return *dispatchedMsg;
+    // As do handlers of locally dispatched calls
+    if (locallyDispatchedMessage_ != nullptr)
+        return *locallyDispatchedMessage_;
+
     auto* sdbusMsg = sdbus_->sd_bus_get_current_message(bus_.get());
 
     return Message::Factory::create<Message>(sdbusMsg, const_cast<Connection*>(this));
@@ -875,7 +3413,10 @@ int Connection::sdbus_match_callback(sd_bus_message *sdbusMessage, void *userDat
 
     auto message = Message::Factory::create<PlainMessage>(sdbusMessage, &matchInfo->connection);
 
-    auto ok = invokeHandlerAndCatchErrors([&](){ matchInfo->callback(std::move(message)); }, retError);
+    auto ok = matchInfo->connection.metrics_.measureHandler([&]
+    {
+        return invokeHandlerAndCatchErrors([&](){ matchInfo->callback(std::move(message)); }, retError);
+    });
 
     return ok ? 0 : -1;
 }
@@ -888,7 +3429,138 @@ int Connection::sdbus_match_install_callback(sd_bus_message *sdbusMessage, void
 
     auto message = Message::Factory::create<PlainMessage>(sdbusMessage, &matchInfo->connection);
 
-    auto ok = invokeHandlerAndCatchErrors([&](){ matchInfo->installCallback(std::move(message)); }, retError);
+    auto ok = matchInfo->connection.metrics_.measureHandler([&]
+    {
+        return invokeHandlerAndCatchErrors([&](){ matchInfo->installCallback(std::move(message)); }, retError);
+    });
+
+    return ok ? 0 : -1;
+}
+
+int Connection::sdbus_introspection_filter(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError)
+{
+    auto* connection = static_cast<Connection*>(userData);
+    assert(connection != nullptr);
+
+    if (sd_bus_message_is_method_call(sdbusMessage, "org.freedesktop.DBus.Introspectable", "Introspect") <= 0)
+        return 0;
+
+    auto call = Message::Factory::create<MethodCall>(sdbusMessage, connection);
+    if (!call.isEmpty())
+        return 0; // Let sd-bus reply with an error
+
+    auto xml = connection->introspectionCache_.getXml(call.getPath(), connection->trustedBus_.load(std::memory_order_relaxed));
+    if (!xml)
+        return 0;
+
+    auto ok = invokeHandlerAndCatchErrors([&]
+    {
+        auto reply = call.createReply();
+        reply << *xml;
+        reply.send();
+    }, retError);
+
+    // The call has been handled, so it doesn't continue to sd-bus object dispatch
+    return ok ? 1 : -1;
+}
+
+int Connection::sdbus_managed_objects_filter(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError)
+{
+    auto* connection = static_cast<Connection*>(userData);
+    assert(connection != nullptr);
+
+    if (sd_bus_message_is_method_call(sdbusMessage, "org.freedesktop.DBus.ObjectManager", "GetManagedObjects") <= 0)
+        return 0;
+
+    auto call = Message::Factory::create<MethodCall>(sdbusMessage, connection);
+    if (!call.isEmpty())
+        return 0; // Let sd-bus reply with an error
+
+    bool handled{};
+    auto ok = invokeHandlerAndCatchErrors([&]
+    {
+        auto reply = call.createReply();
+        handled = connection->managedObjectsCache_.writeManagedObjects(connection->bus_.get(), call.getPath(), reply);
+        if (handled)
+            reply.send();
+    }, retError);
+
+    // A handled call doesn't continue to sd-bus object dispatch
+    return !ok ? -1 : handled ? 1 : 0;
+}
+
+int Connection::sdbus_traffic_capture_filter(sd_bus_message *sdbusMessage, void *userData, sd_bus_error */*retError*/)
+{
+    auto* capture = static_cast<TrafficCaptureInfo*>(userData);
+    assert(capture != nullptr);
+
+    uint8_t type{};
+    if (sd_bus_message_get_type(sdbusMessage, &type) < 0)
+        return 0;
+
+    auto message = Message::Factory::create<PlainMessage>(sdbusMessage, &capture->connection);
+    capture->recorder.record(message, static_cast<CapturedMessage::Type>(type));
+
+    // Recording is transparent, the message continues to the dispatch
+    return 0;
+}
+
+int Connection::sdbus_name_request_reply_handler(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError)
+{
+    auto* request = static_cast<NameRequest*>(userData);
+    assert(request != nullptr);
+    auto& connection = request->connection;
+
+    // A floating request is done with at the complete scope exit, after its callback has been invoked. Releasing
+    // the request acquires global sd-bus mutex, so we must do it out of the `floatingNameRequestsMutex_' critical section.
+    SCOPE_EXIT
+    {
+        Slot slot;
+        {
+            std::lock_guard lock(connection.floatingNameRequestsMutex_);
+            auto& requests = connection.floatingNameRequests_;
+            auto it = std::find_if(requests.begin(), requests.end(), [request](const Slot& item){ return item.get() == request; });
+            if (it != requests.end())
+            {
+                slot = std::move(*it);
+                requests.erase(it);
+            }
+        }
+    };
+
+    auto ok = connection.metrics_.measureHandler([&]
+    {
+        return invokeHandlerAndCatchErrors([&]
+        {
+            std::optional<Error> error;
+            if (const auto* sdbusError = sd_bus_message_get_error(sdbusMessage); sdbusError != nullptr)
+            {
+                error = Error(Error::Name{sdbusError->name}, sdbusError->message);
+            }
+            else
+            {
+                // Like sd_bus_request_name(), fail if the name is owned by someone else, or by us already
+                constexpr uint32_t DBUS_REQUEST_NAME_REPLY_EXISTS{3};
+                constexpr uint32_t DBUS_REQUEST_NAME_REPLY_ALREADY_OWNER{4};
+                auto reply = Message::Factory::create<MethodReply>(sdbusMessage, &connection);
+                uint32_t result{};
+                reply >> result;
+                if (result == DBUS_REQUEST_NAME_REPLY_EXISTS)
+                    error = createError(EEXIST, "Failed to request bus name");
+                else if (result == DBUS_REQUEST_NAME_REPLY_ALREADY_OWNER)
+                    error = createError(EALREADY, "Failed to request bus name");
+            }
+
+            if (!error)
+            {
+                std::lock_guard lock(connection.localDispatchMutex_);
+                connection.ownedNames_.insert(request->name);
+            }
+
+            if (request->callback)
+                request->callback(std::move(error));
+        }, retError);
+    });
 
     return ok ? 0 : -1;
 }
@@ -921,6 +3593,207 @@ bool Connection::EventFd::clear()
     return r >= 0;
 }
 
+namespace {
+    // Method call being handled by the current dispatch pool thread
+    thread_local const MethodCall* currentlyDispatchedMessage{};
+    // Cancellation flag of the jobs handled by the current dispatch pool thread
+    thread_local std::atomic<bool>* currentlyDispatchedJobCancelled{};
+}
+
+Connection::MethodCallDispatchPool::MethodCallDispatchPool( std::size_t threadCount
+                                                          , DispatchOrdering ordering
+                                                          , Connection& connection )
+    : ordering_(ordering)
+    , connection_(connection)
+{
+    workers_.reserve(threadCount + 1);
+    try
+    {
+        for (std::size_t i = 0; i <= threadCount; ++i)
+        {
+            auto& worker = *workers_.emplace_back(std::make_unique<Worker>());
+            worker.isHighPriority = (i == threadCount);
+            worker.thread = startThread(ThreadRole::MethodCallDispatch, [this, &worker](){ run(worker); });
+        }
+    }
+    catch (...)
+    {
+        // E.g. the thread creation policy couldn't be applied. Workers started so far must not outlive the pool.
+        stop();
+        throw;
+    }
+}
+
+Connection::MethodCallDispatchPool::~MethodCallDispatchPool()
+{
+    stop();
+}
+
+void Connection::MethodCallDispatchPool::stop()
+{
+    for (auto& worker : workers_)
+    {
+        {
+            std::lock_guard lock(worker->mutex);
+            worker->exit = true;
+        }
+        worker->cond.notify_one();
+    }
+
+    for (auto& worker : workers_)
+        if (worker->thread.joinable())
+            worker->thread.join();
+}
+
+void Connection::MethodCallDispatchPool::dispatch(MethodCall call, method_callback callback, const void* owner, bool isHighPriority)
+{
+    // Calls with the same ordering key always go to the same worker, which preserves their order. High priority calls
+    // go to their dedicated worker, in the order of their arrival, but not in order with other calls of the same key.
+    auto index = workers_.size() - 1;
+    if (!isHighPriority)
+    {
+        const char* key = ordering_ == DispatchOrdering::PerObjectPath ? call.getPath() : call.getSender();
+        index = std::hash<std::string_view>{}(key != nullptr ? key : "") % (workers_.size() - 1);
+    }
+    auto& worker = *workers_[index];
+
+    pendingJobsOf(worker).fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard lock(worker.mutex);
+        worker.jobs.push_back({std::move(call), std::move(callback), owner});
+    }
+    worker.cond.notify_one();
+}
+
+std::vector<MethodCall> Connection::MethodCallDispatchPool::cancel(const void* owner, bool waitForHandledCalls)
+{
+    // The jobs, with their copies of the owner's callbacks, are destroyed outside of worker locks
+    std::vector<Job> cancelled;
+    for (auto& worker : workers_)
+    {
+        std::unique_lock lock(worker->mutex);
+        const auto cancelledBefore = cancelled.size();
+        for (auto it = worker->jobs.begin(); it != worker->jobs.end();)
+        {
+            if (it->owner != owner)
+            {
+                ++it;
+                continue;
+            }
+            cancelled.push_back(std::move(*it));
+            it = worker->jobs.erase(it);
+        }
+        pendingJobsOf(*worker).fetch_sub(cancelled.size() - cancelledBefore, std::memory_order_relaxed);
+
+        // The owner's handler may be the one cancelling its calls, e.g. when an object unregisters itself
+        if (worker->thread.get_id() == std::this_thread::get_id() || worker->handledOwner != owner)
+            continue;
+        if (waitForHandledCalls)
+            worker->jobDone.wait(lock, [&](){ return worker->handledOwner != owner; });
+        else
+            worker->isHandledJobCancelled.store(true, std::memory_order_relaxed);
+    }
+
+    std::vector<MethodCall> calls;
+    calls.reserve(cancelled.size());
+    for (auto& job : cancelled)
+        calls.push_back(std::move(job.call));
+
+    return calls;
+}
+
+const Message* Connection::MethodCallDispatchPool::getCurrentlyDispatchedMessage()
+{
+    return currentlyDispatchedMessage;
+}
+
+void Connection::MethodCallDispatchPool::run(Worker& worker)
+{
+    currentlyDispatchedJobCancelled = &worker.isHandledJobCancelled;
+
+    std::unique_lock lock(worker.mutex);
+    while (true)
+    {
+        worker.cond.wait(lock, [&worker](){ return !worker.jobs.empty() || worker.exit; });
+
+        // Pending method calls are still handled before the worker exits
+        if (worker.jobs.empty())
+            return;
+
+        {
+            auto job = std::move(worker.jobs.front());
+            worker.jobs.pop_front();
+            worker.handledOwner = job.owner;
+            worker.isHandledJobCancelled.store(false, std::memory_order_relaxed);
+            lock.unlock();
+
+            connection_.handleDispatchedMethodCall(job.call, job.callback);
+        } // The job, with its copy of the callback, is gone before the owner stops counting as being handled
+
+        pendingJobsOf(worker).fetch_sub(1, std::memory_order_relaxed);
+        connection_.onPooledMethodCallDone();
+
+        lock.lock();
+        worker.handledOwner = nullptr;
+        worker.jobDone.notify_all();
+    }
+}
+
+std::atomic<std::size_t>& Connection::MethodCallDispatchPool::pendingJobsOf(const Worker& worker)
+{
+    return worker.isHighPriority ? pendingHighPriorityJobs_ : pendingJobs_;
+}
+
+const MethodCall* Connection::MethodCallDispatchPool::takeCancelledCall(sd_bus_message* sdbusMsg)
+{
+    if (currentlyDispatchedJobCancelled == nullptr || currentlyDispatchedMessage == nullptr)
+        return nullptr;
+
+    uint64_t replyCookie{};
+    if (sd_bus_message_get_reply_cookie(sdbusMsg, &replyCookie) < 0 || replyCookie != currentlyDispatchedMessage->getCookie())
+        return nullptr;
+
+    return currentlyDispatchedJobCancelled->exchange(false, std::memory_order_relaxed) ? currentlyDispatchedMessage : nullptr;
+}
+
+std::optional<Error> Connection::MethodCallDispatchPool::handle(MethodCall& call, const method_callback& callback)
+{
+    currentlyDispatchedMessage = &call;
+    SCOPE_EXIT{ currentlyDispatchedMessage = nullptr; };
+
+    // The reply is sent by the method callback itself, so here we only turn exceptions into error replies,
+    // just like sd-bus does with errors reported from method callbacks invoked in the event loop thread
+    std::optional<Error> error;
+    try
+    {
+        callback(call);
+        return std::nullopt;
+    }
+    catch (const Error& e)
+    {
+        error = e;
+    }
+    catch (const std::exception& e)
+    {
+        error = Error{SDBUSCPP_ERROR_NAME, e.what()};
+    }
+    catch (...)
+    {
+        error = Error{SDBUSCPP_ERROR_NAME, "Unknown error occurred"};
+    }
+
+    try
+    {
+        call.createErrorReply(*error).send();
+    }
+    catch (const Error&)
+    {
+        // E.g. the connection is closed or the caller is gone; the worker thread must survive that
+    }
+
+    return error;
+}
+
 } // namespace sdbus::internal
 
 namespace sdbus {
@@ -939,6 +3812,14 @@ std::chrono::microseconds IConnection::PollData::getRelativeTimeout() const
         return std::max(std::chrono::duration_cast<std::chrono::microseconds>(timeout - now()), zero);
 }
 
+std::chrono::microseconds IConnection::Metrics::Histogram::getBucketUpperBound(std::size_t index)
+{
+    if (index + 1 >= BUCKET_COUNT)
+        return std::chrono::microseconds::max();
+
+    return std::chrono::microseconds{int64_t{1} << index};
+}
+
 int IConnection::PollData::getPollTimeout() const
 {
     const auto relativeTimeout = getRelativeTimeout();
@@ -965,6 +3846,37 @@ namespace sdbus {
 
 using internal::Connection;
 
+namespace {
+    // Opens the connection in a thread of its own, which is subject to the thread creation policy like other threads of sdbus-c++
+    std::future<std::unique_ptr<sdbus::IConnection>> createConnectionInBackground(std::function<std::unique_ptr<sdbus::IConnection>()> factory)
+    {
+        auto promise = std::make_shared<std::promise<std::unique_ptr<sdbus::IConnection>>>();
+        auto future = promise->get_future();
+
+        try
+        {
+            internal::startThread(ThreadRole::ConnectionSetup, [promise, factory = std::move(factory)]()
+            {
+                try
+                {
+                    promise->set_value(factory());
+                }
+                catch (...)
+                {
+                    promise->set_exception(std::current_exception());
+                }
+            }).detach();
+        }
+        catch (...)
+        {
+            // The thread creation policy couldn't be applied, so the factory hasn't been run
+            promise->set_exception(std::current_exception());
+        }
+
+        return future;
+    }
+}
+
 std::unique_ptr<sdbus::IConnection> createBusConnection()
 {
     auto interface = std::make_unique<sdbus::internal::SdBus>();
@@ -978,6 +3890,16 @@ std::unique_ptr<sdbus::IConnection> createBusConnection(const ServiceName& name)
     return conn;
 }
 
+std::future<std::unique_ptr<sdbus::IConnection>> createBusConnectionAsync()
+{
+    return createConnectionInBackground([]{ return createBusConnection(); });
+}
+
+std::future<std::unique_ptr<sdbus::IConnection>> createBusConnectionAsync(const ServiceName& name)
+{
+    return createConnectionInBackground([name]{ return createBusConnection(name); });
+}
+
 std::unique_ptr<sdbus::IConnection> createSystemBusConnection()
 {
     auto interface = std::make_unique<sdbus::internal::SdBus>();
@@ -991,6 +3913,16 @@ std::unique_ptr<sdbus::IConnection> createSystemBusConnection(const ServiceName&
     return conn;
 }
 
+std::future<std::unique_ptr<sdbus::IConnection>> createSystemBusConnectionAsync()
+{
+    return createConnectionInBackground([]{ return createSystemBusConnection(); });
+}
+
+std::future<std::unique_ptr<sdbus::IConnection>> createSystemBusConnectionAsync(const ServiceName& name)
+{
+    return createConnectionInBackground([name]{ return createSystemBusConnection(name); });
+}
+
 std::unique_ptr<sdbus::IConnection> createSessionBusConnection()
 {
     auto interface = std::make_unique<sdbus::internal::SdBus>();
@@ -1004,6 +3936,16 @@ std::unique_ptr<sdbus::IConnection> createSessionBusConnection(const ServiceName
     return conn;
 }
 
+std::future<std::unique_ptr<sdbus::IConnection>> createSessionBusConnectionAsync()
+{
+    return createConnectionInBackground([]{ return createSessionBusConnection(); });
+}
+
+std::future<std::unique_ptr<sdbus::IConnection>> createSessionBusConnectionAsync(const ServiceName& name)
+{
+    return createConnectionInBackground([name]{ return createSessionBusConnection(name); });
+}
+
 std::unique_ptr<sdbus::IConnection> createSessionBusConnectionWithAddress(const std::string &address)
 {
     auto interface = std::make_unique<sdbus::internal::SdBus>();
@@ -1034,6 +3976,84 @@ std::unique_ptr<sdbus::IConnection> createServerBus(int fd)
     return std::make_unique<sdbus::internal::Connection>(std::move(interface), Connection::server_bus, fd);
 }
 
+std::future<void> IConnection::requestNameAsync(const ServiceName& name, with_future_t)
+{
+    auto promise = std::make_shared<std::promise<void>>();
+    auto future = promise->get_future();
+
+    requestNameAsync(name, [promise = std::move(promise)](std::optional<Error> error) noexcept
+    {
+        if (!error)
+            promise->set_value();
+        else
+            promise->set_exception(std::make_exception_ptr(*std::move(error)));
+    });
+
+    return future;
+}
+
+NameRequestAwaitable IConnection::requestNameAsync(const ServiceName& name, with_awaitable_t)
+{
+    return NameRequestAwaitable{*this, name};
+}
+
+NameRequestAwaitable::NameRequestAwaitable(IConnection& connection, std::string name)
+    : connection_(connection)
+    , name_(std::move(name))
+{
+}
+
+bool NameRequestAwaitable::await_ready() const noexcept
+{
+    return false;
+}
+
+bool NameRequestAwaitable::await_suspend(std::coroutine_handle<> handle)
+{
+    handle_ = handle;
+
+    request_ = connection_.requestNameAsync(ServiceName{name_}, [this](std::optional<Error> error)
+    {
+        if (error)
+            error_ = std::make_exception_ptr(*std::move(error));
+
+        // If the coroutine has been suspended already, resume it right here in the event loop thread.
+        // `this` must not be touched afterwards, as the coroutine may have destroyed the awaitable.
+        if (ready_.exchange(true, std::memory_order_acq_rel))
+            handle_.resume();
+    }, return_slot);
+
+    // The reply may have been delivered by the event loop thread already. If so, don't suspend at all.
+    return !ready_.exchange(true, std::memory_order_acq_rel);
+}
+
+void NameRequestAwaitable::await_resume()
+{
+    if (error_)
+        std::rethrow_exception(error_);
+}
+
+namespace {
+// Deadline of the innermost DeadlineScope of the current thread
+thread_local std::optional<std::chrono::steady_clock::time_point> currentDeadline{};
+}
+
+DeadlineScope::DeadlineScope(std::chrono::steady_clock::time_point deadline)
+    : previous_(currentDeadline)
+{
+    currentDeadline = previous_ ? std::min(*previous_, deadline) : deadline;
+}
+
+DeadlineScope::~DeadlineScope()
+{
+    currentDeadline = previous_;
+}
+
+std::optional<std::chrono::steady_clock::time_point> DeadlineScope::current()
+{
+    return currentDeadline;
+}
+
 std::unique_ptr<sdbus::IConnection> createBusConnection(sd_bus *bus)
 {
     SDBUS_THROW_ERROR_IF(bus == nullptr, "Invalid bus argument", EINVAL);
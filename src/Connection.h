@@ -31,14 +31,34 @@
 
 #include "sdbus-c++/Message.h"
 
+#include "HandlerProfiler.h"
 #include "IConnection.h"
 #include "ISdBus.h"
+#include "IntrospectionCache.h"
+#include "ManagedObjectsCache.h"
+#include "MethodCallScheduler.h"
+#include "MetricsCollector.h"
 #include "ScopeGuard.h"
-
+#include "StartupProfiler.h"
+#include "TimerWheel.h"
+#include "TrafficCapture.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <set>
 #include <string>
+#include <string_view>
 #include SDBUS_HEADER
 #include <thread>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 // Forward declarations
@@ -93,21 +113,55 @@ namespace sdbus::internal {
         ~Connection() override;
 
         void requestName(const ServiceName & name) override;
+        void requestNameAsync(const ServiceName& name, name_request_handler callback) override;
+        [[nodiscard]] Slot requestNameAsync(const ServiceName& name, name_request_handler callback, return_slot_t) override;
+        using IConnection::requestNameAsync;
         void releaseName(const ServiceName& name) override;
+        void watchName(const ServiceName& name) override;
+        [[nodiscard]] Slot watchName(const ServiceName& name, return_slot_t) override;
+        [[nodiscard]] BusName getWatchedNameOwner(const ServiceName& name) const override;
         [[nodiscard]] BusName getUniqueName() const override;
         void enterEventLoop() override;
         void enterEventLoopAsync() override;
+        void enableMethodCallDispatchPool(std::size_t threadCount, DispatchOrdering ordering) override;
+        void setEventLoopBusyPollDuration(std::chrono::microseconds duration) override;
         void leaveEventLoop() override;
         [[nodiscard]] PollData getEventLoopPollData() const override;
         bool processPendingEvent() override;
+        std::size_t processPendingEvents(std::size_t maxCount, std::chrono::microseconds maxDuration) override;
         Message getCurrentlyProcessedMessage() const override;
 
         void addObjectManager(const ObjectPath& objectPath) override;
         Slot addObjectManager(const ObjectPath& objectPath, return_slot_t) override;
+        void registerObjects(std::vector<ObjectRegistration> batch, std::size_t preparationThreads = 1) override;
+        void unregisterObjects(std::span<IObject* const> objects) override;
 
         void setMethodCallTimeout(uint64_t timeout) override;
         [[nodiscard]] uint64_t getMethodCallTimeout() const override;
 
+        void enableMetrics(bool enabled = true) override;
+        void enableBusLockProfiling(bool enabled = true, uint32_t samplingInterval = 16) override;
+        void enableCredentialsCache(bool enabled = true) override;
+        void enableIntrospectionCache(bool enabled = true) override;
+        void enableManagedObjectsCache(bool enabled = true) override;
+        void enableLocalDispatch(bool enabled = true) override;
+        void enableSubmissionQueue(bool enabled = true) override;
+        void setMemoryResource(std::pmr::memory_resource* resource) override;
+        [[nodiscard]] Metrics getMetrics() const override;
+        void resetMetrics() override;
+        [[nodiscard]] ResourceUsage getResourceUsage() const override;
+        void setOutboundQueueLimits(OutboundQueueLimits limits) override;
+        void setMethodCallAdmissionLimits(MethodCallAdmissionLimits limits) override;
+        void enableHandlerProfiling(bool enabled = true) override;
+        void setSlowHandlerWatchdog(SlowHandlerWatchdog watchdog) override;
+        [[nodiscard]] std::vector<HandlerProfile> getHandlerProfiles() const override;
+        void resetHandlerProfiles() override;
+        [[nodiscard]] Slot exposeHandlerProfiles(const ObjectPath& objectPath, return_slot_t) override;
+        void enableStartupProfiling(bool enabled = true) override;
+        [[nodiscard]] StartupProfile getStartupProfile() const override;
+        void setTracer(std::shared_ptr<ITracer> tracer) override;
+        [[nodiscard]] Slot captureTraffic(const std::string& filePath, return_slot_t) override;
+
         void addMatch(const std::string& match, message_handler callback) override;
         [[nodiscard]] Slot addMatch(const std::string& match, message_handler callback, return_slot_t) override;
         void addMatchAsync(const std::string& match, message_handler callback, message_handler installCallback) override;
@@ -125,6 +179,22 @@ namespace sdbus::internal {
                             , const sd_bus_vtable* vtable
                             , void* userData
                             , return_slot_t ) override;
+        Slot addFallbackVTable( const ObjectPath& prefix
+                              , const InterfaceName& interfaceName
+                              , const sd_bus_vtable* vtable
+                              , sd_bus_object_find_t find
+                              , void* userData
+                              , return_slot_t ) override;
+        Slot addNodeEnumerator( const ObjectPath& prefix
+                              , sd_bus_node_enumerator_t callback
+                              , void* userData
+                              , return_slot_t ) override;
+        Slot addFallbackHandler( const ObjectPath& prefix
+                               , sd_bus_message_handler_t callback
+                               , void* userData
+                               , return_slot_t ) override;
+        std::vector<Slot> addObjectVTables(std::span<const ObjectVTable> vtables, return_slot_t) override;
+        void removeObjects(std::span<const char* const> objectPaths, std::span<sd_bus_slot* const> slots) override;
 
         [[nodiscard]] PlainMessage createPlainMessage() const override;
         [[nodiscard]] MethodCall createMethodCall( const ServiceName& destination
@@ -148,6 +218,10 @@ namespace sdbus::internal {
         void emitPropertiesChangedSignal( const char* objectPath
                                         , const char* interfaceName
                                         , const std::vector<PropertyName>& propNames ) override;
+        void coalescePropertiesChangedSignal( const char* objectPath
+                                            , const char* interfaceName
+                                            , const std::vector<PropertyName>& propNames
+                                            , std::chrono::microseconds interval ) override;
         void emitInterfacesAddedSignal(const ObjectPath& objectPath) override;
         void emitInterfacesAddedSignal( const ObjectPath& objectPath
                                       , const std::vector<InterfaceName>& interfaces ) override;
@@ -160,6 +234,16 @@ namespace sdbus::internal {
                                   , const char* interfaceName
                                   , const char* signalName
                                   , sd_bus_message_handler_t callback
+                                  , sd_bus_message_handler_t installCallback
+                                  , void* userData
+                                  , return_slot_t ) override;
+        Slot registerSignalHandler( const char* sender
+                                  , const char* objectPath
+                                  , const char* interfaceName
+                                  , const char* signalName
+                                  , const std::vector<SignalArgFilter>& argFilters
+                                  , sd_bus_message_handler_t callback
+                                  , sd_bus_message_handler_t installCallback
                                   , void* userData
                                   , return_slot_t ) override;
 
@@ -171,12 +255,28 @@ namespace sdbus::internal {
         sd_bus_creds* decrementCredsRefCount(sd_bus_creds* creds) override;
 
         sd_bus_message* callMethod(sd_bus_message* sdbusMsg, uint64_t timeout) override;
+        int callMethod(sd_bus_message* sdbusMsg, uint64_t timeout, sd_bus_error* sdbusError, sd_bus_message** sdbusReply) override;
         Slot callMethodAsync(sd_bus_message* sdbusMsg, sd_bus_message_handler_t callback, void* userData, uint64_t timeout, return_slot_t) override;
+        int callMethodsAsync(sd_bus_message** sdbusMsgs, const uint64_t* timeouts, sd_bus_message_handler_t callback, void** userData, std::size_t count, std::vector<Slot>& slots) override;
         void sendMessage(sd_bus_message* sdbusMsg) override;
+        void sendMessages(sd_bus_message** sdbusMsgs, std::size_t count) override;
+        void sendSignal(sd_bus_message* sdbusMsg) override;
+        void sendSignals(sd_bus_message** sdbusMsgs, std::size_t count) override;
+
+        [[nodiscard]] MetricsCollector& getMetricsCollector() override;
+        [[nodiscard]] HandlerProfiler& getHandlerProfiler() override;
+        [[nodiscard]] StartupProfiler& getStartupProfiler() override;
+        [[nodiscard]] std::shared_ptr<ITracer> getTracer() const override;
+        [[nodiscard]] const std::shared_ptr<std::pmr::memory_resource>& getMemoryResource() const override;
 
         sd_bus_message* createMethodReply(sd_bus_message* sdbusMsg) override;
         sd_bus_message* createErrorReplyMessage(sd_bus_message* sdbusMsg, const Error& error) override;
 
+        bool dispatchMethodCall(MethodCall& call, const method_callback& callback, const void* owner, bool isHighPriority) override;
+        void cancelMethodCalls(const void* owner) override;
+        void post(std::function<void()> work) override;
+        [[nodiscard]] Slot addDestructionHandler(std::function<void()> handler) override;
+
     private:
         using BusFactory = std::function<int(sd_bus**)>;
         using BusPtr = std::unique_ptr<sd_bus, std::function<sd_bus*(sd_bus*)>>;
@@ -186,9 +286,189 @@ namespace sdbus::internal {
         BusPtr openPseudoBus();
         void finishHandshake(sd_bus* bus);
         bool waitForNextEvent();
+        void busyPollForEvents();
 
         [[nodiscard]] bool arePendingMessagesInQueues() const;
 
+        // PropertiesChanged emissions deferred in the outbound queue overflow state, per object path and interface.
+        // An empty set of property names stands for all properties of the interface.
+        using DeferredPropertiesChanges = std::map<std::pair<std::string, std::string>, std::set<std::string>>;
+
+        struct OutboundQueueState
+        {
+            bool overflown{};
+            OutboundQueueOverflowPolicy policy{};
+        };
+
+        enum class SignalAdmission { Send, Drop, Defer };
+
+        [[nodiscard]] uint64_t getOutboundQueueSize() const;
+        OutboundQueueState refreshOutboundQueueState();
+        SignalAdmission admitSignal(bool isPropertiesChanged);
+        bool deferPropertiesChange(const char* objectPath, const char* interfaceName, const std::vector<PropertyName>& propNames);
+        void emitDeferredPropertiesChanges(const DeferredPropertiesChanges& changes);
+        static void mergePropertyNames(std::set<std::string>& names, const std::vector<PropertyName>& propNames);
+        bool emitDueCoalescedPropertiesChanges();
+
+        // Method call waiting in the admission queue, along with the handler it's destined for
+        struct ScheduledMethodCall
+        {
+            MethodCall call;
+            method_callback callback;
+            const void* owner{};
+            bool isHighPriority{};
+        };
+
+        void admitMethodCall(MethodCall& call, const method_callback& callback, const void* owner, bool isHighPriority);
+        bool handleScheduledMethodCall(bool isBusIdle);
+        [[nodiscard]] bool canHandleScheduledMethodCall() const;
+        void onPooledMethodCallDone();
+        // Handles a method call dispatched to the pool or scheduled by admission control, profiled and traced
+        void handleDispatchedMethodCall(MethodCall& call, const method_callback& callback);
+        void doEmitPropertiesChangedSignal(const char* objectPath, const char* interfaceName, const std::vector<PropertyName>& propNames);
+
+        // An in-flight async method call, whose timeout is tracked in the connection's timer wheel instead of in sd-bus
+        struct AsyncCall : TimerWheel::Timer
+        {
+            AsyncCall(sd_bus_message_handler_t callback, void* userData, Connection& connection, std::pmr::memory_resource& memoryResource)
+                : callback(callback), userData(userData), connection(connection), memoryResource(memoryResource)
+            {
+                connection.asyncCallCount_.fetch_add(1, std::memory_order_relaxed);
+            }
+            ~AsyncCall()
+            {
+                connection.asyncCallCount_.fetch_sub(1, std::memory_order_relaxed);
+            }
+
+            sd_bus_message_handler_t callback;
+            void* userData;
+            sd_bus_message* call{}; // Kept for creating the error reply on timeout
+            sd_bus_slot* slot{};
+            Connection& connection;
+            std::pmr::memory_resource& memoryResource; // Where the call is allocated from
+            // Released calls are not dispatched anymore, and their resources are freed in a batch by the event loop.
+            // A call released by another thread while it's being dispatched waits for the dispatch to finish instead.
+            enum class State { Pending, Dispatching, Completed, Released };
+            std::atomic<State> state{State::Pending};
+            AsyncCall* nextReleased{}; // Link in the stack of released calls
+            uint32_t localCookie{}; // Cookie of a call dispatched locally (see enableLocalDispatch()), zero for calls over the bus
+        };
+
+        // Synchronous call made asynchronously, whose reply is received by the event loop thread and handed over to the caller
+        struct SyncCall
+        {
+            std::mutex mutex;
+            std::condition_variable cond;
+            sd_bus_message* reply{};
+            Connection& connection;
+            bool abandoned{}; // The event loop thread has exited, nothing will process the reply
+        };
+
+        // Timeouts this long (e.g. UINT64_MAX meaning no timeout) are not tracked, the call waits for its reply indefinitely
+        inline static constexpr uint64_t MAX_TRACKED_TIMEOUT{std::chrono::microseconds(std::chrono::hours(24 * 365 * 100)).count()};
+
+        [[nodiscard]] uint64_t applyCallDeadline(uint64_t timeout) const;
+        [[nodiscard]] std::optional<uint64_t> clampToCallDeadline(uint64_t timeout) const;
+        int doCallMethod(sd_bus_message* sdbusMsg, uint64_t timeout, sd_bus_error* sdbusError, sd_bus_message** sdbusReply);
+        int doCallMethodViaEventLoop(sd_bus_message* sdbusMsg, uint64_t timeout, sd_bus_error* sdbusError, sd_bus_message** sdbusReply);
+        void abandonSyncCallsViaEventLoop();
+        int doCallMethodAsync(sd_bus_message* sdbusMsg, sd_bus_message_handler_t callback, void* userData, uint64_t timeout, Slot& slot);
+        void unwatchName(const std::string& name);
+        std::string queryNameOwner(const std::string& name) const;
+        bool resolveWatchedName(const char* name, std::string& owner) const;
+        void dropCachedCredentials(const std::string& uniqueName);
+        sd_bus_creds* cacheCredentials(const char* sender, sd_bus_creds* creds, uint64_t mask);
+        void clearCredentialsCache();
+        void releaseAsyncCall(AsyncCall* asyncCall);
+        void freeAsyncCall(AsyncCall* asyncCall);
+        void freeReleasedAsyncCalls();
+        bool beginAsyncCallDispatch(AsyncCall& asyncCall);
+        void endAsyncCallDispatch(AsyncCall& asyncCall);
+        bool expireAsyncCalls();
+        void timeOutAsyncCall(AsyncCall& asyncCall);
+        static int sdbus_async_call_reply_handler(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError);
+        static int sdbus_sync_call_reply_handler(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError);
+
+        // Local dispatch of method calls between connections of the process. Calls and replies are handed over between connections
+        // as plain messages, so that neither side ever takes the other's sd-bus lock, lest two connections calling each other from
+        // their handlers deadlock.
+        struct LocalReply
+        {
+            std::optional<Error> error;
+            PlainMessage body; // Arguments of a method return
+        };
+
+        // Method call handed over to the called connection, waiting in its queue for its event loop
+        struct LocalMethodCall
+        {
+            uint32_t cookie; // Unique within the process, the reply is routed back by it
+            Connection* caller;
+            std::string sender; // Unique name of the caller
+            std::string destination;
+            std::string objectPath;
+            std::string interfaceName;
+            std::string methodName;
+            PlainMessage arguments;
+        };
+
+        // Origin of a handled method call, for its reply to be routed back
+        struct LocalCallOrigin
+        {
+            Connection* caller;
+            std::string sender;
+        };
+
+        // Synchronous caller waiting for the reply to its locally dispatched call
+        struct LocalSyncCall
+        {
+            std::mutex mutex;
+            std::condition_variable cond;
+            std::optional<LocalReply> reply;
+        };
+
+        // Caller's record of a locally dispatched call, waiting either in a synchronous caller or as an async call
+        struct LocalCallWaiter
+        {
+            Connection* target;
+            LocalSyncCall* syncCall;
+            AsyncCall* asyncCall;
+        };
+
+        std::optional<uint32_t> dispatchMethodCallLocally(sd_bus_message* sdbusMsg, LocalCallWaiter waiter);
+        Connection* findLocalDispatchTarget( const char* destination
+                                           , const char* objectPath
+                                           , const char* interfaceName
+                                           , const char* methodName
+                                           , const char* signature
+                                           , std::string& sender );
+        [[nodiscard]] bool isLocalDispatchTarget(std::string_view name) const;
+        [[nodiscard]] static bool isInLocalDispatchRegistry(const Connection* connection);
+        bool callMethodAsyncLocally(sd_bus_message* sdbusMsg, AsyncCall& asyncCall);
+        int awaitLocalReply(sd_bus_message* sdbusMsg, uint32_t cookie, LocalSyncCall& syncCall, uint64_t timeout, sd_bus_error* sdbusError, sd_bus_message** sdbusReply);
+        void abandonLocalCall(uint32_t cookie);
+        bool handleLocalMethodCall();
+        int invokeLocalMethodCall(LocalMethodCall& localCall);
+        bool replyLocally(sd_bus_message* sdbusMsg);
+        static void deliverLocalReply(Connection* caller, uint32_t cookie, LocalReply reply);
+        void completeLocalCall(uint32_t cookie, LocalReply reply);
+        bool dispatchLocalReplies();
+        sd_bus_message* createLocalCallReply(sd_bus_message* sdbusCall, LocalReply& reply);
+        void failLocalCalls();
+
+        // A message sent from a thread other than the event loop thread, waiting to be sent out by the event loop
+        struct SubmittedMessage
+        {
+            sd_bus_message* message;
+            std::pmr::memory_resource& memoryResource; // Where the entry is allocated from
+            SubmittedMessage* next{};
+        };
+
+        [[nodiscard]] bool submitMessages(sd_bus_message** sdbusMsgs, std::size_t count);
+        bool sendSubmittedMessages();
+        bool doPostedWork();
+        void invokeDestructionHandlers();
+        void invalidateManagedObjects(std::string_view objectPath, std::string_view interfaceName = {});
+
         void notifyEventLoopToExit();
         void notifyEventLoopToWakeUpFromPoll();
         void wakeUpEventLoopIfMessagesInQueue();
@@ -199,6 +479,10 @@ namespace sdbus::internal {
 
         static int sdbus_match_callback(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError);
         static int sdbus_match_install_callback(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError);
+        static int sdbus_name_request_reply_handler(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError);
+        static int sdbus_introspection_filter(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError);
+        static int sdbus_managed_objects_filter(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError);
+        static int sdbus_traffic_capture_filter(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError);
 
     private:
 #ifndef SDBUS_basu // sd_event integration is not supported if instead of libsystemd we are based on basu
@@ -232,6 +516,18 @@ namespace sdbus::internal {
             Slot slot;
         };
 
+        struct TrafficCaptureInfo
+        {
+            TrafficRecorder recorder;
+            Connection& connection;
+            Slot slot;
+        };
+
+        // Upper bounds of a single batch of events processed in the internal event loop before re-entering poll,
+        // so that the loop still gets to its other duties (e.g. handling a request to exit) under a message flood
+        inline static constexpr std::size_t MAX_EVENTS_PER_BATCH{64};
+        inline static constexpr std::chrono::microseconds MAX_BATCH_DURATION{10'000};
+
         // sd-event integration
         struct SdEvent
         {
@@ -241,14 +537,211 @@ namespace sdbus::internal {
             Slot sdInternalEventSource;
         };
 
+        // Worker threads invoking method handlers outside of the event loop thread
+        class MethodCallDispatchPool
+        {
+        public:
+            MethodCallDispatchPool(std::size_t threadCount, DispatchOrdering ordering, Connection& connection);
+            ~MethodCallDispatchPool();
+
+            void dispatch(MethodCall call, method_callback callback, const void* owner, bool isHighPriority = false);
+            // Takes the queued calls of the owner out, and waits for its calls being handled by other workers to finish.
+            // If told not to wait, the workers finish those calls on their own, and their replies are replaced, see takeCancelledCall().
+            std::vector<MethodCall> cancel(const void* owner, bool waitForHandledCalls = true);
+            [[nodiscard]] bool hasFreeWorker() const { return pendingJobs_.load(std::memory_order_relaxed) < workers_.size() - 1; }
+            [[nodiscard]] std::size_t pendingJobs() const
+            {
+                return pendingJobs_.load(std::memory_order_relaxed) + pendingHighPriorityJobs_.load(std::memory_order_relaxed);
+            }
+            static const Message* getCurrentlyDispatchedMessage();
+            // Invokes the handler outside of sd_bus_process(), turning exceptions into error replies. Returns the replied error, if any.
+            static std::optional<Error> handle(MethodCall& call, const method_callback& callback);
+            // Returns the call handled by the current thread if the message replies to it and the owner's calls have been cancelled
+            // meanwhile without waiting for it, just once, so that the call gets the cancellation error instead of the reply
+            static const MethodCall* takeCancelledCall(sd_bus_message* sdbusMsg);
+
+        private:
+            struct Job
+            {
+                MethodCall call;
+                method_callback callback;
+                const void* owner{}; // Object whose handler the call is destined for
+            };
+
+            struct Worker
+            {
+                std::mutex mutex;
+                std::condition_variable cond;
+                std::condition_variable jobDone;
+                std::deque<Job> jobs;
+                bool isHighPriority{}; // Handles the high priority calls, apart from the others
+                const void* handledOwner{}; // Owner of the job being handled, if any
+                std::atomic<bool> isHandledJobCancelled{}; // The owner's calls were cancelled without waiting for the job
+                bool exit{};
+                std::thread thread;
+            };
+
+            void stop();
+            void run(Worker& worker);
+            std::atomic<std::size_t>& pendingJobsOf(const Worker& worker);
+
+        private:
+            DispatchOrdering ordering_;
+            Connection& connection_;
+            // The last worker is dedicated to high priority calls, so that they don't wait behind other calls being handled
+            std::vector<std::unique_ptr<Worker>> workers_;
+            std::atomic<std::size_t> pendingJobs_{}; // Dispatched jobs not yet handled, high priority ones aside
+            std::atomic<std::size_t> pendingHighPriorityJobs_{};
+        };
+
     private:
         std::unique_ptr<ISdBus> sdbus_;
+        // Resource of bookkeeping objects. The default pool stays alive with the connection even when replaced,
+        // since objects allocated from it before are given back to it.
+        std::shared_ptr<std::pmr::memory_resource> defaultMemoryResource_{std::make_shared<std::pmr::synchronized_pool_resource>()};
+        std::shared_ptr<std::pmr::memory_resource> memoryResource_{defaultMemoryResource_};
         BusPtr bus_;
         std::thread asyncLoopThread_;
+        std::atomic<std::thread::id> asyncLoopThreadId_{}; // For other threads to tell whether the loop thread runs, without touching asyncLoopThread_
+        // Sync calls waiting for their reply from the loop thread, which fails them when it exits. The loop thread id
+        // is set and cleared under the same mutex, so a call can't register with a loop thread that has already exited.
+        std::mutex syncCallsViaEventLoopMutex_;
+        std::vector<SyncCall*> syncCallsViaEventLoop_;
+        // State of the internal event loop, published for other threads to skip waking it up while it's processing
+        enum class EventLoopState { NotRunning, Processing, Polling };
+        std::atomic<EventLoopState> eventLoopState_{EventLoopState::NotRunning};
+        bool isPeerToPeer_{}; // Direct connection, whose closing by the peer ends the event loop
+        std::atomic<bool> isClosedByPeer_{false};
+        std::atomic<std::chrono::microseconds> busyPollDuration_{}; // How long the event loop spins for events before it blocks
         EventFd loopExitFd_; // To wake up event loop I/O polling to exit
         EventFd eventFd_; // To wake up event loop I/O polling to re-enter poll with fresh PollData values
+        // Watched well-known names and their owners. Owner is empty while the name has none, and unset until resolved.
+        struct WatchedName
+        {
+            std::size_t watchCount{};
+            std::optional<std::string> owner;
+            Slot ownerChangedMatch;
+        };
+        mutable std::mutex watchedNamesMutex_;
+        std::map<std::string, WatchedName, std::less<>> watchedNames_;
+        std::atomic<bool> hasWatchedNames_{false}; // Spares the lookup when creating method calls while nothing is watched
+        mutable std::mutex floatingMatchRulesMutex_;
         std::vector<Slot> floatingMatchRules_;
+        struct NameRequest
+        {
+            std::string name;
+            name_request_handler callback;
+            Connection& connection;
+            Slot slot;
+        };
+        mutable std::mutex floatingNameRequestsMutex_;
+        std::vector<Slot> floatingNameRequests_;
         std::unique_ptr<SdEvent> sdEvent_; // Integration of systemd sd-event event loop implementation
+        MetricsCollector metrics_;
+        HandlerProfiler handlerProfiler_;
+        StartupProfiler startupProfiler_;
+        // Spans in flight share the tracer they were opened with, so replacing the tracer doesn't destroy it under them
+        mutable std::mutex tracerMutex_;
+        std::shared_ptr<ITracer> tracer_;
+        std::atomic<ITracer*> tracerPtr_{}; // For the tracing hooks to check for a tracer with one relaxed load
+
+        // Deadlines of in-flight async method calls. The event loop is woken up by a new call only if its deadline
+        // precedes the one the loop waits for, and with the coarse-grained upper levels of the wheel that's rare.
+        mutable std::mutex asyncCallTimersMutex_;
+        TimerWheel asyncCallTimers_;
+        mutable std::atomic<std::chrono::nanoseconds> polledAsyncCallDeadline_{std::chrono::nanoseconds::max()};
+        std::recursive_mutex asyncCallExpiryMutex_; // Held while timed-out calls are being completed in the event loop thread
+        std::atomic<AsyncCall*> releasedAsyncCalls_{}; // Calls released outside of their dispatch, to be freed by the event loop
+        inline static thread_local AsyncCall* dispatchedAsyncCall_{}; // Call whose reply handler runs in this thread
+        std::atomic<std::size_t> asyncCallCount_{}; // Allocated calls, until they are freed
+
+        // Sender credentials per sender unique name, along with the sd-bus creds mask they were queried with.
+        // The cache is bounded; an arbitrary entry is evicted when it's full.
+        struct CachedCredentials
+        {
+            sd_bus_creds* creds;
+            uint64_t mask;
+        };
+        inline static constexpr std::size_t MAX_CACHED_CREDENTIALS{1024};
+        std::atomic<bool> credentialsCacheEnabled_{false};
+        mutable std::mutex credentialsCacheMutex_;
+        std::unordered_map<std::string, CachedCredentials> credentialsCache_;
+        Slot credentialsCacheInvalidation_; // NameOwnerChanged match dropping entries of disconnected senders
+
+        // Registrations of objects are mirrored in the introspection cache at all times, so that it can be enabled any time
+        IntrospectionCache introspectionCache_{/*enabled*/ false}; // Doesn't mirror registrations until enabled
+        std::atomic<bool> trustedBus_{};
+        Slot introspectionFilter_; // Filter answering Introspect calls from the cache, present while the cache is enabled
+
+        // Mirrored at all times too, with properties serialized only while the cache is enabled
+        ManagedObjectsCache managedObjectsCache_;
+        Slot managedObjectsFilter_; // Filter answering GetManagedObjects calls from the cache, present while the cache is enabled
+        std::atomic<bool> managedObjectsCacheEnabled_{false}; // Spares emitters invalidating a cache that holds no properties
+
+        // Limits of the outbound queue for emitted signals. The flag spares the queue length queries when there are no limits.
+        std::atomic<bool> outboundQueueLimited_{false};
+        mutable std::mutex outboundQueueMutex_;
+        OutboundQueueLimits outboundQueueLimits_;
+        bool outboundQueueOverflown_{};
+        std::condition_variable outboundQueueDrained_; // Wakes up emitters blocked in the overflow state by the Block policy
+        DeferredPropertiesChanges deferredPropertiesChanges_;
+
+        // Coalesced PropertiesChanged emissions, per object path and interface, with the time they are due at
+        struct CoalescedPropertiesChange
+        {
+            std::set<std::string> names; // Empty stands for all properties of the interface
+            std::chrono::nanoseconds due;
+        };
+        mutable std::mutex coalescedPropertiesChangesMutex_;
+        std::map<std::pair<std::string, std::string>, CoalescedPropertiesChange> coalescedPropertiesChanges_;
+        std::atomic<std::chrono::nanoseconds> nextCoalescedPropertiesChangeDue_{std::chrono::nanoseconds::max()};
+
+        // Admission queue of incoming method calls, present in front of method handlers while admission limits are set.
+        // Calls are read off the bus ahead of their handling, up to a queue length's worth of processing steps.
+        std::atomic<bool> methodCallAdmission_{false};
+        mutable std::mutex methodCallSchedulerMutex_;
+        MethodCallScheduler<ScheduledMethodCall> methodCallScheduler_;
+        std::size_t methodCallReadAheadLimit_{};
+        std::size_t methodCallReadAheadSteps_{}; // Processing steps since a queued call has been handled
+        std::atomic<bool> hasScheduledMethodCalls_{false};
+        // Owner of the queued call being handled in place, and the thread handling it, for cancellations to wait for
+        const void* handledScheduledCallOwner_{};
+        std::thread::id handledScheduledCallThread_;
+        std::condition_variable scheduledCallHandled_;
+
+        // Local dispatch. The registry of connections with local dispatch enabled guards their unique names, too. Calls and replies
+        // are handed over to a connection under the registry lock, so a connection gone from the registry is not touched anymore.
+        inline static std::mutex localDispatchRegistryMutex_;
+        inline static std::vector<Connection*> localDispatchRegistry_;
+        inline static std::atomic<uint32_t> nextLocalCallCookie_{UINT32_MAX}; // Counting down, away from cookies sd-bus assigns
+        inline static thread_local const Message* locallyDispatchedMessage_{}; // Call whose handler is invoked locally in this thread
+        std::atomic<bool> localDispatchEnabled_{false};
+        std::string localUniqueName_; // Guarded by the registry lock
+        mutable std::mutex localDispatchMutex_;
+        std::set<std::string, std::less<>> ownedNames_; // Well-known names acquired through this connection, tracked at all times
+        std::deque<LocalMethodCall> localMethodCalls_;
+        std::atomic<bool> hasLocalMethodCalls_{false};
+        std::unordered_map<uint32_t, LocalCallOrigin> localCallsAwaitingReply_;
+        std::atomic<bool> hasLocalCallsAwaitingReply_{false};
+        std::unordered_map<uint32_t, LocalCallWaiter> localCallWaiters_;
+        std::vector<std::pair<uint32_t, LocalReply>> localReplies_; // Replies to async calls, to be dispatched by the event loop
+        std::atomic<bool> hasLocalReplies_{false};
+
+        std::atomic<bool> submissionQueueEnabled_{false};
+        std::atomic<SubmittedMessage*> submittedMessages_{}; // Stack of submitted messages, most recent first
+        std::atomic<std::size_t> activeSubmitters_{}; // Threads about to push onto the stack, having seen the queue enabled
+        inline static thread_local const Connection* processingConnection_{}; // Connection whose events are processed in this thread
+
+        // Work handed over to the event loop by other threads or other connections
+        std::mutex postedWorkMutex_;
+        std::vector<std::function<void()>> postedWork_;
+        std::atomic<bool> hasPostedWork_{false};
+
+        std::mutex destructionHandlersMutex_;
+        std::map<std::uint64_t, std::function<void()>> destructionHandlers_;
+        std::uint64_t lastDestructionHandlerId_{};
+
+        std::unique_ptr<MethodCallDispatchPool> dispatchPool_; // Declared last to be stopped before the bus is closed
     };
 
 }
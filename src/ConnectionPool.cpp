@@ -0,0 +1,139 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file ConnectionPool.cpp
+ *
+ * Created on: Oct 14, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ConnectionPool.h"
+
+#include "sdbus-c++/Error.h"
+#include "sdbus-c++/Types.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+
+namespace sdbus::internal {
+
+namespace {
+    // Jump consistent hash (Lamping & Veach), mapping keys evenly onto buckets without any lookup table
+    std::size_t jumpConsistentHash(std::uint64_t key, std::size_t bucketCount)
+    {
+        std::int64_t bucket{-1};
+        std::int64_t next{0};
+        while (next < static_cast<std::int64_t>(bucketCount))
+        {
+            bucket = next;
+            key = key * 2862933555777941757ULL + 1;
+            next = static_cast<std::int64_t>(static_cast<double>(bucket + 1) * (static_cast<double>(1LL << 31) / static_cast<double>((key >> 33) + 1)));
+        }
+        return static_cast<std::size_t>(bucket);
+    }
+}
+
+ConnectionPool::ConnectionPool(std::size_t connectionCount, std::size_t eventLoopCount, ConnectionFactory connectionFactory)
+{
+    SDBUS_THROW_ERROR_IF(connectionCount == 0, "Invalid connection pool size", EINVAL);
+    SDBUS_THROW_ERROR_IF(eventLoopCount == 0, "Invalid number of connection pool event loops", EINVAL);
+    SDBUS_THROW_ERROR_IF(!connectionFactory, "Invalid connection factory", EINVAL);
+
+    // There's no point in event loops having no connection to drive
+    eventLoopCount = std::min(eventLoopCount, connectionCount);
+
+    try
+    {
+        for (std::size_t i = 0; i < eventLoopCount; ++i)
+            eventLoops_.push_back(sdbus::createEventLoop());
+
+        connections_.reserve(connectionCount);
+        for (std::size_t i = 0; i < connectionCount; ++i)
+        {
+            auto connection = connectionFactory();
+            SDBUS_THROW_ERROR_IF(!connection, "Invalid connection created by connection factory", EINVAL);
+            eventLoops_[i % eventLoopCount]->attach(*connection);
+            connections_.push_back(std::move(connection));
+        }
+
+        for (auto& eventLoop : eventLoops_)
+            eventLoop->runAsync();
+    }
+    catch (...)
+    {
+        shutDown();
+        throw;
+    }
+}
+
+ConnectionPool::~ConnectionPool()
+{
+    shutDown();
+}
+
+sdbus::IConnection& ConnectionPool::getConnection(const ObjectPath& objectPath)
+{
+    auto key = std::hash<std::string_view>{}(objectPath);
+
+    return *connections_[jumpConsistentHash(key, connections_.size())];
+}
+
+sdbus::IConnection& ConnectionPool::getConnection(std::size_t index)
+{
+    SDBUS_THROW_ERROR_IF(index >= connections_.size(), "Invalid connection pool index", EINVAL);
+
+    return *connections_[index];
+}
+
+std::size_t ConnectionPool::getConnectionCount() const
+{
+    return connections_.size();
+}
+
+void ConnectionPool::shutDown()
+{
+    for (auto& eventLoop : eventLoops_)
+        eventLoop->stop();
+
+    for (std::size_t i = 0; i < connections_.size(); ++i)
+        eventLoops_[i % eventLoops_.size()]->detach(*connections_[i]);
+
+    connections_.clear();
+    eventLoops_.clear();
+}
+
+}
+
+namespace sdbus {
+
+std::unique_ptr<sdbus::IConnectionPool> createConnectionPool(std::size_t connectionCount, std::size_t eventLoopCount)
+{
+    return createConnectionPool(connectionCount, eventLoopCount, []{ return sdbus::createBusConnection(); });
+}
+
+std::unique_ptr<sdbus::IConnectionPool> createConnectionPool( std::size_t connectionCount
+                                                            , std::size_t eventLoopCount
+                                                            , std::function<std::unique_ptr<sdbus::IConnection>()> connectionFactory )
+{
+    return std::make_unique<sdbus::internal::ConnectionPool>(connectionCount, eventLoopCount, std::move(connectionFactory));
+}
+
+}
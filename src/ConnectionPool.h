@@ -0,0 +1,66 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file ConnectionPool.h
+ *
+ * Created on: Oct 14, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_INTERNAL_CONNECTIONPOOL_H_
+#define SDBUS_CXX_INTERNAL_CONNECTIONPOOL_H_
+
+#include "sdbus-c++/IConnectionPool.h"
+
+#include "sdbus-c++/IConnection.h"
+#include "sdbus-c++/IEventLoop.h"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace sdbus::internal {
+
+    class ConnectionPool
+        : public sdbus::IConnectionPool
+    {
+    public:
+        using ConnectionFactory = std::function<std::unique_ptr<sdbus::IConnection>()>;
+
+        ConnectionPool(std::size_t connectionCount, std::size_t eventLoopCount, ConnectionFactory connectionFactory);
+        ~ConnectionPool() override;
+
+        sdbus::IConnection& getConnection(const ObjectPath& objectPath) override;
+        sdbus::IConnection& getConnection(std::size_t index) override;
+        [[nodiscard]] std::size_t getConnectionCount() const override;
+
+    private:
+        void shutDown();
+
+    private:
+        // Fixed for the lifetime of the pool, so no synchronization is needed
+        std::vector<std::unique_ptr<sdbus::IEventLoop>> eventLoops_;
+        std::vector<std::unique_ptr<sdbus::IConnection>> connections_; // Connection i is driven by event loop i % eventLoops_.size()
+    };
+
+}
+
+#endif /* SDBUS_CXX_INTERNAL_CONNECTIONPOOL_H_ */
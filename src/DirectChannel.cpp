@@ -0,0 +1,188 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file DirectChannel.cpp
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sdbus-c++/StandardInterfaces.h"
+
+#include "sdbus-c++/Error.h"
+
+#include "ThreadPolicy.h"
+
+#include <atomic>
+#include <cerrno>
+#include <list>
+#include <sys/socket.h>
+#include <thread>
+
+namespace sdbus {
+
+namespace {
+    constexpr const char* DIRECT_CHANNEL_INTERFACE_NAME = "org.sdbuscpp.DirectChannel";
+    constexpr const char* DISCONNECTED_MATCH_RULE = "type='signal',path='/org/freedesktop/DBus/Local',"
+                                                    "interface='org.freedesktop.DBus.Local',member='Disconnected'";
+}
+
+// A channel is a socket pair, the server end of which is served by a connection of its own
+class DirectChannel_adaptor::Channels
+{
+public:
+    explicit Channels(DirectChannel_adaptor& adaptor)
+        : adaptor_(adaptor)
+    {
+    }
+
+    ~Channels()
+    {
+        close();
+    }
+
+    UnixFd open()
+    {
+        int fds[2];
+        if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) < 0)
+            throw createError(errno, "Failed to create socket pair for direct channel");
+        UnixFd serverFd{fds[0], adopt_fd};
+        UnixFd peerFd{fds[1], adopt_fd};
+
+        std::list<Channel> closedChannels;
+        {
+            std::lock_guard lock(mutex_);
+            SDBUS_THROW_ERROR_IF(isClosed_, "Failed to open direct channel: the object is being unregistered", ECANCELED);
+
+            for (auto it = channels_.begin(); it != channels_.end();)
+                if (auto current = it++; current->closed)
+                    closedChannels.splice(closedChannels.end(), channels_, current);
+
+            auto& channel = channels_.emplace_back();
+            channel.abortFd = UnixFd{serverFd.get()}; // A duplicate
+            // Server handshake completes only once the peer connects, so it must not hold up this reply
+            try
+            {
+                channel.setupThread = internal::startThread( ThreadRole::ConnectionSetup
+                                                           , [this, &channel, fd = std::move(serverFd)]() mutable { setUp(channel, std::move(fd)); } );
+            }
+            catch (...)
+            {
+                channels_.pop_back();
+                throw;
+            }
+        }
+        closeChannels(closedChannels);
+
+        return peerFd;
+    }
+
+    // Aborts the handshakes of channels still being set up, waits for their setup threads, and closes all channels
+    void close()
+    {
+        std::list<Channel> channels;
+        {
+            std::lock_guard lock(mutex_);
+            isClosed_ = true;
+            for (auto& channel : channels_)
+                if (!channel.connection)
+                    (void)::shutdown(channel.abortFd.get(), SHUT_RDWR);
+            channels.splice(channels.end(), channels_);
+        }
+        closeChannels(channels);
+    }
+
+private:
+    struct Channel
+    {
+        UnixFd abortFd; // Duplicate of the server end of the socket pair, to abort an unfinished handshake
+        std::thread setupThread;
+        std::unique_ptr<IConnection> connection;
+        std::shared_ptr<void> objects;
+        Slot disconnectedSlot;
+        std::atomic<bool> closed{false};
+    };
+
+    void setUp(Channel& channel, UnixFd fd)
+    {
+        try
+        {
+            // The connection takes the descriptor over only once it's created
+            auto connection = createServerBus(fd.get());
+            (void)fd.release();
+            auto objects = adaptor_.onDirectChannelOpened(*connection);
+            auto disconnectedSlot = connection->addMatch( DISCONNECTED_MATCH_RULE
+                                                        , [&channel](Message /*msg*/){ channel.closed = true; }
+                                                        , return_slot );
+            connection->enterEventLoopAsync();
+
+            std::lock_guard lock(mutex_);
+            channel.objects = std::move(objects);
+            channel.disconnectedSlot = std::move(disconnectedSlot);
+            channel.connection = std::move(connection);
+        }
+        catch (...)
+        {
+            channel.closed = true;
+        }
+    }
+
+    // Closes channels taken out of the list, so that their setup threads can finish without the lock
+    static void closeChannels(std::list<Channel>& channels)
+    {
+        for (auto& channel : channels)
+        {
+            if (channel.setupThread.joinable())
+                channel.setupThread.join();
+            // Objects go away before the connection they are exported on
+            channel.disconnectedSlot.reset();
+            channel.objects.reset();
+            channel.connection.reset();
+        }
+        channels.clear();
+    }
+
+private:
+    DirectChannel_adaptor& adaptor_;
+    std::mutex mutex_;
+    std::list<Channel> channels_;
+    bool isClosed_{}; // No more channels are opened
+};
+
+DirectChannel_adaptor::DirectChannel_adaptor(IObject& object)
+    : m_object(object)
+    , m_channels(std::make_unique<Channels>(*this))
+{
+}
+
+DirectChannel_adaptor::~DirectChannel_adaptor() = default;
+
+void DirectChannel_adaptor::registerAdaptor()
+{
+    m_object.addVTable(registerMethod("Open").withOutputParamNames("fd").implementedAs([this](){ return m_channels->open(); }))
+            .forInterface(DIRECT_CHANNEL_INTERFACE_NAME);
+}
+
+void DirectChannel_adaptor::unregisterAdaptor()
+{
+    m_channels->close();
+}
+
+}
@@ -0,0 +1,665 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file DynamicValue.cpp
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "sdbus-c++/DynamicValue.h"
+
+#include "sdbus-c++/Error.h"
+
+#include "MessageUtils.h"
+
+#include <array>
+#include <cassert>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include SDBUS_HEADER
+#include <utility>
+
+namespace sdbus {
+
+namespace {
+
+    // Returns the position right after the single complete type the signature starts with
+    const char* skipCompleteType(const char* signature) noexcept
+    {
+        switch (*signature)
+        {
+            case SD_BUS_TYPE_ARRAY:
+                return skipCompleteType(signature + 1);
+            case SD_BUS_TYPE_STRUCT_BEGIN:
+            case SD_BUS_TYPE_DICT_ENTRY_BEGIN:
+            {
+                ++signature;
+                while (*signature != SD_BUS_TYPE_STRUCT_END && *signature != SD_BUS_TYPE_DICT_ENTRY_END)
+                    signature = skipCompleteType(signature);
+                return signature + 1;
+            }
+            default:
+                return signature + 1;
+        }
+    }
+
+    // Arrays of these types can be read from a message as one block of memory
+    bool isFixedSizeType(char type) noexcept
+    {
+        switch (type)
+        {
+            case SD_BUS_TYPE_BYTE: case SD_BUS_TYPE_BOOLEAN:
+            case SD_BUS_TYPE_INT16: case SD_BUS_TYPE_UINT16:
+            case SD_BUS_TYPE_INT32: case SD_BUS_TYPE_UINT32:
+            case SD_BUS_TYPE_INT64: case SD_BUS_TYPE_UINT64:
+            case SD_BUS_TYPE_DOUBLE:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    std::size_t fixedSizeOf(char type) noexcept
+    {
+        switch (type)
+        {
+            case SD_BUS_TYPE_BYTE: return 1;
+            case SD_BUS_TYPE_INT16: case SD_BUS_TYPE_UINT16: return 2;
+            case SD_BUS_TYPE_BOOLEAN: case SD_BUS_TYPE_INT32: case SD_BUS_TYPE_UINT32: return 4;
+            default: return 8;
+        }
+    }
+
+    // Storage for any basic value read from a message
+    union BasicValue
+    {
+        uint8_t y;
+        int b;
+        int16_t n;
+        uint16_t q;
+        int32_t i;
+        uint32_t u;
+        int64_t x;
+        uint64_t t;
+        double d;
+        const char* s;
+        int h;
+    };
+
+    // Reads a basic value of the given type; returns false at the end of the enclosing array
+    bool readBasic(sd_bus_message* msg, char type, BasicValue& value)
+    {
+        auto r = sd_bus_message_read_basic(msg, type, &value);
+        SDBUS_THROW_ERROR_IF(r < 0, "Failed to decode a basic value", -r);
+        return r > 0;
+    }
+
+    // Enters a container of the given type; returns false at the end of the enclosing array
+    bool enterContainer(sd_bus_message* msg, char type, const char* contents)
+    {
+        auto r = sd_bus_message_enter_container(msg, type, contents);
+        SDBUS_THROW_ERROR_IF(r < 0, "Failed to enter a container", -r);
+        return r > 0;
+    }
+
+    // Enters a container whose contents signature is the given part of a longer signature
+    bool enterContainer(sd_bus_message* msg, char type, const char* contents, const char* contentsEnd)
+    {
+        std::array<char, 256> buffer; // D-Bus signatures are at most 255 characters long
+        const auto length = static_cast<std::size_t>(contentsEnd - contents);
+        assert(length < buffer.size());
+        std::memcpy(buffer.data(), contents, length);
+        buffer[length] = '\0';
+        return enterContainer(msg, type, buffer.data());
+    }
+
+    void exitContainer(sd_bus_message* msg)
+    {
+        auto r = sd_bus_message_exit_container(msg);
+        SDBUS_THROW_ERROR_IF(r < 0, "Failed to exit a container", -r);
+    }
+
+    // Peeks the contents signature of the variant that follows; returns false at the end of the enclosing array
+    bool peekVariant(sd_bus_message* msg, const char*& contents)
+    {
+        char type{};
+        auto r = sd_bus_message_peek_type(msg, &type, &contents);
+        SDBUS_THROW_ERROR_IF(r < 0, "Failed to peek a variant", -r);
+        return r > 0;
+    }
+
+    // Reads an array of fixed-size elements as one block of memory, with the elements counted in `count`
+    const void* readFixedArray(sd_bus_message* msg, char elementType, std::size_t& count)
+    {
+        const void* data{};
+        std::size_t size{};
+        auto r = sd_bus_message_read_array(msg, elementType, &data, &size);
+        SDBUS_THROW_ERROR_IF(r < 0, "Failed to decode an array", -r);
+        count = size / fixedSizeOf(elementType);
+        return data;
+    }
+
+    // Builds the value tree of a message body. Each value is decoded as guided by its signature,
+    // so the message is peeked only for the contents of variants.
+    class Decoder
+    {
+    public:
+        Decoder(sd_bus_message* msg, detail::DynamicTree& tree)
+            : msg_(msg), tree_(tree)
+        {
+        }
+
+        void decodeBody(const char* signature)
+        {
+            const auto first = scratch_.size();
+            for (const auto* type = signature; *type != '\0'; type = skipCompleteType(type))
+            {
+                [[maybe_unused]] auto decoded = decodeValue(type);
+                assert(decoded);
+            }
+
+            auto& root = addNode(signature, SD_BUS_TYPE_STRUCT);
+            linkChildren(root, first);
+        }
+
+    private:
+        // Returns false, without adding any node, at the end of the enclosing array
+        bool decodeValue(const char* signature)
+        {
+            switch (*signature)
+            {
+                case SD_BUS_TYPE_ARRAY:
+                    return decodeArray(signature);
+                case SD_BUS_TYPE_STRUCT_BEGIN:
+                    return decodeContainer(signature, SD_BUS_TYPE_STRUCT);
+                case SD_BUS_TYPE_DICT_ENTRY_BEGIN:
+                    return decodeContainer(signature, SD_BUS_TYPE_DICT_ENTRY);
+                case SD_BUS_TYPE_VARIANT:
+                    return decodeVariant(signature);
+                default:
+                    return decodeBasic(signature);
+            }
+        }
+
+        bool decodeBasic(const char* signature)
+        {
+            BasicValue value{};
+            if (!readBasic(msg_, *signature, value))
+                return false;
+
+            auto& node = addNode(signature, *signature);
+            switch (*signature)
+            {
+                case SD_BUS_TYPE_BYTE: node.value.u = value.y; break;
+                case SD_BUS_TYPE_BOOLEAN: node.value.u = value.b != 0; break;
+                case SD_BUS_TYPE_INT16: node.value.i = value.n; break;
+                case SD_BUS_TYPE_UINT16: node.value.u = value.q; break;
+                case SD_BUS_TYPE_INT32: node.value.i = value.i; break;
+                case SD_BUS_TYPE_UINT32: node.value.u = value.u; break;
+                case SD_BUS_TYPE_INT64: node.value.i = value.x; break;
+                case SD_BUS_TYPE_UINT64: node.value.u = value.t; break;
+                case SD_BUS_TYPE_DOUBLE: node.value.d = value.d; break;
+                case SD_BUS_TYPE_UNIX_FD: node.value.i = value.h; break;
+                default: // Strings, object paths and signatures
+                    node.value.str = value.s;
+                    node.count = static_cast<uint32_t>(std::strlen(value.s));
+                    break;
+            }
+            return true;
+        }
+
+        bool decodeArray(const char* signature)
+        {
+            const auto* elementSignature = signature + 1;
+            if (isFixedSizeType(*elementSignature))
+            {
+                // Reading an array at the end of an enclosing array doesn't fail, so the end is checked up front
+                if (sd_bus_message_at_end(msg_, false) > 0)
+                    return false;
+                std::size_t count{};
+                const auto* data = readFixedArray(msg_, *elementSignature, count);
+                auto& node = addNode(signature, SD_BUS_TYPE_ARRAY);
+                node.value.data = data;
+                node.count = static_cast<uint32_t>(count);
+                node.fixedArray = true;
+                return true;
+            }
+
+            if (!enterContainer(msg_, SD_BUS_TYPE_ARRAY, elementSignature, skipCompleteType(elementSignature)))
+                return false;
+            const auto first = scratch_.size();
+            while (decodeValue(elementSignature))
+                ;
+            exitContainer(msg_);
+
+            auto& node = addNode(signature, SD_BUS_TYPE_ARRAY);
+            linkChildren(node, first);
+            return true;
+        }
+
+        bool decodeContainer(const char* signature, char type)
+        {
+            const auto* end = skipCompleteType(signature) - 1;
+            if (!enterContainer(msg_, type, signature + 1, end))
+                return false;
+            const auto first = scratch_.size();
+            for (const auto* field = signature + 1; field != end; field = skipCompleteType(field))
+            {
+                [[maybe_unused]] auto decoded = decodeValue(field);
+                assert(decoded);
+            }
+            exitContainer(msg_);
+
+            auto& node = addNode(signature, type);
+            linkChildren(node, first);
+            return true;
+        }
+
+        bool decodeVariant(const char* signature)
+        {
+            const char* contents{};
+            if (!peekVariant(msg_, contents))
+                return false;
+            [[maybe_unused]] auto entered = enterContainer(msg_, SD_BUS_TYPE_VARIANT, contents);
+            assert(entered);
+            const auto first = scratch_.size();
+            [[maybe_unused]] auto decoded = decodeValue(contents);
+            assert(decoded);
+            exitContainer(msg_);
+
+            auto& node = addNode(signature, SD_BUS_TYPE_VARIANT);
+            linkChildren(node, first);
+            return true;
+        }
+
+        // Adds a node and registers it as a child of the container being decoded
+        detail::DynamicNode& addNode(const char* signature, char type)
+        {
+            scratch_.push_back(static_cast<uint32_t>(tree_.nodes.size()));
+            auto& node = tree_.nodes.emplace_back();
+            node.signature = signature;
+            node.value.u = 0;
+            node.count = 0;
+            node.type = type;
+            node.fixedArray = false;
+            return node;
+        }
+
+        // Moves the children registered since `first` to the links of the container
+        void linkChildren(detail::DynamicNode& container, std::size_t first)
+        {
+            // The container itself has been registered last
+            const auto last = scratch_.size() - 1;
+            container.value.first = static_cast<uint32_t>(tree_.links.size());
+            container.count = static_cast<uint32_t>(last - first);
+            tree_.links.insert(tree_.links.end(), scratch_.begin() + first, scratch_.begin() + last);
+            scratch_.erase(scratch_.begin() + first, scratch_.begin() + last);
+        }
+
+    private:
+        sd_bus_message* msg_;
+        detail::DynamicTree& tree_;
+        std::vector<uint32_t> scratch_; // Node indices of the children of the containers being decoded
+    };
+
+}
+
+DynamicBody::DynamicBody(Message msg)
+{
+    decode(std::move(msg));
+}
+
+void DynamicBody::decode(Message msg)
+{
+    if (tree_ == nullptr)
+        tree_ = std::make_unique<detail::DynamicTree>();
+
+    tree_->nodes.clear();
+    tree_->links.clear();
+    tree_->signature = {};
+    tree_->msg = std::move(msg);
+
+    auto* sdbusMsg = static_cast<sd_bus_message*>(Message::Factory::getSdBusMessage(*tree_->msg));
+    auto r = sd_bus_message_rewind(sdbusMsg, true);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to rewind the message", -r);
+
+    const auto* signature = sd_bus_message_get_signature(sdbusMsg, true);
+    SDBUS_THROW_ERROR_IF(signature == nullptr, "Failed to get the message signature", EINVAL);
+
+    try
+    {
+        Decoder{sdbusMsg, *tree_}.decodeBody(signature);
+    }
+    catch (...)
+    {
+        tree_->nodes.clear();
+        tree_->links.clear();
+        throw;
+    }
+    tree_->signature = signature;
+}
+
+std::string_view DynamicValue::getSignature() const noexcept
+{
+    return {signature_, static_cast<std::size_t>(skipCompleteType(signature_) - signature_)};
+}
+
+namespace {
+
+    [[noreturn]] void throwTypeMismatch(char actualType)
+    {
+        SDBUS_THROW_ERROR(std::string("Failed to get a dynamic value of type ") + actualType + " as another type", EINVAL);
+    }
+
+}
+
+template <> bool DynamicValue::get<bool>() const
+{
+    if (getType() != SD_BUS_TYPE_BOOLEAN)
+        throwTypeMismatch(getType());
+    return node_ != nullptr ? node_->value.u != 0 : *static_cast<const int*>(element_) != 0;
+}
+
+#define SDBUS_DYNAMIC_VALUE_GETTER(_Type, _TypeCode, _Field)                                    \
+    template <> _Type DynamicValue::get<_Type>() const                                          \
+    {                                                                                           \
+        if (getType() != _TypeCode)                                                             \
+            throwTypeMismatch(getType());                                                       \
+        if (node_ != nullptr)                                                                   \
+            return static_cast<_Type>(node_->value._Field);                                     \
+        _Type value;                                                                            \
+        std::memcpy(&value, element_, sizeof(value));                                           \
+        return value;                                                                           \
+    }
+
+SDBUS_DYNAMIC_VALUE_GETTER(uint8_t, SD_BUS_TYPE_BYTE, u)
+SDBUS_DYNAMIC_VALUE_GETTER(int16_t, SD_BUS_TYPE_INT16, i)
+SDBUS_DYNAMIC_VALUE_GETTER(uint16_t, SD_BUS_TYPE_UINT16, u)
+SDBUS_DYNAMIC_VALUE_GETTER(int32_t, SD_BUS_TYPE_INT32, i)
+SDBUS_DYNAMIC_VALUE_GETTER(uint32_t, SD_BUS_TYPE_UINT32, u)
+SDBUS_DYNAMIC_VALUE_GETTER(int64_t, SD_BUS_TYPE_INT64, i)
+SDBUS_DYNAMIC_VALUE_GETTER(uint64_t, SD_BUS_TYPE_UINT64, u)
+SDBUS_DYNAMIC_VALUE_GETTER(double, SD_BUS_TYPE_DOUBLE, d)
+
+#undef SDBUS_DYNAMIC_VALUE_GETTER
+
+template <> std::string_view DynamicValue::get<std::string_view>() const
+{
+    const auto type = getType();
+    if (type != SD_BUS_TYPE_STRING && type != SD_BUS_TYPE_OBJECT_PATH && type != SD_BUS_TYPE_SIGNATURE)
+        throwTypeMismatch(type);
+    return {node_->value.str, node_->count};
+}
+
+template <> UnixFd DynamicValue::get<UnixFd>() const
+{
+    if (getType() != SD_BUS_TYPE_UNIX_FD)
+        throwTypeMismatch(getType());
+    return UnixFd{static_cast<int>(node_->value.i)};
+}
+
+namespace {
+
+    // Streams a message body as JSON, as guided by its signature, without building any intermediate representation
+    class JsonWriter
+    {
+    public:
+        JsonWriter(sd_bus_message* msg, std::string& output)
+            : msg_(msg), out_(output)
+        {
+        }
+
+        void writeBody(const char* signature)
+        {
+            out_ += '[';
+            for (const auto* type = signature; *type != '\0'; type = skipCompleteType(type))
+            {
+                if (type != signature)
+                    out_ += ',';
+                [[maybe_unused]] auto written = writeValue(type);
+                assert(written);
+            }
+            out_ += ']';
+        }
+
+    private:
+        // Returns false, without writing anything, at the end of the enclosing array
+        bool writeValue(const char* signature)
+        {
+            switch (*signature)
+            {
+                case SD_BUS_TYPE_ARRAY:
+                    return signature[1] == SD_BUS_TYPE_DICT_ENTRY_BEGIN ? writeDictionary(signature) : writeArray(signature);
+                case SD_BUS_TYPE_STRUCT_BEGIN:
+                    return writeStruct(signature);
+                case SD_BUS_TYPE_VARIANT:
+                {
+                    const char* contents{};
+                    if (!peekVariant(msg_, contents))
+                        return false;
+                    enterContainer(msg_, SD_BUS_TYPE_VARIANT, contents);
+                    writeValue(contents);
+                    exitContainer(msg_);
+                    return true;
+                }
+                default:
+                    return writeBasic(signature, /*asKey*/ false);
+            }
+        }
+
+        bool writeBasic(const char* signature, bool asKey)
+        {
+            BasicValue value{};
+            if (!readBasic(msg_, *signature, value))
+                return false;
+
+            const bool isString = *signature == SD_BUS_TYPE_STRING || *signature == SD_BUS_TYPE_OBJECT_PATH || *signature == SD_BUS_TYPE_SIGNATURE;
+            if (asKey && !isString)
+                out_ += '"';
+            switch (*signature)
+            {
+                case SD_BUS_TYPE_BYTE: writeNumber(value.y); break;
+                case SD_BUS_TYPE_BOOLEAN: out_ += value.b ? "true" : "false"; break;
+                case SD_BUS_TYPE_INT16: writeNumber(value.n); break;
+                case SD_BUS_TYPE_UINT16: writeNumber(value.q); break;
+                case SD_BUS_TYPE_INT32: writeNumber(value.i); break;
+                case SD_BUS_TYPE_UINT32: writeNumber(value.u); break;
+                case SD_BUS_TYPE_INT64: writeNumber(value.x); break;
+                case SD_BUS_TYPE_UINT64: writeNumber(value.t); break;
+                case SD_BUS_TYPE_DOUBLE: writeDouble(value.d); break;
+                case SD_BUS_TYPE_UNIX_FD: writeNumber(value.h); break;
+                default: writeString(value.s); break;
+            }
+            if (asKey && !isString)
+                out_ += '"';
+            return true;
+        }
+
+        bool writeArray(const char* signature)
+        {
+            const auto* elementSignature = signature + 1;
+            if (isFixedSizeType(*elementSignature))
+                return writeFixedArray(*elementSignature);
+
+            if (!enterContainer(msg_, SD_BUS_TYPE_ARRAY, elementSignature, skipCompleteType(elementSignature)))
+                return false;
+            out_ += '[';
+            for (bool first = true; ; first = false)
+            {
+                const auto mark = out_.size();
+                if (!first)
+                    out_ += ',';
+                if (!writeValue(elementSignature))
+                {
+                    out_.resize(mark);
+                    break;
+                }
+            }
+            out_ += ']';
+            exitContainer(msg_);
+            return true;
+        }
+
+        bool writeFixedArray(char elementType)
+        {
+            // Reading an array at the end of an enclosing array doesn't fail, so the end is checked up front
+            if (sd_bus_message_at_end(msg_, false) > 0)
+                return false;
+
+            std::size_t count{};
+            const auto* data = readFixedArray(msg_, elementType, count);
+            out_ += '[';
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (i > 0)
+                    out_ += ',';
+                switch (elementType)
+                {
+                    case SD_BUS_TYPE_BYTE: writeNumber(static_cast<const uint8_t*>(data)[i]); break;
+                    case SD_BUS_TYPE_BOOLEAN: out_ += static_cast<const int*>(data)[i] ? "true" : "false"; break;
+                    case SD_BUS_TYPE_INT16: writeNumber(static_cast<const int16_t*>(data)[i]); break;
+                    case SD_BUS_TYPE_UINT16: writeNumber(static_cast<const uint16_t*>(data)[i]); break;
+                    case SD_BUS_TYPE_INT32: writeNumber(static_cast<const int32_t*>(data)[i]); break;
+                    case SD_BUS_TYPE_UINT32: writeNumber(static_cast<const uint32_t*>(data)[i]); break;
+                    case SD_BUS_TYPE_INT64: writeNumber(static_cast<const int64_t*>(data)[i]); break;
+                    case SD_BUS_TYPE_UINT64: writeNumber(static_cast<const uint64_t*>(data)[i]); break;
+                    case SD_BUS_TYPE_DOUBLE: writeDouble(static_cast<const double*>(data)[i]); break;
+                    default: assert(false); break;
+                }
+            }
+            out_ += ']';
+            return true;
+        }
+
+        bool writeDictionary(const char* signature)
+        {
+            const auto* entryEnd = skipCompleteType(signature + 1);
+            if (!enterContainer(msg_, SD_BUS_TYPE_ARRAY, signature + 1, entryEnd))
+                return false;
+            const auto* keySignature = signature + 2;
+            const auto* valueSignature = keySignature + 1; // Keys are of basic types
+            out_ += '{';
+            for (bool first = true; enterContainer(msg_, SD_BUS_TYPE_DICT_ENTRY, keySignature, entryEnd - 1); first = false)
+            {
+                if (!first)
+                    out_ += ',';
+                writeBasic(keySignature, /*asKey*/ true);
+                out_ += ':';
+                writeValue(valueSignature);
+                exitContainer(msg_);
+            }
+            out_ += '}';
+            exitContainer(msg_);
+            return true;
+        }
+
+        bool writeStruct(const char* signature)
+        {
+            const auto* end = skipCompleteType(signature) - 1;
+            if (!enterContainer(msg_, SD_BUS_TYPE_STRUCT, signature + 1, end))
+                return false;
+            out_ += '[';
+            for (const auto* field = signature + 1; field != end; field = skipCompleteType(field))
+            {
+                if (field != signature + 1)
+                    out_ += ',';
+                writeValue(field);
+            }
+            out_ += ']';
+            exitContainer(msg_);
+            return true;
+        }
+
+        template <typename _Integer>
+        void writeNumber(_Integer value)
+        {
+            std::array<char, 24> buffer;
+            auto [end, ec] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+            out_.append(buffer.data(), end);
+        }
+
+        void writeDouble(double value)
+        {
+            if (!std::isfinite(value))
+            {
+                out_ += "null";
+                return;
+            }
+            std::array<char, 32> buffer;
+            auto [end, ec] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+            out_.append(buffer.data(), end);
+        }
+
+        void writeString(const char* str)
+        {
+            static constexpr char hexDigits[] = "0123456789abcdef";
+
+            out_ += '"';
+            const auto* run = str; // Characters that need no escaping are appended in runs
+            for (; *str != '\0'; ++str)
+            {
+                const auto c = static_cast<unsigned char>(*str);
+                if (c >= 0x20 && c != '"' && c != '\\')
+                    continue;
+                out_.append(run, str);
+                run = str + 1;
+                switch (c)
+                {
+                    case '"': out_ += "\\\""; break;
+                    case '\\': out_ += "\\\\"; break;
+                    case '\b': out_ += "\\b"; break;
+                    case '\f': out_ += "\\f"; break;
+                    case '\n': out_ += "\\n"; break;
+                    case '\r': out_ += "\\r"; break;
+                    case '\t': out_ += "\\t"; break;
+                    default:
+                        out_ += "\\u00";
+                        out_ += hexDigits[c >> 4];
+                        out_ += hexDigits[c & 0xF];
+                        break;
+                }
+            }
+            out_.append(run, str);
+            out_ += '"';
+        }
+
+    private:
+        sd_bus_message* msg_;
+        std::string& out_;
+    };
+
+}
+
+void writeJson(Message& msg, std::string& output)
+{
+    auto* sdbusMsg = static_cast<sd_bus_message*>(Message::Factory::getSdBusMessage(msg));
+    auto r = sd_bus_message_rewind(sdbusMsg, true);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to rewind the message", -r);
+
+    const auto* signature = sd_bus_message_get_signature(sdbusMsg, true);
+    SDBUS_THROW_ERROR_IF(signature == nullptr, "Failed to get the message signature", EINVAL);
+
+    JsonWriter{sdbusMsg, output}.writeBody(signature);
+}
+
+}
@@ -0,0 +1,392 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file EventLoop.cpp
+ *
+ * Created on: Oct 14, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EventLoop.h"
+
+#include "sdbus-c++/Error.h"
+
+#include "ScopeGuard.h"
+#include "ThreadPolicy.h"
+
+#include <algorithm>
+#include <cassert>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace sdbus::internal {
+
+namespace {
+    uint32_t toEpollEvents(short int pollEvents)
+    {
+        uint32_t epollEvents{};
+        if (pollEvents & POLLIN)
+            epollEvents |= EPOLLIN;
+        if (pollEvents & POLLOUT)
+            epollEvents |= EPOLLOUT;
+        if (pollEvents & POLLPRI)
+            epollEvents |= EPOLLPRI;
+        return epollEvents;
+    }
+
+    int controlEpoll(int epollFd, int operation, int fd, uint32_t events, std::uint64_t tag)
+    {
+        struct epoll_event event{};
+        event.events = events;
+        event.data.u64 = tag;
+        return epoll_ctl(epollFd, operation, fd, &event);
+    }
+}
+
+EventLoop::EventLoop()
+{
+    epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+    SDBUS_THROW_ERROR_IF(epollFd_ < 0, "Failed to create epoll instance", -errno);
+
+    wakeUpFd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (wakeUpFd_ < 0)
+    {
+        auto error = errno;
+        close(epollFd_);
+        SDBUS_THROW_ERROR("Failed to create event object", error);
+    }
+
+    auto r = controlEpoll(epollFd_, EPOLL_CTL_ADD, wakeUpFd_, EPOLLIN, WAKE_UP_TAG);
+    if (r < 0)
+    {
+        auto error = errno;
+        close(wakeUpFd_);
+        close(epollFd_);
+        SDBUS_THROW_ERROR("Failed to add event object to epoll instance", error);
+    }
+}
+
+EventLoop::~EventLoop()
+{
+    try
+    {
+        stop();
+    }
+    catch (...)
+    {
+    }
+
+    close(wakeUpFd_);
+    close(epollFd_);
+}
+
+void EventLoop::attach(sdbus::IConnection& connection)
+{
+    std::lock_guard lock(mutex_);
+
+    auto alreadyAttached = std::any_of(connections_.begin(), connections_.end(), [&](const auto& entry){ return entry.second.connection == &connection; });
+    SDBUS_THROW_ERROR_IF(alreadyAttached, "Connection is already attached to the event loop", EALREADY);
+
+    auto pollData = connection.getEventLoopPollData();
+    auto tag = nextTag_++;
+
+    auto r = controlEpoll(epollFd_, EPOLL_CTL_ADD, pollData.fd, toEpollEvents(pollData.events), tag);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to add bus descriptor to epoll instance", -errno);
+
+    r = controlEpoll(epollFd_, EPOLL_CTL_ADD, pollData.eventFd, EPOLLIN, tag);
+    if (r < 0)
+    {
+        auto error = errno;
+        (void)epoll_ctl(epollFd_, EPOLL_CTL_DEL, pollData.fd, nullptr);
+        SDBUS_THROW_ERROR("Failed to add event descriptor to epoll instance", error);
+    }
+
+    connections_.emplace(tag, AttachedConnection{&connection, pollData});
+
+    // The loop may be sleeping in epoll_wait() with a timeout that doesn't take the new connection into account
+    notifyEventLoop();
+}
+
+void EventLoop::detach(sdbus::IConnection& connection)
+{
+    std::unique_lock lock(mutex_);
+
+    auto it = std::find_if(connections_.begin(), connections_.end(), [&](const auto& entry){ return entry.second.connection == &connection; });
+    SDBUS_THROW_ERROR_IF(it == connections_.end(), "Connection is not attached to the event loop", ENOENT);
+
+    (void)epoll_ctl(epollFd_, EPOLL_CTL_DEL, it->second.pollData.fd, nullptr);
+    (void)epoll_ctl(epollFd_, EPOLL_CTL_DEL, it->second.pollData.eventFd, nullptr);
+
+    auto tag = it->first;
+    connections_.erase(it);
+
+    waitUntilNotProcessed(lock, tag);
+}
+
+std::uint64_t EventLoop::watchDescriptor(int fd, std::function<void()> callback)
+{
+    std::lock_guard lock(mutex_);
+
+    auto tag = nextTag_++;
+
+    auto r = controlEpoll(epollFd_, EPOLL_CTL_ADD, fd, EPOLLIN, tag);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to add descriptor to epoll instance", -errno);
+
+    descriptors_.emplace(tag, WatchedDescriptor{fd, std::move(callback)});
+
+    return tag;
+}
+
+void EventLoop::unwatchDescriptor(std::uint64_t tag)
+{
+    std::unique_lock lock(mutex_);
+
+    auto it = descriptors_.find(tag);
+    SDBUS_THROW_ERROR_IF(it == descriptors_.end(), "Descriptor is not watched by the event loop", ENOENT);
+
+    (void)epoll_ctl(epollFd_, EPOLL_CTL_DEL, it->second.fd, nullptr);
+
+    auto callback = std::move(it->second.callback);
+    descriptors_.erase(it);
+
+    waitUntilNotProcessed(lock, tag);
+    lock.unlock(); // The callback is destroyed outside of the mutex, as it may hold on to anything
+}
+
+void EventLoop::waitUntilNotProcessed(std::unique_lock<std::mutex>& lock, std::uint64_t tag)
+{
+    // A handler of the connection, or the callback of the descriptor, may be the one detaching or unwatching it
+    if (runningThread_ != std::this_thread::get_id())
+        processed_.wait(lock, [&](){ return processedTag_ != tag; });
+}
+
+void EventLoop::run()
+{
+    {
+        std::lock_guard lock(mutex_);
+        runningThread_ = std::this_thread::get_id();
+    }
+    SCOPE_EXIT
+    {
+        std::lock_guard lock(mutex_);
+        runningThread_ = {};
+        runFinished_.notify_all();
+    };
+
+    while (true)
+    {
+        processReadyConnections();
+        processReadyDescriptors();
+
+        auto success = waitForNextEvents();
+        if (!success)
+            break; // Exit the event loop
+    }
+}
+
+void EventLoop::runAsync()
+{
+    if (!loopThread_.joinable())
+        loopThread_ = startThread(ThreadRole::EventLoop, [this](){ run(); });
+}
+
+void EventLoop::stop()
+{
+    exitRequested_ = true;
+    notifyEventLoop();
+
+    if (loopThread_.joinable() && loopThread_.get_id() != std::this_thread::get_id())
+        loopThread_.join();
+
+    // The loop may also run in a thread of the user's, which is waited for to leave run() as well
+    std::unique_lock lock(mutex_);
+    if (runningThread_ != std::this_thread::get_id())
+        runFinished_.wait(lock, [this](){ return runningThread_ == std::thread::id{}; });
+}
+
+void EventLoop::processReadyConnections()
+{
+    // The ready connections are taken under the mutex, and processed outside of it, since their handlers may attach
+    // and detach connections, and other threads may do so meanwhile. Those detached meanwhile are skipped.
+    std::vector<std::pair<std::uint64_t, sdbus::IConnection*>> readyConnections;
+    {
+        std::lock_guard lock(mutex_);
+        for (const auto& [tag, attachedConnection] : connections_)
+            if (attachedConnection.ready || attachedConnection.pollData.getRelativeTimeout() == std::chrono::microseconds::zero())
+                readyConnections.emplace_back(tag, attachedConnection.connection);
+    }
+
+    for (auto [tag, connection] : readyConnections)
+    {
+        std::unique_lock lock(mutex_);
+        if (auto it = connections_.find(tag); it == connections_.end())
+            continue;
+        processedTag_ = tag;
+        lock.unlock();
+
+        std::size_t processed{};
+        {
+            SCOPE_EXIT
+            {
+                std::lock_guard lock(mutex_);
+                processedTag_ = WAKE_UP_TAG;
+                processed_.notify_all();
+            };
+            processed = connection->processPendingEvents(MAX_EVENTS_PER_BATCH, MAX_BATCH_DURATION);
+        }
+
+        // Look the connection up again, in case it has been detached meanwhile
+        lock.lock();
+        auto it = connections_.find(tag);
+        if (it == connections_.end())
+            continue;
+
+        // If the batch got exhausted, there may be more events pending; give other connections their turn first
+        it->second.ready = processed >= MAX_EVENTS_PER_BATCH;
+        updatePollData(it->first, it->second);
+    }
+}
+
+void EventLoop::processReadyDescriptors()
+{
+    // Like connections, the ready descriptors are taken under the mutex, and their callbacks invoked outside of it
+    std::vector<std::pair<std::uint64_t, std::function<void()>>> readyDescriptors;
+    {
+        std::lock_guard lock(mutex_);
+        for (auto& [tag, descriptor] : descriptors_)
+        {
+            if (!descriptor.ready)
+                continue;
+            descriptor.ready = false;
+            readyDescriptors.emplace_back(tag, descriptor.callback);
+        }
+    }
+
+    for (auto& [tag, callback] : readyDescriptors)
+    {
+        {
+            std::lock_guard lock(mutex_);
+            if (descriptors_.count(tag) == 0)
+                continue;
+            processedTag_ = tag;
+        }
+        SCOPE_EXIT
+        {
+            std::lock_guard lock(mutex_);
+            processedTag_ = WAKE_UP_TAG;
+            processed_.notify_all();
+        };
+
+        callback();
+    }
+}
+
+void EventLoop::updatePollData(std::uint64_t tag, AttachedConnection& attachedConnection)
+{
+    auto pollData = attachedConnection.connection->getEventLoopPollData();
+    auto& current = attachedConnection.pollData;
+
+    // Only touch the epoll registration when the watched events really change, which saves a syscall per iteration
+    if (pollData.fd != current.fd)
+    {
+        (void)epoll_ctl(epollFd_, EPOLL_CTL_DEL, current.fd, nullptr);
+        auto r = controlEpoll(epollFd_, EPOLL_CTL_ADD, pollData.fd, toEpollEvents(pollData.events), tag);
+        SDBUS_THROW_ERROR_IF(r < 0, "Failed to add bus descriptor to epoll instance", -errno);
+    }
+    else if (pollData.events != current.events)
+    {
+        auto r = controlEpoll(epollFd_, EPOLL_CTL_MOD, pollData.fd, toEpollEvents(pollData.events), tag);
+        SDBUS_THROW_ERROR_IF(r < 0, "Failed to modify bus descriptor events in epoll instance", -errno);
+    }
+
+    current = pollData;
+}
+
+int EventLoop::getPollTimeout() const
+{
+    std::lock_guard lock(mutex_);
+
+    int timeout{-1};
+    for (const auto& [tag, attachedConnection] : connections_)
+    {
+        if (attachedConnection.ready)
+            return 0;
+
+        auto connectionTimeout = attachedConnection.pollData.getPollTimeout();
+        if (connectionTimeout >= 0 && (timeout < 0 || connectionTimeout < timeout))
+            timeout = connectionTimeout;
+    }
+
+    return timeout;
+}
+
+bool EventLoop::waitForNextEvents()
+{
+    struct epoll_event events[MAX_EPOLL_EVENTS];
+
+    auto r = epoll_wait(epollFd_, events, MAX_EPOLL_EVENTS, getPollTimeout());
+
+    if (r < 0 && errno == EINTR)
+        return true; // Try again
+
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to wait on the epoll instance", -errno);
+
+    std::lock_guard lock(mutex_);
+
+    for (int i = 0; i < r; ++i)
+    {
+        auto tag = events[i].data.u64;
+        if (tag == WAKE_UP_TAG)
+        {
+            uint64_t value{};
+            (void)eventfd_read(wakeUpFd_, &value);
+            continue;
+        }
+
+        // The connection or descriptor may have been detached in the meantime
+        if (auto it = connections_.find(tag); it != connections_.end())
+            it->second.ready = true;
+        else if (auto it = descriptors_.find(tag); it != descriptors_.end())
+            it->second.ready = true;
+    }
+
+    return !exitRequested_.exchange(false);
+}
+
+void EventLoop::notifyEventLoop()
+{
+    auto r = eventfd_write(wakeUpFd_, 1);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to notify event descriptor", -errno);
+}
+
+}
+
+namespace sdbus {
+
+std::unique_ptr<sdbus::IEventLoop> createEventLoop()
+{
+    return std::make_unique<sdbus::internal::EventLoop>();
+}
+
+}
@@ -0,0 +1,116 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file EventLoop.h
+ *
+ * Created on: Oct 14, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_INTERNAL_EVENTLOOP_H_
+#define SDBUS_CXX_INTERNAL_EVENTLOOP_H_
+
+#include "sdbus-c++/IEventLoop.h"
+
+#include "sdbus-c++/IConnection.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace sdbus::internal {
+
+    class EventLoop
+        : public sdbus::IEventLoop
+    {
+    public:
+        EventLoop();
+        ~EventLoop() override;
+
+        void attach(sdbus::IConnection& connection) override;
+        void detach(sdbus::IConnection& connection) override;
+        void run() override;
+        void runAsync() override;
+        void stop() override;
+
+        // Watches a descriptor (e.g. a listening socket) for readability, and invokes the callback
+        // in the event loop thread whenever it is readable, until the descriptor gets unwatched
+        std::uint64_t watchDescriptor(int fd, std::function<void()> callback);
+        void unwatchDescriptor(std::uint64_t tag);
+
+    private:
+        struct AttachedConnection
+        {
+            sdbus::IConnection* connection{};
+            sdbus::IConnection::PollData pollData{};
+            bool ready{true}; // The connection has (or may have) pending events to process
+        };
+
+        struct WatchedDescriptor
+        {
+            int fd{-1};
+            std::function<void()> callback;
+            bool ready{};
+        };
+
+        void processReadyConnections();
+        void processReadyDescriptors();
+        // Waits, unless called from the event loop thread, until the connection or descriptor isn't being processed
+        void waitUntilNotProcessed(std::unique_lock<std::mutex>& lock, std::uint64_t tag);
+        void updatePollData(std::uint64_t tag, AttachedConnection& attachedConnection);
+        [[nodiscard]] int getPollTimeout() const;
+        bool waitForNextEvents();
+        void notifyEventLoop();
+
+        // Events of all attached connections get processed in batches of this size,
+        // so that one busy connection doesn't starve the others
+        inline static constexpr std::size_t MAX_EVENTS_PER_BATCH{64};
+        inline static constexpr std::chrono::microseconds MAX_BATCH_DURATION{10'000};
+        inline static constexpr std::size_t MAX_EPOLL_EVENTS{32};
+        // Epoll tag of the event loop's own wake-up descriptor. Attached connections get tags from 1 on.
+        inline static constexpr std::uint64_t WAKE_UP_TAG{0};
+
+        int epollFd_{-1};
+        int wakeUpFd_{-1};
+        std::atomic<bool> exitRequested_{false};
+
+        // Connections are processed, and descriptor callbacks invoked, outside of the mutex. Detaching a connection
+        // or unwatching a descriptor waits for it not to be processed, so that it may be destroyed right after.
+        mutable std::mutex mutex_;
+        std::condition_variable processed_;
+        std::map<std::uint64_t, AttachedConnection> connections_; // Keyed by epoll tag
+        std::map<std::uint64_t, WatchedDescriptor> descriptors_; // Keyed by epoll tag, sharing the tag space with connections
+        std::uint64_t nextTag_{WAKE_UP_TAG + 1};
+        std::uint64_t processedTag_{WAKE_UP_TAG}; // Tag of the connection or descriptor being processed, if any
+        std::thread::id runningThread_; // Thread in run(), if any
+        std::condition_variable runFinished_;
+
+        std::thread loopThread_;
+    };
+
+}
+
+#endif /* SDBUS_CXX_INTERNAL_EVENTLOOP_H_ */
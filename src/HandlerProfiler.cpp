@@ -0,0 +1,159 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file HandlerProfiler.cpp
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "HandlerProfiler.h"
+
+#include "sdbus-c++/Error.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <mutex>
+
+namespace sdbus::internal {
+
+void HandlerProfiler::enable(bool enabled)
+{
+    std::unique_lock lock(mutex_);
+    enabled_.store(enabled, std::memory_order_relaxed);
+    updateActivity();
+}
+
+void HandlerProfiler::setWatchdog(SlowHandlerWatchdog watchdog)
+{
+    using std::chrono::microseconds;
+    SDBUS_THROW_ERROR_IF(watchdog.budget < microseconds::zero(), "Invalid slow handler budget provided", EINVAL);
+    SDBUS_THROW_ERROR_IF( std::any_of(watchdog.memberBudgets.begin(), watchdog.memberBudgets.end(), [](const auto& budget){ return budget.second <= microseconds::zero(); })
+                        , "Invalid slow handler budget of a member provided"
+                        , EINVAL );
+
+    std::unique_lock lock(mutex_);
+
+    budget_ = watchdog.budget;
+    memberBudgets_ = {watchdog.memberBudgets.begin(), watchdog.memberBudgets.end()};
+    callback_ = watchdog.callback ? std::make_shared<const SlowHandlerCallback>(std::move(watchdog.callback)) : nullptr;
+
+    for (auto& [key, entry] : entries_)
+        entry.budget = getBudget(std::get<2>(key), std::get<3>(key));
+
+    updateActivity();
+}
+
+void HandlerProfiler::record( HandlerKind kind
+                            , std::string_view objectPath
+                            , std::string_view interfaceName
+                            , std::string_view memberName
+                            , std::chrono::nanoseconds duration )
+{
+    const KeyView key{kind, objectPath, interfaceName, memberName};
+
+    auto callback = [&]
+    {
+        {
+            std::shared_lock lock(mutex_);
+            if (auto it = entries_.find(key); it != entries_.end())
+                return update(it->second, duration);
+        }
+
+        // First invocation of the handler. That's rare, so taking the lock once again is fine.
+        std::unique_lock lock(mutex_);
+        auto [it, inserted] = entries_.try_emplace(Key{kind, objectPath, interfaceName, memberName});
+        if (inserted)
+            it->second.budget = getBudget(interfaceName, memberName);
+        return update(it->second, duration);
+    }();
+
+    // Invoked out of the lock, so that the callback may query the profiles or change the watchdog
+    if (callback != nullptr)
+        (*callback)(kind, objectPath, interfaceName, memberName, duration);
+}
+
+std::shared_ptr<const HandlerProfiler::SlowHandlerCallback> HandlerProfiler::update(Entry& entry, std::chrono::nanoseconds duration)
+{
+    const bool isEnabled = enabled_.load(std::memory_order_relaxed);
+    if (isEnabled)
+    {
+        entry.duration.record(duration);
+        MetricsCollector::updateMaximum(entry.maxDuration, static_cast<uint64_t>(std::max<int64_t>(duration.count(), 0)));
+    }
+
+    if (entry.budget <= std::chrono::nanoseconds::zero() || duration <= entry.budget)
+        return nullptr;
+
+    if (isEnabled)
+        entry.overBudgetCount.fetch_add(1, std::memory_order_relaxed);
+
+    return callback_;
+}
+
+std::vector<HandlerProfiler::HandlerProfile> HandlerProfiler::getProfiles() const
+{
+    std::shared_lock lock(mutex_);
+
+    std::vector<HandlerProfile> profiles;
+    profiles.reserve(entries_.size());
+    for (const auto& [key, entry] : entries_)
+    {
+        HandlerProfile profile;
+        entry.duration.snapshotTo(profile.duration);
+        // Entries of handlers invoked only while the watchdog alone was active carry no data
+        if (profile.duration.count == 0)
+            continue;
+        std::tie(profile.kind, profile.objectPath, profile.interfaceName, profile.memberName) = key;
+        profile.maxDuration = std::chrono::nanoseconds{entry.maxDuration.load(std::memory_order_relaxed)};
+        profile.overBudgetCount = entry.overBudgetCount.load(std::memory_order_relaxed);
+        profiles.push_back(std::move(profile));
+    }
+
+    return profiles;
+}
+
+void HandlerProfiler::reset()
+{
+    std::unique_lock lock(mutex_);
+    entries_.clear();
+}
+
+std::chrono::nanoseconds HandlerProfiler::getBudget(std::string_view interfaceName, std::string_view memberName) const
+{
+    if (!memberBudgets_.empty())
+    {
+        std::string name;
+        name.reserve(interfaceName.size() + 1 + memberName.size());
+        name.append(interfaceName).append(1, '.').append(memberName);
+        if (auto it = memberBudgets_.find(name); it != memberBudgets_.end())
+            return it->second;
+    }
+
+    return budget_;
+}
+
+void HandlerProfiler::updateActivity()
+{
+    const bool hasBudgets = budget_ > std::chrono::nanoseconds::zero() || !memberBudgets_.empty();
+    active_.store(enabled_.load(std::memory_order_relaxed) || hasBudgets, std::memory_order_relaxed);
+}
+
+}
@@ -0,0 +1,130 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file HandlerProfiler.h
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_INTERNAL_HANDLERPROFILER_H_
+#define SDBUS_CXX_INTERNAL_HANDLERPROFILER_H_
+
+#include "sdbus-c++/IConnection.h"
+#include "sdbus-c++/Message.h"
+
+#include "MetricsCollector.h"
+#include "Utils.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace sdbus::internal {
+
+    // Attributes the wall time of method and property handlers to their (kind, object path, interface, member),
+    // and reports handlers that exceed their budget to the slow handler callback. Call sites check isActive() first,
+    // so with both profiling and the watchdog off, the only cost is one relaxed atomic load. The profiler is thread-safe.
+    class HandlerProfiler
+    {
+    public:
+        using HandlerKind = ::sdbus::IConnection::HandlerKind;
+        using HandlerProfile = ::sdbus::IConnection::HandlerProfile;
+        using SlowHandlerWatchdog = ::sdbus::IConnection::SlowHandlerWatchdog;
+
+        [[nodiscard]] bool isActive() const noexcept
+        {
+            return active_.load(std::memory_order_relaxed);
+        }
+
+        void enable(bool enabled);
+        void setWatchdog(SlowHandlerWatchdog watchdog);
+
+        // Invokes a handler of the member addressed by the message, measuring its duration if the profiler is active
+        template <typename _Callable>
+        auto measure(HandlerKind kind, const Message& message, _Callable&& callable)
+        {
+            if (!isActive())
+                return callable();
+
+            // Read before the handler takes the message over
+            return measure(kind, message.getPath(), message.getInterfaceName(), message.getMemberName(), std::forward<_Callable>(callable));
+        }
+
+        template <typename _Callable>
+        auto measure(HandlerKind kind, const char* objectPath, const char* interfaceName, const char* memberName, _Callable&& callable)
+        {
+            if (!isActive())
+                return callable();
+
+            const auto start = now();
+            auto result = callable();
+            record(kind, toView(objectPath), toView(interfaceName), toView(memberName), now() - start);
+            return result;
+        }
+
+        void record( HandlerKind kind
+                   , std::string_view objectPath
+                   , std::string_view interfaceName
+                   , std::string_view memberName
+                   , std::chrono::nanoseconds duration );
+        [[nodiscard]] std::vector<HandlerProfile> getProfiles() const;
+        void reset();
+
+    private:
+        using Key = std::tuple<HandlerKind, std::string, std::string, std::string>;
+        using KeyView = std::tuple<HandlerKind, std::string_view, std::string_view, std::string_view>;
+        using SlowHandlerCallback = decltype(SlowHandlerWatchdog::callback);
+
+        struct Entry
+        {
+            MetricsCollector::Histogram duration;
+            std::atomic<uint64_t> maxDuration{}; // In nanoseconds
+            std::atomic<uint64_t> overBudgetCount{};
+            std::chrono::nanoseconds budget{}; // Cached budget of the member, zero if none. Guarded by the mutex.
+        };
+
+        // Returns the callback to report the slow handler with, if the handler has exceeded its budget
+        std::shared_ptr<const SlowHandlerCallback> update(Entry& entry, std::chrono::nanoseconds duration);
+        [[nodiscard]] std::chrono::nanoseconds getBudget(std::string_view interfaceName, std::string_view memberName) const;
+        void updateActivity();
+        static std::string_view toView(const char* str) { return str != nullptr ? str : ""; }
+
+    private:
+        std::atomic<bool> enabled_{};
+        std::atomic<bool> active_{}; // Profiling enabled, or watchdog budgets set
+        mutable std::shared_mutex mutex_;
+        std::map<Key, Entry, std::less<>> entries_;
+        std::chrono::nanoseconds budget_{};
+        std::map<std::string, std::chrono::nanoseconds, std::less<>> memberBudgets_;
+        std::shared_ptr<const SlowHandlerCallback> callback_;
+    };
+
+}
+
+#endif /* SDBUS_CXX_INTERNAL_HANDLERPROFILER_H_ */
@@ -30,9 +30,13 @@
 #include "sdbus-c++/IConnection.h"
 
 #include "sdbus-c++/TypeTraits.h"
+#include "sdbus-c++/Types.h"
 
+#include <chrono>
 #include <functional>
 #include <memory>
+#include <memory_resource>
+#include <span>
 #include <string>
 #include SDBUS_HEADER
 #include <vector>
@@ -54,6 +58,9 @@ namespace sdbus {
     class Error;
     namespace internal {
         class ISdBus;
+        class MetricsCollector;
+        class HandlerProfiler;
+        class StartupProfiler;
     }
 }
 
@@ -70,6 +77,34 @@ namespace sdbus::internal {
                                                   , const sd_bus_vtable* vtable
                                                   , void* userData
                                                   , return_slot_t ) = 0;
+        [[nodiscard]] virtual Slot addFallbackVTable( const ObjectPath& prefix
+                                                    , const InterfaceName& interfaceName
+                                                    , const sd_bus_vtable* vtable
+                                                    , sd_bus_object_find_t find
+                                                    , void* userData
+                                                    , return_slot_t ) = 0;
+        [[nodiscard]] virtual Slot addNodeEnumerator( const ObjectPath& prefix
+                                                    , sd_bus_node_enumerator_t callback
+                                                    , void* userData
+                                                    , return_slot_t ) = 0;
+        // Registers a handler of all method calls to the given object path and the paths below it
+        [[nodiscard]] virtual Slot addFallbackHandler( const ObjectPath& prefix
+                                                     , sd_bus_message_handler_t callback
+                                                     , void* userData
+                                                     , return_slot_t ) = 0;
+        struct ObjectVTable
+        {
+            const ObjectPath& objectPath;
+            const InterfaceName& interfaceName;
+            const sd_bus_vtable* vtable;
+            void* userData;
+        };
+        // Registers the vtables and emits InterfacesAdded signal for each of their object paths, with interfaces of its vtables,
+        // under one lock acquisition. Returns slots of the vtables, in their order. On failure, no vtable remains registered.
+        [[nodiscard]] virtual std::vector<Slot> addObjectVTables(std::span<const ObjectVTable> vtables, return_slot_t) = 0;
+        // Emits InterfacesRemoved signal for each of the object paths, with all their registered interfaces,
+        // and then releases the raw sd-bus slots, under one lock acquisition. The slots are released in any case.
+        virtual void removeObjects(std::span<const char* const> objectPaths, std::span<sd_bus_slot* const> slots) = 0;
 
         [[nodiscard]] virtual PlainMessage createPlainMessage() const = 0;
         [[nodiscard]] virtual MethodCall createMethodCall( const ServiceName& destination
@@ -93,6 +128,11 @@ namespace sdbus::internal {
         virtual void emitPropertiesChangedSignal( const char* objectPath
                                                 , const char* interfaceName
                                                 , const std::vector<PropertyName>& propNames ) = 0;
+        // Collects the changes and emits them merged, from the event loop, once the interval since the first of them elapses
+        virtual void coalescePropertiesChangedSignal( const char* objectPath
+                                                    , const char* interfaceName
+                                                    , const std::vector<PropertyName>& propNames
+                                                    , std::chrono::microseconds interval ) = 0;
         virtual void emitInterfacesAddedSignal(const ObjectPath& objectPath) = 0;
         virtual void emitInterfacesAddedSignal( const ObjectPath& objectPath
                                               , const std::vector<InterfaceName>& interfaces ) = 0;
@@ -100,11 +140,24 @@ namespace sdbus::internal {
         virtual void emitInterfacesRemovedSignal( const ObjectPath& objectPath
                                                 , const std::vector<InterfaceName>& interfaces ) = 0;
 
+        // With a non-null install callback, the match rule is installed in the bus daemon asynchronously, and the callback
+        // gets the reply to the AddMatch call, with the same user data. Otherwise, the function waits for the installation.
         [[nodiscard]] virtual Slot registerSignalHandler( const char* sender
                                                         , const char* objectPath
                                                         , const char* interfaceName
                                                         , const char* signalName
                                                         , sd_bus_message_handler_t callback
+                                                        , sd_bus_message_handler_t installCallback
+                                                        , void* userData
+                                                        , return_slot_t ) = 0;
+        // Same as above, with the argument filters added to the match rule. Empty names are not part of the rule.
+        [[nodiscard]] virtual Slot registerSignalHandler( const char* sender
+                                                        , const char* objectPath
+                                                        , const char* interfaceName
+                                                        , const char* signalName
+                                                        , const std::vector<SignalArgFilter>& argFilters
+                                                        , sd_bus_message_handler_t callback
+                                                        , sd_bus_message_handler_t installCallback
                                                         , void* userData
                                                         , return_slot_t ) = 0;
 
@@ -117,15 +170,51 @@ namespace sdbus::internal {
         virtual sd_bus_creds* decrementCredsRefCount(sd_bus_creds* creds) = 0;
 
         virtual sd_bus_message* callMethod(sd_bus_message* sdbusMsg, uint64_t timeout) = 0;
+        // Non-throwing variant, reporting failures the sd_bus_call() way: by a negative errno and a set sdbusError
+        virtual int callMethod(sd_bus_message* sdbusMsg, uint64_t timeout, sd_bus_error* sdbusError, sd_bus_message** sdbusReply) = 0;
         [[nodiscard]] virtual Slot callMethodAsync( sd_bus_message* sdbusMsg
                                                   , sd_bus_message_handler_t callback
                                                   , void* userData
                                                   , uint64_t timeout
                                                   , return_slot_t ) = 0;
+        // Makes the async calls in order under one sd-bus lock acquisition, waking up the event loop at most once. Stops at,
+        // and returns, the first failure; slots of the calls made until then are appended to `slots`. Timeouts of 0 mean the default.
+        virtual int callMethodsAsync( sd_bus_message** sdbusMsgs
+                                    , const uint64_t* timeouts
+                                    , sd_bus_message_handler_t callback
+                                    , void** userData
+                                    , std::size_t count
+                                    , std::vector<Slot>& slots ) = 0;
         virtual void sendMessage(sd_bus_message* sdbusMsg) = 0;
+        virtual void sendMessages(sd_bus_message** sdbusMsgs, std::size_t count) = 0;
+        // Signals are subject to the outbound queue limits, unlike other messages
+        virtual void sendSignal(sd_bus_message* sdbusMsg) = 0;
+        virtual void sendSignals(sd_bus_message** sdbusMsgs, std::size_t count) = 0;
+
+        [[nodiscard]] virtual MetricsCollector& getMetricsCollector() = 0;
+        [[nodiscard]] virtual HandlerProfiler& getHandlerProfiler() = 0;
+        [[nodiscard]] virtual StartupProfiler& getStartupProfiler() = 0;
+        [[nodiscard]] virtual std::shared_ptr<ITracer> getTracer() const = 0;
+        [[nodiscard]] virtual const std::shared_ptr<std::pmr::memory_resource>& getMemoryResource() const = 0;
 
         virtual sd_bus_message* createMethodReply(sd_bus_message* sdbusMsg) = 0;
         virtual sd_bus_message* createErrorReplyMessage(sd_bus_message* sdbusMsg, const Error& error) = 0;
+
+        // Hands the method call over to the dispatch pool, if enabled. Returns false if the call shall be handled in place.
+        // High priority calls are handled ahead of other calls queued in the connection. The owner is the object whose
+        // handler the call is destined for.
+        virtual bool dispatchMethodCall(MethodCall& call, const method_callback& callback, const void* owner, bool isHighPriority) = 0;
+        // Fails the calls of the owner still queued in the connection, and waits for those being handled by the dispatch
+        // pool to finish, so that none of the owner's handlers is invoked afterwards
+        virtual void cancelMethodCalls(const void* owner) = 0;
+
+        // Hands the work over to the event loop of the connection, which does it in its next processing step, outside of
+        // sd-bus processing and with no bus lock held. Work still pending when the connection is destroyed is dropped.
+        virtual void post(std::function<void()> work) = 0;
+
+        // Registers a handler invoked at the beginning of the destruction of the connection, so that objects referring to
+        // it, like broadcast groups, can let go of it. Destroying the returned slot unregisters the handler.
+        [[nodiscard]] virtual Slot addDestructionHandler(std::function<void()> handler) = 0;
     };
 
     [[nodiscard]] std::unique_ptr<sdbus::internal::IConnection> createPseudoConnection();
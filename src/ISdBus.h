@@ -28,6 +28,12 @@
 #ifndef SDBUS_CXX_ISDBUS_H
 #define SDBUS_CXX_ISDBUS_H
 
+#include "sdbus-c++/IConnection.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
 #include SDBUS_HEADER
 
 namespace sdbus::internal {
@@ -42,14 +48,33 @@ namespace sdbus::internal {
             uint64_t timeout_usec;
         };
 
+        struct ObjectVTable
+        {
+            const char* path;
+            const char* interface;
+            const sd_bus_vtable* vtable;
+            void* userdata;
+        };
+
         virtual ~ISdBus() = default;
 
         virtual sd_bus_message* sd_bus_message_ref(sd_bus_message *m) = 0;
         virtual sd_bus_message* sd_bus_message_unref(sd_bus_message *m) = 0;
+        // Refs the messages under one lock acquisition
+        virtual void sd_bus_message_ref_many(sd_bus_message **m, std::size_t count) = 0;
 
         virtual int sd_bus_send(sd_bus *bus, sd_bus_message *m, uint64_t *cookie) = 0;
+        // Sends the messages in order under one lock acquisition. Stops at, and returns, the first failure.
+        virtual int sd_bus_send_many(sd_bus *bus, sd_bus_message **m, std::size_t count) = 0;
         virtual int sd_bus_call(sd_bus *bus, sd_bus_message *m, uint64_t usec, sd_bus_error *ret_error, sd_bus_message **reply) = 0;
         virtual int sd_bus_call_async(sd_bus *bus, sd_bus_slot **slot, sd_bus_message *m, sd_bus_message_handler_t callback, void *userdata, uint64_t usec) = 0;
+        // Does sd_bus_call_async(), then takes a reference to the call message into `call` (unless it's null) and sums up the sizes
+        // of the read and write queues into `queued`, all under one lock acquisition. Fails only if sd_bus_call_async() fails.
+        virtual int sd_bus_call_async_get_n_queued(sd_bus *bus, sd_bus_slot **slot, sd_bus_message *m, sd_bus_message_handler_t callback, void *userdata, uint64_t usec, sd_bus_message **call, uint64_t *queued) = 0;
+        // Does sd_bus_call_async_get_n_queued() for each of the messages in order, with `calls` (unless it's null) and `queued` being
+        // taken once for all of them, all under one lock acquisition. Stops at, and returns, the first failure, leaving the slots
+        // (and the call references) of the messages not called untouched. The queues are summed up if at least one call's been made.
+        virtual int sd_bus_call_async_many(sd_bus *bus, sd_bus_slot **slots, sd_bus_message **m, sd_bus_message_handler_t callback, void **userdata, uint64_t usec, std::size_t count, sd_bus_message **calls, uint64_t *queued) = 0;
 
         virtual int sd_bus_message_new(sd_bus *bus, sd_bus_message **m, uint8_t type) = 0;
         virtual int sd_bus_message_new_method_call(sd_bus *bus, sd_bus_message **m, const char *destination, const char *path, const char *interface, const char *member) = 0;
@@ -65,6 +90,12 @@ namespace sdbus::internal {
         virtual int sd_bus_emit_object_removed(sd_bus *bus, const char *path) = 0;
         virtual int sd_bus_emit_interfaces_added_strv(sd_bus *bus, const char *path, char **interfaces) = 0;
         virtual int sd_bus_emit_interfaces_removed_strv(sd_bus *bus, const char *path, char **interfaces) = 0;
+        // Does sd_bus_add_object_vtable() for each of the vtables, storing the slots into `slots`, followed by sd_bus_emit_interfaces_added_strv()
+        // for each of the paths with its interfaces, all under one lock acquisition. Stops at, and returns, the first failure.
+        virtual int sd_bus_add_objects(sd_bus *bus, const ObjectVTable *vtables, sd_bus_slot **slots, std::size_t count, const char **paths, char ***interfaces, std::size_t pathCount) = 0;
+        // Does sd_bus_emit_object_removed() for each of the paths, followed by sd_bus_slot_unref() of each of the slots, any of which may be null,
+        // all under one lock acquisition. Stops emitting at, and returns, the first failure. The slots are unref'd in any case.
+        virtual int sd_bus_remove_objects(sd_bus *bus, const char *const *paths, std::size_t pathCount, sd_bus_slot *const *slots, std::size_t count) = 0;
 
         virtual int sd_bus_open(sd_bus **ret) = 0;
         virtual int sd_bus_open_system(sd_bus **ret) = 0;
@@ -77,17 +108,29 @@ namespace sdbus::internal {
         virtual int sd_bus_request_name(sd_bus *bus, const char *name, uint64_t flags) = 0;
         virtual int sd_bus_release_name(sd_bus *bus, const char *name) = 0;
         virtual int sd_bus_get_unique_name(sd_bus *bus, const char **name) = 0;
+        virtual int sd_bus_is_trusted(sd_bus *bus) = 0;
         virtual int sd_bus_add_object_vtable(sd_bus *bus, sd_bus_slot **slot, const char *path, const char *interface, const sd_bus_vtable *vtable, void *userdata) = 0;
+        virtual int sd_bus_add_fallback_vtable(sd_bus *bus, sd_bus_slot **slot, const char *prefix, const char *interface, const sd_bus_vtable *vtable, sd_bus_object_find_t find, void *userdata) = 0;
+        virtual int sd_bus_add_node_enumerator(sd_bus *bus, sd_bus_slot **slot, const char *path, sd_bus_node_enumerator_t callback, void *userdata) = 0;
+        virtual int sd_bus_add_fallback(sd_bus *bus, sd_bus_slot **slot, const char *prefix, sd_bus_message_handler_t callback, void *userdata) = 0;
         virtual int sd_bus_add_object_manager(sd_bus *bus, sd_bus_slot **slot, const char *path) = 0;
         virtual int sd_bus_add_match(sd_bus *bus, sd_bus_slot **slot, const char *match, sd_bus_message_handler_t callback, void *userdata) = 0;
         virtual int sd_bus_add_match_async(sd_bus *bus, sd_bus_slot **slot, const char *match, sd_bus_message_handler_t callback, sd_bus_message_handler_t install_callback, void *userdata) = 0;
+        virtual int sd_bus_add_filter(sd_bus *bus, sd_bus_slot **slot, sd_bus_message_handler_t callback, void *userdata) = 0;
         virtual int sd_bus_match_signal(sd_bus *bus, sd_bus_slot **ret, const char *sender, const char *path, const char *interface, const char *member, sd_bus_message_handler_t callback, void *userdata) = 0;
+        virtual int sd_bus_match_signal_async(sd_bus *bus, sd_bus_slot **ret, const char *sender, const char *path, const char *interface, const char *member, sd_bus_message_handler_t callback, sd_bus_message_handler_t install_callback, void *userdata) = 0;
         virtual sd_bus_slot* sd_bus_slot_unref(sd_bus_slot *slot) = 0;
+        // Unrefs the slots and the messages, any of which may be null, under one lock acquisition
+        virtual void sd_bus_unref_many(sd_bus_slot **slots, sd_bus_message **messages, std::size_t count) = 0;
 
         virtual int sd_bus_new(sd_bus **ret) = 0;
         virtual int sd_bus_start(sd_bus *bus) = 0;
 
         virtual int sd_bus_process(sd_bus *bus, sd_bus_message **r) = 0;
+        // Runs the callback under the lock, the way sd_bus_process() runs message handlers. For messages not read off the bus.
+        virtual int sd_bus_process_locally(sd_bus *bus, const std::function<int()>& callback) = 0;
+        // Tells whether the calling thread is in sd_bus_process() or sd_bus_process_locally(), holding the lock while running callbacks
+        [[nodiscard]] virtual bool isProcessingInCurrentThread() const = 0;
         virtual sd_bus_message* sd_bus_get_current_message(sd_bus *bus) = 0;
         virtual int sd_bus_get_poll_data(sd_bus *bus, PollData* data) = 0;
         virtual int sd_bus_get_n_queued(sd_bus *bus, uint64_t *read, uint64_t* write) = 0;
@@ -96,6 +139,9 @@ namespace sdbus::internal {
         virtual sd_bus *sd_bus_close_unref(sd_bus *bus) = 0;
 
         virtual int sd_bus_message_set_destination(sd_bus_message *m, const char *destination) = 0;
+        virtual const char* sd_bus_message_get_sender(sd_bus_message *m) = 0;
+        virtual int sd_bus_message_set_sender(sd_bus_message *m, const char *sender) = 0;
+        virtual int sd_bus_message_seal(sd_bus_message *m, uint64_t cookie, uint64_t timeout_usec) = 0;
 
         virtual int sd_bus_query_sender_creds(sd_bus_message *m, uint64_t mask, sd_bus_creds **c) = 0;
         virtual sd_bus_creds* sd_bus_creds_ref(sd_bus_creds *c) = 0;
@@ -108,6 +154,11 @@ namespace sdbus::internal {
         virtual int sd_bus_creds_get_egid(sd_bus_creds *c, gid_t *egid) = 0;
         virtual int sd_bus_creds_get_supplementary_gids(sd_bus_creds *c, const gid_t **gids) = 0;
         virtual int sd_bus_creds_get_selinux_context(sd_bus_creds *c, const char **label) = 0;
+
+        // Profiling of contention on the lock guarding the calls above, see sdbus::IConnection::enableBusLockProfiling()
+        virtual void enableLockProfiling(bool enabled, uint32_t samplingInterval) = 0;
+        [[nodiscard]] virtual std::vector<::sdbus::IConnection::Metrics::BusLockProfile> getLockProfiles() const = 0;
+        virtual void resetLockProfiles() = 0;
     };
 
 }
@@ -0,0 +1,461 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file IntrospectionCache.cpp
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IntrospectionCache.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace sdbus::internal {
+
+namespace {
+    // Verbatim parts of introspection XML, as provided by sd-bus. sd-bus doesn't expose them, so they are copied from its
+    // introspection code. They have been stable across sd-bus versions, but aren't a part of its API. Should a version
+    // differ, cached XML would differ from that of sd-bus in these standard interfaces only, which is still a valid
+    // description. The AnswersIntrospectCallsFromCacheWithSameXmlAsSdBus integration test detects such a difference.
+    constexpr std::string_view INTROSPECTION_PROLOGUE =
+        "<!DOCTYPE node PUBLIC \"-//freedesktop//DTD D-BUS Object Introspection 1.0//EN\"\n"
+        "\"https://www.freedesktop.org/standards/dbus/1.0/introspect.dtd\">\n"
+        "<node>\n"
+        " <interface name=\"org.freedesktop.DBus.Peer\">\n"
+        "  <method name=\"Ping\"/>\n"
+        "  <method name=\"GetMachineId\">\n"
+        "   <arg type=\"s\" name=\"machine_uuid\" direction=\"out\"/>\n"
+        "  </method>\n"
+        " </interface>\n"
+        " <interface name=\"org.freedesktop.DBus.Introspectable\">\n"
+        "  <method name=\"Introspect\">\n"
+        "   <arg name=\"xml_data\" type=\"s\" direction=\"out\"/>\n"
+        "  </method>\n"
+        " </interface>\n"
+        " <interface name=\"org.freedesktop.DBus.Properties\">\n"
+        "  <method name=\"Get\">\n"
+        "   <arg name=\"interface_name\" direction=\"in\" type=\"s\"/>\n"
+        "   <arg name=\"property_name\" direction=\"in\" type=\"s\"/>\n"
+        "   <arg name=\"value\" direction=\"out\" type=\"v\"/>\n"
+        "  </method>\n"
+        "  <method name=\"GetAll\">\n"
+        "   <arg name=\"interface_name\" direction=\"in\" type=\"s\"/>\n"
+        "   <arg name=\"props\" direction=\"out\" type=\"a{sv}\"/>\n"
+        "  </method>\n"
+        "  <method name=\"Set\">\n"
+        "   <arg name=\"interface_name\" direction=\"in\" type=\"s\"/>\n"
+        "   <arg name=\"property_name\" direction=\"in\" type=\"s\"/>\n"
+        "   <arg name=\"value\" direction=\"in\" type=\"v\"/>\n"
+        "  </method>\n"
+        "  <signal name=\"PropertiesChanged\">\n"
+        "   <arg type=\"s\" name=\"interface_name\"/>\n"
+        "   <arg type=\"a{sv}\" name=\"changed_properties\"/>\n"
+        "   <arg type=\"as\" name=\"invalidated_properties\"/>\n"
+        "  </signal>\n"
+        " </interface>\n";
+
+    constexpr std::string_view OBJECT_MANAGER_INTERFACE =
+        " <interface name=\"org.freedesktop.DBus.ObjectManager\">\n"
+        "  <method name=\"GetManagedObjects\">\n"
+        "   <arg type=\"a{oa{sa{sv}}}\" name=\"object_paths_interfaces_and_properties\" direction=\"out\"/>\n"
+        "  </method>\n"
+        "  <signal name=\"InterfacesAdded\">\n"
+        "   <arg type=\"o\" name=\"object_path\"/>\n"
+        "   <arg type=\"a{sa{sv}}\" name=\"interfaces_and_properties\"/>\n"
+        "  </signal>\n"
+        "  <signal name=\"InterfacesRemoved\">\n"
+        "   <arg type=\"o\" name=\"object_path\"/>\n"
+        "   <arg type=\"as\" name=\"interfaces\"/>\n"
+        "  </signal>\n"
+        " </interface>\n";
+
+    constexpr std::string_view INTROSPECTION_EPILOGUE = "</node>\n";
+
+    // Length of the first single complete type in the signature
+    std::size_t getElementLength(std::string_view signature)
+    {
+        std::size_t length{};
+        while (length < signature.size() && signature[length] == 'a')
+            ++length;
+
+        int depth{};
+        for (; length < signature.size(); ++length)
+        {
+            if (signature[length] == '(' || signature[length] == '{')
+                ++depth;
+            else if (signature[length] == ')' || signature[length] == '}')
+                --depth;
+
+            if (depth == 0)
+                return length + 1;
+        }
+
+        return length;
+    }
+
+    std::string_view parentOf(std::string_view objectPath)
+    {
+        auto pos = objectPath.rfind('/');
+        return pos == 0 ? objectPath.substr(0, 1) : objectPath.substr(0, pos);
+    }
+}
+
+IntrospectionCache::IntrospectionCache(bool enabled)
+    : enabled_(enabled)
+{
+}
+
+void IntrospectionCache::enable(bool enabled)
+{
+    std::lock_guard lock(mutex_);
+
+    if (enabled_ && !enabled)
+    {
+        for (const auto& [path, node] : nodes_)
+            missedRegistrations_ += node.vtables.size() + node.subtreeSlots.size() + node.objectManagerSlots.size();
+        nodes_.clear();
+    }
+    enabled_ = enabled;
+}
+
+void IntrospectionCache::addVTable( std::string_view objectPath
+                                  , const void* slot
+                                  , std::string_view interfaceName
+                                  , const sd_bus_vtable* vtable )
+{
+    std::lock_guard lock(mutex_);
+
+    auto* node = getNodeToRecord(objectPath);
+    if (node == nullptr)
+        return;
+
+    auto& vtables = node->vtables;
+    auto sameInterface = [&](const VTableRecord& record){ return record.interfaceName == interfaceName; };
+    auto last = std::find_if(vtables.rbegin(), vtables.rend(), sameInterface);
+    auto position = last != vtables.rend() ? last.base() : vtables.begin();
+    vtables.insert(position, VTableRecord{slot, std::string{interfaceName}, vtable});
+
+    invalidate(objectPath);
+}
+
+void IntrospectionCache::addSubtreeRegistration(std::string_view objectPath, const void* slot)
+{
+    std::lock_guard lock(mutex_);
+
+    auto* node = getNodeToRecord(objectPath);
+    if (node == nullptr)
+        return;
+
+    node->subtreeSlots.push_back(slot);
+
+    invalidate(objectPath);
+}
+
+void IntrospectionCache::addObjectManager(std::string_view objectPath, const void* slot)
+{
+    std::lock_guard lock(mutex_);
+
+    auto* node = getNodeToRecord(objectPath);
+    if (node == nullptr)
+        return;
+
+    node->objectManagerSlots.push_back(slot);
+
+    invalidate(objectPath);
+}
+
+template <typename _Predicate>
+std::size_t IntrospectionCache::removeIf(std::string_view objectPath, _Predicate isRemoved)
+{
+    auto it = nodes_.find(objectPath);
+    if (it == nodes_.end())
+        return 0;
+
+    auto& node = it->second;
+    auto removed = std::erase_if(node.vtables, [&](const VTableRecord& record){ return isRemoved(record.slot); });
+    removed += std::erase_if(node.subtreeSlots, isRemoved);
+    removed += std::erase_if(node.objectManagerSlots, isRemoved);
+
+    invalidate(objectPath);
+
+    return removed;
+}
+
+void IntrospectionCache::remove(std::string_view objectPath, const void* slot)
+{
+    std::lock_guard lock(mutex_);
+
+    // A slot not found in the mirror is that of a missed registration
+    if (removeIf(objectPath, [slot](const void* registered){ return registered == slot; }) == 0)
+        forgetMissed(1);
+}
+
+void IntrospectionCache::remove(std::span<const char* const> objectPaths, std::span<sd_bus_slot* const> slots)
+{
+    std::lock_guard lock(mutex_);
+
+    std::size_t removed{};
+    for (const auto* objectPath : objectPaths)
+    {
+        removed += removeIf(objectPath, [slots](const void* registered)
+        {
+            return registered != nullptr && std::find(slots.begin(), slots.end(), registered) != slots.end();
+        });
+    }
+
+    const auto registered = static_cast<std::size_t>(std::count_if(slots.begin(), slots.end(), [](const auto* slot){ return slot != nullptr; }));
+    forgetMissed(registered - std::min(removed, registered));
+}
+
+void IntrospectionCache::forgetMissed(std::size_t count)
+{
+    missedRegistrations_ -= std::min(count, missedRegistrations_);
+}
+
+std::optional<std::string> IntrospectionCache::getXml(std::string_view objectPath, bool trusted)
+{
+    std::lock_guard lock(mutex_);
+
+    if (!enabled_ || missedRegistrations_ > 0 || isServedDynamically(objectPath))
+        return std::nullopt;
+
+    auto it = nodes_.find(objectPath);
+    if (it != nodes_.end() && it->second.xml)
+        return it->second.xml;
+
+    auto childNodes = getChildNodes(objectPath);
+    if (it == nodes_.end() && childNodes.empty())
+        return std::nullopt; // Unknown object
+
+    auto xml = createXml(it != nodes_.end() ? &it->second : nullptr, childNodes, trusted);
+    // Nodes without registrations, having only registered descendants, are kept just for their XML until those change
+    getNode(objectPath).xml = xml;
+
+    return xml;
+}
+
+IntrospectionCache::Node* IntrospectionCache::getNodeToRecord(std::string_view objectPath)
+{
+    if (!enabled_)
+    {
+        ++missedRegistrations_;
+        return nullptr;
+    }
+
+    return &getNode(objectPath);
+}
+
+IntrospectionCache::Node& IntrospectionCache::getNode(std::string_view objectPath)
+{
+    auto it = nodes_.find(objectPath);
+    if (it == nodes_.end())
+        it = nodes_.emplace(std::string{objectPath}, Node{}).first;
+    return it->second;
+}
+
+void IntrospectionCache::invalidate(std::string_view objectPath)
+{
+    // Introspection of the path itself changes, as well as child nodes listed in introspection of its ancestors
+    for (auto path = objectPath;; path = parentOf(path))
+    {
+        if (auto it = nodes_.find(path); it != nodes_.end())
+        {
+            if (it->second.isEmpty())
+                nodes_.erase(it);
+            else
+                it->second.xml.reset();
+        }
+
+        if (path.size() <= 1)
+            break;
+    }
+}
+
+bool IntrospectionCache::isServedDynamically(std::string_view objectPath) const
+{
+    for (auto path = objectPath;; path = parentOf(path))
+    {
+        if (auto it = nodes_.find(path); it != nodes_.end() && !it->second.subtreeSlots.empty())
+            return true;
+
+        if (path.size() <= 1)
+            return false;
+    }
+}
+
+std::vector<std::string> IntrospectionCache::getChildNodes(std::string_view objectPath) const
+{
+    std::string prefix{objectPath};
+    if (prefix != "/")
+        prefix += '/';
+
+    // Paths are ordered, so descendants of each child are skipped over by seeking to the first path past them
+    std::vector<std::string> childNodes;
+    for (auto it = nodes_.lower_bound(prefix); it != nodes_.end() && it->first.starts_with(prefix);)
+    {
+        auto child = it->first.substr(prefix.size(), it->first.find('/', prefix.size()) - prefix.size());
+        it = nodes_.lower_bound(prefix + child + '0'); // '0' follows '/' in ASCII, and precedes all object path characters
+        childNodes.push_back(std::move(child));
+    }
+
+    return childNodes;
+}
+
+std::string IntrospectionCache::createXml(const Node* node, const std::vector<std::string>& childNodes, bool trusted)
+{
+    std::string xml{INTROSPECTION_PROLOGUE};
+
+    if (node != nullptr && !node->objectManagerSlots.empty())
+        xml += OBJECT_MANAGER_INTERFACE;
+
+    // Consecutive vtables of the same interface are merged into one interface element
+    const std::string* previousInterface{};
+    for (const auto& record : node != nullptr ? std::span{node->vtables} : std::span<const VTableRecord>{})
+    {
+        if (record.vtable[0].flags & SD_BUS_VTABLE_HIDDEN)
+            continue;
+
+        if (previousInterface == nullptr || *previousInterface != record.interfaceName)
+        {
+            if (previousInterface != nullptr)
+                xml += " </interface>\n";
+            xml += " <interface name=\"" + record.interfaceName + "\">\n";
+        }
+        writeInterface(record.vtable, trusted, xml);
+        previousInterface = &record.interfaceName;
+    }
+    if (previousInterface != nullptr)
+        xml += " </interface>\n";
+
+    for (const auto& childNode : childNodes)
+        xml += " <node name=\"" + childNode + "\"/>\n";
+
+    xml += INTROSPECTION_EPILOGUE;
+
+    return xml;
+}
+
+void IntrospectionCache::writeInterface(const sd_bus_vtable* vtable, bool trusted, std::string& xml)
+{
+    const char* names = "";
+#if LIBSYSTEMD_VERSION>=242
+    // Like sd-bus, argument names are only introspected from vtables that declare having them
+    const bool hasNames = (vtable[0].x.start.features & _SD_BUS_VTABLE_PARAM_NAMES) != 0;
+#endif
+
+    for (const auto* item = vtable; item->type != _SD_BUS_VTABLE_END; ++item)
+    {
+        // Hidden members are left out, but not the interface itself
+        if (item->type != _SD_BUS_VTABLE_START && (item->flags & SD_BUS_VTABLE_HIDDEN))
+            continue;
+
+        switch (item->type)
+        {
+            case _SD_BUS_VTABLE_START:
+                if (item->flags & SD_BUS_VTABLE_DEPRECATED)
+                    xml += "  <annotation name=\"org.freedesktop.DBus.Deprecated\" value=\"true\"/>\n";
+                break;
+            case _SD_BUS_VTABLE_METHOD:
+                xml += "  <method name=\"" + std::string{item->x.method.member} + "\">\n";
+#if LIBSYSTEMD_VERSION>=242
+                names = hasNames && item->x.method.names != nullptr ? item->x.method.names : "";
+#endif
+                writeArguments(item->x.method.signature != nullptr ? item->x.method.signature : "", names, "in", xml);
+                writeArguments(item->x.method.result != nullptr ? item->x.method.result : "", names, "out", xml);
+                writeFlags(item->type, item->flags, trusted, xml);
+                xml += "  </method>\n";
+                break;
+            case _SD_BUS_VTABLE_PROPERTY:
+            case _SD_BUS_VTABLE_WRITABLE_PROPERTY:
+                xml += "  <property name=\"" + std::string{item->x.property.member}
+                     + "\" type=\"" + item->x.property.signature
+                     + "\" access=\"" + (item->type == _SD_BUS_VTABLE_WRITABLE_PROPERTY ? "readwrite" : "read") + "\">\n";
+                writeFlags(item->type, item->flags, trusted, xml);
+                xml += "  </property>\n";
+                break;
+            case _SD_BUS_VTABLE_SIGNAL:
+                xml += "  <signal name=\"" + std::string{item->x.signal.member} + "\">\n";
+#if LIBSYSTEMD_VERSION>=242
+                names = hasNames && item->x.signal.names != nullptr ? item->x.signal.names : "";
+#endif
+                writeArguments(item->x.signal.signature != nullptr ? item->x.signal.signature : "", names, nullptr, xml);
+                writeFlags(item->type, item->flags, trusted, xml);
+                xml += "  </signal>\n";
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+void IntrospectionCache::writeArguments(std::string_view signature, const char*& names, const char* direction, std::string& xml)
+{
+    while (!signature.empty())
+    {
+        auto length = getElementLength(signature);
+
+        xml += "   <arg type=\"";
+        xml += signature.substr(0, length);
+        xml += '"';
+        // Names are a sequence of null-terminated strings, one per argument, terminated by an empty string
+        if (*names != '\0')
+        {
+            xml += " name=\"";
+            xml += names;
+            xml += '"';
+            names += std::strlen(names) + 1;
+        }
+        if (direction != nullptr)
+        {
+            xml += " direction=\"";
+            xml += direction;
+            xml += "\"/>\n";
+        }
+        else
+            xml += "/>\n";
+
+        signature.remove_prefix(length);
+    }
+}
+
+void IntrospectionCache::writeFlags(char type, uint64_t flags, bool trusted, std::string& xml)
+{
+    if (flags & SD_BUS_VTABLE_DEPRECATED)
+        xml += "   <annotation name=\"org.freedesktop.DBus.Deprecated\" value=\"true\"/>\n";
+    if (type == _SD_BUS_VTABLE_METHOD && (flags & SD_BUS_VTABLE_METHOD_NO_REPLY))
+        xml += "   <annotation name=\"org.freedesktop.DBus.Method.NoReply\" value=\"true\"/>\n";
+    if (type == _SD_BUS_VTABLE_PROPERTY || type == _SD_BUS_VTABLE_WRITABLE_PROPERTY)
+    {
+        if (flags & SD_BUS_VTABLE_PROPERTY_EXPLICIT)
+            xml += "   <annotation name=\"org.freedesktop.systemd1.Explicit\" value=\"true\"/>\n";
+        if (flags & SD_BUS_VTABLE_PROPERTY_CONST)
+            xml += "   <annotation name=\"org.freedesktop.DBus.Property.EmitsChangedSignal\" value=\"const\"/>\n";
+        else if (flags & SD_BUS_VTABLE_PROPERTY_EMITS_INVALIDATION)
+            xml += "   <annotation name=\"org.freedesktop.DBus.Property.EmitsChangedSignal\" value=\"invalidates\"/>\n";
+        else if (!(flags & SD_BUS_VTABLE_PROPERTY_EMITS_CHANGE))
+            xml += "   <annotation name=\"org.freedesktop.DBus.Property.EmitsChangedSignal\" value=\"false\"/>\n";
+    }
+    if (!trusted && (type == _SD_BUS_VTABLE_METHOD || type == _SD_BUS_VTABLE_WRITABLE_PROPERTY) && !(flags & SD_BUS_VTABLE_UNPRIVILEGED))
+        xml += "   <annotation name=\"org.freedesktop.systemd1.Privileged\" value=\"true\"/>\n";
+}
+
+}
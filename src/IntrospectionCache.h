@@ -0,0 +1,108 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file IntrospectionCache.h
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_INTERNAL_INTROSPECTIONCACHE_H_
+#define SDBUS_CXX_INTERNAL_INTROSPECTIONCACHE_H_
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include SDBUS_HEADER
+#include <vector>
+
+namespace sdbus::internal {
+
+    // Mirror of what is registered at which object paths of a connection, producing introspection XML of object
+    // paths the way sd-bus does, and caching it until registrations at the path or below it change. Paths served
+    // by subtree (fallback) vtables or node enumerators are resolved by sd-bus dynamically, so no XML is produced
+    // for them, nor for paths unknown to the connection. The cache is thread-safe.
+    //
+    // While disabled, the cache mirrors nothing, it only counts registrations it has missed. As long as any of them
+    // is still registered, the mirror is incomplete, and all XML is left to sd-bus.
+    class IntrospectionCache
+    {
+    public:
+        explicit IntrospectionCache(bool enabled = true);
+
+        // Disabling drops the mirror, so registrations in it count as missed from then on
+        void enable(bool enabled);
+
+        // Registration records are identified by their sd-bus slot. Floating registrations have a null slot.
+        void addVTable(std::string_view objectPath, const void* slot, std::string_view interfaceName, const sd_bus_vtable* vtable);
+        void addSubtreeRegistration(std::string_view objectPath, const void* slot);
+        void addObjectManager(std::string_view objectPath, const void* slot);
+        void remove(std::string_view objectPath, const void* slot);
+        void remove(std::span<const char* const> objectPaths, std::span<sd_bus_slot* const> slots);
+
+        // Returns introspection XML of the object path, or nullopt if it has to be provided by sd-bus
+        [[nodiscard]] std::optional<std::string> getXml(std::string_view objectPath, bool trusted);
+
+    private:
+        struct VTableRecord
+        {
+            const void* slot;
+            std::string interfaceName;
+            const sd_bus_vtable* vtable;
+        };
+
+        struct Node
+        {
+            [[nodiscard]] bool isEmpty() const { return vtables.empty() && subtreeSlots.empty() && objectManagerSlots.empty(); }
+
+            // Ordered like in sd-bus: a new interface goes first, a vtable of an existing interface after its other vtables
+            std::vector<VTableRecord> vtables;
+            std::vector<const void*> subtreeSlots;
+            std::vector<const void*> objectManagerSlots;
+            std::optional<std::string> xml;
+        };
+
+        Node* getNodeToRecord(std::string_view objectPath);
+        Node& getNode(std::string_view objectPath);
+        template <typename _Predicate> std::size_t removeIf(std::string_view objectPath, _Predicate isRemoved);
+        void forgetMissed(std::size_t count);
+        void invalidate(std::string_view objectPath);
+        [[nodiscard]] bool isServedDynamically(std::string_view objectPath) const;
+        [[nodiscard]] std::vector<std::string> getChildNodes(std::string_view objectPath) const;
+        [[nodiscard]] static std::string createXml(const Node* node, const std::vector<std::string>& childNodes, bool trusted);
+        static void writeInterface(const sd_bus_vtable* vtable, bool trusted, std::string& xml);
+        static void writeArguments(std::string_view signature, const char*& names, const char* direction, std::string& xml);
+        static void writeFlags(char type, uint64_t flags, bool trusted, std::string& xml);
+
+    private:
+        std::mutex mutex_;
+        bool enabled_;
+        std::size_t missedRegistrations_{}; // Registered without being mirrored, and not removed yet
+        std::map<std::string, Node, std::less<>> nodes_;
+    };
+
+}
+
+#endif /* SDBUS_CXX_INTERNAL_INTROSPECTIONCACHE_H_ */
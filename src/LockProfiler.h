@@ -0,0 +1,209 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file LockProfiler.h
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_INTERNAL_LOCKPROFILER_H_
+#define SDBUS_CXX_INTERNAL_LOCKPROFILER_H_
+
+#include "sdbus-c++/Error.h"
+#include "sdbus-c++/IConnection.h"
+
+#include "MetricsCollector.h"
+#include "Utils.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace sdbus::internal {
+
+    // Profiles contention on a lock per lock site, i.e. per function taking the lock. Each acquisition is counted,
+    // and every n-th acquisition of a thread is sampled: the time waited for the lock and the time it was held are
+    // measured. Sites are registered process-wide under their function name on their first acquisition, and their
+    // statistics are allocated once profiling is enabled first. With profiling off, an acquisition costs one atomic
+    // load more than a plain lock. The profiler is thread-safe.
+    class LockProfiler
+    {
+    public:
+        using LockProfile = ::sdbus::IConnection::Metrics::BusLockProfile;
+
+        static constexpr std::size_t MAX_SITES{64};
+
+        // Registers a lock site of the given function, returning its index. Sites are a fixed set of functions,
+        // so running out of them is a programming error, which must not go unnoticed in release builds either.
+        static std::size_t registerSite(const char* function)
+        {
+            std::lock_guard lock(siteRegistryMutex_);
+            const auto index = siteCount_.load(std::memory_order_relaxed);
+            SDBUS_THROW_ERROR_IF(index >= MAX_SITES, "Failed to register lock site: too many lock sites", ENOSPC);
+            siteNames_[index] = function;
+            siteCount_.store(index + 1, std::memory_order_release);
+            return index;
+        }
+
+        [[nodiscard]] bool isEnabled() const noexcept
+        {
+            return enabled_.load(std::memory_order_acquire);
+        }
+
+        void enable(bool enabled, uint32_t samplingInterval)
+        {
+            std::lock_guard lock(mutex_);
+            if (enabled && sites_ == nullptr)
+                sites_ = std::make_unique<std::array<SiteStats, MAX_SITES>>();
+            samplingInterval_.store(samplingInterval, std::memory_order_relaxed);
+            enabled_.store(enabled, std::memory_order_release);
+        }
+
+        // Counts the acquisition, returning whether it's sampled. Only to be called while profiling is enabled.
+        bool recordAcquisition(std::size_t site) noexcept
+        {
+            (*sites_)[site].acquisitions.fetch_add(1, std::memory_order_relaxed);
+
+            thread_local uint32_t acquisitionsOfThread{};
+            return ++acquisitionsOfThread % samplingInterval_.load(std::memory_order_relaxed) == 0;
+        }
+
+        void recordWait(std::size_t site, std::chrono::nanoseconds duration) noexcept
+        {
+            (*sites_)[site].waitDuration.record(duration);
+        }
+
+        void recordHold(std::size_t site, std::chrono::nanoseconds duration) noexcept
+        {
+            (*sites_)[site].holdDuration.record(duration);
+        }
+
+        // Profiles of the sites acquired so far, in the order of site registration
+        [[nodiscard]] std::vector<LockProfile> getProfiles() const
+        {
+            std::lock_guard lock(mutex_);
+            std::vector<LockProfile> profiles;
+            if (sites_ == nullptr)
+                return profiles;
+
+            const auto siteCount = siteCount_.load(std::memory_order_acquire);
+            for (std::size_t i = 0; i < siteCount; ++i)
+            {
+                const auto& stats = (*sites_)[i];
+                const auto acquisitions = stats.acquisitions.load(std::memory_order_relaxed);
+                if (acquisitions == 0)
+                    continue;
+
+                auto& profile = profiles.emplace_back();
+                profile.function = siteNames_[i];
+                profile.acquisitions = acquisitions;
+                stats.waitDuration.snapshotTo(profile.waitDuration);
+                stats.holdDuration.snapshotTo(profile.holdDuration);
+            }
+
+            return profiles;
+        }
+
+        void reset()
+        {
+            std::lock_guard lock(mutex_);
+            if (sites_ == nullptr)
+                return;
+
+            for (auto& stats : *sites_)
+            {
+                stats.acquisitions.store(0, std::memory_order_relaxed);
+                stats.waitDuration.reset();
+                stats.holdDuration.reset();
+            }
+        }
+
+    private:
+        struct SiteStats
+        {
+            std::atomic<uint64_t> acquisitions{};
+            MetricsCollector::Histogram waitDuration;
+            MetricsCollector::Histogram holdDuration;
+        };
+
+        inline static std::mutex siteRegistryMutex_;
+        inline static std::array<const char*, MAX_SITES> siteNames_{};
+        inline static std::atomic<std::size_t> siteCount_{};
+
+        mutable std::mutex mutex_;
+        std::atomic<bool> enabled_{};
+        std::atomic<uint32_t> samplingInterval_{1};
+        std::unique_ptr<std::array<SiteStats, MAX_SITES>> sites_; // Kept once allocated, lock sites may be using it
+    };
+
+    // Scoped lock of a mutex, profiled by the lock profiler if it's enabled
+    template <typename _Mutex>
+    class ProfiledLockGuard
+    {
+    public:
+        ProfiledLockGuard(_Mutex& mutex, LockProfiler& profiler, std::size_t site)
+            : mutex_(mutex), profiler_(profiler), site_(site)
+        {
+            isSampled_ = profiler_.isEnabled() && profiler_.recordAcquisition(site_);
+            if (!isSampled_)
+            {
+                mutex_.lock();
+                return;
+            }
+
+            const auto start = now();
+            mutex_.lock();
+            lockedAt_ = now();
+            profiler_.recordWait(site_, lockedAt_ - start);
+        }
+
+        ~ProfiledLockGuard()
+        {
+            if (!isSampled_)
+            {
+                mutex_.unlock();
+                return;
+            }
+
+            const auto heldFor = now() - lockedAt_;
+            mutex_.unlock();
+            profiler_.recordHold(site_, heldFor);
+        }
+
+        ProfiledLockGuard(const ProfiledLockGuard&) = delete;
+        ProfiledLockGuard& operator=(const ProfiledLockGuard&) = delete;
+
+    private:
+        _Mutex& mutex_;
+        LockProfiler& profiler_;
+        std::size_t site_;
+        bool isSampled_{};
+        std::chrono::nanoseconds lockedAt_{};
+    };
+
+}
+
+#endif /* SDBUS_CXX_INTERNAL_LOCKPROFILER_H_ */
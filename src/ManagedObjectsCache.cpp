@@ -0,0 +1,425 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file ManagedObjectsCache.cpp
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ManagedObjectsCache.h"
+
+#include "sdbus-c++/Error.h"
+#include "sdbus-c++/Types.h"
+
+#include "MessageUtils.h"
+#include "ScopeGuard.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <utility>
+
+namespace sdbus::internal {
+
+namespace {
+    // Interfaces sd-bus lists, with no properties, first for each managed object
+    constexpr const char* STANDARD_INTERFACES[] = { "org.freedesktop.DBus.Peer"
+                                                  , "org.freedesktop.DBus.Introspectable"
+                                                  , "org.freedesktop.DBus.Properties"
+                                                  , "org.freedesktop.DBus.ObjectManager" };
+
+    std::string_view parentOf(std::string_view objectPath)
+    {
+        auto pos = objectPath.rfind('/');
+        return pos == 0 ? objectPath.substr(0, 1) : objectPath.substr(0, pos);
+    }
+}
+
+void ManagedObjectsCache::addVTable( std::string_view objectPath
+                                   , const void* slot
+                                   , std::string_view interfaceName
+                                   , const sd_bus_vtable* vtable
+                                   , void* userData )
+{
+    std::lock_guard lock(mutex_);
+
+    auto it = nodes_.find(objectPath);
+    if (it == nodes_.end())
+        it = nodes_.emplace(std::string{objectPath}, Node{}).first;
+
+    auto& vtables = it->second.vtables;
+    auto sameInterface = [&](const VTableRecord& record){ return record.interfaceName == interfaceName; };
+    auto last = std::find_if(vtables.rbegin(), vtables.rend(), sameInterface);
+    auto position = last != vtables.rend() ? last.base() : vtables.begin();
+    vtables.insert(position, VTableRecord{slot, std::string{interfaceName}, vtable, userData, std::nullopt, ++generation_});
+}
+
+void ManagedObjectsCache::addSubtreeRegistration(std::string_view objectPath, const void* slot)
+{
+    std::lock_guard lock(mutex_);
+
+    auto it = nodes_.find(objectPath);
+    if (it == nodes_.end())
+        it = nodes_.emplace(std::string{objectPath}, Node{}).first;
+    it->second.subtreeSlots.push_back(slot);
+}
+
+void ManagedObjectsCache::addObjectManager(std::string_view objectPath, const void* slot)
+{
+    std::lock_guard lock(mutex_);
+
+    auto it = nodes_.find(objectPath);
+    if (it == nodes_.end())
+        it = nodes_.emplace(std::string{objectPath}, Node{}).first;
+    it->second.objectManagerSlots.push_back(slot);
+}
+
+template <typename _Predicate>
+void ManagedObjectsCache::removeIf(std::string_view objectPath, _Predicate isRemoved)
+{
+    // Serialized properties are released outside the lock, since releasing a message takes the sd-bus lock
+    std::vector<VTableRecord> removedVTables;
+
+    std::lock_guard lock(mutex_);
+
+    auto it = nodes_.find(objectPath);
+    if (it == nodes_.end())
+        return;
+
+    auto& node = it->second;
+    auto removed = std::stable_partition(node.vtables.begin(), node.vtables.end(), [&](const VTableRecord& record){ return !isRemoved(record.slot); });
+    std::move(removed, node.vtables.end(), std::back_inserter(removedVTables));
+    node.vtables.erase(removed, node.vtables.end());
+    std::erase_if(node.subtreeSlots, isRemoved);
+    std::erase_if(node.objectManagerSlots, isRemoved);
+    if (node.isEmpty())
+        nodes_.erase(it);
+}
+
+void ManagedObjectsCache::remove(std::string_view objectPath, const void* slot)
+{
+    removeIf(objectPath, [slot](const void* registered){ return registered == slot; });
+}
+
+void ManagedObjectsCache::remove(std::string_view objectPath, std::span<sd_bus_slot* const> slots)
+{
+    removeIf(objectPath, [slots](const void* registered)
+    {
+        return registered != nullptr && std::find(slots.begin(), slots.end(), registered) != slots.end();
+    });
+}
+
+void ManagedObjectsCache::invalidate(std::string_view objectPath, std::string_view interfaceName)
+{
+    std::vector<PlainMessage> evictedProperties;
+
+    std::lock_guard lock(mutex_);
+
+    auto it = nodes_.find(objectPath);
+    if (it == nodes_.end())
+        return;
+
+    ++generation_;
+    for (auto& record : it->second.vtables)
+    {
+        if (!interfaceName.empty() && record.interfaceName != interfaceName)
+            continue;
+
+        if (record.properties)
+            evictedProperties.push_back(std::move(*record.properties));
+        record.properties.reset();
+        record.changedAt = generation_;
+    }
+}
+
+bool ManagedObjectsCache::writeManagedObjects(sd_bus* bus, std::string_view objectPath, Message& reply)
+{
+    // Managed objects are collected under the lock, ordered by their paths and with their vtables in sd-bus order
+    std::vector<std::string> objectPaths;
+    std::vector<ManagedVTable> vtables;
+    std::uint64_t generation{};
+    {
+        std::lock_guard lock(mutex_);
+
+        auto it = nodes_.find(objectPath);
+        if (it == nodes_.end() || it->second.objectManagerSlots.empty() || isServedDynamically(objectPath))
+            return false;
+
+        std::string prefix{objectPath};
+        if (prefix != "/")
+            prefix += '/';
+
+        for (auto child = nodes_.lower_bound(prefix); child != nodes_.end() && child->first.starts_with(prefix); ++child)
+        {
+            if (!child->second.subtreeSlots.empty())
+                return false;
+            if (child->second.vtables.empty())
+                continue;
+
+            objectPaths.push_back(child->first);
+            for (const auto& record : child->second.vtables)
+                vtables.push_back({objectPaths.size() - 1, record.slot, record.vtable, record.userData, record.interfaceName, record.properties});
+        }
+
+        generation = generation_;
+    }
+
+    // Getters are invoked outside the lock, since they may well emit PropertiesChanged, invalidating the cache
+    bool serialized{};
+    for (auto& vtable : vtables)
+    {
+        if (vtable.properties)
+            continue;
+
+        try
+        {
+            vtable.properties = serializeProperties(bus, objectPaths[vtable.objectIndex], vtable.interfaceName, vtable.vtable, vtable.userData);
+        }
+        catch (const Error&)
+        {
+            return false; // Let sd-bus reply with the error of the failing getter
+        }
+        serialized = true;
+    }
+
+    if (serialized)
+    {
+        std::lock_guard lock(mutex_);
+
+        for (const auto& vtable : vtables)
+        {
+            auto node = nodes_.find(objectPaths[vtable.objectIndex]);
+            if (node == nodes_.end())
+                continue;
+
+            auto& records = node->second.vtables;
+            auto record = std::find_if(records.begin(), records.end(), [&](const VTableRecord& record)
+            {
+                return record.slot == vtable.slot && record.vtable == vtable.vtable;
+            });
+            // Properties that changed in the meantime may already be stale, so they are left to the next call
+            if (record != records.end() && !record->properties && record->changedAt <= generation)
+                record->properties = vtable.properties;
+        }
+    }
+
+    reply.openContainer("{oa{sa{sv}}}");
+    for (std::size_t i = 0; i < vtables.size();)
+    {
+        const auto objectIndex = vtables[i].objectIndex;
+
+        reply.openDictEntry("oa{sa{sv}}");
+        reply << ObjectPath{objectPaths[objectIndex]};
+        reply.openContainer("{sa{sv}}");
+        for (const auto* interfaceName : STANDARD_INTERFACES)
+        {
+            reply.openDictEntry("sa{sv}");
+            reply << interfaceName;
+            reply.openContainer("{sv}");
+            reply.closeContainer();
+            reply.closeDictEntry();
+        }
+
+        // Subsequent vtables of the same interface make up one interface entry, like in sd-bus
+        while (i < vtables.size() && vtables[i].objectIndex == objectIndex)
+        {
+            const auto& interfaceName = vtables[i].interfaceName;
+            reply.openDictEntry("sa{sv}");
+            reply << interfaceName;
+            reply.openContainer("{sv}");
+            for (; i < vtables.size() && vtables[i].objectIndex == objectIndex && vtables[i].interfaceName == interfaceName; ++i)
+            {
+                // The serialized properties are copied as they are, without invoking the getters again
+                auto& properties = *vtables[i].properties;
+                properties.rewind(true);
+                properties.enterContainer("{sv}");
+                properties.copyTo(reply, true);
+                properties.exitContainer();
+            }
+            reply.closeContainer();
+            reply.closeDictEntry();
+        }
+
+        reply.closeContainer();
+        reply.closeDictEntry();
+    }
+    reply.closeContainer();
+
+    return true;
+}
+
+void ManagedObjectsCache::clear()
+{
+    std::vector<PlainMessage> evictedProperties;
+
+    std::lock_guard lock(mutex_);
+
+    ++generation_;
+    for (auto& [objectPath, node] : nodes_)
+    {
+        for (auto& record : node.vtables)
+        {
+            if (record.properties)
+                evictedProperties.push_back(std::move(*record.properties));
+            record.properties.reset();
+            record.changedAt = generation_;
+        }
+    }
+}
+
+std::optional<ManagedObjectsCache::MethodHandler> ManagedObjectsCache::findMethod( std::string_view objectPath
+                                                                                 , std::string_view interfaceName
+                                                                                 , std::string_view methodName )
+{
+    std::lock_guard lock(mutex_);
+
+    auto [item, userData] = findMethodItem(objectPath, interfaceName, methodName);
+    if (item == nullptr)
+        return std::nullopt;
+
+    // Method handlers are addressed by the offset relative to the vtable userdata, like in sd-bus
+    auto* methodUserData = static_cast<std::uint8_t*>(userData) + item->x.method.offset;
+    return MethodHandler{item->x.method.handler, methodUserData};
+}
+
+bool ManagedObjectsCache::hasMethod( std::string_view objectPath
+                                   , std::string_view interfaceName
+                                   , std::string_view methodName
+                                   , std::string_view signature )
+{
+    std::lock_guard lock(mutex_);
+
+    auto [item, userData] = findMethodItem(objectPath, interfaceName, methodName);
+    if (item == nullptr)
+        return false;
+
+    return std::string_view{item->x.method.signature != nullptr ? item->x.method.signature : ""} == signature;
+}
+
+bool ManagedObjectsCache::hasInterface(std::string_view objectPath, std::string_view interfaceName)
+{
+    std::lock_guard lock(mutex_);
+
+    if (isServedDynamically(objectPath))
+        return true;
+
+    auto it = nodes_.find(objectPath);
+    if (it == nodes_.end())
+        return false;
+
+    return std::any_of( it->second.vtables.begin()
+                      , it->second.vtables.end()
+                      , [&](const VTableRecord& record){ return record.interfaceName == interfaceName; } );
+}
+
+std::pair<const sd_bus_vtable*, void*> ManagedObjectsCache::findMethodItem( std::string_view objectPath
+                                                                          , std::string_view interfaceName
+                                                                          , std::string_view methodName ) const
+{
+    auto it = nodes_.find(objectPath);
+    if (it == nodes_.end() || isServedDynamically(objectPath))
+        return {};
+
+    for (const auto& record : it->second.vtables)
+    {
+        if (record.interfaceName != interfaceName)
+            continue;
+
+        for (const auto* item = record.vtable; item->type != _SD_BUS_VTABLE_END; ++item)
+        {
+            if (item->type == _SD_BUS_VTABLE_METHOD && methodName == item->x.method.member)
+                return {item, record.userData};
+        }
+    }
+
+    return {};
+}
+
+bool ManagedObjectsCache::isServedDynamically(std::string_view objectPath) const
+{
+    for (auto path = objectPath;; path = parentOf(path))
+    {
+        if (auto it = nodes_.find(path); it != nodes_.end() && !it->second.subtreeSlots.empty())
+            return true;
+
+        if (path.size() <= 1)
+            return false;
+    }
+}
+
+PlainMessage ManagedObjectsCache::serializeProperties( sd_bus* bus
+                                                     , const std::string& objectPath
+                                                     , const std::string& interfaceName
+                                                     , const sd_bus_vtable* vtable
+                                                     , void* userData )
+{
+    auto properties = createPlainMessage();
+    auto* sdbusMessage = static_cast<sd_bus_message*>(Message::Factory::getSdBusMessage(properties));
+
+    // Properties are listed the way sd-bus lists them in InterfacesAdded signals and GetAll replies. Dict
+    // entries can't stand alone in a message, so they are wrapped in an array, which gets unwrapped on copying.
+    auto r = sd_bus_message_open_container(sdbusMessage, SD_BUS_TYPE_ARRAY, "{sv}");
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to serialize properties", -r);
+
+    for (const auto* item = vtable; item->type != _SD_BUS_VTABLE_END; ++item)
+    {
+        if (item->type != _SD_BUS_VTABLE_PROPERTY && item->type != _SD_BUS_VTABLE_WRITABLE_PROPERTY)
+            continue;
+        if ((vtable[0].flags | item->flags) & (SD_BUS_VTABLE_HIDDEN | SD_BUS_VTABLE_PROPERTY_EXPLICIT))
+            continue;
+        SDBUS_THROW_ERROR_IF(item->x.property.get == nullptr, "Property without a getter", ENOTSUP);
+
+        sd_bus_error sdbusError = SD_BUS_ERROR_NULL;
+        SCOPE_EXIT{ sd_bus_error_free(&sdbusError); };
+
+        r = sd_bus_message_open_container(sdbusMessage, SD_BUS_TYPE_DICT_ENTRY, "sv");
+        if (r >= 0)
+            r = sd_bus_message_append_basic(sdbusMessage, SD_BUS_TYPE_STRING, item->x.property.member);
+        if (r >= 0)
+            r = sd_bus_message_open_container(sdbusMessage, SD_BUS_TYPE_VARIANT, item->x.property.signature);
+        if (r >= 0)
+        {
+            // Property handlers are addressed by the offset relative to the vtable userdata, like in sd-bus
+            auto* propertyUserData = static_cast<std::uint8_t*>(userData) + item->x.property.offset;
+            r = item->x.property.get( bus
+                                    , objectPath.c_str()
+                                    , interfaceName.c_str()
+                                    , item->x.property.member
+                                    , sdbusMessage
+                                    , propertyUserData
+                                    , &sdbusError );
+        }
+        SDBUS_THROW_ERROR_IF(sd_bus_error_is_set(&sdbusError), "Failed to get property", EIO);
+        if (r >= 0)
+            r = sd_bus_message_close_container(sdbusMessage);
+        if (r >= 0)
+            r = sd_bus_message_close_container(sdbusMessage);
+        SDBUS_THROW_ERROR_IF(r < 0, "Failed to serialize property", -r);
+    }
+
+    r = sd_bus_message_close_container(sdbusMessage);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to serialize properties", -r);
+    properties.seal();
+
+    return properties;
+}
+
+}
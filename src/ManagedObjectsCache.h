@@ -0,0 +1,151 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file ManagedObjectsCache.h
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_INTERNAL_MANAGEDOBJECTSCACHE_H_
+#define SDBUS_CXX_INTERNAL_MANAGEDOBJECTSCACHE_H_
+
+#include "sdbus-c++/Message.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include SDBUS_HEADER
+#include <utility>
+#include <vector>
+
+namespace sdbus::internal {
+
+    // Mirror of vtables and object managers registered at object paths of a connection, producing replies to
+    // GetManagedObjects calls the way sd-bus does. Properties of each registered vtable are serialized on first
+    // demand and reused until the vtable's interface is announced or removed, or its properties change, so a call
+    // only invokes the getters of what has changed since the previous one. Object managers with subtree (fallback)
+    // vtables or node enumerators at, above or below their path are resolved by sd-bus dynamically, so no reply
+    // is produced for them. The cache is thread-safe.
+    class ManagedObjectsCache
+    {
+    public:
+        // Registration records are identified by their sd-bus slot. Floating registrations have a null slot.
+        void addVTable( std::string_view objectPath
+                      , const void* slot
+                      , std::string_view interfaceName
+                      , const sd_bus_vtable* vtable
+                      , void* userData );
+        void addSubtreeRegistration(std::string_view objectPath, const void* slot);
+        void addObjectManager(std::string_view objectPath, const void* slot);
+        void remove(std::string_view objectPath, const void* slot);
+        void remove(std::string_view objectPath, std::span<sd_bus_slot* const> slots);
+
+        // Drops serialized properties of the interface of the object, or of all its interfaces if the name is empty
+        void invalidate(std::string_view objectPath, std::string_view interfaceName = {});
+
+        // Writes the reply to GetManagedObjects of the object manager at the path, or returns false
+        // if the reply has to be provided by sd-bus. Property getters are invoked outside the lock.
+        [[nodiscard]] bool writeManagedObjects(sd_bus* bus, std::string_view objectPath, Message& reply);
+        void clear();
+
+        // Handler of a method of a registered vtable, with the userdata sd-bus would invoke it with
+        struct MethodHandler
+        {
+            sd_bus_message_handler_t handler;
+            void* userData;
+        };
+
+        // Looks up the handler of the method of the object like sd-bus does for an incoming call. Objects
+        // served by subtree (fallback) vtables or node enumerators are resolved by sd-bus dynamically, so
+        // no handler is found for them.
+        [[nodiscard]] std::optional<MethodHandler> findMethod( std::string_view objectPath
+                                                             , std::string_view interfaceName
+                                                             , std::string_view methodName );
+        // Tells whether findMethod() finds a handler of the method taking arguments of the signature
+        [[nodiscard]] bool hasMethod( std::string_view objectPath
+                                    , std::string_view interfaceName
+                                    , std::string_view methodName
+                                    , std::string_view signature );
+
+        // Tells whether the object has a vtable of the interface registered. Objects served by subtree (fallback) vtables
+        // or node enumerators are resolved by sd-bus dynamically, so they are assumed to have it.
+        [[nodiscard]] bool hasInterface(std::string_view objectPath, std::string_view interfaceName);
+
+    private:
+        struct VTableRecord
+        {
+            const void* slot;
+            std::string interfaceName;
+            const sd_bus_vtable* vtable;
+            void* userData;
+            std::optional<PlainMessage> properties; // Serialized {sv} entries of the vtable's properties
+            std::uint64_t changedAt; // Generation of the last change of the properties
+        };
+
+        struct Node
+        {
+            [[nodiscard]] bool isEmpty() const { return vtables.empty() && subtreeSlots.empty() && objectManagerSlots.empty(); }
+
+            // Ordered like in sd-bus: a new interface goes first, a vtable of an existing interface after its other vtables
+            std::vector<VTableRecord> vtables;
+            std::vector<const void*> subtreeSlots;
+            std::vector<const void*> objectManagerSlots;
+        };
+
+        // A vtable of a managed object as collected for a reply, with its properties serialized or yet to be
+        struct ManagedVTable
+        {
+            std::size_t objectIndex;
+            const void* slot;
+            const sd_bus_vtable* vtable;
+            void* userData;
+            std::string interfaceName;
+            std::optional<PlainMessage> properties;
+        };
+
+        template <typename _Predicate> void removeIf(std::string_view objectPath, _Predicate isRemoved);
+        [[nodiscard]] bool isServedDynamically(std::string_view objectPath) const;
+        // Must be called under the mutex, as the vtable item points into the vtable of the registration
+        [[nodiscard]] std::pair<const sd_bus_vtable*, void*> findMethodItem( std::string_view objectPath
+                                                                           , std::string_view interfaceName
+                                                                           , std::string_view methodName ) const;
+        static PlainMessage serializeProperties( sd_bus* bus
+                                               , const std::string& objectPath
+                                               , const std::string& interfaceName
+                                               , const sd_bus_vtable* vtable
+                                               , void* userData );
+
+    private:
+        std::mutex mutex_;
+        std::map<std::string, Node, std::less<>> nodes_;
+        // Counts property changes, so that properties serialized concurrently with their change aren't stored
+        std::uint64_t generation_{};
+    };
+
+}
+
+#endif /* SDBUS_CXX_INTERNAL_MANAGEDOBJECTSCACHE_H_ */
@@ -0,0 +1,125 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file MemoryResource.h
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_INTERNAL_MEMORYRESOURCE_H_
+#define SDBUS_CXX_INTERNAL_MEMORYRESOURCE_H_
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+namespace sdbus::internal {
+
+    // Creates an object in the given memory resource. The object must be destroyed by deleteObject() with the same resource.
+    template <typename _T, typename... _Args>
+    _T* newObject(std::pmr::memory_resource& resource, _Args&&... args)
+    {
+        void* memory = resource.allocate(sizeof(_T), alignof(_T));
+        try
+        {
+            return ::new (memory) _T{std::forward<_Args>(args)...};
+        }
+        catch (...)
+        {
+            resource.deallocate(memory, sizeof(_T), alignof(_T));
+            throw;
+        }
+    }
+
+    template <typename _T>
+    void deleteObject(std::pmr::memory_resource& resource, _T* object) noexcept
+    {
+        object->~_T();
+        resource.deallocate(object, sizeof(_T), alignof(_T));
+    }
+
+    // Deleter of objects created by newObject()
+    struct ObjectDeleter
+    {
+        std::pmr::memory_resource* resource;
+
+        template <typename _T>
+        void operator()(_T* object) const noexcept
+        {
+            deleteObject(*resource, object);
+        }
+    };
+
+    template <typename _T>
+    using PooledPtr = std::unique_ptr<_T, ObjectDeleter>;
+
+    template <typename _T, typename... _Args>
+    PooledPtr<_T> makePooled(std::pmr::memory_resource& resource, _Args&&... args)
+    {
+        return {newObject<_T>(resource, std::forward<_Args>(args)...), ObjectDeleter{&resource}};
+    }
+
+    // Allocator sharing the ownership of its memory resource, for objects (like std::allocate_shared control
+    // blocks) that may be kept alive by handles outliving the connection the resource belongs to
+    template <typename _T>
+    class SharedResourceAllocator
+    {
+    public:
+        using value_type = _T;
+
+        explicit SharedResourceAllocator(std::shared_ptr<std::pmr::memory_resource> resource) noexcept
+            : resource_(std::move(resource))
+        {
+        }
+
+        template <typename _U>
+        SharedResourceAllocator(const SharedResourceAllocator<_U>& other) noexcept
+            : resource_(other.resource_)
+        {
+        }
+
+        _T* allocate(std::size_t count)
+        {
+            return static_cast<_T*>(resource_->allocate(count * sizeof(_T), alignof(_T)));
+        }
+
+        void deallocate(_T* ptr, std::size_t count) noexcept
+        {
+            resource_->deallocate(ptr, count * sizeof(_T), alignof(_T));
+        }
+
+        template <typename _U>
+        bool operator==(const SharedResourceAllocator<_U>& other) const noexcept
+        {
+            return resource_ == other.resource_;
+        }
+
+    private:
+        template <typename _U> friend class SharedResourceAllocator;
+
+        std::shared_ptr<std::pmr::memory_resource> resource_;
+    };
+
+}
+
+#endif /* SDBUS_CXX_INTERNAL_MEMORYRESOURCE_H_ */
@@ -29,12 +29,25 @@
 #include "sdbus-c++/Error.h"
 #include "sdbus-c++/Types.h"
 
+#include "Compression.h"
 #include "IConnection.h"
 #include "MessageUtils.h"
 #include "ScopeGuard.h"
+#include "Utf8Validation.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <cstdarg>
 #include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <thread>
+#include <utility>
 #include SDBUS_HEADER
 
 namespace sdbus {
@@ -62,49 +75,103 @@ Message::Message(void *msg, internal::IConnection* connection, adopt_message_t)
     assert(connection_ != nullptr);
 }
 
+// Counter of Message copies sharing a single reference to the underlying sd-bus message. Copying a message and
+// destroying a copy other than the last one is thus an atomic counter update, instead of a round trip to sd-bus
+// message reference counting, which has to be serialized by the connection-wide sd-bus mutex.
+struct Message::SharedRefs
+{
+    std::atomic<std::size_t> count;
+};
+
 Message::Message(const Message& other) noexcept
+    : msg_(other.msg_)
+    , connection_(other.connection_)
+    , ok_(other.ok_)
+    , sharedRefs_(other.acquireSharedRefs())
 {
-    *this = other;
 }
 
 Message& Message::operator=(const Message& other) noexcept
 {
-    if (msg_)
-        connection_->decrementMessageRefCount((sd_bus_message*)msg_);
+    if (this == &other)
+        return *this;
+
+    releaseMessage();
 
     msg_ = other.msg_;
     connection_ = other.connection_;
     ok_ = other.ok_;
-
-    connection_->incrementMessageRefCount((sd_bus_message*)msg_);
+    sharedRefs_.store(other.acquireSharedRefs(), std::memory_order_relaxed);
 
     return *this;
 }
 
 Message::Message(Message&& other) noexcept
+    : msg_(std::exchange(other.msg_, nullptr))
+    , connection_(std::exchange(other.connection_, nullptr))
+    , ok_(std::exchange(other.ok_, true))
+    , sharedRefs_(other.sharedRefs_.exchange(nullptr, std::memory_order_relaxed))
 {
-    *this = std::move(other);
 }
 
 Message& Message::operator=(Message&& other) noexcept
 {
-    if (msg_)
-        connection_->decrementMessageRefCount((sd_bus_message*)msg_);
+    if (this == &other)
+        return *this;
 
-    msg_ = other.msg_;
-    other.msg_ = nullptr;
-    connection_ = other.connection_;
-    other.connection_ = nullptr;
-    ok_ = other.ok_;
-    other.ok_ = true;
+    releaseMessage();
+
+    msg_ = std::exchange(other.msg_, nullptr);
+    connection_ = std::exchange(other.connection_, nullptr);
+    ok_ = std::exchange(other.ok_, true);
+    sharedRefs_.store(other.sharedRefs_.exchange(nullptr, std::memory_order_relaxed), std::memory_order_relaxed);
 
     return *this;
 }
 
 Message::~Message()
 {
-    if (msg_)
-        connection_->decrementMessageRefCount((sd_bus_message*)msg_);
+    releaseMessage();
+}
+
+Message::SharedRefs* Message::acquireSharedRefs() const noexcept
+{
+    if (msg_ == nullptr)
+        return nullptr;
+
+    auto* refs = sharedRefs_.load(std::memory_order_acquire);
+    if (refs == nullptr)
+    {
+        // The first copy of the message: the original and the copy start sharing the reference
+        auto* newRefs = new (std::nothrow) SharedRefs{{2}};
+        if (newRefs == nullptr)
+        {
+            // Fall back to a reference of the copy's own
+            connection_->incrementMessageRefCount((sd_bus_message*)msg_);
+            return nullptr;
+        }
+        if (sharedRefs_.compare_exchange_strong(refs, newRefs, std::memory_order_acq_rel, std::memory_order_acquire))
+            return newRefs;
+        delete newRefs; // Another thread has made the first copy concurrently
+    }
+
+    refs->count.fetch_add(1, std::memory_order_relaxed);
+    return refs;
+}
+
+void Message::releaseMessage() noexcept
+{
+    if (msg_ == nullptr)
+        return;
+
+    if (auto* refs = sharedRefs_.exchange(nullptr, std::memory_order_relaxed); refs != nullptr)
+    {
+        if (refs->count.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+        delete refs;
+    }
+
+    connection_->decrementMessageRefCount((sd_bus_message*)msg_);
 }
 
 Message& Message::operator<<(bool item)
@@ -203,6 +270,9 @@ Message& Message::operator<<(const std::string& item)
 
 Message& Message::operator<<(std::string_view item)
 {
+    // sd-bus doesn't validate strings appended through the string space API, so we have to do it ourselves
+    SDBUS_THROW_ERROR_IF(!internal::isValidUtf8String(item), "Failed to serialize a string_view value: invalid UTF-8 string", EINVAL);
+
     char* destPtr{};
     auto r = sd_bus_message_append_string_space((sd_bus_message*)msg_, item.length(), &destPtr);
     SDBUS_THROW_ERROR_IF(r < 0, "Failed to serialize a string_view value", -r);
@@ -244,6 +314,47 @@ Message& Message::operator<<(const UnixFd &item)
     return *this;
 }
 
+Message& Message::operator<<(const SharedUnixFd &item)
+{
+    // sd-bus duplicates the fd for the message
+    auto fd = item.get();
+    auto r = sd_bus_message_append_basic((sd_bus_message*)msg_, SD_BUS_TYPE_UNIX_FD, &fd);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to serialize a SharedUnixFd value", -r);
+
+    return *this;
+}
+
+Message& Message::operator<<(const SharedBuffer &item)
+{
+    openStruct("ht");
+    *this << item.getFd() << static_cast<uint64_t>(item.size());
+    closeStruct();
+
+    return *this;
+}
+
+Message& Message::operator<<(const CompressedBytes &item)
+{
+    const auto& data = item.data();
+
+    // Small blocks aren't worth the effort, and the block is passed as is if the codec is unavailable or doesn't help
+    std::optional<std::vector<uint8_t>> compressed;
+    if (data.size() >= item.getThreshold())
+        compressed = internal::compressBytes(item.getCodec(), data);
+
+    // The original size travels as a uint32, which is way above the maximum D-Bus message size anyway
+    SDBUS_THROW_ERROR_IF(data.size() > std::numeric_limits<uint32_t>::max(), "Bytes too large to be compressed", EMSGSIZE);
+
+    openStruct("uyay");
+    if (compressed)
+        *this << static_cast<uint32_t>(data.size()) << static_cast<uint8_t>(item.getCodec()) << *compressed;
+    else
+        *this << static_cast<uint32_t>(data.size()) << static_cast<uint8_t>(CompressedBytes::Codec::None) << data;
+    closeStruct();
+
+    return *this;
+}
+
 Message& Message::appendArray(char type, const void *ptr, size_t size)
 {
     auto r = sd_bus_message_append_array((sd_bus_message*)msg_, type, ptr, size);
@@ -252,6 +363,37 @@ Message& Message::appendArray(char type, const void *ptr, size_t size)
     return *this;
 }
 
+Message& Message::appendArraySpace(char type, size_t size, void **ptr)
+{
+    auto r = sd_bus_message_append_array_space((sd_bus_message*)msg_, type, size, ptr);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to serialize an array", -r);
+
+    return *this;
+}
+
+Message& Message::appendStringArray(const std::string* items, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        SDBUS_THROW_ERROR_IF( !internal::isValidUtf8String(items[i])
+                            , "Failed to serialize a string array: invalid UTF-8 string at index " + std::to_string(i)
+                            , EINVAL );
+
+    openContainer("s");
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        char* destPtr{};
+        auto r = sd_bus_message_append_string_space((sd_bus_message*)msg_, items[i].length(), &destPtr);
+        SDBUS_THROW_ERROR_IF(r < 0, "Failed to serialize a string array", -r);
+
+        std::memcpy(destPtr, items[i].data(), items[i].length());
+    }
+
+    closeContainer();
+
+    return *this;
+}
+
 Message& Message::operator>>(bool& item)
 {
     int intItem;
@@ -387,6 +529,17 @@ Message& Message::operator>>(std::string& item)
     return *this;
 }
 
+Message& Message::operator>>(std::string_view& item)
+{
+    char* str{};
+    (*this) >> str;
+
+    if (str != nullptr)
+        item = str;
+
+    return *this;
+}
+
 Message& Message::operator>>(Variant &item)
 {
     item.deserializeFrom(*this);
@@ -444,6 +597,82 @@ Message& Message::operator>>(UnixFd &item)
     return *this;
 }
 
+Message& Message::operator>>(SharedUnixFd &item)
+{
+    UnixFd fd;
+    *this >> fd;
+
+    item = SharedUnixFd{std::move(fd)};
+
+    return *this;
+}
+
+Message& Message::operator>>(SharedBuffer &item)
+{
+    if (!enterStruct("ht"))
+        return *this;
+
+    UnixFd fd;
+    uint64_t size{};
+    *this >> fd >> size;
+    exitStruct();
+
+    if (*this)
+        item = SharedBuffer{std::move(fd), size};
+
+    return *this;
+}
+
+Message& Message::operator>>(CompressedBytes &item)
+{
+    if (!enterStruct("uyay"))
+        return *this;
+
+    uint32_t size{};
+    uint8_t codec{};
+    std::vector<uint8_t> data;
+    *this >> size >> codec >> data;
+    exitStruct();
+
+    if (!*this)
+        return *this;
+
+    if (static_cast<CompressedBytes::Codec>(codec) != CompressedBytes::Codec::None)
+        data = internal::decompressBytes(static_cast<CompressedBytes::Codec>(codec), data, size);
+    else
+        SDBUS_THROW_ERROR_IF(data.size() != size, "Uncompressed data doesn't match their announced size", EBADMSG);
+
+    // The receiving side keeps its own compression settings, e.g. for passing the data on
+    item = CompressedBytes{std::move(data), item.getCodec(), item.getThreshold()};
+
+    return *this;
+}
+
+Message& Message::appendTrivialStruct(const char* signature, ...)
+{
+    va_list args;
+    va_start(args, signature);
+    auto r = sd_bus_message_appendv((sd_bus_message*)msg_, signature, args);
+    va_end(args);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to serialize a struct", -r);
+
+    return *this;
+}
+
+Message& Message::readTrivialStruct(const char* signature, ...)
+{
+    va_list args;
+    va_start(args, signature);
+    auto r = sd_bus_message_readv((sd_bus_message*)msg_, signature, args);
+    va_end(args);
+    if (r == 0)
+        ok_ = false;
+
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to deserialize a struct", -r);
+
+    return *this;
+}
+
 Message& Message::openContainer(const char* signature)
 {
     auto r = sd_bus_message_open_container((sd_bus_message*)msg_, SD_BUS_TYPE_ARRAY, signature);
@@ -527,6 +756,17 @@ Message& Message::exitContainer()
     return *this;
 }
 
+Message& Message::skipToContainerEnd()
+{
+    int r{};
+    while ((r = sd_bus_message_skip((sd_bus_message*)msg_, nullptr)) > 0)
+        ; // Skips one complete type at a time, until the end of the container
+
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to skip rest of a container", -r);
+
+    return *this;
+}
+
 Message& Message::enterDictEntry(const char* signature)
 {
     auto r = sd_bus_message_enter_container((sd_bus_message*)msg_, SD_BUS_TYPE_DICT_ENTRY, signature);
@@ -595,9 +835,58 @@ void Message::clearFlags()
     ok_ = true;
 }
 
+namespace {
+
+// Like sd_bus_message_copy(), except that arrays of fixed-size elements are copied as single blocks of memory
+// instead of element by element, which makes forwarding and rebroadcasting bulky message bodies cheap
+int copyMessageContents(sd_bus_message* destination, sd_bus_message* source, bool all)
+{
+    do
+    {
+        char type{};
+        const char* contents{};
+        auto r = sd_bus_message_peek_type(source, &type, &contents);
+        if (r <= 0)
+            return r; // End of the message or of the enclosing container
+
+        if (type == SD_BUS_TYPE_ARRAY && contents[1] == '\0' && std::strchr("ybnqiuxtd", contents[0]) != nullptr)
+        {
+            const void* data{};
+            size_t size{};
+            r = sd_bus_message_read_array(source, contents[0], &data, &size);
+            if (r >= 0)
+                r = sd_bus_message_append_array(destination, contents[0], data, size);
+        }
+        else if ( type == SD_BUS_TYPE_ARRAY || type == SD_BUS_TYPE_VARIANT
+               || type == SD_BUS_TYPE_STRUCT || type == SD_BUS_TYPE_DICT_ENTRY )
+        {
+            r = sd_bus_message_enter_container(source, type, contents);
+            if (r >= 0)
+                r = sd_bus_message_open_container(destination, type, contents);
+            if (r >= 0)
+                r = copyMessageContents(destination, source, true);
+            if (r >= 0)
+                r = sd_bus_message_close_container(destination);
+            if (r >= 0)
+                r = sd_bus_message_exit_container(source);
+        }
+        else
+        {
+            r = sd_bus_message_copy(destination, source, false);
+        }
+
+        if (r < 0)
+            return r;
+    } while (all);
+
+    return 1;
+}
+
+}
+
 void Message::copyTo(Message& destination, bool complete) const
 {
-    auto r = sd_bus_message_copy((sd_bus_message*)destination.msg_, (sd_bus_message*)msg_, complete);
+    auto r = copyMessageContents((sd_bus_message*)destination.msg_, (sd_bus_message*)msg_, complete);
     SDBUS_THROW_ERROR_IF(r < 0, "Failed to copy the message", -r);
 }
 
@@ -640,6 +929,26 @@ const char* Message::getDestination() const
     return sd_bus_message_get_destination((sd_bus_message*)msg_);
 }
 
+uint64_t Message::getCookie() const
+{
+    uint64_t cookie{};
+    (void)sd_bus_message_get_cookie((sd_bus_message*)msg_, &cookie); // Fails with -ENODATA on unsealed messages, leaving 0
+    return cookie;
+}
+
+bool Message::isSealed() const
+{
+    uint64_t cookie{};
+    return sd_bus_message_get_cookie((sd_bus_message*)msg_, &cookie) >= 0; // Sealing assigns the cookie
+}
+
+uint64_t Message::getReplyCookie() const
+{
+    uint64_t cookie{};
+    (void)sd_bus_message_get_reply_cookie((sd_bus_message*)msg_, &cookie);
+    return cookie;
+}
+
 std::pair<char, const char*> Message::peekType() const
 {
     char typeSignature{};
@@ -774,6 +1083,46 @@ std::string Message::getSELinuxContext() const
     return cLabel;
 }
 
+Credentials Message::getCreds(uint64_t fields) const
+{
+    uint64_t mask = SD_BUS_CREDS_AUGMENT;
+    if (fields & Credentials::Pid) mask |= SD_BUS_CREDS_PID;
+    if (fields & Credentials::Uid) mask |= SD_BUS_CREDS_UID;
+    if (fields & Credentials::Euid) mask |= SD_BUS_CREDS_EUID;
+    if (fields & Credentials::Gid) mask |= SD_BUS_CREDS_GID;
+    if (fields & Credentials::Egid) mask |= SD_BUS_CREDS_EGID;
+    if (fields & Credentials::SupplementaryGids) mask |= SD_BUS_CREDS_SUPPLEMENTARY_GIDS;
+    if (fields & Credentials::SELinuxContext) mask |= SD_BUS_CREDS_SELINUX_CONTEXT;
+
+    sd_bus_creds *creds = nullptr;
+    SCOPE_EXIT{ connection_->decrementCredsRefCount(creds); };
+    int r = connection_->querySenderCredentials((sd_bus_message*)msg_, mask, &creds);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to get bus creds", -r);
+
+    // Fields the sender credentials don't provide are left empty rather than reported as errors
+    Credentials result;
+    if (pid_t pid{}; (fields & Credentials::Pid) && sd_bus_creds_get_pid(creds, &pid) >= 0)
+        result.pid = pid;
+    if (uid_t uid{}; (fields & Credentials::Uid) && sd_bus_creds_get_uid(creds, &uid) >= 0)
+        result.uid = uid;
+    if (uid_t euid{}; (fields & Credentials::Euid) && sd_bus_creds_get_euid(creds, &euid) >= 0)
+        result.euid = euid;
+    if (gid_t gid{}; (fields & Credentials::Gid) && sd_bus_creds_get_gid(creds, &gid) >= 0)
+        result.gid = gid;
+    if (gid_t egid{}; (fields & Credentials::Egid) && sd_bus_creds_get_egid(creds, &egid) >= 0)
+        result.egid = egid;
+    if (fields & Credentials::SupplementaryGids)
+    {
+        const gid_t *cGids = nullptr;
+        if (r = sd_bus_creds_get_supplementary_gids(creds, &cGids); r >= 0)
+            result.supplementaryGids = cGids != nullptr ? std::vector<gid_t>(cGids, cGids + r) : std::vector<gid_t>{};
+    }
+    if (const char *cLabel = nullptr; (fields & Credentials::SELinuxContext) && sd_bus_creds_get_selinux_context(creds, &cLabel) >= 0)
+        result.selinuxContext = cLabel;
+
+    return result;
+}
+
 
 MethodCall::MethodCall( void *msg
                       , internal::IConnection *connection
@@ -810,6 +1159,35 @@ MethodReply MethodCall::sendWithReply(uint64_t timeout) const
     return Factory::create<MethodReply>(sdbusReply, connection_, adopt_message);
 }
 
+Expected<MethodReply> MethodCall::send(uint64_t timeout, std::nothrow_t) const
+{
+    // Errors of sending out a message without waiting for a reply are local failures, which are exceptional
+    if (doesntExpectReply())
+    {
+        try
+        {
+            return sendWithNoReply();
+        }
+        catch (const Error& e)
+        {
+            return e;
+        }
+    }
+
+    sd_bus_error sdbusError = SD_BUS_ERROR_NULL;
+    SCOPE_EXIT{ sd_bus_error_free(&sdbusError); };
+
+    sd_bus_message* sdbusReply{};
+    auto r = connection_->callMethod((sd_bus_message*)msg_, timeout, &sdbusError, &sdbusReply);
+
+    if (sd_bus_error_is_set(&sdbusError))
+        return Error(Error::Name{sdbusError.name}, sdbusError.message);
+    if (r < 0)
+        return createError(-r, "Failed to call method");
+
+    return Factory::create<MethodReply>(sdbusReply, connection_, adopt_message);
+}
+
 MethodReply MethodCall::sendWithNoReply() const
 {
     connection_->sendMessage((sd_bus_message*)msg_);
@@ -843,7 +1221,7 @@ void MethodReply::send() const
 
 void Signal::send() const
 {
-    connection_->sendMessage((sd_bus_message*)msg_);
+    connection_->sendSignal((sd_bus_message*)msg_);
 }
 
 void Signal::setDestination(const std::string& destination)
@@ -859,47 +1237,86 @@ void Signal::setDestination(const char* destination)
 
 namespace {
 
-// Pseudo-connection lifetime handling. In standard cases, we could do with simply function-local static pseudo
-// connection instance below. However, it may happen that client's sdbus-c++ objects outlive this static connection
-// instance (because they are used in global application objects that were created before this connection, and thus
-// are destroyed later). This by itself sounds like a smell in client's application design, but it is downright bad
-// in sdbus-c++ because it has no control over when client's dependent statics get destroyed. A "Phoenix" pattern
-// (see Modern C++ Design - Generic Programming and Design Patterns Applied, by Andrei Alexandrescu) is applied to fix
-// this by re-creating the connection again in such cases and keeping it alive until the next exit handler is invoked.
-// Please note that the solution is NOT thread-safe.
+// Local messages (plain messages, Variants) are built on pseudo connections, each of which serializes access to its
+// pseudo bus with its own sd-bus mutex. To let threads build messages in parallel, they are spread round-robin over
+// a fixed set of pseudo connections, which are created lazily. A thread keeps using its assigned connection, and the
+// connections live as long as the pool, so messages are free to outlive the thread that created them and to be
+// released from any other thread -- a message always goes back to the connection it was created on.
+class PseudoConnectionPool
+{
+public:
+    PseudoConnectionPool()
+        : shardCount_(std::clamp<std::size_t>(std::thread::hardware_concurrency(), 1, MAX_SHARDS))
+    {
+    }
+
+    sdbus::internal::IConnection& getConnection()
+    {
+        thread_local const std::size_t shardIndex = nextShard_.fetch_add(1, std::memory_order_relaxed);
+
+        auto& shard = shards_[shardIndex % shardCount_];
+        std::call_once(shard.created, [&shard](){ shard.connection = internal::createPseudoConnection(); });
+
+        assert(shard.connection != nullptr);
+
+        return *shard.connection;
+    }
+
+private:
+    static constexpr std::size_t MAX_SHARDS{16};
+
+    struct Shard
+    {
+        std::once_flag created;
+        std::unique_ptr<sdbus::internal::IConnection> connection;
+    };
+
+    const std::size_t shardCount_;
+    std::atomic<std::size_t> nextShard_{};
+    std::array<Shard, MAX_SHARDS> shards_;
+};
+
+// Pseudo-connection pool lifetime handling. In standard cases, we could do with simply function-local static pool
+// instance below. However, it may happen that client's sdbus-c++ objects outlive this static pool instance (because
+// they are used in global application objects that were created before this pool, and thus are destroyed later).
+// This by itself sounds like a smell in client's application design, but it is downright bad in sdbus-c++ because
+// it has no control over when client's dependent statics get destroyed. A "Phoenix" pattern (see Modern C++ Design -
+// Generic Programming and Design Patterns Applied, by Andrei Alexandrescu) is applied to fix this by re-creating
+// the pool again in such cases and keeping it alive until the next exit handler is invoked. Please note that the
+// re-creation, happening during static destruction only, is NOT thread-safe.
 // Another common solution is global sdbus-c++ startup/shutdown functions, but that would be an intrusive change.
 
 #ifdef __cpp_constinit
-constinit static bool pseudoConnectionDestroyed{};
+constinit static bool pseudoConnectionPoolDestroyed{};
 #else
-static bool pseudoConnectionDestroyed{};
+static bool pseudoConnectionPoolDestroyed{};
 #endif
 
-std::unique_ptr<sdbus::internal::IConnection, void(*)(sdbus::internal::IConnection*)> createPseudoConnection()
+std::unique_ptr<PseudoConnectionPool, void(*)(PseudoConnectionPool*)> createPseudoConnectionPool()
 {
-    auto deleter = [](sdbus::internal::IConnection* con)
+    auto deleter = [](PseudoConnectionPool* pool)
     {
-        delete con;
-        pseudoConnectionDestroyed = true;
+        delete pool;
+        pseudoConnectionPoolDestroyed = true;
     };
 
-    return {internal::createPseudoConnection().release(), std::move(deleter)};
+    return {new PseudoConnectionPool, std::move(deleter)};
 }
 
 sdbus::internal::IConnection& getPseudoConnectionInstance()
 {
-    static auto connection = createPseudoConnection();
+    static auto pool = createPseudoConnectionPool();
 
-    if (pseudoConnectionDestroyed)
+    if (pseudoConnectionPoolDestroyed)
     {
-        connection = createPseudoConnection(); // Phoenix rising from the ashes
-        atexit([](){ connection.~unique_ptr(); }); // We have to manually take care of deleting the phoenix
-        pseudoConnectionDestroyed = false;
+        pool = createPseudoConnectionPool(); // Phoenix rising from the ashes
+        atexit([](){ pool.~unique_ptr(); }); // We have to manually take care of deleting the phoenix
+        pseudoConnectionPoolDestroyed = false;
     }
 
-    assert(connection != nullptr);
+    assert(pool != nullptr);
 
-    return *connection;
+    return pool->getConnection();
 }
 
 }
@@ -909,7 +1326,8 @@ PlainMessage createPlainMessage()
     // Let's create a pseudo connection -- one that does not really connect to the real bus.
     // This is a bit of a hack, but it enables use to work with D-Bus message locally without
     // the need of D-Bus daemon. This is especially useful in unit tests of both sdbus-c++ and client code.
-    // Additionally, it's light-weight and fast solution.
+    // Additionally, it's light-weight and fast solution. Threads get pseudo connections of their own (see
+    // PseudoConnectionPool), so building local messages scales across threads.
     const auto& connection = getPseudoConnectionInstance();
     return connection.createPlainMessage();
 }
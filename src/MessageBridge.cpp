@@ -0,0 +1,312 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file MessageBridge.cpp
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MessageBridge.h"
+
+#include "sdbus-c++/Error.h"
+#include "sdbus-c++/IConnection.h"
+
+#include "MessageUtils.h"
+#include "Utils.h"
+
+#include <cassert>
+#include <cerrno>
+#include <string_view>
+#include <utility>
+
+namespace sdbus::internal {
+
+MessageBridge::MessageBridge(internal::IConnection& source, internal::IConnection& target)
+    : state_(std::make_shared<State>(source, target))
+{
+}
+
+MessageBridge::~MessageBridge()
+{
+    decltype(state_->pendingCalls) pendingCalls;
+    {
+        std::lock_guard lock(state_->mutex);
+        state_->closed = true;
+        pendingCalls.swap(state_->pendingCalls);
+    }
+
+    for (auto& [rawPendingCall, pendingCall] : pendingCalls)
+    {
+        try
+        {
+            auto error = createError(ECANCELED, "Message bridge destroyed before the reply arrived");
+            pendingCall->call.createErrorReply(error).send();
+        }
+        catch (const Error&)
+        {
+            // The caller may have disconnected in the meantime
+        }
+    }
+}
+
+void MessageBridge::forwardSignal(const Signal& signal, const ObjectPath& objectPath)
+{
+    auto& target = state_->target;
+    target.post([&target, signal, objectPath]()
+    {
+        relaySignal(target, signal, objectPath.c_str());
+    });
+}
+
+void MessageBridge::forwardMethodCall(const MethodCall& call, const ServiceName& destination, const ObjectPath& objectPath)
+{
+    state_->target.post([state = state_, call, destination, objectPath]()
+    {
+        relayMethodCall(state, call, destination, objectPath);
+    });
+}
+
+Slot MessageBridge::forwardSignals(const std::string& match, return_slot_t)
+{
+    auto& target = state_->target;
+    return state_->source.addMatch(match, [&target](Message signal)
+    {
+        target.post([&target, signal = std::move(signal)]()
+        {
+            relaySignal(target, signal, signal.getPath());
+        });
+    }, return_slot);
+}
+
+Slot MessageBridge::forwardMethodCalls( const ObjectPath& sourcePrefix
+                                      , const ServiceName& destination
+                                      , const ObjectPath& targetPrefix
+                                      , return_slot_t )
+{
+    auto route = std::make_unique<MethodCallRoute>(MethodCallRoute{*this, sourcePrefix, destination, targetPrefix, {}});
+
+    route->slot = state_->source.addFallbackHandler(sourcePrefix, &MessageBridge::sdbus_method_call_handler, route.get(), return_slot);
+
+    return {route.release(), [](void *route){ delete static_cast<MethodCallRoute*>(route); }};
+}
+
+std::size_t MessageBridge::getPendingCallCount() const
+{
+    std::lock_guard lock(state_->mutex);
+
+    return state_->pendingCalls.size();
+}
+
+void MessageBridge::relaySignal(internal::IConnection& target, Message signal, const char* objectPath)
+{
+    try
+    {
+        auto relayedSignal = target.createSignal(objectPath, signal.getInterfaceName(), signal.getMemberName());
+        signal.rewind(true);
+        signal.copyTo(relayedSignal, true);
+        relayedSignal.send();
+    }
+    catch (const Error&)
+    {
+        // Relayed in the event loop of the target connection, so there's no one to report the failure to
+    }
+}
+
+void MessageBridge::relayMethodCall( const std::shared_ptr<State>& state
+                                   , const MethodCall& call
+                                   , const ServiceName& destination
+                                   , const ObjectPath& objectPath )
+{
+    try
+    {
+        auto relayedCall = state->target.createMethodCall(destination.c_str(), objectPath.c_str(), call.getInterfaceName(), call.getMemberName());
+        // The serialized body is copied as is, without deserializing and serializing the arguments again
+        auto body = call;
+        body.rewind(true);
+        body.copyTo(relayedCall, true);
+
+        if (call.doesntExpectReply())
+        {
+            relayedCall.dontExpectReply();
+            (void)relayedCall.send(0);
+            return;
+        }
+
+        auto pendingCall = std::make_unique<PendingCall>(PendingCall{state, call, {}, false});
+        auto* rawPendingCall = pendingCall.get();
+        {
+            std::lock_guard lock(state->mutex);
+            SDBUS_THROW_ERROR_IF(state->closed, "Message bridge destroyed before the call was relayed", ECANCELED);
+            state->pendingCalls.emplace(rawPendingCall, std::move(pendingCall));
+        }
+
+        Slot slot;
+        try
+        {
+            slot = relayedCall.send((void*)&MessageBridge::sdbus_reply_handler, rawPendingCall, 0, return_slot);
+        }
+        catch (const Error&)
+        {
+            std::lock_guard lock(state->mutex);
+            if (auto it = state->pendingCalls.find(rawPendingCall); it != state->pendingCalls.end())
+            {
+                pendingCall = std::move(it->second);
+                state->pendingCalls.erase(it);
+            }
+            throw;
+        }
+
+        std::lock_guard lock(state->mutex);
+        auto it = state->pendingCalls.find(rawPendingCall);
+        if (it == state->pendingCalls.end())
+            return; // Cancelled by the destruction of the bridge, the slot is released once the lock is released
+        if (rawPendingCall->replied)
+        {
+            // The reply has been handed over by the target's event loop before the slot was stored
+            pendingCall = std::move(it->second);
+            state->pendingCalls.erase(it);
+        }
+        else
+            rawPendingCall->slot = std::move(slot);
+    }
+    catch (const Error& e)
+    {
+        if (call.doesntExpectReply())
+            return; // There's no one to report the failure to
+
+        try
+        {
+            call.createErrorReply(e).send();
+        }
+        catch (const Error&)
+        {
+            // The caller may have disconnected in the meantime
+        }
+    }
+}
+
+void MessageBridge::relayReply(const MethodCall& call, const MethodReply& reply, const std::optional<Error>& error)
+{
+    try
+    {
+        if (error)
+        {
+            call.createErrorReply(*error).send();
+            return;
+        }
+
+        auto relayedReply = call.createReply();
+        reply.copyTo(relayedReply, true);
+        relayedReply.send();
+    }
+    catch (const Error& e)
+    {
+        try
+        {
+            call.createErrorReply(e).send();
+        }
+        catch (const Error&)
+        {
+            // The caller may have disconnected in the meantime
+        }
+    }
+}
+
+int MessageBridge::sdbus_method_call_handler(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError)
+{
+    auto* route = static_cast<MethodCallRoute*>(userData);
+    assert(route != nullptr);
+    auto& bridge = route->bridge;
+
+    auto call = Message::Factory::create<MethodCall>(sdbusMessage, &bridge.state_->source);
+
+    auto ok = invokeHandlerAndCatchErrors([&]
+    {
+        // Replace the source prefix with the target prefix, e.g. /a/b/c -> /x/c for the prefixes /a/b and /x
+        std::string_view suffix{call.getPath()};
+        if (route->sourcePrefix != "/")
+            suffix.remove_prefix(route->sourcePrefix.size());
+        std::string objectPath = route->targetPrefix != "/" ? route->targetPrefix : std::string{};
+        if (suffix != "/")
+            objectPath += suffix;
+        if (objectPath.empty())
+            objectPath = "/";
+
+        bridge.forwardMethodCall(call, route->destination, ObjectPath{std::move(objectPath)});
+    }, retError);
+
+    return ok ? 1 : -1; // Handled, so that sd-bus doesn't reply with an unknown object or method error
+}
+
+int MessageBridge::sdbus_reply_handler(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError)
+{
+    auto* pendingCall = static_cast<PendingCall*>(userData);
+    assert(pendingCall != nullptr);
+    auto state = pendingCall->state;
+
+    MethodCall call;
+    std::unique_ptr<PendingCall> finishedCall; // Released at the scope exit, after the reply has been handed over
+    {
+        std::lock_guard lock(state->mutex);
+        auto it = state->pendingCalls.find(pendingCall);
+        if (it == state->pendingCalls.end())
+            return 0; // Cancelled by the destruction of the bridge, which replies to the call itself
+        call = pendingCall->call;
+        if (pendingCall->slot)
+        {
+            finishedCall = std::move(it->second);
+            state->pendingCalls.erase(it);
+        }
+        else
+            pendingCall->replied = true; // The relaying thread hasn't stored the slot yet, and releases the call then
+    }
+
+    auto ok = invokeHandlerAndCatchErrors([&]
+    {
+        auto reply = Message::Factory::create<MethodReply>(sdbusMessage, &state->target);
+        std::optional<Error> error;
+        if (const auto* sdbusError = sd_bus_message_get_error(sdbusMessage); sdbusError != nullptr)
+            error = Error(Error::Name{sdbusError->name}, sdbusError->message);
+
+        state->source.post([call = std::move(call), reply = std::move(reply), error = std::move(error)]()
+        {
+            relayReply(call, reply, error);
+        });
+    }, retError);
+
+    return ok ? 0 : -1;
+}
+
+}
+
+namespace sdbus {
+
+std::unique_ptr<sdbus::IMessageBridge> createMessageBridge(IConnection& source, IConnection& target)
+{
+    auto* sourceConnection = dynamic_cast<sdbus::internal::IConnection*>(&source);
+    SDBUS_THROW_ERROR_IF(!sourceConnection, "Source connection is not a real sdbus-c++ connection", EINVAL);
+    auto* targetConnection = dynamic_cast<sdbus::internal::IConnection*>(&target);
+    SDBUS_THROW_ERROR_IF(!targetConnection, "Target connection is not a real sdbus-c++ connection", EINVAL);
+
+    return std::make_unique<sdbus::internal::MessageBridge>(*sourceConnection, *targetConnection);
+}
+
+}
@@ -0,0 +1,114 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file MessageBridge.h
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_INTERNAL_MESSAGEBRIDGE_H_
+#define SDBUS_CXX_INTERNAL_MESSAGEBRIDGE_H_
+
+#include "sdbus-c++/IMessageBridge.h"
+
+#include "sdbus-c++/Error.h"
+#include "sdbus-c++/Message.h"
+
+#include "IConnection.h"
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include SDBUS_HEADER
+
+namespace sdbus::internal {
+
+    class MessageBridge
+        : public sdbus::IMessageBridge
+    {
+    public:
+        MessageBridge(internal::IConnection& source, internal::IConnection& target);
+        ~MessageBridge() override;
+
+        void forwardSignal(const Signal& signal, const ObjectPath& objectPath) override;
+        void forwardMethodCall(const MethodCall& call, const ServiceName& destination, const ObjectPath& objectPath) override;
+        [[nodiscard]] Slot forwardSignals(const std::string& match, return_slot_t) override;
+        [[nodiscard]] Slot forwardMethodCalls( const ObjectPath& sourcePrefix
+                                             , const ServiceName& destination
+                                             , const ObjectPath& targetPrefix
+                                             , return_slot_t ) override;
+        [[nodiscard]] std::size_t getPendingCallCount() const override;
+
+    private:
+        struct PendingCall;
+
+        // State shared with the relays handed over to the event loops of the connections, which may outlive the bridge
+        struct State
+        {
+            State(internal::IConnection& source, internal::IConnection& target) : source(source), target(target) {}
+
+            internal::IConnection& source;
+            internal::IConnection& target;
+            // Sending takes the sd-bus lock of a connection, so the mutex is never held while sending,
+            // and slots of pending calls are destroyed outside of it
+            mutable std::mutex mutex;
+            std::map<PendingCall*, std::unique_ptr<PendingCall>> pendingCalls;
+            bool closed{}; // The bridge is gone, no more calls are relayed
+        };
+
+        struct MethodCallRoute
+        {
+            MessageBridge& bridge;
+            std::string sourcePrefix;
+            ServiceName destination;
+            std::string targetPrefix;
+            Slot slot;
+        };
+
+        struct PendingCall
+        {
+            std::shared_ptr<State> state;
+            MethodCall call; // The original call, which the relayed reply is sent back to
+            Slot slot;
+            bool replied{};
+        };
+
+        static void relaySignal(internal::IConnection& target, Message signal, const char* objectPath);
+        static void relayMethodCall( const std::shared_ptr<State>& state
+                                   , const MethodCall& call
+                                   , const ServiceName& destination
+                                   , const ObjectPath& objectPath );
+        static void relayReply(const MethodCall& call, const MethodReply& reply, const std::optional<Error>& error);
+        static int sdbus_method_call_handler(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError);
+        static int sdbus_reply_handler(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError);
+
+        // Messages received on one connection are relayed by the event loop of the other one, never right from
+        // the handler receiving them, which runs under the sd-bus lock of its connection. Sending on the other
+        // connection from there would take the two locks in opposite orders for calls and their replies.
+        std::shared_ptr<State> state_;
+    };
+
+}
+
+#endif /* SDBUS_CXX_INTERNAL_MESSAGEBRIDGE_H_ */
@@ -57,6 +57,16 @@ namespace sdbus
         {
             return _Msg{msg, connection, adopt_message};
         }
+
+        static void* getSdBusMessage(const Message& msg)
+        {
+            return msg.msg_;
+        }
+
+        static internal::IConnection* getConnection(const Message& msg)
+        {
+            return msg.connection_;
+        }
     };
 }
 
@@ -0,0 +1,355 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file MethodCallScheduler.h
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef SDBUS_CXX_INTERNAL_METHODCALLSCHEDULER_H_
+#define SDBUS_CXX_INTERNAL_METHODCALLSCHEDULER_H_
+
+#include <sdbus-c++/IConnection.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace sdbus::internal {
+
+    // Admission and fair scheduling of incoming method calls. Each sender has a FIFO queue of its calls and a token
+    // bucket limiting its call rate. Queued calls are taken out in deficit round robin order over senders: each sender
+    // gets one turn per round, and a call takes the inverse of its interface weight out of the turn, so senders share
+    // the handling equally, and calls on interfaces of higher weight take a smaller part of it. Calls of one sender
+    // are taken out in the order of their arrival. High priority calls bypass all that: they are queued in a lane of
+    // their own, taken out ahead of all other calls, in the order of their arrival, and not rate limited. The scheduler
+    // is not thread-safe; its user is responsible for synchronization.
+    template <typename _Call>
+    class MethodCallScheduler
+    {
+    public:
+        using Limits = IConnection::MethodCallAdmissionLimits;
+
+        void setLimits(const Limits& limits)
+        {
+            maxQueuedCalls_ = limits.maxQueuedCalls;
+            callsPerSecond_ = limits.callsPerSecond;
+            burst_ = static_cast<double>(limits.burst);
+            deferOverLimit_ = limits.policy == IConnection::MethodCallOverloadPolicy::Defer;
+            interfaceWeights_ = {limits.interfaceWeights.begin(), limits.interfaceWeights.end()};
+        }
+
+        // Queues the call, unless its sender is over the rate limit under the Reject policy. When the scheduler is full,
+        // the newest call of the sender with most queued calls is pushed out in favor of the submitted one, unless the
+        // submitting sender has as many queued calls itself. A high priority call pushes it out regardless, and only
+        // doesn't make it in if the scheduler is full of high priority calls. Returns the call that didn't make it in, if any.
+        [[nodiscard]] std::optional<_Call> submit( std::string_view sender
+                                                 , std::string_view interfaceName
+                                                 , _Call call
+                                                 , std::chrono::nanoseconds now
+                                                 , bool isHighPriority = false )
+        {
+            std::optional<_Call> rejected;
+
+            if (isHighPriority)
+            {
+                if (size_ >= maxQueuedCalls_)
+                {
+                    if (active_.empty())
+                        return call;
+                    rejected = pushOutNewestCall(findLongestFlow(), now);
+                }
+
+                highPriorityCalls_.push_back(std::move(call));
+                ++size_;
+
+                return rejected;
+            }
+
+            auto& flow = getFlow(sender, now);
+
+            // Capacity is checked first, so that a call rejected for a full scheduler doesn't cost its sender a token
+            Flow* pushedOutFlow{};
+            if (size_ >= maxQueuedCalls_)
+            {
+                if (active_.empty())
+                    return call;
+                pushedOutFlow = &findLongestFlow();
+                if (pushedOutFlow->calls.size() <= flow.calls.size())
+                    return call;
+            }
+
+            if (!deferOverLimit_ && !takeToken(flow, now))
+                return call;
+
+            if (pushedOutFlow != nullptr)
+                rejected = pushOutNewestCall(*pushedOutFlow, now);
+
+            if (flow.calls.empty())
+                active_.push_back(&flow);
+            flow.calls.push_back({std::move(call), getCost(interfaceName)});
+            ++size_;
+
+            return rejected;
+        }
+
+        // Takes the next call to be handled out of the scheduler, or returns nullopt if no call is ready at `now'
+        [[nodiscard]] std::optional<_Call> next(std::chrono::nanoseconds now)
+        {
+            if (!highPriorityCalls_.empty())
+            {
+                auto call = std::move(highPriorityCalls_.front());
+                highPriorityCalls_.pop_front();
+                --size_;
+                return call;
+            }
+
+            // A sender credited with its turn can always take at least one call, since interface weights are at least 1.
+            // The sender at the front may have used its turn up already, hence one visit more than there are senders.
+            for (auto visits = active_.size() + 1; visits > 0 && !active_.empty(); --visits)
+            {
+                auto& flow = *active_.front();
+                if (!isFrontCredited_)
+                {
+                    flow.deficit += 1.0;
+                    isFrontCredited_ = true;
+                }
+
+                auto& head = flow.calls.front();
+                if (head.cost <= flow.deficit)
+                {
+                    if (!deferOverLimit_ || takeToken(flow, now))
+                    {
+                        flow.deficit -= head.cost;
+                        auto call = std::move(head.call);
+                        flow.calls.pop_front();
+                        --size_;
+                        if (flow.calls.empty())
+                            deactivate(flow, now);
+                        return call;
+                    }
+                    flow.deficit = 0.0; // Senders waiting for tokens don't save up turns meanwhile
+                }
+
+                active_.push_back(&flow);
+                active_.pop_front();
+                isFrontCredited_ = false;
+            }
+
+            return std::nullopt;
+        }
+
+        // Takes all queued calls satisfying the predicate out of the scheduler, high priority calls first, then the calls
+        // of each sender in the order of their arrival. Senders keep their token buckets.
+        template <typename _Predicate>
+        [[nodiscard]] std::vector<_Call> removeIf(_Predicate predicate, std::chrono::nanoseconds now)
+        {
+            std::vector<_Call> removed;
+
+            for (auto it = highPriorityCalls_.begin(); it != highPriorityCalls_.end();)
+            {
+                if (!predicate(std::as_const(*it)))
+                {
+                    ++it;
+                    continue;
+                }
+                removed.push_back(std::move(*it));
+                it = highPriorityCalls_.erase(it);
+            }
+
+            // Senders whose queue runs empty are deactivated, which reorders the active ones, so a snapshot is walked
+            for (auto* flow : std::vector<Flow*>(active_.begin(), active_.end()))
+            {
+                for (auto it = flow->calls.begin(); it != flow->calls.end();)
+                {
+                    if (!predicate(std::as_const(it->call)))
+                    {
+                        ++it;
+                        continue;
+                    }
+                    removed.push_back(std::move(it->call));
+                    it = flow->calls.erase(it);
+                }
+                if (flow->calls.empty())
+                    deactivate(*flow, now);
+            }
+
+            size_ -= removed.size();
+
+            return removed;
+        }
+
+        // Time point at which a queued call gets ready to be taken out, at latest `now' if one is ready already.
+        // nanoseconds::max() if there are no queued calls.
+        [[nodiscard]] std::chrono::nanoseconds nextReadyTime(std::chrono::nanoseconds now) const
+        {
+            if (!highPriorityCalls_.empty())
+                return now;
+            if (active_.empty())
+                return std::chrono::nanoseconds::max();
+            if (!deferOverLimit_ || callsPerSecond_ <= 0.0)
+                return now;
+
+            auto readyTime = std::chrono::nanoseconds::max();
+            for (const auto* flow : active_)
+            {
+                auto missingTokens = 1.0 - getTokens(*flow, now);
+                if (missingTokens <= 0.0)
+                    return now;
+                auto wait = std::chrono::ceil<std::chrono::nanoseconds>(std::chrono::duration<double>(missingTokens / callsPerSecond_));
+                readyTime = std::min(readyTime, now + wait);
+            }
+
+            return readyTime;
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return size_; }
+        [[nodiscard]] bool isFull() const noexcept { return size_ >= maxQueuedCalls_; }
+        [[nodiscard]] bool hasHighPriorityCalls() const noexcept { return !highPriorityCalls_.empty(); }
+
+    private:
+        struct QueuedCall
+        {
+            _Call call;
+            double cost;
+        };
+
+        // Queue and token bucket of a sender. Senders without queued calls are kept until their bucket fills up again,
+        // lest a sender escapes its rate limit by letting its queue run empty.
+        struct Flow
+        {
+            std::string_view sender; // Key of the flow in the map
+            std::deque<QueuedCall> calls;
+            double deficit{};
+            double tokens{};
+            std::chrono::nanoseconds lastRefill{};
+        };
+
+        Flow& getFlow(std::string_view sender, std::chrono::nanoseconds now)
+        {
+            if (auto it = flows_.find(sender); it != flows_.end())
+                return it->second;
+
+            if (flows_.size() >= pruneThreshold_)
+                pruneIdleFlows(now);
+
+            auto it = flows_.emplace(std::string{sender}, Flow{{}, {}, 0.0, burst_, now}).first;
+            it->second.sender = it->first;
+            return it->second;
+        }
+
+        // The sender with most queued calls. There must be one.
+        Flow& findLongestFlow() const
+        {
+            return **std::max_element(active_.begin(), active_.end(), [](const Flow* a, const Flow* b){ return a->calls.size() < b->calls.size(); });
+        }
+
+        _Call pushOutNewestCall(Flow& flow, std::chrono::nanoseconds now)
+        {
+            auto call = std::move(flow.calls.back().call);
+            flow.calls.pop_back();
+            --size_;
+            if (flow.calls.empty())
+                deactivate(flow, now);
+
+            return call;
+        }
+
+        void deactivate(Flow& flow, std::chrono::nanoseconds now)
+        {
+            if (&flow == active_.front())
+            {
+                active_.pop_front();
+                isFrontCredited_ = false;
+            }
+            else
+                active_.erase(std::find(active_.begin(), active_.end(), &flow));
+
+            flow.deficit = 0.0;
+            if (isBucketFull(flow, now))
+                flows_.erase(flows_.find(flow.sender));
+        }
+
+        void pruneIdleFlows(std::chrono::nanoseconds now)
+        {
+            std::erase_if(flows_, [&](const auto& item){ return item.second.calls.empty() && isBucketFull(item.second, now); });
+            pruneThreshold_ = std::max(MIN_PRUNE_THRESHOLD, 2 * flows_.size());
+        }
+
+        [[nodiscard]] double getTokens(const Flow& flow, std::chrono::nanoseconds now) const
+        {
+            auto refill = std::chrono::duration<double>(now - flow.lastRefill).count() * callsPerSecond_;
+            return std::min(burst_, flow.tokens + refill);
+        }
+
+        [[nodiscard]] bool isBucketFull(const Flow& flow, std::chrono::nanoseconds now) const
+        {
+            return callsPerSecond_ <= 0.0 || getTokens(flow, now) >= burst_;
+        }
+
+        bool takeToken(Flow& flow, std::chrono::nanoseconds now)
+        {
+            if (callsPerSecond_ <= 0.0)
+                return true;
+
+            flow.tokens = getTokens(flow, now);
+            flow.lastRefill = now;
+            if (flow.tokens < 1.0)
+                return false;
+
+            flow.tokens -= 1.0;
+            return true;
+        }
+
+        [[nodiscard]] double getCost(std::string_view interfaceName) const
+        {
+            auto it = interfaceWeights_.find(interfaceName);
+            return it != interfaceWeights_.end() ? 1.0 / it->second : 1.0;
+        }
+
+    private:
+        static constexpr std::size_t MIN_PRUNE_THRESHOLD{64};
+
+        std::size_t maxQueuedCalls_{};
+        double callsPerSecond_{};
+        double burst_{1.0};
+        bool deferOverLimit_{};
+        std::map<std::string, unsigned, std::less<>> interfaceWeights_;
+
+        std::map<std::string, Flow, std::less<>> flows_;
+        std::deque<Flow*> active_; // Senders with queued calls, in round robin order
+        std::deque<_Call> highPriorityCalls_;
+        bool isFrontCredited_{}; // Whether the sender at the front has been credited with its current turn
+        std::size_t size_{};
+        std::size_t pruneThreshold_{MIN_PRUNE_THRESHOLD};
+    };
+
+}
+
+#endif /* SDBUS_CXX_INTERNAL_METHODCALLSCHEDULER_H_ */
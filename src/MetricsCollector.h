@@ -0,0 +1,185 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file MetricsCollector.h
+ *
+ * Created on: Oct 14, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_INTERNAL_METRICSCOLLECTOR_H_
+#define SDBUS_CXX_INTERNAL_METRICSCOLLECTOR_H_
+
+#include "sdbus-c++/IConnection.h"
+
+#include "Utils.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace sdbus::internal {
+
+    // Lock-free collector of connection metrics. All updates use relaxed atomics, since the
+    // metrics are statistical and impose no ordering on the data they describe. Call sites
+    // check isEnabled() first, so disabled collection costs just one relaxed atomic load.
+    class MetricsCollector
+    {
+    public:
+        using Metrics = ::sdbus::IConnection::Metrics;
+
+        // Lock-free counterpart of Metrics::Histogram, also used by other collectors
+        class Histogram
+        {
+        public:
+            void record(std::chrono::nanoseconds duration) noexcept
+            {
+                const auto micros = static_cast<uint64_t>(std::max<int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count(), 0));
+                const auto index = std::min<std::size_t>(std::bit_width(micros), Metrics::Histogram::BUCKET_COUNT - 1);
+                buckets_[index].fetch_add(1, std::memory_order_relaxed);
+                count_.fetch_add(1, std::memory_order_relaxed);
+                sum_.fetch_add(duration.count(), std::memory_order_relaxed);
+            }
+
+            void snapshotTo(Metrics::Histogram& histogram) const noexcept
+            {
+                for (std::size_t i = 0; i < buckets_.size(); ++i)
+                    histogram.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+                histogram.count = count_.load(std::memory_order_relaxed);
+                histogram.sum = std::chrono::nanoseconds{sum_.load(std::memory_order_relaxed)};
+            }
+
+            void reset() noexcept
+            {
+                for (auto& bucket : buckets_)
+                    bucket.store(0, std::memory_order_relaxed);
+                count_.store(0, std::memory_order_relaxed);
+                sum_.store(0, std::memory_order_relaxed);
+            }
+
+        private:
+            std::array<std::atomic<uint64_t>, Metrics::Histogram::BUCKET_COUNT> buckets_{};
+            std::atomic<uint64_t> count_{};
+            std::atomic<int64_t> sum_{};
+        };
+
+        static void updateMaximum(std::atomic<uint64_t>& maximum, uint64_t value) noexcept
+        {
+            auto current = maximum.load(std::memory_order_relaxed);
+            while (value > current && !maximum.compare_exchange_weak(current, value, std::memory_order_relaxed))
+                ;
+        }
+
+        [[nodiscard]] bool isEnabled() const noexcept
+        {
+            return enabled_.load(std::memory_order_relaxed);
+        }
+
+        void enable(bool enabled) noexcept
+        {
+            enabled_.store(enabled, std::memory_order_relaxed);
+        }
+
+        void recordProcessingStep(std::chrono::nanoseconds duration, bool processed) noexcept
+        {
+            processingSteps_.fetch_add(1, std::memory_order_relaxed);
+            if (processed)
+                processedEvents_.fetch_add(1, std::memory_order_relaxed);
+            processingDuration_.record(duration);
+        }
+
+        void recordPollWakeup() noexcept
+        {
+            pollWakeups_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void recordQueueDepths(uint64_t readQueueDepth, uint64_t writeQueueDepth) noexcept
+        {
+            readQueueDepth_.store(readQueueDepth, std::memory_order_relaxed);
+            writeQueueDepth_.store(writeQueueDepth, std::memory_order_relaxed);
+            updateMaximum(maxReadQueueDepth_, readQueueDepth);
+            updateMaximum(maxWriteQueueDepth_, writeQueueDepth);
+        }
+
+        void recordAsyncCallRoundTrip(std::chrono::nanoseconds duration) noexcept
+        {
+            asyncCallRoundTrip_.record(duration);
+        }
+
+        // Invokes a user handler, measuring its duration if the collection is enabled
+        template <typename _Callable>
+        auto measureHandler(_Callable&& callable)
+        {
+            if (!isEnabled())
+                return callable();
+
+            const auto start = now();
+            auto result = callable();
+            handlerDuration_.record(now() - start);
+            return result;
+        }
+
+        [[nodiscard]] Metrics getSnapshot() const noexcept
+        {
+            Metrics metrics;
+            metrics.processingSteps = processingSteps_.load(std::memory_order_relaxed);
+            metrics.processedEvents = processedEvents_.load(std::memory_order_relaxed);
+            processingDuration_.snapshotTo(metrics.processingDuration);
+            handlerDuration_.snapshotTo(metrics.handlerDuration);
+            metrics.pollWakeups = pollWakeups_.load(std::memory_order_relaxed);
+            metrics.readQueueDepth = readQueueDepth_.load(std::memory_order_relaxed);
+            metrics.writeQueueDepth = writeQueueDepth_.load(std::memory_order_relaxed);
+            metrics.maxReadQueueDepth = maxReadQueueDepth_.load(std::memory_order_relaxed);
+            metrics.maxWriteQueueDepth = maxWriteQueueDepth_.load(std::memory_order_relaxed);
+            asyncCallRoundTrip_.snapshotTo(metrics.asyncCallRoundTrip);
+            return metrics;
+        }
+
+        void reset() noexcept
+        {
+            for (auto* counter : { &processingSteps_, &processedEvents_, &pollWakeups_
+                                 , &readQueueDepth_, &writeQueueDepth_, &maxReadQueueDepth_, &maxWriteQueueDepth_ })
+                counter->store(0, std::memory_order_relaxed);
+            processingDuration_.reset();
+            handlerDuration_.reset();
+            asyncCallRoundTrip_.reset();
+        }
+
+    private:
+        std::atomic<bool> enabled_{};
+        std::atomic<uint64_t> processingSteps_{};
+        std::atomic<uint64_t> processedEvents_{};
+        Histogram processingDuration_;
+        Histogram handlerDuration_;
+        std::atomic<uint64_t> pollWakeups_{};
+        std::atomic<uint64_t> readQueueDepth_{};
+        std::atomic<uint64_t> writeQueueDepth_{};
+        std::atomic<uint64_t> maxReadQueueDepth_{};
+        std::atomic<uint64_t> maxWriteQueueDepth_{};
+        Histogram asyncCallRoundTrip_;
+    };
+
+}
+
+#endif /* SDBUS_CXX_INTERNAL_METRICSCOLLECTOR_H_ */
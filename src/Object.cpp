@@ -29,17 +29,35 @@
 #include "sdbus-c++/Error.h"
 #include "sdbus-c++/Flags.h"
 #include "sdbus-c++/IConnection.h"
+#include "sdbus-c++/ITracer.h"
 #include "sdbus-c++/Message.h"
 
 #include "IConnection.h"
+#include "HandlerProfiler.h"
 #include "MessageUtils.h"
+#include "MetricsCollector.h"
 #include "ScopeGuard.h"
+#include "StartupProfiler.h"
+#include "ThreadPolicy.h"
 #include "Utils.h"
 #include "VTableUtils.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <string>
 #include SDBUS_HEADER
+#include <thread>
+#include <unordered_map>
 #include <utility>
+#include <variant>
 
 namespace sdbus::internal {
 
@@ -49,10 +67,16 @@ Object::Object(sdbus::internal::IConnection& connection, ObjectPath objectPath)
     SDBUS_CHECK_OBJECT_PATH(objectPath_.c_str());
 }
 
+Object::~Object()
+{
+    unregister();
+}
+
 void Object::addVTable(InterfaceName interfaceName, std::vector<VTableItem> vtable)
 {
     auto slot = Object::addVTable(std::move(interfaceName), std::move(vtable), return_slot);
 
+    std::lock_guard lock(registrationsMutex_);
     vtables_.push_back(std::move(slot));
 }
 
@@ -60,27 +84,289 @@ Slot Object::addVTable(InterfaceName interfaceName, std::vector<VTableItem> vtab
 {
     SDBUS_CHECK_INTERFACE_NAME(interfaceName.c_str());
 
-    // 1st pass -- create vtable structure for internal sdbus-c++ purposes
-    auto internalVTable = std::make_unique<VTable>(createInternalVTable(std::move(interfaceName), std::move(vtable)));
-
-    // 2nd pass -- from internal sdbus-c++ vtable, create vtable structure in format expected by underlying sd-bus library
-    internalVTable->sdbusVTable = createInternalSdBusVTable(*internalVTable);
+    // 1st step -- create vtable structure for internal sdbus-c++ purposes, with a shared descriptor in format expected by sd-bus
+    auto internalVTable = createInternalVTable(std::move(interfaceName), std::move(vtable));
 
-    // 3rd step -- register the vtable with sd-bus
+    // 2nd step -- register the vtable with sd-bus
     internalVTable->slot = connection_.addObjectVTable( objectPath_
-                                                      , internalVTable->interfaceName
-                                                      , &internalVTable->sdbusVTable[0]
-                                                      , internalVTable.get()
+                                                      , internalVTable->descriptor->interfaceName
+                                                      , &internalVTable->descriptor->sdbusVTable[0]
+                                                      , internalVTable->handlers.data()
                                                       , return_slot );
 
     // Return vtable wrapped in a Slot object
     return {internalVTable.release(), [](void *ptr){ delete static_cast<VTable*>(ptr); }};
 }
 
+void Object::addVTable(const StaticVTable& vtable, std::vector<VTableHandler> handlers)
+{
+    auto slot = Object::addVTable(vtable, std::move(handlers), return_slot);
+
+    std::lock_guard lock(registrationsMutex_);
+    vtables_.push_back(std::move(slot));
+}
+
+Slot Object::addVTable(const StaticVTable& vtable, std::vector<VTableHandler> handlers, return_slot_t)
+{
+    const auto& layout = *static_cast<const StaticVTableLayout*>(vtable.layout_.get());
+    SDBUS_THROW_ERROR_IF(handlers.size() != layout.handlerPositions.size(), "Handlers don't match the static vtable layout", EINVAL);
+
+    // 1st step -- arrange object's handlers for the prepared descriptor, which is taken over as is
+    auto internalVTable = std::make_unique<VTable>();
+    internalVTable->descriptor = layout.descriptor;
+    internalVTable->handlers.reserve(handlers.size());
+
+    const auto methodCount = layout.descriptor->methods.size();
+    for (std::size_t i = 0; i < layout.handlerPositions.size(); ++i)
+    {
+        auto& handler = handlers[layout.handlerPositions[i]];
+        if (i < methodCount)
+        {
+            SDBUS_THROW_ERROR_IF(!handler.method || handler.getter || handler.setter, "Invalid method callback provided", EINVAL);
+            internalVTable->handlers.emplace_back(VTable::MethodItem{std::move(handler.method), this, isHighPriorityMethod(*layout.descriptor, i)});
+        }
+        else
+        {
+            const auto propertyIndex = i - methodCount;
+            const auto writable = layout.descriptor->properties[propertyIndex].writable;
+            SDBUS_THROW_ERROR_IF( handler.method || !handler.getter || writable != static_cast<bool>(handler.setter)
+                                , "Invalid property callbacks provided"
+                                , EINVAL );
+            const auto valueCacheTimeToLive = layout.valueCacheTimeToLives[propertyIndex];
+            internalVTable->handlers.emplace_back(VTable::PropertyItem{ std::move(handler.getter)
+                                                                      , std::move(handler.setter)
+                                                                      , valueCacheTimeToLive
+                                                                      , this });
+        }
+    }
+
+    // 2nd step -- register the vtable with sd-bus
+    internalVTable->slot = connection_.addObjectVTable( objectPath_
+                                                      , internalVTable->descriptor->interfaceName
+                                                      , &internalVTable->descriptor->sdbusVTable[0]
+                                                      , internalVTable->handlers.data()
+                                                      , return_slot );
+
+    if (std::any_of(layout.valueCacheTimeToLives.begin(), layout.valueCacheTimeToLives.end(), [](auto ttl){ return ttl.count() > 0; }))
+        hasCachedProperties_ = true;
+
+    return {internalVTable.release(), [](void *ptr){ delete static_cast<VTable*>(ptr); }};
+}
+
+std::shared_ptr<const void> Object::createStaticVTableLayout(const InterfaceName& interfaceName, std::vector<VTableItem> vtable)
+{
+    SDBUS_CHECK_INTERFACE_NAME(interfaceName.c_str());
+
+    VTableItemHandlers handlers;
+    auto descriptor = createVTableDescriptor(interfaceName, std::move(vtable), handlers);
+
+    auto layout = std::make_shared<StaticVTableLayout>();
+    layout->handlerPositions = std::move(handlers.methodPositions);
+    layout->handlerPositions.insert(layout->handlerPositions.end(), handlers.propertyPositions.begin(), handlers.propertyPositions.end());
+    for (const auto& propertyItem : handlers.properties)
+        layout->valueCacheTimeToLives.push_back(propertyItem.valueCacheTimeToLive);
+    layout->descriptor = internVTableDescriptor(std::move(descriptor));
+
+    return layout;
+}
+
+void Object::addSubtreeVTable(InterfaceName interfaceName, std::vector<VTableItem> vtable, object_finder finder)
+{
+    auto slot = Object::addSubtreeVTable(std::move(interfaceName), std::move(vtable), std::move(finder), return_slot);
+
+    std::lock_guard lock(registrationsMutex_);
+    vtables_.push_back(std::move(slot));
+}
+
+Slot Object::addSubtreeVTable( InterfaceName interfaceName
+                             , std::vector<VTableItem> vtable
+                             , object_finder finder
+                             , return_slot_t )
+{
+    SDBUS_CHECK_INTERFACE_NAME(interfaceName.c_str());
+
+    auto internalVTable = createInternalVTable(std::move(interfaceName), std::move(vtable));
+    internalVTable->finder = std::move(finder);
+
+    // The single vtable serves all objects of the subtree. sd-bus resolves them lazily through the find callback.
+    internalVTable->slot = connection_.addFallbackVTable( objectPath_
+                                                        , internalVTable->descriptor->interfaceName
+                                                        , &internalVTable->descriptor->sdbusVTable[0]
+                                                        , &Object::sdbus_object_find_callback
+                                                        , internalVTable.get()
+                                                        , return_slot );
+
+    return {internalVTable.release(), [](void *ptr){ delete static_cast<VTable*>(ptr); }};
+}
+
+void Object::addSubtreeEnumerator(object_enumerator enumerator)
+{
+    auto slot = Object::addSubtreeEnumerator(std::move(enumerator), return_slot);
+
+    std::lock_guard lock(registrationsMutex_);
+    enumerators_.push_back(std::move(slot));
+}
+
+Slot Object::addSubtreeEnumerator(object_enumerator enumerator, return_slot_t)
+{
+    SDBUS_THROW_ERROR_IF(!enumerator, "Invalid subtree enumerator provided", EINVAL);
+
+    auto enumeratorInfo = std::make_unique<EnumeratorInfo>(EnumeratorInfo{std::move(enumerator), {}});
+
+    enumeratorInfo->slot = connection_.addNodeEnumerator( objectPath_
+                                                        , &Object::sdbus_node_enumerator_callback
+                                                        , enumeratorInfo.get()
+                                                        , return_slot );
+
+    return {enumeratorInfo.release(), [](void *ptr){ delete static_cast<EnumeratorInfo*>(ptr); }};
+}
+
 void Object::unregister()
 {
+    std::unique_lock lock(registrationsMutex_);
+    auto vtables = std::move(vtables_);
+    auto enumerators = std::move(enumerators_);
     vtables_.clear();
+    enumerators_.clear();
+    lock.unlock();
+
+    // Releasing the registrations acquires global sd-bus mutex, so we must do it out of the `registrationsMutex_' critical section
+    vtables.clear();
+    enumerators.clear();
     objectManagerSlot_.reset();
+
+    // No new calls reach the object now. Those queued in the connection would invoke the handlers when they're long gone.
+    connection_.cancelMethodCalls(this);
+}
+
+void Object::registerObjects( sdbus::internal::IConnection& connection
+                            , std::vector<ObjectRegistration> batch
+                            , std::size_t preparationThreads )
+{
+    std::vector<Object*> objects;
+    std::vector<std::unique_ptr<VTable>> internalVTables(batch.size());
+    std::vector<IConnection::ObjectVTable> sdbusVTables;
+    objects.reserve(batch.size());
+    sdbusVTables.reserve(batch.size());
+
+    for (auto& registration : batch)
+    {
+        objects.push_back(&toObjectOf(connection, registration.object));
+        SDBUS_CHECK_INTERFACE_NAME(registration.interfaceName.c_str());
+    }
+
+    // 1st step -- create vtable structures for internal sdbus-c++ purposes, like addVTable() does. This takes
+    // no bus lock, so the batch may be split into parts prepared in parallel, the first one by the calling thread.
+    auto preparePart = [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+            internalVTables[i] = objects[i]->createInternalVTable(std::move(batch[i].interfaceName), std::move(batch[i].vtable));
+    };
+
+    const auto partCount = std::min(preparationThreads, batch.size());
+    if (partCount <= 1)
+        preparePart(0, batch.size());
+    else
+    {
+        const auto partSize = (batch.size() + partCount - 1) / partCount;
+        std::vector<std::exception_ptr> errors(partCount);
+        auto preparePartSafely = [&](std::size_t part)
+        {
+            try
+            {
+                preparePart(std::min(part * partSize, batch.size()), std::min((part + 1) * partSize, batch.size()));
+            }
+            catch (...)
+            {
+                errors[part] = std::current_exception();
+            }
+        };
+
+        {
+            std::vector<std::thread> workers;
+            workers.reserve(partCount - 1);
+            SCOPE_EXIT
+            {
+                // Also should starting some of them fail, e.g. when the thread creation policy can't be applied
+                for (auto& worker : workers)
+                    worker.join();
+            };
+            for (std::size_t part = 1; part < partCount; ++part)
+                workers.push_back(startThread(ThreadRole::VTablePreparation, [&preparePartSafely, part](){ preparePartSafely(part); }));
+            preparePartSafely(0);
+        }
+
+        for (const auto& error : errors)
+            if (error)
+                std::rethrow_exception(error);
+    }
+
+    for (std::size_t i = 0; i < internalVTables.size(); ++i)
+    {
+        const auto& internalVTable = internalVTables[i];
+        sdbusVTables.push_back({ objects[i]->objectPath_
+                               , internalVTable->descriptor->interfaceName
+                               , &internalVTable->descriptor->sdbusVTable[0]
+                               , internalVTable->handlers.data() });
+    }
+
+    // 2nd step -- register all the vtables with sd-bus and announce the objects in one go
+    auto slots = connection.addObjectVTables(sdbusVTables, return_slot);
+
+    for (std::size_t i = 0; i < internalVTables.size(); ++i)
+    {
+        internalVTables[i]->slot = std::move(slots[i]);
+        std::lock_guard lock(objects[i]->registrationsMutex_);
+        objects[i]->vtables_.emplace_back(internalVTables[i].release(), [](void *ptr){ delete static_cast<VTable*>(ptr); });
+    }
+}
+
+void Object::unregisterObjects(sdbus::internal::IConnection& connection, std::span<IObject* const> objects)
+{
+    std::vector<Object*> internalObjects;
+    std::vector<const char*> paths;
+    internalObjects.reserve(objects.size());
+    paths.reserve(objects.size());
+
+    for (auto* object : objects)
+    {
+        SDBUS_THROW_ERROR_IF(object == nullptr, "Invalid object provided", EINVAL);
+        auto& internalObject = toObjectOf(connection, *object);
+        internalObjects.push_back(&internalObject);
+        paths.push_back(internalObject.objectPath_.c_str());
+    }
+
+    // The sd-bus registrations are taken over from the objects, and released by the connection after emitting
+    // the signals. The rest of the registration records, with the callbacks, is destroyed afterwards.
+    std::vector<sd_bus_slot*> slots;
+    for (auto* object : internalObjects)
+        object->releaseSdBusSlots(slots);
+
+    SCOPE_EXIT
+    {
+        for (auto* object : internalObjects)
+            object->unregister();
+    };
+
+    connection.removeObjects(paths, slots);
+}
+
+Object& Object::toObjectOf(sdbus::internal::IConnection& connection, IObject& object)
+{
+    auto* internalObject = dynamic_cast<Object*>(&object);
+    SDBUS_THROW_ERROR_IF(!internalObject || &internalObject->connection_ != &connection, "Object was not created on this connection", EINVAL);
+
+    return *internalObject;
+}
+
+void Object::releaseSdBusSlots(std::vector<sd_bus_slot*>& slots)
+{
+    std::lock_guard lock(registrationsMutex_);
+    for (auto& vtable : vtables_)
+        slots.push_back(static_cast<sd_bus_slot*>(static_cast<VTable*>(vtable.get())->slot.release()));
+    for (auto& enumerator : enumerators_)
+        slots.push_back(static_cast<sd_bus_slot*>(static_cast<EnumeratorInfo*>(enumerator.get())->slot.release()));
+    slots.push_back(static_cast<sd_bus_slot*>(objectManagerSlot_.release()));
 }
 
 Signal Object::createSignal(const InterfaceName& interfaceName, const SignalName& signalName) const
@@ -100,14 +386,36 @@ void Object::emitSignal(const sdbus::Signal& message)
     message.send();
 }
 
+void Object::emitSignals(std::span<const sdbus::Signal> messages)
+{
+    std::vector<sd_bus_message*> sdbusMsgs;
+    sdbusMsgs.reserve(messages.size());
+
+    for (const auto& message : messages)
+    {
+        SDBUS_THROW_ERROR_IF(!message.isValid(), "Invalid signal message provided", EINVAL);
+        sdbusMsgs.push_back(static_cast<sd_bus_message*>(Message::Factory::getSdBusMessage(message)));
+    }
+
+    if (sdbusMsgs.empty())
+        return;
+
+    connection_.sendSignals(sdbusMsgs.data(), sdbusMsgs.size());
+}
+
 void Object::emitPropertiesChangedSignal(const InterfaceName& interfaceName, const std::vector<PropertyName>& propNames)
 {
-    connection_.emitPropertiesChangedSignal(objectPath_, interfaceName, propNames);
+    Object::emitPropertiesChangedSignal(interfaceName.c_str(), propNames);
 }
 
 void Object::emitPropertiesChangedSignal(const char* interfaceName, const std::vector<PropertyName>& propNames)
 {
-    connection_.emitPropertiesChangedSignal(objectPath_.c_str(), interfaceName, propNames);
+    invalidateCachedPropertyValues(interfaceName, propNames);
+
+    if (auto interval = propertiesChangedCoalescingInterval_.load(std::memory_order_relaxed); interval.count() >= 0)
+        connection_.coalescePropertiesChangedSignal(objectPath_.c_str(), interfaceName, propNames, interval);
+    else
+        connection_.emitPropertiesChangedSignal(objectPath_.c_str(), interfaceName, propNames);
 }
 
 void Object::emitPropertiesChangedSignal(const InterfaceName& interfaceName)
@@ -120,6 +428,18 @@ void Object::emitPropertiesChangedSignal(const char* interfaceName)
     Object::emitPropertiesChangedSignal(interfaceName, {});
 }
 
+void Object::enablePropertiesChangedCoalescing(std::chrono::microseconds interval)
+{
+    SDBUS_THROW_ERROR_IF(interval.count() < 0, "Invalid PropertiesChanged coalescing interval provided", EINVAL);
+
+    propertiesChangedCoalescingInterval_.store(interval, std::memory_order_relaxed);
+}
+
+void Object::disablePropertiesChangedCoalescing()
+{
+    propertiesChangedCoalescingInterval_.store(std::chrono::microseconds{-1}, std::memory_order_relaxed);
+}
+
 void Object::emitInterfacesAddedSignal()
 {
     connection_.emitInterfacesAddedSignal(objectPath_);
@@ -165,82 +485,269 @@ Message Object::getCurrentlyProcessedMessage() const
     return connection_.getCurrentlyProcessedMessage();
 }
 
-Object::VTable Object::createInternalVTable(InterfaceName interfaceName, std::vector<VTableItem> vtable)
+Object::ResourceUsage Object::getResourceUsage() const
 {
-    VTable internalVTable;
+    // Rough size of a node of a node-based container, on top of its value
+    constexpr std::size_t NODE_OVERHEAD{4 * sizeof(void*)};
 
-    internalVTable.interfaceName = std::move(interfaceName);
+    ResourceUsage usage;
+    std::size_t bytes{};
 
-    for (auto& vtableItem : vtable)
     {
-        std::visit( overload{ [&](InterfaceFlagsVTableItem&& interfaceFlags){ writeInterfaceFlagsToVTable(std::move(interfaceFlags), internalVTable); }
-                            , [&](MethodVTableItem&& method){ writeMethodRecordToVTable(std::move(method), internalVTable); }
-                            , [&](SignalVTableItem&& signal){ writeSignalRecordToVTable(std::move(signal), internalVTable); }
-                            , [&](PropertyVTableItem&& property){ writePropertyRecordToVTable(std::move(property), internalVTable); } }
-                  , std::move(vtableItem) );
+        std::lock_guard lock(registrationsMutex_);
+        usage.vtables = vtables_.size();
+        usage.subtreeEnumerators = enumerators_.size();
+        bytes += vtables_.capacity() * sizeof(Slot) + enumerators_.capacity() * sizeof(Slot);
+        bytes += usage.subtreeEnumerators * sizeof(EnumeratorInfo);
+        for (const auto& slot : vtables_)
+        {
+            const auto& vtable = *static_cast<const VTable*>(slot.get());
+            usage.methods += vtable.descriptor->methods.size();
+            usage.signals += vtable.descriptor->signals.size();
+            usage.properties += vtable.descriptor->properties.size();
+            bytes += sizeof(VTable) + vtable.handlers.capacity() * sizeof(VTable::HandlerItem);
+        }
     }
+    {
+        std::lock_guard lock(propertyValueCacheMutex_);
+        usage.cachedPropertyValues = propertyValueCache_.size();
+        for (const auto& [key, value] : propertyValueCache_)
+            bytes += NODE_OVERHEAD + sizeof(key) + sizeof(value)
+                   + std::get<0>(key).capacity() + std::get<1>(key).capacity() + std::get<2>(key).capacity();
+    }
+
+    usage.approximateBytes = bytes;
+
+    return usage;
+}
+
+std::unique_ptr<Object::VTable> Object::createInternalVTable(InterfaceName interfaceName, std::vector<VTableItem> vtable)
+{
+    return connection_.getStartupProfiler().measure(IConnection::StartupPhase::VTablePreparation, objectPath_, [&]
+    {
+        VTableItemHandlers handlers;
+        auto descriptor = createVTableDescriptor(std::move(interfaceName), std::move(vtable), handlers);
+
+        for (const auto& methodItem : handlers.methods)
+            SDBUS_THROW_ERROR_IF(!methodItem.callback, "Invalid method callback provided", EINVAL);
+        for (std::size_t i = 0; i < handlers.properties.size(); ++i)
+        {
+            const auto& propertyItem = handlers.properties[i];
+            SDBUS_THROW_ERROR_IF( (!propertyItem.getCallback && !propertyItem.setCallback)
+                                  || (descriptor.properties[i].writable && !propertyItem.setCallback)
+                                , "Invalid property callbacks provided"
+                                , EINVAL );
+        }
+
+        auto internalVTable = std::make_unique<VTable>();
+        internalVTable->descriptor = internVTableDescriptor(std::move(descriptor));
+
+        internalVTable->handlers.reserve(handlers.methods.size() + handlers.properties.size());
+        for (std::size_t i = 0; i < handlers.methods.size(); ++i)
+        {
+            auto& methodItem = handlers.methods[i];
+            methodItem.object = this;
+            methodItem.isHighPriority = isHighPriorityMethod(*internalVTable->descriptor, i);
+            internalVTable->handlers.emplace_back(std::move(methodItem));
+        }
+        for (auto& propertyItem : handlers.properties)
+        {
+            propertyItem.object = this;
+            if (propertyItem.valueCacheTimeToLive.count() > 0)
+                hasCachedProperties_ = true;
+            internalVTable->handlers.emplace_back(std::move(propertyItem));
+        }
+
+        return internalVTable;
+    });
+}
 
-    // Sort arrays so we can do fast searching for an item in sd-bus callback handlers
-    std::sort(internalVTable.methods.begin(), internalVTable.methods.end(), [](const auto& a, const auto& b){ return a.name < b.name; });
-    std::sort(internalVTable.signals.begin(), internalVTable.signals.end(), [](const auto& a, const auto& b){ return a.name < b.name; });
-    std::sort(internalVTable.properties.begin(), internalVTable.properties.end(), [](const auto& a, const auto& b){ return a.name < b.name; });
+Object::VTableDescriptor Object::createVTableDescriptor(InterfaceName interfaceName, std::vector<VTableItem> vtable, VTableItemHandlers& handlers)
+{
+    VTableDescriptor descriptor;
+    std::size_t position{};
 
-    internalVTable.object = this;
+    descriptor.interfaceName = std::move(interfaceName);
 
-    return internalVTable;
+    for (auto& vtableItem : vtable)
+    {
+        std::visit( overload{ [&](InterfaceFlagsVTableItem&& interfaceFlags){ writeInterfaceFlagsToVTable(std::move(interfaceFlags), descriptor); }
+                            , [&](MethodVTableItem&& method)
+                              {
+                                  writeMethodRecordToVTable(std::move(method), descriptor, handlers.methods);
+                                  handlers.methodPositions.push_back(position++);
+                              }
+                            , [&](SignalVTableItem&& signal){ writeSignalRecordToVTable(std::move(signal), descriptor); }
+                            , [&](PropertyVTableItem&& property)
+                              {
+                                  writePropertyRecordToVTable(std::move(property), descriptor, handlers.properties);
+                                  handlers.propertyPositions.push_back(position++);
+                              } }
+                  , std::move(vtableItem) );
+    }
+
+    // Sort records by name, so that equal vtables yield equal descriptors regardless of the order of their items.
+    // Handlers are permuted along with their descriptor records.
+    auto sortByName = [](auto& records, auto&... handlers)
+    {
+        std::vector<std::size_t> order(records.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](auto a, auto b){ return records[a].name < records[b].name; });
+
+        auto permute = [&order](auto& items)
+        {
+            std::remove_reference_t<decltype(items)> sorted;
+            sorted.reserve(items.size());
+            for (auto index : order)
+                sorted.push_back(std::move(items[index]));
+            items = std::move(sorted);
+        };
+        permute(records);
+        (permute(handlers), ...);
+    };
+    sortByName(descriptor.methods, handlers.methods, handlers.methodPositions);
+    sortByName(descriptor.signals);
+    sortByName(descriptor.properties, handlers.properties, handlers.propertyPositions);
+
+    return descriptor;
 }
 
-void Object::writeInterfaceFlagsToVTable(InterfaceFlagsVTableItem flags, VTable& vtable)
+void Object::writeInterfaceFlagsToVTable(InterfaceFlagsVTableItem flags, VTableDescriptor& descriptor)
 {
-    vtable.interfaceFlags = std::move(flags.flags);
+    descriptor.interfaceFlags = std::move(flags.flags);
 }
 
-void Object::writeMethodRecordToVTable(MethodVTableItem method, VTable& vtable)
+void Object::writeMethodRecordToVTable(MethodVTableItem method, VTableDescriptor& descriptor, std::vector<VTable::MethodItem>& handlers)
 {
     SDBUS_CHECK_MEMBER_NAME(method.name.c_str());
-    SDBUS_THROW_ERROR_IF(!method.callbackHandler, "Invalid method callback provided", EINVAL);
 
-    vtable.methods.push_back({ std::move(method.name)
-                             , std::move(method.inputSignature)
-                             , std::move(method.outputSignature)
-                             , paramNamesToString(method.inputParamNames) + paramNamesToString(method.outputParamNames)
-                             , std::move(method.callbackHandler)
-                             , std::move(method.flags) });
+    descriptor.methods.push_back({ std::move(method.name)
+                                 , std::move(method.inputSignature)
+                                 , std::move(method.outputSignature)
+                                 , paramNamesToString(method.inputParamNames) + paramNamesToString(method.outputParamNames)
+                                 , std::move(method.flags) });
+    handlers.push_back({std::move(method.callbackHandler)});
 }
 
-void Object::writeSignalRecordToVTable(SignalVTableItem signal, VTable& vtable)
+void Object::writeSignalRecordToVTable(SignalVTableItem signal, VTableDescriptor& descriptor)
 {
     SDBUS_CHECK_MEMBER_NAME(signal.name.c_str());
 
-    vtable.signals.push_back({ std::move(signal.name)
-                             , std::move(signal.signature)
-                             , paramNamesToString(signal.paramNames)
-                             , std::move(signal.flags) });
+    descriptor.signals.push_back({ std::move(signal.name)
+                                 , std::move(signal.signature)
+                                 , paramNamesToString(signal.paramNames)
+                                 , std::move(signal.flags) });
 }
 
-void Object::writePropertyRecordToVTable(PropertyVTableItem property, VTable& vtable)
+void Object::writePropertyRecordToVTable(PropertyVTableItem property, VTableDescriptor& descriptor, std::vector<VTable::PropertyItem>& handlers)
 {
     SDBUS_CHECK_MEMBER_NAME(property.name.c_str());
-    SDBUS_THROW_ERROR_IF(!property.getter && !property.setter, "Invalid property callbacks provided", EINVAL);
 
-    vtable.properties.push_back({ std::move(property.name)
-                                , std::move(property.signature)
-                                , std::move(property.getter)
-                                , std::move(property.setter)
-                                , std::move(property.flags) });
+    descriptor.properties.push_back({ std::move(property.name)
+                                    , std::move(property.signature)
+                                    , property.writable || static_cast<bool>(property.setter)
+                                    , std::move(property.flags) });
+    handlers.push_back({std::move(property.getter), std::move(property.setter), property.valueCacheTimeToLive});
 }
 
-std::vector<sd_bus_vtable> Object::createInternalSdBusVTable(const VTable& vtable)
+std::shared_ptr<const Object::VTableDescriptor> Object::internVTableDescriptor(VTableDescriptor descriptor)
 {
-    std::vector<sd_bus_vtable> sdbusVTable;
+    // Process-wide registry of descriptors in use. A descriptor lives as long as some vtable refers to it. Entries
+    // of expired descriptors are swept out once the registry has doubled since the last sweep, or are reused by their key.
+    static constexpr std::size_t MIN_PRUNE_THRESHOLD{64};
+    static std::mutex registryMutex;
+    static std::unordered_map<std::string, std::weak_ptr<const VTableDescriptor>> registry;
+    static std::size_t pruneThreshold{MIN_PRUNE_THRESHOLD};
+
+    auto key = createVTableDescriptorKey(descriptor);
+
+    {
+        std::lock_guard lock(registryMutex);
+        if (auto it = registry.find(key); it != registry.end())
+            if (auto sharedDescriptor = it->second.lock())
+                return sharedDescriptor;
+    }
+
+    // The sd-bus vtable points into the descriptor's strings, so it's created only once the descriptor sits at its final
+    // place. That's done out of the registry lock, so that threads preparing vtables of different shapes don't wait for each other.
+    auto sharedDescriptor = std::make_shared<VTableDescriptor>(std::move(descriptor));
+    sharedDescriptor->sdbusVTable = createInternalSdBusVTable(*sharedDescriptor);
 
-    startSdBusVTable(vtable.interfaceFlags, sdbusVTable);
-    for (const auto& methodItem : vtable.methods)
-        writeMethodRecordToSdBusVTable(methodItem, sdbusVTable);
-    for (const auto& signalItem : vtable.signals)
-        writeSignalRecordToSdBusVTable(signalItem, sdbusVTable);
-    for (const auto& propertyItem : vtable.properties)
-        writePropertyRecordToSdBusVTable(propertyItem, sdbusVTable);
+    std::lock_guard lock(registryMutex);
+
+    auto [it, inserted] = registry.try_emplace(std::move(key));
+    if (!inserted)
+    {
+        // Another thread may have interned the same shape meanwhile
+        if (auto existingDescriptor = it->second.lock())
+            return existingDescriptor;
+    }
+    it->second = sharedDescriptor;
+
+    if (registry.size() >= pruneThreshold)
+    {
+        std::erase_if(registry, [](const auto& item){ return item.second.expired(); });
+        pruneThreshold = std::max(MIN_PRUNE_THRESHOLD, 2 * registry.size());
+    }
+
+    return sharedDescriptor;
+}
+
+std::string Object::createVTableDescriptorKey(const VTableDescriptor& descriptor)
+{
+    std::string key;
+
+    auto append = [&key](std::string_view str){ key.append(str); key.push_back('\0'); };
+    auto appendFlags = [&key](std::uint64_t flags){ key.append(std::to_string(flags)); key.push_back('\0'); };
+
+    append(descriptor.interfaceName);
+    appendFlags(descriptor.interfaceFlags.toSdBusInterfaceFlags());
+    for (std::size_t i = 0; i < descriptor.methods.size(); ++i)
+    {
+        const auto& method = descriptor.methods[i];
+        key.push_back(isHighPriorityMethod(descriptor, i) ? 'H' : 'M');
+        append(method.name);
+        append(method.inputSignature);
+        append(method.outputSignature);
+        append(method.paramNames);
+        appendFlags(method.flags.toSdBusMethodFlags());
+    }
+    for (const auto& signal : descriptor.signals)
+    {
+        key.push_back('S');
+        append(signal.name);
+        append(signal.signature);
+        append(signal.paramNames);
+        appendFlags(signal.flags.toSdBusSignalFlags());
+    }
+    for (const auto& property : descriptor.properties)
+    {
+        key.push_back(property.writable ? 'W' : 'P');
+        append(property.name);
+        append(property.signature);
+        appendFlags(property.writable ? property.flags.toSdBusWritablePropertyFlags() : property.flags.toSdBusPropertyFlags());
+    }
+
+    return key;
+}
+
+bool Object::isHighPriorityMethod(const VTableDescriptor& descriptor, std::size_t methodIndex)
+{
+    return descriptor.interfaceFlags.test(Flags::HIGH_PRIORITY) || descriptor.methods[methodIndex].flags.test(Flags::HIGH_PRIORITY);
+}
+
+std::vector<sd_bus_vtable> Object::createInternalSdBusVTable(const VTableDescriptor& descriptor)
+{
+    std::vector<sd_bus_vtable> sdbusVTable;
+    std::size_t handlerIndex{};
+
+    startSdBusVTable(descriptor.interfaceFlags, sdbusVTable);
+    for (const auto& methodInfo : descriptor.methods)
+        writeMethodRecordToSdBusVTable(methodInfo, handlerIndex++, sdbusVTable);
+    for (const auto& signalInfo : descriptor.signals)
+        writeSignalRecordToSdBusVTable(signalInfo, sdbusVTable);
+    for (const auto& propertyInfo : descriptor.properties)
+        writePropertyRecordToSdBusVTable(propertyInfo, handlerIndex++, sdbusVTable);
     finalizeSdBusVTable(sdbusVTable);
 
     return sdbusVTable;
@@ -252,7 +759,7 @@ void Object::startSdBusVTable(const Flags& interfaceFlags, std::vector<sd_bus_vt
     vtable.push_back(std::move(vtableItem));
 }
 
-void Object::writeMethodRecordToSdBusVTable(const VTable::MethodItem& method, std::vector<sd_bus_vtable>& vtable)
+void Object::writeMethodRecordToSdBusVTable(const VTableDescriptor::MethodInfo& method, std::size_t handlerIndex, std::vector<sd_bus_vtable>& vtable)
 {
     auto vtableItem = createSdBusVTableMethodItem( method.name.c_str()
                                                  , method.inputSignature.c_str()
@@ -260,10 +767,12 @@ void Object::writeMethodRecordToSdBusVTable(const VTable::MethodItem& method, st
                                                  , method.paramNames.c_str()
                                                  , &Object::sdbus_method_callback
                                                  , method.flags.toSdBusMethodFlags() );
+    // Let sd-bus hand the object's method handler directly over to the callback, sparing a lookup by name on each call
+    vtableItem.x.method.offset = handlerIndex * sizeof(VTable::HandlerItem);
     vtable.push_back(std::move(vtableItem));
 }
 
-void Object::writeSignalRecordToSdBusVTable(const VTable::SignalItem& signal, std::vector<sd_bus_vtable>& vtable)
+void Object::writeSignalRecordToSdBusVTable(const VTableDescriptor::SignalInfo& signal, std::vector<sd_bus_vtable>& vtable)
 {
     auto vtableItem = createSdBusVTableSignalItem( signal.name.c_str()
                                                  , signal.signature.c_str()
@@ -272,9 +781,9 @@ void Object::writeSignalRecordToSdBusVTable(const VTable::SignalItem& signal, st
     vtable.push_back(std::move(vtableItem));
 }
 
-void Object::writePropertyRecordToSdBusVTable(const VTable::PropertyItem& property, std::vector<sd_bus_vtable>& vtable)
+void Object::writePropertyRecordToSdBusVTable(const VTableDescriptor::PropertyInfo& property, std::size_t handlerIndex, std::vector<sd_bus_vtable>& vtable)
 {
-    auto vtableItem = !property.setCallback
+    auto vtableItem = !property.writable
                     ? createSdBusVTableReadOnlyPropertyItem( property.name.c_str()
                                                            , property.signature.c_str()
                                                            , &Object::sdbus_property_get_callback
@@ -284,6 +793,8 @@ void Object::writePropertyRecordToSdBusVTable(const VTable::PropertyItem& proper
                                                            , &Object::sdbus_property_get_callback
                                                            , &Object::sdbus_property_set_callback
                                                            , property.flags.toSdBusWritablePropertyFlags() );
+    // Let sd-bus hand the object's property handlers directly over to the callbacks, sparing a lookup by name on each access
+    vtableItem.x.property.offset = handlerIndex * sizeof(VTable::HandlerItem);
     vtable.push_back(std::move(vtableItem));
 }
 
@@ -292,24 +803,75 @@ void Object::finalizeSdBusVTable(std::vector<sd_bus_vtable>& vtable)
     vtable.push_back(createSdBusVTableEndItem());
 }
 
-const Object::VTable::MethodItem* Object::findMethod(const VTable& vtable, std::string_view methodName)
+const Object::VTable::MethodItem* Object::getMethodItem(void* userData)
+{
+    return std::get_if<VTable::MethodItem>(static_cast<const VTable::HandlerItem*>(userData));
+}
+
+void Object::getPropertyThroughCache( const VTable::PropertyItem& propertyItem
+                                    , const char* objectPath
+                                    , const char* interfaceName
+                                    , const char* propertyName
+                                    , PropertyGetReply& reply )
 {
-    auto it = std::lower_bound(vtable.methods.begin(), vtable.methods.end(), methodName, [](const auto& methodItem, const auto& methodName)
+    const auto key = std::make_tuple(std::string_view{objectPath}, std::string_view{interfaceName}, std::string_view{propertyName});
+    std::uint64_t generation{};
+
     {
-        return methodItem.name < methodName;
-    });
+        std::lock_guard lock(propertyValueCacheMutex_);
+        if (auto it = propertyValueCache_.find(key); it != propertyValueCache_.end() && std::chrono::steady_clock::now() < it->second.expiry)
+        {
+            it->second.value.rewind(true);
+            it->second.value.copyTo(reply, true);
+            return;
+        }
+        generation = propertyValueCacheGeneration_;
+    }
 
-    return it != vtable.methods.end() && it->name == methodName ? &*it : nullptr;
+    // The getter is invoked outside the lock, since it may well emit PropertiesChanged itself
+    auto value = connection_.createPlainMessage();
+    auto valueReply = Message::Factory::create<PropertyGetReply>(Message::Factory::getSdBusMessage(value), &connection_);
+    propertyItem.getCallback(valueReply);
+    value.seal();
+    value.rewind(true);
+    value.copyTo(reply, true);
+
+    const auto expiry = std::chrono::steady_clock::now() + propertyItem.valueCacheTimeToLive;
+    std::lock_guard lock(propertyValueCacheMutex_);
+    if (generation != propertyValueCacheGeneration_)
+        return;
+    if (auto it = propertyValueCache_.find(key); it != propertyValueCache_.end())
+        it->second = CachedPropertyValue{std::move(value), expiry};
+    else
+        propertyValueCache_.emplace(std::make_tuple(objectPath, interfaceName, propertyName), CachedPropertyValue{std::move(value), expiry});
 }
 
-const Object::VTable::PropertyItem* Object::findProperty(const VTable& vtable, std::string_view propertyName)
+void Object::invalidateCachedPropertyValues(std::string_view interfaceName, const std::vector<PropertyName>& propNames)
 {
-    auto it = std::lower_bound(vtable.properties.begin(), vtable.properties.end(), propertyName, [](const auto& propertyItem, const auto& propertyName)
+    if (!hasCachedProperties_)
+        return;
+
+    // Evicted values are released outside the lock, since releasing a message takes the sd-bus lock
+    std::vector<PlainMessage> evictedValues;
+
+    std::lock_guard lock(propertyValueCacheMutex_);
+    ++propertyValueCacheGeneration_;
+    for (auto it = propertyValueCache_.begin(); it != propertyValueCache_.end();)
     {
-        return propertyItem.name < propertyName;
-    });
+        const auto& [objectPath, interface, property] = it->first;
+        if (interface == interfaceName && (propNames.empty() || std::find(propNames.begin(), propNames.end(), property) != propNames.end()))
+        {
+            evictedValues.push_back(std::move(it->second.value));
+            it = propertyValueCache_.erase(it);
+        }
+        else
+            ++it;
+    }
+}
 
-    return it != vtable.properties.end() && it->name == propertyName ? &*it : nullptr;
+const Object::VTable::PropertyItem* Object::getPropertyItem(void* userData)
+{
+    return std::get_if<VTable::PropertyItem>(static_cast<const VTable::HandlerItem*>(userData));
 }
 
 std::string Object::paramNamesToString(const std::vector<std::string>& paramNames)
@@ -320,37 +882,120 @@ std::string Object::paramNamesToString(const std::vector<std::string>& paramName
     return names;
 }
 
-int Object::sdbus_method_callback(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError)
+int Object::sdbus_object_find_callback( sd_bus */*bus*/
+                                      , const char *objectPath
+                                      , const char */*interface*/
+                                      , void *userData
+                                      , void **found
+                                      , sd_bus_error *retError )
 {
-    auto* vtable = static_cast<VTable*>(userData);
+    const auto* vtable = static_cast<const VTable*>(userData);
     assert(vtable != nullptr);
-    assert(vtable->object != nullptr);
 
-    auto message = Message::Factory::create<MethodCall>(sdbusMessage, &vtable->object->connection_);
+    bool exists{true};
+    if (vtable->finder)
+    {
+        auto ok = invokeHandlerAndCatchErrors([&](){ exists = vtable->finder(objectPath); }, retError);
+        if (!ok)
+            return -1;
+    }
+
+    // Hand the object's handlers over to sd-bus as the object's userdata, so that they are found as usual
+    *found = const_cast<VTable::HandlerItem*>(vtable->handlers.data());
+
+    return exists ? 1 : 0;
+}
+
+int Object::sdbus_node_enumerator_callback( sd_bus */*bus*/
+                                          , const char *prefix
+                                          , void *userData
+                                          , char ***nodes
+                                          , sd_bus_error *retError )
+{
+    const auto* enumeratorInfo = static_cast<const EnumeratorInfo*>(userData);
+    assert(enumeratorInfo != nullptr);
+    assert(enumeratorInfo->callback);
+
+    std::vector<ObjectPath> objectPaths;
+    auto ok = invokeHandlerAndCatchErrors([&](){ objectPaths = enumeratorInfo->callback(prefix); }, retError);
+    if (!ok)
+        return -1;
+
+    // sd-bus takes ownership of the NULL-terminated, malloc'ed array of strings
+    auto** strv = static_cast<char**>(calloc(objectPaths.size() + 1, sizeof(char*)));
+    if (strv == nullptr)
+        return -ENOMEM;
+    for (std::size_t i = 0; i < objectPaths.size(); ++i)
+    {
+        strv[i] = strdup(objectPaths[i].c_str());
+        if (strv[i] == nullptr)
+        {
+            for (std::size_t j = 0; j < i; ++j)
+                free(strv[j]);
+            free(strv);
+            return -ENOMEM;
+        }
+    }
+
+    *nodes = strv;
+
+    return 0;
+}
 
-    const auto* methodItem = findMethod(*vtable, message.getMemberName());
+int Object::sdbus_method_callback(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError)
+{
+    const auto* methodItem = getMethodItem(userData);
     assert(methodItem != nullptr);
     assert(methodItem->callback);
+    assert(methodItem->object != nullptr);
 
-    auto ok = invokeHandlerAndCatchErrors([&](){ methodItem->callback(std::move(message)); }, retError);
+    auto message = Message::Factory::create<MethodCall>(sdbusMessage, &methodItem->object->connection_);
+
+    // With the dispatch pool enabled, the handler is invoked and the reply is sent from a worker thread
+    if (methodItem->object->connection_.dispatchMethodCall(message, methodItem->callback, methodItem->object, methodItem->isHighPriority))
+        return 1;
+
+    auto& connection = methodItem->object->connection_;
+    auto tracer = connection.getTracer();
+    void* span = tracer != nullptr ? tracer->onMethodCallReceived(message) : nullptr;
+
+    auto ok = connection.getMetricsCollector().measureHandler([&]
+    {
+        return connection.getHandlerProfiler().measure(IConnection::HandlerKind::Method, message, [&]
+        {
+            return invokeHandlerAndCatchErrors([&]()
+            {
+                // With a tracer, the handler gets a copy of the call, so that the call is still at hand for the exit hook
+                if (tracer == nullptr)
+                    methodItem->callback(std::move(message));
+                else
+                    methodItem->callback(message);
+            }, retError);
+        });
+    });
+
+    if (tracer != nullptr)
+    {
+        std::optional<Error> error;
+        if (!ok)
+            error = Error(Error::Name{retError->name}, retError->message);
+        tracer->onMethodCallHandled(span, message, error ? &*error : nullptr);
+    }
 
     return ok ? 1 : -1;
 }
 
 int Object::sdbus_property_get_callback( sd_bus */*bus*/
-                                       , const char */*objectPath*/
-                                       , const char */*interface*/
+                                       , const char *objectPath
+                                       , const char *interface
                                        , const char *property
                                        , sd_bus_message *sdbusReply
                                        , void *userData
                                        , sd_bus_error *retError )
 {
-    auto* vtable = static_cast<VTable*>(userData);
-    assert(vtable != nullptr);
-    assert(vtable->object != nullptr);
-
-    const auto* propertyItem = findProperty(*vtable, property);
+    const auto* propertyItem = getPropertyItem(userData);
     assert(propertyItem != nullptr);
+    assert(propertyItem->object != nullptr);
 
     // Getter may be empty - the case of "write-only" property
     if (!propertyItem->getCallback)
@@ -359,32 +1004,49 @@ int Object::sdbus_property_get_callback( sd_bus */*bus*/
         return 1;
     }
 
-    auto reply = Message::Factory::create<PropertyGetReply>(sdbusReply, &vtable->object->connection_);
+    auto reply = Message::Factory::create<PropertyGetReply>(sdbusReply, &propertyItem->object->connection_);
 
-    auto ok = invokeHandlerAndCatchErrors([&](){ propertyItem->getCallback(reply); }, retError);
+    auto& connection = propertyItem->object->connection_;
+    auto ok = connection.getMetricsCollector().measureHandler([&]
+    {
+        return connection.getHandlerProfiler().measure(IConnection::HandlerKind::PropertyGet, objectPath, interface, property, [&]
+        {
+            return invokeHandlerAndCatchErrors([&]()
+            {
+                if (propertyItem->valueCacheTimeToLive.count() > 0)
+                    propertyItem->object->getPropertyThroughCache(*propertyItem, objectPath, interface, property, reply);
+                else
+                    propertyItem->getCallback(reply);
+            }, retError);
+        });
+    });
 
     return ok ? 1 : -1;
 }
 
 int Object::sdbus_property_set_callback( sd_bus */*bus*/
-                                       , const char */*objectPath*/
-                                       , const char */*interface*/
+                                       , const char *objectPath
+                                       , const char *interface
                                        , const char *property
                                        , sd_bus_message *sdbusValue
                                        , void *userData
                                        , sd_bus_error *retError )
 {
-    auto* vtable = static_cast<VTable*>(userData);
-    assert(vtable != nullptr);
-    assert(vtable->object != nullptr);
-
-    const auto* propertyItem = findProperty(*vtable, property);
+    const auto* propertyItem = getPropertyItem(userData);
     assert(propertyItem != nullptr);
     assert(propertyItem->setCallback);
+    assert(propertyItem->object != nullptr);
 
-    auto value = Message::Factory::create<PropertySetCall>(sdbusValue, &vtable->object->connection_);
+    auto value = Message::Factory::create<PropertySetCall>(sdbusValue, &propertyItem->object->connection_);
 
-    auto ok = invokeHandlerAndCatchErrors([&](){ propertyItem->setCallback(std::move(value)); }, retError);
+    auto& connection = propertyItem->object->connection_;
+    auto ok = connection.getMetricsCollector().measureHandler([&]
+    {
+        return connection.getHandlerProfiler().measure(IConnection::HandlerKind::PropertySet, objectPath, interface, property, [&]
+        {
+            return invokeHandlerAndCatchErrors([&](){ propertyItem->setCallback(std::move(value)); }, retError);
+        });
+    });
 
     return ok ? 1 : -1;
 }
@@ -393,6 +1055,17 @@ int Object::sdbus_property_set_callback( sd_bus */*bus*/
 
 namespace sdbus {
 
+StaticVTable::StaticVTable(InterfaceName interfaceName, std::vector<VTableItem> layout)
+    : interfaceName_(std::move(interfaceName))
+    , layout_(internal::Object::createStaticVTableLayout(interfaceName_, std::move(layout)))
+{
+}
+
+const InterfaceName& StaticVTable::getInterfaceName() const
+{
+    return interfaceName_;
+}
+
 std::unique_ptr<sdbus::IObject> createObject(sdbus::IConnection& connection, ObjectPath objectPath)
 {
     auto* sdbusConnection = dynamic_cast<sdbus::internal::IConnection*>(&connection);
@@ -32,13 +32,21 @@
 #include "IConnection.h"
 #include "sdbus-c++/Types.h"
 
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <list>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <string>
 #include <string_view>
 #include SDBUS_HEADER
+#include <tuple>
+#include <variant>
 #include <vector>
 
 namespace sdbus::internal {
@@ -48,18 +56,31 @@ namespace sdbus::internal {
     {
     public:
         Object(sdbus::internal::IConnection& connection, ObjectPath objectPath);
+        ~Object() override;
 
         void addVTable(InterfaceName interfaceName, std::vector<VTableItem> vtable) override;
         Slot addVTable(InterfaceName interfaceName, std::vector<VTableItem> vtable, return_slot_t) override;
+        void addVTable(const StaticVTable& vtable, std::vector<VTableHandler> handlers) override;
+        Slot addVTable(const StaticVTable& vtable, std::vector<VTableHandler> handlers, return_slot_t) override;
+        void addSubtreeVTable(InterfaceName interfaceName, std::vector<VTableItem> vtable, object_finder finder) override;
+        Slot addSubtreeVTable( InterfaceName interfaceName
+                             , std::vector<VTableItem> vtable
+                             , object_finder finder
+                             , return_slot_t ) override;
+        void addSubtreeEnumerator(object_enumerator enumerator) override;
+        Slot addSubtreeEnumerator(object_enumerator enumerator, return_slot_t) override;
         void unregister() override;
 
         Signal createSignal(const InterfaceName& interfaceName, const SignalName& signalName) const override;
         Signal createSignal(const char* interfaceName, const char* signalName) const override;
         void emitSignal(const sdbus::Signal& message) override;
+        void emitSignals(std::span<const sdbus::Signal> messages) override;
         void emitPropertiesChangedSignal(const InterfaceName& interfaceName, const std::vector<PropertyName>& propNames) override;
         void emitPropertiesChangedSignal(const char* interfaceName, const std::vector<PropertyName>& propNames) override;
         void emitPropertiesChangedSignal(const InterfaceName& interfaceName) override;
         void emitPropertiesChangedSignal(const char* interfaceName) override;
+        void enablePropertiesChangedCoalescing(std::chrono::microseconds interval) override;
+        void disablePropertiesChangedCoalescing() override;
         void emitInterfacesAddedSignal() override;
         void emitInterfacesAddedSignal(const std::vector<InterfaceName>& interfaces) override;
         void emitInterfacesRemovedSignal() override;
@@ -71,29 +92,38 @@ namespace sdbus::internal {
         [[nodiscard]] sdbus::IConnection& getConnection() const override;
         [[nodiscard]] const ObjectPath& getObjectPath() const override;
         [[nodiscard]] Message getCurrentlyProcessedMessage() const override;
+        [[nodiscard]] ResourceUsage getResourceUsage() const override;
+
+        // Bulk (un)registration of objects on behalf of the connection, see IConnection::registerObjects()
+        static void registerObjects( sdbus::internal::IConnection& connection
+                                   , std::vector<ObjectRegistration> batch
+                                   , std::size_t preparationThreads );
+        static void unregisterObjects(sdbus::internal::IConnection& connection, std::span<IObject* const> objects);
+
+        // Internal representation of a StaticVTable layout, see StaticVTable::StaticVTable()
+        static std::shared_ptr<const void> createStaticVTableLayout(const InterfaceName& interfaceName, std::vector<VTableItem> vtable);
 
     private:
-        // A vtable record comprising methods, signals, properties, flags.
-        // Once created, it cannot be modified. Only new vtables records can be added.
-        // An interface can have any number of vtables attached to it, not only one.
-        struct VTable
+        // An immutable description of a vtable -- names, signatures, flags and the vtable array in the format
+        // required by sd-bus API. Descriptors are interned, so all objects registering vtables of the same shape
+        // (typically, all instances of a generated adaptor) share one descriptor instead of copying it.
+        struct VTableDescriptor
         {
             InterfaceName interfaceName;
             Flags interfaceFlags;
 
-            struct MethodItem
+            struct MethodInfo
             {
                 MethodName name;
                 Signature inputSignature;
                 Signature outputSignature;
                 std::string paramNames;
-                method_callback callback;
                 Flags flags;
             };
             // Array of method records sorted by method name
-            std::vector<MethodItem> methods;
+            std::vector<MethodInfo> methods;
 
-            struct SignalItem
+            struct SignalInfo
             {
                 SignalName name;
                 Signature signature;
@@ -101,48 +131,128 @@ namespace sdbus::internal {
                 Flags flags;
             };
             // Array of signal records sorted by signal name
-            std::vector<SignalItem> signals;
+            std::vector<SignalInfo> signals;
 
-            struct PropertyItem
+            struct PropertyInfo
             {
                 PropertyName name;
                 Signature signature;
-                property_get_callback getCallback;
-                property_set_callback setCallback;
+                bool writable{};
                 Flags flags;
             };
-            // Array of signal records sorted by signal name
-            std::vector<PropertyItem> properties;
+            // Array of property records sorted by property name
+            std::vector<PropertyInfo> properties;
 
-            // VTable structure in format required by sd-bus API
+            // VTable structure in format required by sd-bus API. Its records address object's handlers
+            // by offsets relative to the handler array, so the structure is the same for all objects.
             std::vector<sd_bus_vtable> sdbusVTable;
+        };
 
-            // Back-reference to the owning object from sd-bus callback handlers
-            Object* object{};
+        // A vtable record of an object: a shared descriptor plus object's own callback handlers.
+        // Once created, it cannot be modified. Only new vtables records can be added.
+        // An interface can have any number of vtables attached to it, not only one.
+        struct VTable
+        {
+            std::shared_ptr<const VTableDescriptor> descriptor;
+
+            struct MethodItem
+            {
+                method_callback callback;
+                Object* object{}; // Back-reference to the owning object from sd-bus callback handlers
+                bool isHighPriority{}; // Calls are dispatched ahead of other calls, see Flags::HIGH_PRIORITY
+            };
+
+            struct PropertyItem
+            {
+                property_get_callback getCallback;
+                property_set_callback setCallback;
+                std::chrono::microseconds valueCacheTimeToLive{};
+                Object* object{}; // Back-reference to the owning object from sd-bus callback handlers
+            };
+
+            // Array of handlers handed over to sd-bus as userdata: methods, followed by properties,
+            // in the order of their descriptor records
+            using HandlerItem = std::variant<MethodItem, PropertyItem>;
+            std::vector<HandlerItem> handlers;
+
+            // Resolver of objects served by the vtable, in case it's registered for a whole subtree
+            object_finder finder;
 
             // This is intentionally the last member, because it must be destructed first,
             // releasing callbacks above before the callbacks themselves are destructed.
             Slot slot;
         };
 
-        VTable createInternalVTable(InterfaceName interfaceName, std::vector<VTableItem> vtable);
-        void writeInterfaceFlagsToVTable(InterfaceFlagsVTableItem flags, VTable& vtable);
-        void writeMethodRecordToVTable(MethodVTableItem method, VTable& vtable);
-        void writeSignalRecordToVTable(SignalVTableItem signal, VTable& vtable);
-        void writePropertyRecordToVTable(PropertyVTableItem property, VTable& vtable);
+        // Handlers of vtable items, in the order of their descriptor records, along with their positions
+        // among the method and property items of the vtable
+        struct VTableItemHandlers
+        {
+            std::vector<VTable::MethodItem> methods;
+            std::vector<VTable::PropertyItem> properties;
+            std::vector<std::size_t> methodPositions;
+            std::vector<std::size_t> propertyPositions;
+        };
 
-        std::vector<sd_bus_vtable> createInternalSdBusVTable(const VTable& vtable);
+        // A prepared StaticVTable layout: a shared descriptor plus what's needed to arrange object's handlers for it
+        struct StaticVTableLayout
+        {
+            std::shared_ptr<const VTableDescriptor> descriptor;
+            // For each handler slot of the descriptor (methods, followed by properties), position of its handler
+            // among the handlers provided by objects, which follow the order of method and property layout items
+            std::vector<std::size_t> handlerPositions;
+            // Value cache time-to-live of each property, in the order of descriptor records
+            std::vector<std::chrono::microseconds> valueCacheTimeToLives;
+        };
+
+        // A node enumerator record, listing objects served by subtree vtables
+        struct EnumeratorInfo
+        {
+            object_enumerator callback;
+            Slot slot; // Intentionally the last member, releasing the sd-bus registration first
+        };
+
+        std::unique_ptr<VTable> createInternalVTable(InterfaceName interfaceName, std::vector<VTableItem> vtable);
+        static VTableDescriptor createVTableDescriptor(InterfaceName interfaceName, std::vector<VTableItem> vtable, VTableItemHandlers& handlers);
+        static Object& toObjectOf(sdbus::internal::IConnection& connection, IObject& object);
+        void releaseSdBusSlots(std::vector<sd_bus_slot*>& slots);
+        static void writeInterfaceFlagsToVTable(InterfaceFlagsVTableItem flags, VTableDescriptor& descriptor);
+        static void writeMethodRecordToVTable(MethodVTableItem method, VTableDescriptor& descriptor, std::vector<VTable::MethodItem>& handlers);
+        static void writeSignalRecordToVTable(SignalVTableItem signal, VTableDescriptor& descriptor);
+        static void writePropertyRecordToVTable(PropertyVTableItem property, VTableDescriptor& descriptor, std::vector<VTable::PropertyItem>& handlers);
+
+        static std::shared_ptr<const VTableDescriptor> internVTableDescriptor(VTableDescriptor descriptor);
+        static std::string createVTableDescriptorKey(const VTableDescriptor& descriptor);
+        static bool isHighPriorityMethod(const VTableDescriptor& descriptor, std::size_t methodIndex);
+        static std::vector<sd_bus_vtable> createInternalSdBusVTable(const VTableDescriptor& descriptor);
         static void startSdBusVTable(const Flags& interfaceFlags, std::vector<sd_bus_vtable>& vtable);
-        static void writeMethodRecordToSdBusVTable(const VTable::MethodItem& method, std::vector<sd_bus_vtable>& vtable);
-        static void writeSignalRecordToSdBusVTable(const VTable::SignalItem& signal, std::vector<sd_bus_vtable>& vtable);
-        static void writePropertyRecordToSdBusVTable(const VTable::PropertyItem& property, std::vector<sd_bus_vtable>& vtable);
+        static void writeMethodRecordToSdBusVTable(const VTableDescriptor::MethodInfo& method, std::size_t handlerIndex, std::vector<sd_bus_vtable>& vtable);
+        static void writeSignalRecordToSdBusVTable(const VTableDescriptor::SignalInfo& signal, std::vector<sd_bus_vtable>& vtable);
+        static void writePropertyRecordToSdBusVTable(const VTableDescriptor::PropertyInfo& property, std::size_t handlerIndex, std::vector<sd_bus_vtable>& vtable);
         static void finalizeSdBusVTable(std::vector<sd_bus_vtable>& vtable);
 
-        static const VTable::MethodItem* findMethod(const VTable& vtable, std::string_view methodName);
-        static const VTable::PropertyItem* findProperty(const VTable& vtable, std::string_view propertyName);
+        void getPropertyThroughCache( const VTable::PropertyItem& propertyItem
+                                    , const char* objectPath
+                                    , const char* interfaceName
+                                    , const char* propertyName
+                                    , PropertyGetReply& reply );
+        void invalidateCachedPropertyValues(std::string_view interfaceName, const std::vector<PropertyName>& propNames);
+
+        static const VTable::MethodItem* getMethodItem(void* userData);
+        static const VTable::PropertyItem* getPropertyItem(void* userData);
 
         static std::string paramNamesToString(const std::vector<std::string>& paramNames);
 
+        static int sdbus_object_find_callback( sd_bus *bus
+                                             , const char *objectPath
+                                             , const char *interface
+                                             , void *userData
+                                             , void **found
+                                             , sd_bus_error *retError );
+        static int sdbus_node_enumerator_callback( sd_bus *bus
+                                                 , const char *prefix
+                                                 , void *userData
+                                                 , char ***nodes
+                                                 , sd_bus_error *retError );
         static int sdbus_method_callback(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError);
         static int sdbus_property_get_callback( sd_bus *bus
                                               , const char *objectPath
@@ -162,8 +272,26 @@ namespace sdbus::internal {
     private:
         sdbus::internal::IConnection& connection_;
         ObjectPath objectPath_;
+        mutable std::mutex registrationsMutex_; // Guards the containers of floating registrations below
         std::vector<Slot> vtables_;
+        std::vector<Slot> enumerators_;
         Slot objectManagerSlot_;
+
+        // Serialized values of properties registered with value caching, keyed by object path (a subtree vtable
+        // serves many objects), interface name and property name. The generation counts invalidations, so that
+        // values fetched concurrently with an invalidation aren't stored.
+        struct CachedPropertyValue
+        {
+            PlainMessage value;
+            std::chrono::steady_clock::time_point expiry;
+        };
+        // Interval of coalescing of PropertiesChanged signals, or a negative one if they're emitted right away
+        std::atomic<std::chrono::microseconds> propertiesChangedCoalescingInterval_{std::chrono::microseconds{-1}};
+
+        std::atomic<bool> hasCachedProperties_{false};
+        mutable std::mutex propertyValueCacheMutex_;
+        std::uint64_t propertyValueCacheGeneration_{};
+        std::map<std::tuple<std::string, std::string, std::string>, CachedPropertyValue, std::less<>> propertyValueCache_;
     };
 
 }
@@ -0,0 +1,336 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file PeerServer.cpp
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PeerServer.h"
+
+#include "sdbus-c++/Error.h"
+#include "sdbus-c++/IEventLoop.h"
+
+#include "EventLoop.h"
+#include "ScopeGuard.h"
+#include "Utils.h"
+
+#include <algorithm>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace sdbus::internal {
+
+namespace {
+    constexpr const char* DISCONNECTED_MATCH_RULE = "type='signal',path='/org/freedesktop/DBus/Local',"
+                                                    "interface='org.freedesktop.DBus.Local',member='Disconnected'";
+}
+
+void BroadcastGroup::add(sdbus::IConnection& connection)
+{
+    auto* sdbusConnection = dynamic_cast<internal::IConnection*>(&connection);
+    SDBUS_THROW_ERROR_IF(!sdbusConnection, "Connection is not a real sdbus-c++ connection", EINVAL);
+
+    std::lock_guard lock(mutex_);
+
+    auto alreadyMember = std::find(members_->begin(), members_->end(), sdbusConnection) != members_->end();
+    SDBUS_THROW_ERROR_IF(alreadyMember, "Connection is already a member of the broadcast group", EALREADY);
+
+    auto updated = std::make_shared<Members>(*members_);
+    updated->push_back(sdbusConnection);
+    members_ = std::move(updated);
+
+    destructionSlots_[sdbusConnection] = sdbusConnection->addDestructionHandler([this, sdbusConnection]()
+    {
+        (void)removeMember(sdbusConnection);
+    });
+}
+
+void BroadcastGroup::remove(sdbus::IConnection& connection)
+{
+    auto* sdbusConnection = dynamic_cast<internal::IConnection*>(&connection);
+
+    auto removed = removeMember(sdbusConnection);
+    SDBUS_THROW_ERROR_IF(!removed, "Connection is not a member of the broadcast group", ENOENT);
+}
+
+bool BroadcastGroup::removeMember(internal::IConnection* connection)
+{
+    Slot destructionSlot;
+    std::unique_lock lock(mutex_);
+
+    auto it = std::find(members_->begin(), members_->end(), connection);
+    if (it == members_->end())
+        return false;
+
+    auto updated = std::make_shared<Members>(*members_);
+    updated->erase(updated->begin() + (it - members_->begin()));
+    members_ = std::move(updated);
+
+    // Released once the lock is unlocked, since the slot takes the lock of the connection's destruction handlers
+    if (auto slotIt = destructionSlots_.find(connection); slotIt != destructionSlots_.end())
+    {
+        destructionSlot = std::move(slotIt->second);
+        destructionSlots_.erase(slotIt);
+    }
+
+    // Broadcasts that started from now on don't see the connection, the earlier ones must finish first
+    const auto generation = ++generation_;
+    broadcastFinished_.wait(lock, [&](){ return activeBroadcasts_.empty() || activeBroadcasts_.begin()->first >= generation; });
+
+    return true;
+}
+
+std::size_t BroadcastGroup::getConnectionCount() const
+{
+    std::lock_guard lock(mutex_);
+
+    return members_->size();
+}
+
+std::size_t BroadcastGroup::broadcast( const ObjectPath& objectPath
+                                     , const InterfaceName& interfaceName
+                                     , const SignalName& signalName
+                                     , PlainMessage& arguments )
+{
+    // Invalid names would otherwise make the broadcast fail for each member silently
+    SDBUS_CHECK_OBJECT_PATH(objectPath.c_str());
+    SDBUS_CHECK_INTERFACE_NAME(interfaceName.c_str());
+    SDBUS_CHECK_MEMBER_NAME(signalName.c_str());
+
+    // Sealed already if broadcast before; reading the arguments below fails on an unsealed message otherwise
+    if (!arguments.isSealed())
+        arguments.seal();
+
+    std::shared_ptr<const Members> members;
+    std::uint64_t generation{};
+    {
+        std::lock_guard lock(mutex_);
+        members = members_;
+        generation = generation_;
+        ++activeBroadcasts_[generation];
+    }
+    SCOPE_EXIT
+    {
+        {
+            std::lock_guard lock(mutex_);
+            if (--activeBroadcasts_[generation] == 0)
+                activeBroadcasts_.erase(generation);
+        }
+        broadcastFinished_.notify_all();
+    };
+
+    std::size_t sentCount{};
+    for (auto* connection : *members)
+    {
+        try
+        {
+            // The serialized body is copied as is, without deserializing and serializing the arguments again
+            auto signal = connection->createSignal(objectPath, interfaceName, signalName);
+            arguments.rewind(true);
+            arguments.copyTo(signal, true);
+            signal.send();
+            ++sentCount;
+        }
+        catch (const Error&)
+        {
+            // The peer may have closed its connection in the meantime, which shall not affect the other members
+        }
+    }
+
+    return sentCount;
+}
+
+PeerServer::PeerServer(int listeningFd, EventLoop& eventLoop, peer_handler onPeerConnected, peer_handler onPeerDisconnected)
+    : listeningFd_(listeningFd)
+    , eventLoop_(eventLoop)
+    , onPeerConnected_(std::move(onPeerConnected))
+    , onPeerDisconnected_(std::move(onPeerDisconnected))
+{
+    SDBUS_THROW_ERROR_IF(listeningFd_ < 0, "Invalid listening socket", EINVAL);
+
+    releaseFd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    SDBUS_THROW_ERROR_IF(releaseFd_ < 0, "Failed to create event object", -errno);
+
+    try
+    {
+        releaseTag_ = eventLoop_.watchDescriptor(releaseFd_, [this](){ releaseDisconnectedPeers(); });
+    }
+    catch (const Error&)
+    {
+        close(releaseFd_);
+        throw;
+    }
+
+    try
+    {
+        listeningTag_ = eventLoop_.watchDescriptor(listeningFd_, [this](){ acceptPeer(); });
+    }
+    catch (const Error&)
+    {
+        eventLoop_.unwatchDescriptor(releaseTag_);
+        close(releaseFd_);
+        throw;
+    }
+}
+
+PeerServer::~PeerServer()
+{
+    try
+    {
+        // Once unwatched, the event loop doesn't invoke the callbacks anymore, nor is in the middle of them
+        eventLoop_.unwatchDescriptor(listeningTag_);
+        eventLoop_.unwatchDescriptor(releaseTag_);
+
+        decltype(peers_) peers;
+        {
+            std::lock_guard lock(mutex_);
+            peers.swap(peers_);
+        }
+        for (auto& [connection, peer] : peers)
+            releasePeer(peer);
+    }
+    catch (...)
+    {
+    }
+
+    close(releaseFd_);
+}
+
+sdbus::IBroadcastGroup& PeerServer::getBroadcastGroup()
+{
+    return broadcastGroup_;
+}
+
+std::size_t PeerServer::getPeerCount() const
+{
+    std::lock_guard lock(mutex_);
+
+    return peers_.size();
+}
+
+void PeerServer::acceptPeer()
+{
+    auto fd = accept4(listeningFd_, nullptr, nullptr, SOCK_CLOEXEC);
+    if (fd < 0)
+        return; // E.g. the client has given up in the meantime, the server goes on listening
+
+    std::unique_ptr<sdbus::IConnection> connection;
+    try
+    {
+        connection = createServerBus(fd);
+    }
+    catch (const Error&)
+    {
+        return; // A client failing to connect shall not take the server down
+    }
+
+    auto* rawConnection = connection.get();
+    auto disconnectedSlot = connection->addMatch( DISCONNECTED_MATCH_RULE
+                                                , [this, rawConnection](Message /*msg*/){ markPeerDisconnected(rawConnection); }
+                                                , return_slot );
+    eventLoop_.attach(*connection);
+    broadcastGroup_.add(*connection);
+    {
+        std::lock_guard lock(mutex_);
+        peers_.emplace(rawConnection, Peer{std::move(connection), std::move(disconnectedSlot)});
+    }
+
+    if (onPeerConnected_)
+        onPeerConnected_(*rawConnection);
+}
+
+void PeerServer::markPeerDisconnected(sdbus::IConnection* connection)
+{
+    // Invoked from within the processing of the connection, so it's only detached now, and released later
+    std::lock_guard lock(mutex_);
+
+    auto it = peers_.find(connection);
+    if (it == peers_.end() || it->second.disconnected)
+        return;
+
+    it->second.disconnected = true;
+    eventLoop_.detach(*connection);
+    (void)eventfd_write(releaseFd_, 1);
+}
+
+void PeerServer::releaseDisconnectedPeers()
+{
+    eventfd_t value{};
+    (void)eventfd_read(releaseFd_, &value);
+
+    std::vector<Peer> releasedPeers;
+    {
+        std::lock_guard lock(mutex_);
+        for (auto it = peers_.begin(); it != peers_.end();)
+        {
+            if (it->second.disconnected)
+            {
+                releasedPeers.push_back(std::move(it->second));
+                it = peers_.erase(it);
+            }
+            else
+                ++it;
+        }
+    }
+
+    for (auto& peer : releasedPeers)
+        releasePeer(peer);
+}
+
+void PeerServer::releasePeer(Peer& peer)
+{
+    if (!peer.disconnected)
+        eventLoop_.detach(*peer.connection);
+    broadcastGroup_.remove(*peer.connection);
+
+    if (onPeerDisconnected_)
+        onPeerDisconnected_(*peer.connection);
+
+    peer.disconnectedSlot.reset();
+    peer.connection.reset();
+}
+
+}
+
+namespace sdbus {
+
+std::unique_ptr<sdbus::IBroadcastGroup> createBroadcastGroup()
+{
+    return std::make_unique<sdbus::internal::BroadcastGroup>();
+}
+
+std::unique_ptr<sdbus::IPeerServer> createPeerServer( int listeningFd
+                                                    , IEventLoop& eventLoop
+                                                    , peer_handler onPeerConnected
+                                                    , peer_handler onPeerDisconnected )
+{
+    auto* internalEventLoop = dynamic_cast<sdbus::internal::EventLoop*>(&eventLoop);
+    SDBUS_THROW_ERROR_IF(!internalEventLoop, "Event loop is not a real sdbus-c++ event loop", EINVAL);
+
+    return std::make_unique<sdbus::internal::PeerServer>( listeningFd
+                                                        , *internalEventLoop
+                                                        , std::move(onPeerConnected)
+                                                        , std::move(onPeerDisconnected) );
+}
+
+}
@@ -0,0 +1,118 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file PeerServer.h
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_INTERNAL_PEERSERVER_H_
+#define SDBUS_CXX_INTERNAL_PEERSERVER_H_
+
+#include "sdbus-c++/IPeerServer.h"
+
+#include "sdbus-c++/IConnection.h"
+
+#include "IConnection.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace sdbus::internal {
+
+    class EventLoop;
+
+    class BroadcastGroup
+        : public sdbus::IBroadcastGroup
+    {
+    public:
+        void add(sdbus::IConnection& connection) override;
+        void remove(sdbus::IConnection& connection) override;
+        [[nodiscard]] std::size_t getConnectionCount() const override;
+        std::size_t broadcast( const ObjectPath& objectPath
+                             , const InterfaceName& interfaceName
+                             , const SignalName& signalName
+                             , PlainMessage& arguments ) override;
+
+    private:
+        using Members = std::vector<internal::IConnection*>;
+
+        bool removeMember(internal::IConnection* connection);
+
+        mutable std::mutex mutex_;
+        // Broadcasts send to an immutable snapshot of members without holding the mutex, since sending
+        // takes the sd-bus lock of each member, which the event loop holds while running its handlers
+        std::shared_ptr<const Members> members_{std::make_shared<Members>()};
+        // Removal bumps the generation and waits for broadcasts of older generations to finish
+        std::uint64_t generation_{};
+        std::map<std::uint64_t, std::size_t> activeBroadcasts_; // Generation -> number of broadcasts in progress
+        std::condition_variable broadcastFinished_;
+        // Members destroyed without having been removed leave the group through their destruction handlers
+        std::map<internal::IConnection*, Slot> destructionSlots_;
+    };
+
+    class PeerServer
+        : public sdbus::IPeerServer
+    {
+    public:
+        PeerServer(int listeningFd, EventLoop& eventLoop, peer_handler onPeerConnected, peer_handler onPeerDisconnected);
+        ~PeerServer() override;
+
+        sdbus::IBroadcastGroup& getBroadcastGroup() override;
+        [[nodiscard]] std::size_t getPeerCount() const override;
+
+    private:
+        struct Peer
+        {
+            std::unique_ptr<sdbus::IConnection> connection;
+            Slot disconnectedSlot;
+            bool disconnected{};
+        };
+
+        void acceptPeer();
+        void markPeerDisconnected(sdbus::IConnection* connection);
+        void releaseDisconnectedPeers();
+        void releasePeer(Peer& peer);
+
+        int listeningFd_;
+        EventLoop& eventLoop_;
+        peer_handler onPeerConnected_;
+        peer_handler onPeerDisconnected_;
+        BroadcastGroup broadcastGroup_;
+
+        mutable std::mutex mutex_;
+        std::map<sdbus::IConnection*, Peer> peers_;
+
+        // Disconnected peers can't be destroyed from within their own handlers, so they are released
+        // by a callback of this descriptor, which the event loop invokes outside of connection processing
+        int releaseFd_{-1};
+        std::uint64_t listeningTag_{};
+        std::uint64_t releaseTag_{};
+    };
+
+}
+
+#endif /* SDBUS_CXX_INTERNAL_PEERSERVER_H_ */
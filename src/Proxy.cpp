@@ -28,13 +28,17 @@
 
 #include "sdbus-c++/Error.h"
 #include "sdbus-c++/IConnection.h"
+#include "sdbus-c++/ITracer.h"
 #include "sdbus-c++/Message.h"
 
 #include "IConnection.h"
+#include "MemoryResource.h"
 #include "MessageUtils.h"
+#include "MetricsCollector.h"
 #include "ScopeGuard.h"
 #include "Utils.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include SDBUS_HEADER
@@ -42,6 +46,51 @@
 
 namespace sdbus::internal {
 
+namespace {
+    constexpr const char* DBUS_PROPERTIES_INTERFACE_NAME = "org.freedesktop.DBus.Properties";
+
+    // Appends the serialized arguments to the cache key, each one prefixed with its type and containers terminated
+    // by a zero, so that different arguments never make up the same key. Unix fds can't make up a key.
+    bool appendToMethodResultKey(std::string& key, sd_bus_message* arguments)
+    {
+        for (;;)
+        {
+            char type{};
+            const char* contents{};
+            auto r = sd_bus_message_peek_type(arguments, &type, &contents);
+            if (r <= 0)
+                return r == 0; // End of the message or of the enclosing container
+
+            key += type;
+            if (type == SD_BUS_TYPE_ARRAY || type == SD_BUS_TYPE_VARIANT || type == SD_BUS_TYPE_STRUCT || type == SD_BUS_TYPE_DICT_ENTRY)
+            {
+                key.append(contents, std::strlen(contents) + 1);
+                if ( sd_bus_message_enter_container(arguments, type, contents) < 0
+                  || !appendToMethodResultKey(key, arguments)
+                  || sd_bus_message_exit_container(arguments) < 0 )
+                    return false;
+                key += '\0';
+            }
+            else if (type == SD_BUS_TYPE_STRING || type == SD_BUS_TYPE_OBJECT_PATH || type == SD_BUS_TYPE_SIGNATURE)
+            {
+                const char* value{};
+                if (sd_bus_message_read_basic(arguments, type, &value) < 0)
+                    return false;
+                key.append(value, std::strlen(value) + 1);
+            }
+            else if (type != SD_BUS_TYPE_UNIX_FD)
+            {
+                std::uint64_t value{}; // Wide enough for any fixed-size basic type
+                if (sd_bus_message_read_basic(arguments, type, &value) < 0)
+                    return false;
+                key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+            }
+            else
+                return false;
+        }
+    }
+}
+
 Proxy::Proxy(sdbus::internal::IConnection& connection, ServiceName destination, ObjectPath objectPath)
     : connection_(&connection, [](sdbus::internal::IConnection *){ /* Intentionally left empty */ })
     , destination_(std::move(destination))
@@ -94,6 +143,14 @@ MethodCall Proxy::createMethodCall(const char* interfaceName, const char* method
     return connection_->createMethodCall(destination_.c_str(), objectPath_.c_str(), interfaceName, methodName);
 }
 
+PreparedMethodCall Proxy::prepareMethodCall(InterfaceName interfaceName, MethodName methodName) const
+{
+    SDBUS_CHECK_INTERFACE_NAME(interfaceName.c_str());
+    SDBUS_CHECK_MEMBER_NAME(methodName.c_str());
+
+    return {*this, std::move(interfaceName), std::move(methodName)};
+}
+
 MethodReply Proxy::callMethod(const MethodCall& message)
 {
     return Proxy::callMethod(message, /*timeout*/ 0);
@@ -103,7 +160,43 @@ MethodReply Proxy::callMethod(const MethodCall& message, uint64_t timeout)
 {
     SDBUS_THROW_ERROR_IF(!message.isValid(), "Invalid method call message provided", EINVAL);
 
-    return message.send(timeout);
+    auto tracer = connection_->getTracer();
+    if (tracer == nullptr)
+        return message.send(timeout);
+
+    auto* span = tracer->onMethodCallSent(message);
+    const Error* error{};
+    // The span is closed whatever the call throws, and with the error if it's a D-Bus one
+    SCOPE_EXIT{ tracer->onMethodCallCompleted(span, message, error); };
+    try
+    {
+        return message.send(timeout);
+    }
+    catch (const Error& e)
+    {
+        error = &e;
+        throw;
+    }
+}
+
+Expected<MethodReply> Proxy::callMethod(const MethodCall& message, std::nothrow_t)
+{
+    return Proxy::callMethod(message, /*timeout*/ 0, std::nothrow);
+}
+
+Expected<MethodReply> Proxy::callMethod(const MethodCall& message, uint64_t timeout, std::nothrow_t)
+{
+    if (!message.isValid())
+        return createError(EINVAL, "Invalid method call message provided");
+
+    auto tracer = connection_->getTracer();
+    if (tracer == nullptr)
+        return message.send(timeout, std::nothrow);
+
+    auto* span = tracer->onMethodCallSent(message);
+    auto reply = message.send(timeout, std::nothrow);
+    tracer->onMethodCallCompleted(span, message, reply ? nullptr : &reply.error());
+    return reply;
 }
 
 PendingAsyncCall Proxy::callMethodAsync(const MethodCall& message, async_reply_handler asyncReplyCallback)
@@ -120,11 +213,14 @@ PendingAsyncCall Proxy::callMethodAsync(const MethodCall& message, async_reply_h
 {
     SDBUS_THROW_ERROR_IF(!message.isValid(), "Invalid async method call message provided", EINVAL);
 
-    auto asyncCallInfo = std::make_shared<AsyncCallInfo>(AsyncCallInfo{ .callback = std::move(asyncReplyCallback)
-                                                                      , .proxy = *this
-                                                                      , .floating = false });
+    // Pending call handles hold the call info weakly, so the allocator keeps the memory resource alive for them
+    auto asyncCallInfo = std::allocate_shared<AsyncCallInfo>( SharedResourceAllocator<AsyncCallInfo>(connection_->getMemoryResource())
+                                                            , AsyncCallInfo{ .callback = std::move(asyncReplyCallback)
+                                                                           , .proxy = *this
+                                                                           , .windowToken = acquireAsyncCallWindowToken()
+                                                                           , .floating = false } );
 
-    asyncCallInfo->slot = message.send((void*)&Proxy::sdbus_async_reply_handler, asyncCallInfo.get(), timeout, return_slot);
+    sendAsyncCall(*asyncCallInfo, message, timeout);
 
     auto asyncCallInfoWeakPtr = std::weak_ptr{asyncCallInfo};
 
@@ -137,13 +233,39 @@ Slot Proxy::callMethodAsync(const MethodCall& message, async_reply_handler async
 {
     SDBUS_THROW_ERROR_IF(!message.isValid(), "Invalid async method call message provided", EINVAL);
 
-    auto asyncCallInfo = std::make_unique<AsyncCallInfo>(AsyncCallInfo{ .callback = std::move(asyncReplyCallback)
-                                                                      , .proxy = *this
-                                                                      , .floating = true });
+    auto asyncCallInfo = makePooled<AsyncCallInfo>( *connection_->getMemoryResource()
+                                                  , AsyncCallInfo{ .callback = std::move(asyncReplyCallback)
+                                                                 , .proxy = *this
+                                                                 , .windowToken = acquireAsyncCallWindowToken()
+                                                                 , .floating = true } );
 
-    asyncCallInfo->slot = message.send((void*)&Proxy::sdbus_async_reply_handler, asyncCallInfo.get(), timeout, return_slot);
+    sendAsyncCall(*asyncCallInfo, message, timeout);
 
-    return {asyncCallInfo.release(), [](void *ptr){ delete static_cast<AsyncCallInfo*>(ptr); }};
+    return {asyncCallInfo.release(), [deleter = asyncCallInfo.get_deleter()](void *ptr){ deleter(static_cast<AsyncCallInfo*>(ptr)); }};
+}
+
+void Proxy::sendAsyncCall(AsyncCallInfo& asyncCallInfo, const MethodCall& message, uint64_t timeout)
+{
+    if (connection_->getMetricsCollector().isEnabled())
+        asyncCallInfo.startTime = now();
+
+    auto tracer = connection_->getTracer();
+    if (tracer == nullptr)
+    {
+        asyncCallInfo.slot = message.send((void*)&Proxy::sdbus_async_reply_handler, &asyncCallInfo, timeout, return_slot);
+        return;
+    }
+
+    asyncCallInfo.trace = AsyncCallTrace{std::move(tracer), message};
+    try
+    {
+        asyncCallInfo.slot = message.send((void*)&Proxy::sdbus_async_reply_handler, &asyncCallInfo, timeout, return_slot);
+    }
+    catch (const Error& e)
+    {
+        asyncCallInfo.trace.complete(&e);
+        throw;
+    }
 }
 
 std::future<MethodReply> Proxy::callMethodAsync(const MethodCall& message, with_future_t)
@@ -182,6 +304,7 @@ void Proxy::registerSignalHandler( const char* interfaceName
 {
     auto slot = Proxy::registerSignalHandler(interfaceName, signalName, std::move(signalHandler), return_slot);
 
+    std::lock_guard lock(floatingSignalSlotsMutex_);
     floatingSignalSlots_.push_back(std::move(slot));
 }
 
@@ -202,23 +325,253 @@ Slot Proxy::registerSignalHandler( const char* interfaceName
     SDBUS_CHECK_MEMBER_NAME(signalName);
     SDBUS_THROW_ERROR_IF(!signalHandler, "Invalid signal handler provided", EINVAL);
 
-    auto signalInfo = std::make_unique<SignalInfo>(SignalInfo{std::move(signalHandler), *this, {}});
+    if (aggregateSignalMatches_ && *interfaceName && *signalName)
+        return registerAggregatedSignalHandler(interfaceName, signalName, std::move(signalHandler));
+
+    auto signalInfo = makePooled<SignalInfo>( *connection_->getMemoryResource()
+                                            , std::move(signalHandler)
+                                            , *this
+                                            , acquireSignalMatchInstallToken()
+                                            , Slot{} );
+
+    signalInfo->slot = connection_->registerSignalHandler( destination_.c_str()
+                                                         , objectPath_.c_str()
+                                                         , interfaceName
+                                                         , signalName
+                                                         , &Proxy::sdbus_signal_handler
+                                                         , signalInfo->installToken.isPending() ? &Proxy::sdbus_signal_match_install_handler : nullptr
+                                                         , signalInfo.get()
+                                                         , return_slot );
+
+    return {signalInfo.release(), [deleter = signalInfo.get_deleter()](void *ptr){ deleter(static_cast<SignalInfo*>(ptr)); }};
+}
+
+void Proxy::registerSignalHandler( const InterfaceName& interfaceName
+                                 , const SignalName& signalName
+                                 , const std::vector<SignalArgFilter>& argFilters
+                                 , signal_handler signalHandler )
+{
+    Proxy::registerSignalHandler(interfaceName.c_str(), signalName.c_str(), argFilters, std::move(signalHandler));
+}
+
+void Proxy::registerSignalHandler( const char* interfaceName
+                                 , const char* signalName
+                                 , const std::vector<SignalArgFilter>& argFilters
+                                 , signal_handler signalHandler )
+{
+    auto slot = Proxy::registerSignalHandler(interfaceName, signalName, argFilters, std::move(signalHandler), return_slot);
+
+    std::lock_guard lock(floatingSignalSlotsMutex_);
+    floatingSignalSlots_.push_back(std::move(slot));
+}
+
+Slot Proxy::registerSignalHandler( const InterfaceName& interfaceName
+                                 , const SignalName& signalName
+                                 , const std::vector<SignalArgFilter>& argFilters
+                                 , signal_handler signalHandler
+                                 , return_slot_t )
+{
+    return Proxy::registerSignalHandler(interfaceName.c_str(), signalName.c_str(), argFilters, std::move(signalHandler), return_slot);
+}
+
+Slot Proxy::registerSignalHandler( const char* interfaceName
+                                 , const char* signalName
+                                 , const std::vector<SignalArgFilter>& argFilters
+                                 , signal_handler signalHandler
+                                 , return_slot_t )
+{
+    if (argFilters.empty())
+        return Proxy::registerSignalHandler(interfaceName, signalName, std::move(signalHandler), return_slot);
+
+    SDBUS_CHECK_INTERFACE_NAME(interfaceName);
+    SDBUS_CHECK_MEMBER_NAME(signalName);
+    SDBUS_THROW_ERROR_IF(!signalHandler, "Invalid signal handler provided", EINVAL);
+
+    // The filters are specific to this handler, so the subscription gets a match rule of its own instead of being aggregated
+    auto signalInfo = makePooled<SignalInfo>( *connection_->getMemoryResource()
+                                            , std::move(signalHandler)
+                                            , *this
+                                            , acquireSignalMatchInstallToken()
+                                            , Slot{} );
 
     signalInfo->slot = connection_->registerSignalHandler( destination_.c_str()
                                                          , objectPath_.c_str()
                                                          , interfaceName
                                                          , signalName
+                                                         , argFilters
                                                          , &Proxy::sdbus_signal_handler
+                                                         , signalInfo->installToken.isPending() ? &Proxy::sdbus_signal_match_install_handler : nullptr
                                                          , signalInfo.get()
                                                          , return_slot );
 
-    return {signalInfo.release(), [](void *ptr){ delete static_cast<SignalInfo*>(ptr); }};
+    return {signalInfo.release(), [deleter = signalInfo.get_deleter()](void *ptr){ deleter(static_cast<SignalInfo*>(ptr)); }};
+}
+
+Slot Proxy::registerAggregatedSignalHandler(const char* interfaceName, const char* signalName, signal_handler signalHandler)
+{
+    auto signalInfo = std::make_shared<AggregatedSignalInfo>(AggregatedSignalInfo{std::move(signalHandler)});
+    auto* signalInfoPtr = signalInfo.get();
+    auto slot = Slot{signalInfoPtr, [this, interface = std::string(interfaceName), signal = std::string(signalName)](void *ptr)
+    {
+        unregisterAggregatedSignalHandler(interface, signal, ptr);
+    }};
+
+    {
+        std::lock_guard lock(interfaceSignalsMutex_);
+        if (auto it = interfaceSignals_.find(std::string_view{interfaceName}); it != interfaceSignals_.end())
+        {
+            it->second->handlers[signalName].push_back(std::move(signalInfo));
+            return slot;
+        }
+    }
+
+    // First handler of the interface: subscribe to all signals of the interface with one match rule.
+    // The match must be added outside the `interfaceSignalsMutex_' critical section, because adding it
+    // acquires the sd-bus mutex, while the dispatching thread holds the sd-bus mutex when acquiring ours.
+    auto interfaceSignals = std::make_shared<InterfaceSignals>(*this);
+    interfaceSignals->installToken = acquireSignalMatchInstallToken();
+    interfaceSignals->matchSlot = connection_->registerSignalHandler( destination_.c_str()
+                                                                    , objectPath_.c_str()
+                                                                    , interfaceName
+                                                                    , ""
+                                                                    , &Proxy::sdbus_aggregated_signal_handler
+                                                                    , interfaceSignals->installToken.isPending()
+                                                                      ? &Proxy::sdbus_aggregated_signal_match_install_handler
+                                                                      : nullptr
+                                                                    , interfaceSignals.get()
+                                                                    , return_slot );
+
+    std::unique_lock lock(interfaceSignalsMutex_);
+    // Another thread may have subscribed to the interface in the meantime; our match is then dropped at scope exit, after unlocking
+    auto it = interfaceSignals_.try_emplace(interfaceName, std::move(interfaceSignals)).first;
+    it->second->handlers[signalName].push_back(std::move(signalInfo));
+    lock.unlock();
+
+    return slot;
+}
+
+void Proxy::unregisterAggregatedSignalHandler(const std::string& interfaceName, const std::string& signalName, const void* handlerInfo)
+{
+    std::shared_ptr<InterfaceSignals> unusedInterfaceSignals;
+    std::shared_ptr<AggregatedSignalInfo> removedHandler;
+
+    std::unique_lock lock(interfaceSignalsMutex_);
+
+    auto interfaceIt = interfaceSignals_.find(interfaceName);
+    if (interfaceIt == interfaceSignals_.end())
+        return; // The proxy has been unregistered in the meantime
+
+    auto& interfaceSignals = *interfaceIt->second;
+    auto handlersIt = interfaceSignals.handlers.find(signalName);
+    if (handlersIt == interfaceSignals.handlers.end())
+        return;
+
+    auto& handlers = handlersIt->second;
+    auto it = std::find_if(handlers.begin(), handlers.end(), [handlerInfo](const auto& handler){ return handler.get() == handlerInfo; });
+    if (it == handlers.end())
+        return;
+
+    // If we get here from within the handler itself, the dispatcher still holds its own reference to it
+    removedHandler = std::move(*it);
+
+    if (interfaceSignals.dispatchDepth > 0)
+    {
+        // We are called from within a signal handler. Keep the containers intact for the dispatch loop up the stack.
+        interfaceSignals.hasRemovedHandlers = true;
+        return;
+    }
+
+    handlers.erase(it);
+    if (handlers.empty())
+        interfaceSignals.handlers.erase(handlersIt);
+    if (interfaceSignals.handlers.empty())
+    {
+        unusedInterfaceSignals = std::move(interfaceIt->second);
+        interfaceSignals_.erase(interfaceIt);
+    }
+
+    lock.unlock();
+
+    // Releasing match slot acquires global sd-bus mutex, so we must do it out of the `interfaceSignalsMutex_' critical section
+}
+
+void Proxy::enableSignalMatchAggregation(bool enabled)
+{
+    aggregateSignalMatches_ = enabled;
+}
+
+void Proxy::enableAsyncSignalMatchInstallation(bool enabled, signal_match_install_handler installHandler)
+{
+    {
+        std::lock_guard lock(signalMatchInstallation_->mutex);
+        signalMatchInstallation_->installHandler = std::move(installHandler);
+    }
+    installSignalMatchesAsync_ = enabled;
+}
+
+void Proxy::enablePropertyCache(bool enabled)
+{
+    if (!enabled)
+    {
+        propertyCacheEnabled_ = false;
+
+        std::unique_lock lock(propertyCacheMutex_);
+        auto slots = std::move(propertyCacheSlots_);
+        propertyCacheSlots_.clear();
+        propertyCache_.clear();
+        ++propertyCacheGeneration_;
+        lock.unlock();
+
+        // Releasing match slots acquires global sd-bus mutex, so we must do it out of the `propertyCacheMutex_' critical section
+        return;
+    }
+
+    if (propertyCacheEnabled_.exchange(true))
+        return;
+
+    std::vector<Slot> slots;
+    try
+    {
+        slots.push_back(Proxy::registerSignalHandler( DBUS_PROPERTIES_INTERFACE_NAME
+                                                    , "PropertiesChanged"
+                                                    , [this](Signal signal){ onPropertiesChanged(signal); }
+                                                    , return_slot ));
+
+        // Values cached from a previous owner of the service name are meaningless for the new one
+        auto ownerChangedMatch = "type='signal',sender='org.freedesktop.DBus',path='/org/freedesktop/DBus',"
+                                 "interface='org.freedesktop.DBus',member='NameOwnerChanged',arg0='" + destination_ + "'";
+        slots.push_back(connection_->addMatch(ownerChangedMatch, [this](sdbus::Message /*msg*/){ dropPropertyCache(); }, return_slot));
+    }
+    catch (...)
+    {
+        propertyCacheEnabled_ = false;
+        throw;
+    }
+
+    std::lock_guard lock(propertyCacheMutex_);
+    propertyCacheSlots_ = std::move(slots);
 }
 
 void Proxy::unregister()
 {
     floatingAsyncCallSlots_.clear();
-    floatingSignalSlots_.clear();
+    {
+        std::unique_lock lock(floatingSignalSlotsMutex_);
+        auto signalSlots = std::move(floatingSignalSlots_);
+        floatingSignalSlots_.clear();
+        lock.unlock();
+
+        // Releasing match slots acquires global sd-bus mutex, so we must do it out of the `floatingSignalSlotsMutex_' critical section
+    }
+    Proxy::enablePropertyCache(false);
+    methodResultCacheSlot_.reset();
+
+    std::unique_lock lock(interfaceSignalsMutex_);
+    auto interfaceSignals = std::move(interfaceSignals_);
+    interfaceSignals_ = {};
+    lock.unlock();
+
+    // Releasing match slots acquires global sd-bus mutex, so we must do it out of the `interfaceSignalsMutex_' critical section
 }
 
 sdbus::IConnection& Proxy::getConnection() const
@@ -236,6 +589,241 @@ Message Proxy::getCurrentlyProcessedMessage() const
     return connection_->getCurrentlyProcessedMessage();
 }
 
+void Proxy::setMaxPendingAsyncCalls(std::size_t maxCount)
+{
+    asyncCallWindow_->maxSize.store(maxCount, std::memory_order_relaxed);
+}
+
+std::size_t Proxy::getPendingAsyncCallCount() const
+{
+    return asyncCallWindow_->size.load(std::memory_order_relaxed);
+}
+
+Proxy::ResourceUsage Proxy::getResourceUsage() const
+{
+    // Rough size of a node of a node-based container, on top of its value
+    constexpr std::size_t NODE_OVERHEAD{4 * sizeof(void*)};
+
+    ResourceUsage usage;
+    std::size_t bytes{};
+
+    {
+        std::lock_guard lock(floatingSignalSlotsMutex_);
+        usage.floatingSignalHandlers = floatingSignalSlots_.size();
+        bytes += floatingSignalSlots_.capacity() * sizeof(Slot);
+    }
+    {
+        std::lock_guard lock(interfaceSignalsMutex_);
+        for (const auto& [interfaceName, signals] : interfaceSignals_)
+        {
+            bytes += NODE_OVERHEAD + sizeof(InterfaceSignals) + interfaceName.capacity();
+            for (const auto& [signalName, handlers] : signals->handlers)
+            {
+                bytes += NODE_OVERHEAD + sizeof(handlers) + signalName.capacity() + handlers.capacity() * sizeof(handlers[0]);
+                for (const auto& handler : handlers)
+                    usage.aggregatedSignalHandlers += handler != nullptr;
+            }
+        }
+        bytes += usage.aggregatedSignalHandlers * sizeof(AggregatedSignalInfo);
+    }
+    // Signal handlers served by their own match rules
+    bytes += (usage.floatingSignalHandlers - std::min(usage.floatingSignalHandlers, usage.aggregatedSignalHandlers)) * sizeof(SignalInfo);
+
+    usage.floatingAsyncCalls = floatingAsyncCallSlots_.size();
+    usage.pendingAsyncCalls = getPendingAsyncCallCount();
+    bytes += usage.pendingAsyncCalls * sizeof(AsyncCallInfo);
+
+    {
+        std::lock_guard lock(propertyCacheMutex_);
+        for (const auto& [interfaceName, properties] : propertyCache_)
+        {
+            usage.cachedProperties += properties.size();
+            bytes += NODE_OVERHEAD + sizeof(properties) + interfaceName.capacity();
+            for (const auto& [propertyName, value] : properties)
+                bytes += NODE_OVERHEAD + sizeof(value) + propertyName.capacity();
+        }
+    }
+    {
+        std::lock_guard lock(methodResultCacheMutex_);
+        usage.cachedMethodResults = methodResultCache_.size();
+        for (const auto& [key, results] : methodResultCache_)
+            bytes += NODE_OVERHEAD + sizeof(results) + key.capacity();
+    }
+
+    usage.approximateBytes = bytes;
+
+    return usage;
+}
+
+std::optional<Variant> Proxy::getCachedProperty(std::string_view interfaceName, std::string_view propertyName)
+{
+    if (!propertyCacheEnabled_.load(std::memory_order_relaxed))
+        return std::nullopt;
+
+    std::unique_lock lock(propertyCacheMutex_);
+    const auto generation = propertyCacheGeneration_;
+
+    if (auto interfaceIt = propertyCache_.find(interfaceName); interfaceIt != propertyCache_.end())
+    {
+        auto& cachedProperties = interfaceIt->second;
+        if (auto propertyIt = cachedProperties.find(propertyName); propertyIt != cachedProperties.end())
+            return propertyIt->second;
+
+        // The property has been invalidated by the remote side, so we re-fetch it alone
+        lock.unlock();
+        Variant value;
+        IProxy::callMethod("Get").onInterface(DBUS_PROPERTIES_INTERFACE_NAME).withArguments(interfaceName, propertyName).storeResultsTo(value);
+        lock.lock();
+
+        if (generation == propertyCacheGeneration_)
+            propertyCache_[std::string{interfaceName}][std::string{propertyName}] = value;
+
+        return value;
+    }
+
+    // First use of the interface, so we fetch all its properties at once
+    lock.unlock();
+    std::map<std::string, Variant, std::less<>> properties;
+    IProxy::callMethod("GetAll").onInterface(DBUS_PROPERTIES_INTERFACE_NAME).withArguments(interfaceName).storeResultsTo(properties);
+
+    std::optional<Variant> value;
+    if (auto propertyIt = properties.find(propertyName); propertyIt != properties.end())
+        value = propertyIt->second; // Otherwise let the plain Get call report the error
+
+    lock.lock();
+    // Values which may have been overtaken by a concurrently delivered PropertiesChanged are not stored
+    if (generation == propertyCacheGeneration_)
+        propertyCache_.try_emplace(std::string{interfaceName}, std::move(properties));
+
+    return value;
+}
+
+void Proxy::onPropertiesChanged(Signal& signal)
+{
+    std::string interfaceName;
+    std::map<std::string, Variant> changedProperties;
+    std::vector<std::string> invalidatedProperties;
+    signal >> interfaceName >> changedProperties >> invalidatedProperties;
+
+    std::lock_guard lock(propertyCacheMutex_);
+    ++propertyCacheGeneration_;
+
+    auto interfaceIt = propertyCache_.find(interfaceName);
+    if (interfaceIt == propertyCache_.end())
+        return; // Not cached yet
+
+    auto& cachedProperties = interfaceIt->second;
+    for (auto& [name, value] : changedProperties)
+        cachedProperties[name] = std::move(value);
+    for (const auto& name : invalidatedProperties)
+        cachedProperties.erase(name);
+}
+
+void Proxy::dropPropertyCache()
+{
+    std::lock_guard lock(propertyCacheMutex_);
+    propertyCache_.clear();
+    ++propertyCacheGeneration_;
+}
+
+Expected<Message> Proxy::callMethodWithCachedResults( const MethodCall& message
+                                                    , PlainMessage& arguments
+                                                    , uint64_t timeout
+                                                    , uint64_t ttl )
+{
+    if (!message.isValid())
+        return createError(EINVAL, "Invalid method call message provided");
+
+    std::string key{message.getInterfaceName()};
+    key += '\0';
+    key += message.getMemberName();
+    key += '\0';
+
+    arguments.seal();
+    const auto cacheable = appendToMethodResultKey(key, static_cast<sd_bus_message*>(Message::Factory::getSdBusMessage(arguments)));
+
+    std::uint64_t generation{};
+    if (cacheable)
+    {
+        // Subscribed outside the cache mutex, since its NameOwnerChanged handler takes the mutex under the sd-bus lock
+        watchOwnerForMethodResultCache();
+
+        std::lock_guard lock(methodResultCacheMutex_);
+        generation = methodResultCacheGeneration_;
+
+        if (auto it = methodResultCache_.find(key); it != methodResultCache_.end())
+        {
+            if (std::chrono::steady_clock::now() < it->second.expiresAt)
+            {
+                // Each caller reads its own copy of the results, since reading moves the read position of a message
+                auto results = createPlainMessage();
+                it->second.results.rewind(true);
+                it->second.results.copyTo(results, true);
+                results.seal();
+                return Message{std::move(results)};
+            }
+            methodResultCache_.erase(it);
+        }
+    }
+
+    auto call = message;
+    arguments.rewind(true);
+    arguments.copyTo(call, true);
+
+    auto reply = Proxy::callMethod(call, timeout, std::nothrow);
+    if (!reply || !cacheable)
+        return reply ? Expected<Message>{std::move(*reply)} : Expected<Message>{std::move(reply).error()};
+
+    auto results = createPlainMessage();
+    reply->copyTo(results, true);
+    results.seal();
+    reply->rewind(true);
+
+    const auto now = std::chrono::steady_clock::now();
+    auto expiresAt = std::chrono::steady_clock::time_point::max();
+    if (ttl < static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(expiresAt - now).count()))
+        expiresAt = now + std::chrono::microseconds(ttl);
+
+    std::lock_guard lock(methodResultCacheMutex_);
+    // Results which may come from a previous owner of the service name are not stored
+    if (generation == methodResultCacheGeneration_)
+        methodResultCache_.insert_or_assign(std::move(key), CachedMethodResults{std::move(results), expiresAt});
+
+    return Message{std::move(*reply)};
+}
+
+void Proxy::watchOwnerForMethodResultCache()
+{
+    std::call_once(methodResultCacheOwnerWatched_, [this]()
+    {
+        // Results cached from a previous owner of the service name are meaningless for the new one
+        auto ownerChangedMatch = "type='signal',sender='org.freedesktop.DBus',path='/org/freedesktop/DBus',"
+                                 "interface='org.freedesktop.DBus',member='NameOwnerChanged',arg0='" + destination_ + "'";
+        methodResultCacheSlot_ = connection_->addMatch(ownerChangedMatch, [this](sdbus::Message /*msg*/){ dropMethodResultCache(); }, return_slot);
+    });
+}
+
+void Proxy::dropMethodResultCache()
+{
+    std::lock_guard lock(methodResultCacheMutex_);
+    methodResultCache_.clear();
+    ++methodResultCacheGeneration_;
+}
+
+Proxy::AsyncCallWindowToken Proxy::acquireAsyncCallWindowToken()
+{
+    auto& window = *asyncCallWindow_;
+    const auto maxSize = window.maxSize.load(std::memory_order_relaxed);
+
+    auto size = window.size.load(std::memory_order_relaxed);
+    do
+    {
+        SDBUS_THROW_ERROR_IF(maxSize != 0 && size >= maxSize, "Failed to issue async method call: too many pending calls", EBUSY);
+    } while (!window.size.compare_exchange_weak(size, size + 1, std::memory_order_relaxed));
+
+    return AsyncCallWindowToken{asyncCallWindow_};
+}
+
 int Proxy::sdbus_async_reply_handler(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError)
 {
     auto* asyncCallInfo = static_cast<AsyncCallInfo*>(userData);
@@ -251,21 +839,29 @@ int Proxy::sdbus_async_reply_handler(sd_bus_message *sdbusMessage, void *userDat
         proxy.floatingAsyncCallSlots_.erase(asyncCallInfo);
     };
 
+    // The call is no longer in flight, so free its place in the window for calls issued from within the callback
+    asyncCallInfo->windowToken = {};
+
     auto message = Message::Factory::create<MethodReply>(sdbusMessage, proxy.connection_.get());
 
-    auto ok = invokeHandlerAndCatchErrors([&]
+    auto& metrics = proxy.connection_->getMetricsCollector();
+    if (asyncCallInfo->startTime != std::chrono::nanoseconds{} && metrics.isEnabled())
+        metrics.recordAsyncCallRoundTrip(now() - asyncCallInfo->startTime);
+
+    const auto* error = sd_bus_message_get_error(sdbusMessage);
+    std::optional<Error> exception;
+    if (error != nullptr)
+        exception.emplace(Error::Name{error->name}, error->message);
+
+    asyncCallInfo->trace.complete(exception ? &*exception : nullptr);
+
+    auto ok = metrics.measureHandler([&]
     {
-        const auto* error = sd_bus_message_get_error(sdbusMessage);
-        if (error == nullptr)
+        return invokeHandlerAndCatchErrors([&]
         {
-            asyncCallInfo->callback(std::move(message), {});
-        }
-        else
-        {
-            Error exception(Error::Name{error->name}, error->message);
             asyncCallInfo->callback(std::move(message), std::move(exception));
-        }
-    }, retError);
+        }, retError);
+    });
 
     return ok ? 0 : -1;
 }
@@ -278,11 +874,248 @@ int Proxy::sdbus_signal_handler(sd_bus_message *sdbusMessage, void *userData, sd
 
     auto message = Message::Factory::create<Signal>(sdbusMessage, signalInfo->proxy.connection_.get());
 
-    auto ok = invokeHandlerAndCatchErrors([&](){ signalInfo->callback(std::move(message)); }, retError);
+    auto ok = signalInfo->proxy.connection_->getMetricsCollector().measureHandler([&]
+    {
+        return invokeHandlerAndCatchErrors([&](){ signalInfo->callback(std::move(message)); }, retError);
+    });
 
     return ok ? 0 : -1;
 }
 
+int Proxy::sdbus_signal_match_install_handler(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError)
+{
+    auto* signalInfo = static_cast<SignalInfo*>(userData);
+    assert(signalInfo != nullptr);
+
+    auto ok = invokeHandlerAndCatchErrors([&](){ signalInfo->installToken.complete(sdbusMessage); }, retError);
+
+    return ok ? 0 : -1;
+}
+
+int Proxy::sdbus_aggregated_signal_match_install_handler(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError)
+{
+    auto* interfaceSignals = static_cast<InterfaceSignals*>(userData);
+    assert(interfaceSignals != nullptr);
+
+    auto ok = invokeHandlerAndCatchErrors([&](){ interfaceSignals->installToken.complete(sdbusMessage); }, retError);
+
+    return ok ? 0 : -1;
+}
+
+int Proxy::sdbus_aggregated_signal_handler(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError)
+{
+    auto* interfaceSignals = static_cast<InterfaceSignals*>(userData);
+    assert(interfaceSignals != nullptr);
+    auto& proxy = interfaceSignals->proxy;
+
+    auto message = Message::Factory::create<Signal>(sdbusMessage, proxy.connection_.get());
+    const auto* signalName = message.getMemberName();
+    if (signalName == nullptr)
+        return 0;
+
+    // A handler may unregister the whole proxy; the subscription then goes away only once we are done with it.
+    // (If it's being destroyed by another thread, its destruction waits for us on the match slot release.)
+    auto keepAlive = interfaceSignals->weak_from_this().lock();
+    std::lock_guard lock(proxy.interfaceSignalsMutex_);
+
+    auto handlersIt = interfaceSignals->handlers.find(std::string_view{signalName});
+    if (handlersIt == interfaceSignals->handlers.end())
+        return 0; // No handler for this signal of the interface
+
+    // References to unordered_map elements survive insertions, and removals from handlers are deferred while dispatching
+    auto& handlers = handlersIt->second;
+
+    ++interfaceSignals->dispatchDepth;
+    SCOPE_EXIT
+    {
+        if (--interfaceSignals->dispatchDepth == 0 && interfaceSignals->hasRemovedHandlers)
+        {
+            interfaceSignals->hasRemovedHandlers = false;
+            for (auto it = interfaceSignals->handlers.begin(); it != interfaceSignals->handlers.end();)
+            {
+                std::erase(it->second, nullptr);
+                it = it->second.empty() ? interfaceSignals->handlers.erase(it) : std::next(it);
+            }
+        }
+    };
+
+    const auto handlerCount = handlers.size(); // Handlers registered from within a handler start with the next signal
+    for (std::size_t i = 0; i < handlerCount; ++i)
+    {
+        auto handler = handlers[i]; // Holds the handler alive even if it unregisters itself
+        if (!handler)
+            continue;
+
+        auto ok = proxy.connection_->getMetricsCollector().measureHandler([&]
+        {
+            return invokeHandlerAndCatchErrors([&](){ handler->callback(message); }, retError);
+        });
+        if (!ok)
+            return -1;
+    }
+
+    return 0;
+}
+
+Proxy::AsyncCallWindowToken::AsyncCallWindowToken(std::shared_ptr<AsyncCallWindow> window)
+    : window_(std::move(window))
+{
+}
+
+Proxy::AsyncCallWindowToken& Proxy::AsyncCallWindowToken::operator=(AsyncCallWindowToken&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (window_)
+            window_->size.fetch_sub(1, std::memory_order_relaxed);
+        window_ = std::move(other.window_);
+    }
+    return *this;
+}
+
+Proxy::AsyncCallWindowToken::~AsyncCallWindowToken()
+{
+    if (window_)
+        window_->size.fetch_sub(1, std::memory_order_relaxed);
+}
+
+Proxy::SignalMatchInstallToken Proxy::acquireSignalMatchInstallToken()
+{
+    if (!installSignalMatchesAsync_.load(std::memory_order_relaxed))
+        return {};
+
+    return SignalMatchInstallToken{signalMatchInstallation_};
+}
+
+Proxy::SignalMatchInstallToken::SignalMatchInstallToken(std::shared_ptr<SignalMatchInstallation> installation)
+    : installation_(std::move(installation))
+{
+    std::lock_guard lock(installation_->mutex);
+    ++installation_->pending;
+}
+
+Proxy::SignalMatchInstallToken& Proxy::SignalMatchInstallToken::operator=(SignalMatchInstallToken&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        installation_ = std::move(other.installation_);
+    }
+    return *this;
+}
+
+Proxy::SignalMatchInstallToken::~SignalMatchInstallToken()
+{
+    release();
+}
+
+void Proxy::SignalMatchInstallToken::release()
+{
+    auto installation = std::move(installation_);
+    if (!installation)
+        return;
+
+    // The installation didn't complete, so it's just not waited for anymore. If it was the last one pending,
+    // the installations that did complete are reported now, as no one else would report them.
+    signal_match_install_handler installHandler;
+    std::optional<Error> error;
+    {
+        std::lock_guard lock(installation->mutex);
+        --installation->pending;
+        if (!takeResult(*installation, installHandler, error))
+            return;
+    }
+
+    if (installHandler)
+        installHandler(std::move(error));
+}
+
+void Proxy::SignalMatchInstallToken::complete(sd_bus_message* reply)
+{
+    auto installation = std::move(installation_);
+    if (!installation)
+        return;
+
+    std::optional<Error> error;
+    if (const auto* sdbusError = sd_bus_message_get_error(reply); sdbusError != nullptr)
+        error = Error(Error::Name{sdbusError->name}, sdbusError->message);
+
+    signal_match_install_handler installHandler;
+    {
+        std::lock_guard lock(installation->mutex);
+        if (error && !installation->error)
+            installation->error = std::move(error);
+        installation->hasCompleted = true;
+        --installation->pending;
+        if (!takeResult(*installation, installHandler, error))
+            return;
+    }
+
+    // The subscription may be destroyed from within the handler, so it's not touched afterwards
+    if (installHandler)
+        installHandler(std::move(error));
+}
+
+bool Proxy::SignalMatchInstallToken::takeResult( SignalMatchInstallation& installation
+                                               , signal_match_install_handler& installHandler
+                                               , std::optional<Error>& error )
+{
+    if (installation.pending > 0 || !installation.hasCompleted)
+        return false;
+
+    installation.hasCompleted = false;
+    installHandler = installation.installHandler;
+    error = std::exchange(installation.error, std::nullopt);
+    return true;
+}
+
+Proxy::AsyncCallTrace::AsyncCallTrace(std::shared_ptr<ITracer> tracer, const MethodCall& call)
+    : tracer_(std::move(tracer))
+    , span_(tracer_->onMethodCallSent(call))
+    , call_(call)
+{
+}
+
+Proxy::AsyncCallTrace::AsyncCallTrace(AsyncCallTrace&& other) noexcept
+    : tracer_(std::move(other.tracer_))
+    , span_(std::exchange(other.span_, nullptr))
+    , call_(std::move(other.call_))
+{
+}
+
+Proxy::AsyncCallTrace& Proxy::AsyncCallTrace::operator=(AsyncCallTrace&& other) noexcept
+{
+    if (this != &other)
+    {
+        complete(nullptr);
+        tracer_ = std::move(other.tracer_);
+        span_ = std::exchange(other.span_, nullptr);
+        call_ = std::move(other.call_);
+    }
+    return *this;
+}
+
+Proxy::AsyncCallTrace::~AsyncCallTrace()
+{
+    if (tracer_ == nullptr)
+        return;
+
+    try
+    {
+        const Error cancelled{SDBUSCPP_ERROR_NAME, "Method call cancelled before its reply arrived"};
+        close(&cancelled);
+    }
+    catch (...)
+    {
+        // Not closing the span is the lesser evil than terminating
+    }
+}
+
+void Proxy::AsyncCallTrace::close(const Error* error)
+{
+    std::exchange(tracer_, nullptr)->onMethodCallCompleted(span_, call_, error);
+}
+
 Proxy::FloatingAsyncCallSlots::~FloatingAsyncCallSlots()
 {
     clear();
@@ -291,39 +1124,58 @@ Proxy::FloatingAsyncCallSlots::~FloatingAsyncCallSlots()
 void Proxy::FloatingAsyncCallSlots::push_back(std::shared_ptr<AsyncCallInfo> asyncCallInfo)
 {
     std::lock_guard lock(mutex_);
-    if (!asyncCallInfo->finished) // The call may have finished in the meantime
+    if (asyncCallInfo->finished) // The call may have finished in the meantime
+        return;
+
+    if (!freeIndices_.empty())
+    {
+        asyncCallInfo->registryIndex = freeIndices_.back();
+        freeIndices_.pop_back();
+        slots_[asyncCallInfo->registryIndex] = std::move(asyncCallInfo);
+    }
+    else
+    {
+        asyncCallInfo->registryIndex = slots_.size();
         slots_.emplace_back(std::move(asyncCallInfo));
+    }
 }
 
 void Proxy::FloatingAsyncCallSlots::erase(AsyncCallInfo* info)
 {
     std::unique_lock lock(mutex_);
     info->finished = true;
-    auto it = std::find_if(slots_.begin(), slots_.end(), [info](auto const& entry){ return entry.get() == info; });
-    if (it != slots_.end())
+    const auto index = info->registryIndex;
+    if (index < slots_.size() && slots_[index].get() == info)
     {
-        auto callInfo = std::move(*it);
-        slots_.erase(it);
+        auto callInfo = std::move(slots_[index]);
+        callInfo->registryIndex = NO_REGISTRY_INDEX;
+        freeIndices_.push_back(index);
         lock.unlock();
 
-        // Releasing call slot pointer acquires global sd-bus mutex. We have to perform the release
-        // out of the `mutex_' critical section here, because if the `removeCall` is called by some
-        // thread and at the same time Proxy's async reply handler (which already holds global sd-bus
-        // mutex) is in progress in a different thread, we get double-mutex deadlock.
+        // Releasing the call slot waits for the call's async reply handler if it's in progress in another
+        // thread (which holds global sd-bus mutex then, and may need `mutex_' itself). We have to perform
+        // the release out of the `mutex_' critical section here, otherwise we get double-mutex deadlock.
+        // A call that isn't being dispatched is released without taking any lock (see Connection::releaseAsyncCall).
     }
 }
 
+std::size_t Proxy::FloatingAsyncCallSlots::size() const
+{
+    std::lock_guard lock(mutex_);
+    return slots_.size() - freeIndices_.size();
+}
+
 void Proxy::FloatingAsyncCallSlots::clear()
 {
     std::unique_lock lock(mutex_);
     auto asyncCallSlots = std::move(slots_);
     slots_ = {};
+    freeIndices_ = {};
     lock.unlock();
 
-    // Releasing call slot pointer acquires global sd-bus mutex. We have to perform the release
-    // out of the `mutex_' critical section here, because if the `clear` is called by some thread
-    // and at the same time Proxy's async reply handler (which already holds global sd-bus
-    // mutex) is in progress in a different thread, we get double-mutex deadlock.
+    // Releasing a call slot waits for the call's async reply handler if it's in progress in another
+    // thread, so we have to perform the release out of the `mutex_' critical section here, too. The
+    // other calls are handed over to the event loop thread, which frees them in one batch.
 }
 
 }
@@ -343,9 +1195,10 @@ void PendingAsyncCall::cancel()
         asyncCallInfo->proxy.floatingAsyncCallSlots_.erase(asyncCallInfo);
 
         // At this point, the callData item is being deleted, leading to the release of the
-        // sd-bus slot pointer. This release locks the global sd-bus mutex. If the async
-        // callback is currently being processed, the sd-bus mutex is locked by the event
-        // loop thread, thus access to the callData item is synchronized and thread-safe.
+        // call. The release is lock-free, as the call's sd-bus resources are freed later in the
+        // event loop thread, which doesn't dispatch the reply anymore. Only if the async callback
+        // is currently being processed, the release waits for it, thus access to the callData
+        // item is synchronized and thread-safe.
     }
 }
 
@@ -440,4 +1293,28 @@ std::unique_ptr<sdbus::IProxy> createLightWeightProxy(ServiceName destination, O
     return createProxy(std::move(destination), std::move(objectPath), dont_run_event_loop_thread);
 }
 
+std::unique_ptr<sdbus::IProxy> createDirectChannelProxy( IConnection& busConnection
+                                                       , ServiceName destination
+                                                       , ObjectPath objectPath )
+{
+    static constexpr const char* DIRECT_CHANNEL_INTERFACE_NAME = "org.sdbuscpp.DirectChannel";
+
+    try
+    {
+        UnixFd fd;
+        createProxy(busConnection, destination, objectPath)->callMethod("Open")
+                                                           .onInterface(DIRECT_CHANNEL_INTERFACE_NAME)
+                                                           .storeResultsTo(fd);
+
+        // The connection takes over the descriptor; destination is empty on direct connections
+        auto connection = createDirectBusConnection(fd.release());
+        return createProxy(std::move(connection), ServiceName{}, std::move(objectPath));
+    }
+    catch (const Error&)
+    {
+        // No direct channel to the service, so go through the bus daemon
+        return createProxy(busConnection, std::move(destination), std::move(objectPath));
+    }
+}
+
 }
@@ -32,11 +32,19 @@
 #include "IConnection.h"
 #include "sdbus-c++/Types.h"
 
-#include <deque>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <memory>
+#include <map>
 #include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
 #include SDBUS_HEADER
+#include <unordered_map>
 #include <vector>
 
 namespace sdbus::internal {
@@ -58,8 +66,11 @@ namespace sdbus::internal {
 
         MethodCall createMethodCall(const InterfaceName& interfaceName, const MethodName& methodName) const override;
         MethodCall createMethodCall(const char* interfaceName, const char* methodName) const override;
+        PreparedMethodCall prepareMethodCall(InterfaceName interfaceName, MethodName methodName) const override;
         MethodReply callMethod(const MethodCall& message) override;
         MethodReply callMethod(const MethodCall& message, uint64_t timeout) override;
+        Expected<MethodReply> callMethod(const MethodCall& message, std::nothrow_t) override;
+        Expected<MethodReply> callMethod(const MethodCall& message, uint64_t timeout, std::nothrow_t) override;
         PendingAsyncCall callMethodAsync(const MethodCall& message, async_reply_handler asyncReplyCallback) override;
         Slot callMethodAsync( const MethodCall& message
                             , async_reply_handler asyncReplyCallback
@@ -88,15 +99,56 @@ namespace sdbus::internal {
                                   , const char* signalName
                                   , signal_handler signalHandler
                                   , return_slot_t ) override;
+        void registerSignalHandler( const InterfaceName& interfaceName
+                                  , const SignalName& signalName
+                                  , const std::vector<SignalArgFilter>& argFilters
+                                  , signal_handler signalHandler ) override;
+        void registerSignalHandler( const char* interfaceName
+                                  , const char* signalName
+                                  , const std::vector<SignalArgFilter>& argFilters
+                                  , signal_handler signalHandler ) override;
+        Slot registerSignalHandler( const InterfaceName& interfaceName
+                                  , const SignalName& signalName
+                                  , const std::vector<SignalArgFilter>& argFilters
+                                  , signal_handler signalHandler
+                                  , return_slot_t ) override;
+        Slot registerSignalHandler( const char* interfaceName
+                                  , const char* signalName
+                                  , const std::vector<SignalArgFilter>& argFilters
+                                  , signal_handler signalHandler
+                                  , return_slot_t ) override;
+        void enableSignalMatchAggregation(bool enabled) override;
+        void enableAsyncSignalMatchInstallation(bool enabled, signal_match_install_handler installHandler) override;
+        void enablePropertyCache(bool enabled) override;
         void unregister() override;
 
         [[nodiscard]] sdbus::IConnection& getConnection() const override;
         [[nodiscard]] const ObjectPath& getObjectPath() const override;
         [[nodiscard]] Message getCurrentlyProcessedMessage() const override;
+        void setMaxPendingAsyncCalls(std::size_t maxCount) override;
+        [[nodiscard]] std::size_t getPendingAsyncCallCount() const override;
+        [[nodiscard]] ResourceUsage getResourceUsage() const override;
+
+    protected:
+        [[nodiscard]] std::optional<Variant> getCachedProperty(std::string_view interfaceName, std::string_view propertyName) override;
+        [[nodiscard]] Expected<Message> callMethodWithCachedResults( const MethodCall& message
+                                                                   , PlainMessage& arguments
+                                                                   , uint64_t timeout
+                                                                   , uint64_t ttl ) override;
 
     private:
         static int sdbus_signal_handler(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError);
         static int sdbus_async_reply_handler(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError);
+        static int sdbus_aggregated_signal_handler(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError);
+        static int sdbus_signal_match_install_handler(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError);
+        static int sdbus_aggregated_signal_match_install_handler(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError);
+
+        Slot registerAggregatedSignalHandler(const char* interfaceName, const char* signalName, signal_handler signalHandler);
+        void unregisterAggregatedSignalHandler(const std::string& interfaceName, const std::string& signalName, const void* handlerInfo);
+        void onPropertiesChanged(Signal& signal);
+        void dropPropertyCache();
+        void watchOwnerForMethodResultCache();
+        void dropMethodResultCache();
 
     private:
         friend PendingAsyncCall;
@@ -107,25 +159,174 @@ namespace sdbus::internal {
         ServiceName destination_;
         ObjectPath objectPath_;
 
+        struct StringHash
+        {
+            using is_transparent = void;
+            std::size_t operator()(std::string_view str) const noexcept { return std::hash<std::string_view>{}(str); }
+        };
+
+        struct AggregatedSignalInfo
+        {
+            signal_handler callback;
+        };
+
+        // Match rule installations in progress. Shared with the subscriptions, since a returned slot may outlive the proxy.
+        struct SignalMatchInstallation
+        {
+            std::mutex mutex;
+            std::size_t pending{};
+            bool hasCompleted{}; // Some installation completed since the install handler was last invoked
+            std::optional<Error> error; // First error since the install handler was last invoked
+            signal_match_install_handler installHandler;
+        };
+
+        // Stands for one installation in progress, until the installation completes or the token is destroyed
+        class SignalMatchInstallToken
+        {
+        public:
+            SignalMatchInstallToken() = default;
+            explicit SignalMatchInstallToken(std::shared_ptr<SignalMatchInstallation> installation);
+            SignalMatchInstallToken(SignalMatchInstallToken&& other) noexcept = default;
+            SignalMatchInstallToken& operator=(SignalMatchInstallToken&& other) noexcept;
+            ~SignalMatchInstallToken();
+
+            [[nodiscard]] bool isPending() const { return installation_ != nullptr; }
+            // Completes the installation with the reply to its AddMatch call, invoking the install handler if it was the last one
+            void complete(sd_bus_message* reply);
+
+        private:
+            void release();
+            // Takes the result accumulated since the last invocation if no installation is pending anymore
+            static bool takeResult(SignalMatchInstallation& installation, signal_match_install_handler& installHandler, std::optional<Error>& error);
+
+        private:
+            std::shared_ptr<SignalMatchInstallation> installation_;
+        };
+
+        SignalMatchInstallToken acquireSignalMatchInstallToken();
+
+        // Signal handlers of one interface, served by a single D-Bus match rule and dispatched by member name
+        struct InterfaceSignals : std::enable_shared_from_this<InterfaceSignals>
+        {
+            explicit InterfaceSignals(Proxy& proxy) : proxy(proxy) {}
+
+            Proxy& proxy;
+            std::unordered_map<std::string, std::vector<std::shared_ptr<AggregatedSignalInfo>>, StringHash, std::equal_to<>> handlers;
+            std::size_t dispatchDepth{}; // While handlers are being invoked, removals only null out entries
+            bool hasRemovedHandlers{};
+            SignalMatchInstallToken installToken{}; // Declared before matchSlot, so that it's released after the slot
+            Slot matchSlot{};
+        };
+
+        std::atomic<bool> aggregateSignalMatches_{false};
+        std::atomic<bool> installSignalMatchesAsync_{false};
+        std::shared_ptr<SignalMatchInstallation> signalMatchInstallation_{std::make_shared<SignalMatchInstallation>()};
+        mutable std::recursive_mutex interfaceSignalsMutex_; // Recursive, since signal handlers may (un)register signal handlers
+        std::map<std::string, std::shared_ptr<InterfaceSignals>, std::less<>> interfaceSignals_;
+
+        // Declared after the aggregated signal handler registry, since floating slots unregister from it on destruction
+        mutable std::mutex floatingSignalSlotsMutex_;
         std::vector<Slot> floatingSignalSlots_;
 
+        // Client-side cache of remote properties, per interface. An interface is present once its GetAll has been stored,
+        // and a property invalidated by the remote side is missing until it's fetched again. The generation counts
+        // updates of the cache by signals, so that fetches racing with them don't store stale values.
+        std::atomic<bool> propertyCacheEnabled_{false};
+        mutable std::mutex propertyCacheMutex_;
+        std::uint64_t propertyCacheGeneration_{};
+        std::map<std::string, std::map<std::string, Variant, std::less<>>, std::less<>> propertyCache_;
+        std::vector<Slot> propertyCacheSlots_; // PropertiesChanged and NameOwnerChanged subscriptions
+
+        // Client-side cache of results of methods called with cached results, keyed by interface, method and serialized
+        // arguments. The generation counts drops of the cache, so that calls racing with them don't store stale results.
+        struct CachedMethodResults
+        {
+            PlainMessage results;
+            std::chrono::steady_clock::time_point expiresAt;
+        };
+        mutable std::mutex methodResultCacheMutex_;
+        std::uint64_t methodResultCacheGeneration_{};
+        std::unordered_map<std::string, CachedMethodResults> methodResultCache_;
+        std::once_flag methodResultCacheOwnerWatched_;
+        Slot methodResultCacheSlot_; // NameOwnerChanged subscription, made upon the first call with cached results
+
         struct SignalInfo
         {
             signal_handler callback;
             Proxy& proxy;
+            SignalMatchInstallToken installToken; // Declared before slot, so that it's released after the slot
             Slot slot;
         };
 
+        // Window of in-flight async calls. Shared with the calls, since a returned slot may outlive the proxy.
+        struct AsyncCallWindow
+        {
+            std::atomic<std::size_t> maxSize{}; // 0 means unlimited
+            std::atomic<std::size_t> size{};
+        };
+
+        // Occupies one place in the async call window for the lifetime of the token
+        class AsyncCallWindowToken
+        {
+        public:
+            AsyncCallWindowToken() = default;
+            explicit AsyncCallWindowToken(std::shared_ptr<AsyncCallWindow> window);
+            AsyncCallWindowToken(AsyncCallWindowToken&& other) noexcept = default;
+            AsyncCallWindowToken& operator=(AsyncCallWindowToken&& other) noexcept;
+            ~AsyncCallWindowToken();
+
+        private:
+            std::shared_ptr<AsyncCallWindow> window_;
+        };
+
+        AsyncCallWindowToken acquireAsyncCallWindowToken();
+
+        // Client span of a traced async call. The span is closed when the reply arrives, or on destruction
+        // if the call is cancelled or the proxy is destroyed before that.
+        class AsyncCallTrace
+        {
+        public:
+            AsyncCallTrace() = default;
+            AsyncCallTrace(std::shared_ptr<ITracer> tracer, const MethodCall& call);
+            AsyncCallTrace(AsyncCallTrace&& other) noexcept;
+            AsyncCallTrace& operator=(AsyncCallTrace&& other) noexcept;
+            ~AsyncCallTrace();
+
+            void complete(const Error* error)
+            {
+                if (tracer_ != nullptr)
+                    close(error);
+            }
+
+        private:
+            void close(const Error* error);
+
+        private:
+            std::shared_ptr<ITracer> tracer_; // Kept alive by the span, even if the connection's tracer is replaced
+            void* span_{};
+            MethodCall call_;
+        };
+
+        static constexpr std::size_t NO_REGISTRY_INDEX = std::numeric_limits<std::size_t>::max();
+
         struct AsyncCallInfo
         {
             async_reply_handler callback;
             Proxy& proxy;
+            AsyncCallWindowToken windowToken{}; // Declared before slot, so that it's released after the slot
             Slot slot{};
             bool finished{false};
             bool floating;
+            std::chrono::nanoseconds startTime{}; // Set only when metrics are collected
+            AsyncCallTrace trace{}; // Active only when a tracer is installed
+            std::size_t registryIndex{NO_REGISTRY_INDEX}; // Position in FloatingAsyncCallSlots, guarded by its mutex
         };
 
-        // Container keeping track of pending async calls
+        void sendAsyncCall(AsyncCallInfo& asyncCallInfo, const MethodCall& message, uint64_t timeout);
+
+        // Container keeping track of pending async calls. It's a slab of slots indexed by
+        // AsyncCallInfo::registryIndex, with vacated slots recycled, so both insertion and
+        // removal are O(1) and the critical sections stay short.
         class FloatingAsyncCallSlots
         {
         public:
@@ -133,13 +334,16 @@ namespace sdbus::internal {
             void push_back(std::shared_ptr<AsyncCallInfo> asyncCallInfo);
             void erase(AsyncCallInfo* info);
             void clear();
+            [[nodiscard]] std::size_t size() const;
 
         private:
-            std::mutex mutex_;
-            std::deque<std::shared_ptr<AsyncCallInfo>> slots_;
+            mutable std::mutex mutex_;
+            std::vector<std::shared_ptr<AsyncCallInfo>> slots_;
+            std::vector<std::size_t> freeIndices_;
         };
 
         FloatingAsyncCallSlots floatingAsyncCallSlots_;
+        std::shared_ptr<AsyncCallWindow> asyncCallWindow_{std::make_shared<AsyncCallWindow>()};
     };
 
 }
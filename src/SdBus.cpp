@@ -26,28 +26,43 @@
  */
 
 #include "SdBus.h"
+#include "ScopeGuard.h"
 #include <sdbus-c++/Error.h>
 #include <algorithm>
 
+// Takes the sd-bus lock in a wrapper function, the function being the site the lock profiler attributes the lock times to
+#define SDBUS_LOCK_GUARD                                                               \
+    static const auto SDBUS_LOCK_SITE = LockProfiler::registerSite(__func__);          \
+    ProfiledLockGuard lock(sdbusMutex_, lockProfiler_, SDBUS_LOCK_SITE)                \
+    /**/
+
 namespace sdbus::internal {
 
 sd_bus_message* SdBus::sd_bus_message_ref(sd_bus_message *m)
 {
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
 
     return ::sd_bus_message_ref(m);
 }
 
 sd_bus_message* SdBus::sd_bus_message_unref(sd_bus_message *m)
 {
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
 
     return ::sd_bus_message_unref(m);
 }
 
+void SdBus::sd_bus_message_ref_many(sd_bus_message **m, std::size_t count)
+{
+    SDBUS_LOCK_GUARD;
+
+    for (std::size_t i = 0; i < count; ++i)
+        ::sd_bus_message_ref(m[i]);
+}
+
 int SdBus::sd_bus_send(sd_bus *bus, sd_bus_message *m, uint64_t *cookie)
 {
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
 
     auto r = ::sd_bus_send(bus, m, cookie);
     if (r < 0)
@@ -56,16 +71,30 @@ int SdBus::sd_bus_send(sd_bus *bus, sd_bus_message *m, uint64_t *cookie)
     return r;
 }
 
+int SdBus::sd_bus_send_many(sd_bus *bus, sd_bus_message **m, std::size_t count)
+{
+    SDBUS_LOCK_GUARD;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        auto r = ::sd_bus_send(bus, m[i], nullptr);
+        if (r < 0)
+            return r;
+    }
+
+    return 0;
+}
+
 int SdBus::sd_bus_call(sd_bus *bus, sd_bus_message *m, uint64_t usec, sd_bus_error *ret_error, sd_bus_message **reply)
 {
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
 
     return ::sd_bus_call(bus, m, usec, ret_error, reply);
 }
 
 int SdBus::sd_bus_call_async(sd_bus *bus, sd_bus_slot **slot, sd_bus_message *m, sd_bus_message_handler_t callback, void *userdata, uint64_t usec)
 {
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
 
     auto r = ::sd_bus_call_async(bus, slot, m, callback, userdata, usec);
     if (r < 0)
@@ -74,37 +103,94 @@ int SdBus::sd_bus_call_async(sd_bus *bus, sd_bus_slot **slot, sd_bus_message *m,
     return r;
 }
 
+int SdBus::sd_bus_call_async_get_n_queued(sd_bus *bus, sd_bus_slot **slot, sd_bus_message *m, sd_bus_message_handler_t callback, void *userdata, uint64_t usec, sd_bus_message **call, uint64_t *queued)
+{
+    SDBUS_LOCK_GUARD;
+
+    auto r = ::sd_bus_call_async(bus, slot, m, callback, userdata, usec);
+    if (r < 0)
+        return r;
+
+    if (call != nullptr)
+        *call = ::sd_bus_message_ref(m);
+
+    // The call has been made already, so a failure to get the queue sizes must not fail it. It's reported as
+    // queued messages instead, which costs at most a spurious event loop wakeup.
+    if (bus == nullptr)
+        bus = ::sd_bus_message_get_bus(m);
+    uint64_t read{};
+    uint64_t write{};
+    if (::sd_bus_get_n_queued_read(bus, &read) < 0 || ::sd_bus_get_n_queued_write(bus, &write) < 0)
+        *queued = 1;
+    else
+        *queued = read + write;
+
+    return r;
+}
+
+int SdBus::sd_bus_call_async_many(sd_bus *bus, sd_bus_slot **slots, sd_bus_message **m, sd_bus_message_handler_t callback, void **userdata, uint64_t usec, std::size_t count, sd_bus_message **calls, uint64_t *queued)
+{
+    SDBUS_LOCK_GUARD;
+
+    int r{};
+    std::size_t made{};
+    for (; made < count; ++made)
+    {
+        r = ::sd_bus_call_async(bus, &slots[made], m[made], callback, userdata[made], usec);
+        if (r < 0)
+            break;
+
+        if (calls != nullptr)
+            calls[made] = ::sd_bus_message_ref(m[made]);
+    }
+
+    // The calls made must not be failed by a failure to get the queue sizes, just like in sd_bus_call_async_get_n_queued()
+    if (made > 0)
+    {
+        if (bus == nullptr)
+            bus = ::sd_bus_message_get_bus(m[0]);
+        uint64_t read{};
+        uint64_t write{};
+        if (::sd_bus_get_n_queued_read(bus, &read) < 0 || ::sd_bus_get_n_queued_write(bus, &write) < 0)
+            *queued = 1;
+        else
+            *queued = read + write;
+    }
+
+    return r;
+}
+
 int SdBus::sd_bus_message_new(sd_bus *bus, sd_bus_message **m, uint8_t type)
 {
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
 
     return ::sd_bus_message_new(bus, m, type);
 }
 
 int SdBus::sd_bus_message_new_method_call(sd_bus *bus, sd_bus_message **m, const char *destination, const char *path, const char *interface, const char *member)
 {
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
 
     return ::sd_bus_message_new_method_call(bus, m, destination, path, interface, member);
 }
 
 int SdBus::sd_bus_message_new_signal(sd_bus *bus, sd_bus_message **m, const char *path, const char *interface, const char *member)
 {
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
 
     return ::sd_bus_message_new_signal(bus, m, path, interface, member);
 }
 
 int SdBus::sd_bus_message_new_method_return(sd_bus_message *call, sd_bus_message **m)
 {
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
 
     return ::sd_bus_message_new_method_return(call, m);
 }
 
 int SdBus::sd_bus_message_new_method_error(sd_bus_message *call, sd_bus_message **m, const sd_bus_error *e)
 {
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
 
     return ::sd_bus_message_new_method_error(call, m, e);
 }
@@ -112,7 +198,7 @@ int SdBus::sd_bus_message_new_method_error(sd_bus_message *call, sd_bus_message
 int SdBus::sd_bus_set_method_call_timeout(sd_bus *bus, uint64_t usec)
 {
 #if LIBSYSTEMD_VERSION>=240
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
 
     return ::sd_bus_set_method_call_timeout(bus, usec);
 #else
@@ -125,7 +211,7 @@ int SdBus::sd_bus_set_method_call_timeout(sd_bus *bus, uint64_t usec)
 int SdBus::sd_bus_get_method_call_timeout(sd_bus *bus, uint64_t *ret)
 {
 #if LIBSYSTEMD_VERSION>=240
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
 
     return ::sd_bus_get_method_call_timeout(bus, ret);
 #else
@@ -137,39 +223,74 @@ int SdBus::sd_bus_get_method_call_timeout(sd_bus *bus, uint64_t *ret)
 
 int SdBus::sd_bus_emit_properties_changed_strv(sd_bus *bus, const char *path, const char *interface, char **names)
 {
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
 
     return ::sd_bus_emit_properties_changed_strv(bus, path, interface, names);
 }
 
 int SdBus::sd_bus_emit_object_added(sd_bus *bus, const char *path)
 {
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
 
     return ::sd_bus_emit_object_added(bus, path);
 }
 
 int SdBus::sd_bus_emit_object_removed(sd_bus *bus, const char *path)
 {
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
 
     return ::sd_bus_emit_object_removed(bus, path);
 }
 
 int SdBus::sd_bus_emit_interfaces_added_strv(sd_bus *bus, const char *path, char **interfaces)
 {
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
 
     return ::sd_bus_emit_interfaces_added_strv(bus, path, interfaces);
 }
 
 int SdBus::sd_bus_emit_interfaces_removed_strv(sd_bus *bus, const char *path, char **interfaces)
 {
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
 
     return ::sd_bus_emit_interfaces_removed_strv(bus, path, interfaces);
 }
 
+int SdBus::sd_bus_add_objects(sd_bus *bus, const ObjectVTable *vtables, sd_bus_slot **slots, std::size_t count, const char **paths, char ***interfaces, std::size_t pathCount)
+{
+    SDBUS_LOCK_GUARD;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        auto r = ::sd_bus_add_object_vtable(bus, &slots[i], vtables[i].path, vtables[i].interface, vtables[i].vtable, vtables[i].userdata);
+        if (r < 0)
+            return r;
+    }
+
+    for (std::size_t i = 0; i < pathCount; ++i)
+    {
+        auto r = ::sd_bus_emit_interfaces_added_strv(bus, paths[i], interfaces[i]);
+        if (r < 0)
+            return r;
+    }
+
+    return 0;
+}
+
+int SdBus::sd_bus_remove_objects(sd_bus *bus, const char *const *paths, std::size_t pathCount, sd_bus_slot *const *slots, std::size_t count)
+{
+    SDBUS_LOCK_GUARD;
+
+    int result{};
+    for (std::size_t i = 0; i < pathCount && result >= 0; ++i)
+        result = ::sd_bus_emit_object_removed(bus, paths[i]);
+
+    for (std::size_t i = 0; i < count; ++i)
+        ::sd_bus_slot_unref(slots[i]);
+
+    return result;
+}
+
 int SdBus::sd_bus_open(sd_bus **ret)
 {
     return ::sd_bus_open(ret);
@@ -303,66 +424,118 @@ int SdBus::sd_bus_open_system_remote(sd_bus **ret, const char *host)
 
 int SdBus::sd_bus_request_name(sd_bus *bus, const char *name, uint64_t flags)
 {
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
 
     return ::sd_bus_request_name(bus, name, flags);
 }
 
 int SdBus::sd_bus_release_name(sd_bus *bus, const char *name)
 {
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
 
     return ::sd_bus_release_name(bus, name);
 }
 
 int SdBus::sd_bus_get_unique_name(sd_bus *bus, const char **name)
 {
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
     return ::sd_bus_get_unique_name(bus, name);
 }
 
+int SdBus::sd_bus_is_trusted(sd_bus *bus)
+{
+    SDBUS_LOCK_GUARD;
+    return ::sd_bus_is_trusted(bus);
+}
+
 int SdBus::sd_bus_add_object_vtable(sd_bus *bus, sd_bus_slot **slot, const char *path, const char *interface, const sd_bus_vtable *vtable, void *userdata)
 {
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
 
     return ::sd_bus_add_object_vtable(bus, slot, path, interface,  vtable, userdata);
 }
 
+int SdBus::sd_bus_add_fallback_vtable(sd_bus *bus, sd_bus_slot **slot, const char *prefix, const char *interface, const sd_bus_vtable *vtable, sd_bus_object_find_t find, void *userdata)
+{
+    SDBUS_LOCK_GUARD;
+
+    return ::sd_bus_add_fallback_vtable(bus, slot, prefix, interface, vtable, find, userdata);
+}
+
+int SdBus::sd_bus_add_node_enumerator(sd_bus *bus, sd_bus_slot **slot, const char *path, sd_bus_node_enumerator_t callback, void *userdata)
+{
+    SDBUS_LOCK_GUARD;
+
+    return ::sd_bus_add_node_enumerator(bus, slot, path, callback, userdata);
+}
+
+int SdBus::sd_bus_add_fallback(sd_bus *bus, sd_bus_slot **slot, const char *prefix, sd_bus_message_handler_t callback, void *userdata)
+{
+    SDBUS_LOCK_GUARD;
+
+    return ::sd_bus_add_fallback(bus, slot, prefix, callback, userdata);
+}
+
 int SdBus::sd_bus_add_object_manager(sd_bus *bus, sd_bus_slot **slot, const char *path)
 {
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
 
     return ::sd_bus_add_object_manager(bus, slot, path);
 }
 
 int SdBus::sd_bus_add_match(sd_bus *bus, sd_bus_slot **slot, const char *match, sd_bus_message_handler_t callback, void *userdata)
 {
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
 
     return ::sd_bus_add_match(bus, slot, match, callback, userdata);
 }
 
 int SdBus::sd_bus_add_match_async(sd_bus *bus, sd_bus_slot **slot, const char *match, sd_bus_message_handler_t callback, sd_bus_message_handler_t install_callback, void *userdata)
 {
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
 
     return ::sd_bus_add_match_async(bus, slot, match, callback, install_callback, userdata);
 }
 
+int SdBus::sd_bus_add_filter(sd_bus *bus, sd_bus_slot **slot, sd_bus_message_handler_t callback, void *userdata)
+{
+    SDBUS_LOCK_GUARD;
+
+    return ::sd_bus_add_filter(bus, slot, callback, userdata);
+}
+
 int SdBus::sd_bus_match_signal(sd_bus *bus, sd_bus_slot **ret, const char *sender, const char *path, const char *interface, const char *member, sd_bus_message_handler_t callback, void *userdata)
 {
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
 
     return ::sd_bus_match_signal(bus, ret, sender, path, interface, member, callback, userdata);
 }
 
+int SdBus::sd_bus_match_signal_async(sd_bus *bus, sd_bus_slot **ret, const char *sender, const char *path, const char *interface, const char *member, sd_bus_message_handler_t callback, sd_bus_message_handler_t install_callback, void *userdata)
+{
+    SDBUS_LOCK_GUARD;
+
+    return ::sd_bus_match_signal_async(bus, ret, sender, path, interface, member, callback, install_callback, userdata);
+}
+
 sd_bus_slot* SdBus::sd_bus_slot_unref(sd_bus_slot *slot)
 {
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
 
     return ::sd_bus_slot_unref(slot);
 }
 
+void SdBus::sd_bus_unref_many(sd_bus_slot **slots, sd_bus_message **messages, std::size_t count)
+{
+    SDBUS_LOCK_GUARD;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        ::sd_bus_slot_unref(slots[i]);
+        ::sd_bus_message_unref(messages[i]);
+    }
+}
+
 int SdBus::sd_bus_new(sd_bus **ret)
 {
     return ::sd_bus_new(ret);
@@ -375,11 +548,27 @@ int SdBus::sd_bus_start(sd_bus *bus)
 
 int SdBus::sd_bus_process(sd_bus *bus, sd_bus_message **r)
 {
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
+    auto previousProcessingThread = processingThread_.exchange(std::this_thread::get_id(), std::memory_order_relaxed);
+    SCOPE_EXIT{ processingThread_.store(previousProcessingThread, std::memory_order_relaxed); };
 
     return ::sd_bus_process(bus, r);
 }
 
+int SdBus::sd_bus_process_locally(sd_bus */*bus*/, const std::function<int()>& callback)
+{
+    SDBUS_LOCK_GUARD;
+    auto previousProcessingThread = processingThread_.exchange(std::this_thread::get_id(), std::memory_order_relaxed);
+    SCOPE_EXIT{ processingThread_.store(previousProcessingThread, std::memory_order_relaxed); };
+
+    return callback();
+}
+
+bool SdBus::isProcessingInCurrentThread() const
+{
+    return processingThread_.load(std::memory_order_relaxed) == std::this_thread::get_id();
+}
+
 sd_bus_message* SdBus::sd_bus_get_current_message(sd_bus *bus)
 {
     return ::sd_bus_get_current_message(bus);
@@ -387,7 +576,7 @@ sd_bus_message* SdBus::sd_bus_get_current_message(sd_bus *bus)
 
 int SdBus::sd_bus_get_poll_data(sd_bus *bus, PollData* data)
 {
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
 
     auto r = ::sd_bus_get_fd(bus);
     if (r < 0)
@@ -406,7 +595,7 @@ int SdBus::sd_bus_get_poll_data(sd_bus *bus, PollData* data)
 
 int SdBus::sd_bus_get_n_queued(sd_bus *bus, uint64_t *read, uint64_t* write)
 {
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
 
     auto r1 = ::sd_bus_get_n_queued_read(bus, read);
     auto r2 = ::sd_bus_get_n_queued_write(bus, write);
@@ -436,79 +625,97 @@ sd_bus* SdBus::sd_bus_close_unref(sd_bus *bus)
 
 int SdBus::sd_bus_message_set_destination(sd_bus_message *m, const char *destination)
 {
-    std::lock_guard lock(sdbusMutex_);
-
     return ::sd_bus_message_set_destination(m, destination);
 }
 
+const char* SdBus::sd_bus_message_get_sender(sd_bus_message *m)
+{
+    return ::sd_bus_message_get_sender(m);
+}
+
+int SdBus::sd_bus_message_set_sender(sd_bus_message *m, const char *sender)
+{
+    SDBUS_LOCK_GUARD;
+
+    return ::sd_bus_message_set_sender(m, sender);
+}
+
+int SdBus::sd_bus_message_seal(sd_bus_message *m, uint64_t cookie, uint64_t timeout_usec)
+{
+    SDBUS_LOCK_GUARD;
+
+    return ::sd_bus_message_seal(m, cookie, timeout_usec);
+}
+
 int SdBus::sd_bus_query_sender_creds(sd_bus_message *m, uint64_t mask, sd_bus_creds **c)
 {
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
 
     return ::sd_bus_query_sender_creds(m, mask, c);
 }
 
 sd_bus_creds* SdBus::sd_bus_creds_ref(sd_bus_creds *c)
 {
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
 
     return ::sd_bus_creds_ref(c);
 }
 
 sd_bus_creds* SdBus::sd_bus_creds_unref(sd_bus_creds *c)
 {
-    std::lock_guard lock(sdbusMutex_);
+    SDBUS_LOCK_GUARD;
 
     return ::sd_bus_creds_unref(c);
 }
 
 int SdBus::sd_bus_creds_get_pid(sd_bus_creds *c, pid_t *pid)
 {
-    std::lock_guard lock(sdbusMutex_);
-
     return ::sd_bus_creds_get_pid(c, pid);
 }
 
 int SdBus::sd_bus_creds_get_uid(sd_bus_creds *c, uid_t *uid)
 {
-    std::lock_guard lock(sdbusMutex_);
-
     return ::sd_bus_creds_get_uid(c, uid);
 }
 
 int SdBus::sd_bus_creds_get_euid(sd_bus_creds *c, uid_t *euid)
 {
-    std::lock_guard lock(sdbusMutex_);
-
     return ::sd_bus_creds_get_euid(c, euid);
 }
 
 int SdBus::sd_bus_creds_get_gid(sd_bus_creds *c, gid_t *gid)
 {
-    std::lock_guard lock(sdbusMutex_);
-
     return ::sd_bus_creds_get_gid(c, gid);
 }
 
 int SdBus::sd_bus_creds_get_egid(sd_bus_creds *c, uid_t *egid)
 {
-    std::lock_guard lock(sdbusMutex_);
-
     return ::sd_bus_creds_get_egid(c, egid);
 }
 
 int SdBus::sd_bus_creds_get_supplementary_gids(sd_bus_creds *c, const gid_t **gids)
 {
-    std::lock_guard lock(sdbusMutex_);
-
     return ::sd_bus_creds_get_supplementary_gids(c, gids);
 }
 
 int SdBus::sd_bus_creds_get_selinux_context(sd_bus_creds *c, const char **label)
 {
-    std::lock_guard lock(sdbusMutex_);
-
     return ::sd_bus_creds_get_selinux_context(c, label);
 }
 
+void SdBus::enableLockProfiling(bool enabled, uint32_t samplingInterval)
+{
+    lockProfiler_.enable(enabled, samplingInterval);
+}
+
+std::vector<::sdbus::IConnection::Metrics::BusLockProfile> SdBus::getLockProfiles() const
+{
+    return lockProfiler_.getProfiles();
+}
+
+void SdBus::resetLockProfiles()
+{
+    lockProfiler_.reset();
+}
+
 }
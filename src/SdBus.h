@@ -29,7 +29,10 @@
 #define SDBUS_CXX_SDBUS_H
 
 #include "ISdBus.h"
+#include "LockProfiler.h"
+#include <atomic>
 #include <mutex>
+#include <thread>
 
 namespace sdbus::internal {
 
@@ -38,10 +41,14 @@ class SdBus final : public ISdBus
 public:
     virtual sd_bus_message* sd_bus_message_ref(sd_bus_message *m) override;
     virtual sd_bus_message* sd_bus_message_unref(sd_bus_message *m) override;
+    virtual void sd_bus_message_ref_many(sd_bus_message **m, std::size_t count) override;
 
     virtual int sd_bus_send(sd_bus *bus, sd_bus_message *m, uint64_t *cookie) override;
+    virtual int sd_bus_send_many(sd_bus *bus, sd_bus_message **m, std::size_t count) override;
     virtual int sd_bus_call(sd_bus *bus, sd_bus_message *m, uint64_t usec, sd_bus_error *ret_error, sd_bus_message **reply) override;
     virtual int sd_bus_call_async(sd_bus *bus, sd_bus_slot **slot, sd_bus_message *m, sd_bus_message_handler_t callback, void *userdata, uint64_t usec) override;
+    virtual int sd_bus_call_async_get_n_queued(sd_bus *bus, sd_bus_slot **slot, sd_bus_message *m, sd_bus_message_handler_t callback, void *userdata, uint64_t usec, sd_bus_message **call, uint64_t *queued) override;
+    virtual int sd_bus_call_async_many(sd_bus *bus, sd_bus_slot **slots, sd_bus_message **m, sd_bus_message_handler_t callback, void **userdata, uint64_t usec, std::size_t count, sd_bus_message **calls, uint64_t *queued) override;
 
     virtual int sd_bus_message_new(sd_bus *bus, sd_bus_message **m, uint8_t type) override;
     virtual int sd_bus_message_new_method_call(sd_bus *bus, sd_bus_message **m, const char *destination, const char *path, const char *interface, const char *member) override;
@@ -57,6 +64,8 @@ public:
     virtual int sd_bus_emit_object_removed(sd_bus *bus, const char *path) override;
     virtual int sd_bus_emit_interfaces_added_strv(sd_bus *bus, const char *path, char **interfaces) override;
     virtual int sd_bus_emit_interfaces_removed_strv(sd_bus *bus, const char *path, char **interfaces) override;
+    virtual int sd_bus_add_objects(sd_bus *bus, const ObjectVTable *vtables, sd_bus_slot **slots, std::size_t count, const char **paths, char ***interfaces, std::size_t pathCount) override;
+    virtual int sd_bus_remove_objects(sd_bus *bus, const char *const *paths, std::size_t pathCount, sd_bus_slot *const *slots, std::size_t count) override;
 
     virtual int sd_bus_open(sd_bus **ret) override;
     virtual int sd_bus_open_system(sd_bus **ret) override;
@@ -69,17 +78,26 @@ public:
     virtual int sd_bus_request_name(sd_bus *bus, const char *name, uint64_t flags) override;
     virtual int sd_bus_release_name(sd_bus *bus, const char *name) override;
     virtual int sd_bus_get_unique_name(sd_bus *bus, const char **name) override;
+    virtual int sd_bus_is_trusted(sd_bus *bus) override;
     virtual int sd_bus_add_object_vtable(sd_bus *bus, sd_bus_slot **slot, const char *path, const char *interface, const sd_bus_vtable *vtable, void *userdata) override;
+    virtual int sd_bus_add_fallback_vtable(sd_bus *bus, sd_bus_slot **slot, const char *prefix, const char *interface, const sd_bus_vtable *vtable, sd_bus_object_find_t find, void *userdata) override;
+    virtual int sd_bus_add_node_enumerator(sd_bus *bus, sd_bus_slot **slot, const char *path, sd_bus_node_enumerator_t callback, void *userdata) override;
+    virtual int sd_bus_add_fallback(sd_bus *bus, sd_bus_slot **slot, const char *prefix, sd_bus_message_handler_t callback, void *userdata) override;
     virtual int sd_bus_add_object_manager(sd_bus *bus, sd_bus_slot **slot, const char *path) override;
     virtual int sd_bus_add_match(sd_bus *bus, sd_bus_slot **slot, const char *match, sd_bus_message_handler_t callback, void *userdata) override;
     virtual int sd_bus_add_match_async(sd_bus *bus, sd_bus_slot **slot, const char *match, sd_bus_message_handler_t callback, sd_bus_message_handler_t install_callback, void *userdata) override;
+    virtual int sd_bus_add_filter(sd_bus *bus, sd_bus_slot **slot, sd_bus_message_handler_t callback, void *userdata) override;
     virtual int sd_bus_match_signal(sd_bus *bus, sd_bus_slot **ret, const char *sender, const char *path, const char *interface, const char *member, sd_bus_message_handler_t callback, void *userdata) override;
+    virtual int sd_bus_match_signal_async(sd_bus *bus, sd_bus_slot **ret, const char *sender, const char *path, const char *interface, const char *member, sd_bus_message_handler_t callback, sd_bus_message_handler_t install_callback, void *userdata) override;
     virtual sd_bus_slot* sd_bus_slot_unref(sd_bus_slot *slot) override;
+    virtual void sd_bus_unref_many(sd_bus_slot **slots, sd_bus_message **messages, std::size_t count) override;
 
     virtual int sd_bus_new(sd_bus **ret) override;
     virtual int sd_bus_start(sd_bus *bus) override;
 
     virtual int sd_bus_process(sd_bus *bus, sd_bus_message **r) override;
+    virtual int sd_bus_process_locally(sd_bus *bus, const std::function<int()>& callback) override;
+    virtual bool isProcessingInCurrentThread() const override;
     virtual sd_bus_message* sd_bus_get_current_message(sd_bus *bus) override;
     virtual int sd_bus_get_poll_data(sd_bus *bus, PollData* data) override;
     virtual int sd_bus_get_n_queued(sd_bus *bus, uint64_t *read, uint64_t* write) override;
@@ -88,6 +106,9 @@ public:
     virtual sd_bus *sd_bus_close_unref(sd_bus *bus) override;
 
     virtual int sd_bus_message_set_destination(sd_bus_message *m, const char *destination) override;
+    virtual const char* sd_bus_message_get_sender(sd_bus_message *m) override;
+    virtual int sd_bus_message_set_sender(sd_bus_message *m, const char *sender) override;
+    virtual int sd_bus_message_seal(sd_bus_message *m, uint64_t cookie, uint64_t timeout_usec) override;
 
     virtual int sd_bus_query_sender_creds(sd_bus_message *m, uint64_t mask, sd_bus_creds **c) override;
     virtual sd_bus_creds* sd_bus_creds_ref(sd_bus_creds *c) override;
@@ -101,8 +122,18 @@ public:
     virtual int sd_bus_creds_get_supplementary_gids(sd_bus_creds *c, const gid_t **gids) override;
     virtual int sd_bus_creds_get_selinux_context(sd_bus_creds *c, const char **label) override;
 
+    virtual void enableLockProfiling(bool enabled, uint32_t samplingInterval) override;
+    virtual std::vector<::sdbus::IConnection::Metrics::BusLockProfile> getLockProfiles() const override;
+    virtual void resetLockProfiles() override;
+
 private:
+    // Each connection owns its SdBus instance, so this is effectively a per-bus lock. It guards all calls
+    // touching the sd_bus state, including its non-atomic reference count, which is also modified when
+    // messages bound to the bus are created or released. Calls that only read or modify data of a message
+    // or creds object that is not shared with the bus (e.g. creds getters) run without taking the lock.
     std::recursive_mutex sdbusMutex_;
+    LockProfiler lockProfiler_;
+    std::atomic<std::thread::id> processingThread_{}; // Only ever set to its own id by the thread holding the lock
 };
 
 }
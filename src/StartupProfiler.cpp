@@ -0,0 +1,78 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file StartupProfiler.cpp
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StartupProfiler.h"
+
+namespace sdbus::internal {
+
+void StartupProfiler::record(StartupPhase phase, std::string_view objectPath, std::chrono::nanoseconds duration)
+{
+    std::lock_guard lock(mutex_);
+
+    auto& phaseProfile = phases_[static_cast<std::size_t>(phase)];
+    phaseProfile.count++;
+    phaseProfile.duration += duration;
+
+    if (objectPath.empty() || (phase != StartupPhase::VTablePreparation && phase != StartupPhase::VTableRegistration))
+        return;
+
+    auto it = objects_.find(objectPath);
+    if (it == objects_.end())
+        it = objects_.emplace(std::string{objectPath}, StartupProfile::ObjectProfile{std::string{objectPath}}).first;
+
+    auto& objectProfile = it->second;
+    if (phase == StartupPhase::VTablePreparation)
+    {
+        objectProfile.vtables++;
+        objectProfile.vtablePreparationDuration += duration;
+    }
+    else
+    {
+        objectProfile.vtableRegistrationDuration += duration;
+    }
+}
+
+StartupProfiler::StartupProfile StartupProfiler::getProfile() const
+{
+    StartupProfile profile;
+
+    std::lock_guard lock(mutex_);
+
+    profile.phases.reserve(phases_.size());
+    for (std::size_t i = 0; i < phases_.size(); ++i)
+    {
+        profile.phases.push_back(phases_[i]);
+        profile.phases.back().phase = static_cast<StartupPhase>(i);
+    }
+
+    profile.objects.reserve(objects_.size());
+    for (const auto& [objectPath, objectProfile] : objects_)
+        profile.objects.push_back(objectProfile);
+
+    return profile;
+}
+
+}
@@ -0,0 +1,135 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file ThreadPolicy.cpp
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ThreadPolicy.h"
+
+#include "sdbus-c++/Error.h"
+
+#include <future>
+#include <mutex>
+#include <pthread.h>
+#include <sched.h>
+#include <utility>
+
+namespace sdbus::internal {
+
+namespace {
+
+    struct ThreadCreationPolicy
+    {
+        std::mutex mutex;
+        thread_creation_policy_t callback;
+    };
+
+    ThreadCreationPolicy& getThreadCreationPolicy()
+    {
+        static ThreadCreationPolicy policy;
+        return policy;
+    }
+
+    // Returns 0 on success, or the error number of the first attribute that failed to apply
+    int applyThreadAttributes(pthread_t thread, const ThreadAttributes& attributes)
+    {
+        if (!attributes.name.empty())
+        {
+            // Linux limits thread names to 16 bytes including the terminating null
+            const auto name = attributes.name.substr(0, 15);
+            if (auto r = pthread_setname_np(thread, name.c_str()); r != 0)
+                return r;
+        }
+
+        if (!attributes.cpuAffinity.empty())
+        {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            for (auto cpu : attributes.cpuAffinity)
+            {
+                if (cpu >= CPU_SETSIZE)
+                    return EINVAL;
+                CPU_SET(cpu, &cpus);
+            }
+            if (auto r = pthread_setaffinity_np(thread, sizeof(cpus), &cpus); r != 0)
+                return r;
+        }
+
+        if (attributes.schedulingPolicy)
+        {
+            sched_param param{};
+            param.sched_priority = attributes.schedulingPriority;
+            if (auto r = pthread_setschedparam(thread, *attributes.schedulingPolicy, &param); r != 0)
+                return r;
+        }
+
+        return 0;
+    }
+
+}
+
+std::thread startThread(ThreadRole role, std::function<void()> function)
+{
+    thread_creation_policy_t policy;
+    {
+        auto& threadCreationPolicy = getThreadCreationPolicy();
+        std::lock_guard lock(threadCreationPolicy.mutex);
+        policy = threadCreationPolicy.callback;
+    }
+
+    if (!policy)
+        return std::thread(std::move(function));
+
+    const auto attributes = policy(role);
+
+    // The thread waits until its attributes are applied, so that it doesn't do any work with the inherited ones
+    std::promise<bool> start;
+    std::thread thread([function = std::move(function), started = start.get_future()]() mutable
+    {
+        if (started.get())
+            function();
+    });
+
+    auto r = applyThreadAttributes(thread.native_handle(), attributes);
+    start.set_value(r == 0);
+    if (r != 0)
+    {
+        thread.join();
+        SDBUS_THROW_ERROR("Failed to apply attributes to a new thread", r);
+    }
+
+    return thread;
+}
+
+}
+
+namespace sdbus {
+
+void setThreadCreationPolicy(thread_creation_policy_t policy)
+{
+    auto& threadCreationPolicy = internal::getThreadCreationPolicy();
+    std::lock_guard lock(threadCreationPolicy.mutex);
+    threadCreationPolicy.callback = std::move(policy);
+}
+
+}
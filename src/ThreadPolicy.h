@@ -0,0 +1,44 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file ThreadPolicy.h
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_INTERNAL_THREADPOLICY_H_
+#define SDBUS_CXX_INTERNAL_THREADPOLICY_H_
+
+#include "sdbus-c++/IConnection.h"
+
+#include <functional>
+#include <thread>
+
+namespace sdbus::internal {
+
+    // Starts a thread running the function. If a thread creation policy is set, the attributes it gives
+    // for the role are applied before the function is entered. If they can't be applied, the function
+    // isn't run at all, and sdbus::Error is thrown once the thread has been joined.
+    std::thread startThread(ThreadRole role, std::function<void()> function);
+
+}
+
+#endif /* SDBUS_CXX_INTERNAL_THREADPOLICY_H_ */
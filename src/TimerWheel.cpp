@@ -0,0 +1,206 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file TimerWheel.cpp
+ *
+ * Created on: Oct 14, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TimerWheel.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <limits>
+
+namespace sdbus::internal {
+
+void TimerWheel::TimerList::pushBack(Timer& timer) noexcept
+{
+    timer.prev = head.prev;
+    timer.next = &head;
+    head.prev->next = &timer;
+    head.prev = &timer;
+}
+
+void TimerWheel::TimerList::unlink(Timer& timer) noexcept
+{
+    timer.prev->next = timer.next;
+    timer.next->prev = timer.prev;
+    timer.prev = timer.next = nullptr;
+}
+
+TimerWheel::TimerWheel(std::chrono::nanoseconds now, std::chrono::nanoseconds resolution)
+    : resolution_(resolution)
+    , currentTick_(static_cast<std::uint64_t>(now / resolution))
+{
+    assert(resolution.count() > 0);
+}
+
+void TimerWheel::schedule(Timer& timer, std::chrono::nanoseconds deadline) noexcept
+{
+    cancel(timer);
+
+    timer.deadline = deadline;
+    place(timer);
+    ++size_;
+}
+
+void TimerWheel::cancel(Timer& timer) noexcept
+{
+    if (!timer.isScheduled())
+        return;
+
+    // Clearing the occupancy bit of a slot is left to the wheel advancement, so cancellation stays O(1)
+    TimerList::unlink(timer);
+    --size_;
+}
+
+void TimerWheel::advance(std::chrono::nanoseconds now) noexcept
+{
+    const auto targetTick = static_cast<std::uint64_t>(now / resolution_);
+
+    while (currentTick_ < targetTick)
+    {
+        // Jump over ticks with nothing to expire or redistribute
+        currentTick_ = std::min(nextEventTick(), targetTick);
+
+        // Redistribute timers from upper levels whose slot is due now, starting with the uppermost level
+        for (auto level = LEVEL_COUNT - 1; level > 0; --level)
+        {
+            const auto levelTickMask = (std::uint64_t{1} << (LEVEL_BITS * level)) - 1;
+            if ((currentTick_ & levelTickMask) == 0)
+                cascade(level);
+        }
+
+        expireCurrentSlot();
+    }
+}
+
+TimerWheel::Timer* TimerWheel::popExpired() noexcept
+{
+    if (expired_.empty())
+        return nullptr;
+
+    auto* timer = expired_.head.next;
+    TimerList::unlink(*timer);
+    --size_;
+
+    return timer;
+}
+
+std::chrono::nanoseconds TimerWheel::nextDeadline() const noexcept
+{
+    if (!expired_.empty())
+        return std::chrono::nanoseconds::zero();
+
+    const auto tick = nextEventTick();
+    if (tick == std::numeric_limits<std::uint64_t>::max())
+        return std::chrono::nanoseconds::max();
+
+    return static_cast<std::int64_t>(tick) * resolution_;
+}
+
+std::uint64_t TimerWheel::toTick(std::chrono::nanoseconds deadline) const noexcept
+{
+    // Round up, so that the timer doesn't expire before its deadline
+    if (deadline.count() <= 0)
+        return 0;
+    return static_cast<std::uint64_t>((deadline.count() + resolution_.count() - 1) / resolution_.count());
+}
+
+std::uint64_t TimerWheel::nextEventTick() const noexcept
+{
+    auto tick = std::numeric_limits<std::uint64_t>::max();
+
+    // The nearest non-empty slot of the lowest level, within the next SLOT_COUNT ticks
+    if (occupiedSlots_[0] != 0)
+    {
+        const auto nextSlot = static_cast<int>((currentTick_ + 1) % SLOT_COUNT);
+        const auto distance = std::countr_zero(std::rotr(occupiedSlots_[0], nextSlot));
+        tick = currentTick_ + 1 + static_cast<std::uint64_t>(distance);
+    }
+
+    // The nearest redistribution of a non-empty upper level
+    for (std::size_t level = 1; level < LEVEL_COUNT; ++level)
+    {
+        if (occupiedSlots_[level] == 0)
+            continue;
+        const auto levelShift = LEVEL_BITS * level;
+        const auto boundaryTick = ((currentTick_ >> levelShift) + 1) << levelShift;
+        tick = std::min(tick, boundaryTick);
+    }
+
+    return tick;
+}
+
+void TimerWheel::place(Timer& timer) noexcept
+{
+    auto tick = toTick(timer.deadline);
+    if (tick <= currentTick_)
+    {
+        expired_.pushBack(timer);
+        return;
+    }
+
+    // Find the lowest level that reaches out to the deadline. Deadlines beyond the span of the wheel
+    // are parked in the farthest slot of the uppermost level, to be redistributed again from there.
+    const auto maxDelta = (std::uint64_t{1} << (LEVEL_BITS * LEVEL_COUNT)) - 1;
+    tick = std::min(tick, currentTick_ + maxDelta);
+    const auto delta = tick - currentTick_;
+    std::size_t level = 0;
+    while (level < LEVEL_COUNT - 1 && delta >= (std::uint64_t{1} << (LEVEL_BITS * (level + 1))))
+        ++level;
+
+    const auto slot = (tick >> (LEVEL_BITS * level)) % SLOT_COUNT;
+    slots_[level][slot].pushBack(timer);
+    occupiedSlots_[level] |= std::uint64_t{1} << slot;
+}
+
+void TimerWheel::cascade(std::size_t level) noexcept
+{
+    const auto slot = (currentTick_ >> (LEVEL_BITS * level)) % SLOT_COUNT;
+    auto& timers = slots_[level][slot];
+    occupiedSlots_[level] &= ~(std::uint64_t{1} << slot);
+
+    while (!timers.empty())
+    {
+        auto& timer = *timers.head.next;
+        TimerList::unlink(timer);
+        place(timer);
+    }
+}
+
+void TimerWheel::expireCurrentSlot() noexcept
+{
+    const auto slot = currentTick_ % SLOT_COUNT;
+    auto& timers = slots_[0][slot];
+    occupiedSlots_[0] &= ~(std::uint64_t{1} << slot);
+
+    while (!timers.empty())
+    {
+        auto& timer = *timers.head.next;
+        TimerList::unlink(timer);
+        expired_.pushBack(timer);
+    }
+}
+
+}
@@ -0,0 +1,107 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file TimerWheel.h
+ *
+ * Created on: Oct 14, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_INTERNAL_TIMERWHEEL_H_
+#define SDBUS_CXX_INTERNAL_TIMERWHEEL_H_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace sdbus::internal {
+
+    // Hierarchical timing wheel keeping track of a large number of deadlines at O(1) cost of scheduling and
+    // cancellation. Deadlines are rounded up to the wheel resolution, so timers never expire early. The wheel
+    // is not thread-safe; its user is responsible for synchronization.
+    class TimerWheel
+    {
+    public:
+        // Intrusive timer record, owned by the user of the wheel. It must be cancelled before it's destroyed.
+        struct Timer
+        {
+            Timer() = default;
+            Timer(const Timer&) = delete;
+            Timer& operator=(const Timer&) = delete;
+
+            [[nodiscard]] bool isScheduled() const noexcept { return next != nullptr; }
+
+            std::chrono::nanoseconds deadline{};
+            Timer* prev{};
+            Timer* next{};
+        };
+
+        explicit TimerWheel(std::chrono::nanoseconds now, std::chrono::nanoseconds resolution = std::chrono::milliseconds{1});
+        TimerWheel(const TimerWheel&) = delete;
+        TimerWheel& operator=(const TimerWheel&) = delete;
+
+        void schedule(Timer& timer, std::chrono::nanoseconds deadline) noexcept;
+        void cancel(Timer& timer) noexcept;
+
+        // Moves timers whose deadline has been reached at `now' over to the list of expired timers
+        void advance(std::chrono::nanoseconds now) noexcept;
+        // Takes the next expired timer out of the wheel, or returns nullptr if there is none
+        [[nodiscard]] Timer* popExpired() noexcept;
+
+        // Time point the wheel shall be advanced at next: either the earliest deadline, or an earlier point at which
+        // timers from an upper level get redistributed. nanoseconds::max() if there are no timers in the wheel.
+        [[nodiscard]] std::chrono::nanoseconds nextDeadline() const noexcept;
+        [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+    private:
+        static constexpr unsigned LEVEL_BITS = 6;
+        static constexpr std::uint64_t SLOT_COUNT = 1 << LEVEL_BITS;
+        static constexpr std::size_t LEVEL_COUNT = 4; // With 1ms resolution, the wheel spans over 4.6 hours
+
+        // Circular doubly-linked list of timers with a sentinel node
+        struct TimerList
+        {
+            TimerList() noexcept { head.prev = head.next = &head; }
+            [[nodiscard]] bool empty() const noexcept { return head.next == &head; }
+            void pushBack(Timer& timer) noexcept;
+            static void unlink(Timer& timer) noexcept;
+
+            Timer head;
+        };
+
+        [[nodiscard]] std::uint64_t toTick(std::chrono::nanoseconds deadline) const noexcept;
+        [[nodiscard]] std::uint64_t nextEventTick() const noexcept;
+        void place(Timer& timer) noexcept;
+        void cascade(std::size_t level) noexcept;
+        void expireCurrentSlot() noexcept;
+
+    private:
+        std::chrono::nanoseconds resolution_;
+        std::uint64_t currentTick_;
+        std::array<std::array<TimerList, SLOT_COUNT>, LEVEL_COUNT> slots_;
+        std::array<std::uint64_t, LEVEL_COUNT> occupiedSlots_{}; // Bitmap of non-empty slots, per level
+        TimerList expired_;
+        std::size_t size_{};
+    };
+
+}
+
+#endif /* SDBUS_CXX_INTERNAL_TIMERWHEEL_H_ */
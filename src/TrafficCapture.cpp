@@ -0,0 +1,444 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file TrafficCapture.cpp
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TrafficCapture.h"
+
+#include "sdbus-c++/Error.h"
+#include "sdbus-c++/Types.h"
+
+#include "Utils.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <string_view>
+
+// Layout of a capture file, all integers in host byte order:
+//   header:  "SDBUSCAP" magic, uint32 format version
+//   record:  uint32 length of the rest of the record, uint64 timestamp in ns since the start of the capture,
+//            uint8 message type, then path, interface, member, sender, destination and signature as strings
+//            (uint32 length followed by the characters), and the body, i.e. the arguments up to the record end.
+// Arguments are encoded by their D-Bus type:
+//   y n q i u x t d  raw value        b  one byte           s o g  string        h  nothing (fds aren't recorded)
+//   a                uint32 element count followed by the elements; arrays of fixed-size types are copied in one step
+//   v                contents signature as a string followed by the value
+//   ( ) { }          members in order
+
+namespace sdbus::internal {
+
+namespace {
+
+    constexpr std::string_view CAPTURE_MAGIC{"SDBUSCAP"};
+    constexpr uint32_t CAPTURE_VERSION{1};
+
+    std::size_t fixedTypeSize(char type)
+    {
+        switch (type)
+        {
+            case 'y': return 1;
+            case 'n': case 'q': return 2;
+            case 'i': case 'u': return 4;
+            case 'x': case 't': case 'd': return 8;
+            default: return 0; // Not a fixed-size type. Bool is excluded too, as its in-memory size differs.
+        }
+    }
+
+    template <typename _T>
+    void put(std::string& out, _T value)
+    {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void putString(std::string& out, std::string_view str)
+    {
+        put<uint32_t>(out, static_cast<uint32_t>(str.size()));
+        out.append(str);
+    }
+
+    template <typename _T>
+    void encodeBasic(Message& message, std::string& out)
+    {
+        _T value{};
+        message >> value;
+        put(out, value);
+    }
+
+    void encodeSequence(Message& message, std::string& out);
+
+    void encodeValue(Message& message, char type, const char* contents, std::string& out)
+    {
+        switch (type)
+        {
+            case 'y': encodeBasic<uint8_t>(message, out); break;
+            case 'n': encodeBasic<int16_t>(message, out); break;
+            case 'q': encodeBasic<uint16_t>(message, out); break;
+            case 'i': encodeBasic<int32_t>(message, out); break;
+            case 'u': encodeBasic<uint32_t>(message, out); break;
+            case 'x': encodeBasic<int64_t>(message, out); break;
+            case 't': encodeBasic<uint64_t>(message, out); break;
+            case 'd': encodeBasic<double>(message, out); break;
+            case 'b':
+            {
+                bool value{};
+                message >> value;
+                put<uint8_t>(out, value);
+                break;
+            }
+            case 's':
+            {
+                std::string_view value;
+                message >> value;
+                putString(out, value);
+                break;
+            }
+            case 'o':
+            {
+                ObjectPath value;
+                message >> value;
+                putString(out, value);
+                break;
+            }
+            case 'g':
+            {
+                Signature value;
+                message >> value;
+                putString(out, value);
+                break;
+            }
+            case 'h':
+            {
+                UnixFd value;
+                message >> value;
+                break;
+            }
+            case 'a':
+            {
+                if (const auto size = fixedTypeSize(contents[0]); size != 0 && contents[1] == '\0')
+                {
+                    const void* ptr{};
+                    std::size_t bytes{};
+                    message.readArray(contents[0], &ptr, &bytes);
+                    put<uint32_t>(out, static_cast<uint32_t>(bytes / size));
+                    if (bytes != 0)
+                        out.append(static_cast<const char*>(ptr), bytes);
+                    break;
+                }
+
+                message.enterContainer(contents);
+                const auto countPosition = out.size();
+                put<uint32_t>(out, 0); // Patched once the elements are counted
+                uint32_t count{};
+                for (auto [elementType, elementContents] = message.peekType(); elementType != '\0'; std::tie(elementType, elementContents) = message.peekType())
+                {
+                    encodeValue(message, elementType, elementContents, out);
+                    ++count;
+                }
+                std::memcpy(out.data() + countPosition, &count, sizeof(count));
+                message.exitContainer();
+                break;
+            }
+            case 'v':
+                message.enterVariant(contents);
+                putString(out, contents);
+                encodeSequence(message, out);
+                message.exitVariant();
+                break;
+            case 'r':
+                message.enterStruct(contents);
+                encodeSequence(message, out);
+                message.exitStruct();
+                break;
+            case 'e':
+                message.enterDictEntry(contents);
+                encodeSequence(message, out);
+                message.exitDictEntry();
+                break;
+            default:
+                SDBUS_THROW_ERROR("Failed to capture a message: unsupported argument type", EINVAL);
+        }
+    }
+
+    void encodeSequence(Message& message, std::string& out)
+    {
+        for (auto [type, contents] = message.peekType(); type != '\0'; std::tie(type, contents) = message.peekType())
+            encodeValue(message, type, contents, out);
+    }
+
+    // Returns the end of the single complete type the signature starts with
+    const char* completeTypeEnd(const char* signature)
+    {
+        if (*signature == 'a')
+            return completeTypeEnd(signature + 1);
+        if (*signature != '(' && *signature != '{')
+        {
+            SDBUS_THROW_ERROR_IF(*signature == '\0', "Invalid signature of a captured message", EINVAL);
+            return signature + 1;
+        }
+
+        int depth{};
+        do
+        {
+            SDBUS_THROW_ERROR_IF(*signature == '\0', "Invalid signature of a captured message", EINVAL);
+            if (*signature == '(' || *signature == '{')
+                ++depth;
+            else if (*signature == ')' || *signature == '}')
+                --depth;
+            ++signature;
+        } while (depth > 0);
+
+        return signature;
+    }
+
+    class BodyDecoder
+    {
+    public:
+        explicit BodyDecoder(std::string_view body) : body_(body) {}
+
+        template <typename _T>
+        _T get()
+        {
+            _T value{};
+            std::memcpy(&value, getBytes(sizeof(value)).data(), sizeof(value));
+            return value;
+        }
+
+        std::string_view getString()
+        {
+            return getBytes(get<uint32_t>());
+        }
+
+        std::string_view getBytes(std::size_t size)
+        {
+            SDBUS_THROW_ERROR_IF(body_.size() < size, "Truncated body of a captured message", EINVAL);
+            auto bytes = body_.substr(0, size);
+            body_.remove_prefix(size);
+            return bytes;
+        }
+
+        std::string_view getRemaining()
+        {
+            return getBytes(body_.size());
+        }
+
+        [[nodiscard]] bool isAtEnd() const
+        {
+            return body_.empty();
+        }
+
+    private:
+        std::string_view body_;
+    };
+
+    void decodeValue(Message& message, const char*& signature, BodyDecoder& in)
+    {
+        const auto* typeEnd = completeTypeEnd(signature);
+        const auto type = *signature;
+
+        switch (type)
+        {
+            case 'y': message << in.get<uint8_t>(); break;
+            case 'n': message << in.get<int16_t>(); break;
+            case 'q': message << in.get<uint16_t>(); break;
+            case 'i': message << in.get<int32_t>(); break;
+            case 'u': message << in.get<uint32_t>(); break;
+            case 'x': message << in.get<int64_t>(); break;
+            case 't': message << in.get<uint64_t>(); break;
+            case 'd': message << in.get<double>(); break;
+            case 'b': message << (in.get<uint8_t>() != 0); break;
+            case 's': message << in.getString(); break;
+            case 'o': message << ObjectPath{std::string{in.getString()}}; break;
+            case 'g': message << Signature{std::string{in.getString()}}; break;
+            case 'h':
+            {
+                auto fd = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+                SDBUS_THROW_ERROR_IF(fd < 0, "Failed to open /dev/null as a replacement of a captured fd", errno);
+                message << UnixFd{fd, adopt_fd};
+                break;
+            }
+            case 'a':
+            {
+                const std::string element{signature + 1, typeEnd};
+                const auto count = in.get<uint32_t>();
+                if (const auto size = fixedTypeSize(element[0]); size != 0 && element.size() == 1)
+                {
+                    auto bytes = in.getBytes(std::size_t{count} * size);
+                    message.appendArray(element[0], bytes.data(), bytes.size());
+                    break;
+                }
+
+                message.openContainer(element.c_str());
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    const char* elementSignature = element.c_str();
+                    decodeValue(message, elementSignature, in);
+                }
+                message.closeContainer();
+                break;
+            }
+            case 'v':
+            {
+                const std::string contents{in.getString()};
+                const char* contentsSignature = contents.c_str();
+                message.openVariant(contentsSignature);
+                decodeValue(message, contentsSignature, in);
+                SDBUS_THROW_ERROR_IF(*contentsSignature != '\0', "Invalid variant in a captured message", EINVAL);
+                message.closeVariant();
+                break;
+            }
+            case '(':
+            case '{':
+            {
+                const std::string contents{signature + 1, typeEnd - 1};
+                type == '(' ? message.openStruct(contents.c_str()) : message.openDictEntry(contents.c_str());
+                for (const char* member = contents.c_str(); *member != '\0';)
+                    decodeValue(message, member, in);
+                type == '(' ? message.closeStruct() : message.closeDictEntry();
+                break;
+            }
+            default:
+                SDBUS_THROW_ERROR("Invalid signature of a captured message", EINVAL);
+        }
+
+        signature = typeEnd;
+    }
+
+}
+
+void encodeCapturedArguments(Message& message, std::string& signature, std::string& body)
+{
+    for (auto [type, contents] = message.peekType(); type != '\0'; std::tie(type, contents) = message.peekType())
+    {
+        if (type == 'a')
+            signature.append("a").append(contents);
+        else if (type == 'r')
+            signature.append("(").append(contents).append(")");
+        else
+            signature.append(1, type);
+        encodeValue(message, type, contents, body);
+    }
+}
+
+TrafficRecorder::TrafficRecorder(const std::string& filePath)
+    : file_(filePath, std::ios::binary | std::ios::trunc)
+    , start_(now())
+{
+    SDBUS_THROW_ERROR_IF(!file_, "Failed to open traffic capture file " + filePath, errno);
+
+    file_.write(CAPTURE_MAGIC.data(), static_cast<std::streamsize>(CAPTURE_MAGIC.size()));
+    file_.write(reinterpret_cast<const char*>(&CAPTURE_VERSION), sizeof(CAPTURE_VERSION));
+    SDBUS_THROW_ERROR_IF(!file_, "Failed to write traffic capture file " + filePath, errno);
+}
+
+void TrafficRecorder::record(Message& message, CapturedMessage::Type type) noexcept
+{
+    try
+    {
+        const auto timestamp = now() - start_;
+
+        signature_.clear();
+        body_.clear();
+        try
+        {
+            encodeCapturedArguments(message, signature_, body_);
+        }
+        catch (...)
+        {
+            message.rewind(true);
+            throw;
+        }
+        message.rewind(true);
+
+        record_.clear();
+        put<uint32_t>(record_, 0); // Patched once the record is complete
+        put<uint64_t>(record_, static_cast<uint64_t>(timestamp.count()));
+        put<uint8_t>(record_, static_cast<uint8_t>(type));
+        for (const auto* field : { message.getPath(), message.getInterfaceName(), message.getMemberName()
+                                 , message.getSender(), message.getDestination() })
+            putString(record_, field != nullptr ? field : "");
+        putString(record_, signature_);
+        record_.append(body_);
+
+        const auto length = static_cast<uint32_t>(record_.size() - sizeof(uint32_t));
+        std::memcpy(record_.data(), &length, sizeof(length));
+        file_.write(record_.data(), static_cast<std::streamsize>(record_.size()));
+    }
+    catch (...)
+    {
+        // The message is dispatched as usual, it's just missing in the capture
+    }
+}
+
+}
+
+namespace sdbus {
+
+TrafficCaptureReader::TrafficCaptureReader(const std::string& filePath)
+    : file_(filePath, std::ios::binary)
+{
+    SDBUS_THROW_ERROR_IF(!file_, "Failed to open traffic capture file " + filePath, errno);
+
+    char magic[internal::CAPTURE_MAGIC.size()]{};
+    uint32_t version{};
+    file_.read(magic, sizeof(magic));
+    file_.read(reinterpret_cast<char*>(&version), sizeof(version));
+    SDBUS_THROW_ERROR_IF( !file_ || std::string_view(magic, sizeof(magic)) != internal::CAPTURE_MAGIC
+                        , "Not a traffic capture file: " + filePath
+                        , EINVAL );
+    SDBUS_THROW_ERROR_IF(version != internal::CAPTURE_VERSION, "Unsupported traffic capture file version", EINVAL);
+}
+
+std::optional<CapturedMessage> TrafficCaptureReader::next()
+{
+    uint32_t length{};
+    if (!file_.read(reinterpret_cast<char*>(&length), sizeof(length)))
+        return std::nullopt;
+
+    std::string record(length, '\0');
+    if (!file_.read(record.data(), length))
+        return std::nullopt; // Truncated by an interrupted capture
+
+    internal::BodyDecoder in{record};
+    CapturedMessage message;
+    message.timestamp = std::chrono::nanoseconds{in.get<uint64_t>()};
+    message.type = static_cast<CapturedMessage::Type>(in.get<uint8_t>());
+    for (auto* field : { &message.path, &message.interfaceName, &message.memberName
+                       , &message.sender, &message.destination, &message.signature })
+        *field = in.getString();
+    message.body = in.getRemaining();
+
+    return message;
+}
+
+void appendCapturedArguments(Message& message, const CapturedMessage& captured)
+{
+    internal::BodyDecoder in{captured.body};
+    for (const char* signature = captured.signature.c_str(); *signature != '\0';)
+        internal::decodeValue(message, signature, in);
+    SDBUS_THROW_ERROR_IF(!in.isAtEnd(), "Body of a captured message doesn't match its signature", EINVAL);
+}
+
+}
@@ -0,0 +1,63 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file TrafficCapture.h
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_INTERNAL_TRAFFICCAPTURE_H_
+#define SDBUS_CXX_INTERNAL_TRAFFICCAPTURE_H_
+
+#include "sdbus-c++/Message.h"
+#include "sdbus-c++/TrafficCapture.h"
+
+#include <chrono>
+#include <fstream>
+#include <string>
+
+namespace sdbus::internal {
+
+    // Encodes the arguments of the message, from its current read position to its end, in the traffic capture
+    // encoding (see TrafficCapture.cpp), appending their signature to the signature and their values to the body
+    void encodeCapturedArguments(Message& message, std::string& signature, std::string& body);
+
+    // Records received messages into a traffic capture file. It's fed from the sd-bus filter of the connection,
+    // i.e. from the event loop thread only, so it's not thread-safe.
+    class TrafficRecorder
+    {
+    public:
+        explicit TrafficRecorder(const std::string& filePath);
+
+        // Records the message, leaving it rewound for the dispatch. Messages that fail to encode are skipped.
+        void record(Message& message, CapturedMessage::Type type) noexcept;
+
+    private:
+        std::ofstream file_;
+        std::chrono::nanoseconds start_;
+        std::string signature_; // Buffers reused across records
+        std::string body_;
+        std::string record_;
+    };
+
+}
+
+#endif /* SDBUS_CXX_INTERNAL_TRAFFICCAPTURE_H_ */
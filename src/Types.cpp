@@ -28,43 +28,144 @@
 
 #include "sdbus-c++/Error.h"
 
+#include "Compression.h"
 #include "MessageUtils.h"
 
 #include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <mutex>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <system_error>
+#include <type_traits>
 #include SDBUS_HEADER
 #include <unistd.h>
+#include <unordered_set>
 
 namespace sdbus {
 
-Variant::Variant()
-    : msg_(createPlainMessage())
-{
+namespace {
+
+    // Invokes the function with a type tag of the fixed-size basic D-Bus type given by its signature character.
+    // Returns false for all other types, which a Variant does not store inline.
+    template <typename _Function>
+    bool visitInlineType(char type, _Function&& function)
+    {
+        switch (type)
+        {
+            case 'y': function(std::type_identity<uint8_t>{}); return true;
+            case 'b': function(std::type_identity<bool>{}); return true;
+            case 'n': function(std::type_identity<int16_t>{}); return true;
+            case 'q': function(std::type_identity<uint16_t>{}); return true;
+            case 'i': function(std::type_identity<int32_t>{}); return true;
+            case 'u': function(std::type_identity<uint32_t>{}); return true;
+            case 'x': function(std::type_identity<int64_t>{}); return true;
+            case 't': function(std::type_identity<uint64_t>{}); return true;
+            case 'd': function(std::type_identity<double>{}); return true;
+            default: return false;
+        }
+    }
+
 }
 
+Variant::Variant() = default;
+
 void Variant::serializeTo(Message& msg) const
 {
     SDBUS_THROW_ERROR_IF(isEmpty(), "Empty variant is not allowed", EINVAL);
+
+    if (inlineSignature_[0] != '\0')
+    {
+        msg.openVariant(inlineSignature_);
+        visitInlineType(inlineSignature_[0], [&]<typename _Type>(std::type_identity<_Type>)
+        {
+            _Type value;
+            std::memcpy(&value, &inlineValue_, sizeof(value));
+            msg << value;
+        });
+        msg.closeVariant();
+        return;
+    }
+
     msg_.rewind(true);
     msg_.copyTo(msg, true);
 }
 
 void Variant::deserializeFrom(Message& msg)
 {
+    msg_ = {};
+    inlineSignature_[0] = '\0';
+    valueTypeTag_ = 0;
+    decodedValue_.reset();
+    decodedType_ = nullptr;
+
+    auto [type, contents] = msg.peekType();
+
+    // Nothing to read (e.g. at the end of a container), which leaves the variant empty
+    if (type == '\0')
+        return;
+
+    // Read values of fixed-size basic types inline, sparing the creation of a message and the copy
+    if (type == 'v' && contents != nullptr && contents[0] != '\0' && contents[1] == '\0')
+    {
+        auto isInline = visitInlineType(contents[0], [&]<typename _Type>(std::type_identity<_Type>)
+        {
+            _Type value{};
+            msg.enterVariant(contents);
+            msg >> value;
+            msg.exitVariant();
+            std::memcpy(&inlineValue_, &value, sizeof(value));
+        });
+
+        if (isInline)
+        {
+            inlineSignature_[0] = contents[0];
+            return;
+        }
+    }
+
+    msg_ = createPlainMessage();
     msg.copyTo(msg_, false);
     msg_.seal();
 }
 
 const char* Variant::peekValueType() const
 {
+    if (inlineSignature_[0] != '\0')
+        return inlineSignature_;
+    if (!msg_.isValid())
+        return nullptr;
+
     msg_.rewind(false);
     auto [type, contents] = msg_.peekType();
     return contents;
 }
 
+uint64_t Variant::cacheValueTypeTag() const
+{
+    const auto* valueType = peekValueType();
+    valueTypeTag_ = valueType != nullptr ? typeTagOf(valueType) : 0;
+    return valueTypeTag_;
+}
+
 bool Variant::isEmpty() const
 {
-    return msg_.isEmpty();
+    return inlineSignature_[0] == '\0' && (!msg_.isValid() || msg_.isEmpty());
+}
+
+void Variant::materialize() const
+{
+    if (inlineSignature_[0] == '\0')
+        return;
+
+    auto msg = createPlainMessage();
+    serializeTo(msg);
+    msg.seal();
+
+    msg_ = std::move(msg);
+    inlineSignature_[0] = '\0';
 }
 
 void UnixFd::close() // NOLINT(readability-make-member-function-const)
@@ -90,4 +191,94 @@ int UnixFd::checkedDup(int fd)
     return ret;
 }
 
+namespace {
+    // Seals which guarantee that the content of a shared buffer can't change under its reader's hands
+    constexpr int SHARED_BUFFER_SEALS = F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE;
+
+    std::shared_ptr<const std::byte> mapSharedBuffer(int fd, std::size_t size)
+    {
+        if (size == 0)
+            return {};
+
+        auto* addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        SDBUS_THROW_ERROR_IF(addr == MAP_FAILED, "Failed to map shared buffer", errno);
+
+        return {static_cast<const std::byte*>(addr), [size](const std::byte* ptr){ munmap(const_cast<std::byte*>(ptr), size); }};
+    }
+}
+
+SharedBuffer::SharedBuffer(std::span<const std::byte> data)
+    : SharedBuffer(data.size(), [&data](std::span<std::byte> buffer){ std::memcpy(buffer.data(), data.data(), data.size()); })
+{
+}
+
+SharedBuffer::SharedBuffer(std::size_t size, const std::function<void(std::span<std::byte>)>& fill)
+{
+    auto fd = memfd_create("sdbus-c++-shared-buffer", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    SDBUS_THROW_ERROR_IF(fd < 0, "Failed to create memfd for shared buffer", errno);
+    fd_.reset(fd, adopt_fd);
+
+    auto r = ftruncate(fd, static_cast<off_t>(size));
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to resize shared buffer", errno);
+
+    if (size > 0)
+    {
+        auto* addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        SDBUS_THROW_ERROR_IF(addr == MAP_FAILED, "Failed to map shared buffer for writing", errno);
+        // The writable mapping must be gone before sealing against writes
+        std::unique_ptr<std::byte, std::function<void(std::byte*)>> writableMapping{static_cast<std::byte*>(addr), [size](std::byte* ptr){ munmap(ptr, size); }};
+
+        fill({writableMapping.get(), size});
+    }
+
+    r = fcntl(fd, F_ADD_SEALS, SHARED_BUFFER_SEALS | F_SEAL_SEAL);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to seal shared buffer", errno);
+
+    size_ = size;
+    mapping_ = mapSharedBuffer(fd, size);
+}
+
+SharedBuffer::SharedBuffer(UnixFd fd, std::size_t size)
+    : fd_(std::move(fd))
+{
+    auto seals = fcntl(fd_.get(), F_GET_SEALS);
+    SDBUS_THROW_ERROR_IF(seals < 0, "Failed to get seals of shared buffer", errno);
+    SDBUS_THROW_ERROR_IF((seals & SHARED_BUFFER_SEALS) != SHARED_BUFFER_SEALS, "Shared buffer memfd is not sealed", EPERM);
+
+    struct stat st{};
+    auto r = fstat(fd_.get(), &st);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to get size of shared buffer", errno);
+    SDBUS_THROW_ERROR_IF(static_cast<std::size_t>(st.st_size) < size, "Shared buffer is smaller than announced", EINVAL);
+
+    size_ = size;
+    mapping_ = mapSharedBuffer(fd_.get(), size);
+}
+
+bool CompressedBytes::isCodecAvailable(Codec codec)
+{
+    return internal::isCompressionCodecAvailable(codec);
+}
+
+const char* detail::internName(std::string_view name)
+{
+    struct StringHash
+    {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view str) const noexcept { return std::hash<std::string_view>{}(str); }
+    };
+
+    // Deliberately never destroyed, so that interned names outlive all static objects referring to them.
+    // Elements of a node-based set keep their addresses, so the returned pointers stay valid as the table grows.
+    static auto* const mutex = new std::mutex;
+    static auto* const names = new std::unordered_set<std::string, StringHash, std::equal_to<>>;
+
+    std::lock_guard lock(*mutex);
+
+    auto it = names->find(name);
+    if (it == names->end())
+        it = names->emplace(name).first;
+
+    return it->c_str();
+}
+
 } // namespace sdbus
@@ -0,0 +1,205 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file Utf8Validation.cpp
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Utf8Validation.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__))
+#define SDBUS_UTF8_VALIDATION_X86
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define SDBUS_UTF8_VALIDATION_NEON
+#include <arm_neon.h>
+#endif
+
+namespace sdbus::internal {
+
+namespace {
+
+    // Returns the length of the valid UTF-8 sequence starting at p, or 0 if there is none there
+    std::size_t validSequenceLength(const unsigned char* p, const unsigned char* end) noexcept
+    {
+        const unsigned char lead = *p;
+        if (lead < 0x80)
+            return lead != 0 ? 1 : 0;
+
+        std::size_t length{};
+        char32_t codePoint{};
+        char32_t minCodePoint{};
+        if ((lead & 0xE0) == 0xC0)
+            length = 2, codePoint = lead & 0x1F, minCodePoint = 0x80;
+        else if ((lead & 0xF0) == 0xE0)
+            length = 3, codePoint = lead & 0x0F, minCodePoint = 0x800;
+        else if ((lead & 0xF8) == 0xF0)
+            length = 4, codePoint = lead & 0x07, minCodePoint = 0x10000;
+        else
+            return 0;
+
+        if (static_cast<std::size_t>(end - p) < length)
+            return 0;
+        for (std::size_t i = 1; i < length; ++i)
+        {
+            if ((p[i] & 0xC0) != 0x80)
+                return 0;
+            codePoint = (codePoint << 6) | (p[i] & 0x3F);
+        }
+
+        if ( codePoint < minCodePoint                           // Overlong form
+          || codePoint >= 0x110000                              // Beyond Unicode
+          || (codePoint >= 0xD800 && codePoint <= 0xDFFF)       // UTF-16 surrogates
+          || (codePoint >= 0xFDD0 && codePoint <= 0xFDEF)       // Noncharacters
+          || (codePoint & 0xFFFE) == 0xFFFE )                   // Noncharacters at the end of each plane
+            return 0;
+
+        return length;
+    }
+
+    // Validates sequences from p up to `until`, finishing the one that straddles it, if any.
+    // Returns the position past the last validated sequence, or nullptr if the input is invalid.
+    const unsigned char* validateSequences(const unsigned char* p, const unsigned char* until, const unsigned char* end) noexcept
+    {
+        while (p < until)
+        {
+            auto length = validSequenceLength(p, end);
+            if (length == 0)
+                return nullptr;
+            p += length;
+        }
+        return p;
+    }
+
+    // Each implementation below skips over blocks of plain ASCII (no high bit, no NUL), which is what
+    // the vast majority of D-Bus strings consist of, and falls back to validating sequence by sequence
+    // only in blocks containing something else.
+
+#if defined(SDBUS_UTF8_VALIDATION_X86)
+    __attribute__((target("avx2"))) bool validateUtf8Avx2(const unsigned char* p, const unsigned char* end) noexcept
+    {
+        const auto zero = _mm256_setzero_si256();
+        while (end - p >= 32)
+        {
+            const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            const auto nonPlainMask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(block, _mm256_cmpeq_epi8(block, zero))));
+            if (nonPlainMask == 0)
+            {
+                p += 32;
+                continue;
+            }
+            p = validateSequences(p + __builtin_ctz(nonPlainMask), p + 32, end);
+            if (p == nullptr)
+                return false;
+        }
+        return validateSequences(p, end, end) != nullptr;
+    }
+
+    bool validateUtf8Sse2(const unsigned char* p, const unsigned char* end) noexcept
+    {
+        const auto zero = _mm_setzero_si128();
+        while (end - p >= 16)
+        {
+            const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            const auto nonPlainMask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(block, _mm_cmpeq_epi8(block, zero))));
+            if (nonPlainMask == 0)
+            {
+                p += 16;
+                continue;
+            }
+            p = validateSequences(p + __builtin_ctz(nonPlainMask), p + 16, end);
+            if (p == nullptr)
+                return false;
+        }
+        return validateSequences(p, end, end) != nullptr;
+    }
+#elif defined(SDBUS_UTF8_VALIDATION_NEON)
+    bool validateUtf8Neon(const unsigned char* p, const unsigned char* end) noexcept
+    {
+        while (end - p >= 16)
+        {
+            const auto block = vld1q_u8(p);
+            if (vmaxvq_u8(block) < 0x80 && vminvq_u8(block) != 0)
+            {
+                p += 16;
+                continue;
+            }
+            p = validateSequences(p, p + 16, end);
+            if (p == nullptr)
+                return false;
+        }
+        return validateSequences(p, end, end) != nullptr;
+    }
+#else
+    bool validateUtf8Portable(const unsigned char* p, const unsigned char* end) noexcept
+    {
+        constexpr uint64_t lowBits = 0x0101010101010101;
+        constexpr uint64_t highBits = 0x8080808080808080;
+        while (end - p >= 8)
+        {
+            uint64_t word;
+            std::memcpy(&word, p, sizeof(word));
+            // With no high bit set in any byte, the second term is exact: it flags the NUL bytes
+            if ((word & highBits) == 0 && ((word - lowBits) & ~word & highBits) == 0)
+            {
+                p += 8;
+                continue;
+            }
+            p = validateSequences(p, p + 8, end);
+            if (p == nullptr)
+                return false;
+        }
+        return validateSequences(p, end, end) != nullptr;
+    }
+#endif
+
+    using Utf8Validator = bool (*)(const unsigned char*, const unsigned char*) noexcept;
+
+    Utf8Validator selectUtf8Validator() noexcept
+    {
+#if defined(SDBUS_UTF8_VALIDATION_X86)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return &validateUtf8Avx2;
+        return &validateUtf8Sse2;
+#elif defined(SDBUS_UTF8_VALIDATION_NEON)
+        return &validateUtf8Neon;
+#else
+        return &validateUtf8Portable;
+#endif
+    }
+
+}
+
+bool isValidUtf8String(std::string_view str) noexcept
+{
+    static const Utf8Validator validator = selectUtf8Validator();
+
+    const auto* begin = reinterpret_cast<const unsigned char*>(str.data());
+    return validator(begin, begin + str.size());
+}
+
+}
@@ -0,0 +1,42 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file Utf8Validation.h
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_INTERNAL_UTF8VALIDATION_H_
+#define SDBUS_CXX_INTERNAL_UTF8VALIDATION_H_
+
+#include <string_view>
+
+namespace sdbus::internal {
+
+    // Checks that the string is a valid D-Bus string: well-formed UTF-8 without embedded NUL characters,
+    // following the same rules as sd-bus (no overlong forms, surrogates, noncharacters or code points
+    // beyond U+10FFFF). Runs of ASCII are checked a whole vector register at a time; the implementation
+    // (AVX2, SSE2, NEON or portable word-at-a-time) is selected at runtime on first use.
+    bool isValidUtf8String(std::string_view str) noexcept;
+
+}
+
+#endif /* SDBUS_CXX_INTERNAL_UTF8VALIDATION_H_ */
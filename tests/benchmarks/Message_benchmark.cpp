@@ -0,0 +1,280 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file Message_benchmark.cpp
+ *
+ * Created on: Oct 14, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <sdbus-c++/sdbus-c++.h>
+
+#include <benchmark/benchmark.h>
+#include <array>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace std::string_literals;
+
+namespace my {
+    struct Struct
+    {
+        int32_t i;
+        std::string s;
+        std::vector<double> l;
+    };
+}
+
+SDBUSCPP_REGISTER_STRUCT(my::Struct, i, s, l);
+
+namespace {
+
+    // Each serialization benchmark includes the creation of the plain message, which is measured
+    // separately by BM_CreatePlainMessage. Each deserialization benchmark reads from a single sealed
+    // message that is rewound in every iteration, so only the deserialization itself is measured.
+
+    template <typename _Value>
+    void BM_Serialize(benchmark::State& state, const _Value& value)
+    {
+        for (auto _ : state)
+        {
+            auto msg = sdbus::createPlainMessage();
+            msg << value;
+            benchmark::DoNotOptimize(msg);
+        }
+    }
+
+    template <typename _Value, typename _Result = _Value>
+    void BM_Deserialize(benchmark::State& state, const _Value& value)
+    {
+        auto msg = sdbus::createPlainMessage();
+        msg << value;
+        msg.seal();
+
+        for (auto _ : state)
+        {
+            msg.rewind(true);
+            _Result result{};
+            msg >> result;
+            benchmark::DoNotOptimize(result);
+        }
+    }
+
+    template <typename _Element>
+    std::vector<_Element> makeArray(benchmark::State& state)
+    {
+        return std::vector<_Element>(static_cast<std::size_t>(state.range(0)));
+    }
+
+    // Contiguous arrays of trivial D-Bus types are read in one step (Message::deserializeArrayFast())
+    template <typename _Element>
+    void BM_SerializeArray(benchmark::State& state)
+    {
+        auto array = makeArray<_Element>(state);
+        BM_Serialize(state, array);
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * array.size() * sizeof(_Element)));
+    }
+
+    template <typename _Element>
+    void BM_DeserializeArray(benchmark::State& state)
+    {
+        auto array = makeArray<_Element>(state);
+        BM_Deserialize(state, array);
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * array.size() * sizeof(_Element)));
+    }
+
+    std::map<int32_t, std::string> makeMap(benchmark::State& state)
+    {
+        std::map<int32_t, std::string> map;
+        for (int32_t i = 0; i < state.range(0); ++i)
+            map.emplace(i, "value");
+        return map;
+    }
+
+    std::map<std::string, std::map<std::string, sdbus::Variant>> makeNestedDictionary()
+    {
+        std::map<std::string, std::map<std::string, sdbus::Variant>> dict;
+        for (const auto& interface : {"org.example.A"s, "org.example.B"s, "org.example.C"s})
+            dict[interface] = {{"int", sdbus::Variant{int32_t{42}}}, {"str", sdbus::Variant{"hello"s}}, {"dbl", sdbus::Variant{3.14}}};
+        return dict;
+    }
+
+    // Generic walk through the Message API, as done by tools handling messages of any type without sdbus::DynamicBody
+    void walkGenerically(sdbus::Message& msg, std::string& output)
+    {
+        for (auto [type, contents] = msg.peekType(); type != '\0'; std::tie(type, contents) = msg.peekType())
+        {
+            switch (type)
+            {
+                case 'a': msg.enterContainer(contents); output += '['; walkGenerically(msg, output); output += ']'; msg.exitContainer(); break;
+                case 'r': msg.enterStruct(contents); output += '['; walkGenerically(msg, output); output += ']'; msg.exitStruct(); break;
+                case 'e': msg.enterDictEntry(contents); walkGenerically(msg, output); msg.exitDictEntry(); break;
+                case 'v': msg.enterVariant(contents); walkGenerically(msg, output); msg.exitVariant(); break;
+                case 'i': { int32_t value{}; msg >> value; output += std::to_string(value); break; }
+                case 'd': { double value{}; msg >> value; output += std::to_string(value); break; }
+                case 's': { std::string value; msg >> value; output += value; break; }
+                default: throw std::runtime_error("Unexpected type");
+            }
+            output += ',';
+        }
+    }
+
+    template <typename _Value>
+    void BM_WalkGenerically(benchmark::State& state, const _Value& value)
+    {
+        auto msg = sdbus::createPlainMessage();
+        msg << value;
+        msg.seal();
+
+        std::string output;
+        for (auto _ : state)
+        {
+            msg.rewind(true);
+            output.clear();
+            walkGenerically(msg, output);
+            benchmark::DoNotOptimize(output);
+        }
+    }
+
+    template <typename _Value>
+    void BM_DecodeDynamically(benchmark::State& state, const _Value& value)
+    {
+        auto msg = sdbus::createPlainMessage();
+        msg << value;
+        msg.seal();
+
+        sdbus::DynamicBody body;
+        for (auto _ : state)
+        {
+            body.decode(msg);
+            benchmark::DoNotOptimize(body);
+        }
+    }
+
+    template <typename _Value>
+    void BM_WriteJson(benchmark::State& state, const _Value& value)
+    {
+        auto msg = sdbus::createPlainMessage();
+        msg << value;
+        msg.seal();
+
+        std::string output;
+        for (auto _ : state)
+        {
+            output.clear();
+            sdbus::writeJson(msg, output);
+            benchmark::DoNotOptimize(output);
+        }
+    }
+
+    const my::Struct aStruct{42, "hello"s, {3.14, 2.71, 1.41}};
+    using StructAsDictionary = std::map<std::string, sdbus::Variant>;
+
+}
+
+void BM_CreatePlainMessage(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        auto msg = sdbus::createPlainMessage();
+        benchmark::DoNotOptimize(msg);
+    }
+}
+BENCHMARK(BM_CreatePlainMessage);
+
+// Basic types
+BENCHMARK_CAPTURE(BM_Serialize, bool, true);
+BENCHMARK_CAPTURE(BM_Deserialize, bool, true);
+BENCHMARK_CAPTURE(BM_Serialize, uint8, uint8_t{42});
+BENCHMARK_CAPTURE(BM_Deserialize, uint8, uint8_t{42});
+BENCHMARK_CAPTURE(BM_Serialize, int32, int32_t{42});
+BENCHMARK_CAPTURE(BM_Deserialize, int32, int32_t{42});
+BENCHMARK_CAPTURE(BM_Serialize, uint64, uint64_t{42});
+BENCHMARK_CAPTURE(BM_Deserialize, uint64, uint64_t{42});
+BENCHMARK_CAPTURE(BM_Serialize, double, 3.14);
+BENCHMARK_CAPTURE(BM_Deserialize, double, 3.14);
+BENCHMARK_CAPTURE(BM_Serialize, string, "Hello, D-Bus!"s);
+BENCHMARK_CAPTURE(BM_Deserialize, string, "Hello, D-Bus!"s);
+BENCHMARK_CAPTURE(BM_Serialize, string_4k, std::string(4096, 'x'));
+BENCHMARK_CAPTURE(BM_Deserialize, string_4k, std::string(4096, 'x'));
+void BM_DeserializeStringView(benchmark::State& state) { BM_Deserialize<std::string, std::string_view>(state, std::string(4096, 'x')); }
+BENCHMARK(BM_DeserializeStringView);
+BENCHMARK_CAPTURE(BM_Serialize, object_path, sdbus::ObjectPath{"/org/sdbuscpp/benchmark"});
+BENCHMARK_CAPTURE(BM_Deserialize, object_path, sdbus::ObjectPath{"/org/sdbuscpp/benchmark"});
+BENCHMARK_CAPTURE(BM_Serialize, signature, sdbus::Signature{"a{sv}"});
+BENCHMARK_CAPTURE(BM_Deserialize, signature, sdbus::Signature{"a{sv}"});
+
+// Arrays: fast path for trivial types vs. element-wise (slow) path for bool and strings
+BENCHMARK_TEMPLATE(BM_SerializeArray, uint8_t)->Range(16, 64 << 10);
+BENCHMARK_TEMPLATE(BM_DeserializeArray, uint8_t)->Range(16, 64 << 10);
+BENCHMARK_TEMPLATE(BM_SerializeArray, int32_t)->Range(16, 64 << 10);
+BENCHMARK_TEMPLATE(BM_DeserializeArray, int32_t)->Range(16, 64 << 10);
+BENCHMARK_TEMPLATE(BM_SerializeArray, double)->Range(16, 64 << 10);
+BENCHMARK_TEMPLATE(BM_DeserializeArray, double)->Range(16, 64 << 10);
+BENCHMARK_TEMPLATE(BM_SerializeArray, bool)->Range(16, 64 << 10);
+BENCHMARK_TEMPLATE(BM_DeserializeArray, bool)->Range(16, 64 << 10);
+BENCHMARK_TEMPLATE(BM_SerializeArray, std::string)->Range(16, 4 << 10);
+BENCHMARK_TEMPLATE(BM_DeserializeArray, std::string)->Range(16, 4 << 10);
+BENCHMARK_CAPTURE(BM_Serialize, std_array_int32, std::array<int32_t, 256>{});
+BENCHMARK_CAPTURE(BM_Deserialize, std_array_int32, std::array<int32_t, 256>{});
+
+// Dictionaries
+void BM_SerializeMap(benchmark::State& state) { BM_Serialize(state, makeMap(state)); }
+void BM_DeserializeMap(benchmark::State& state) { BM_Deserialize(state, makeMap(state)); }
+BENCHMARK(BM_SerializeMap)->Range(16, 4 << 10);
+BENCHMARK(BM_DeserializeMap)->Range(16, 4 << 10);
+BENCHMARK_CAPTURE(BM_Serialize, nested_dictionary, makeNestedDictionary());
+BENCHMARK_CAPTURE(BM_Deserialize, nested_dictionary, makeNestedDictionary());
+
+// Structs
+BENCHMARK_CAPTURE(BM_Serialize, struct, sdbus::Struct<int32_t, std::string, double>{42, "hello"s, 3.14});
+BENCHMARK_CAPTURE(BM_Deserialize, struct, sdbus::Struct<int32_t, std::string, double>{42, "hello"s, 3.14});
+BENCHMARK_CAPTURE(BM_Serialize, user_defined_struct, aStruct);
+BENCHMARK_CAPTURE(BM_Deserialize, user_defined_struct, aStruct);
+BENCHMARK_CAPTURE(BM_Serialize, struct_as_dictionary, sdbus::as_dictionary{aStruct});
+void BM_DeserializeDictionaryAsStruct(benchmark::State& state)
+{
+    const StructAsDictionary dict{{"i", sdbus::Variant{int32_t{42}}}, {"s", sdbus::Variant{"hello"s}}, {"l", sdbus::Variant{std::vector<double>{3.14, 2.71, 1.41}}}};
+    BM_Deserialize<StructAsDictionary, my::Struct>(state, dict);
+}
+BENCHMARK(BM_DeserializeDictionaryAsStruct);
+
+// Variants
+BENCHMARK_CAPTURE(BM_Serialize, variant_int32, sdbus::Variant{int32_t{42}});
+BENCHMARK_CAPTURE(BM_Deserialize, variant_int32, sdbus::Variant{int32_t{42}});
+BENCHMARK_CAPTURE(BM_Serialize, variant_string, sdbus::Variant{"hello"s});
+BENCHMARK_CAPTURE(BM_Deserialize, variant_string, sdbus::Variant{"hello"s});
+BENCHMARK_CAPTURE(BM_Serialize, variant_struct, sdbus::Variant{sdbus::Struct<int32_t, std::string>{42, "hello"s}});
+BENCHMARK_CAPTURE(BM_Deserialize, variant_struct, sdbus::Variant{sdbus::Struct<int32_t, std::string>{42, "hello"s}});
+
+// Generic decoding of messages whose types are not known at compile time
+BENCHMARK_CAPTURE(BM_WalkGenerically, nested_dictionary, makeNestedDictionary());
+BENCHMARK_CAPTURE(BM_DecodeDynamically, nested_dictionary, makeNestedDictionary());
+BENCHMARK_CAPTURE(BM_WriteJson, nested_dictionary, makeNestedDictionary());
+BENCHMARK_CAPTURE(BM_WalkGenerically, array_double, std::vector<double>(1024));
+BENCHMARK_CAPTURE(BM_DecodeDynamically, array_double, std::vector<double>(1024));
+BENCHMARK_CAPTURE(BM_WriteJson, array_double, std::vector<double>(1024));
+BENCHMARK_CAPTURE(BM_WalkGenerically, user_defined_struct, aStruct);
+BENCHMARK_CAPTURE(BM_DecodeDynamically, user_defined_struct, aStruct);
+BENCHMARK_CAPTURE(BM_WriteJson, user_defined_struct, aStruct);
@@ -35,6 +35,7 @@
 #include <thread>
 #include <tuple>
 #include <chrono>
+#include <coroutine>
 #include <fstream>
 #include <future>
 #include <unistd.h>
@@ -49,6 +50,79 @@ using ::testing::SizeIs;
 using namespace std::chrono_literals;
 using namespace sdbus::test;
 
+namespace
+{
+    // Minimal eagerly started, self-destroying coroutine type to drive sdbus-c++ awaitables in tests
+    struct Coroutine
+    {
+        struct promise_type
+        {
+            Coroutine get_return_object() { return {}; }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+    };
+
+    Coroutine doOperationInCoroutine(TestProxy& proxy, uint32_t param, std::promise<uint32_t>& result)
+    {
+        try
+        {
+            result.set_value(co_await proxy.doOperationClientSideAsyncAwaitable(param));
+        }
+        catch (...)
+        {
+            result.set_exception(std::current_exception());
+        }
+    }
+
+    Coroutine doErroneousOperationInCoroutine(TestProxy& proxy, std::promise<void>& result)
+    {
+        try
+        {
+            co_await proxy.doErroneousOperationClientSideAsyncAwaitable();
+            result.set_value();
+        }
+        catch (...)
+        {
+            result.set_exception(std::current_exception());
+        }
+    }
+
+    Coroutine getPropertyInCoroutine(TestProxy& proxy, std::promise<std::string>& result)
+    {
+        try
+        {
+            auto value = co_await proxy.getProxy().getPropertyAsync(STATE_PROPERTY).onInterface(INTERFACE_NAME).getResultAsAwaitable();
+            result.set_value(value.get<std::string>());
+        }
+        catch (...)
+        {
+            result.set_exception(std::current_exception());
+        }
+    }
+
+    Coroutine sendBatchInCoroutine(sdbus::CallBatch batch, std::promise<sdbus::CallBatch::Replies>& result)
+    {
+        result.set_value(co_await batch.send(sdbus::with_awaitable));
+    }
+
+    sdbus::MethodCall createDoOperationCall(TestProxy& proxy, uint32_t param)
+    {
+        auto call = proxy.getProxy().createMethodCall(INTERFACE_NAME, sdbus::MethodName{"doOperation"});
+        call << param;
+        return call;
+    }
+
+    uint32_t getDoOperationResult(sdbus::Expected<sdbus::MethodReply>& reply)
+    {
+        uint32_t result{};
+        reply.value() >> result;
+        return result;
+    }
+}
+
 /*-------------------------------------*/
 /* --          TEST CASES           -- */
 /*-------------------------------------*/
@@ -276,6 +350,35 @@ TYPED_TEST(AsyncSdbusTestObject, SupportsAsyncCallCopyAssignment)
     ASSERT_TRUE(call.isPending());
 }
 
+TYPED_TEST(AsyncSdbusTestObject, RejectsAsyncCallWhenPendingAsyncCallWindowIsFull)
+{
+    this->m_proxy->installDoOperationClientSideAsyncReplyHandler([&](uint32_t /*res*/, std::optional<sdbus::Error> /*err*/){});
+    this->m_proxy->getProxy().setMaxPendingAsyncCalls(2);
+
+    auto call1 = this->m_proxy->doOperationClientSideAsync(100);
+    auto call2 = this->m_proxy->doOperationClientSideAsync(100);
+
+    ASSERT_THAT(this->m_proxy->getProxy().getPendingAsyncCallCount(), Eq(2));
+    ASSERT_THROW(this->m_proxy->doOperationClientSideAsync(100), sdbus::Error);
+}
+
+TYPED_TEST(AsyncSdbusTestObject, AcceptsNewAsyncCallsOncePendingOnesAreCompletedOrCancelled)
+{
+    std::promise<uint32_t> promise;
+    auto future = promise.get_future();
+    this->m_proxy->installDoOperationClientSideAsyncReplyHandler([&](uint32_t res, std::optional<sdbus::Error> /*err*/){ if (res == 0) promise.set_value(res); });
+    this->m_proxy->getProxy().setMaxPendingAsyncCalls(2);
+    auto call1 = this->m_proxy->doOperationClientSideAsync(0);
+    auto call2 = this->m_proxy->doOperationClientSideAsync(100);
+
+    (void) future.get(); // Wait for the first call to finish
+    call2.cancel();
+
+    ASSERT_TRUE(waitUntil([this](){ return this->m_proxy->getProxy().getPendingAsyncCallCount() == 0; }));
+    ASSERT_NO_THROW(this->m_proxy->doOperationClientSideAsync(100));
+    ASSERT_NO_THROW(this->m_proxy->doOperationClientSideAsync(100));
+}
+
 TYPED_TEST(AsyncSdbusTestObject, ReturnsNonnullErrorWhenAsynchronousMethodCallFails)
 {
     std::promise<uint32_t> promise;
@@ -299,3 +402,131 @@ TYPED_TEST(AsyncSdbusTestObject, ThrowsErrorWhenClientSideAsynchronousMethodCall
 
     ASSERT_THROW(future.get(), sdbus::Error);
 }
+
+TYPED_TEST(AsyncSdbusTestObject, InvokesMethodAsynchronouslyOnClientSideWithCoroutine)
+{
+    std::promise<uint32_t> result;
+    auto future = result.get_future();
+
+    doOperationInCoroutine(*this->m_proxy, 100, result);
+
+    ASSERT_THAT(future.get(), Eq(100));
+}
+
+TYPED_TEST(AsyncSdbusTestObject, ThrowsErrorFromCoAwaitWhenClientSideAsynchronousMethodCallFails)
+{
+    std::promise<void> result;
+    auto future = result.get_future();
+
+    doErroneousOperationInCoroutine(*this->m_proxy, result);
+
+    ASSERT_THROW(future.get(), sdbus::Error);
+}
+
+TYPED_TEST(AsyncSdbusTestObject, GetsPropertyAsynchronouslyWithCoroutine)
+{
+    std::promise<std::string> result;
+    auto future = result.get_future();
+
+    getPropertyInCoroutine(*this->m_proxy, result);
+
+    ASSERT_THAT(future.get(), Eq(DEFAULT_STATE_VALUE));
+}
+
+TYPED_TEST(AsyncSdbusTestObject, CompletesBatchOfMethodCallsWithAllRepliesAndErrorsInOrder)
+{
+    sdbus::CallBatch batch;
+    batch.add(createDoOperationCall(*this->m_proxy, 100))
+         .add(this->m_proxy->getProxy().createMethodCall(INTERFACE_NAME, sdbus::MethodName{"throwError"}))
+         .add(createDoOperationCall(*this->m_proxy, 10));
+
+    auto replies = batch.send(sdbus::with_future).get();
+
+    ASSERT_TRUE(batch.empty());
+    ASSERT_THAT(replies, SizeIs(3));
+    ASSERT_THAT(getDoOperationResult(replies[0]), Eq(100));
+    ASSERT_FALSE(replies[1].has_value());
+    ASSERT_THAT(getDoOperationResult(replies[2]), Eq(10));
+}
+
+TYPED_TEST(AsyncSdbusTestObject, InvokesCallbackOnceWithAllRepliesOfABatch)
+{
+    std::promise<sdbus::CallBatch::Replies> promise;
+    auto future = promise.get_future();
+    std::atomic<int> invocations{};
+    sdbus::CallBatch batch;
+    for (uint32_t i = 1; i <= 20; ++i)
+        batch.add(createDoOperationCall(*this->m_proxy, i));
+
+    auto slot = batch.send([&](sdbus::CallBatch::Replies replies)
+    {
+        ++invocations;
+        promise.set_value(std::move(replies));
+    }, sdbus::return_slot);
+
+    auto replies = future.get();
+    ASSERT_THAT(invocations, Eq(1));
+    ASSERT_THAT(replies, SizeIs(20));
+    for (uint32_t i = 0; i < 20; ++i)
+        ASSERT_THAT(getDoOperationResult(replies[i]), Eq(i + 1));
+}
+
+TYPED_TEST(AsyncSdbusTestObject, CompletesEmptyBatchRightAway)
+{
+    sdbus::CallBatch batch;
+
+    auto future = batch.send(sdbus::with_future);
+
+    ASSERT_THAT(future.wait_for(0s), Eq(std::future_status::ready));
+    ASSERT_THAT(future.get(), SizeIs(0));
+}
+
+TYPED_TEST(AsyncSdbusTestObject, CompletesBatchOfMethodCallsWithCoroutine)
+{
+    std::promise<sdbus::CallBatch::Replies> result;
+    auto future = result.get_future();
+    sdbus::CallBatch batch;
+    batch.add(createDoOperationCall(*this->m_proxy, 20))
+         .add(createDoOperationCall(*this->m_proxy, 30));
+
+    sendBatchInCoroutine(std::move(batch), result);
+
+    auto replies = future.get();
+    ASSERT_THAT(replies, SizeIs(2));
+    ASSERT_THAT(getDoOperationResult(replies[0]), Eq(20));
+    ASSERT_THAT(getDoOperationResult(replies[1]), Eq(30));
+}
+
+TEST(AnAdaptorWithCoroutineMethods, RepliesOnceTheCoroutineCompletesWithoutBlockingTheEventLoop)
+{
+    auto connection = sdbus::createBusConnection();
+    connection->requestName(SERVICE_NAME);
+    connection->enterEventLoopAsync();
+    TestAdaptor adaptor(*connection, OBJECT_PATH);
+    // The downstream call goes through the very same connection, so it would deadlock if the handler blocked
+    auto downstreamProxy = sdbus::createProxy(*connection, SERVICE_NAME, OBJECT_PATH);
+    sdbus::InterfaceName interfaceName{"org.sdbuscpp.integrationtests2"};
+    adaptor.getObject().addVTable( sdbus::registerMethod("multiplyDownstream").implementedAs([&](int64_t a, double b) -> sdbus::Task<double>
+                                   {
+                                       co_return co_await downstreamProxy->callMethodAsync("multiply")
+                                                                          .onInterface(INTERFACE_NAME)
+                                                                          .withArguments(a, b)
+                                                                          .getResultAsAwaitable<double>();
+                                   })
+                                 , sdbus::registerMethod("throwErrorDownstream").implementedAs([&]() -> sdbus::Task<>
+                                   {
+                                       co_await downstreamProxy->callMethodAsync("throwError")
+                                                               .onInterface(INTERFACE_NAME)
+                                                               .getResultAsAwaitable<>();
+                                   }) )
+                       .forInterface(interfaceName);
+    TestProxy proxy(SERVICE_NAME, OBJECT_PATH);
+
+    double result{};
+    proxy.getProxy().callMethod("multiplyDownstream").onInterface(interfaceName).withArguments(int64_t{INT64_VALUE}, DOUBLE_VALUE).storeResultsTo(result);
+
+    ASSERT_THAT(result, DoubleEq(INT64_VALUE * DOUBLE_VALUE));
+    ASSERT_THROW(proxy.getProxy().callMethod("throwErrorDownstream").onInterface(interfaceName), sdbus::Error);
+
+    connection->releaseName(SERVICE_NAME);
+}
@@ -26,6 +26,7 @@
 
 // Own
 #include "Defs.h"
+#include "TestFixture.h"
 
 // sdbus
 #include <sdbus-c++/Error.h>
@@ -38,10 +39,44 @@
 // STL
 #include <thread>
 #include <chrono>
+#include <coroutine>
+#include <future>
+#include <mutex>
+#include <vector>
 
 using ::testing::Eq;
+using ::testing::ElementsAre;
 using namespace sdbus::test;
 
+namespace
+{
+    // Minimal eagerly started, self-destroying coroutine type to drive sdbus-c++ awaitables in tests
+    struct Coroutine
+    {
+        struct promise_type
+        {
+            Coroutine get_return_object() { return {}; }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+    };
+
+    Coroutine requestNameInCoroutine(sdbus::IConnection& connection, std::promise<void>& result)
+    {
+        try
+        {
+            co_await connection.requestNameAsync(SERVICE_NAME, sdbus::with_awaitable);
+            result.set_value();
+        }
+        catch (const sdbus::Error&)
+        {
+            result.set_exception(std::current_exception());
+        }
+    }
+}
+
 /*-------------------------------------*/
 /* --          TEST CASES           -- */
 /*-------------------------------------*/
@@ -68,6 +103,89 @@ TEST(SystemBusConnection, CannotRequestNonregisteredDbusName)
     ASSERT_THROW(connection->requestName(notSupportedBusName), sdbus::Error);
 }
 
+TEST(Connection, CanRequestNameAsynchronously)
+{
+    auto connection = sdbus::createBusConnection();
+    connection->enterEventLoopAsync();
+
+    auto future = connection->requestNameAsync(SERVICE_NAME, sdbus::with_future);
+
+    ASSERT_NO_THROW(future.get());
+    ASSERT_NO_THROW(connection->releaseName(SERVICE_NAME));
+}
+
+TEST(Connection, FailsAsyncRequestOfNameOwnedByAnotherConnection)
+{
+    auto owner = sdbus::createBusConnection(SERVICE_NAME);
+    auto connection = sdbus::createBusConnection();
+    connection->enterEventLoopAsync();
+
+    std::promise<std::optional<sdbus::Error>> outcome;
+    connection->requestNameAsync(SERVICE_NAME, [&](std::optional<sdbus::Error> error){ outcome.set_value(std::move(error)); });
+
+    auto error = outcome.get_future().get();
+    ASSERT_TRUE(error.has_value());
+    ASSERT_THAT(error->getName(), Eq(sdbus::createError(EEXIST, {}).getName()));
+}
+
+TEST(Connection, DropsFloatingNameRequestsOnceTheyAreReplied)
+{
+    auto connection = sdbus::createBusConnection();
+    connection->enterEventLoopAsync();
+
+    for (int i = 0; i < 3; ++i)
+    {
+        std::promise<std::optional<sdbus::Error>> outcome;
+        connection->requestNameAsync(SERVICE_NAME, [&](std::optional<sdbus::Error> error){ outcome.set_value(std::move(error)); });
+        (void)outcome.get_future().get();
+    }
+
+    ASSERT_TRUE(waitUntil([&](){ return connection->getResourceUsage().floatingNameRequests == 0; }));
+    connection->releaseName(SERVICE_NAME);
+}
+
+TEST(Connection, CanRequestNameFromCoroutine)
+{
+    auto connection = sdbus::createBusConnection();
+    connection->enterEventLoopAsync();
+
+    std::promise<void> result;
+    requestNameInCoroutine(*connection, result);
+
+    ASSERT_NO_THROW(result.get_future().get());
+}
+
+TEST(Connection, CanBeCreatedWithNameInBackground)
+{
+    auto futureConnection = sdbus::createBusConnectionAsync(SERVICE_NAME);
+    auto futureOtherConnection = sdbus::createBusConnectionAsync();
+
+    auto connection = futureConnection.get();
+    auto otherConnection = futureOtherConnection.get();
+
+    ASSERT_NO_THROW(connection->releaseName(SERVICE_NAME));
+    ASSERT_FALSE(otherConnection->getUniqueName().empty());
+}
+
+TEST(Connection, IsCreatedInBackgroundThreadSubjectToThreadCreationPolicy)
+{
+    std::mutex mutex;
+    std::vector<sdbus::ThreadRole> roles;
+    sdbus::setThreadCreationPolicy([&](sdbus::ThreadRole role)
+    {
+        std::lock_guard lock(mutex);
+        roles.push_back(role);
+        return sdbus::ThreadAttributes{};
+    });
+
+    auto connection = sdbus::createBusConnectionAsync().get();
+    sdbus::setThreadCreationPolicy({});
+
+    ASSERT_FALSE(connection->getUniqueName().empty());
+    std::lock_guard lock(mutex);
+    ASSERT_THAT(roles, ElementsAre(sdbus::ThreadRole::ConnectionSetup));
+}
+
 TEST(Connection, CanReleaseRequestedName)
 {
     auto connection = sdbus::createBusConnection();
@@ -84,6 +202,49 @@ TEST(Connection, CannotReleaseNonrequestedName)
     ASSERT_THROW(connection->releaseName(notAcquiredBusName), sdbus::Error);
 }
 
+TEST(Connection, TracksOwnerOfWatchedName)
+{
+    auto service = sdbus::createBusConnection();
+    auto client = sdbus::createBusConnection();
+    client->enterEventLoopAsync();
+    service->requestName(SERVICE_NAME);
+
+    auto watch = client->watchName(SERVICE_NAME, sdbus::return_slot);
+    ASSERT_THAT(client->getWatchedNameOwner(SERVICE_NAME), Eq(service->getUniqueName()));
+
+    service->releaseName(SERVICE_NAME);
+    ASSERT_TRUE(waitUntil([&](){ return client->getWatchedNameOwner(SERVICE_NAME).empty(); }));
+}
+
+TEST(Connection, FailsCallToWatchedNameWithoutOwnerRightAway)
+{
+    auto client = sdbus::createBusConnection();
+    auto watch = client->watchName(SERVICE_NAME, sdbus::return_slot);
+    auto proxy = sdbus::createProxy(*client, SERVICE_NAME, OBJECT_PATH);
+
+    try
+    {
+        proxy->createMethodCall(INTERFACE_NAME, sdbus::MethodName{"noArgNoReturn"});
+        FAIL() << "Expected sdbus::Error";
+    }
+    catch (const sdbus::Error& e)
+    {
+        ASSERT_THAT(e.getName(), Eq("org.freedesktop.DBus.Error.ServiceUnknown"));
+    }
+}
+
+TEST(Connection, StopsWatchingNameWhenWatchSlotIsDestroyed)
+{
+    auto client = sdbus::createBusConnection();
+    auto watch = client->watchName(SERVICE_NAME, sdbus::return_slot);
+    auto proxy = sdbus::createProxy(*client, SERVICE_NAME, OBJECT_PATH);
+
+    watch.reset();
+
+    ASSERT_THROW((void)client->getWatchedNameOwner(SERVICE_NAME), sdbus::Error);
+    ASSERT_NO_THROW(proxy->createMethodCall(INTERFACE_NAME, sdbus::MethodName{"noArgNoReturn"}));
+}
+
 TEST(Connection, CanEnterAndLeaveInternalEventLoop)
 {
     auto connection = sdbus::createBusConnection();
@@ -94,3 +255,30 @@ TEST(Connection, CanEnterAndLeaveInternalEventLoop)
 
     t.join();
 }
+
+TEST(Connection, FailsSyncCallInFlightWhenItsEventLoopIsLeft)
+{
+    auto service = sdbus::createBusConnection();
+    service->enterEventLoopAsync();
+    std::promise<void> released;
+    auto object = sdbus::createObject(*service, OBJECT_PATH);
+    object->addVTable(sdbus::registerMethod("wait").implementedAs([future = released.get_future().share()](){ future.wait(); }))
+          .forInterface(INTERFACE_NAME);
+    auto client = sdbus::createBusConnection();
+    client->enterEventLoopAsync();
+    auto proxy = sdbus::createProxy(*client, sdbus::ServiceName{service->getUniqueName()}, OBJECT_PATH);
+
+    std::thread leaver([&](){ std::this_thread::sleep_for(std::chrono::milliseconds(100)); client->leaveEventLoop(); });
+    try
+    {
+        proxy->callMethod("wait").onInterface(INTERFACE_NAME).withTimeout(UINT64_MAX);
+        FAIL() << "Expected sdbus::Error";
+    }
+    catch (const sdbus::Error& e)
+    {
+        ASSERT_THAT(e.getName(), Eq("org.freedesktop.DBus.Error.NoReply"));
+    }
+
+    leaver.join();
+    released.set_value();
+}
@@ -28,17 +28,25 @@
 #include "TestProxy.h"
 #include "TestFixture.h"
 #include "sdbus-c++/sdbus-c++.h"
+#if __has_include(<boost/asio/io_context.hpp>)
+#include "sdbus-c++/AsioEventLoopAdapter.h"
+#define SDBUS_TEST_WITH_ASIO
+#endif
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include <string>
 #include <thread>
 #include <tuple>
+#include <cassert>
 #include <chrono>
 #include <fstream>
 #include <future>
+#include <map>
+#include <set>
 #include <unistd.h>
 #include <variant>
+#include <vector>
 
 using ::testing::ElementsAre;
 using ::testing::Eq;
@@ -48,6 +56,27 @@ using namespace std::string_view_literals;
 
 using ADirectConnection = TestFixtureWithDirectConnection;
 
+namespace
+{
+    int openListeningSocket(const std::string& path)
+    {
+        int sock = socket(AF_UNIX, SOCK_STREAM|SOCK_CLOEXEC, 0);
+        assert(sock >= 0);
+
+        sockaddr_un sa{};
+        sa.sun_family = AF_UNIX;
+        snprintf(sa.sun_path, sizeof(sa.sun_path), "%s", path.c_str());
+        unlink(path.c_str());
+
+        [[maybe_unused]] int r = bind(sock, (const sockaddr*) &sa, sizeof(sa));
+        assert(r >= 0);
+        r = listen(sock, 16);
+        assert(r >= 0);
+
+        return sock;
+    }
+}
+
 /*-------------------------------------*/
 /* --          TEST CASES           -- */
 /*-------------------------------------*/
@@ -75,6 +104,294 @@ TEST(AnAdaptor, DoesNotSupportMoveSemantics)
     static_assert(!std::is_move_assignable_v<DummyTestAdaptor>);
 }
 
+TEST(AnEventLoop, DrivesServiceAndClientConnectionsInOneThread)
+{
+    auto serviceConnection = sdbus::createBusConnection();
+    serviceConnection->requestName(SERVICE_NAME);
+    auto clientConnection = sdbus::createBusConnection();
+    auto eventLoop = sdbus::createEventLoop();
+    eventLoop->attach(*serviceConnection);
+    eventLoop->attach(*clientConnection);
+    eventLoop->runAsync();
+    auto adaptor = std::make_unique<TestAdaptor>(*serviceConnection, OBJECT_PATH);
+    auto proxy = std::make_unique<TestProxy>(*clientConnection, SERVICE_NAME, OBJECT_PATH);
+
+    auto val = proxy->sumArrayItems({1, 7}, {2, 3, 4});
+    adaptor->emitSimpleSignal();
+
+    ASSERT_THAT(val, Eq(1 + 7 + 2 + 3 + 4));
+    ASSERT_TRUE(waitUntil(proxy->m_gotSimpleSignal));
+
+    proxy.reset();
+    adaptor.reset();
+    eventLoop->stop();
+    eventLoop->detach(*clientConnection);
+    eventLoop->detach(*serviceConnection);
+    serviceConnection->releaseName(SERVICE_NAME);
+}
+
+TEST(AnEventLoop, CannotAttachTheSameConnectionTwice)
+{
+    auto connection = sdbus::createBusConnection();
+    auto eventLoop = sdbus::createEventLoop();
+    eventLoop->attach(*connection);
+
+    ASSERT_THROW(eventLoop->attach(*connection), sdbus::Error);
+
+    eventLoop->detach(*connection);
+}
+
+TEST(AnEventLoop, WaitsForRunInUserThreadToReturnWhenStopped)
+{
+    auto connection = sdbus::createBusConnection();
+    auto eventLoop = sdbus::createEventLoop();
+    eventLoop->attach(*connection);
+    std::thread loopThread([&](){ eventLoop->run(); });
+    // A handler of the connection keeps the loop busy for a while
+    std::atomic<bool> handlerEntered{};
+    std::atomic<bool> handlerFinished{};
+    auto slot = connection->addMatch("type='signal',member='blockTheLoop'", [&](sdbus::Message)
+    {
+        handlerEntered = true;
+        std::this_thread::sleep_for(100ms);
+        handlerFinished = true;
+    }, sdbus::return_slot);
+    auto emitter = sdbus::createObject(*connection, sdbus::ObjectPath{"/org/sdbuscpp/emitter"});
+    emitter->emitSignal("blockTheLoop").onInterface(INTERFACE_NAME);
+    ASSERT_TRUE(waitUntil(handlerEntered));
+
+    eventLoop->stop();
+
+    EXPECT_TRUE(handlerFinished);
+    loopThread.join();
+    eventLoop->detach(*connection);
+}
+
+#ifdef SDBUS_TEST_WITH_ASIO
+TEST(AnAsioEventLoopAdapter, DrivesServiceAndClientConnectionsFromIoContext)
+{
+    auto serviceConnection = sdbus::createBusConnection();
+    serviceConnection->requestName(SERVICE_NAME);
+    auto clientConnection = sdbus::createBusConnection();
+    boost::asio::io_context ioContext;
+    auto serviceAdapter = std::make_unique<sdbus::AsioEventLoopAdapter>(ioContext, *serviceConnection);
+    auto clientAdapter = std::make_unique<sdbus::AsioEventLoopAdapter>(ioContext, *clientConnection);
+    auto workGuard = boost::asio::make_work_guard(ioContext);
+    std::thread ioThread([&](){ ioContext.run(); });
+    auto adaptor = std::make_unique<TestAdaptor>(*serviceConnection, OBJECT_PATH);
+    auto proxy = std::make_unique<TestProxy>(*clientConnection, SERVICE_NAME, OBJECT_PATH);
+
+    auto val = proxy->sumArrayItems({1, 7}, {2, 3, 4});
+    adaptor->emitSimpleSignal();
+
+    ASSERT_THAT(val, Eq(1 + 7 + 2 + 3 + 4));
+    ASSERT_TRUE(waitUntil(proxy->m_gotSimpleSignal));
+
+    proxy.reset();
+    adaptor.reset();
+    ioContext.stop();
+    ioThread.join();
+    clientAdapter.reset();
+    serviceAdapter.reset();
+    serviceConnection->releaseName(SERVICE_NAME);
+}
+#endif
+
+TEST(AConnectionPool, ShardsObjectPathsConsistentlyAcrossItsConnections)
+{
+    auto pool = sdbus::createConnectionPool(4, 2);
+
+    std::set<sdbus::IConnection*> usedConnections;
+    for (int i = 0; i < 64; ++i)
+    {
+        sdbus::ObjectPath objectPath{"/org/sdbuscpp/object" + std::to_string(i)};
+        auto& connection = pool->getConnection(objectPath);
+        ASSERT_THAT(&pool->getConnection(objectPath), Eq(&connection));
+        usedConnections.insert(&connection);
+    }
+
+    ASSERT_THAT(pool->getConnectionCount(), Eq(4));
+    ASSERT_THAT(usedConnections.size(), Eq(4));
+    ASSERT_THROW((void)pool->getConnection(std::size_t{4}), sdbus::Error);
+}
+
+TEST(AConnectionPool, DrivesProxiesCreatedUponPooledConnections)
+{
+    auto serviceConnection = sdbus::createBusConnection();
+    serviceConnection->requestName(SERVICE_NAME);
+    serviceConnection->enterEventLoopAsync();
+    auto adaptor = std::make_unique<TestAdaptor>(*serviceConnection, OBJECT_PATH);
+    auto pool = sdbus::createConnectionPool(3);
+    auto proxy = std::make_unique<TestProxy>(pool->getConnection(OBJECT_PATH), SERVICE_NAME, OBJECT_PATH);
+
+    auto val = proxy->sumArrayItems({1, 7}, {2, 3, 4});
+    adaptor->emitSimpleSignal();
+
+    ASSERT_THAT(val, Eq(1 + 7 + 2 + 3 + 4));
+    ASSERT_TRUE(waitUntil(proxy->m_gotSimpleSignal));
+
+    proxy.reset();
+    pool.reset();
+    adaptor.reset();
+    serviceConnection->releaseName(SERVICE_NAME);
+}
+
+TEST(ObjectsWithEqualVTables, ShareVTableLayoutButInvokeTheirOwnHandlers)
+{
+    auto serviceConnection = sdbus::createBusConnection();
+    serviceConnection->requestName(SERVICE_NAME);
+    serviceConnection->enterEventLoopAsync();
+    auto createObject = [&](const sdbus::ObjectPath& path, int32_t id)
+    {
+        auto object = sdbus::createObject(*serviceConnection, path);
+        object->addVTable( sdbus::registerMethod("getId").implementedAs([id](){ return id; })
+                         , sdbus::registerProperty("id").withGetter([id](){ return id; }) )
+                         .forInterface(INTERFACE_NAME);
+        return object;
+    };
+    auto object1 = createObject(OBJECT_PATH, 1);
+    auto object2 = createObject(OBJECT_PATH_2, 2);
+    auto getId = [&](const sdbus::ObjectPath& path)
+    {
+        int32_t id{};
+        sdbus::createProxy(SERVICE_NAME, path)->callMethod("getId").onInterface(INTERFACE_NAME).storeResultsTo(id);
+        return id;
+    };
+    auto getIdProperty = [&](const sdbus::ObjectPath& path)
+    {
+        return sdbus::createProxy(SERVICE_NAME, path)->getProperty("id").onInterface(INTERFACE_NAME).get<int32_t>();
+    };
+
+    ASSERT_THAT(getId(OBJECT_PATH), Eq(1));
+    ASSERT_THAT(getId(OBJECT_PATH_2), Eq(2));
+    ASSERT_THAT(getIdProperty(OBJECT_PATH), Eq(1));
+    ASSERT_THAT(getIdProperty(OBJECT_PATH_2), Eq(2));
+
+    object1.reset();
+    ASSERT_THAT(getId(OBJECT_PATH_2), Eq(2));
+
+    object2.reset();
+    serviceConnection->releaseName(SERVICE_NAME);
+}
+
+TEST(AMethodReturningExpected, RepliesWithErrorItReturnsAndProxyGetsItWithoutThrowing)
+{
+    auto serviceConnection = sdbus::createBusConnection();
+    serviceConnection->requestName(SERVICE_NAME);
+    serviceConnection->enterEventLoopAsync();
+    auto object = sdbus::createObject(*serviceConnection, OBJECT_PATH);
+    object->addVTable( sdbus::registerMethod("lookup").implementedAs([](int32_t key) -> sdbus::Expected<std::string>
+                                                       {
+                                                           if (key != 1)
+                                                               return sdbus::Error{sdbus::DBUS_ERROR_INVALID_ARGS, "No such key"};
+                                                           return std::string{"one"};
+                                                       })
+                     , sdbus::registerMethod("touch").implementedAs([]() -> sdbus::Expected<void>
+                                                       {
+                                                           return sdbus::Error{sdbus::DBUS_ERROR_ACCESS_DENIED, "Read-only"};
+                                                       }) )
+                     .forInterface(INTERFACE_NAME);
+    auto proxy = sdbus::createProxy(SERVICE_NAME, OBJECT_PATH);
+
+    std::string value;
+    auto found = proxy->callMethod("lookup").onInterface(INTERFACE_NAME).withArguments(1).storeResultsTo(std::nothrow, value);
+    auto notFound = proxy->callMethod("lookup").onInterface(INTERFACE_NAME).withArguments(2).storeResultsTo(std::nothrow, value);
+    auto touched = proxy->callMethod(proxy->createMethodCall(sdbus::InterfaceName{INTERFACE_NAME}, sdbus::MethodName{"touch"}), std::nothrow);
+
+    ASSERT_TRUE(found.has_value());
+    ASSERT_THAT(value, Eq("one"));
+    ASSERT_FALSE(notFound.has_value());
+    ASSERT_THAT(notFound.error().getName(), Eq(sdbus::DBUS_ERROR_INVALID_ARGS));
+    ASSERT_THAT(notFound.error().getMessage(), Eq("No such key"));
+    ASSERT_FALSE(touched);
+    ASSERT_THAT(touched.error().getName(), Eq(sdbus::DBUS_ERROR_ACCESS_DENIED));
+    ASSERT_THROW(touched.value(), sdbus::Error);
+
+    object.reset();
+    serviceConnection->releaseName(SERVICE_NAME);
+}
+
+TEST(ASubtreeVTable, ServesObjectsResolvedLazilyUnderItsPath)
+{
+    const sdbus::ObjectPath prefix{"/org/sdbuscpp/integrationtests/subtree"};
+    auto serviceConnection = sdbus::createBusConnection();
+    serviceConnection->requestName(SERVICE_NAME);
+    serviceConnection->enterEventLoopAsync();
+    auto object = sdbus::createObject(*serviceConnection, prefix);
+    auto isItem = [](std::string_view path){ return path.ends_with("/item1") || path.ends_with("/item2"); };
+    object->addSubtreeVTable( sdbus::InterfaceName{INTERFACE_NAME}
+                            , { sdbus::MethodVTableItem{ sdbus::MethodName{"getPath"}, sdbus::Signature{""}, {}, sdbus::Signature{"s"}, {"path"}
+                                                       , [](sdbus::MethodCall call)
+                                                         {
+                                                             auto reply = call.createReply();
+                                                             reply << std::string{call.getPath()};
+                                                             reply.send();
+                                                         }
+                                                       , {} } }
+                            , isItem );
+    object->addSubtreeEnumerator([&](std::string_view)
+    {
+        return std::vector<sdbus::ObjectPath>{sdbus::ObjectPath{prefix + "/item1"}, sdbus::ObjectPath{prefix + "/item2"}};
+    });
+    auto callGetPath = [&](const sdbus::ObjectPath& path)
+    {
+        std::string result;
+        sdbus::createProxy(SERVICE_NAME, path)->callMethod("getPath").onInterface(INTERFACE_NAME).storeResultsTo(result);
+        return result;
+    };
+
+    ASSERT_THAT(callGetPath(sdbus::ObjectPath{prefix + "/item1"}), Eq(prefix + "/item1"));
+    ASSERT_THAT(callGetPath(sdbus::ObjectPath{prefix + "/item2"}), Eq(prefix + "/item2"));
+    ASSERT_THROW(callGetPath(sdbus::ObjectPath{prefix + "/item3"}), sdbus::Error);
+
+    std::string introspection;
+    sdbus::createProxy(SERVICE_NAME, prefix)->callMethod("Introspect").onInterface("org.freedesktop.DBus.Introspectable").storeResultsTo(introspection);
+    ASSERT_THAT(introspection, ::testing::HasSubstr("<node name=\"item1\"/>"));
+    ASSERT_THAT(introspection, ::testing::HasSubstr("<node name=\"item2\"/>"));
+
+    object.reset();
+    serviceConnection->releaseName(SERVICE_NAME);
+}
+
+TEST(ObjectsAndProxies, ReportResourceUsageOfTheirRegistrations)
+{
+    auto serviceConnection = sdbus::createBusConnection();
+    serviceConnection->requestName(SERVICE_NAME);
+    serviceConnection->enterEventLoopAsync();
+    std::promise<void> released;
+    auto object = sdbus::createObject(*serviceConnection, OBJECT_PATH);
+    object->addVTable( sdbus::registerMethod("wait").implementedAs([future = released.get_future().share()](){ future.wait(); })
+                     , sdbus::registerProperty("id").withGetter([](){ return 1; })
+                     , sdbus::registerSignal("changed").withParameters<int32_t>() )
+                     .forInterface(INTERFACE_NAME);
+    object->addSubtreeEnumerator([](std::string_view){ return std::vector<sdbus::ObjectPath>{}; });
+    auto proxy = sdbus::createProxy(SERVICE_NAME, OBJECT_PATH);
+    proxy->uponSignal("changed").onInterface(INTERFACE_NAME).call([](int32_t){});
+    proxy->callMethodAsync("wait").onInterface(INTERFACE_NAME).uponReplyInvoke([](std::optional<sdbus::Error>){});
+
+    auto objectUsage = object->getResourceUsage();
+    auto proxyUsage = proxy->getResourceUsage();
+    released.set_value();
+
+    ASSERT_THAT(objectUsage.vtables, Eq(1u));
+    ASSERT_THAT(objectUsage.methods, Eq(1u));
+    ASSERT_THAT(objectUsage.properties, Eq(1u));
+    ASSERT_THAT(objectUsage.signals, Eq(1u));
+    ASSERT_THAT(objectUsage.subtreeEnumerators, Eq(1u));
+    ASSERT_THAT(objectUsage.approximateBytes, ::testing::Gt(0u));
+    ASSERT_THAT(proxyUsage.floatingSignalHandlers, Eq(1u));
+    ASSERT_THAT(proxyUsage.floatingAsyncCalls, Eq(1u));
+    ASSERT_THAT(proxyUsage.pendingAsyncCalls, Eq(1u));
+    ASSERT_THAT(proxyUsage.approximateBytes, ::testing::Gt(0u));
+
+    object->unregister();
+    ASSERT_THAT(object->getResourceUsage().vtables, Eq(0u));
+
+    proxy.reset();
+    object.reset();
+    serviceConnection->releaseName(SERVICE_NAME);
+}
+
 TYPED_TEST(AConnection, WillCallCallbackHandlerForIncomingMessageMatchingMatchRule)
 {
     auto matchRule = "sender='" + SERVICE_NAME + "',path='" + OBJECT_PATH + "'";
@@ -172,6 +489,129 @@ TYPED_TEST(AConnection, WillNotPassToMatchCallbackMessagesThatDoNotMatchTheRule)
     ASSERT_FALSE(waitUntil([&](){ return numberOfMatchingMessages > 2; }, 1s));
 }
 
+TYPED_TEST(AConnection, RelaysMethodCallsAndTheirRepliesThroughMessageBridge)
+{
+    const sdbus::ServiceName bridgeName{"org.sdbuscpp.integrationtests2"};
+    auto sourceConnection = sdbus::createBusConnection(bridgeName);
+    auto targetConnection = sdbus::createBusConnection();
+    auto bridge = sdbus::createMessageBridge(*sourceConnection, *targetConnection);
+    auto route = bridge->forwardMethodCalls( sdbus::ObjectPath{"/org/sdbuscpp/bridge"}
+                                           , SERVICE_NAME
+                                           , sdbus::ObjectPath{"/org/sdbuscpp/integrationtests"}
+                                           , sdbus::return_slot );
+    auto eventLoop = sdbus::createEventLoop();
+    eventLoop->attach(*sourceConnection);
+    eventLoop->attach(*targetConnection);
+    eventLoop->runAsync();
+    auto proxy = std::make_unique<TestProxy>(*this->s_proxyConnection, bridgeName, sdbus::ObjectPath{"/org/sdbuscpp/bridge/ObjectA1"});
+
+    auto val = proxy->sumArrayItems({1, 7}, {2, 3, 4});
+    auto complex = proxy->getComplex();
+
+    ASSERT_THAT(val, Eq(1 + 7 + 2 + 3 + 4));
+    ASSERT_THAT(complex.count(0), Eq(1));
+    try
+    {
+        proxy->throwError();
+        FAIL() << "Expected sdbus::Error exception";
+    }
+    catch (const sdbus::Error& e)
+    {
+        ASSERT_THAT(e.getName(), Eq("org.freedesktop.DBus.Error.AccessDenied"));
+    }
+    ASSERT_THAT(bridge->getPendingCallCount(), Eq(0));
+
+    proxy.reset();
+    route.reset();
+    bridge.reset();
+    eventLoop->stop();
+    eventLoop->detach(*targetConnection);
+    eventLoop->detach(*sourceConnection);
+}
+
+TYPED_TEST(AConnection, RelaysSignalsThroughMessageBridge)
+{
+    auto sourceConnection = sdbus::createBusConnection();
+    auto targetConnection = sdbus::createBusConnection();
+    auto bridge = sdbus::createMessageBridge(*sourceConnection, *targetConnection);
+    auto eventLoop = sdbus::createEventLoop();
+    eventLoop->attach(*sourceConnection);
+    eventLoop->attach(*targetConnection);
+    eventLoop->runAsync();
+    auto route = bridge->forwardSignals("type='signal',sender='" + SERVICE_NAME + "',member='signalWithMap'", sdbus::return_slot);
+    std::map<int32_t, std::string> relayedMap;
+    std::atomic<bool> relayedSignalReceived{false};
+    auto matchRule = "type='signal',sender='" + targetConnection->getUniqueName() + "',member='signalWithMap'";
+    auto slot = this->s_proxyConnection->addMatch(matchRule, [&](sdbus::Message msg)
+    {
+        if (msg.getPath() == OBJECT_PATH)
+        {
+            msg >> relayedMap;
+            relayedSignalReceived = true;
+        }
+    }, sdbus::return_slot);
+
+    const std::map<int32_t, std::string> aMap{{0, "zero"}, {1, "one"}};
+    this->m_adaptor->emitSignalWithMap(aMap);
+
+    ASSERT_TRUE(waitUntil(relayedSignalReceived));
+    ASSERT_THAT(relayedMap, Eq(aMap));
+
+    route.reset();
+    bridge.reset();
+    eventLoop->stop();
+    eventLoop->detach(*targetConnection);
+    eventLoop->detach(*sourceConnection);
+}
+
+TYPED_TEST(AConnection, RelaysMethodCallsThroughMessageBridgeBetweenConnectionsRunningSeparateEventLoops)
+{
+    const sdbus::ServiceName bridgeName{"org.sdbuscpp.integrationtests2"};
+    auto sourceConnection = sdbus::createBusConnection(bridgeName);
+    auto targetConnection = sdbus::createBusConnection();
+    auto bridge = sdbus::createMessageBridge(*sourceConnection, *targetConnection);
+    auto route = bridge->forwardMethodCalls( sdbus::ObjectPath{"/org/sdbuscpp/bridge"}
+                                           , SERVICE_NAME
+                                           , sdbus::ObjectPath{"/org/sdbuscpp/integrationtests"}
+                                           , sdbus::return_slot );
+    sourceConnection->enterEventLoopAsync();
+    targetConnection->enterEventLoopAsync();
+    auto proxy = std::make_unique<TestProxy>(*this->s_proxyConnection, bridgeName, sdbus::ObjectPath{"/org/sdbuscpp/bridge/ObjectA1"});
+
+    // Calls and their replies cross the two event loop threads in both directions all the time
+    std::atomic<int> failedCalls{0};
+    std::vector<std::thread> callers;
+    for (int i = 0; i < 4; ++i)
+    {
+        callers.emplace_back([&]()
+        {
+            for (int j = 0; j < 100; ++j)
+            {
+                try
+                {
+                    if (proxy->sumArrayItems({1, 7}, {2, 3, 4}) != 1 + 7 + 2 + 3 + 4)
+                        ++failedCalls;
+                }
+                catch (const sdbus::Error&)
+                {
+                    ++failedCalls;
+                }
+            }
+        });
+    }
+    for (auto& caller : callers)
+        caller.join();
+
+    ASSERT_THAT(failedCalls, Eq(0));
+    ASSERT_TRUE(waitUntil([&](){ return bridge->getPendingCallCount() == 0; }));
+
+    proxy.reset();
+    route.reset();
+    bridge.reset();
+    targetConnection->leaveEventLoop();
+    sourceConnection->leaveEventLoop();
+}
+
 // A simple direct connection test similar in nature to https://github.com/systemd/systemd/blob/main/src/libsystemd/sd-bus/test-bus-server.c
 TEST_F(ADirectConnection, CanBeUsedBetweenClientAndServer)
 {
@@ -182,3 +622,83 @@ TEST_F(ADirectConnection, CanBeUsedBetweenClientAndServer)
     ASSERT_THAT(val, Eq(1 + 7 + 2 + 3 + 4));
     ASSERT_TRUE(waitUntil(m_proxy->m_gotSimpleSignal));
 }
+
+TEST(APeerServer, BroadcastsSignalToAllConnectedClients)
+{
+    const auto socketPath = DIRECT_CONNECTION_SOCKET_PATH + "-peer-server";
+    auto sock = openListeningSocket(socketPath);
+    auto eventLoop = sdbus::createEventLoop();
+    auto server = sdbus::createPeerServer(sock, *eventLoop);
+    eventLoop->runAsync();
+    std::vector<std::unique_ptr<sdbus::IConnection>> clientConnections;
+    std::vector<std::unique_ptr<TestProxy>> proxies;
+    for (int i = 0; i < 3; ++i)
+    {
+        auto& connection = clientConnections.emplace_back(sdbus::createDirectBusConnection("unix:path=" + socketPath));
+        connection->enterEventLoopAsync();
+        proxies.push_back(std::make_unique<TestProxy>(*connection, EMPTY_DESTINATION, OBJECT_PATH));
+    }
+    ASSERT_TRUE(waitUntil([&](){ return server->getPeerCount() == 3; }));
+
+    const std::map<int32_t, std::string> aMap{{0, "zero"}, {1, "one"}};
+    auto sentCount = server->getBroadcastGroup().broadcastSignal(OBJECT_PATH, INTERFACE_NAME, sdbus::SignalName{"signalWithMap"}, aMap);
+
+    ASSERT_THAT(sentCount, Eq(3));
+    for (const auto& proxy : proxies)
+    {
+        ASSERT_TRUE(waitUntil(proxy->m_gotSignalWithMap));
+        ASSERT_THAT(proxy->m_mapFromSignal, Eq(aMap));
+    }
+
+    proxies.clear();
+    clientConnections.clear();
+    server.reset();
+    eventLoop->stop();
+    close(sock);
+}
+
+TEST(ABroadcastGroup, DropsMembersDestroyedWithoutRemoval)
+{
+    auto group = sdbus::createBroadcastGroup();
+    auto connection1 = sdbus::createBusConnection();
+    auto connection2 = sdbus::createBusConnection();
+    group->add(*connection1);
+    group->add(*connection2);
+
+    connection1.reset();
+
+    ASSERT_THAT(group->getConnectionCount(), Eq(1));
+    ASSERT_THAT(group->broadcastSignal(OBJECT_PATH, INTERFACE_NAME, sdbus::SignalName{"simpleSignal"}), Eq(1));
+}
+
+TEST(APeerServer, ReleasesClientsThatDisconnect)
+{
+    const auto socketPath = DIRECT_CONNECTION_SOCKET_PATH + "-peer-server";
+    auto sock = openListeningSocket(socketPath);
+    auto eventLoop = sdbus::createEventLoop();
+    std::atomic<int> connectedCount{};
+    std::atomic<int> disconnectedCount{};
+    auto server = sdbus::createPeerServer( sock
+                                         , *eventLoop
+                                         , [&](sdbus::IConnection&){ ++connectedCount; }
+                                         , [&](sdbus::IConnection&){ ++disconnectedCount; } );
+    eventLoop->runAsync();
+    auto clientConnection1 = sdbus::createDirectBusConnection("unix:path=" + socketPath);
+    auto clientConnection2 = sdbus::createDirectBusConnection("unix:path=" + socketPath);
+    clientConnection2->enterEventLoopAsync();
+    auto proxy = std::make_unique<TestProxy>(*clientConnection2, EMPTY_DESTINATION, OBJECT_PATH);
+    ASSERT_TRUE(waitUntil([&](){ return connectedCount == 2; }));
+
+    clientConnection1.reset();
+
+    ASSERT_TRUE(waitUntil([&](){ return disconnectedCount == 1 && server->getPeerCount() == 1; }));
+    ASSERT_THAT(server->getBroadcastGroup().getConnectionCount(), Eq(1));
+    ASSERT_THAT(server->getBroadcastGroup().broadcastSignal(OBJECT_PATH, INTERFACE_NAME, sdbus::SignalName{"simpleSignal"}), Eq(1));
+    ASSERT_TRUE(waitUntil(proxy->m_gotSimpleSignal));
+
+    proxy.reset();
+    server.reset();
+    ASSERT_THAT(disconnectedCount, Eq(2));
+    eventLoop->stop();
+    close(sock);
+}
@@ -31,22 +31,30 @@
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <algorithm>
+#include <atomic>
 #include <string>
 #include <thread>
 #include <tuple>
+#include <type_traits>
 #include <chrono>
+#include <filesystem>
 #include <fstream>
 #include <future>
+#include <mutex>
+#include <vector>
 #include <unistd.h>
 
 using ::testing::Eq;
 using ::testing::DoubleEq;
 using ::testing::Gt;
+using ::testing::Ge;
 using ::testing::Le;
 using ::testing::AnyOf;
 using ::testing::ElementsAre;
 using ::testing::SizeIs;
 using ::testing::NotNull;
+using ::testing::Optional;
 using namespace std::chrono_literals;
 using namespace std::string_literals;
 using namespace sdbus::test;
@@ -64,6 +72,18 @@ namespace my {
 
 SDBUSCPP_REGISTER_STRUCT(my::Struct, i, s, l);
 
+namespace {
+    // Counts method calls the connection has made over the bus so far, from its sd-bus lock profiles
+    uint64_t countCallsOverBus(const sdbus::IConnection& connection)
+    {
+        uint64_t calls{};
+        for (const auto& profile : connection.getMetrics().busLockProfiles)
+            if (profile.function.starts_with("sd_bus_call"))
+                calls += profile.acquisitions;
+        return calls;
+    }
+}
+
 /*-------------------------------------*/
 /* --          TEST CASES           -- */
 /*-------------------------------------*/
@@ -208,6 +228,45 @@ TYPED_TEST(SdbusTestObject, ThrowsTimeoutErrorWhenMethodTimesOut)
     }
 }
 
+TYPED_TEST(SdbusTestObject, ShortensMethodCallTimeoutToDeadlineOfEnclosingScope)
+{
+    auto start = std::chrono::steady_clock::now();
+    sdbus::DeadlineScope deadline{50ms};
+
+    // The operation will take 1s and the timeout is 10s, but the deadline is in 50ms, so we should time out
+    ASSERT_THROW(this->m_proxy->doOperationWithTimeout(10s, (1000ms).count()), sdbus::Error);
+
+    auto measuredTimeout = std::chrono::steady_clock::now() - start;
+    ASSERT_THAT(measuredTimeout, Le(200ms));
+}
+
+TYPED_TEST(SdbusTestObject, FailsMethodCallRightAwayWhenDeadlineHasPassed)
+{
+    sdbus::DeadlineScope deadline{std::chrono::steady_clock::now() - 1ms};
+
+    try
+    {
+        this->m_proxy->doOperation(0);
+        FAIL() << "Expected sdbus::Error exception";
+    }
+    catch (const sdbus::Error& e)
+    {
+        ASSERT_THAT(e.getName(), Eq("org.freedesktop.DBus.Error.Timeout"));
+    }
+}
+
+TYPED_TEST(SdbusTestObject, DoesNotExtendDeadlineInNestedScope)
+{
+    sdbus::DeadlineScope outerDeadline{50ms};
+    {
+        sdbus::DeadlineScope innerDeadline{10s};
+
+        ASSERT_THAT(*sdbus::DeadlineScope::current(), Le(std::chrono::steady_clock::now() + 50ms));
+    }
+
+    ASSERT_THAT(sdbus::DeadlineScope::current().has_value(), Eq(true));
+}
+
 TYPED_TEST(SdbusTestObject, CallsMethodThatThrowsError)
 {
     try
@@ -278,6 +337,27 @@ TYPED_TEST(SdbusTestObject, CanSendAndReceiveDictionariesAsCustomStructsImplicit
     ASSERT_THAT(structReceived, Eq(structSent));
 }
 
+TYPED_TEST(SdbusTestObject, CallsMethodRepeatedlyThroughPreparedMethodCall)
+{
+    auto preparedCall = this->m_proxy->getProxy().prepareMethodCall(INTERFACE_NAME, sdbus::MethodName{"doOperation"});
+
+    for (uint32_t param : {10u, 20u, 30u})
+    {
+        auto methodCall = preparedCall.createMethodCall();
+        methodCall << param;
+        auto reply = this->m_proxy->getProxy().callMethod(methodCall);
+        uint32_t result{};
+        reply >> result;
+
+        ASSERT_THAT(result, Eq(param));
+    }
+}
+
+TYPED_TEST(SdbusTestObject, FailsPreparingMethodCallWithInvalidMethodName)
+{
+    ASSERT_THROW(this->m_proxy->getProxy().prepareMethodCall(INTERFACE_NAME, sdbus::MethodName{"do.Operation"}), sdbus::Error);
+}
+
 TYPED_TEST(SdbusTestObject, CanAccessAssociatedMethodCallMessageInMethodCallHandler)
 {
     this->m_proxy->doOperation(10); // This will save pointer to method call message on server side
@@ -286,6 +366,150 @@ TYPED_TEST(SdbusTestObject, CanAccessAssociatedMethodCallMessageInMethodCallHand
     ASSERT_THAT(this->m_adaptor->m_methodName, Eq("doOperation"));
 }
 
+TYPED_TEST(SdbusTestObject, CallsMethodAddressedToOwnerOfWatchedDestination)
+{
+    auto watch = this->s_proxyConnection->watchName(SERVICE_NAME, sdbus::return_slot);
+
+    auto result = this->m_proxy->doOperation(1);
+
+    ASSERT_THAT(result, Eq(1));
+    ASSERT_THAT(this->m_adaptor->m_methodCallMsg->getDestination(), Eq(std::string{this->s_adaptorConnection->getUniqueName()}));
+}
+
+TYPED_TEST(SdbusTestObject, DispatchesMethodCallsBetweenConnectionsOfTheProcessLocally)
+{
+    this->s_proxyConnection->enableBusLockProfiling();
+    this->s_adaptorConnection->enableLocalDispatch();
+    this->s_proxyConnection->enableLocalDispatch();
+    const auto callsOverBus = countCallsOverBus(*this->s_proxyConnection);
+
+    auto result = this->m_proxy->doOperation(10);
+    auto asyncResult = this->m_proxy->doOperationClientSideAsync(20, sdbus::with_future);
+
+    ASSERT_THAT(result, Eq(10));
+    ASSERT_THAT(this->m_adaptor->m_methodCallMsg->getSender(), Eq(std::string{this->s_proxyConnection->getUniqueName()}));
+    ASSERT_THAT(asyncResult.get(), Eq(20));
+    ASSERT_THROW(this->m_proxy->throwError(), sdbus::Error);
+    ASSERT_THAT(countCallsOverBus(*this->s_proxyConnection), Eq(callsOverBus));
+
+    this->s_proxyConnection->enableLocalDispatch(false);
+    this->s_adaptorConnection->enableLocalDispatch(false);
+    this->s_proxyConnection->enableBusLockProfiling(false);
+}
+
+TYPED_TEST(SdbusTestObject, TimesOutLocallyDispatchedMethodCall)
+{
+    this->s_adaptorConnection->enableLocalDispatch();
+    this->s_proxyConnection->enableLocalDispatch();
+
+    auto start = std::chrono::steady_clock::now();
+    try
+    {
+        this->m_proxy->doOperationWithTimeout(10ms, (200ms).count());
+        FAIL() << "Expected sdbus::Error exception";
+    }
+    catch (const sdbus::Error& e)
+    {
+        ASSERT_THAT(e.getName(), Eq("org.freedesktop.DBus.Error.NoReply"));
+        ASSERT_THAT(std::chrono::steady_clock::now() - start, Le(100ms));
+    }
+
+    this->s_proxyConnection->enableLocalDispatch(false);
+    this->s_adaptorConnection->enableLocalDispatch(false);
+}
+
+TYPED_TEST(SdbusTestObject, FailsPendingLocallyDispatchedCallsWhenLocalDispatchIsDisabled)
+{
+    this->s_adaptorConnection->enableLocalDispatch();
+    this->s_proxyConnection->enableLocalDispatch();
+    auto asyncResult = this->m_proxy->doOperationClientSideAsync(200, sdbus::with_future);
+    std::this_thread::sleep_for(50ms);
+
+    this->s_proxyConnection->enableLocalDispatch(false);
+
+    try
+    {
+        asyncResult.get();
+        FAIL() << "Expected sdbus::Error exception";
+    }
+    catch (const sdbus::Error& e)
+    {
+        ASSERT_THAT(e.getName(), Eq("org.freedesktop.DBus.Error.NoReply"));
+    }
+    this->s_adaptorConnection->enableLocalDispatch(false);
+}
+
+TYPED_TEST(SdbusTestObject, SendsMethodCallWithMismatchingArgumentsOverBusDespiteLocalDispatch)
+{
+    this->s_proxyConnection->enableBusLockProfiling();
+    this->s_adaptorConnection->enableLocalDispatch();
+    this->s_proxyConnection->enableLocalDispatch();
+    const auto callsOverBus = countCallsOverBus(*this->s_proxyConnection);
+    auto proxy = sdbus::createProxy(*this->s_proxyConnection, SERVICE_NAME, OBJECT_PATH);
+
+    try
+    {
+        proxy->callMethod("doOperation").onInterface(INTERFACE_NAME).withArguments("not a number"s);
+        FAIL() << "Expected sdbus::Error exception";
+    }
+    catch (const sdbus::Error& e)
+    {
+        ASSERT_THAT(e.getName(), Eq("org.freedesktop.DBus.Error.InvalidArgs"));
+    }
+    ASSERT_THAT(countCallsOverBus(*this->s_proxyConnection), Eq(callsOverBus + 1));
+
+    this->s_proxyConnection->enableLocalDispatch(false);
+    this->s_adaptorConnection->enableLocalDispatch(false);
+    this->s_proxyConnection->enableBusLockProfiling(false);
+}
+
+TYPED_TEST(SdbusTestObject, SendsMethodCallToUnknownObjectOrInterfaceOverBusDespiteLocalDispatch)
+{
+    this->s_proxyConnection->enableBusLockProfiling();
+    this->s_adaptorConnection->enableLocalDispatch();
+    this->s_proxyConnection->enableLocalDispatch();
+    const auto callsOverBus = countCallsOverBus(*this->s_proxyConnection);
+    auto proxy = sdbus::createProxy(*this->s_proxyConnection, SERVICE_NAME, sdbus::ObjectPath{"/org/sdbuscpp/unknown"});
+
+    ASSERT_THROW(proxy->callMethod("doOperation").onInterface(INTERFACE_NAME).withArguments(uint32_t{1}), sdbus::Error);
+    ASSERT_THROW(this->m_proxy->callMethodOnNonexistentInterface(), sdbus::Error);
+    ASSERT_THROW(this->m_proxy->callNonexistentMethod(), sdbus::Error);
+    ASSERT_THAT(countCallsOverBus(*this->s_proxyConnection), Eq(callsOverBus + 3));
+
+    this->s_proxyConnection->enableLocalDispatch(false);
+    this->s_adaptorConnection->enableLocalDispatch(false);
+    this->s_proxyConnection->enableBusLockProfiling(false);
+}
+
+TYPED_TEST(SdbusTestObject, GetsRequestedSenderCredentialsOfMethodCallAtOnce)
+{
+    this->m_proxy->doOperation(0); // This will save pointer to method call message on server side
+    ASSERT_THAT(this->m_adaptor->m_methodCallMsg, NotNull());
+
+    auto creds = this->m_adaptor->m_methodCallMsg->getCreds(sdbus::Credentials::Pid | sdbus::Credentials::Uid);
+
+    ASSERT_THAT(creds.pid, Optional(getpid()));
+    ASSERT_THAT(creds.uid, Optional(getuid()));
+    ASSERT_FALSE(creds.euid.has_value());
+}
+
+TYPED_TEST(SdbusTestObject, GetsSameSenderCredentialsFromCredentialsCache)
+{
+    this->s_adaptorConnection->enableCredentialsCache();
+    this->m_proxy->doOperation(0);
+    ASSERT_THAT(this->m_adaptor->m_methodCallMsg, NotNull());
+
+    auto queried = this->m_adaptor->m_methodCallMsg->getCreds(sdbus::Credentials::Pid);
+    auto cached = this->m_adaptor->m_methodCallMsg->getCreds(sdbus::Credentials::Pid);
+    auto extended = this->m_adaptor->m_methodCallMsg->getCreds(sdbus::Credentials::Pid | sdbus::Credentials::Uid);
+    this->s_adaptorConnection->enableCredentialsCache(false);
+
+    ASSERT_THAT(queried.pid, Optional(getpid()));
+    ASSERT_THAT(cached.pid, Optional(getpid()));
+    ASSERT_THAT(extended.pid, Optional(getpid()));
+    ASSERT_THAT(extended.uid, Optional(getuid()));
+}
+
 TYPED_TEST(SdbusTestObject, CanAccessAssociatedMethodCallMessageInAsyncMethodCallHandler)
 {
     this->m_proxy->doOperationAsync(10); // This will save pointer to method call message on server side
@@ -341,6 +565,21 @@ TYPED_TEST(SdbusTestObject, CanCallMethodSynchronouslyWithoutAnEventLoopThread)
     ASSERT_THAT(multiplyRes, Eq(INT64_VALUE * DOUBLE_VALUE));
 }
 
+TYPED_TEST(SdbusTestObject, DoesNotSerializeConcurrentSynchronousCallsOverConnectionWithEventLoopThread)
+{
+    if constexpr (!std::is_same_v<TypeParam, SdBusCppLoop>)
+        GTEST_SKIP() << "Synchronous calls are made through the event loop only when it runs in an internal thread";
+
+    // Each operation takes 300ms in its own thread on the server side. Made one after another, the calls would take 600ms.
+    auto start = std::chrono::steady_clock::now();
+    auto otherCall = std::async(std::launch::async, [this](){ return this->m_proxy->doOperationAsync(300); });
+    auto result = this->m_proxy->doOperationAsync(300);
+
+    ASSERT_THAT(otherCall.get(), Eq(300));
+    ASSERT_THAT(result, Eq(300));
+    ASSERT_THAT(std::chrono::steady_clock::now() - start, Le(500ms));
+}
+
 TYPED_TEST(SdbusTestObject, CanRegisterAdditionalVTableDynamicallyAtAnyTime)
 {
     auto& object = this->m_adaptor->getObject();
@@ -373,3 +612,538 @@ TYPED_TEST(SdbusTestObject, CanUnregisterAdditionallyRegisteredVTableAtAnyTime)
     auto proxy = sdbus::createLightWeightProxy(SERVICE_NAME, OBJECT_PATH);
     ASSERT_THROW(proxy->callMethod("subtract").onInterface(interfaceName).withArguments(10, 2), sdbus::Error);
 }
+
+TYPED_TEST(SdbusTestObject, CanRegisterStaticVTableWithHandlersOfTheObject)
+{
+    static const sdbus::StaticVTable vtable{ sdbus::InterfaceName{"org.sdbuscpp.integrationtests2"}
+                                           , { sdbus::registerProperty("state").withValueType<uint32_t>().markAsWritable()
+                                             , sdbus::registerMethod("subtract").withSignatureOf<int(int, int)>() } };
+    uint32_t state{42};
+    auto vtableSlot = this->m_adaptor->getObject().addVTable( vtable
+                                                            , { sdbus::implementProperty([&](){ return state; }, [&](uint32_t value){ state = value; })
+                                                              , sdbus::implementMethod([](const int& a, const int& b){ return a - b; }) }
+                                                            , sdbus::return_slot );
+
+    auto proxy = sdbus::createLightWeightProxy(SERVICE_NAME, OBJECT_PATH);
+    int result{};
+    proxy->callMethod("subtract").onInterface(vtable.getInterfaceName()).withArguments(10, 2).storeResultsTo(result);
+    proxy->setProperty("state").onInterface(vtable.getInterfaceName()).toValue(uint32_t{7});
+
+    ASSERT_THAT(result, Eq(8));
+    ASSERT_THAT(proxy->getProperty("state").onInterface(vtable.getInterfaceName()).get<uint32_t>(), Eq(7u));
+}
+
+TYPED_TEST(SdbusTestObject, CannotRegisterStaticVTableWithHandlersNotMatchingItsLayout)
+{
+    static const sdbus::StaticVTable vtable{ sdbus::InterfaceName{"org.sdbuscpp.integrationtests2"}
+                                           , { sdbus::registerMethod("subtract").withSignatureOf<int(int, int)>()
+                                             , sdbus::registerProperty("state").withValueType<uint32_t>().markAsWritable() } };
+    auto& object = this->m_adaptor->getObject();
+    auto subtract = [](const int& a, const int& b){ return a - b; };
+    auto getState = [](){ return uint32_t{}; };
+
+    ASSERT_THROW(object.addVTable(vtable, {sdbus::implementMethod(subtract)}), sdbus::Error);
+    ASSERT_THROW(object.addVTable(vtable, {sdbus::implementProperty(getState), sdbus::implementMethod(subtract)}), sdbus::Error);
+    ASSERT_THROW(object.addVTable(vtable, {sdbus::implementMethod(subtract), sdbus::implementProperty(getState)}), sdbus::Error);
+}
+
+TYPED_TEST(SdbusTestObject, ServesRepeatedCallsWithCachedResultsFromCache)
+{
+    std::atomic<int> callCount{};
+    sdbus::InterfaceName interfaceName{"org.sdbuscpp.integrationtests2"};
+    auto vtableSlot = this->m_adaptor->getObject().addVTable( interfaceName
+                                                            , { sdbus::registerMethod("lookup").implementedAs([&](const uint32_t& id){ ++callCount; return std::to_string(id); }) }
+                                                            , sdbus::return_slot );
+    auto& proxy = this->m_proxy->getProxy();
+    auto lookup = [&](uint32_t id)
+    {
+        std::string result;
+        proxy.callMethod("lookup").onInterface(interfaceName).cacheResults().withArguments(id).storeResultsTo(result);
+        return result;
+    };
+
+    auto result1 = lookup(1);
+    auto result2 = lookup(2);
+    auto cachedResult1 = lookup(1);
+
+    ASSERT_THAT(result1, Eq("1"));
+    ASSERT_THAT(result2, Eq("2"));
+    ASSERT_THAT(cachedResult1, Eq("1"));
+    ASSERT_THAT(callCount, Eq(2));
+}
+
+TYPED_TEST(SdbusTestObject, RefusesToCacheResultsOfCallWithArgumentsAlreadySet)
+{
+    std::atomic<int> callCount{};
+    sdbus::InterfaceName interfaceName{"org.sdbuscpp.integrationtests2"};
+    auto vtableSlot = this->m_adaptor->getObject().addVTable( interfaceName
+                                                            , { sdbus::registerMethod("lookup").implementedAs([&](const uint32_t& id){ ++callCount; return std::to_string(id); }) }
+                                                            , sdbus::return_slot );
+    auto& proxy = this->m_proxy->getProxy();
+
+    ASSERT_THROW(proxy.callMethod("lookup").onInterface(interfaceName).withArguments(uint32_t{1}).cacheResults(), sdbus::Error);
+    ASSERT_THAT(callCount, Eq(0));
+}
+
+TYPED_TEST(SdbusTestObject, CallsMethodAgainOnceCachedResultsExpire)
+{
+    std::atomic<int> callCount{};
+    sdbus::InterfaceName interfaceName{"org.sdbuscpp.integrationtests2"};
+    auto vtableSlot = this->m_adaptor->getObject().addVTable( interfaceName
+                                                            , { sdbus::registerMethod("getVersion").implementedAs([&](){ return ++callCount; }) }
+                                                            , sdbus::return_slot );
+    auto& proxy = this->m_proxy->getProxy();
+    int version{};
+
+    proxy.callMethod("getVersion").onInterface(interfaceName).cacheResultsFor(50ms).storeResultsTo(version);
+    proxy.callMethod("getVersion").onInterface(interfaceName).cacheResultsFor(50ms).storeResultsTo(version);
+    ASSERT_THAT(version, Eq(1));
+    std::this_thread::sleep_for(100ms);
+    proxy.callMethod("getVersion").onInterface(interfaceName).cacheResultsFor(50ms).storeResultsTo(version);
+
+    ASSERT_THAT(version, Eq(2));
+}
+
+TYPED_TEST(SdbusTestObject, DropsCachedResultsWhenServiceOwnerChanges)
+{
+    std::atomic<int> callCount{};
+    sdbus::InterfaceName interfaceName{"org.sdbuscpp.integrationtests2"};
+    auto vtableSlot = this->m_adaptor->getObject().addVTable( interfaceName
+                                                            , { sdbus::registerMethod("getVersion").implementedAs([&](){ return ++callCount; }) }
+                                                            , sdbus::return_slot );
+    auto& proxy = this->m_proxy->getProxy();
+    auto getVersion = [&]()
+    {
+        int version{};
+        proxy.callMethod("getVersion").onInterface(interfaceName).cacheResults().storeResultsTo(version);
+        return version;
+    };
+    ASSERT_THAT(getVersion(), Eq(1));
+
+    this->s_adaptorConnection->releaseName(SERVICE_NAME);
+    this->s_adaptorConnection->requestName(SERVICE_NAME);
+
+    ASSERT_TRUE(waitUntil([&](){ return getVersion() == 2; }));
+}
+
+TEST(AnAdaptorWithDispatchPool, HandlesMethodCallsInWorkerThreads)
+{
+    auto connection = sdbus::createBusConnection();
+    connection->requestName(SERVICE_NAME);
+    connection->enableMethodCallDispatchPool(2);
+    connection->enterEventLoopAsync();
+    auto mainThreadId = std::this_thread::get_id();
+    std::thread::id handlerThreadId;
+    TestAdaptor adaptor(*connection, OBJECT_PATH);
+    sdbus::InterfaceName interfaceName{"org.sdbuscpp.integrationtests2"};
+    adaptor.getObject().addVTable(sdbus::registerMethod("add").implementedAs([&](const int64_t& a, const double& b)
+                                  {
+                                      handlerThreadId = std::this_thread::get_id();
+                                      return a + b;
+                                  }))
+                       .forInterface(interfaceName);
+    TestProxy proxy(SERVICE_NAME, OBJECT_PATH);
+
+    double result{};
+    proxy.getProxy().callMethod("add").onInterface(interfaceName).withArguments(int64_t{INT64_VALUE}, DOUBLE_VALUE).storeResultsTo(result);
+
+    ASSERT_THAT(result, DoubleEq(INT64_VALUE + DOUBLE_VALUE));
+    ASSERT_NE(handlerThreadId, mainThreadId);
+    ASSERT_THROW(proxy.throwError(), sdbus::Error);
+
+    connection->releaseName(SERVICE_NAME);
+}
+
+TEST(AnAdaptorWithDispatchPool, FailsQueuedCallsAndWaitsForRunningHandlerWhenUnregistered)
+{
+    auto connection = sdbus::createBusConnection();
+    connection->enableMethodCallDispatchPool(1);
+    connection->enterEventLoopAsync();
+    std::promise<void> entered;
+    std::promise<void> released;
+    std::atomic<int> handledCalls{};
+    std::atomic<bool> handlerFinished{};
+    auto object = sdbus::createObject(*connection, OBJECT_PATH);
+    object->addVTable(sdbus::registerMethod("wait").implementedAs([&, future = released.get_future().share()]()
+          {
+              if (handledCalls++ == 0)
+                  entered.set_value();
+              future.wait();
+              handlerFinished = true;
+          }))
+          .forInterface(INTERFACE_NAME);
+    auto client = sdbus::createBusConnection();
+    client->enterEventLoopAsync();
+    auto proxy = sdbus::createProxy(*client, sdbus::ServiceName{connection->getUniqueName()}, OBJECT_PATH);
+    std::mutex mutex;
+    std::vector<std::string> errors;
+    std::atomic<int> replies{};
+    for (int i = 0; i < 3; ++i)
+    {
+        proxy->callMethodAsync("wait").onInterface(INTERFACE_NAME).uponReplyInvoke([&](std::optional<sdbus::Error> error)
+        {
+            std::lock_guard lock(mutex);
+            if (error)
+                errors.push_back(error->getName());
+            ++replies;
+        });
+    }
+    entered.get_future().wait();
+    ASSERT_TRUE(waitUntil([&](){ return connection->getResourceUsage().queuedMethodCalls == 3; })); // One of them being handled
+
+    std::thread releaser([&](){ std::this_thread::sleep_for(100ms); released.set_value(); });
+    object->unregister();
+    EXPECT_TRUE(handlerFinished);
+    releaser.join();
+
+    ASSERT_TRUE(waitUntil([&](){ return replies == 3; }));
+    std::lock_guard lock(mutex);
+    EXPECT_THAT(errors, ElementsAre("org.freedesktop.DBus.Error.UnknownObject", "org.freedesktop.DBus.Error.UnknownObject"));
+    EXPECT_THAT(handledCalls, Eq(1));
+    EXPECT_THAT(connection->getResourceUsage().queuedMethodCalls, Eq(0));
+}
+
+TEST(AnAdaptorWithDispatchPool, HandlesHighPriorityCallWithoutWaitingForSlowCallOfTheSameObject)
+{
+    auto connection = sdbus::createBusConnection();
+    connection->enableMethodCallDispatchPool(1);
+    connection->enterEventLoopAsync();
+    std::promise<void> entered;
+    std::promise<void> released;
+    std::atomic<bool> slowCallFinished{};
+    auto object = sdbus::createObject(*connection, OBJECT_PATH);
+    object->addVTable( sdbus::registerMethod("wait").implementedAs([&, future = released.get_future().share()]()
+                       {
+                           entered.set_value();
+                           future.wait();
+                           slowCallFinished = true;
+                       })
+                     , sdbus::registerMethod("ping").implementedAs([](){}).withHighPriority() )
+          .forInterface(INTERFACE_NAME);
+    auto client = sdbus::createBusConnection();
+    client->enterEventLoopAsync();
+    auto proxy = sdbus::createProxy(*client, sdbus::ServiceName{connection->getUniqueName()}, OBJECT_PATH);
+    std::atomic<bool> slowCallReplied{};
+    proxy->callMethodAsync("wait").onInterface(INTERFACE_NAME).uponReplyInvoke([&](std::optional<sdbus::Error>){ slowCallReplied = true; });
+    entered.get_future().wait();
+
+    proxy->callMethod("ping").onInterface(INTERFACE_NAME);
+
+    EXPECT_FALSE(slowCallFinished);
+    released.set_value();
+    ASSERT_TRUE(waitUntil(slowCallReplied));
+}
+
+TEST(AnAdaptorWithDispatchPool, DoesNotDeadlockWhenObjectIsDestroyedFromSignalHandlerDuringPooledCall)
+{
+    auto connection = sdbus::createBusConnection();
+    connection->enableMethodCallDispatchPool(1);
+    connection->enterEventLoopAsync();
+    std::promise<void> entered;
+    std::promise<void> released;
+    auto object = sdbus::createObject(*connection, OBJECT_PATH);
+    object->addVTable(sdbus::registerMethod("wait").implementedAs([&, future = released.get_future().share()]()
+          {
+              entered.set_value();
+              future.wait();
+          }))
+          .forInterface(INTERFACE_NAME);
+    auto client = sdbus::createBusConnection();
+    client->enterEventLoopAsync();
+    auto proxy = sdbus::createProxy(*client, sdbus::ServiceName{connection->getUniqueName()}, OBJECT_PATH);
+    std::optional<sdbus::Error> replyError;
+    std::atomic<bool> replied{};
+    proxy->callMethodAsync("wait").onInterface(INTERFACE_NAME).uponReplyInvoke([&](std::optional<sdbus::Error> error)
+    {
+        replyError = std::move(error);
+        replied = true;
+    });
+    entered.get_future().wait();
+    // The handler, still running in the worker thread, tries to send its reply while the object is being destroyed
+    // from the signal handler, which holds the bus lock of the connection
+    std::atomic<bool> objectDestroyed{};
+    auto slot = connection->addMatch("type='signal',sender='" + client->getUniqueName() + "',member='destroy'", [&](sdbus::Message)
+    {
+        std::thread releaser([&](){ std::this_thread::sleep_for(100ms); released.set_value(); });
+        object.reset();
+        objectDestroyed = true;
+        releaser.join();
+    }, sdbus::return_slot);
+    auto emitter = sdbus::createObject(*client, sdbus::ObjectPath{"/org/sdbuscpp/emitter"});
+
+    emitter->emitSignal("destroy").onInterface(INTERFACE_NAME);
+
+    ASSERT_TRUE(waitUntil(objectDestroyed));
+    ASSERT_TRUE(waitUntil(replied));
+    ASSERT_TRUE(replyError.has_value());
+    EXPECT_THAT(replyError->getName(), Eq("org.freedesktop.DBus.Error.UnknownObject"));
+}
+
+TEST(AnAdaptorWithMethodCallAdmissionLimits, RejectsCallsOverRateLimitOfTheSender)
+{
+    auto connection = sdbus::createBusConnection();
+    connection->requestName(SERVICE_NAME);
+    connection->setMethodCallAdmissionLimits({16, 0.01, 2, sdbus::IConnection::MethodCallOverloadPolicy::Reject, {}});
+    connection->enterEventLoopAsync();
+    TestAdaptor adaptor(*connection, OBJECT_PATH);
+    sdbus::InterfaceName interfaceName{"org.sdbuscpp.integrationtests2"};
+    adaptor.getObject().addVTable(sdbus::registerMethod("add").implementedAs([](const int64_t& a, const double& b){ return a + b; }))
+                       .forInterface(interfaceName);
+    auto proxy = sdbus::createLightWeightProxy(SERVICE_NAME, OBJECT_PATH);
+
+    double result{};
+    proxy->callMethod("add").onInterface(interfaceName).withArguments(int64_t{INT64_VALUE}, DOUBLE_VALUE).storeResultsTo(result);
+    proxy->callMethod("add").onInterface(interfaceName).withArguments(int64_t{INT64_VALUE}, DOUBLE_VALUE).storeResultsTo(result);
+    try
+    {
+        proxy->callMethod("add").onInterface(interfaceName).withArguments(int64_t{INT64_VALUE}, DOUBLE_VALUE).storeResultsTo(result);
+        FAIL() << "Expected sdbus::Error exception";
+    }
+    catch (const sdbus::Error& e)
+    {
+        ASSERT_THAT(e.getName(), Eq("org.freedesktop.DBus.Error.LimitsExceeded"));
+    }
+
+    connection->releaseName(SERVICE_NAME);
+}
+
+TEST(AnAdaptorWithMethodCallAdmissionLimits, DefersCallsOverRateLimitOfTheSenderToDispatchPool)
+{
+    auto connection = sdbus::createBusConnection();
+    connection->requestName(SERVICE_NAME);
+    connection->enableMethodCallDispatchPool(2);
+    connection->setMethodCallAdmissionLimits({16, 20.0, 1, sdbus::IConnection::MethodCallOverloadPolicy::Defer, {}});
+    connection->enterEventLoopAsync();
+    auto mainThreadId = std::this_thread::get_id();
+    std::thread::id handlerThreadId;
+    TestAdaptor adaptor(*connection, OBJECT_PATH);
+    sdbus::InterfaceName interfaceName{"org.sdbuscpp.integrationtests2"};
+    adaptor.getObject().addVTable(sdbus::registerMethod("add").implementedAs([&](const int64_t& a, const double& b)
+                                  {
+                                      handlerThreadId = std::this_thread::get_id();
+                                      return a + b;
+                                  }))
+                       .forInterface(interfaceName);
+    auto proxy = sdbus::createLightWeightProxy(SERVICE_NAME, OBJECT_PATH);
+
+    auto start = std::chrono::steady_clock::now();
+    double result{};
+    for (int i = 0; i < 3; ++i)
+        proxy->callMethod("add").onInterface(interfaceName).withArguments(int64_t{INT64_VALUE}, DOUBLE_VALUE).storeResultsTo(result);
+
+    ASSERT_THAT(result, DoubleEq(INT64_VALUE + DOUBLE_VALUE));
+    ASSERT_THAT(std::chrono::steady_clock::now() - start, Gt(90ms)); // Two of the calls waited for a token, 50ms each
+    ASSERT_NE(handlerThreadId, mainThreadId);
+
+    connection->releaseName(SERVICE_NAME);
+}
+
+TEST(AnAdaptorWithHandlerProfiling, ExposesProfilesOfItsMethodHandlersOverDBus)
+{
+    auto connection = sdbus::createBusConnection();
+    connection->requestName(SERVICE_NAME);
+    connection->enableHandlerProfiling();
+    std::atomic<bool> slowHandlerReported{};
+    connection->setSlowHandlerWatchdog({0us, {{"org.sdbuscpp.integrationtests2.add", 1ms}}, [&](auto, auto, auto, auto memberName, auto)
+    {
+        slowHandlerReported = (memberName == "add");
+    }});
+    connection->enterEventLoopAsync();
+    TestAdaptor adaptor(*connection, OBJECT_PATH);
+    sdbus::InterfaceName interfaceName{"org.sdbuscpp.integrationtests2"};
+    adaptor.getObject().addVTable(sdbus::registerMethod("add").implementedAs([](const int64_t& a, const double& b)
+                                  {
+                                      std::this_thread::sleep_for(2ms);
+                                      return a + b;
+                                  }))
+                       .forInterface(interfaceName);
+    sdbus::ObjectPath statsObjectPath{"/org/sdbuscpp/debug"};
+    auto statsSlot = connection->exposeHandlerProfiles(statsObjectPath, sdbus::return_slot);
+    auto proxy = sdbus::createLightWeightProxy(SERVICE_NAME, OBJECT_PATH);
+    double result{};
+    proxy->callMethod("add").onInterface(interfaceName).withArguments(int64_t{INT64_VALUE}, DOUBLE_VALUE).storeResultsTo(result);
+
+    auto statsProxy = sdbus::createLightWeightProxy(SERVICE_NAME, statsObjectPath);
+    std::vector<sdbus::Struct<std::string, std::string, std::string, std::string, uint64_t, uint64_t, uint64_t, uint64_t, std::vector<uint64_t>>> stats;
+    statsProxy->callMethod("GetHandlerStats").onInterface("org.sdbuscpp.Debug.Stats").storeResultsTo(stats);
+
+    auto it = std::find_if(stats.begin(), stats.end(), [](const auto& entry){ return std::get<3>(entry) == "add"; });
+    ASSERT_NE(it, stats.end());
+    EXPECT_THAT(std::get<0>(*it), Eq("method"));
+    EXPECT_THAT(std::get<1>(*it), Eq(OBJECT_PATH));
+    EXPECT_THAT(std::get<4>(*it), Eq(1));
+    EXPECT_THAT(std::get<6>(*it), Ge(2'000'000));
+    EXPECT_THAT(std::get<7>(*it), Eq(1));
+    EXPECT_TRUE(slowHandlerReported);
+
+    connection->releaseName(SERVICE_NAME);
+}
+
+namespace {
+class RecordingTracer : public sdbus::ITracer
+{
+public:
+    struct Span
+    {
+        std::string memberName;
+        std::string sender;
+        uint64_t cookie{};
+        bool closed{};
+        bool failed{};
+    };
+
+    void* onMethodCallSent(const sdbus::MethodCall& call) noexcept override
+    {
+        return open(call);
+    }
+
+    void onMethodCallCompleted(void* span, const sdbus::MethodCall& call, const sdbus::Error* error) noexcept override
+    {
+        close(span, call, error);
+    }
+
+    void* onMethodCallReceived(const sdbus::MethodCall& call) noexcept override
+    {
+        return open(call);
+    }
+
+    void onMethodCallHandled(void* span, const sdbus::MethodCall& call, const sdbus::Error* error) noexcept override
+    {
+        close(span, call, error);
+    }
+
+    std::vector<Span> getSpans() const
+    {
+        std::lock_guard lock(mutex_);
+        return spans_;
+    }
+
+private:
+    void* open(const sdbus::MethodCall& call)
+    {
+        std::lock_guard lock(mutex_);
+        spans_.push_back({call.getMemberName(), call.getSender() != nullptr ? call.getSender() : "", call.getCookie()});
+        return reinterpret_cast<void*>(spans_.size());
+    }
+
+    void close(void* span, const sdbus::MethodCall& call, const sdbus::Error* error)
+    {
+        std::lock_guard lock(mutex_);
+        auto& record = spans_.at(reinterpret_cast<std::size_t>(span) - 1);
+        record.cookie = call.getCookie(); // Client calls get their cookie on sending
+        record.closed = true;
+        record.failed = error != nullptr;
+    }
+
+    mutable std::mutex mutex_;
+    std::vector<Span> spans_;
+};
+}
+
+TEST(AConnectionWithTracer, TracesMethodCallsOnBothSidesCorrelatedBySenderAndCookie)
+{
+    auto serverConnection = sdbus::createBusConnection();
+    serverConnection->requestName(SERVICE_NAME);
+    auto serverTracer = std::make_shared<RecordingTracer>();
+    serverConnection->setTracer(serverTracer);
+    serverConnection->enterEventLoopAsync();
+    TestAdaptor adaptor(*serverConnection, OBJECT_PATH);
+    sdbus::InterfaceName interfaceName{"org.sdbuscpp.integrationtests2"};
+    adaptor.getObject().addVTable( sdbus::registerMethod("add").implementedAs([](const int64_t& a, const double& b){ return a + b; })
+                                 , sdbus::registerMethod("fail").implementedAs([](){ throw sdbus::Error(sdbus::Error::Name{"org.sdbuscpp.Error"}, "Failed"); }) )
+                       .forInterface(interfaceName);
+    auto clientConnection = sdbus::createBusConnection();
+    auto clientTracer = std::make_shared<RecordingTracer>();
+    clientConnection->setTracer(clientTracer);
+    clientConnection->enterEventLoopAsync();
+    auto proxy = sdbus::createProxy(*clientConnection, SERVICE_NAME, OBJECT_PATH);
+
+    double result{};
+    proxy->callMethod("add").onInterface(interfaceName).withArguments(int64_t{INT64_VALUE}, DOUBLE_VALUE).storeResultsTo(result);
+    auto future = proxy->callMethodAsync("add").onInterface(interfaceName).withArguments(int64_t{INT64_VALUE}, DOUBLE_VALUE).getResultAsFuture<double>();
+    ASSERT_THAT(future.get(), DoubleEq(INT64_VALUE + DOUBLE_VALUE));
+    ASSERT_THROW(proxy->callMethod("fail").onInterface(interfaceName), sdbus::Error);
+
+    auto clientSpans = clientTracer->getSpans();
+    auto serverSpans = serverTracer->getSpans();
+    ASSERT_THAT(clientSpans, SizeIs(3));
+    ASSERT_THAT(serverSpans, SizeIs(3));
+    for (std::size_t i = 0; i < clientSpans.size(); ++i)
+    {
+        EXPECT_TRUE(clientSpans[i].closed);
+        EXPECT_TRUE(serverSpans[i].closed);
+        EXPECT_THAT(serverSpans[i].memberName, Eq(clientSpans[i].memberName));
+        EXPECT_THAT(serverSpans[i].sender, Eq(clientConnection->getUniqueName()));
+        EXPECT_THAT(serverSpans[i].cookie, Eq(clientSpans[i].cookie));
+        EXPECT_THAT(serverSpans[i].failed, Eq(clientSpans[i].memberName == "fail"));
+        EXPECT_THAT(clientSpans[i].failed, Eq(clientSpans[i].memberName == "fail"));
+    }
+
+    serverConnection->releaseName(SERVICE_NAME);
+}
+
+TEST(AConnectionWithTracer, ClosesSpanOfAsyncCallInFlightWithTracerItWasOpenedWith)
+{
+    auto serverConnection = sdbus::createBusConnection();
+    serverConnection->requestName(SERVICE_NAME);
+    serverConnection->enterEventLoopAsync();
+    TestAdaptor adaptor(*serverConnection, OBJECT_PATH);
+    sdbus::InterfaceName interfaceName{"org.sdbuscpp.integrationtests2"};
+    adaptor.getObject().addVTable(sdbus::registerMethod("slow").implementedAs([](){ std::this_thread::sleep_for(std::chrono::milliseconds(100)); }))
+                       .forInterface(interfaceName);
+    auto clientConnection = sdbus::createBusConnection();
+    auto tracer = std::make_shared<RecordingTracer>();
+    clientConnection->setTracer(tracer);
+    clientConnection->enterEventLoopAsync();
+    auto proxy = sdbus::createProxy(*clientConnection, SERVICE_NAME, OBJECT_PATH);
+
+    auto future = proxy->callMethodAsync("slow").onInterface(interfaceName).getResultAsFuture<>();
+    clientConnection->setTracer(nullptr);
+    std::weak_ptr<RecordingTracer> weakTracer = tracer;
+    tracer.reset();
+    ASSERT_FALSE(weakTracer.expired()); // The span in flight keeps it alive
+    future.get();
+
+    ASSERT_TRUE(waitUntil([&](){ return weakTracer.expired(); }));
+
+    serverConnection->releaseName(SERVICE_NAME);
+}
+
+TEST(AConnectionCapturingTraffic, RecordsReceivedMethodCallsForReplay)
+{
+    const auto capturePath = (std::filesystem::temp_directory_path() / "sdbus-c++-integration-test-capture.bin").string();
+    auto connection = sdbus::createBusConnection();
+    connection->requestName(SERVICE_NAME);
+    connection->enterEventLoopAsync();
+    TestAdaptor adaptor(*connection, OBJECT_PATH);
+    sdbus::InterfaceName interfaceName{"org.sdbuscpp.integrationtests2"};
+    adaptor.getObject().addVTable(sdbus::registerMethod("add").implementedAs([](const int64_t& a, const double& b){ return a + b; }))
+                       .forInterface(interfaceName);
+    auto proxy = sdbus::createProxy(SERVICE_NAME, OBJECT_PATH);
+
+    {
+        auto captureSlot = connection->captureTraffic(capturePath, sdbus::return_slot);
+        double result{};
+        proxy->callMethod("add").onInterface(interfaceName).withArguments(int64_t{INT64_VALUE}, DOUBLE_VALUE).storeResultsTo(result);
+        ASSERT_THAT(result, DoubleEq(INT64_VALUE + DOUBLE_VALUE)); // The call is dispatched as usual
+    }
+
+    sdbus::TrafficCaptureReader reader{capturePath};
+    std::optional<sdbus::CapturedMessage> call;
+    while ((call = reader.next()) && call->memberName != "add")
+        ;
+    ASSERT_TRUE(call.has_value());
+    EXPECT_THAT(call->type, Eq(sdbus::CapturedMessage::Type::MethodCall));
+    EXPECT_THAT(call->path, Eq(OBJECT_PATH));
+    EXPECT_THAT(call->interfaceName, Eq(interfaceName));
+    EXPECT_THAT(call->signature, Eq("xd"));
+    auto replayedCall = proxy->createMethodCall(sdbus::InterfaceName{call->interfaceName}, sdbus::MethodName{call->memberName});
+    sdbus::appendCapturedArguments(replayedCall, *call);
+    auto reply = proxy->callMethod(replayedCall);
+    double result{};
+    reply >> result;
+    EXPECT_THAT(result, DoubleEq(INT64_VALUE + DOUBLE_VALUE));
+
+    connection->releaseName(SERVICE_NAME);
+    std::filesystem::remove(capturePath);
+}
@@ -31,6 +31,8 @@
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <atomic>
+#include <map>
 #include <string>
 #include <thread>
 #include <tuple>
@@ -90,3 +92,101 @@ TYPED_TEST(SdbusTestObject, WritesAndReadsReadWriteVariantPropertySuccessfully)
 
     ASSERT_THAT(this->m_proxy->actionVariant().template get<int>(), Eq(5678));
 }
+
+TYPED_TEST(SdbusTestObject, ServesPropertyFromCacheUntilItIsInvalidated)
+{
+    this->m_proxy->getProxy().enablePropertyCache();
+    ASSERT_THAT(this->m_proxy->action(), Eq(DEFAULT_ACTION_VALUE));
+
+    // Another client changes the value, and no PropertiesChanged is emitted for now
+    auto otherProxy = sdbus::createProxy(*this->s_proxyConnection, SERVICE_NAME, OBJECT_PATH);
+    otherProxy->setProperty(ACTION_PROPERTY).onInterface(INTERFACE_NAME).toValue(DEFAULT_ACTION_VALUE*2);
+
+    ASSERT_THAT(this->m_proxy->action(), Eq(DEFAULT_ACTION_VALUE));
+    this->m_adaptor->emitPropertiesChangedSignal(INTERFACE_NAME, {ACTION_PROPERTY}); // `action' is marked for invalidation upon change
+    ASSERT_TRUE(waitUntil([this](){ return this->m_proxy->action() == DEFAULT_ACTION_VALUE*2; }));
+}
+
+TYPED_TEST(SdbusTestObject, UpdatesCachedPropertyFromPropertiesChangedSignal)
+{
+    this->m_proxy->getProxy().enablePropertyCache();
+    ASSERT_THAT(this->m_proxy->blocking(), Eq(DEFAULT_BLOCKING_VALUE));
+
+    this->m_proxy->blocking(!DEFAULT_BLOCKING_VALUE);
+    this->m_adaptor->emitPropertiesChangedSignal(INTERFACE_NAME, {BLOCKING_PROPERTY});
+
+    ASSERT_TRUE(waitUntil([this](){ return this->m_proxy->blocking() == !DEFAULT_BLOCKING_VALUE; }));
+}
+
+TYPED_TEST(SdbusTestObject, ReadsPropertiesFromRemoteObjectAgainOncePropertyCacheIsDisabled)
+{
+    this->m_proxy->getProxy().enablePropertyCache();
+    ASSERT_THAT(this->m_proxy->action(), Eq(DEFAULT_ACTION_VALUE));
+    auto otherProxy = sdbus::createProxy(*this->s_proxyConnection, SERVICE_NAME, OBJECT_PATH);
+    otherProxy->setProperty(ACTION_PROPERTY).onInterface(INTERFACE_NAME).toValue(DEFAULT_ACTION_VALUE*2);
+
+    this->m_proxy->getProxy().enablePropertyCache(false);
+
+    ASSERT_THAT(this->m_proxy->action(), Eq(DEFAULT_ACTION_VALUE*2));
+}
+
+TEST(APropertyWithValueCaching, InvokesGetterOnceWithinTimeToLiveUntilValueIsInvalidated)
+{
+    auto serviceConnection = sdbus::createBusConnection();
+    serviceConnection->requestName(SERVICE_NAME);
+    serviceConnection->enterEventLoopAsync();
+    std::atomic<int> getterCalls{};
+    std::string value{"first"};
+    auto object = sdbus::createObject(*serviceConnection, OBJECT_PATH);
+    object->addVTable( sdbus::registerProperty("state").withGetter([&](){ ++getterCalls; return value; }).withValueCaching(1h) )
+                     .forInterface(INTERFACE_NAME);
+    auto proxy = sdbus::createProxy(SERVICE_NAME, OBJECT_PATH);
+    auto getState = [&](){ return proxy->getProperty("state").onInterface(INTERFACE_NAME).get<std::string>(); };
+
+    ASSERT_THAT(getState(), Eq("first"));
+    value = "second";
+    ASSERT_THAT(getState(), Eq("first"));
+    ASSERT_THAT(getterCalls, Eq(1));
+
+    object->emitPropertiesChangedSignal(INTERFACE_NAME, {sdbus::PropertyName{"state"}});
+
+    ASSERT_THAT(getState(), Eq("second"));
+    ASSERT_THAT(getterCalls, Eq(2));
+
+    object.reset();
+    serviceConnection->releaseName(SERVICE_NAME);
+}
+
+TEST(AnObjectWithPropertiesChangedCoalescing, EmitsOneMergedSignalForChangesWithinInterval)
+{
+    auto serviceConnection = sdbus::createBusConnection();
+    serviceConnection->requestName(SERVICE_NAME);
+    serviceConnection->enterEventLoopAsync();
+    auto object = sdbus::createObject(*serviceConnection, OBJECT_PATH);
+    object->addVTable( sdbus::registerProperty("a").withGetter([](){ return 1; })
+                     , sdbus::registerProperty("b").withGetter([](){ return 2; }) )
+                     .forInterface(INTERFACE_NAME);
+    object->enablePropertiesChangedCoalescing(50ms);
+    std::atomic<int> signalCount{};
+    std::map<sdbus::PropertyName, sdbus::Variant> changedProperties;
+    auto proxy = sdbus::createProxy(SERVICE_NAME, OBJECT_PATH);
+    proxy->uponSignal("PropertiesChanged").onInterface("org.freedesktop.DBus.Properties")
+         .call([&](const sdbus::InterfaceName&, const std::map<sdbus::PropertyName, sdbus::Variant>& changed, const std::vector<sdbus::PropertyName>&)
+    {
+        changedProperties = changed;
+        ++signalCount;
+    });
+
+    object->emitPropertiesChangedSignal(INTERFACE_NAME, {sdbus::PropertyName{"a"}});
+    object->emitPropertiesChangedSignal(INTERFACE_NAME, {sdbus::PropertyName{"b"}});
+    object->emitPropertiesChangedSignal(INTERFACE_NAME, {sdbus::PropertyName{"a"}});
+
+    ASSERT_TRUE(waitUntil([&](){ return signalCount > 0; }));
+    std::this_thread::sleep_for(100ms);
+    ASSERT_THAT(signalCount, Eq(1));
+    ASSERT_THAT(changedProperties, SizeIs(2));
+    ASSERT_THAT(changedProperties.at(sdbus::PropertyName{"b"}).get<int>(), Eq(2));
+
+    object.reset();
+    serviceConnection->releaseName(SERVICE_NAME);
+}
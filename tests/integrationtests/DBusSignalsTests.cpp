@@ -33,6 +33,10 @@
 #include <gmock/gmock.h>
 #include <string>
 #include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 using ::testing::Eq;
 using ::testing::DoubleEq;
@@ -42,8 +46,21 @@ using ::testing::ElementsAre;
 using ::testing::SizeIs;
 using ::testing::NotNull;
 using namespace std::chrono_literals;
+using namespace std::string_literals;
 using namespace sdbus::test;
 
+namespace reusable {
+    struct Reading
+    {
+        std::string sensor;
+        std::vector<int32_t> samples;
+
+        friend bool operator==(const Reading &lhs, const Reading &rhs) = default;
+    };
+}
+
+SDBUSCPP_REGISTER_STRUCT(reusable::Reading, sensor, samples);
+
 /*-------------------------------------*/
 /* --          TEST CASES           -- */
 /*-------------------------------------*/
@@ -67,6 +84,181 @@ TYPED_TEST(SdbusTestObject, EmitsSimpleSignalToMultipleProxiesSuccessfully)
     ASSERT_TRUE(waitUntil(proxy2->m_gotSimpleSignal));
 }
 
+TYPED_TEST(SdbusTestObject, EmitsBatchOfSignalsSuccessfully)
+{
+    auto& object = this->m_adaptor->getObject();
+    std::vector<sdbus::Signal> signals;
+    signals.push_back(object.createSignal(INTERFACE_NAME, sdbus::SignalName{"simpleSignal"}));
+    signals.push_back(object.createSignal(INTERFACE_NAME, sdbus::SignalName{"signalWithMap"}));
+    signals.back() << std::map<int32_t, std::string>{{0, "zero"}, {1, "one"}};
+
+    object.emitSignals(signals);
+
+    ASSERT_TRUE(waitUntil(this->m_proxy->m_gotSimpleSignal));
+    ASSERT_TRUE(waitUntil(this->m_proxy->m_gotSignalWithMap));
+}
+
+TYPED_TEST(SdbusTestObject, EmitsSignalsFromOtherThreadsThroughSubmissionQueue)
+{
+    this->s_adaptorConnection->enableSubmissionQueue();
+    auto& object = this->m_adaptor->getObject();
+    std::vector<sdbus::Signal> signals;
+    signals.push_back(object.createSignal(INTERFACE_NAME, sdbus::SignalName{"signalWithMap"}));
+    signals.back() << std::map<int32_t, std::string>{{0, "zero"}, {1, "one"}};
+
+    std::thread([&](){ this->m_adaptor->emitSimpleSignal(); }).join();
+    std::thread([&](){ object.emitSignals(signals); }).join();
+
+    ASSERT_TRUE(waitUntil(this->m_proxy->m_gotSimpleSignal));
+    ASSERT_TRUE(waitUntil(this->m_proxy->m_gotSignalWithMap));
+    ASSERT_THAT(this->m_proxy->doOperationAsync(10), Eq(10));
+
+    this->s_adaptorConnection->enableSubmissionQueue(false);
+}
+
+TYPED_TEST(SdbusTestObject, DispatchesSignalsOfAggregatedSubscriptionToTheirHandlers)
+{
+    auto proxy = sdbus::createProxy(*this->s_proxyConnection, SERVICE_NAME, OBJECT_PATH);
+    proxy->enableSignalMatchAggregation();
+    std::atomic<bool> gotSimpleSignal{false};
+    std::atomic<bool> gotSignalWithMap{false};
+    auto slot1 = proxy->uponSignal("simpleSignal").onInterface(INTERFACE_NAME).call([&](){ gotSimpleSignal = true; }, sdbus::return_slot);
+    auto slot2 = proxy->uponSignal("signalWithMap").onInterface(INTERFACE_NAME).call([&](const std::map<int32_t, std::string>&){ gotSignalWithMap = true; }, sdbus::return_slot);
+
+    this->m_adaptor->emitSimpleSignal();
+    this->m_adaptor->emitSignalWithMap({{0, "zero"}});
+
+    ASSERT_TRUE(waitUntil(gotSimpleSignal));
+    ASSERT_TRUE(waitUntil(gotSignalWithMap));
+}
+
+TYPED_TEST(SdbusTestObject, RefillsReusableSignalArgumentsForEachSignal)
+{
+    auto proxy = sdbus::createProxy(*this->s_proxyConnection, SERVICE_NAME, OBJECT_PATH);
+    std::mutex mutex;
+    std::vector<std::map<int32_t, std::string>> mapsFromSignals;
+    std::atomic<bool> gotBothSignals{false};
+    proxy->uponSignal("signalWithMap").onInterface(INTERFACE_NAME).withReusableArguments().call([&](const std::map<int32_t, std::string>& aMap)
+    {
+        std::lock_guard lock(mutex);
+        mapsFromSignals.push_back(aMap);
+        gotBothSignals = mapsFromSignals.size() == 2;
+    });
+
+    this->m_adaptor->emitSignalWithMap({{0, "zero"}, {1, "one"}});
+    this->m_adaptor->emitSignalWithMap({{2, "two"}});
+
+    ASSERT_TRUE(waitUntil(gotBothSignals));
+    std::lock_guard lock(mutex);
+    ASSERT_THAT(mapsFromSignals, ElementsAre( std::map<int32_t, std::string>{{0, "zero"}, {1, "one"}}
+                                            , std::map<int32_t, std::string>{{2, "two"}} ));
+}
+
+TYPED_TEST(SdbusTestObject, RefillsReusableStructSignalArgumentsForEachSignal)
+{
+    auto proxy = sdbus::createProxy(*this->s_proxyConnection, SERVICE_NAME, OBJECT_PATH);
+    std::mutex mutex;
+    std::vector<reusable::Reading> readingsFromSignals;
+    std::atomic<bool> gotBothSignals{false};
+    proxy->uponSignal("readingSignal").onInterface(INTERFACE_NAME).withReusableArguments().call([&](const reusable::Reading& reading)
+    {
+        std::lock_guard lock(mutex);
+        readingsFromSignals.push_back(reading);
+        gotBothSignals = readingsFromSignals.size() == 2;
+    });
+
+    auto& object = this->m_adaptor->getObject();
+    object.emitSignal("readingSignal").onInterface(INTERFACE_NAME).withArguments(reusable::Reading{"a", {1, 2, 3}});
+    object.emitSignal("readingSignal").onInterface(INTERFACE_NAME).withArguments(reusable::Reading{"b", {4}});
+
+    ASSERT_TRUE(waitUntil(gotBothSignals));
+    std::lock_guard lock(mutex);
+    ASSERT_THAT(readingsFromSignals, ElementsAre(reusable::Reading{"a", {1, 2, 3}}, reusable::Reading{"b", {4}}));
+}
+
+TYPED_TEST(SdbusTestObject, RefillsReusableStructSignalArgumentsDeserializedFromDictionariesForEachSignal)
+{
+    auto proxy = sdbus::createProxy(*this->s_proxyConnection, SERVICE_NAME, OBJECT_PATH);
+    std::mutex mutex;
+    std::vector<reusable::Reading> readingsFromSignals;
+    std::atomic<bool> gotBothSignals{false};
+    proxy->uponSignal("readingDictSignal").onInterface(INTERFACE_NAME).withReusableArguments().call([&](const reusable::Reading& reading)
+    {
+        std::lock_guard lock(mutex);
+        readingsFromSignals.push_back(reading);
+        gotBothSignals = readingsFromSignals.size() == 2;
+    });
+
+    auto& object = this->m_adaptor->getObject();
+    object.emitSignal("readingDictSignal").onInterface(INTERFACE_NAME)
+          .withArguments(std::map<std::string, sdbus::Variant>{{"sensor", sdbus::Variant{"a"s}}, {"samples", sdbus::Variant{std::vector<int32_t>{1, 2}}}});
+    object.emitSignal("readingDictSignal").onInterface(INTERFACE_NAME)
+          .withArguments(std::map<std::string, sdbus::Variant>{{"samples", sdbus::Variant{std::vector<int32_t>{3}}}});
+
+    ASSERT_TRUE(waitUntil(gotBothSignals));
+    std::lock_guard lock(mutex);
+    ASSERT_THAT(readingsFromSignals, ElementsAre(reusable::Reading{"a", {1, 2}}, reusable::Reading{"", {3}}));
+}
+
+TYPED_TEST(SdbusTestObject, StopsDispatchingSignalOfAggregatedSubscriptionWhenItsSlotIsDestroyed)
+{
+    auto proxy = sdbus::createProxy(*this->s_proxyConnection, SERVICE_NAME, OBJECT_PATH);
+    proxy->enableSignalMatchAggregation();
+    std::atomic<bool> gotSimpleSignal{false};
+    std::atomic<bool> gotSignalWithMap{false};
+    auto slot1 = proxy->uponSignal("simpleSignal").onInterface(INTERFACE_NAME).call([&](){ gotSimpleSignal = true; }, sdbus::return_slot);
+    auto slot2 = proxy->uponSignal("signalWithMap").onInterface(INTERFACE_NAME).call([&](const std::map<int32_t, std::string>&){ gotSignalWithMap = true; }, sdbus::return_slot);
+
+    slot1.reset();
+    this->m_adaptor->emitSimpleSignal();
+    this->m_adaptor->emitSignalWithMap({{0, "zero"}});
+
+    ASSERT_TRUE(waitUntil(gotSignalWithMap));
+    ASSERT_FALSE(waitUntil(gotSimpleSignal, 1s));
+}
+
+TYPED_TEST(SdbusTestObject, ReportsAsynchronouslyInstalledSignalMatchesOnceAllAreInPlace)
+{
+    // The event loop is started only after the registrations, so that the installations are all in progress together
+    auto connection = sdbus::createBusConnection();
+    auto proxy = sdbus::createProxy(*connection, SERVICE_NAME, OBJECT_PATH);
+    std::atomic<int> installations{0};
+    std::atomic<bool> installed{false};
+    proxy->enableAsyncSignalMatchInstallation(true, [&](std::optional<sdbus::Error> error)
+    {
+        ++installations;
+        installed = !error.has_value();
+    });
+    std::atomic<bool> gotSimpleSignal{false};
+    std::atomic<bool> gotSignalWithMap{false};
+    auto slot1 = proxy->uponSignal("simpleSignal").onInterface(INTERFACE_NAME).call([&](){ gotSimpleSignal = true; }, sdbus::return_slot);
+    auto slot2 = proxy->uponSignal("signalWithMap").onInterface(INTERFACE_NAME).call([&](const std::map<int32_t, std::string>&){ gotSignalWithMap = true; }, sdbus::return_slot);
+    connection->enterEventLoopAsync();
+
+    ASSERT_TRUE(waitUntil(installed));
+    this->m_adaptor->emitSimpleSignal();
+    this->m_adaptor->emitSignalWithMap({{0, "zero"}});
+
+    ASSERT_TRUE(waitUntil(gotSimpleSignal));
+    ASSERT_TRUE(waitUntil(gotSignalWithMap));
+    ASSERT_THAT(installations, Eq(1));
+}
+
+TYPED_TEST(SdbusTestObject, InstallsAggregatedSignalMatchAsynchronously)
+{
+    auto proxy = sdbus::createProxy(*this->s_proxyConnection, SERVICE_NAME, OBJECT_PATH);
+    proxy->enableSignalMatchAggregation();
+    std::atomic<bool> installed{false};
+    proxy->enableAsyncSignalMatchInstallation(true, [&](std::optional<sdbus::Error> error){ installed = !error.has_value(); });
+    std::atomic<bool> gotSimpleSignal{false};
+    auto slot = proxy->uponSignal("simpleSignal").onInterface(INTERFACE_NAME).call([&](){ gotSimpleSignal = true; }, sdbus::return_slot);
+
+    ASSERT_TRUE(waitUntil(installed));
+    this->m_adaptor->emitSimpleSignal();
+
+    ASSERT_TRUE(waitUntil(gotSimpleSignal));
+}
+
 TYPED_TEST(SdbusTestObject, ProxyDoesNotReceiveSignalFromOtherBusName)
 {
     sdbus::ServiceName otherBusName{SERVICE_NAME + "2"};
@@ -165,3 +357,115 @@ TYPED_TEST(SdbusTestObject, ReRegistersSignalHandler)
 
     ASSERT_TRUE(waitUntil(this->m_proxy->m_gotSimpleSignal));
 }
+
+TYPED_TEST(SdbusTestObject, DeliversOnlySignalsSatisfyingArgumentFilter)
+{
+    std::atomic<bool> gotMatchingSignal{false};
+    std::atomic<bool> gotNonMatchingSignal{false};
+    auto handler = [](std::atomic<bool>& flag){ return [&flag](const std::string&, const std::map<std::string, sdbus::Variant>&, const std::vector<std::string>&){ flag = true; }; };
+    auto matchingSlot = this->m_proxy->getProxy().uponSignal("PropertiesChanged").onInterface("org.freedesktop.DBus.Properties")
+                                                 .template withArgFilter<0>(INTERFACE_NAME)
+                                                 .call(handler(gotMatchingSignal), sdbus::return_slot);
+    auto nonMatchingSlot = this->m_proxy->getProxy().uponSignal("PropertiesChanged").onInterface("org.freedesktop.DBus.Properties")
+                                                    .template withArgFilter<0>("org.sdbuscpp.other")
+                                                    .call(handler(gotNonMatchingSignal), sdbus::return_slot);
+
+    this->m_adaptor->emitPropertiesChangedSignal(INTERFACE_NAME, {BLOCKING_PROPERTY});
+
+    ASSERT_TRUE(waitUntil(gotMatchingSignal));
+    ASSERT_FALSE(waitUntil(gotNonMatchingSignal, 1s));
+}
+
+TYPED_TEST(SdbusTestObject, DeliversOnlySignalsSatisfyingArgumentNamespaceFilter)
+{
+    std::atomic<bool> gotMatchingSignal{false};
+    std::atomic<bool> gotNonMatchingSignal{false};
+    auto handler = [](std::atomic<bool>& flag){ return [&flag](const std::string&, const std::map<std::string, sdbus::Variant>&, const std::vector<std::string>&){ flag = true; }; };
+    auto matchingSlot = this->m_proxy->getProxy().uponSignal("PropertiesChanged").onInterface("org.freedesktop.DBus.Properties")
+                                                 .withArg0NamespaceFilter("org.sdbuscpp")
+                                                 .call(handler(gotMatchingSignal), sdbus::return_slot);
+    auto nonMatchingSlot = this->m_proxy->getProxy().uponSignal("PropertiesChanged").onInterface("org.freedesktop.DBus.Properties")
+                                                    .withArg0NamespaceFilter("org.sdbuscpp.integrationtests.other")
+                                                    .call(handler(gotNonMatchingSignal), sdbus::return_slot);
+
+    this->m_adaptor->emitPropertiesChangedSignal(INTERFACE_NAME, {BLOCKING_PROPERTY});
+
+    ASSERT_TRUE(waitUntil(gotMatchingSignal));
+    ASSERT_FALSE(waitUntil(gotNonMatchingSignal, 1s));
+}
+
+TYPED_TEST(SdbusTestObject, DispatchesSubtreeSignalOnlyToHandlersOfEmittingObject)
+{
+    auto adaptor2 = std::make_unique<TestAdaptor>(*this->s_adaptorConnection, OBJECT_PATH_2);
+    sdbus::SubtreeSignalSubscription subscription( *this->s_proxyConnection
+                                                 , SERVICE_NAME
+                                                 , sdbus::ObjectPath{"/org/sdbuscpp/integrationtests"}
+                                                 , INTERFACE_NAME
+                                                 , sdbus::SignalName{"signalWithMap"} );
+    std::atomic<bool> gotSignalOfObject1{false};
+    std::atomic<bool> gotSignalOfObject2{false};
+    std::string pathOfObject2;
+    auto slot1 = subscription.subscribe(OBJECT_PATH, [&](const std::map<int32_t, std::string>&){ gotSignalOfObject1 = true; });
+    auto slot2 = subscription.subscribe(OBJECT_PATH_2, [&](sdbus::Message msg){ pathOfObject2 = msg.getPath(); gotSignalOfObject2 = true; });
+
+    adaptor2->emitSignalWithMap({{0, "zero"}});
+
+    ASSERT_TRUE(waitUntil(gotSignalOfObject2));
+    ASSERT_THAT(pathOfObject2, Eq(OBJECT_PATH_2));
+    ASSERT_FALSE(waitUntil(gotSignalOfObject1, 1s));
+}
+
+TYPED_TEST(SdbusTestObject, StopsDispatchingSubtreeSignalToUnsubscribedHandler)
+{
+    sdbus::SubtreeSignalSubscription subscription( *this->s_proxyConnection
+                                                 , SERVICE_NAME
+                                                 , sdbus::ObjectPath{"/org/sdbuscpp/integrationtests"}
+                                                 , INTERFACE_NAME );
+    std::atomic<int> calls{};
+    auto slot = subscription.subscribe(OBJECT_PATH, [&](const std::map<int32_t, std::string>&){ ++calls; });
+    ASSERT_THAT(subscription.getObjectCount(), Eq(1));
+
+    this->m_adaptor->emitSignalWithMap({{0, "zero"}});
+    ASSERT_TRUE(waitUntil([&](){ return calls == 1; }));
+    slot.reset();
+    ASSERT_THAT(subscription.getObjectCount(), Eq(0));
+
+    this->m_adaptor->emitSignalWithMap({{0, "zero"}});
+    ASSERT_FALSE(waitUntil([&](){ return calls > 1; }, 1s));
+}
+
+TYPED_TEST(SdbusTestObject, FansSignalOutToBroadcastSubscribersWithOneSharedValue)
+{
+    sdbus::SignalBroadcast<std::map<int32_t, std::string>> broadcast(this->m_proxy->getProxy(), INTERFACE_NAME, sdbus::SignalName{"signalWithMap"});
+    std::atomic<const void*> value1{};
+    std::atomic<const void*> value2{};
+    std::atomic<bool> gotArguments{false};
+    auto slot1 = broadcast.subscribe([&](const auto& value){ value1 = value.get(); });
+    auto slot2 = broadcast.subscribe([&](const auto& value){ value2 = value.get(); });
+    auto slot3 = broadcast.subscribe([&](const std::map<int32_t, std::string>& aMap){ gotArguments = aMap.at(1) == "one"; });
+
+    this->m_adaptor->emitSignalWithMap({{0, "zero"}, {1, "one"}});
+
+    ASSERT_TRUE(waitUntil(gotArguments));
+    ASSERT_THAT(value1.load(), NotNull());
+    ASSERT_THAT(value2.load(), Eq(value1.load()));
+}
+
+TYPED_TEST(SdbusTestObject, DoesNotInvokeUnsubscribedBroadcastSubscriberFromPendingExecutorTask)
+{
+    std::mutex mutex;
+    std::vector<std::function<void()>> tasks;
+    auto executor = [&](std::function<void()> task){ std::lock_guard lock(mutex); tasks.push_back(std::move(task)); };
+    sdbus::SignalBroadcast<std::map<int32_t, std::string>> broadcast(this->m_proxy->getProxy(), INTERFACE_NAME, sdbus::SignalName{"signalWithMap"}, executor);
+    std::atomic<int> calls{};
+    auto slot = broadcast.subscribe([&](const auto&){ ++calls; });
+
+    this->m_adaptor->emitSignalWithMap({{0, "zero"}});
+    ASSERT_TRUE(waitUntil([&](){ std::lock_guard lock(mutex); return !tasks.empty(); }));
+    slot.reset();
+
+    std::lock_guard lock(mutex);
+    for (auto& task : tasks)
+        task();
+    ASSERT_THAT(calls.load(), Eq(0));
+}
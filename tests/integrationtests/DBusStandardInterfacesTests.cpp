@@ -31,6 +31,9 @@
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <map>
+#include <mutex>
+#include <set>
 #include <string>
 #include <thread>
 #include <tuple>
@@ -45,9 +48,23 @@ using ::testing::Gt;
 using ::testing::AnyOf;
 using ::testing::ElementsAre;
 using ::testing::SizeIs;
+using ::testing::HasSubstr;
+using ::testing::Not;
 using namespace std::chrono_literals;
 using namespace sdbus::test;
 
+namespace
+{
+    // A subset of properties of the test object, named after them
+    struct StateAndActionProperties
+    {
+        std::string state;
+        uint32_t action;
+    };
+}
+
+SDBUSCPP_REGISTER_STRUCT(StateAndActionProperties, state, action);
+
 /*-------------------------------------*/
 /* --          TEST CASES           -- */
 /*-------------------------------------*/
@@ -72,6 +89,99 @@ TYPED_TEST(SdbusTestObject, AnswersMachineUuidViaPeerInterface)
 //    ASSERT_THAT(this->m_proxy->Introspect(), Eq(this->m_adaptor->getExpectedXmlApiDescription()));
 //}
 
+TYPED_TEST(SdbusTestObject, AnswersIntrospectCallsFromCacheWithSameXmlAsSdBus)
+{
+    auto introspect = [&](const sdbus::ObjectPath& path)
+    {
+        std::string xml;
+        sdbus::createProxy(*this->s_proxyConnection, SERVICE_NAME, path)->callMethod("Introspect").onInterface("org.freedesktop.DBus.Introspectable").storeResultsTo(xml);
+        return xml;
+    };
+    auto objectXml = introspect(OBJECT_PATH);
+    auto managerXml = introspect(MANAGER_PATH);
+
+    // The cache only tracks objects registered while it's enabled
+    this->m_adaptor.reset();
+    this->m_objectManagerAdaptor.reset();
+    this->s_adaptorConnection->enableIntrospectionCache();
+    this->m_objectManagerAdaptor = std::make_unique<ObjectManagerTestAdaptor>(*this->s_adaptorConnection, MANAGER_PATH);
+    this->m_adaptor = std::make_unique<TestAdaptor>(*this->s_adaptorConnection, OBJECT_PATH);
+    auto cachedObjectXml = introspect(OBJECT_PATH);
+    auto cachedManagerXml = introspect(MANAGER_PATH);
+    auto recachedObjectXml = introspect(OBJECT_PATH);
+    this->s_adaptorConnection->enableIntrospectionCache(false);
+
+    EXPECT_THAT(cachedObjectXml, Eq(objectXml));
+    EXPECT_THAT(cachedManagerXml, Eq(managerXml));
+    EXPECT_THAT(recachedObjectXml, Eq(objectXml));
+}
+
+TYPED_TEST(SdbusTestObject, UpdatesCachedIntrospectionWhenVTableIsAddedAndRemoved)
+{
+    this->m_adaptor.reset();
+    this->s_adaptorConnection->enableIntrospectionCache();
+    this->m_adaptor = std::make_unique<TestAdaptor>(*this->s_adaptorConnection, OBJECT_PATH);
+    auto xmlBefore = this->m_proxy->Introspect();
+
+    auto slot = this->m_adaptor->getObject().addVTable(sdbus::registerMethod("cachedMethod").implementedAs([](){}))
+                                            .forInterface("org.sdbuscpp.integrationtests.Cached", sdbus::return_slot);
+    auto xmlWithVTable = this->m_proxy->Introspect();
+    slot.reset();
+    auto xmlAfter = this->m_proxy->Introspect();
+    this->s_adaptorConnection->enableIntrospectionCache(false);
+
+    EXPECT_THAT(xmlBefore, Not(HasSubstr("org.sdbuscpp.integrationtests.Cached")));
+    EXPECT_THAT(xmlWithVTable, HasSubstr("<method name=\"cachedMethod\">"));
+    EXPECT_THAT(xmlAfter, Eq(xmlBefore));
+}
+
+TYPED_TEST(SdbusTestObject, AnswersGetManagedObjectsCallsFromCacheWithSameObjectsAsSdBus)
+{
+    auto adaptor2 = std::make_unique<TestAdaptor>(*this->s_adaptorConnection, OBJECT_PATH_2);
+    auto getPropertyNames = [&]()
+    {
+        std::map<sdbus::ObjectPath, std::map<sdbus::InterfaceName, std::set<sdbus::PropertyName>>> names;
+        for (const auto& [objectPath, interfaces] : this->m_objectManagerProxy->GetManagedObjects())
+            for (const auto& [interfaceName, properties] : interfaces)
+                for (const auto& [propertyName, value] : properties)
+                    names[objectPath][interfaceName].insert(propertyName);
+        return names;
+    };
+    auto names = getPropertyNames();
+
+    this->s_adaptorConnection->enableManagedObjectsCache();
+    auto cachedNames = getPropertyNames();
+    auto recachedObjects = this->m_objectManagerProxy->GetManagedObjects();
+    this->s_adaptorConnection->enableManagedObjectsCache(false);
+
+    EXPECT_THAT(cachedNames, Eq(names));
+    EXPECT_THAT(recachedObjects.at(OBJECT_PATH_2)
+        .at(sdbus::InterfaceName{org::sdbuscpp::integrationtests_adaptor::INTERFACE_NAME})
+        .at(ACTION_PROPERTY).template get<uint32_t>(), Eq(DEFAULT_ACTION_VALUE));
+}
+
+TYPED_TEST(SdbusTestObject, UpdatesCachedManagedObjectsWhenPropertiesChangedSignalIsEmitted)
+{
+    this->s_adaptorConnection->enableManagedObjectsCache();
+    auto getAction = [&]()
+    {
+        return this->m_objectManagerProxy->GetManagedObjects().at(OBJECT_PATH)
+            .at(sdbus::InterfaceName{org::sdbuscpp::integrationtests_adaptor::INTERFACE_NAME})
+            .at(ACTION_PROPERTY).template get<uint32_t>();
+    };
+    auto actionBefore = getAction();
+
+    this->m_proxy->action(DEFAULT_ACTION_VALUE + 1);
+    auto staleAction = getAction();
+    this->m_adaptor->emitPropertiesChangedSignal(INTERFACE_NAME, {ACTION_PROPERTY});
+    auto actionAfter = getAction();
+    this->s_adaptorConnection->enableManagedObjectsCache(false);
+
+    EXPECT_THAT(actionBefore, Eq(DEFAULT_ACTION_VALUE));
+    EXPECT_THAT(staleAction, Eq(DEFAULT_ACTION_VALUE));
+    EXPECT_THAT(actionAfter, Eq(DEFAULT_ACTION_VALUE + 1));
+}
+
 TYPED_TEST(SdbusTestObject, GetsPropertyViaPropertiesInterface)
 {
     ASSERT_THAT(this->m_proxy->Get(INTERFACE_NAME, "state").template get<std::string>(), Eq(DEFAULT_STATE_VALUE));
@@ -148,6 +258,14 @@ TYPED_TEST(SdbusTestObject, GetsAllPropertiesViaPropertiesInterface)
     EXPECT_THAT(properties.at(BLOCKING_PROPERTY).template get<bool>(), Eq(DEFAULT_BLOCKING_VALUE));
 }
 
+TYPED_TEST(SdbusTestObject, GetsAllPropertiesDirectlyIntoStructViaPropertiesInterface)
+{
+    const auto properties = this->m_proxy->template GetAll<StateAndActionProperties>(INTERFACE_NAME);
+
+    EXPECT_THAT(properties.state, Eq(DEFAULT_STATE_VALUE));
+    EXPECT_THAT(properties.action, Eq(DEFAULT_ACTION_VALUE));
+}
+
 TYPED_TEST(SdbusTestObject, GetsAllPropertiesAsynchronouslyViaPropertiesInterface)
 {
     std::promise<std::map<sdbus::PropertyName, sdbus::Variant>> promise;
@@ -353,3 +471,127 @@ TYPED_TEST(SdbusTestObject, EmitsInterfacesRemovedSignalForAllObjectInterfaces)
 
     ASSERT_TRUE(waitUntil(signalReceived));
 }
+
+TYPED_TEST(SdbusTestObject, RegistersObjectsInBulkAndEmitsInterfacesAddedSignalForEach)
+{
+    std::mutex mutex;
+    std::map<sdbus::ObjectPath, std::vector<sdbus::InterfaceName>> addedObjects;
+    this->m_objectManagerProxy->m_onInterfacesAddedHandler = [&]( const sdbus::ObjectPath& objectPath
+                                                                , const std::map<sdbus::InterfaceName, std::map<sdbus::PropertyName, sdbus::Variant>>& interfacesAndProperties )
+    {
+        std::lock_guard lock(mutex);
+        for (const auto& [interfaceName, properties] : interfacesAndProperties)
+            addedObjects[objectPath].push_back(interfaceName);
+    };
+    std::vector<std::unique_ptr<sdbus::IObject>> objects;
+    std::vector<sdbus::ObjectRegistration> batch;
+    for (const char* name : {"Bulk1", "Bulk2", "Bulk3"})
+    {
+        objects.push_back(sdbus::createObject(*this->s_adaptorConnection, sdbus::ObjectPath{MANAGER_PATH + "/" + name}));
+        batch.push_back({*objects.back(), INTERFACE_NAME, {sdbus::registerProperty("bulk").withGetter([](){ return true; })}});
+    }
+
+    this->s_adaptorConnection->registerObjects(std::move(batch));
+
+    ASSERT_TRUE(waitUntil([&](){ std::lock_guard lock(mutex); return addedObjects.size() == 3; }));
+    EXPECT_THAT(addedObjects[sdbus::ObjectPath{MANAGER_PATH + "/Bulk2"}], ElementsAre(INTERFACE_NAME));
+    auto proxy = sdbus::createProxy(*this->s_proxyConnection, SERVICE_NAME, sdbus::ObjectPath{MANAGER_PATH + "/Bulk3"});
+    EXPECT_TRUE(proxy->getProperty("bulk").onInterface(INTERFACE_NAME).template get<bool>());
+}
+
+TYPED_TEST(SdbusTestObject, UnregistersObjectsInBulkAndEmitsInterfacesRemovedSignalForEach)
+{
+    std::vector<std::unique_ptr<sdbus::IObject>> objects;
+    std::vector<sdbus::ObjectRegistration> batch;
+    for (const char* name : {"Bulk1", "Bulk2"})
+    {
+        objects.push_back(sdbus::createObject(*this->s_adaptorConnection, sdbus::ObjectPath{MANAGER_PATH + "/" + name}));
+        batch.push_back({*objects.back(), INTERFACE_NAME, {sdbus::registerProperty("bulk").withGetter([](){ return true; })}});
+    }
+    this->s_adaptorConnection->registerObjects(std::move(batch));
+    std::mutex mutex;
+    std::set<sdbus::ObjectPath> removedObjects;
+    this->m_objectManagerProxy->m_onInterfacesRemovedHandler = [&](const sdbus::ObjectPath& objectPath, const std::vector<sdbus::InterfaceName>&)
+    {
+        std::lock_guard lock(mutex);
+        removedObjects.insert(objectPath);
+    };
+
+    std::vector<sdbus::IObject*> objectsToRemove{objects[0].get(), objects[1].get()};
+    this->s_adaptorConnection->unregisterObjects(objectsToRemove);
+
+    ASSERT_TRUE(waitUntil([&](){ std::lock_guard lock(mutex); return removedObjects.size() == 2; }));
+    auto proxy = sdbus::createProxy(*this->s_proxyConnection, SERVICE_NAME, sdbus::ObjectPath{MANAGER_PATH + "/Bulk1"});
+    EXPECT_THROW(proxy->getProperty("bulk").onInterface(INTERFACE_NAME).template get<bool>(), sdbus::Error);
+}
+
+TYPED_TEST(SdbusTestObject, MirrorsManagedObjectsOfObjectManager)
+{
+    sdbus::ObjectManagerMirror mirror{*this->s_proxyConnection, SERVICE_NAME, MANAGER_PATH};
+
+    ASSERT_TRUE(mirror.hasObject(OBJECT_PATH));
+    auto blocking = mirror.getProperty(OBJECT_PATH, INTERFACE_NAME, BLOCKING_PROPERTY);
+    ASSERT_TRUE(blocking.has_value());
+    EXPECT_THAT(blocking->template get<bool>(), Eq(DEFAULT_BLOCKING_VALUE));
+}
+
+TYPED_TEST(SdbusTestObject, MirrorTracksObjectsAddedToAndRemovedFromObjectManager)
+{
+    sdbus::ObjectManagerMirror mirror{*this->s_proxyConnection, SERVICE_NAME, MANAGER_PATH};
+    ASSERT_FALSE(mirror.hasObject(OBJECT_PATH_2));
+
+    auto adaptor2 = std::make_unique<TestAdaptor>(*this->s_adaptorConnection, OBJECT_PATH_2);
+    adaptor2->emitInterfacesAddedSignal();
+    ASSERT_TRUE(waitUntil([&](){ return mirror.hasObject(OBJECT_PATH_2); }));
+    EXPECT_THAT(mirror.getObjectPaths(), SizeIs(2));
+
+    adaptor2->emitInterfacesRemovedSignal();
+    ASSERT_TRUE(waitUntil([&](){ return !mirror.hasObject(OBJECT_PATH_2); }));
+}
+
+TYPED_TEST(SdbusTestObject, MirrorUpdatesPropertiesOfManagedObjectsFromPropertiesChangedSignal)
+{
+    sdbus::ObjectManagerMirror mirror{*this->s_proxyConnection, SERVICE_NAME, MANAGER_PATH};
+
+    this->m_proxy->blocking(!DEFAULT_BLOCKING_VALUE);
+    this->m_adaptor->emitPropertiesChangedSignal(INTERFACE_NAME, {BLOCKING_PROPERTY});
+
+    ASSERT_TRUE(waitUntil([&]()
+    {
+        auto blocking = mirror.getProperty(OBJECT_PATH, INTERFACE_NAME, BLOCKING_PROPERTY);
+        return blocking.has_value() && blocking->template get<bool>() == !DEFAULT_BLOCKING_VALUE;
+    }));
+}
+
+TYPED_TEST(SdbusTestObject, CallsMethodsOverDirectChannelWhenObjectOffersIt)
+{
+    DirectChannelTestAdaptor adaptor{*this->s_adaptorConnection, OBJECT_PATH_2};
+
+    auto proxy = sdbus::createDirectChannelProxy(*this->s_proxyConnection, SERVICE_NAME, OBJECT_PATH_2);
+
+    ASSERT_NE(&proxy->getConnection(), this->s_proxyConnection.get());
+    int32_t result{};
+    proxy->callMethod("getInt").onInterface(INTERFACE_NAME).storeResultsTo(result);
+    ASSERT_THAT(result, Eq(INT32_VALUE));
+}
+
+TYPED_TEST(SdbusTestObject, FallsBackToBusWhenObjectDoesNotOfferDirectChannel)
+{
+    auto proxy = sdbus::createDirectChannelProxy(*this->s_proxyConnection, SERVICE_NAME, OBJECT_PATH);
+
+    ASSERT_EQ(&proxy->getConnection(), this->s_proxyConnection.get());
+    int32_t result{};
+    proxy->callMethod("getInt").onInterface(INTERFACE_NAME).storeResultsTo(result);
+    ASSERT_THAT(result, Eq(INT32_VALUE));
+}
+
+TYPED_TEST(SdbusTestObject, FailsCallsOverDirectChannelClosedByObject)
+{
+    auto adaptor = std::make_unique<DirectChannelTestAdaptor>(*this->s_adaptorConnection, OBJECT_PATH_2);
+    auto proxy = sdbus::createDirectChannelProxy(*this->s_proxyConnection, SERVICE_NAME, OBJECT_PATH_2);
+    proxy->callMethod("noArgNoReturn").onInterface(INTERFACE_NAME);
+
+    adaptor.reset();
+
+    ASSERT_THROW(proxy->callMethod("noArgNoReturn").onInterface(INTERFACE_NAME), sdbus::Error);
+}
@@ -31,6 +31,11 @@
 
 namespace sdbus { namespace test {
 
+std::shared_ptr<void> DirectChannelTestAdaptor::onDirectChannelOpened(sdbus::IConnection& connection)
+{
+    return std::make_shared<TestAdaptor>(connection, m_path);
+}
+
 TestAdaptor::TestAdaptor(sdbus::IConnection& connection, sdbus::ObjectPath path) :
     AdaptorInterfaces(connection, std::move(path))
 {
@@ -52,6 +52,29 @@ public:
     }
 };
 
+// Offers direct channels, over which a TestAdaptor at the same path is served
+class DirectChannelTestAdaptor final : public sdbus::AdaptorInterfaces< sdbus::DirectChannel_adaptor >
+{
+public:
+    DirectChannelTestAdaptor(sdbus::IConnection& connection, sdbus::ObjectPath path) :
+        AdaptorInterfaces(connection, path),
+        m_path(std::move(path))
+    {
+        registerAdaptor();
+    }
+
+    ~DirectChannelTestAdaptor()
+    {
+        unregisterAdaptor();
+    }
+
+protected:
+    std::shared_ptr<void> onDirectChannelOpened(sdbus::IConnection& connection) override;
+
+private:
+    sdbus::ObjectPath m_path;
+};
+
 class TestAdaptor final : public sdbus::AdaptorInterfaces< org::sdbuscpp::integrationtests_adaptor
                                                          , sdbus::Properties_adaptor
                                                          , sdbus::ManagedObject_adaptor >
@@ -176,6 +176,21 @@ std::future<void> TestProxy::doErroneousOperationClientSideAsync(with_future_t)
                      .getResultAsFuture<>();
 }
 
+sdbus::AsyncCallAwaitable<uint32_t> TestProxy::doOperationClientSideAsyncAwaitable(uint32_t param)
+{
+    return getProxy().callMethodAsync("doOperation")
+                     .onInterface(sdbus::test::INTERFACE_NAME)
+                     .withArguments(param)
+                     .getResultAsAwaitable<uint32_t>();
+}
+
+sdbus::AsyncCallAwaitable<> TestProxy::doErroneousOperationClientSideAsyncAwaitable()
+{
+    return getProxy().callMethodAsync("throwError")
+                     .onInterface(sdbus::test::INTERFACE_NAME)
+                     .getResultAsAwaitable<>();
+}
+
 void TestProxy::doOperationClientSideAsyncWithTimeout(const std::chrono::microseconds &timeout, uint32_t param)
 {
     using namespace std::chrono_literals;
@@ -101,6 +101,8 @@ public:
     std::future<std::map<int32_t, std::string>> doOperationWithLargeDataClientSideAsync(const std::map<int32_t, std::string>& largeParam, with_future_t);
     std::future<MethodReply> doOperationClientSideAsyncOnBasicAPILevel(uint32_t param);
     std::future<void> doErroneousOperationClientSideAsync(with_future_t);
+    sdbus::AsyncCallAwaitable<uint32_t> doOperationClientSideAsyncAwaitable(uint32_t param);
+    sdbus::AsyncCallAwaitable<> doErroneousOperationClientSideAsyncAwaitable();
     void doErroneousOperationClientSideAsync();
     void doOperationClientSideAsyncWithTimeout(const std::chrono::microseconds &timeout, uint32_t param);
     int32_t callNonexistentMethod();
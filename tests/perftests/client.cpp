@@ -76,6 +76,10 @@ protected:
         }
     }
 
+    virtual void onTimestampedDataSignal(const uint64_t& /*sentAt*/, const std::string& /*data*/) override
+    {
+    }
+
 public:
     unsigned int m_msgSize{};
     unsigned int m_msgCount{};
@@ -0,0 +1,679 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file eventloop.cpp
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+// Compares the ways of driving a client bus connection: the internal event loop thread (enterEventLoopAsync()),
+// an attached sd-event loop (attachSdEventLoop()), an external poll() loop (getEventLoopPollData() and
+// processPendingEvent()), and no event loop at all. For each way, measures method call round-trip latency
+// (blocking and async calls) and signal throughput against sdbus-c++-perf-tests-server, together with
+// CPU time and thread wakeups per message, and reports them as text, CSV or JSON.
+
+#include "perftests-proxy.h"
+#include <sdbus-c++/sdbus-c++.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#ifndef SDBUS_basu // sd-event integration is not supported in basu-based sdbus-c++
+#include <systemd/sd-event.h>
+#endif
+
+using namespace std::chrono_literals;
+
+namespace {
+
+enum class Loop { Internal, SdEvent, External, None };
+enum class Scenario { RoundTrip, Signals };
+enum class Calls { Sync, Async };
+enum class Format { Text, Csv, Json };
+
+struct Options
+{
+    std::vector<Loop> loops{Loop::Internal, Loop::SdEvent, Loop::External, Loop::None};
+    std::vector<Scenario> scenarios{Scenario::RoundTrip, Scenario::Signals};
+    std::vector<Calls> calls{Calls::Sync, Calls::Async};
+    uint32_t payloadSize{20};
+    uint32_t requests{10000};   // Measured calls or signals
+    uint32_t warmup{1000};      // Unmeasured calls or signals
+    Format format{Format::Text};
+    bool csvHeader{true};
+    std::string label;
+};
+
+// One measured combination of the loop, the scenario and (for round trips) the kind of calls
+struct Run
+{
+    Loop loop{};
+    Scenario scenario{};
+    Calls calls{};
+};
+
+const char* toString(Loop loop)
+{
+    switch (loop)
+    {
+        case Loop::Internal: return "internal";
+        case Loop::SdEvent: return "sd-event";
+        case Loop::External: return "external";
+        case Loop::None: return "none";
+    }
+    return "";
+}
+
+const char* toString(Scenario scenario)
+{
+    switch (scenario)
+    {
+        case Scenario::RoundTrip: return "roundtrip";
+        case Scenario::Signals: return "signals";
+    }
+    return "";
+}
+
+const char* toString(Calls calls)
+{
+    switch (calls)
+    {
+        case Calls::Sync: return "sync";
+        case Calls::Async: return "async";
+    }
+    return "";
+}
+
+// Without an event loop, nothing processes replies to async calls nor incoming signals
+bool isSupported(const Run& run)
+{
+    if (run.loop == Loop::None)
+        return run.scenario == Scenario::RoundTrip && run.calls == Calls::Sync;
+#ifdef SDBUS_basu
+    if (run.loop == Loop::SdEvent)
+        return false;
+#endif
+    return true;
+}
+
+// Drives the bus connection in the given way while alive
+class EventLoopDriver
+{
+public:
+    EventLoopDriver(sdbus::IConnection& connection, Loop loop)
+        : connection_(connection)
+        , loop_(loop)
+    {
+        switch (loop_)
+        {
+            case Loop::Internal:
+                connection_.enterEventLoopAsync();
+                break;
+            case Loop::SdEvent:
+                startSdEventLoop();
+                break;
+            case Loop::External:
+                stopFd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+                thread_ = std::thread([this](){ runExternalLoop(); });
+                break;
+            case Loop::None:
+                break;
+        }
+    }
+
+    ~EventLoopDriver()
+    {
+        switch (loop_)
+        {
+            case Loop::Internal:
+                connection_.leaveEventLoop();
+                break;
+            case Loop::SdEvent:
+                stopSdEventLoop();
+                break;
+            case Loop::External:
+                (void)eventfd_write(stopFd_, 1);
+                thread_.join();
+                close(stopFd_);
+                break;
+            case Loop::None:
+                break;
+        }
+    }
+
+    // Number of returns from poll() in the external loop; not known for the other loops
+    std::optional<uint64_t> pollWakeups() const
+    {
+        if (loop_ != Loop::External)
+            return std::nullopt;
+        return pollWakeups_.load(std::memory_order_relaxed);
+    }
+
+private:
+    void runExternalLoop()
+    {
+        while (true)
+        {
+            auto pollData = connection_.getEventLoopPollData();
+            struct pollfd fds[] = { {pollData.fd, pollData.events, 0}
+                                  , {pollData.eventFd, POLLIN, 0}
+                                  , {stopFd_, POLLIN, 0} };
+            auto r = poll(fds, std::size(fds), pollData.getPollTimeout());
+            if (r < 0 && errno == EINTR)
+                continue;
+            pollWakeups_.fetch_add(1, std::memory_order_relaxed);
+            if (fds[2].revents & POLLIN)
+                break;
+            (void)connection_.processPendingEvent();
+        }
+    }
+
+#ifndef SDBUS_basu
+    void startSdEventLoop()
+    {
+        sd_event_new(&event_);
+        connection_.attachSdEventLoop(event_);
+
+        stopFd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        auto exitHandler = [](sd_event_source *s, auto...){ return sd_event_exit(sd_event_source_get_event(s), 0); };
+        sd_event_add_io(event_, nullptr, stopFd_, EPOLLIN, exitHandler, nullptr);
+
+        thread_ = std::thread([this](){ sd_event_loop(event_); });
+    }
+
+    void stopSdEventLoop()
+    {
+        (void)eventfd_write(stopFd_, 1);
+        thread_.join();
+        connection_.detachSdEventLoop();
+        sd_event_unref(event_);
+        close(stopFd_);
+    }
+
+    sd_event* event_{};
+#else
+    void startSdEventLoop() {}
+    void stopSdEventLoop() {}
+#endif
+
+    sdbus::IConnection& connection_;
+    Loop loop_;
+    int stopFd_{-1};
+    std::thread thread_;
+    std::atomic<uint64_t> pollWakeups_{};
+};
+
+class Client final : public sdbus::ProxyInterfaces<org::sdbuscpp::perftests_proxy>
+{
+public:
+    explicit Client(sdbus::IConnection& connection)
+        : ProxyInterfaces( connection
+                         , sdbus::ServiceName{"org.sdbuscpp.perftests"}
+                         , sdbus::ObjectPath{"/org/sdbuscpp/perftests"} )
+    {
+        registerProxy();
+    }
+
+    ~Client()
+    {
+        unregisterProxy();
+    }
+
+    void call(Calls calls, const std::string& string1, const std::string& string2)
+    {
+        if (calls == Calls::Sync)
+            (void)concatenateTwoStrings(string1, string2);
+        else
+            (void)getProxy().callMethodAsync("concatenateTwoStrings")
+                            .onInterface(INTERFACE_NAME)
+                            .withArguments(string1, string2)
+                            .getResultAsFuture<std::string>()
+                            .get();
+    }
+
+    void expectSignals(uint64_t count, std::vector<uint64_t>* latencies)
+    {
+        std::lock_guard lock(mutex_);
+        latencies_ = latencies;
+        expectedSignals_ = count;
+        receivedSignals_ = 0;
+    }
+
+    // Returns the arrival time of the last expected signal, or nothing if not all have arrived until the deadline.
+    // Signals are not recorded anymore afterwards.
+    std::optional<std::chrono::steady_clock::time_point> waitForSignals(std::chrono::steady_clock::time_point deadline)
+    {
+        while (std::chrono::steady_clock::now() < deadline)
+        {
+            {
+                std::lock_guard lock(mutex_);
+                if (receivedSignals_ >= expectedSignals_)
+                    break;
+            }
+            std::this_thread::sleep_for(1ms);
+        }
+
+        std::lock_guard lock(mutex_);
+        latencies_ = nullptr;
+        if (receivedSignals_ < expectedSignals_)
+            return std::nullopt;
+        return lastSignalAt_;
+    }
+
+protected:
+    virtual void onDataSignal(const std::string& /*data*/) override
+    {
+    }
+
+    virtual void onTimestampedDataSignal(const uint64_t& sentAt, const std::string& /*data*/) override
+    {
+        auto now = std::chrono::steady_clock::now();
+        std::lock_guard lock(mutex_);
+        lastSignalAt_ = now;
+        if (latencies_ != nullptr)
+            latencies_->push_back(static_cast<uint64_t>(now.time_since_epoch().count()) - sentAt);
+        ++receivedSignals_;
+    }
+
+private:
+    // Uncontended while signals flow, as the waiting thread checks only once per millisecond
+    std::mutex mutex_;
+    std::vector<uint64_t>* latencies_{};
+    std::chrono::steady_clock::time_point lastSignalAt_;
+    uint64_t expectedSignals_{};
+    uint64_t receivedSignals_{};
+};
+
+struct Usage
+{
+    std::chrono::microseconds cpuTime;
+    uint64_t contextSwitches;
+
+    static Usage now()
+    {
+        struct rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        auto toMicroseconds = [](const timeval& tv){ return std::chrono::seconds{tv.tv_sec} + std::chrono::microseconds{tv.tv_usec}; };
+        return { toMicroseconds(usage.ru_utime) + toMicroseconds(usage.ru_stime)
+               , static_cast<uint64_t>(usage.ru_nvcsw) + static_cast<uint64_t>(usage.ru_nivcsw) };
+    }
+};
+
+struct Results
+{
+    Run run;
+    std::vector<uint64_t> latencies; // In nanoseconds, sorted
+    uint64_t messages{};
+    uint64_t errors{};
+    std::chrono::nanoseconds duration{};
+    std::chrono::microseconds cpuTime{};
+    uint64_t contextSwitches{};
+    std::optional<uint64_t> pollWakeups;
+};
+
+std::string createRandomString(size_t length)
+{
+    std::string str(length, 0);
+    std::generate_n(str.begin(), length, [](){ return static_cast<char>('a' + rand() % 26); });
+    return str;
+}
+
+Results measure(const Options& options, const Run& run)
+{
+    Results results;
+    results.run = run;
+
+    auto connection = sdbus::createSystemBusConnection();
+    Client client(*connection);
+    EventLoopDriver driver(*connection, run.loop);
+
+    const auto string1 = createRandomString(options.payloadSize / 2);
+    const auto string2 = createRandomString(options.payloadSize - options.payloadSize / 2);
+
+    auto makeCalls = [&](uint32_t count, std::vector<uint64_t>* latencies)
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            auto start = std::chrono::steady_clock::now();
+            try
+            {
+                client.call(run.calls, string1, string2);
+            }
+            catch (const sdbus::Error&)
+            {
+                if (latencies != nullptr)
+                    ++results.errors;
+                continue;
+            }
+            if (latencies != nullptr)
+                latencies->push_back(static_cast<uint64_t>((std::chrono::steady_clock::now() - start).count()));
+        }
+    };
+
+    // Returns the time the last signal arrived at, or nothing if some signals got lost
+    auto receiveSignals = [&](uint32_t count, std::vector<uint64_t>* latencies) -> std::optional<std::chrono::steady_clock::time_point>
+    {
+        client.expectSignals(count, latencies);
+        try
+        {
+            client.sendTimestampedDataSignals(count, options.payloadSize);
+        }
+        catch (const sdbus::Error&)
+        {
+            return std::nullopt;
+        }
+        return client.waitForSignals(std::chrono::steady_clock::now() + 10s);
+    };
+
+    if (run.scenario == Scenario::RoundTrip)
+        makeCalls(options.warmup, nullptr);
+    else
+        (void)receiveSignals(options.warmup, nullptr);
+
+    results.latencies.reserve(options.requests);
+    auto usageBefore = Usage::now();
+    auto pollWakeupsBefore = driver.pollWakeups();
+    auto start = std::chrono::steady_clock::now();
+
+    if (run.scenario == Scenario::RoundTrip)
+    {
+        makeCalls(options.requests, &results.latencies);
+        results.duration = std::chrono::steady_clock::now() - start;
+    }
+    else
+    {
+        auto end = receiveSignals(options.requests, &results.latencies);
+        results.duration = (end ? *end : std::chrono::steady_clock::now()) - start;
+        if (!end)
+            results.errors = options.requests - results.latencies.size();
+    }
+
+    auto usageAfter = Usage::now();
+    results.messages = results.latencies.size();
+    results.cpuTime = usageAfter.cpuTime - usageBefore.cpuTime;
+    results.contextSwitches = usageAfter.contextSwitches - usageBefore.contextSwitches;
+    if (auto pollWakeupsAfter = driver.pollWakeups())
+        results.pollWakeups = *pollWakeupsAfter - *pollWakeupsBefore;
+    std::sort(results.latencies.begin(), results.latencies.end());
+
+    return results;
+}
+
+double percentileOf(const std::vector<uint64_t>& sorted, double percent)
+{
+    if (sorted.empty())
+        return 0.0;
+    auto rank = static_cast<size_t>(std::ceil(percent / 100.0 * static_cast<double>(sorted.size())));
+    return static_cast<double>(sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1]) / 1000.0;
+}
+
+double meanOf(const std::vector<uint64_t>& values)
+{
+    if (values.empty())
+        return 0.0;
+    long double sum{};
+    for (auto value : values)
+        sum += value;
+    return static_cast<double>(sum / values.size()) / 1000.0;
+}
+
+double perMessage(double value, const Results& results)
+{
+    return results.messages > 0 ? value / static_cast<double>(results.messages) : 0.0;
+}
+
+double throughputOf(const Results& results)
+{
+    auto seconds = std::chrono::duration<double>(results.duration).count();
+    return seconds > 0 ? static_cast<double>(results.messages) / seconds : 0.0;
+}
+
+// Round-trip kind of calls doesn't apply to signals
+const char* callsOf(const Run& run)
+{
+    return run.scenario == Scenario::RoundTrip ? toString(run.calls) : "";
+}
+
+void printText(const Options& options, const std::vector<Results>& allResults)
+{
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Payload size: " << options.payloadSize << ", messages per run: " << options.requests << std::endl;
+    std::cout << std::left << std::setw(10) << "loop" << std::setw(11) << "scenario" << std::setw(7) << "calls" << std::right
+              << std::setw(12) << "msgs/s" << std::setw(10) << "p50 us" << std::setw(10) << "p99 us"
+              << std::setw(12) << "cpu us/msg" << std::setw(13) << "ctxsw/msg" << std::setw(12) << "polls/msg"
+              << std::setw(8) << "errors" << std::endl;
+    for (const auto& results : allResults)
+    {
+        std::cout << std::left << std::setw(10) << toString(results.run.loop) << std::setw(11) << toString(results.run.scenario)
+                  << std::setw(7) << callsOf(results.run) << std::right
+                  << std::setw(12) << throughputOf(results)
+                  << std::setw(10) << percentileOf(results.latencies, 50) << std::setw(10) << percentileOf(results.latencies, 99)
+                  << std::setw(12) << perMessage(static_cast<double>(results.cpuTime.count()), results)
+                  << std::setw(13) << perMessage(static_cast<double>(results.contextSwitches), results)
+                  << std::setw(12);
+        if (results.pollWakeups)
+            std::cout << perMessage(static_cast<double>(*results.pollWakeups), results);
+        else
+            std::cout << "-";
+        std::cout << std::setw(8) << results.errors << std::endl;
+    }
+}
+
+void printCsv(const Options& options, const std::vector<Results>& allResults)
+{
+    if (options.csvHeader)
+        std::cout << "label,loop,scenario,calls,payload_size,messages,errors,duration_ms,throughput_per_s,"
+                     "min_us,mean_us,p50_us,p90_us,p99_us,max_us,cpu_us_per_msg,context_switches_per_msg,poll_wakeups_per_msg" << std::endl;
+
+    std::cout << std::fixed << std::setprecision(3);
+    for (const auto& results : allResults)
+    {
+        std::cout << options.label << ',' << toString(results.run.loop) << ',' << toString(results.run.scenario) << ','
+                  << callsOf(results.run) << ',' << options.payloadSize << ',' << results.messages << ',' << results.errors << ','
+                  << std::chrono::duration<double, std::milli>(results.duration).count() << ',' << throughputOf(results) << ','
+                  << percentileOf(results.latencies, 0) << ',' << meanOf(results.latencies) << ','
+                  << percentileOf(results.latencies, 50) << ',' << percentileOf(results.latencies, 90) << ','
+                  << percentileOf(results.latencies, 99) << ',' << percentileOf(results.latencies, 100) << ','
+                  << perMessage(static_cast<double>(results.cpuTime.count()), results) << ','
+                  << perMessage(static_cast<double>(results.contextSwitches), results) << ',';
+        if (results.pollWakeups)
+            std::cout << perMessage(static_cast<double>(*results.pollWakeups), results);
+        std::cout << std::endl;
+    }
+}
+
+void printJson(const Options& options, const std::vector<Results>& allResults)
+{
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "[";
+    const char* separator = "";
+    for (const auto& results : allResults)
+    {
+        std::string label;
+        for (char c : options.label)
+            if (static_cast<unsigned char>(c) >= 0x20)
+                label += (c == '"' || c == '\\') ? std::string{'\\', c} : std::string{c};
+
+        std::cout << separator << "\n  {\"label\": \"" << label << "\", \"loop\": \"" << toString(results.run.loop)
+                  << "\", \"scenario\": \"" << toString(results.run.scenario) << "\", \"calls\": \"" << callsOf(results.run)
+                  << "\", \"payload_size\": " << options.payloadSize << ", \"messages\": " << results.messages
+                  << ", \"errors\": " << results.errors
+                  << ", \"duration_ms\": " << std::chrono::duration<double, std::milli>(results.duration).count()
+                  << ", \"throughput_per_s\": " << throughputOf(results)
+                  << ", \"latency_us\": {\"min\": " << percentileOf(results.latencies, 0) << ", \"mean\": " << meanOf(results.latencies)
+                  << ", \"p50\": " << percentileOf(results.latencies, 50) << ", \"p90\": " << percentileOf(results.latencies, 90)
+                  << ", \"p99\": " << percentileOf(results.latencies, 99) << ", \"max\": " << percentileOf(results.latencies, 100) << "}"
+                  << ", \"cpu_us_per_msg\": " << perMessage(static_cast<double>(results.cpuTime.count()), results)
+                  << ", \"context_switches_per_msg\": " << perMessage(static_cast<double>(results.contextSwitches), results)
+                  << ", \"poll_wakeups_per_msg\": ";
+        if (results.pollWakeups)
+            std::cout << perMessage(static_cast<double>(*results.pollWakeups), results);
+        else
+            std::cout << "null";
+        std::cout << "}";
+        separator = ",";
+    }
+    std::cout << "\n]" << std::endl;
+}
+
+void printUsage(const char* program)
+{
+    std::cerr << "Usage: " << program << " [OPTION]...\n"
+              << "Compares event loop integration modes against sdbus-c++-perf-tests-server. Runs all combinations of the\n"
+              << "selected loops, scenarios and calls, except those that need an event loop but have none.\n\n"
+              << "  --loop=internal|sd-event|external|none|all   Way of driving the client connection (default: all)\n"
+              << "  --scenario=roundtrip|signals|all             Measured traffic (default: all)\n"
+              << "  --calls=sync|async|all                       Kind of method calls of round trips (default: all)\n"
+              << "  --size=N                                     Payload size in bytes (default: 20)\n"
+              << "  --requests=N                                 Measured calls or signals per run (default: 10000)\n"
+              << "  --warmup=N                                   Unmeasured calls or signals per run (default: 1000)\n"
+              << "  --format=text|csv|json                       Output format (default: text)\n"
+              << "  --no-header                                  Omit the CSV header line, e.g. to append runs to one file\n"
+              << "  --label=TEXT                                 Label of the runs, e.g. the library version under test\n";
+}
+
+std::optional<Options> parseOptions(int argc, char* argv[])
+{
+    Options options;
+
+    auto toNumber = [](const std::string& value) -> std::optional<uint32_t>
+    {
+        try
+        {
+            size_t pos{};
+            auto number = std::stoul(value, &pos);
+            if (pos != value.size() || number > UINT32_MAX)
+                return std::nullopt;
+            return static_cast<uint32_t>(number);
+        }
+        catch (const std::exception&)
+        {
+            return std::nullopt;
+        }
+    };
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--no-header")
+        {
+            options.csvHeader = false;
+            continue;
+        }
+
+        auto eq = arg.find('=');
+        if (arg.rfind("--", 0) != 0 || eq == std::string::npos)
+            return std::nullopt;
+        auto name = arg.substr(2, eq - 2);
+        auto value = arg.substr(eq + 1);
+
+        std::optional<uint32_t> number;
+        if (name == "loop" && value == "internal") options.loops = {Loop::Internal};
+        else if (name == "loop" && value == "sd-event") options.loops = {Loop::SdEvent};
+        else if (name == "loop" && value == "external") options.loops = {Loop::External};
+        else if (name == "loop" && value == "none") options.loops = {Loop::None};
+        else if (name == "loop" && value == "all") options.loops = Options{}.loops;
+        else if (name == "scenario" && value == "roundtrip") options.scenarios = {Scenario::RoundTrip};
+        else if (name == "scenario" && value == "signals") options.scenarios = {Scenario::Signals};
+        else if (name == "scenario" && value == "all") options.scenarios = Options{}.scenarios;
+        else if (name == "calls" && value == "sync") options.calls = {Calls::Sync};
+        else if (name == "calls" && value == "async") options.calls = {Calls::Async};
+        else if (name == "calls" && value == "all") options.calls = Options{}.calls;
+        else if (name == "format" && value == "text") options.format = Format::Text;
+        else if (name == "format" && value == "csv") options.format = Format::Csv;
+        else if (name == "format" && value == "json") options.format = Format::Json;
+        else if (name == "label") options.label = value;
+        else if (name == "size" && (number = toNumber(value))) options.payloadSize = *number;
+        else if (name == "requests" && (number = toNumber(value))) options.requests = *number;
+        else if (name == "warmup" && (number = toNumber(value))) options.warmup = *number;
+        else
+            return std::nullopt;
+    }
+
+    return options;
+}
+
+std::vector<Run> plan(const Options& options)
+{
+    std::vector<Run> runs;
+    for (auto loop : options.loops)
+        for (auto scenario : options.scenarios)
+        {
+            // Signals are measured once per loop, since no calls are involved
+            auto calls = scenario == Scenario::RoundTrip ? options.calls : std::vector<Calls>{Calls::Sync};
+            for (auto kind : calls)
+                if (Run run{loop, scenario, kind}; isSupported(run))
+                    runs.push_back(run);
+        }
+    return runs;
+}
+
+}
+
+//-----------------------------------------
+int main(int argc, char* argv[])
+{
+    auto options = parseOptions(argc, argv);
+    if (!options)
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::vector<Results> allResults;
+    try
+    {
+        for (const auto& run : plan(*options))
+            allResults.push_back(measure(*options, run));
+    }
+    catch (const sdbus::Error& e)
+    {
+        std::cerr << "Benchmark run failed: " << e.getName() << ": " << e.getMessage() << std::endl;
+        return 1;
+    }
+
+    switch (options->format)
+    {
+        case Format::Text: printText(*options, allResults); break;
+        case Format::Csv: printCsv(*options, allResults); break;
+        case Format::Json: printJson(*options, allResults); break;
+    }
+
+    auto failed = std::any_of(allResults.begin(), allResults.end(), [](const auto& results){ return results.errors > 0; });
+    return failed ? 2 : 0;
+}
@@ -0,0 +1,731 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file load.cpp
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Load generator against sdbus-c++-perf-tests-server. Runs threads x connections x in-flight calls
+// (or signal subscribers), and reports throughput and latency distribution as text, CSV or JSON.
+
+#include "perftests-proxy.h"
+#include <sdbus-c++/sdbus-c++.h>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+enum class Mode { SyncCalls, AsyncCalls, Signals };
+enum class Shape { String, Bytes, Records };
+enum class Format { Text, Csv, Json };
+
+struct Options
+{
+    Mode mode{Mode::SyncCalls};
+    Shape shape{Shape::String};
+    uint32_t payloadSize{20};   // Bytes for the string and bytes shapes, number of records for the records shape
+    unsigned threads{1};
+    unsigned connections{1};    // Per thread
+    unsigned inFlight{1};       // Outstanding async calls per connection
+    uint32_t requests{1000};    // Measured calls, or requested signals, per connection
+    uint32_t warmup{100};       // Unmeasured calls, or requested signals, per connection
+    Format format{Format::Text};
+    bool csvHeader{true};
+    std::string label;
+};
+
+const char* toString(Mode mode)
+{
+    switch (mode)
+    {
+        case Mode::SyncCalls: return "sync";
+        case Mode::AsyncCalls: return "async";
+        case Mode::Signals: return "signals";
+    }
+    return "";
+}
+
+const char* toString(Shape shape)
+{
+    switch (shape)
+    {
+        case Shape::String: return "string";
+        case Shape::Bytes: return "bytes";
+        case Shape::Records: return "records";
+    }
+    return "";
+}
+
+// Log-linear histogram of latencies in nanoseconds. Values are bucketed by their power of two, and each
+// power of two is split into linear sub-buckets, so percentiles are exact to within ~1.6% at any scale
+// while the histogram keeps a fixed size and can be merged cheaply.
+class LatencyHistogram
+{
+public:
+    static constexpr unsigned SUB_BUCKET_BITS = 7;
+    static constexpr uint64_t SUB_BUCKET_COUNT = uint64_t{1} << SUB_BUCKET_BITS;
+    static constexpr uint64_t SUB_BUCKET_HALF_COUNT = SUB_BUCKET_COUNT / 2;
+    static constexpr size_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS) * SUB_BUCKET_HALF_COUNT + SUB_BUCKET_COUNT;
+
+    void record(std::chrono::nanoseconds latency)
+    {
+        auto value = static_cast<uint64_t>(std::max(latency.count(), std::chrono::nanoseconds::rep{0}));
+        ++counts_[indexOf(value)];
+        ++count_;
+        sum_ += value;
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+
+    void merge(const LatencyHistogram& other)
+    {
+        for (size_t i = 0; i < BUCKET_COUNT; ++i)
+            counts_[i] += other.counts_[i];
+        count_ += other.count_;
+        sum_ += other.sum_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+
+    uint64_t count() const { return count_; }
+    uint64_t min() const { return count_ > 0 ? min_ : 0; }
+    uint64_t max() const { return max_; }
+    double mean() const { return count_ > 0 ? static_cast<double>(sum_) / static_cast<double>(count_) : 0.0; }
+
+    // Returns the upper bound of the bucket the given percentile falls into
+    uint64_t percentile(double percent) const
+    {
+        if (count_ == 0)
+            return 0;
+
+        auto target = static_cast<uint64_t>(std::ceil(percent / 100.0 * static_cast<double>(count_)));
+        target = std::clamp<uint64_t>(target, 1, count_);
+        uint64_t cumulative{};
+        for (size_t i = 0; i < BUCKET_COUNT; ++i)
+        {
+            cumulative += counts_[i];
+            if (cumulative >= target)
+                return std::min(upperBoundOf(i), max_);
+        }
+        return max_;
+    }
+
+    // Invokes the callback with lower bound, upper bound and count of each non-empty bucket, in ascending order
+    template <typename _Callback>
+    void forEachBucket(_Callback&& callback) const
+    {
+        for (size_t i = 0; i < BUCKET_COUNT; ++i)
+            if (counts_[i] > 0)
+                callback(lowerBoundOf(i), upperBoundOf(i), counts_[i]);
+    }
+
+private:
+    static size_t indexOf(uint64_t value)
+    {
+        if (value < SUB_BUCKET_COUNT)
+            return value;
+        auto shift = static_cast<unsigned>(std::bit_width(value)) - SUB_BUCKET_BITS;
+        return shift * SUB_BUCKET_HALF_COUNT + (value >> shift);
+    }
+
+    static uint64_t lowerBoundOf(size_t index)
+    {
+        if (index < SUB_BUCKET_COUNT)
+            return index;
+        auto shift = (index - SUB_BUCKET_HALF_COUNT) / SUB_BUCKET_HALF_COUNT;
+        return (index - shift * SUB_BUCKET_HALF_COUNT) << shift;
+    }
+
+    static uint64_t upperBoundOf(size_t index)
+    {
+        if (index < SUB_BUCKET_COUNT)
+            return index;
+        auto shift = (index - SUB_BUCKET_HALF_COUNT) / SUB_BUCKET_HALF_COUNT;
+        return lowerBoundOf(index) + (uint64_t{1} << shift) - 1;
+    }
+
+    std::vector<uint64_t> counts_ = std::vector<uint64_t>(BUCKET_COUNT);
+    uint64_t count_{};
+    uint64_t sum_{};
+    uint64_t min_{UINT64_MAX};
+    uint64_t max_{};
+};
+
+using Record = sdbus::Struct<uint32_t, double, std::string>;
+
+struct Payload
+{
+    std::string string1;
+    std::string string2;
+    std::vector<uint8_t> bytes;
+    std::vector<Record> records;
+};
+
+std::string createRandomString(size_t length)
+{
+    auto randchar = []() -> char
+    {
+        const char charset[] =
+        "0123456789"
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+        "abcdefghijklmnopqrstuvwxyz";
+        const size_t max_index = (sizeof(charset) - 1);
+        return charset[ rand() % max_index ];
+    };
+    std::string str(length, 0);
+    std::generate_n(str.begin(), length, randchar);
+    return str;
+}
+
+Payload createPayload(Shape shape, uint32_t size)
+{
+    Payload payload;
+    switch (shape)
+    {
+        case Shape::String:
+            payload.string1 = createRandomString(size/2);
+            payload.string2 = createRandomString(size - size/2);
+            break;
+        case Shape::Bytes:
+            payload.bytes.resize(size);
+            for (uint32_t i = 0; i < size; ++i)
+                payload.bytes[i] = static_cast<uint8_t>(i);
+            break;
+        case Shape::Records:
+            payload.records.reserve(size);
+            for (uint32_t i = 0; i < size; ++i)
+                payload.records.emplace_back(i, i * 0.5, createRandomString(16));
+            break;
+    }
+    return payload;
+}
+
+class LoadClient final : public sdbus::ProxyInterfaces<org::sdbuscpp::perftests_proxy>
+{
+public:
+    LoadClient(const Options& options, const Payload& payload)
+        : ProxyInterfaces( sdbus::createSystemBusConnection()
+                         , sdbus::ServiceName{"org.sdbuscpp.perftests"}
+                         , sdbus::ObjectPath{"/org/sdbuscpp/perftests"} )
+        , options_(options)
+        , payload_(payload)
+    {
+        registerProxy();
+    }
+
+    ~LoadClient()
+    {
+        unregisterProxy();
+    }
+
+    void callSync(bool measured)
+    {
+        auto start = std::chrono::steady_clock::now();
+        try
+        {
+            switch (options_.shape)
+            {
+                case Shape::String: (void)concatenateTwoStrings(payload_.string1, payload_.string2); break;
+                case Shape::Bytes: (void)echoBytes(payload_.bytes); break;
+                case Shape::Records: (void)echoRecords(payload_.records); break;
+            }
+        }
+        catch (const sdbus::Error&)
+        {
+            ++errors_;
+            return;
+        }
+        if (measured)
+            histogram_.record(std::chrono::steady_clock::now() - start);
+    }
+
+    // Issues the given number of async calls, keeping at most `in-flight` of them outstanding at a time
+    std::future<void> startAsyncCalls(uint32_t count, bool measured)
+    {
+        measured_ = measured;
+        asyncCallsToIssue_ = count;
+        asyncCallsPending_ = count;
+        asyncCallsDone_ = std::promise<void>{};
+        auto future = asyncCallsDone_.get_future();
+
+        if (count == 0)
+            asyncCallsDone_.set_value();
+        for (unsigned i = 0; i < options_.inFlight && claimAsyncCall(); ++i)
+            issueAsyncCall();
+
+        return future;
+    }
+
+    void expectSignals(uint64_t count, bool measured)
+    {
+        measured_ = measured;
+        expectedSignals_ = count;
+        receivedSignals_ = 0;
+    }
+
+    void requestSignals(uint32_t count)
+    {
+        try
+        {
+            sendTimestampedDataSignals(count, options_.payloadSize);
+        }
+        catch (const sdbus::Error&)
+        {
+            ++errors_;
+        }
+    }
+
+    // Returns the number of expected signals that haven't arrived until the deadline
+    uint64_t waitForSignals(std::chrono::steady_clock::time_point deadline)
+    {
+        while (receivedSignals_.load(std::memory_order_acquire) < expectedSignals_ && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(1ms);
+        auto received = receivedSignals_.load(std::memory_order_acquire);
+        return received < expectedSignals_ ? expectedSignals_ - received : 0;
+    }
+
+    const LatencyHistogram& histogram() const { return histogram_; }
+    uint64_t errors() const { return errors_; }
+
+protected:
+    virtual void onDataSignal(const std::string& /*data*/) override
+    {
+    }
+
+    virtual void onTimestampedDataSignal(const uint64_t& sentAt, const std::string& /*data*/) override
+    {
+        if (measured_)
+        {
+            auto now = std::chrono::steady_clock::now().time_since_epoch();
+            histogram_.record(now - std::chrono::nanoseconds{static_cast<int64_t>(sentAt)});
+        }
+        receivedSignals_.fetch_add(1, std::memory_order_release);
+    }
+
+private:
+    bool claimAsyncCall()
+    {
+        auto toIssue = asyncCallsToIssue_.load();
+        while (toIssue > 0 && !asyncCallsToIssue_.compare_exchange_weak(toIssue, toIssue - 1))
+            ;
+        return toIssue > 0;
+    }
+
+    void issueAsyncCall()
+    {
+        try
+        {
+            switch (options_.shape)
+            {
+                case Shape::String:
+                    issueAsyncCall<std::string>("concatenateTwoStrings", payload_.string1, payload_.string2);
+                    break;
+                case Shape::Bytes:
+                    issueAsyncCall<std::vector<uint8_t>>("echoBytes", payload_.bytes);
+                    break;
+                case Shape::Records:
+                    issueAsyncCall<std::vector<Record>>("echoRecords", payload_.records);
+                    break;
+            }
+        }
+        catch (const sdbus::Error&)
+        {
+            ++errors_;
+            onAsyncCallFinished();
+        }
+    }
+
+    template <typename _Result, typename... _Args>
+    void issueAsyncCall(const char* methodName, const _Args&... args)
+    {
+        auto start = std::chrono::steady_clock::now();
+        getProxy().callMethodAsync(methodName).onInterface(INTERFACE_NAME).withArguments(args...)
+                  .uponReplyInvoke([this, start](std::optional<sdbus::Error> error, const _Result& /*result*/)
+                  {
+                      if (error)
+                          ++errors_;
+                      else if (measured_)
+                          histogram_.record(std::chrono::steady_clock::now() - start);
+
+                      if (claimAsyncCall())
+                          issueAsyncCall();
+                      onAsyncCallFinished();
+                  });
+    }
+
+    void onAsyncCallFinished()
+    {
+        if (asyncCallsPending_.fetch_sub(1) == 1)
+            asyncCallsDone_.set_value();
+    }
+
+    const Options& options_;
+    const Payload& payload_;
+    // Recorded to by one thread at a time only: the load thread for sync calls, the event loop thread otherwise
+    LatencyHistogram histogram_;
+    std::atomic<uint64_t> errors_{};
+    std::atomic<bool> measured_{};
+    std::atomic<uint32_t> asyncCallsToIssue_{};
+    std::atomic<uint32_t> asyncCallsPending_{};
+    std::promise<void> asyncCallsDone_;
+    uint64_t expectedSignals_{};
+    std::atomic<uint64_t> receivedSignals_{};
+};
+
+struct Results
+{
+    LatencyHistogram histogram;
+    uint64_t errors{};
+    uint64_t lostSignals{};
+    std::chrono::nanoseconds duration{};
+};
+
+// Runs one phase of the load (warm-up or measurement), each load thread driving its own connections
+void runPhase(const Options& options, std::vector<std::unique_ptr<LoadClient>>& clients, uint32_t count, bool measured)
+{
+    if (options.mode == Mode::Signals)
+    {
+        // Signals are broadcast, so each subscriber receives the signals requested through all connections
+        for (auto& client : clients)
+            client->expectSignals(uint64_t{count} * clients.size(), measured);
+    }
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < options.threads; ++t)
+    {
+        threads.emplace_back([&, t]()
+        {
+            auto first = clients.begin() + t * options.connections;
+            auto last = first + options.connections;
+
+            switch (options.mode)
+            {
+                case Mode::SyncCalls:
+                    for (uint32_t i = 0; i < count; ++i)
+                        for (auto it = first; it != last; ++it)
+                            (*it)->callSync(measured);
+                    break;
+                case Mode::AsyncCalls:
+                {
+                    std::vector<std::future<void>> done;
+                    for (auto it = first; it != last; ++it)
+                        done.push_back((*it)->startAsyncCalls(count, measured));
+                    for (auto& future : done)
+                        future.wait();
+                    break;
+                }
+                case Mode::Signals:
+                    for (auto it = first; it != last; ++it)
+                        (*it)->requestSignals(count);
+                    break;
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+}
+
+Results run(const Options& options)
+{
+    auto payload = createPayload(options.shape, options.payloadSize);
+
+    std::vector<std::unique_ptr<LoadClient>> clients;
+    for (unsigned i = 0; i < options.threads * options.connections; ++i)
+        clients.push_back(std::make_unique<LoadClient>(options, payload));
+
+    Results results;
+    auto waitForSignals = [&]()
+    {
+        uint64_t lost{};
+        auto deadline = std::chrono::steady_clock::now() + 10s;
+        for (auto& client : clients)
+            lost += client->waitForSignals(deadline);
+        return lost;
+    };
+
+    runPhase(options, clients, options.warmup, false);
+    if (options.mode == Mode::Signals)
+        waitForSignals();
+
+    // Errors of the warm-up phase are not reported
+    uint64_t warmupErrors{};
+    for (auto& client : clients)
+        warmupErrors += client->errors();
+
+    auto start = std::chrono::steady_clock::now();
+    runPhase(options, clients, options.requests, true);
+    if (options.mode == Mode::Signals)
+        results.lostSignals = waitForSignals();
+    results.duration = std::chrono::steady_clock::now() - start;
+
+    for (auto& client : clients)
+    {
+        results.histogram.merge(client->histogram());
+        results.errors += client->errors();
+    }
+    results.errors -= warmupErrors;
+
+    return results;
+}
+
+double toMicroseconds(uint64_t nanoseconds)
+{
+    return static_cast<double>(nanoseconds) / 1000.0;
+}
+
+double throughputOf(const Results& results)
+{
+    auto seconds = std::chrono::duration<double>(results.duration).count();
+    return seconds > 0 ? static_cast<double>(results.histogram.count()) / seconds : 0.0;
+}
+
+std::string escapeJson(const std::string& str)
+{
+    std::string result;
+    for (char c : str)
+    {
+        if (c == '"' || c == '\\')
+            result += {'\\', c};
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            char buffer[8];
+            std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+            result += buffer;
+        }
+        else
+            result += c;
+    }
+    return result;
+}
+
+void printText(const Options& options, const Results& results)
+{
+    const auto& histogram = results.histogram;
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Mode: " << toString(options.mode) << ", shape: " << toString(options.shape)
+              << ", payload size: " << options.payloadSize << ", threads: " << options.threads
+              << ", connections per thread: " << options.connections << ", in-flight calls: " << options.inFlight << std::endl;
+    std::cout << "Samples: " << histogram.count() << ", errors: " << results.errors << ", lost signals: " << results.lostSignals
+              << ", duration: " << std::chrono::duration_cast<std::chrono::milliseconds>(results.duration).count() << " ms"
+              << ", throughput: " << throughputOf(results) << " /s" << std::endl;
+    std::cout << "Latency [us]: min " << toMicroseconds(histogram.min()) << ", mean " << histogram.mean() / 1000.0
+              << ", p50 " << toMicroseconds(histogram.percentile(50)) << ", p90 " << toMicroseconds(histogram.percentile(90))
+              << ", p99 " << toMicroseconds(histogram.percentile(99)) << ", p999 " << toMicroseconds(histogram.percentile(99.9))
+              << ", max " << toMicroseconds(histogram.max()) << std::endl;
+
+    if (histogram.count() == 0)
+        return;
+
+    // Fold the fine-grained buckets into powers of two for a compact overview
+    std::vector<std::pair<uint64_t, uint64_t>> rows; // Lower bound, count
+    histogram.forEachBucket([&](uint64_t lower, uint64_t /*upper*/, uint64_t count)
+    {
+        auto rowLower = lower == 0 ? 0 : std::bit_floor(lower);
+        if (rows.empty() || rows.back().first != rowLower)
+            rows.emplace_back(rowLower, 0);
+        rows.back().second += count;
+    });
+    auto maxCount = std::max_element(rows.begin(), rows.end(), [](auto& a, auto& b){ return a.second < b.second; })->second;
+
+    std::cout << "Histogram [us]:" << std::endl;
+    for (const auto& [lower, count] : rows)
+    {
+        auto upper = lower == 0 ? 1 : lower * 2;
+        std::cout << std::setw(12) << toMicroseconds(lower) << " - " << std::setw(12) << toMicroseconds(upper) << " | "
+                  << std::left << std::setw(50) << std::string(static_cast<size_t>(50 * count / maxCount), '#') << std::right
+                  << " " << count << std::endl;
+    }
+}
+
+void printCsv(const Options& options, const Results& results)
+{
+    const auto& histogram = results.histogram;
+
+    if (options.csvHeader)
+        std::cout << "label,mode,shape,payload_size,threads,connections,in_flight,samples,errors,lost_signals,"
+                     "duration_ms,throughput_per_s,min_us,mean_us,p50_us,p90_us,p99_us,p999_us,max_us" << std::endl;
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << options.label << ',' << toString(options.mode) << ',' << toString(options.shape) << ',' << options.payloadSize << ','
+              << options.threads << ',' << options.connections << ',' << options.inFlight << ',' << histogram.count() << ','
+              << results.errors << ',' << results.lostSignals << ','
+              << std::chrono::duration<double, std::milli>(results.duration).count() << ',' << throughputOf(results) << ','
+              << toMicroseconds(histogram.min()) << ',' << histogram.mean() / 1000.0 << ','
+              << toMicroseconds(histogram.percentile(50)) << ',' << toMicroseconds(histogram.percentile(90)) << ','
+              << toMicroseconds(histogram.percentile(99)) << ',' << toMicroseconds(histogram.percentile(99.9)) << ','
+              << toMicroseconds(histogram.max()) << std::endl;
+}
+
+void printJson(const Options& options, const Results& results)
+{
+    const auto& histogram = results.histogram;
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "{\n"
+              << "  \"label\": \"" << escapeJson(options.label) << "\",\n"
+              << "  \"config\": {\"mode\": \"" << toString(options.mode) << "\", \"shape\": \"" << toString(options.shape)
+              << "\", \"payload_size\": " << options.payloadSize << ", \"threads\": " << options.threads
+              << ", \"connections\": " << options.connections << ", \"in_flight\": " << options.inFlight
+              << ", \"requests\": " << options.requests << ", \"warmup\": " << options.warmup << "},\n"
+              << "  \"samples\": " << histogram.count() << ",\n"
+              << "  \"errors\": " << results.errors << ",\n"
+              << "  \"lost_signals\": " << results.lostSignals << ",\n"
+              << "  \"duration_ms\": " << std::chrono::duration<double, std::milli>(results.duration).count() << ",\n"
+              << "  \"throughput_per_s\": " << throughputOf(results) << ",\n"
+              << "  \"latency_us\": {\"min\": " << toMicroseconds(histogram.min()) << ", \"mean\": " << histogram.mean() / 1000.0
+              << ", \"p50\": " << toMicroseconds(histogram.percentile(50)) << ", \"p90\": " << toMicroseconds(histogram.percentile(90))
+              << ", \"p99\": " << toMicroseconds(histogram.percentile(99)) << ", \"p999\": " << toMicroseconds(histogram.percentile(99.9))
+              << ", \"max\": " << toMicroseconds(histogram.max()) << "},\n"
+              << "  \"histogram_ns\": [";
+    const char* separator = "";
+    histogram.forEachBucket([&](uint64_t lower, uint64_t upper, uint64_t count)
+    {
+        std::cout << separator << "\n    {\"lower\": " << lower << ", \"upper\": " << upper << ", \"count\": " << count << "}";
+        separator = ",";
+    });
+    std::cout << "\n  ]\n}" << std::endl;
+}
+
+void printUsage(const char* program)
+{
+    std::cerr << "Usage: " << program << " [OPTION]...\n"
+              << "Generates load against sdbus-c++-perf-tests-server and reports throughput and latency distribution.\n\n"
+              << "  --mode=sync|async|signals      Kind of load (default: sync)\n"
+              << "  --shape=string|bytes|records   Payload of method calls (default: string); signals always carry a string\n"
+              << "  --size=N                       Payload size in bytes, or number of records for the records shape (default: 20)\n"
+              << "  --threads=N                    Number of load threads (default: 1)\n"
+              << "  --connections=N                Number of bus connections per thread (default: 1)\n"
+              << "  --in-flight=N                  Outstanding async calls per connection (default: 1)\n"
+              << "  --requests=N                   Measured calls, or requested signals, per connection (default: 1000)\n"
+              << "  --warmup=N                     Unmeasured calls, or requested signals, per connection (default: 100)\n"
+              << "  --format=text|csv|json         Output format (default: text)\n"
+              << "  --no-header                    Omit the CSV header line, e.g. to append runs to one file\n"
+              << "  --label=TEXT                   Label of the run, e.g. the library version under test\n";
+}
+
+std::optional<Options> parseOptions(int argc, char* argv[])
+{
+    Options options;
+
+    auto toNumber = [](const std::string& value, unsigned long min) -> std::optional<uint32_t>
+    {
+        try
+        {
+            size_t pos{};
+            auto number = std::stoul(value, &pos);
+            if (pos != value.size() || number < min || number > UINT32_MAX)
+                return std::nullopt;
+            return static_cast<uint32_t>(number);
+        }
+        catch (const std::exception&)
+        {
+            return std::nullopt;
+        }
+    };
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--no-header")
+        {
+            options.csvHeader = false;
+            continue;
+        }
+
+        auto eq = arg.find('=');
+        if (arg.rfind("--", 0) != 0 || eq == std::string::npos)
+            return std::nullopt;
+        auto name = arg.substr(2, eq - 2);
+        auto value = arg.substr(eq + 1);
+
+        std::optional<uint32_t> number;
+        if (name == "mode" && value == "sync") options.mode = Mode::SyncCalls;
+        else if (name == "mode" && value == "async") options.mode = Mode::AsyncCalls;
+        else if (name == "mode" && value == "signals") options.mode = Mode::Signals;
+        else if (name == "shape" && value == "string") options.shape = Shape::String;
+        else if (name == "shape" && value == "bytes") options.shape = Shape::Bytes;
+        else if (name == "shape" && value == "records") options.shape = Shape::Records;
+        else if (name == "format" && value == "text") options.format = Format::Text;
+        else if (name == "format" && value == "csv") options.format = Format::Csv;
+        else if (name == "format" && value == "json") options.format = Format::Json;
+        else if (name == "label") options.label = value;
+        else if (name == "size" && (number = toNumber(value, 0))) options.payloadSize = *number;
+        else if (name == "threads" && (number = toNumber(value, 1))) options.threads = *number;
+        else if (name == "connections" && (number = toNumber(value, 1))) options.connections = *number;
+        else if (name == "in-flight" && (number = toNumber(value, 1))) options.inFlight = *number;
+        else if (name == "requests" && (number = toNumber(value, 0))) options.requests = *number;
+        else if (name == "warmup" && (number = toNumber(value, 0))) options.warmup = *number;
+        else
+            return std::nullopt;
+    }
+
+    return options;
+}
+
+}
+
+//-----------------------------------------
+int main(int argc, char* argv[])
+{
+    auto options = parseOptions(argc, argv);
+    if (!options)
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    Results results;
+    try
+    {
+        results = run(*options);
+    }
+    catch (const sdbus::Error& e)
+    {
+        std::cerr << "Load run failed: " << e.getName() << ": " << e.getMessage() << std::endl;
+        return 1;
+    }
+
+    switch (options->format)
+    {
+        case Format::Text: printText(*options, results); break;
+        case Format::Csv: printCsv(*options, results); break;
+        case Format::Json: printJson(*options, results); break;
+    }
+
+    return results.errors == 0 && results.lostSignals == 0 ? 0 : 2;
+}
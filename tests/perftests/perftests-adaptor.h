@@ -35,7 +35,11 @@ protected:
     {
         m_object.addVTable( sdbus::registerMethod("sendDataSignals").withInputParamNames("numberOfSignals", "signalMsgSize").implementedAs([this](const uint32_t& numberOfSignals, const uint32_t& signalMsgSize){ return this->sendDataSignals(numberOfSignals, signalMsgSize); })
                           , sdbus::registerMethod("concatenateTwoStrings").withInputParamNames("string1", "string2").withOutputParamNames("result").implementedAs([this](const std::string& string1, const std::string& string2){ return this->concatenateTwoStrings(string1, string2); })
+                          , sdbus::registerMethod("echoBytes").withInputParamNames("data").withOutputParamNames("result").implementedAs([this](const std::vector<uint8_t>& data){ return this->echoBytes(data); })
+                          , sdbus::registerMethod("echoRecords").withInputParamNames("records").withOutputParamNames("result").implementedAs([this](const std::vector<sdbus::Struct<uint32_t, double, std::string>>& records){ return this->echoRecords(records); })
+                          , sdbus::registerMethod("sendTimestampedDataSignals").withInputParamNames("numberOfSignals", "signalMsgSize").implementedAs([this](const uint32_t& numberOfSignals, const uint32_t& signalMsgSize){ return this->sendTimestampedDataSignals(numberOfSignals, signalMsgSize); })
                           , sdbus::registerSignal("dataSignal").withParameters<std::string>("data")
+                          , sdbus::registerSignal("timestampedDataSignal").withParameters<uint64_t, std::string>("sentAt", "data")
                           ).forInterface(INTERFACE_NAME);
     }
 
@@ -45,9 +49,17 @@ public:
         m_object.emitSignal("dataSignal").onInterface(INTERFACE_NAME).withArguments(data);
     }
 
+    void emitTimestampedDataSignal(const uint64_t& sentAt, const std::string& data)
+    {
+        m_object.emitSignal("timestampedDataSignal").onInterface(INTERFACE_NAME).withArguments(sentAt, data);
+    }
+
 private:
     virtual void sendDataSignals(const uint32_t& numberOfSignals, const uint32_t& signalMsgSize) = 0;
     virtual std::string concatenateTwoStrings(const std::string& string1, const std::string& string2) = 0;
+    virtual std::vector<uint8_t> echoBytes(const std::vector<uint8_t>& data) = 0;
+    virtual std::vector<sdbus::Struct<uint32_t, double, std::string>> echoRecords(const std::vector<sdbus::Struct<uint32_t, double, std::string>>& records) = 0;
+    virtual void sendTimestampedDataSignals(const uint32_t& numberOfSignals, const uint32_t& signalMsgSize) = 0;
 
 private:
     sdbus::IObject& m_object;
@@ -34,9 +34,11 @@ protected:
     void registerProxy()
     {
         m_proxy.uponSignal("dataSignal").onInterface(INTERFACE_NAME).call([this](const std::string& data){ this->onDataSignal(data); });
+        m_proxy.uponSignal("timestampedDataSignal").onInterface(INTERFACE_NAME).call([this](const uint64_t& sentAt, const std::string& data){ this->onTimestampedDataSignal(sentAt, data); });
     }
 
     virtual void onDataSignal(const std::string& data) = 0;
+    virtual void onTimestampedDataSignal(const uint64_t& sentAt, const std::string& data) = 0;
 
 public:
     void sendDataSignals(const uint32_t& numberOfSignals, const uint32_t& signalMsgSize)
@@ -51,6 +53,25 @@ public:
         return result;
     }
 
+    std::vector<uint8_t> echoBytes(const std::vector<uint8_t>& data)
+    {
+        std::vector<uint8_t> result;
+        m_proxy.callMethod("echoBytes").onInterface(INTERFACE_NAME).withArguments(data).storeResultsTo(result);
+        return result;
+    }
+
+    std::vector<sdbus::Struct<uint32_t, double, std::string>> echoRecords(const std::vector<sdbus::Struct<uint32_t, double, std::string>>& records)
+    {
+        std::vector<sdbus::Struct<uint32_t, double, std::string>> result;
+        m_proxy.callMethod("echoRecords").onInterface(INTERFACE_NAME).withArguments(records).storeResultsTo(result);
+        return result;
+    }
+
+    void sendTimestampedDataSignals(const uint32_t& numberOfSignals, const uint32_t& signalMsgSize)
+    {
+        m_proxy.callMethod("sendTimestampedDataSignals").onInterface(INTERFACE_NAME).withArguments(numberOfSignals, signalMsgSize);
+    }
+
 private:
     sdbus::IProxy& m_proxy;
 };
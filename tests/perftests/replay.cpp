@@ -0,0 +1,403 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file replay.cpp
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Replays method calls from a traffic capture, recorded by IConnection::captureTraffic(), against a service on
+// the bus or a peer on a direct D-Bus address, at the original or a scaled rate. Reports call latencies overall
+// and per member, as text or JSON, so handler and serialization costs of a recorded load can be studied offline.
+
+#include <sdbus-c++/sdbus-c++.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+enum class Format { Text, Json };
+
+struct Options
+{
+    std::string file;
+    std::string destination;    // Service to replay the calls against, instead of their recorded destination
+    std::string address;        // Direct D-Bus address of the peer to replay the calls against
+    std::string interfaceName;  // Replay only calls of this interface, if given
+    double speed{1.0};          // Rate scale of the replay, 0 replays the calls as fast as possible
+    Format format{Format::Text};
+    std::string label;
+};
+
+struct Latencies
+{
+    std::vector<uint64_t> samples; // Nanoseconds
+    uint64_t errors{};
+
+    uint64_t percentile(double percent)
+    {
+        if (samples.empty())
+            return 0;
+        auto index = static_cast<size_t>(percent / 100.0 * static_cast<double>(samples.size() - 1));
+        std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+        return samples[index];
+    }
+
+    double mean() const
+    {
+        if (samples.empty())
+            return 0.0;
+        uint64_t sum{};
+        for (auto sample : samples)
+            sum += sample;
+        return static_cast<double>(sum) / static_cast<double>(samples.size());
+    }
+};
+
+struct Results
+{
+    Latencies overall;
+    std::map<std::string, Latencies> members; // Keyed by interface.member
+    uint64_t replayed{};
+    uint64_t skipped{};             // Recorded messages other than (matching) method calls
+    uint64_t unanswered{};          // Calls without a reply until the end of the replay
+    std::chrono::nanoseconds maxLag{}; // Maximum delay of issuing a call behind its schedule
+    std::chrono::nanoseconds duration{};
+};
+
+class Replayer
+{
+public:
+    explicit Replayer(const Options& options)
+        : options_(options)
+        , connection_(options.address.empty() ? sdbus::createBusConnection() : sdbus::createDirectBusConnection(options.address))
+    {
+        connection_->enterEventLoopAsync();
+    }
+
+    ~Replayer()
+    {
+        proxies_.clear();
+        connection_->leaveEventLoop();
+    }
+
+    Results run()
+    {
+        sdbus::TrafficCaptureReader reader{options_.file};
+        std::optional<std::chrono::nanoseconds> firstTimestamp;
+        auto start = std::chrono::steady_clock::now();
+
+        while (auto captured = reader.next())
+        {
+            if (captured->type != sdbus::CapturedMessage::Type::MethodCall
+                || (!options_.interfaceName.empty() && captured->interfaceName != options_.interfaceName))
+            {
+                ++results_.skipped;
+                continue;
+            }
+
+            if (!firstTimestamp)
+                firstTimestamp = captured->timestamp;
+            if (options_.speed > 0)
+            {
+                auto offset = std::chrono::duration_cast<std::chrono::nanoseconds>((captured->timestamp - *firstTimestamp) / options_.speed);
+                auto scheduled = start + offset;
+                std::this_thread::sleep_until(scheduled);
+                results_.maxLag = std::max(results_.maxLag, std::chrono::steady_clock::now() - scheduled);
+            }
+
+            issueCall(*captured);
+        }
+
+        waitForReplies(std::chrono::steady_clock::now() + 10s);
+        results_.duration = std::chrono::steady_clock::now() - start;
+        proxies_.clear(); // Drops calls still pending, so that no reply arrives past this point
+
+        std::lock_guard lock(mutex_);
+        results_.unanswered = pending_;
+        return std::move(results_);
+    }
+
+private:
+    void issueCall(const sdbus::CapturedMessage& captured)
+    {
+        auto member = captured.interfaceName + "." + captured.memberName;
+        try
+        {
+            auto& proxy = getProxy(captured);
+            auto call = proxy.createMethodCall(sdbus::InterfaceName{captured.interfaceName}, sdbus::MethodName{captured.memberName});
+            sdbus::appendCapturedArguments(call, captured);
+
+            {
+                std::lock_guard lock(mutex_);
+                ++pending_;
+                ++results_.replayed;
+            }
+            auto sentAt = std::chrono::steady_clock::now();
+            proxy.callMethodAsync(call, [this, member, sentAt](sdbus::MethodReply /*reply*/, std::optional<sdbus::Error> error)
+            {
+                onReply(member, std::chrono::steady_clock::now() - sentAt, error.has_value());
+            });
+        }
+        catch (const sdbus::Error&)
+        {
+            std::lock_guard lock(mutex_);
+            ++results_.overall.errors;
+            ++results_.members[member].errors;
+        }
+    }
+
+    void onReply(const std::string& member, std::chrono::nanoseconds latency, bool failed)
+    {
+        std::lock_guard lock(mutex_);
+        auto& latencies = results_.members[member];
+        if (failed)
+        {
+            ++results_.overall.errors;
+            ++latencies.errors;
+        }
+        else
+        {
+            results_.overall.samples.push_back(static_cast<uint64_t>(latency.count()));
+            latencies.samples.push_back(static_cast<uint64_t>(latency.count()));
+        }
+        --pending_;
+    }
+
+    void waitForReplies(std::chrono::steady_clock::time_point deadline)
+    {
+        while (std::chrono::steady_clock::now() < deadline)
+        {
+            {
+                std::lock_guard lock(mutex_);
+                if (pending_ == 0)
+                    return;
+            }
+            std::this_thread::sleep_for(1ms);
+        }
+    }
+
+    sdbus::IProxy& getProxy(const sdbus::CapturedMessage& captured)
+    {
+        // Direct connections have no bus to route messages by destination
+        auto destination = !options_.address.empty() ? std::string{}
+                         : !options_.destination.empty() ? options_.destination
+                         : captured.destination;
+
+        auto& proxy = proxies_[{destination, captured.path}];
+        if (!proxy)
+            proxy = sdbus::createProxy(*connection_, sdbus::ServiceName{destination}, sdbus::ObjectPath{captured.path});
+        return *proxy;
+    }
+
+    const Options& options_;
+    std::unique_ptr<sdbus::IConnection> connection_;
+    std::map<std::pair<std::string, std::string>, std::unique_ptr<sdbus::IProxy>> proxies_; // Keyed by destination and path
+    std::mutex mutex_; // Guards the results, which are recorded to from the event loop thread as well
+    Results results_;
+    uint64_t pending_{};
+};
+
+double toMicroseconds(uint64_t nanoseconds)
+{
+    return static_cast<double>(nanoseconds) / 1000.0;
+}
+
+void printText(const Options& options, Results& results)
+{
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Capture: " << options.file << ", speed: ";
+    if (options.speed > 0)
+        std::cout << options.speed << "x" << std::endl;
+    else
+        std::cout << "max" << std::endl;
+    std::cout << "Replayed calls: " << results.replayed << ", errors: " << results.overall.errors << ", unanswered: " << results.unanswered
+              << ", skipped messages: " << results.skipped
+              << ", duration: " << std::chrono::duration_cast<std::chrono::milliseconds>(results.duration).count() << " ms"
+              << ", max lag: " << toMicroseconds(static_cast<uint64_t>(results.maxLag.count())) << " us" << std::endl;
+
+    auto printLatencies = [](const std::string& name, Latencies& latencies)
+    {
+        std::cout << std::left << std::setw(48) << name << std::right << std::setw(10) << latencies.samples.size()
+                  << std::setw(8) << latencies.errors << std::setw(12) << latencies.mean() / 1000.0
+                  << std::setw(12) << toMicroseconds(latencies.percentile(50)) << std::setw(12) << toMicroseconds(latencies.percentile(99))
+                  << std::setw(12) << toMicroseconds(latencies.percentile(100)) << std::endl;
+    };
+
+    std::cout << std::left << std::setw(48) << "Latency [us]" << std::right << std::setw(10) << "calls" << std::setw(8) << "errors"
+              << std::setw(12) << "mean" << std::setw(12) << "p50" << std::setw(12) << "p99" << std::setw(12) << "max" << std::endl;
+    for (auto& [member, latencies] : results.members)
+        printLatencies(member, latencies);
+    printLatencies("(all)", results.overall);
+}
+
+std::string escapeJson(const std::string& str)
+{
+    std::string result;
+    for (char c : str)
+    {
+        if (c == '"' || c == '\\')
+            result += {'\\', c};
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            char buffer[8];
+            std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+            result += buffer;
+        }
+        else
+            result += c;
+    }
+    return result;
+}
+
+void printJson(const Options& options, Results& results)
+{
+    auto printLatencies = [](Latencies& latencies)
+    {
+        std::cout << "{\"calls\": " << latencies.samples.size() << ", \"errors\": " << latencies.errors
+                  << ", \"mean\": " << latencies.mean() / 1000.0 << ", \"p50\": " << toMicroseconds(latencies.percentile(50))
+                  << ", \"p99\": " << toMicroseconds(latencies.percentile(99)) << ", \"max\": " << toMicroseconds(latencies.percentile(100)) << "}";
+    };
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "{\n"
+              << "  \"label\": \"" << escapeJson(options.label) << "\",\n"
+              << "  \"config\": {\"file\": \"" << escapeJson(options.file) << "\", \"speed\": " << options.speed << "},\n"
+              << "  \"replayed\": " << results.replayed << ",\n"
+              << "  \"unanswered\": " << results.unanswered << ",\n"
+              << "  \"skipped\": " << results.skipped << ",\n"
+              << "  \"duration_ms\": " << std::chrono::duration<double, std::milli>(results.duration).count() << ",\n"
+              << "  \"max_lag_us\": " << toMicroseconds(static_cast<uint64_t>(results.maxLag.count())) << ",\n"
+              << "  \"latency_us\": ";
+    printLatencies(results.overall);
+    std::cout << ",\n  \"members_latency_us\": {";
+    const char* separator = "";
+    for (auto& [member, latencies] : results.members)
+    {
+        std::cout << separator << "\n    \"" << escapeJson(member) << "\": ";
+        printLatencies(latencies);
+        separator = ",";
+    }
+    std::cout << "\n  }\n}" << std::endl;
+}
+
+void printUsage(const char* program)
+{
+    std::cerr << "Usage: " << program << " --file=PATH [OPTION]...\n"
+              << "Replays method calls from a traffic capture and reports their latencies.\n\n"
+              << "  --file=PATH                    Traffic capture recorded by IConnection::captureTraffic()\n"
+              << "  --destination=NAME             Service to replay the calls against (default: recorded destination)\n"
+              << "  --address=ADDRESS              Replay against a peer on this direct D-Bus address instead of the bus\n"
+              << "  --interface=NAME               Replay only calls of this interface\n"
+              << "  --speed=X                      Rate scale, e.g. 2 replays twice as fast; 0 replays as fast as possible (default: 1)\n"
+              << "  --format=text|json             Output format (default: text)\n"
+              << "  --label=TEXT                   Label of the run, e.g. the library version under test\n";
+}
+
+std::optional<Options> parseOptions(int argc, char* argv[])
+{
+    Options options;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        auto eq = arg.find('=');
+        if (arg.rfind("--", 0) != 0 || eq == std::string::npos)
+            return std::nullopt;
+        auto name = arg.substr(2, eq - 2);
+        auto value = arg.substr(eq + 1);
+
+        if (name == "file") options.file = value;
+        else if (name == "destination") options.destination = value;
+        else if (name == "address") options.address = value;
+        else if (name == "interface") options.interfaceName = value;
+        else if (name == "format" && value == "text") options.format = Format::Text;
+        else if (name == "format" && value == "json") options.format = Format::Json;
+        else if (name == "label") options.label = value;
+        else if (name == "speed")
+        {
+            try
+            {
+                size_t pos{};
+                options.speed = std::stod(value, &pos);
+                if (pos != value.size() || options.speed < 0)
+                    return std::nullopt;
+            }
+            catch (const std::exception&)
+            {
+                return std::nullopt;
+            }
+        }
+        else
+            return std::nullopt;
+    }
+
+    if (options.file.empty())
+        return std::nullopt;
+
+    return options;
+}
+
+}
+
+//-----------------------------------------
+int main(int argc, char* argv[])
+{
+    auto options = parseOptions(argc, argv);
+    if (!options)
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    Results results;
+    try
+    {
+        Replayer replayer{*options};
+        results = replayer.run();
+    }
+    catch (const sdbus::Error& e)
+    {
+        std::cerr << "Replay failed: " << e.getName() << ": " << e.getMessage() << std::endl;
+        return 1;
+    }
+
+    switch (options->format)
+    {
+        case Format::Text: printText(*options, results); break;
+        case Format::Json: printJson(*options, results); break;
+    }
+
+    return results.overall.errors == 0 && results.unanswered == 0 ? 0 : 2;
+}
@@ -70,6 +70,28 @@ protected:
     {
         return string1 + string2;
     }
+
+    virtual std::vector<uint8_t> echoBytes(const std::vector<uint8_t>& data) override
+    {
+        return data;
+    }
+
+    virtual std::vector<sdbus::Struct<uint32_t, double, std::string>> echoRecords(const std::vector<sdbus::Struct<uint32_t, double, std::string>>& records) override
+    {
+        return records;
+    }
+
+    virtual void sendTimestampedDataSignals(const uint32_t& numberOfSignals, const uint32_t& signalMsgSize) override
+    {
+        auto data = createRandomString(signalMsgSize);
+
+        for (uint32_t i = 0; i < numberOfSignals; ++i)
+        {
+            // Steady clock is system-wide on Linux, so the receiver on the same host can compute the latency
+            auto sentAt = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+            emitTimestampedDataSignal(static_cast<uint64_t>(sentAt), data);
+        }
+    }
 };
 
 std::string createRandomString(size_t length)
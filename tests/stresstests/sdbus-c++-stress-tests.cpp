@@ -44,6 +44,10 @@
 #include <mutex>
 #include <condition_variable>
 #include <queue>
+#include <random>
+#include <string_view>
+#include <sys/resource.h>
+#include <fstream>
 
 using namespace std::chrono_literals;
 
@@ -344,12 +348,382 @@ public:
     std::atomic<uint32_t> signalsReceived_{};
 };
 
+//-----------------------------------------
+// Scale-out stress mode: many connections, objects and signal subscriptions, with churn of objects,
+// proxies and floating match rules, and tracking of resident memory and CPU time over time
+//-----------------------------------------
+
+const std::string SCALE_SERVICE_BUS_NAME_PREFIX{"org.sdbuscpp.stresstests.scale.service"};
+const std::string SCALE_OBJECT_PATH_PREFIX{"/org/sdbuscpp/stresstests/scale/concatenator"};
+
+struct ScaleOptions
+{
+    unsigned connections{4};                        // Service connections, and as many client connections
+    unsigned objectsPerConnection{100};
+    unsigned subscriptions{400};                    // Signal-subscribed proxies, spread over client connections
+    std::chrono::milliseconds churnPeriod{10};      // Zero turns churn off
+    std::chrono::milliseconds duration{60000};
+    std::chrono::milliseconds reportPeriod{1000};
+    long maxRssGrowthKb{};                          // Zero turns the leak check off
+};
+
+struct ScaleStats
+{
+    std::atomic<uint64_t> callsMade{};
+    std::atomic<uint64_t> repliesReceived{};
+    std::atomic<uint64_t> errorsReceived{};
+    std::atomic<uint64_t> signalsReceived{};
+    std::atomic<uint64_t> objectsChurned{};
+    std::atomic<uint64_t> proxiesChurned{};
+    std::atomic<uint64_t> matchRulesChurned{};
+};
+
+class ScaleConcatenatorAdaptor final : public sdbus::AdaptorInterfaces<org::sdbuscpp::stresstests::concatenator_adaptor>
+{
+public:
+    ScaleConcatenatorAdaptor(sdbus::IConnection& connection, sdbus::ObjectPath objectPath)
+        : AdaptorInterfaces(connection, std::move(objectPath))
+    {
+        registerAdaptor();
+    }
+
+    ~ScaleConcatenatorAdaptor()
+    {
+        unregisterAdaptor();
+    }
+
+protected:
+    virtual void concatenate(sdbus::Result<std::string>&& result, std::map<std::string, sdbus::Variant> params) override
+    {
+        auto resultString = params.at("key1").get<std::string>() + " " + std::to_string(params.at("key2").get<uint32_t>());
+
+        result.returnResults(resultString);
+
+        emitConcatenatedSignal(resultString);
+    }
+};
+
+class ScaleConcatenatorProxy final : public sdbus::ProxyInterfaces<org::sdbuscpp::stresstests::concatenator_proxy>
+{
+public:
+    ScaleConcatenatorProxy(sdbus::IConnection& connection, sdbus::ServiceName destination, sdbus::ObjectPath objectPath, ScaleStats& stats)
+        : ProxyInterfaces(connection, std::move(destination), std::move(objectPath))
+        , stats_(stats)
+    {
+        registerProxy();
+    }
+
+    ~ScaleConcatenatorProxy()
+    {
+        unregisterProxy();
+    }
+
+    // Pending async calls are dropped, together with their floating slots, when the proxy is destroyed
+    static constexpr uint32_t MAX_CALLS_IN_FLIGHT{4};
+
+    bool tryCall(uint32_t number)
+    {
+        if (callsInFlight_ >= MAX_CALLS_IN_FLIGHT)
+            return false;
+
+        std::map<std::string, sdbus::Variant> param;
+        param["key1"] = sdbus::Variant{"sdbus-c++-stress-tests"};
+        param["key2"] = sdbus::Variant{number};
+
+        ++callsInFlight_;
+        try
+        {
+            concatenate(param);
+            ++stats_.callsMade;
+        }
+        catch (const sdbus::Error&)
+        {
+            --callsInFlight_;
+            ++stats_.errorsReceived;
+        }
+        return true;
+    }
+
+private:
+    virtual void onConcatenateReply(const std::string& /*result*/, std::optional<sdbus::Error> error) override
+    {
+        // Calls to objects that are being churned at the moment legitimately fail
+        if (error)
+            ++stats_.errorsReceived;
+        else
+            ++stats_.repliesReceived;
+        --callsInFlight_;
+    }
+
+    virtual void onConcatenatedSignal(const std::string& /*concatenatedString*/) override
+    {
+        ++stats_.signalsReceived;
+    }
+
+    ScaleStats& stats_;
+    std::atomic<uint32_t> callsInFlight_{};
+};
+
+class ScaleService
+{
+public:
+    ScaleService(unsigned index, unsigned objectCount)
+        : connection_(sdbus::createSystemBusConnection(serviceName(index)))
+    {
+        for (unsigned i = 0; i < objectCount; ++i)
+            objects_.push_back(std::make_unique<ScaleConcatenatorAdaptor>(*connection_, objectPath(i)));
+        connection_->enterEventLoopAsync();
+    }
+
+    ~ScaleService()
+    {
+        connection_->leaveEventLoop();
+        objects_.clear();
+    }
+
+    // Unregisters the object from the bus and registers a fresh one at the same path
+    void recreateObject(unsigned index)
+    {
+        std::lock_guard lock(objectsMutex_);
+        objects_[index].reset();
+        objects_[index] = std::make_unique<ScaleConcatenatorAdaptor>(*connection_, objectPath(index));
+    }
+
+    static sdbus::ServiceName serviceName(unsigned index)
+    {
+        return sdbus::ServiceName{SCALE_SERVICE_BUS_NAME_PREFIX + std::to_string(index + 1)};
+    }
+
+    static sdbus::ObjectPath objectPath(unsigned index)
+    {
+        return sdbus::ObjectPath{SCALE_OBJECT_PATH_PREFIX + std::to_string(index + 1)};
+    }
+
+private:
+    std::unique_ptr<sdbus::IConnection> connection_;
+    std::mutex objectsMutex_;
+    std::vector<std::unique_ptr<ScaleConcatenatorAdaptor>> objects_;
+};
+
+struct ProcessUsage
+{
+    long rssKb;
+    std::chrono::microseconds cpuTime;
+};
+
+ProcessUsage getProcessUsage()
+{
+    long totalPages{}, residentPages{};
+    std::ifstream statm("/proc/self/statm");
+    statm >> totalPages >> residentPages;
+
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    auto toMicroseconds = [](const timeval& tv){ return std::chrono::seconds{tv.tv_sec} + std::chrono::microseconds{tv.tv_usec}; };
+
+    return {residentPages * (sysconf(_SC_PAGESIZE) / 1024), toMicroseconds(usage.ru_utime) + toMicroseconds(usage.ru_stime)};
+}
+
+ScaleOptions parseScaleOptions(int argc, char *argv[])
+{
+    ScaleOptions options;
+
+    for (int i = 0; i < argc; ++i)
+    {
+        std::string_view arg{argv[i]};
+        auto eq = arg.find('=');
+        if (arg.substr(0, 2) != "--" || eq == std::string_view::npos)
+            throw std::runtime_error("Wrong program options");
+        auto name = arg.substr(2, eq - 2);
+        auto value = std::atol(std::string{arg.substr(eq + 1)}.c_str());
+        if (value < 0)
+            throw std::runtime_error("Wrong program options");
+
+        if (name == "connections") options.connections = static_cast<unsigned>(value);
+        else if (name == "objects") options.objectsPerConnection = static_cast<unsigned>(value);
+        else if (name == "subscriptions") options.subscriptions = static_cast<unsigned>(value);
+        else if (name == "churn-period") options.churnPeriod = std::chrono::milliseconds{value};
+        else if (name == "duration") options.duration = std::chrono::milliseconds{value};
+        else if (name == "report-period") options.reportPeriod = std::chrono::milliseconds{value};
+        else if (name == "max-rss-growth") options.maxRssGrowthKb = value;
+        else
+            throw std::runtime_error("Wrong program options");
+    }
+
+    if (options.connections == 0 || options.objectsPerConnection == 0 || options.reportPeriod.count() == 0)
+        throw std::runtime_error("Wrong program options");
+
+    return options;
+}
+
+int runScaleStressTest(const ScaleOptions& options)
+{
+    std::cout << "Going on in scale mode with " << options.connections << " service and client connections, "
+              << options.objectsPerConnection << " objects per service connection, " << options.subscriptions << " signal subscriptions, "
+              << options.churnPeriod.count() << "ms churn period and " << options.duration.count() << "ms duration" << std::endl;
+
+    ScaleStats stats;
+
+    std::vector<std::unique_ptr<ScaleService>> services;
+    for (unsigned i = 0; i < options.connections; ++i)
+        services.push_back(std::make_unique<ScaleService>(i, options.objectsPerConnection));
+
+    std::vector<std::unique_ptr<sdbus::IConnection>> clientConnections;
+    for (unsigned i = 0; i < options.connections; ++i)
+    {
+        clientConnections.push_back(sdbus::createSystemBusConnection());
+        clientConnections.back()->enterEventLoopAsync();
+    }
+
+    // Subscription k lives on client connection k % N, and targets an object spread over all services
+    auto createProxy = [&](unsigned k)
+    {
+        auto service = (k / options.connections) % options.connections;
+        auto object = (k / options.connections / options.connections) % options.objectsPerConnection;
+        return std::make_unique<ScaleConcatenatorProxy>( *clientConnections[k % options.connections]
+                                                       , ScaleService::serviceName(service)
+                                                       , ScaleService::objectPath(object)
+                                                       , stats );
+    };
+
+    std::atomic<bool> stop{};
+
+    // One caller thread per client connection issues async calls over its own proxies, and churns them
+    std::vector<std::thread> callerThreads;
+    for (unsigned c = 0; c < options.connections; ++c)
+    {
+        callerThreads.emplace_back([&, c]()
+        {
+            std::vector<std::pair<unsigned, std::unique_ptr<ScaleConcatenatorProxy>>> proxies;
+            for (unsigned k = c; k < options.subscriptions; k += options.connections)
+                proxies.emplace_back(k, createProxy(k));
+
+            std::mt19937 random{c};
+            uint32_t counter{};
+            auto nextChurn = std::chrono::steady_clock::now() + options.churnPeriod;
+
+            while (!stop)
+            {
+                bool called{};
+                for (auto& [k, proxy] : proxies)
+                    called |= proxy->tryCall(++counter);
+
+                if (options.churnPeriod.count() > 0 && !proxies.empty() && std::chrono::steady_clock::now() >= nextChurn)
+                {
+                    // Here we are testing proxy destruction with async calls in flight, and creation of new signal subscriptions
+                    auto& [k, proxy] = proxies[random() % proxies.size()];
+                    proxy.reset();
+                    proxy = createProxy(k);
+                    ++stats.proxiesChurned;
+                    nextChurn += options.churnPeriod;
+                }
+
+                if (!called)
+                    std::this_thread::sleep_for(1ms);
+            }
+        });
+    }
+
+    std::thread churnThread;
+    if (options.churnPeriod.count() > 0)
+    {
+        churnThread = std::thread([&]()
+        {
+            std::mt19937 random{42};
+            for (uint64_t tick = 1; !stop; ++tick)
+            {
+                std::this_thread::sleep_for(options.churnPeriod);
+
+                // Here we are testing dynamic removal and re-creation of D-Bus objects while they are being called
+                services[random() % services.size()]->recreateObject(random() % options.objectsPerConnection);
+                ++stats.objectsChurned;
+
+                // Here we are testing that floating match rules are released together with their connection
+                if (tick % 10 == 0)
+                {
+                    auto connection = sdbus::createSystemBusConnection();
+                    for (int i = 0; i < 8; ++i)
+                        connection->addMatch( "type='signal',interface='org.sdbuscpp.stresstests.concatenator',member='concatenatedSignal'"
+                                            , [](sdbus::Message /*msg*/){} );
+                    stats.matchRulesChurned += 8;
+                }
+            }
+        });
+    }
+
+    // Report resident memory, CPU usage and throughput periodically
+    const auto start = std::chrono::steady_clock::now();
+    auto lastTime = start;
+    auto lastUsage = getProcessUsage();
+    auto lastReplies = stats.repliesReceived.load();
+    auto lastSignals = stats.signalsReceived.load();
+    std::optional<long> baselineRssKb;
+    long peakRssKb{};
+
+    while (std::chrono::steady_clock::now() - start < options.duration)
+    {
+        std::this_thread::sleep_for(options.reportPeriod);
+
+        auto now = std::chrono::steady_clock::now();
+        auto usage = getProcessUsage();
+        auto replies = stats.repliesReceived.load();
+        auto signals = stats.signalsReceived.load();
+        auto period = std::chrono::duration<double>(now - lastTime).count();
+
+        // The first period is the warm-up, during which all objects, proxies and match rules come to existence
+        if (!baselineRssKb)
+            baselineRssKb = usage.rssKb;
+        peakRssKb = std::max(peakRssKb, usage.rssKb);
+
+        std::cout << "[" << std::chrono::duration_cast<std::chrono::seconds>(now - start).count() << " s] "
+                  << "RSS " << usage.rssKb << " kB, "
+                  << "CPU " << static_cast<long>(std::chrono::duration<double>(usage.cpuTime - lastUsage.cpuTime).count() / period * 100) << " %, "
+                  << static_cast<long>((replies - lastReplies) / period) << " replies/s, "
+                  << static_cast<long>((signals - lastSignals) / period) << " signals/s, "
+                  << stats.errorsReceived << " errors, "
+                  << stats.objectsChurned << " objects, " << stats.proxiesChurned << " proxies and "
+                  << stats.matchRulesChurned << " match rules churned so far" << std::endl;
+
+        lastTime = now;
+        lastUsage = usage;
+        lastReplies = replies;
+        lastSignals = signals;
+    }
+
+    stop = true;
+    if (churnThread.joinable())
+        churnThread.join();
+    for (auto& thread : callerThreads)
+        thread.join();
+
+    auto finalRssKb = getProcessUsage().rssKb;
+    auto rssGrowthKb = baselineRssKb ? finalRssKb - *baselineRssKb : 0;
+
+    std::cout << "Made " << stats.callsMade << " calls, received " << stats.repliesReceived << " replies, "
+              << stats.errorsReceived << " errors and " << stats.signalsReceived << " signals." << std::endl;
+    std::cout << "RSS grew by " << rssGrowthKb << " kB after warm-up, peaking at " << peakRssKb << " kB." << std::endl;
+
+    clientConnections.clear();
+    services.clear();
+
+    if (options.maxRssGrowthKb > 0 && rssGrowthKb > options.maxRssGrowthKb)
+    {
+        std::cout << "RSS growth exceeds the limit of " << options.maxRssGrowthKb << " kB, possible leak!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
 //-----------------------------------------
 int main(int argc, char *argv[])
 {
     long loops;
     long loopDuration;
 
+    if (argc >= 2 && std::string_view{argv[1]} == "--scale")
+        return runScaleStressTest(parseScaleOptions(argc - 2, argv + 2));
+
     if (argc == 1)
     {
         loops = 1;
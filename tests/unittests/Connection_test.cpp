@@ -26,17 +26,35 @@
  */
 
 #include "Connection.h"
+#include "sdbus-c++/IObject.h"
 #include "sdbus-c++/Types.h"
 #include "unittests/mocks/SdBusMock.h"
 
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <memory_resource>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <thread>
 
 using ::testing::_;
 using ::testing::DoAll;
+using ::testing::Each;
+using ::testing::ElementsAre;
+using ::testing::Eq;
+using ::testing::Gt;
+using ::testing::Invoke;
+using ::testing::IsNull;
+using ::testing::NotNull;
+using ::testing::SaveArg;
 using ::testing::SetArgPointee;
+using ::testing::SizeIs;
 using ::testing::Return;
 using ::testing::NiceMock;
 using ::sdbus::internal::Connection;
+using ::sdbus::internal::ISdBus;
 
 class ConnectionCreationTest : public ::testing::Test
 {
@@ -221,3 +239,623 @@ TYPED_TEST(AConnectionNameRequest, ThrowsOnFail)
 
     ASSERT_THROW(this->con_->requestName(name), sdbus::Error);
 }
+
+using AConnectionProcessingEvents = ConnectionCreationTest;
+
+TEST_F(AConnectionProcessingEvents, ProcessesEventsUntilNoneArePending)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_process(fakeBusPtr_, _)).WillOnce(Return(1)).WillOnce(Return(1)).WillOnce(Return(0));
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+
+    ASSERT_THAT(con.processPendingEvents(10, std::chrono::microseconds::max()), Eq(2u));
+}
+
+TEST_F(AConnectionProcessingEvents, StopsProcessingEventsWhenMaxCountIsReached)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_process(fakeBusPtr_, _)).Times(3).WillRepeatedly(Return(1));
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+
+    ASSERT_THAT(con.processPendingEvents(3, std::chrono::microseconds::max()), Eq(3u));
+}
+
+TEST_F(AConnectionProcessingEvents, StopsProcessingEventsWhenMaxDurationElapses)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_process(fakeBusPtr_, _)).Times(1).WillRepeatedly(Return(1));
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+
+    ASSERT_THAT(con.processPendingEvents(100, std::chrono::microseconds::zero()), Eq(1u));
+}
+
+TEST_F(AConnectionProcessingEvents, ThrowsErrorWhenProcessingFails)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    ON_CALL(*sdBusIntfMock_, sd_bus_process(fakeBusPtr_, _)).WillByDefault(Return(-EIO));
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+
+    ASSERT_THROW(con.processPendingEvents(10, std::chrono::microseconds::max()), sdbus::Error);
+}
+
+TEST_F(AConnectionProcessingEvents, KeepsOnProcessingBeforeBlockingWhenBusyPollingIsEnabled)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    ON_CALL(*sdBusIntfMock_, sd_bus_get_poll_data(_, _)).WillByDefault(DoAll(SetArgPointee<1>(ISdBus::PollData{-1, 0, UINT64_MAX}), Return(0)));
+    std::atomic<std::size_t> processCount{};
+    ON_CALL(*sdBusIntfMock_, sd_bus_process(fakeBusPtr_, _)).WillByDefault(Invoke([&](sd_bus*, sd_bus_message**){ ++processCount; return 0; }));
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+    con.setEventLoopBusyPollDuration(std::chrono::seconds(10));
+
+    con.enterEventLoopAsync();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    con.leaveEventLoop();
+
+    // Without busy polling, the loop would process just once and then block in poll()
+    ASSERT_THAT(processCount.load(), Gt(10u));
+}
+
+TEST_F(AConnectionProcessingEvents, ThrowsErrorWhenBusyPollDurationIsNegative)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+
+    ASSERT_THROW(con.setEventLoopBusyPollDuration(std::chrono::microseconds(-1)), sdbus::Error);
+}
+
+using AConnectionSendingMessages = ConnectionCreationTest;
+
+TEST_F(AConnectionSendingMessages, SendsAllMessagesOfABatchInOneCall)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_send_many(_, _, 3)).Times(1).WillOnce(Return(0));
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_send(_, _, _)).Times(0);
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+
+    sd_bus_message* msgs[3]{};
+    con.sendMessages(msgs, 3);
+}
+
+TEST_F(AConnectionSendingMessages, ThrowsErrorWhenSendingABatchFails)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    ON_CALL(*sdBusIntfMock_, sd_bus_send_many(_, _, _)).WillByDefault(Return(-ENOBUFS));
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+
+    sd_bus_message* msgs[2]{};
+    ASSERT_THROW(con.sendMessages(msgs, 2), sdbus::Error);
+}
+
+TEST_F(AConnectionSendingMessages, WakesUpExternalEventLoopWhenMessageIsLeftInWriteQueue)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    ON_CALL(*sdBusIntfMock_, sd_bus_get_n_queued(_, _, _)).WillByDefault(DoAll(SetArgPointee<2>(1), Return(0)));
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+
+    sd_bus_message* msg{};
+    con.sendMessage(msg);
+
+    // The connection doesn't know the state of an external event loop, so it has to signal the event fd
+    struct pollfd fd{con.getEventLoopPollData().eventFd, POLLIN, 0};
+    ASSERT_THAT(poll(&fd, 1, 0), Eq(1));
+}
+
+TEST_F(AConnectionSendingMessages, DoesNotWakeUpInternalEventLoopThatIsProcessing)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    ON_CALL(*sdBusIntfMock_, sd_bus_get_poll_data(_, _)).WillByDefault(DoAll(SetArgPointee<1>(ISdBus::PollData{-1, 0, UINT64_MAX}), Return(0)));
+    ON_CALL(*sdBusIntfMock_, sd_bus_get_n_queued(_, _, _)).WillByDefault(DoAll(SetArgPointee<2>(1), Return(0)));
+    Connection* connection{};
+    std::atomic<int> pollResultWhileProcessing{-1};
+    ON_CALL(*sdBusIntfMock_, sd_bus_process(fakeBusPtr_, _)).WillByDefault(Invoke([&](sd_bus*, sd_bus_message**)
+    {
+        if (pollResultWhileProcessing >= 0)
+            return 0;
+        // A message sent from a handler, i.e. while the loop is processing, is picked up before the loop polls again
+        struct pollfd fd{connection->getEventLoopPollData().eventFd, POLLIN, 0};
+        eventfd_t value{};
+        (void)eventfd_read(fd.fd, &value);
+        sd_bus_message* msg{};
+        connection->sendMessage(msg);
+        pollResultWhileProcessing = poll(&fd, 1, 0);
+        return 0;
+    }));
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+    connection = &con;
+
+    con.enterEventLoopAsync();
+    while (pollResultWhileProcessing < 0)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    con.leaveEventLoop();
+
+    ASSERT_THAT(pollResultWhileProcessing.load(), Eq(0));
+}
+
+using AConnectionRegisteringObjects = ConnectionCreationTest;
+
+TEST_F(AConnectionRegisteringObjects, RegistersVTablesAndEmitsInterfacesAddedSignalsOfAllObjectsInOneCall)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_add_objects(_, _, _, 3, _, _, 2)).Times(1).WillOnce(Return(0));
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_add_object_vtable(_, _, _, _, _, _)).Times(0);
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_emit_interfaces_added_strv(_, _, _)).Times(0);
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+    auto object1 = sdbus::createObject(con, sdbus::ObjectPath{"/org/sdbuscpp/object1"});
+    auto object2 = sdbus::createObject(con, sdbus::ObjectPath{"/org/sdbuscpp/object2"});
+
+    con.registerObjects({ {*object1, sdbus::InterfaceName{"org.sdbuscpp.A"}, {sdbus::registerSignal("a")}}
+                        , {*object1, sdbus::InterfaceName{"org.sdbuscpp.B"}, {sdbus::registerSignal("b")}}
+                        , {*object2, sdbus::InterfaceName{"org.sdbuscpp.A"}, {sdbus::registerSignal("a")}} });
+}
+
+TEST_F(AConnectionRegisteringObjects, PreparesVTablesInParallelAndProfilesTheirPreparationPerObject)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_add_objects(_, _, _, 3, _, _, 2)).Times(1).WillOnce(Return(0));
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+    con.enableStartupProfiling();
+    auto object1 = sdbus::createObject(con, sdbus::ObjectPath{"/org/sdbuscpp/object1"});
+    auto object2 = sdbus::createObject(con, sdbus::ObjectPath{"/org/sdbuscpp/object2"});
+
+    con.registerObjects({ {*object1, sdbus::InterfaceName{"org.sdbuscpp.A"}, {sdbus::registerSignal("a")}}
+                        , {*object1, sdbus::InterfaceName{"org.sdbuscpp.B"}, {sdbus::registerSignal("b")}}
+                        , {*object2, sdbus::InterfaceName{"org.sdbuscpp.A"}, {sdbus::registerSignal("a")}} }, 2);
+
+    auto profile = con.getStartupProfile();
+    EXPECT_THAT(profile.phases[0].count, Eq(3));
+    EXPECT_THAT(profile.phases[1].count, Eq(1));
+    ASSERT_THAT(profile.objects, SizeIs(2));
+    EXPECT_THAT(profile.objects[0].vtables, Eq(2));
+    EXPECT_THAT(profile.objects[1].vtables, Eq(1));
+}
+
+TEST_F(AConnectionRegisteringObjects, ThrowsErrorWhenNoPreparationThreadIsGiven)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_add_objects(_, _, _, _, _, _, _)).Times(0);
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+    auto object = sdbus::createObject(con, sdbus::ObjectPath{"/org/sdbuscpp/object"});
+
+    ASSERT_THROW(con.registerObjects({{*object, sdbus::InterfaceName{"org.sdbuscpp.A"}, {sdbus::registerSignal("a")}}}, 0), sdbus::Error);
+}
+
+TEST_F(AConnectionRegisteringObjects, EmitsInterfacesRemovedSignalsAndUnregistersAllObjectsInOneCall)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_remove_objects(_, _, 2, _, _)).Times(1).WillOnce(Return(0));
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_emit_object_removed(_, _)).Times(0);
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+    auto object1 = sdbus::createObject(con, sdbus::ObjectPath{"/org/sdbuscpp/object1"});
+    auto object2 = sdbus::createObject(con, sdbus::ObjectPath{"/org/sdbuscpp/object2"});
+
+    sdbus::IObject* objects[]{object1.get(), object2.get()};
+    con.unregisterObjects(objects);
+}
+
+TEST_F(AConnectionRegisteringObjects, ThrowsErrorWhenObjectWasCreatedOnAnotherConnection)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_add_objects(_, _, _, _, _, _, _)).Times(0);
+    auto otherSdBusIntfMock = std::make_unique<NiceMock<SdBusMock>>();
+    ON_CALL(*otherSdBusIntfMock, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+    Connection otherCon(std::move(otherSdBusIntfMock), Connection::default_bus);
+    auto object = sdbus::createObject(otherCon, sdbus::ObjectPath{"/org/sdbuscpp/object"});
+
+    ASSERT_THROW(con.registerObjects({{*object, sdbus::InterfaceName{"org.sdbuscpp.A"}, {sdbus::registerSignal("a")}}}), sdbus::Error);
+}
+
+using AConnectionCallingMethodsAsynchronously = ConnectionCreationTest;
+
+TEST_F(AConnectionCallingMethodsAsynchronously, MakesCallAndChecksQueuesInOneSdBusOperation)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_call_async_get_n_queued(_, _, _, _, _, _, NotNull(), _)).WillOnce(Return(1));
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_call_async(_, _, _, _, _, _)).Times(0);
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_message_ref(_)).Times(0);
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_get_n_queued(_, _, _)).Times(0);
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+
+    sd_bus_message* msg{};
+    auto slot = con.callMethodAsync(msg, nullptr, nullptr, 1000000, sdbus::return_slot);
+}
+
+TEST_F(AConnectionCallingMethodsAsynchronously, DoesNotKeepCallMessageWhenCallHasNoTimeout)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_call_async_get_n_queued(_, _, _, _, _, _, IsNull(), _)).WillOnce(Return(1));
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+
+    sd_bus_message* msg{};
+    auto slot = con.callMethodAsync(msg, nullptr, nullptr, UINT64_MAX, sdbus::return_slot);
+}
+
+TEST_F(AConnectionCallingMethodsAsynchronously, FreesCancelledCallsInOneSdBusOperationInEventLoop)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    ON_CALL(*sdBusIntfMock_, sd_bus_call_async_get_n_queued(_, _, _, _, _, _, _, _)).WillByDefault(Return(1));
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_slot_unref(_)).Times(0);
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_unref_many(_, _, 3)).Times(1);
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+
+    sd_bus_message* msg{};
+    for (int i = 0; i < 3; ++i)
+        (void)con.callMethodAsync(msg, nullptr, nullptr, 1000000, sdbus::return_slot);
+
+    (void)con.processPendingEvent();
+}
+
+TEST_F(AConnectionCallingMethodsAsynchronously, DoesNotDispatchReplyToCancelledCall)
+{
+    static bool replyHandlerCalled{};
+    sd_bus_message_handler_t connectionReplyHandler{};
+    void* asyncCall{};
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    ON_CALL(*sdBusIntfMock_, sd_bus_call_async_get_n_queued(_, _, _, _, _, _, _, _)).WillByDefault(DoAll(SaveArg<3>(&connectionReplyHandler), SaveArg<4>(&asyncCall), Return(1)));
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+
+    sd_bus_message* msg{};
+    auto replyHandler = [](sd_bus_message*, void*, sd_bus_error*){ replyHandlerCalled = true; return 0; };
+    auto slot = con.callMethodAsync(msg, replyHandler, nullptr, 1000000, sdbus::return_slot);
+    slot.reset();
+
+    // A reply arriving before the event loop frees the cancelled call
+    sd_bus_message* reply{};
+    connectionReplyHandler(reply, asyncCall, nullptr);
+
+    ASSERT_FALSE(replyHandlerCalled);
+}
+
+TEST_F(AConnectionCallingMethodsAsynchronously, MakesAllCallsOfABatchInOneSdBusOperation)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_call_async_many(_, _, _, _, _, _, 3, NotNull(), _))
+        .WillOnce([](sd_bus*, sd_bus_slot** slots, sd_bus_message**, sd_bus_message_handler_t, void**, uint64_t, std::size_t count, sd_bus_message**, uint64_t*)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                slots[i] = reinterpret_cast<sd_bus_slot*>(i + 1);
+            return 1;
+        });
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_call_async_get_n_queued(_, _, _, _, _, _, _, _)).Times(0);
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+
+    sd_bus_message* msgs[3]{};
+    uint64_t timeouts[3]{1000000, 0, UINT64_MAX};
+    void* userData[3]{};
+    std::vector<sdbus::Slot> slots;
+    auto r = con.callMethodsAsync(msgs, timeouts, nullptr, userData, 3, slots);
+
+    ASSERT_THAT(r, Eq(1));
+    ASSERT_THAT(slots.size(), Eq(3));
+}
+
+TEST_F(AConnectionCallingMethodsAsynchronously, ReturnsSlotsOfBatchCallsMadeBeforeFailure)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    ON_CALL(*sdBusIntfMock_, sd_bus_call_async_many(_, _, _, _, _, _, _, _, _))
+        .WillByDefault([](sd_bus*, sd_bus_slot** slots, sd_bus_message**, sd_bus_message_handler_t, void**, uint64_t, std::size_t, sd_bus_message**, uint64_t*)
+        {
+            slots[0] = reinterpret_cast<sd_bus_slot*>(1);
+            return -ENOTCONN;
+        });
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+
+    sd_bus_message* msgs[2]{};
+    uint64_t timeouts[2]{};
+    void* userData[2]{};
+    std::vector<sdbus::Slot> slots;
+    auto r = con.callMethodsAsync(msgs, timeouts, nullptr, userData, 2, slots);
+
+    ASSERT_THAT(r, Eq(-ENOTCONN));
+    ASSERT_THAT(slots.size(), Eq(1));
+}
+
+namespace {
+    class CountingMemoryResource : public std::pmr::memory_resource
+    {
+    public:
+        std::size_t allocations{};
+        std::size_t deallocations{};
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            ++allocations;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override
+        {
+            ++deallocations;
+            std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+}
+
+TEST_F(AConnectionCallingMethodsAsynchronously, AllocatesCallsAndMatchesFromPluggedInMemoryResource)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    ON_CALL(*sdBusIntfMock_, sd_bus_call_async_get_n_queued(_, _, _, _, _, _, _, _)).WillByDefault(Return(1));
+    CountingMemoryResource resource;
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+    con.setMemoryResource(&resource);
+
+    sd_bus_message* msg{};
+    auto callSlot = con.callMethodAsync(msg, nullptr, nullptr, 1000000, sdbus::return_slot);
+    auto matchSlot = con.addMatch("type='signal'", [](sdbus::Message){}, sdbus::return_slot);
+    ASSERT_THAT(resource.allocations, Eq(2));
+
+    callSlot.reset();
+    matchSlot.reset();
+    (void)con.processPendingEvent();
+
+    ASSERT_THAT(resource.deallocations, Eq(2));
+}
+
+TEST_F(AConnectionCallingMethodsAsynchronously, ThrowsErrorWhenCallFails)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    ON_CALL(*sdBusIntfMock_, sd_bus_call_async_get_n_queued(_, _, _, _, _, _, _, _)).WillByDefault(Return(-ENOTCONN));
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+
+    sd_bus_message* msg{};
+    ASSERT_THROW((void)con.callMethodAsync(msg, nullptr, nullptr, 0, sdbus::return_slot), sdbus::Error);
+}
+
+using AConnectionRegisteringSignalHandlers = ConnectionCreationTest;
+
+TEST_F(AConnectionRegisteringSignalHandlers, AddsArgumentFiltersToMatchRule)
+{
+    std::string match;
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_add_match(_, _, _, _, _)).WillOnce(DoAll([&](sd_bus*, sd_bus_slot**, const char* m, sd_bus_message_handler_t, void*){ match = m; }, Return(1)));
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_match_signal(_, _, _, _, _, _, _, _)).Times(0);
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+
+    std::vector<sdbus::SignalArgFilter> filters{ {0, sdbus::SignalArgFilter::Kind::Namespace, "org.sdbuscpp"}
+                                               , {2, sdbus::SignalArgFilter::Kind::Equals, "it's"}
+                                               , {3, sdbus::SignalArgFilter::Kind::Path, "/a/"} };
+    auto slot = con.registerSignalHandler("org.sdbuscpp.service", "/a", "org.sdbuscpp.A", "", filters, nullptr, nullptr, nullptr, sdbus::return_slot);
+
+    ASSERT_THAT(match, Eq("type='signal',sender='org.sdbuscpp.service',path='/a',interface='org.sdbuscpp.A',"
+                          "arg0namespace='org.sdbuscpp',arg2='it'\\''s',arg3path='/a/'"));
+}
+
+TEST_F(AConnectionRegisteringSignalHandlers, InstallsMatchAsynchronouslyWhenGivenInstallCallback)
+{
+    sd_bus_message_handler_t installCallback = [](sd_bus_message*, void*, sd_bus_error*){ return 0; };
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_match_signal(_, _, _, _, _, _, _, _)).Times(0);
+    EXPECT_CALL( *sdBusIntfMock_
+               , sd_bus_match_signal_async(fakeBusPtr_, _, ::testing::StrEq("org.sdbuscpp.service"), ::testing::StrEq("/a"), ::testing::StrEq("org.sdbuscpp.A"), IsNull(), _, installCallback, _) )
+        .WillOnce(Return(1));
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+
+    auto slot = con.registerSignalHandler("org.sdbuscpp.service", "/a", "org.sdbuscpp.A", "", nullptr, installCallback, nullptr, sdbus::return_slot);
+}
+
+TEST_F(AConnectionRegisteringSignalHandlers, ThrowsErrorWhenNamespaceFilterIsNotOnFirstArgument)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_add_match(_, _, _, _, _)).Times(0);
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+
+    std::vector<sdbus::SignalArgFilter> filters{{1, sdbus::SignalArgFilter::Kind::Namespace, "org.sdbuscpp"}};
+    ASSERT_THROW((void)con.registerSignalHandler("", "/a", "org.sdbuscpp.A", "b", filters, nullptr, nullptr, nullptr, sdbus::return_slot), sdbus::Error);
+}
+
+using AConnectionWithOutboundQueueLimits = ConnectionCreationTest;
+
+TEST_F(AConnectionWithOutboundQueueLimits, DropsSignalsAndReportsOverflowWhenQueueIsOverHighWatermark)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    ON_CALL(*sdBusIntfMock_, sd_bus_get_n_queued(_, _, _)).WillByDefault(DoAll(SetArgPointee<2>(5), Return(0)));
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_send(_, _, _)).Times(0);
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+    std::vector<uint64_t> overflows;
+    con.setOutboundQueueLimits({ 4, 2, Connection::OutboundQueueOverflowPolicy::DropSignals
+                               , [&](uint64_t queued){ overflows.push_back(queued); } });
+
+    sd_bus_message* msg{};
+    con.sendSignal(msg);
+    con.sendSignal(msg);
+
+    ASSERT_THAT(overflows, ElementsAre(5));
+}
+
+TEST_F(AConnectionWithOutboundQueueLimits, SendsMethodRepliesRegardlessOfLimits)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    ON_CALL(*sdBusIntfMock_, sd_bus_get_n_queued(_, _, _)).WillByDefault(DoAll(SetArgPointee<2>(5), Return(0)));
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_send(_, _, _)).Times(1);
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+    con.setOutboundQueueLimits({4, 2, Connection::OutboundQueueOverflowPolicy::DropSignals, {}});
+
+    sd_bus_message* msg{};
+    con.sendMessage(msg);
+}
+
+TEST_F(AConnectionWithOutboundQueueLimits, CoalescesPropertiesChangedUntilQueueFallsToLowWatermark)
+{
+    uint64_t queueSize{5};
+    std::vector<std::string> emittedNames;
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    ON_CALL(*sdBusIntfMock_, sd_bus_get_n_queued(_, _, _)).WillByDefault([&](sd_bus*, uint64_t*, uint64_t* write){ *write = queueSize; return 0; });
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_emit_properties_changed_strv(_, _, _, _)).WillOnce([&](sd_bus*, const char*, const char*, char** names)
+    {
+        for (; names != nullptr && *names != nullptr; ++names)
+            emittedNames.emplace_back(*names);
+        return 0;
+    });
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+    con.setOutboundQueueLimits({4, 2, Connection::OutboundQueueOverflowPolicy::CoalescePropertiesChanged, {}});
+
+    con.emitPropertiesChangedSignal("/org/sdbuscpp/object", "org.sdbuscpp.Interface", {sdbus::PropertyName{"b"}});
+    con.emitPropertiesChangedSignal("/org/sdbuscpp/object", "org.sdbuscpp.Interface", {sdbus::PropertyName{"a"}, sdbus::PropertyName{"b"}});
+    ASSERT_TRUE(emittedNames.empty());
+
+    queueSize = 2;
+    (void)con.processPendingEvent();
+
+    ASSERT_THAT(emittedNames, ElementsAre("a", "b"));
+}
+
+TEST_F(AConnectionWithOutboundQueueLimits, BlocksEmittingThreadUntilEventLoopDrainsQueueToLowWatermark)
+{
+    std::atomic<uint64_t> queueSize{5};
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    ON_CALL(*sdBusIntfMock_, sd_bus_get_n_queued(_, _, _)).WillByDefault([&](sd_bus*, uint64_t*, uint64_t* write){ *write = queueSize; return 0; });
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_flush(_)).Times(1); // Only upon opening the bus, the emitter doesn't flush it
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_send(_, _, _)).Times(1);
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+    con.setOutboundQueueLimits({4, 2, Connection::OutboundQueueOverflowPolicy::Block, {}});
+
+    std::atomic<bool> sent{};
+    std::thread emitter([&](){ sd_bus_message* msg{}; con.sendSignal(msg); sent = true; });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_FALSE(sent);
+
+    queueSize = 2;
+    (void)con.processPendingEvent();
+    emitter.join();
+
+    ASSERT_TRUE(sent);
+}
+
+TEST_F(AConnectionWithOutboundQueueLimits, ThrowsErrorWhenLowWatermarkIsAboveHighWatermark)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+
+    ASSERT_THROW(con.setOutboundQueueLimits({2, 4, Connection::OutboundQueueOverflowPolicy::Enqueue, {}}), sdbus::Error);
+}
+
+using AConnectionWithMethodCallAdmissionLimits = ConnectionCreationTest;
+
+TEST_F(AConnectionWithMethodCallAdmissionLimits, ThrowsErrorWhenBurstIsZeroWithRateLimit)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+
+    ASSERT_THROW(con.setMethodCallAdmissionLimits({16, 10.0, 0, Connection::MethodCallOverloadPolicy::Reject, {}}), sdbus::Error);
+}
+
+TEST_F(AConnectionWithMethodCallAdmissionLimits, ThrowsErrorWhenInterfaceWeightIsZero)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+
+    ASSERT_THROW(con.setMethodCallAdmissionLimits({16, 0.0, 1, Connection::MethodCallOverloadPolicy::Defer, {{"org.sdbuscpp.Interface", 0}}}), sdbus::Error);
+}
+
+using AConnectionCollectingMetrics = ConnectionCreationTest;
+
+TEST_F(AConnectionCollectingMetrics, DoesNotCollectMetricsByDefault)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_process(fakeBusPtr_, _)).WillOnce(Return(1)).WillOnce(Return(0));
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_get_n_queued(_, _, _)).Times(0);
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+
+    (void)con.processPendingEvents(10, std::chrono::microseconds::max());
+
+    auto metrics = con.getMetrics();
+    ASSERT_THAT(metrics.processingSteps, Eq(0u));
+    ASSERT_THAT(metrics.processingDuration.count, Eq(0u));
+}
+
+TEST_F(AConnectionCollectingMetrics, CountsProcessingStepsAndSamplesQueueDepthsWhenEnabled)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_process(fakeBusPtr_, _)).WillOnce(Return(1)).WillOnce(Return(1)).WillOnce(Return(0));
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_get_n_queued(fakeBusPtr_, _, _))
+        .WillOnce(DoAll(SetArgPointee<1>(5), SetArgPointee<2>(2), Return(0)))
+        .WillRepeatedly(DoAll(SetArgPointee<1>(1), SetArgPointee<2>(0), Return(0)));
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+    con.enableMetrics();
+
+    (void)con.processPendingEvents(10, std::chrono::microseconds::max());
+
+    auto metrics = con.getMetrics();
+    ASSERT_THAT(metrics.processingSteps, Eq(3u));
+    ASSERT_THAT(metrics.processedEvents, Eq(2u));
+    ASSERT_THAT(metrics.processingDuration.count, Eq(3u));
+    ASSERT_THAT(metrics.readQueueDepth, Eq(1u));
+    ASSERT_THAT(metrics.maxReadQueueDepth, Eq(5u));
+    ASSERT_THAT(metrics.maxWriteQueueDepth, Eq(2u));
+}
+
+TEST_F(AConnectionCollectingMetrics, ClearsMetricsOnReset)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    ON_CALL(*sdBusIntfMock_, sd_bus_process(fakeBusPtr_, _)).WillByDefault(Return(1));
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+    con.enableMetrics();
+    (void)con.processPendingEvent();
+
+    con.resetMetrics();
+
+    auto metrics = con.getMetrics();
+    ASSERT_THAT(metrics.processingSteps, Eq(0u));
+    ASSERT_THAT(metrics.processingDuration.buckets, Each(Eq(0u)));
+}
+
+TEST_F(AConnectionCollectingMetrics, ForwardsBusLockProfilingRequestToSdBus)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    EXPECT_CALL(*sdBusIntfMock_, enableLockProfiling(true, 4));
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+
+    con.enableBusLockProfiling(true, 4);
+}
+
+TEST_F(AConnectionCollectingMetrics, ThrowsErrorWhenBusLockProfilingSamplingIntervalIsZero)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+
+    ASSERT_THROW(con.enableBusLockProfiling(true, 0), sdbus::Error);
+}
+
+using AConnectionReportingResourceUsage = ConnectionCreationTest;
+
+TEST_F(AConnectionReportingResourceUsage, CountsFloatingMatchRules)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    ON_CALL(*sdBusIntfMock_, sd_bus_add_match(_, _, _, _, _)).WillByDefault(Return(1));
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+    ASSERT_THAT(con.getResourceUsage().floatingMatchRules, Eq(0u));
+
+    con.addMatch("type='signal'", [](sdbus::Message){});
+    con.addMatch("type='signal',member='Changed'", [](sdbus::Message){});
+
+    auto usage = con.getResourceUsage();
+    ASSERT_THAT(usage.floatingMatchRules, Eq(2u));
+    ASSERT_THAT(usage.approximateBytes, Gt(0u));
+}
+
+TEST_F(AConnectionReportingResourceUsage, ReportsDepthsOfBusQueues)
+{
+    ON_CALL(*sdBusIntfMock_, sd_bus_open(_)).WillByDefault(DoAll(SetArgPointee<0>(fakeBusPtr_), Return(1)));
+    EXPECT_CALL(*sdBusIntfMock_, sd_bus_get_n_queued(fakeBusPtr_, _, _)).WillOnce(DoAll(SetArgPointee<1>(3), SetArgPointee<2>(7), Return(0)));
+    Connection con(std::move(sdBusIntfMock_), Connection::default_bus);
+
+    auto usage = con.getResourceUsage();
+
+    ASSERT_THAT(usage.readQueueDepth, Eq(3u));
+    ASSERT_THAT(usage.writeQueueDepth, Eq(7u));
+}
+
+TEST(AMetricsHistogram, HasExponentiallyGrowingBucketUpperBounds)
+{
+    using Histogram = sdbus::IConnection::Metrics::Histogram;
+
+    ASSERT_THAT(Histogram::getBucketUpperBound(0), Eq(std::chrono::microseconds{1}));
+    ASSERT_THAT(Histogram::getBucketUpperBound(10), Eq(std::chrono::microseconds{1024}));
+    ASSERT_THAT(Histogram::getBucketUpperBound(Histogram::BUCKET_COUNT - 1), Eq(std::chrono::microseconds::max()));
+}
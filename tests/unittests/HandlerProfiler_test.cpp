@@ -0,0 +1,138 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file HandlerProfiler_test.cpp
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "HandlerProfiler.h"
+
+#include "sdbus-c++/Error.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using ::testing::ElementsAre;
+using ::testing::Eq;
+using ::testing::IsEmpty;
+using ::testing::SizeIs;
+using ::sdbus::internal::HandlerProfiler;
+using HandlerKind = HandlerProfiler::HandlerKind;
+using namespace std::chrono_literals;
+
+/*-------------------------------------*/
+/* --          TEST CASES           -- */
+/*-------------------------------------*/
+
+TEST(AHandlerProfiler, IsInactiveByDefault)
+{
+    HandlerProfiler profiler;
+
+    auto result = profiler.measure(HandlerKind::Method, "/org/sdbuscpp/device", "org.sdbuscpp.Device", "reset", [](){ return 42; });
+
+    EXPECT_FALSE(profiler.isActive());
+    EXPECT_THAT(result, Eq(42));
+    EXPECT_THAT(profiler.getProfiles(), IsEmpty());
+}
+
+TEST(AHandlerProfiler, AttributesHandlerDurationsToTheirMembers)
+{
+    HandlerProfiler profiler;
+    profiler.enable(true);
+
+    profiler.record(HandlerKind::Method, "/org/sdbuscpp/device", "org.sdbuscpp.Device", "reset", 3us);
+    profiler.record(HandlerKind::Method, "/org/sdbuscpp/device", "org.sdbuscpp.Device", "reset", 100us);
+    profiler.record(HandlerKind::PropertyGet, "/org/sdbuscpp/device", "org.sdbuscpp.Device", "reset", 1us);
+    profiler.record(HandlerKind::Method, "/org/sdbuscpp/device2", "org.sdbuscpp.Device", "reset", 1us);
+
+    auto profiles = profiler.getProfiles();
+
+    ASSERT_THAT(profiles, SizeIs(3));
+    const auto& profile = profiles[0];
+    EXPECT_THAT(profile.kind, Eq(HandlerKind::Method));
+    EXPECT_THAT(profile.objectPath, Eq("/org/sdbuscpp/device"));
+    EXPECT_THAT(profile.interfaceName, Eq("org.sdbuscpp.Device"));
+    EXPECT_THAT(profile.memberName, Eq("reset"));
+    EXPECT_THAT(profile.duration.count, Eq(2));
+    EXPECT_THAT(profile.duration.sum, Eq(103us));
+    EXPECT_THAT(profile.duration.buckets[2], Eq(1)); // [2us, 4us)
+    EXPECT_THAT(profile.duration.buckets[7], Eq(1)); // [64us, 128us)
+    EXPECT_THAT(profile.maxDuration, Eq(100us));
+    EXPECT_THAT(profiles[1].objectPath, Eq("/org/sdbuscpp/device2"));
+    EXPECT_THAT(profiles[2].kind, Eq(HandlerKind::PropertyGet));
+}
+
+TEST(AHandlerProfiler, ReportsHandlersOverTheirBudgetToTheCallback)
+{
+    HandlerProfiler profiler;
+    std::vector<std::string> reported;
+    profiler.setWatchdog({10us, {{"org.sdbuscpp.Device.reset", 50us}}, [&](auto, auto, auto, auto memberName, auto)
+    {
+        reported.emplace_back(memberName);
+    }});
+
+    profiler.record(HandlerKind::Method, "/org/sdbuscpp/device", "org.sdbuscpp.Device", "reset", 20us);
+    profiler.record(HandlerKind::Method, "/org/sdbuscpp/device", "org.sdbuscpp.Device", "reset", 60us);
+    profiler.record(HandlerKind::PropertySet, "/org/sdbuscpp/device", "org.sdbuscpp.Device", "label", 5us);
+    profiler.record(HandlerKind::PropertySet, "/org/sdbuscpp/device", "org.sdbuscpp.Device", "label", 20us);
+
+    EXPECT_TRUE(profiler.isActive());
+    EXPECT_THAT(reported, ElementsAre("reset", "label"));
+    EXPECT_THAT(profiler.getProfiles(), IsEmpty()); // The watchdog alone doesn't collect profiles
+}
+
+TEST(AHandlerProfiler, AppliesNewBudgetsToMembersAlreadyProfiled)
+{
+    HandlerProfiler profiler;
+    profiler.enable(true);
+    profiler.setWatchdog({10us, {}, {}});
+    profiler.record(HandlerKind::Method, "/org/sdbuscpp/device", "org.sdbuscpp.Device", "reset", 20us);
+
+    profiler.setWatchdog({10us, {{"org.sdbuscpp.Device.reset", 50us}}, {}});
+    profiler.record(HandlerKind::Method, "/org/sdbuscpp/device", "org.sdbuscpp.Device", "reset", 20us);
+
+    auto profiles = profiler.getProfiles();
+    ASSERT_THAT(profiles, SizeIs(1));
+    EXPECT_THAT(profiles[0].duration.count, Eq(2));
+    EXPECT_THAT(profiles[0].overBudgetCount, Eq(1));
+}
+
+TEST(AHandlerProfiler, DropsProfilesOnReset)
+{
+    HandlerProfiler profiler;
+    profiler.enable(true);
+    profiler.record(HandlerKind::Method, "/org/sdbuscpp/device", "org.sdbuscpp.Device", "reset", 20us);
+
+    profiler.reset();
+
+    EXPECT_THAT(profiler.getProfiles(), IsEmpty());
+}
+
+TEST(AHandlerProfiler, ThrowsOnInvalidBudgets)
+{
+    HandlerProfiler profiler;
+
+    ASSERT_THROW(profiler.setWatchdog({-1us, {}, {}}), sdbus::Error);
+    ASSERT_THROW(profiler.setWatchdog({10us, {{"org.sdbuscpp.Device.reset", 0us}}, {}}), sdbus::Error);
+}
@@ -0,0 +1,169 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file InlineFunction_test.cpp
+ *
+ * Created on: Oct 14, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <sdbus-c++/InlineFunction.h>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <array>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <string>
+
+using ::testing::Eq;
+
+namespace
+{
+    int add(int a, int b)
+    {
+        return a + b;
+    }
+
+    // Callable counting its live instances, whose copying throws on request
+    template <std::size_t _Size>
+    struct ThrowingOnCopy
+    {
+        ThrowingOnCopy(int& instances, bool& throwOnCopy) : instances(&instances), throwOnCopy(&throwOnCopy) { ++*this->instances; }
+        ThrowingOnCopy(const ThrowingOnCopy& other) : instances(other.instances), throwOnCopy(other.throwOnCopy)
+        {
+            if (*throwOnCopy)
+                throw std::runtime_error("copy failed");
+            ++*instances;
+        }
+        ThrowingOnCopy(ThrowingOnCopy&& other) noexcept : instances(other.instances), throwOnCopy(other.throwOnCopy) { ++*instances; }
+        ~ThrowingOnCopy() { --*instances; }
+        int operator()() const { return 42; }
+
+        int* instances;
+        bool* throwOnCopy;
+        std::array<std::byte, _Size> padding{};
+    };
+}
+
+/*-------------------------------------*/
+/* --          TEST CASES           -- */
+/*-------------------------------------*/
+
+TEST(AnInlineFunction, IsEmptyWhenDefaultConstructed)
+{
+    sdbus::InlineFunction<void()> function;
+
+    ASSERT_FALSE(function);
+    ASSERT_TRUE(function == nullptr);
+    ASSERT_THROW(function(), std::bad_function_call);
+}
+
+TEST(AnInlineFunction, IsEmptyWhenConstructedFromEmptyFunctionWrappers)
+{
+    int (*nullFunctionPointer)(int, int){};
+
+    ASSERT_FALSE((sdbus::InlineFunction<int(int, int)>{nullFunctionPointer}));
+    ASSERT_FALSE((sdbus::InlineFunction<int(int, int)>{std::function<int(int, int)>{}}));
+}
+
+TEST(AnInlineFunction, InvokesFunctionPointers)
+{
+    sdbus::InlineFunction<int(int, int)> function{&add};
+
+    ASSERT_THAT(function(2, 3), Eq(5));
+}
+
+TEST(AnInlineFunction, InvokesLambdasStoredInPlaceAsWellAsOnHeap)
+{
+    std::array<int, 64> bigCapture{};
+    bigCapture[63] = 10;
+    sdbus::InlineFunction<int(int)> small{[offset = 1](int value){ return value + offset; }};
+    sdbus::InlineFunction<int(int)> big{[bigCapture](int value){ return value + bigCapture[63]; }};
+
+    ASSERT_THAT(small(1), Eq(2));
+    ASSERT_THAT(big(1), Eq(11));
+}
+
+TEST(AnInlineFunction, CanBeCopiedAndMoved)
+{
+    std::array<int, 64> bigCapture{};
+    bigCapture[0] = 5;
+    sdbus::InlineFunction<int()> small{[str = std::string("abc")](){ return static_cast<int>(str.size()); }};
+    sdbus::InlineFunction<int()> big{[bigCapture](){ return bigCapture[0]; }};
+
+    auto smallCopy = small;
+    auto bigCopy = big;
+    auto smallMoved = std::move(small);
+    auto bigMoved = std::move(big);
+
+    ASSERT_THAT(smallCopy(), Eq(3));
+    ASSERT_THAT(bigCopy(), Eq(5));
+    ASSERT_THAT(smallMoved(), Eq(3));
+    ASSERT_THAT(bigMoved(), Eq(5));
+    ASSERT_FALSE(small);
+    ASSERT_FALSE(big);
+}
+
+TEST(AnInlineFunction, StaysIntactWhenCopyingItsCallableThrows)
+{
+    auto test = [](auto callableSize)
+    {
+        int instances{};
+        bool throwOnCopy{};
+        sdbus::InlineFunction<int()> function{ThrowingOnCopy<decltype(callableSize)::value>{instances, throwOnCopy}};
+        sdbus::InlineFunction<int()> target{[](){ return 7; }};
+        ASSERT_THAT(instances, Eq(1));
+        throwOnCopy = true;
+
+        ASSERT_THROW(sdbus::InlineFunction<int()>{function}, std::runtime_error);
+        ASSERT_THROW(target = function, std::runtime_error);
+
+        ASSERT_THAT(instances, Eq(1));
+        ASSERT_THAT(function(), Eq(42));
+        ASSERT_THAT(target(), Eq(7));
+    };
+
+    test(std::integral_constant<std::size_t, 1>{});    // Stored in place
+    test(std::integral_constant<std::size_t, 256>{});  // Stored on heap
+}
+
+TEST(AnInlineFunction, ForwardsArgumentsWithoutCopyingThem)
+{
+    sdbus::InlineFunction<std::size_t(std::unique_ptr<std::string>)> function{[](std::unique_ptr<std::string> str){ return str->size(); }};
+
+    ASSERT_THAT(function(std::make_unique<std::string>("abcd")), Eq(4));
+}
+
+TEST(AnInlineFunction, DestroysStoredCallableWhenResetOrDestroyed)
+{
+    auto state = std::make_shared<int>(1);
+    sdbus::InlineFunction<void()> function{[state](){}};
+    {
+        sdbus::InlineFunction<void()> other{[state](){}};
+        ASSERT_THAT(state.use_count(), Eq(3));
+    }
+    ASSERT_THAT(state.use_count(), Eq(2));
+
+    function = nullptr;
+
+    ASSERT_THAT(state.use_count(), Eq(1));
+}
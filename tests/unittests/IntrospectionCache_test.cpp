@@ -0,0 +1,229 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file IntrospectionCache_test.cpp
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IntrospectionCache.h"
+#include "VTableUtils.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <array>
+#include <optional>
+#include <string>
+
+using ::testing::Eq;
+using ::testing::HasSubstr;
+using ::testing::Not;
+using ::testing::Ne;
+using ::testing::Optional;
+using ::sdbus::internal::IntrospectionCache;
+
+namespace {
+const sd_bus_vtable DEVICE_VTABLE[] =
+{
+    createSdBusVTableStartItem(0),
+    createSdBusVTableMethodItem("reset", "us", "b", "mode\0reason\0ok\0", nullptr, 0),
+    createSdBusVTableMethodItem("hiddenMethod", "", "", "", nullptr, SD_BUS_VTABLE_HIDDEN),
+    createSdBusVTableSignalItem("stateChanged", "s", "state\0", SD_BUS_VTABLE_DEPRECATED),
+    createSdBusVTableReadOnlyPropertyItem("serial", "s", nullptr, SD_BUS_VTABLE_PROPERTY_CONST),
+    createSdBusVTableWritablePropertyItem("label", "s", nullptr, nullptr, SD_BUS_VTABLE_PROPERTY_EMITS_CHANGE | SD_BUS_VTABLE_UNPRIVILEGED),
+    createSdBusVTableEndItem()
+};
+
+const sd_bus_vtable EMPTY_VTABLE[] = { createSdBusVTableStartItem(0), createSdBusVTableEndItem() };
+
+const int SLOT1{}, SLOT2{}, SLOT3{};
+}
+
+/*-------------------------------------*/
+/* --          TEST CASES           -- */
+/*-------------------------------------*/
+
+TEST(AnIntrospectionCache, ProvidesNoXmlForUnknownObjectPath)
+{
+    IntrospectionCache cache;
+
+    EXPECT_THAT(cache.getXml("/org/sdbuscpp/device", true), Eq(std::nullopt));
+}
+
+TEST(AnIntrospectionCache, DescribesRegisteredInterfaceMembersLikeSdBus)
+{
+    IntrospectionCache cache;
+    cache.addVTable("/org/sdbuscpp/device", &SLOT1, "org.sdbuscpp.Device", DEVICE_VTABLE);
+
+    auto xml = cache.getXml("/org/sdbuscpp/device", true);
+
+    ASSERT_TRUE(xml.has_value());
+    EXPECT_THAT(*xml, HasSubstr( " <interface name=\"org.sdbuscpp.Device\">\n"
+                                 "  <method name=\"reset\">\n"
+                                 "   <arg type=\"u\" name=\"mode\" direction=\"in\"/>\n"
+                                 "   <arg type=\"s\" name=\"reason\" direction=\"in\"/>\n"
+                                 "   <arg type=\"b\" name=\"ok\" direction=\"out\"/>\n"
+                                 "  </method>\n"
+                                 "  <signal name=\"stateChanged\">\n"
+                                 "   <arg type=\"s\" name=\"state\"/>\n"
+                                 "   <annotation name=\"org.freedesktop.DBus.Deprecated\" value=\"true\"/>\n"
+                                 "  </signal>\n"
+                                 "  <property name=\"serial\" type=\"s\" access=\"read\">\n"
+                                 "   <annotation name=\"org.freedesktop.DBus.Property.EmitsChangedSignal\" value=\"const\"/>\n"
+                                 "  </property>\n"
+                                 "  <property name=\"label\" type=\"s\" access=\"readwrite\">\n"
+                                 "  </property>\n"
+                                 " </interface>\n"
+                                 "</node>\n" ));
+    EXPECT_THAT(*xml, Not(HasSubstr("hiddenMethod")));
+}
+
+TEST(AnIntrospectionCache, MarksPrivilegedMembersOnUntrustedBus)
+{
+    IntrospectionCache cache;
+    cache.addVTable("/org/sdbuscpp/device", &SLOT1, "org.sdbuscpp.Device", DEVICE_VTABLE);
+
+    auto xml = cache.getXml("/org/sdbuscpp/device", false);
+
+    ASSERT_TRUE(xml.has_value());
+    EXPECT_THAT(*xml, HasSubstr( "   <arg type=\"b\" name=\"ok\" direction=\"out\"/>\n"
+                                 "   <annotation name=\"org.freedesktop.systemd1.Privileged\" value=\"true\"/>\n"
+                                 "  </method>\n" ));
+    EXPECT_THAT(*xml, HasSubstr( "  <property name=\"label\" type=\"s\" access=\"readwrite\">\n"
+                                 "  </property>\n" ));
+}
+
+TEST(AnIntrospectionCache, ListsDirectChildNodesOnly)
+{
+    IntrospectionCache cache;
+    cache.addVTable("/org/sdbuscpp/device", &SLOT1, "org.sdbuscpp.Device", EMPTY_VTABLE);
+    cache.addVTable("/org/sdbuscpp/device/port/1", &SLOT2, "org.sdbuscpp.Port", EMPTY_VTABLE);
+    cache.addVTable("/org/sdbuscpp/device2", &SLOT3, "org.sdbuscpp.Device", EMPTY_VTABLE);
+
+    EXPECT_THAT(cache.getXml("/org/sdbuscpp", true), Optional(HasSubstr(" <node name=\"device\"/>\n <node name=\"device2\"/>\n</node>\n")));
+    EXPECT_THAT(cache.getXml("/org/sdbuscpp/device", true), Optional(HasSubstr(" </interface>\n <node name=\"port\"/>\n</node>\n")));
+    EXPECT_THAT(cache.getXml("/", true), Optional(HasSubstr(" <node name=\"org\"/>\n</node>\n")));
+}
+
+TEST(AnIntrospectionCache, MergesVTablesOfTheSameInterface)
+{
+    IntrospectionCache cache;
+    cache.addVTable("/org/sdbuscpp/device", &SLOT1, "org.sdbuscpp.Device", DEVICE_VTABLE);
+    cache.addVTable("/org/sdbuscpp/device", &SLOT2, "org.sdbuscpp.Port", EMPTY_VTABLE);
+    cache.addVTable("/org/sdbuscpp/device", &SLOT3, "org.sdbuscpp.Device", DEVICE_VTABLE);
+
+    auto xml = cache.getXml("/org/sdbuscpp/device", true);
+
+    ASSERT_TRUE(xml.has_value());
+    EXPECT_THAT(*xml, HasSubstr(" <interface name=\"org.sdbuscpp.Port\">\n </interface>\n <interface name=\"org.sdbuscpp.Device\">\n"));
+    EXPECT_THAT(*xml, HasSubstr(" </property>\n  <method name=\"reset\">\n"));
+}
+
+TEST(AnIntrospectionCache, UpdatesXmlOfObjectAndItsParentsWhenRegistrationsChange)
+{
+    IntrospectionCache cache;
+    cache.addVTable("/org/sdbuscpp/device", &SLOT1, "org.sdbuscpp.Device", EMPTY_VTABLE);
+    auto objectXml = cache.getXml("/org/sdbuscpp/device", true);
+    auto parentXml = cache.getXml("/org/sdbuscpp", true);
+
+    cache.addVTable("/org/sdbuscpp/device", &SLOT2, "org.sdbuscpp.Port", EMPTY_VTABLE);
+    cache.addVTable("/org/sdbuscpp/other", &SLOT3, "org.sdbuscpp.Port", EMPTY_VTABLE);
+
+    EXPECT_THAT(cache.getXml("/org/sdbuscpp/device", true), Optional(HasSubstr("org.sdbuscpp.Port")));
+    EXPECT_THAT(cache.getXml("/org/sdbuscpp", true), Optional(HasSubstr("<node name=\"other\"/>")));
+
+    cache.remove("/org/sdbuscpp/device", &SLOT2);
+    cache.remove("/org/sdbuscpp/other", &SLOT3);
+
+    EXPECT_THAT(cache.getXml("/org/sdbuscpp/device", true), Eq(objectXml));
+    EXPECT_THAT(cache.getXml("/org/sdbuscpp", true), Eq(parentXml));
+    EXPECT_THAT(cache.getXml("/org/sdbuscpp/other", true), Eq(std::nullopt));
+}
+
+TEST(AnIntrospectionCache, IncludesObjectManagerInterfaceWhileObjectManagerIsRegistered)
+{
+    IntrospectionCache cache;
+    cache.addObjectManager("/org/sdbuscpp", &SLOT1);
+
+    EXPECT_THAT(cache.getXml("/org/sdbuscpp", true), Optional(HasSubstr("<interface name=\"org.freedesktop.DBus.ObjectManager\">")));
+
+    cache.remove("/org/sdbuscpp", &SLOT1);
+
+    EXPECT_THAT(cache.getXml("/org/sdbuscpp", true), Eq(std::nullopt));
+}
+
+TEST(AnIntrospectionCache, LeavesPathsServedBySubtreeRegistrationsToSdBus)
+{
+    IntrospectionCache cache;
+    cache.addVTable("/org/sdbuscpp/device", &SLOT1, "org.sdbuscpp.Device", EMPTY_VTABLE);
+    cache.addSubtreeRegistration("/org/sdbuscpp", &SLOT2);
+
+    EXPECT_THAT(cache.getXml("/org/sdbuscpp", true), Eq(std::nullopt));
+    EXPECT_THAT(cache.getXml("/org/sdbuscpp/device", true), Eq(std::nullopt));
+    EXPECT_THAT(cache.getXml("/org", true), Ne(std::nullopt));
+
+    cache.remove("/org/sdbuscpp", &SLOT2);
+
+    EXPECT_THAT(cache.getXml("/org/sdbuscpp/device", true), Ne(std::nullopt));
+}
+
+TEST(AnIntrospectionCache, MirrorsNothingWhileDisabled)
+{
+    IntrospectionCache cache{/*enabled*/ false};
+    cache.addVTable("/org/sdbuscpp/device", &SLOT1, "org.sdbuscpp.Device", EMPTY_VTABLE);
+
+    cache.enable(true);
+
+    EXPECT_THAT(cache.getXml("/org/sdbuscpp/device", true), Eq(std::nullopt));
+}
+
+TEST(AnIntrospectionCache, LeavesAllPathsToSdBusWhileRegistrationMissedWhenDisabledIsAround)
+{
+    IntrospectionCache cache{/*enabled*/ false};
+    cache.addVTable("/org/sdbuscpp/device1", &SLOT1, "org.sdbuscpp.Device", EMPTY_VTABLE);
+    cache.enable(true);
+    cache.addVTable("/org/sdbuscpp/device2", &SLOT2, "org.sdbuscpp.Device", EMPTY_VTABLE);
+
+    auto xmlWithMissedRegistration = cache.getXml("/org/sdbuscpp/device2", true);
+    cache.remove("/org/sdbuscpp/device1", &SLOT1);
+
+    EXPECT_THAT(xmlWithMissedRegistration, Eq(std::nullopt));
+    EXPECT_THAT(cache.getXml("/org/sdbuscpp/device2", true), Ne(std::nullopt));
+}
+
+TEST(AnIntrospectionCache, CountsRegistrationsAsMissedOnceDisabled)
+{
+    IntrospectionCache cache;
+    cache.addVTable("/org/sdbuscpp/device1", &SLOT1, "org.sdbuscpp.Device", EMPTY_VTABLE);
+    cache.addVTable("/org/sdbuscpp/device2", &SLOT2, "org.sdbuscpp.Device", EMPTY_VTABLE);
+
+    cache.enable(false);
+    cache.enable(true);
+    auto xmlWithMissedRegistrations = cache.getXml("/org/sdbuscpp/device2", true);
+    std::array<const char*, 1> paths{"/org/sdbuscpp/device1"};
+    std::array<sd_bus_slot*, 1> slots{(sd_bus_slot*)&SLOT1};
+    cache.remove(paths, slots);
+    cache.remove("/org/sdbuscpp/device2", &SLOT2);
+    cache.addVTable("/org/sdbuscpp/device3", &SLOT3, "org.sdbuscpp.Device", EMPTY_VTABLE);
+
+    EXPECT_THAT(xmlWithMissedRegistrations, Eq(std::nullopt));
+    EXPECT_THAT(cache.getXml("/org/sdbuscpp/device3", true), Ne(std::nullopt));
+}
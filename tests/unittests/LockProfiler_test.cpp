@@ -0,0 +1,189 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file LockProfiler_test.cpp
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LockProfiler.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+using ::testing::Eq;
+using ::testing::Ge;
+using ::testing::IsEmpty;
+using ::sdbus::internal::LockProfiler;
+using ::sdbus::internal::ProfiledLockGuard;
+using namespace std::chrono_literals;
+
+namespace
+{
+    // Sites are registered process-wide, so each test looks up its own one by name
+    std::optional<LockProfiler::LockProfile> findProfile(const LockProfiler& profiler, const char* function)
+    {
+        auto profiles = profiler.getProfiles();
+        auto it = std::find_if(profiles.begin(), profiles.end(), [&](const auto& profile){ return profile.function == function; });
+        if (it == profiles.end())
+            return std::nullopt;
+        return *it;
+    }
+
+    void acquire(std::mutex& mutex, LockProfiler& profiler, std::size_t site, std::size_t times)
+    {
+        for (std::size_t i = 0; i < times; ++i)
+            ProfiledLockGuard lock(mutex, profiler, site);
+    }
+}
+
+/*-------------------------------------*/
+/* --          TEST CASES           -- */
+/*-------------------------------------*/
+
+TEST(ALockProfiler, RegistersSitesUnderConsecutiveIndices)
+{
+    static const auto site1 = LockProfiler::registerSite("registersSites1");
+    static const auto site2 = LockProfiler::registerSite("registersSites2");
+
+    EXPECT_THAT(site2, Eq(site1 + 1));
+}
+
+TEST(ALockProfiler, RecordsNothingWhenDisabled)
+{
+    static const auto site = LockProfiler::registerSite("recordsNothing");
+    LockProfiler profiler;
+    std::mutex mutex;
+
+    acquire(mutex, profiler, site, 3);
+
+    EXPECT_FALSE(profiler.isEnabled());
+    EXPECT_THAT(profiler.getProfiles(), IsEmpty());
+}
+
+TEST(ALockProfiler, CountsEveryAcquisitionAndSamplesEveryNthOne)
+{
+    static const auto site = LockProfiler::registerSite("countsAcquisitions");
+    LockProfiler profiler;
+    profiler.enable(true, 4);
+    std::mutex mutex;
+
+    acquire(mutex, profiler, site, 8);
+
+    auto profile = findProfile(profiler, "countsAcquisitions");
+    ASSERT_TRUE(profile.has_value());
+    EXPECT_THAT(profile->acquisitions, Eq(8));
+    EXPECT_THAT(profile->waitDuration.count, Eq(2));
+    EXPECT_THAT(profile->holdDuration.count, Eq(2));
+}
+
+TEST(ALockProfiler, MeasuresTimeTheLockWasHeld)
+{
+    static const auto site = LockProfiler::registerSite("measuresHold");
+    LockProfiler profiler;
+    profiler.enable(true, 1);
+    std::mutex mutex;
+
+    {
+        ProfiledLockGuard lock(mutex, profiler, site);
+        std::this_thread::sleep_for(1ms);
+    }
+
+    auto profile = findProfile(profiler, "measuresHold");
+    ASSERT_TRUE(profile.has_value());
+    EXPECT_THAT(profile->holdDuration.count, Eq(1));
+    EXPECT_THAT(profile->holdDuration.sum, Ge(1ms));
+}
+
+TEST(ALockProfiler, ReportsOnlySitesAcquiredWhileEnabled)
+{
+    static const auto acquiredSite = LockProfiler::registerSite("acquiredSite");
+    static const auto idleSite = LockProfiler::registerSite("idleSite");
+    LockProfiler profiler;
+    profiler.enable(true, 1);
+    std::mutex mutex;
+
+    acquire(mutex, profiler, acquiredSite, 1);
+
+    EXPECT_TRUE(findProfile(profiler, "acquiredSite").has_value());
+    EXPECT_FALSE(findProfile(profiler, "idleSite").has_value());
+    EXPECT_THAT(idleSite, Eq(acquiredSite + 1));
+}
+
+TEST(ALockProfiler, StopsCountingOnceDisabledButKeepsCollectedProfiles)
+{
+    static const auto site = LockProfiler::registerSite("stopsCounting");
+    LockProfiler profiler;
+    profiler.enable(true, 1);
+    std::mutex mutex;
+    acquire(mutex, profiler, site, 2);
+
+    profiler.enable(false, 1);
+    acquire(mutex, profiler, site, 2);
+
+    auto profile = findProfile(profiler, "stopsCounting");
+    ASSERT_TRUE(profile.has_value());
+    EXPECT_THAT(profile->acquisitions, Eq(2));
+}
+
+TEST(ALockProfiler, ClearsProfilesOnReset)
+{
+    static const auto site = LockProfiler::registerSite("clearsOnReset");
+    LockProfiler profiler;
+    profiler.enable(true, 1);
+    std::mutex mutex;
+    acquire(mutex, profiler, site, 2);
+
+    profiler.reset();
+
+    EXPECT_FALSE(findProfile(profiler, "clearsOnReset").has_value());
+    acquire(mutex, profiler, site, 1);
+    auto profile = findProfile(profiler, "clearsOnReset");
+    ASSERT_TRUE(profile.has_value());
+    EXPECT_THAT(profile->acquisitions, Eq(1));
+    EXPECT_THAT(profile->waitDuration.count, Eq(1));
+}
+
+TEST(AProfiledLockGuard, HoldsTheLockForItsLifetime)
+{
+    static const auto site = LockProfiler::registerSite("holdsTheLock");
+    LockProfiler profiler;
+    profiler.enable(true, 1);
+    std::mutex mutex;
+
+    auto tryLockElsewhere = [&]()
+    {
+        bool locked{};
+        std::thread([&](){ if ((locked = mutex.try_lock())) mutex.unlock(); }).join();
+        return locked;
+    };
+
+    {
+        ProfiledLockGuard lock(mutex, profiler, site);
+        EXPECT_FALSE(tryLockElsewhere());
+    }
+
+    EXPECT_TRUE(tryLockElsewhere());
+}
@@ -0,0 +1,202 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file ManagedObjectsCache_test.cpp
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ManagedObjectsCache.h"
+#include "VTableUtils.h"
+
+#include <sdbus-c++/Message.h>
+#include <sdbus-c++/Types.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <map>
+#include <string>
+
+using ::testing::ElementsAre;
+using ::testing::Eq;
+using ::testing::IsEmpty;
+using ::testing::Key;
+using ::testing::Optional;
+using ::sdbus::internal::ManagedObjectsCache;
+
+namespace {
+struct Device
+{
+    uint32_t level{};
+    int getterCalls{};
+};
+
+int getLevel(sd_bus*, const char*, const char*, const char*, sd_bus_message* reply, void* userData, sd_bus_error*)
+{
+    auto* device = static_cast<Device*>(userData);
+    ++device->getterCalls;
+    return sd_bus_message_append_basic(reply, 'u', &device->level);
+}
+
+int getSerial(sd_bus*, const char*, const char*, const char*, sd_bus_message* reply, void*, sd_bus_error*)
+{
+    return sd_bus_message_append_basic(reply, 's', "SN-42");
+}
+
+const sd_bus_vtable DEVICE_VTABLE[] =
+{
+    createSdBusVTableStartItem(0),
+    createSdBusVTableReadOnlyPropertyItem("level", "u", &getLevel, SD_BUS_VTABLE_PROPERTY_EMITS_CHANGE),
+    createSdBusVTableReadOnlyPropertyItem("secret", "u", &getLevel, SD_BUS_VTABLE_HIDDEN),
+    createSdBusVTableEndItem()
+};
+
+const sd_bus_vtable IDENTITY_VTABLE[] =
+{
+    createSdBusVTableStartItem(0),
+    createSdBusVTableReadOnlyPropertyItem("serial", "s", &getSerial, SD_BUS_VTABLE_PROPERTY_CONST),
+    createSdBusVTableEndItem()
+};
+
+const int SLOT1{}, SLOT2{}, SLOT3{}, SLOT4{};
+
+using ManagedObjects = std::map<sdbus::ObjectPath, std::map<std::string, std::map<std::string, sdbus::Variant>>>;
+
+std::optional<ManagedObjects> getManagedObjects(ManagedObjectsCache& cache, std::string_view objectPath)
+{
+    auto reply = sdbus::createPlainMessage();
+    if (!cache.writeManagedObjects(nullptr, objectPath, reply))
+        return std::nullopt;
+
+    reply.seal();
+    ManagedObjects objects;
+    reply >> objects;
+    return objects;
+}
+}
+
+/*-------------------------------------*/
+/* --          TEST CASES           -- */
+/*-------------------------------------*/
+
+TEST(AManagedObjectsCache, ProvidesNoReplyForPathWithoutObjectManager)
+{
+    ManagedObjectsCache cache;
+    Device device;
+    cache.addVTable("/org/sdbuscpp/devices/1", &SLOT1, "org.sdbuscpp.Device", DEVICE_VTABLE, &device);
+
+    EXPECT_FALSE(getManagedObjects(cache, "/org/sdbuscpp/devices").has_value());
+}
+
+TEST(AManagedObjectsCache, ListsObjectsBelowObjectManagerWithTheirPropertiesLikeSdBus)
+{
+    ManagedObjectsCache cache;
+    Device device{7};
+    cache.addObjectManager("/org/sdbuscpp/devices", &SLOT1);
+    cache.addVTable("/org/sdbuscpp/devices", &SLOT2, "org.sdbuscpp.Device", DEVICE_VTABLE, &device);
+    cache.addVTable("/org/sdbuscpp/devices/1", &SLOT3, "org.sdbuscpp.Device", DEVICE_VTABLE, &device);
+    cache.addVTable("/org/sdbuscpp/devices/1", &SLOT4, "org.sdbuscpp.Identity", IDENTITY_VTABLE, nullptr);
+
+    auto objects = getManagedObjects(cache, "/org/sdbuscpp/devices");
+
+    ASSERT_TRUE(objects.has_value());
+    ASSERT_THAT(*objects, ElementsAre(Key(sdbus::ObjectPath{"/org/sdbuscpp/devices/1"})));
+    const auto& interfaces = objects->begin()->second;
+    EXPECT_THAT(interfaces, ElementsAre( Key("org.freedesktop.DBus.Introspectable")
+                                       , Key("org.freedesktop.DBus.ObjectManager")
+                                       , Key("org.freedesktop.DBus.Peer")
+                                       , Key("org.freedesktop.DBus.Properties")
+                                       , Key("org.sdbuscpp.Device")
+                                       , Key("org.sdbuscpp.Identity") ));
+    EXPECT_THAT(interfaces.at("org.sdbuscpp.Device"), ElementsAre(Key("level")));
+    EXPECT_THAT(interfaces.at("org.sdbuscpp.Device").at("level").get<uint32_t>(), Eq(7));
+    EXPECT_THAT(interfaces.at("org.sdbuscpp.Identity").at("serial").get<std::string>(), Eq("SN-42"));
+    EXPECT_THAT(interfaces.at("org.freedesktop.DBus.Peer"), IsEmpty());
+}
+
+TEST(AManagedObjectsCache, InvokesGettersOnlyAgainAfterPropertiesChange)
+{
+    ManagedObjectsCache cache;
+    Device device{7};
+    cache.addObjectManager("/org/sdbuscpp/devices", &SLOT1);
+    cache.addVTable("/org/sdbuscpp/devices/1", &SLOT2, "org.sdbuscpp.Device", DEVICE_VTABLE, &device);
+    cache.addVTable("/org/sdbuscpp/devices/1", &SLOT3, "org.sdbuscpp.Identity", IDENTITY_VTABLE, nullptr);
+    (void)getManagedObjects(cache, "/org/sdbuscpp/devices");
+    const auto getterCalls = device.getterCalls;
+
+    device.level = 8;
+    auto staleObjects = getManagedObjects(cache, "/org/sdbuscpp/devices");
+    cache.invalidate("/org/sdbuscpp/devices/1", "org.sdbuscpp.Identity");
+    auto stillStaleObjects = getManagedObjects(cache, "/org/sdbuscpp/devices");
+    cache.invalidate("/org/sdbuscpp/devices/1", "org.sdbuscpp.Device");
+    auto freshObjects = getManagedObjects(cache, "/org/sdbuscpp/devices");
+
+    EXPECT_THAT(staleObjects->at(sdbus::ObjectPath{"/org/sdbuscpp/devices/1"}).at("org.sdbuscpp.Device").at("level").get<uint32_t>(), Eq(7));
+    EXPECT_THAT(stillStaleObjects->at(sdbus::ObjectPath{"/org/sdbuscpp/devices/1"}).at("org.sdbuscpp.Device").at("level").get<uint32_t>(), Eq(7));
+    EXPECT_THAT(freshObjects->at(sdbus::ObjectPath{"/org/sdbuscpp/devices/1"}).at("org.sdbuscpp.Device").at("level").get<uint32_t>(), Eq(8));
+    EXPECT_THAT(device.getterCalls, Eq(getterCalls + 1));
+}
+
+TEST(AManagedObjectsCache, DropsObjectsWhoseVTablesAreRemoved)
+{
+    ManagedObjectsCache cache;
+    Device device;
+    cache.addObjectManager("/org/sdbuscpp/devices", &SLOT1);
+    cache.addVTable("/org/sdbuscpp/devices/1", &SLOT2, "org.sdbuscpp.Device", DEVICE_VTABLE, &device);
+    cache.addVTable("/org/sdbuscpp/devices/2", &SLOT3, "org.sdbuscpp.Device", DEVICE_VTABLE, &device);
+    (void)getManagedObjects(cache, "/org/sdbuscpp/devices");
+
+    cache.remove("/org/sdbuscpp/devices/1", &SLOT2);
+
+    auto objects = getManagedObjects(cache, "/org/sdbuscpp/devices");
+    ASSERT_TRUE(objects.has_value());
+    EXPECT_THAT(*objects, ElementsAre(Key(sdbus::ObjectPath{"/org/sdbuscpp/devices/2"})));
+}
+
+TEST(AManagedObjectsCache, TellsWhetherObjectStillHasInterface)
+{
+    ManagedObjectsCache cache;
+    Device device;
+    cache.addVTable("/org/sdbuscpp/devices/1", &SLOT1, "org.sdbuscpp.Device", DEVICE_VTABLE, &device);
+    cache.addVTable("/org/sdbuscpp/devices/1", &SLOT2, "org.sdbuscpp.Identity", IDENTITY_VTABLE, nullptr);
+    cache.addSubtreeRegistration("/org/sdbuscpp/sensors", &SLOT3);
+
+    cache.remove("/org/sdbuscpp/devices/1", &SLOT2);
+
+    EXPECT_TRUE(cache.hasInterface("/org/sdbuscpp/devices/1", "org.sdbuscpp.Device"));
+    EXPECT_FALSE(cache.hasInterface("/org/sdbuscpp/devices/1", "org.sdbuscpp.Identity"));
+    EXPECT_FALSE(cache.hasInterface("/org/sdbuscpp/devices/2", "org.sdbuscpp.Device"));
+    EXPECT_TRUE(cache.hasInterface("/org/sdbuscpp/sensors/1", "org.sdbuscpp.Sensor"));
+}
+
+TEST(AManagedObjectsCache, LeavesObjectManagersWithSubtreeRegistrationsToSdBus)
+{
+    ManagedObjectsCache cache;
+    cache.addObjectManager("/org/sdbuscpp/devices", &SLOT1);
+    cache.addObjectManager("/org/sdbuscpp/sensors", &SLOT2);
+    cache.addSubtreeRegistration("/org/sdbuscpp/devices/usb", &SLOT3);
+    cache.addSubtreeRegistration("/org/sdbuscpp", &SLOT4);
+
+    EXPECT_FALSE(getManagedObjects(cache, "/org/sdbuscpp/devices").has_value());
+    EXPECT_FALSE(getManagedObjects(cache, "/org/sdbuscpp/sensors").has_value());
+    cache.remove("/org/sdbuscpp", &SLOT4);
+    EXPECT_THAT(getManagedObjects(cache, "/org/sdbuscpp/sensors"), Optional(IsEmpty()));
+}
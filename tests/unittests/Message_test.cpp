@@ -25,15 +25,29 @@
  */
 
 #include <sdbus-c++/Types.h>
+#include <sdbus-c++/DynamicValue.h>
 #include "MessageUtils.h"
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <array>
 #include <cstdint>
+#include <deque>
 #include <list>
+#include <memory_resource>
+#include <optional>
+#ifdef __has_include
+#  if __has_include(<ranges>)
+#    include <ranges>
+#  endif
+#endif
+#include <set>
+#include <thread>
+#include <vector>
 
 using ::testing::Eq;
 using ::testing::StrEq;
 using ::testing::Gt;
+using ::testing::Lt;
 using ::testing::DoubleEq;
 using ::testing::IsNull;
 using ::testing::SizeIs;
@@ -132,8 +146,73 @@ namespace my {
 
         friend bool operator==(const NestedStruct& lhs, const NestedStruct& rhs) = default;
     };
+
+    struct Sample
+    {
+        int32_t id;
+        double value;
+        uint64_t timestamp;
+
+        friend bool operator==(const Sample& lhs, const Sample& rhs) = default;
+    };
+
+    // Minimal inline-capacity vector, counting its reallocations
+    template <typename _Element, std::size_t _Capacity>
+    class SmallVector
+    {
+    public:
+        using value_type = _Element;
+
+        const _Element* data() const { return elements_.data(); }
+        std::size_t size() const { return elements_.size(); }
+        auto begin() const { return elements_.begin(); }
+        auto end() const { return elements_.end(); }
+        auto end() { return elements_.end(); }
+        void reserve(std::size_t capacity) { if (capacity > _Capacity) { elements_.reserve(capacity); ++allocations; } }
+        template <typename _InputIt>
+        void insert(typename std::vector<_Element>::iterator pos, _InputIt first, _InputIt last) { elements_.insert(pos, first, last); }
+        template <typename... _Args>
+        void emplace_back(_Args&&... args) { elements_.emplace_back(std::forward<_Args>(args)...); }
+
+        std::size_t allocations{};
+
+    private:
+        std::vector<_Element> elements_ = [](){ std::vector<_Element> v; v.reserve(_Capacity); return v; }();
+    };
+
+    // Minimal flat map over a sorted vector of pairs, counting its insertions
+    template <typename _Key, typename _Value>
+    class FlatMap
+    {
+    public:
+        using key_type = _Key;
+        using mapped_type = _Value;
+        using value_type = std::pair<_Key, _Value>;
+
+        auto begin() const { return entries_.begin(); }
+        auto end() const { return entries_.end(); }
+        template <typename _InputIt>
+        void insert(_InputIt first, _InputIt last)
+        {
+            entries_.insert(entries_.end(), first, last);
+            std::stable_sort(entries_.begin(), entries_.end(), [](const auto& lhs, const auto& rhs){ return lhs.first < rhs.first; });
+            ++insertions;
+        }
+
+        std::size_t insertions{};
+
+    private:
+        std::vector<value_type> entries_;
+    };
 }
 
+template <typename _Element, std::size_t _Capacity>
+constexpr bool sdbus::dbus_array_container_v<my::SmallVector<_Element, _Capacity>> = true;
+template <typename _Element>
+constexpr bool sdbus::dbus_array_container_v<std::deque<_Element>> = true;
+template <typename _Key, typename _Value>
+constexpr bool sdbus::dbus_dictionary_container_v<my::FlatMap<_Key, _Value>> = true;
+
 SDBUSCPP_REGISTER_STRUCT(my::Struct, i, s, l, e);
 
 SDBUSCPP_ENABLE_RELAXED_DICT2STRUCT_DESERIALIZATION(my::RelaxedStruct);
@@ -142,6 +221,8 @@ SDBUSCPP_REGISTER_STRUCT(my::RelaxedStruct, i, s, l, e);
 SDBUSCPP_ENABLE_NESTED_STRUCT2DICT_SERIALIZATION(my::NestedStruct);
 SDBUSCPP_REGISTER_STRUCT(my::NestedStruct, i, s, e, x);
 
+SDBUSCPP_REGISTER_STRUCT(my::Sample, id, value, timestamp);
+
 /*-------------------------------------*/
 /* --          TEST CASES           -- */
 /*-------------------------------------*/
@@ -179,6 +260,69 @@ TEST(AMessage, CreatesShallowCopyWhenCopyConstructed)
     ASSERT_THROW(msgCopy >> str, sdbus::Error);
 }
 
+TEST(AMessage, RemainsValidInCopiesAfterOriginalIsDestroyed)
+{
+    std::optional<sdbus::PlainMessage> msg{sdbus::createPlainMessage()};
+    *msg << "I am a string"s;
+    msg->seal();
+
+    sdbus::PlainMessage msgCopy = *msg;
+    sdbus::PlainMessage msgCopyOfCopy = msgCopy;
+    msg.reset();
+    msgCopy = sdbus::PlainMessage{};
+
+    ASSERT_TRUE(msgCopyOfCopy.isValid());
+    ASSERT_THAT(deserializeString(msgCopyOfCopy), Eq("I am a string"));
+}
+
+TEST(AMessage, CanBeCopiedAndDestroyedConcurrentlyInMultipleThreads)
+{
+    auto msg = sdbus::createPlainMessage();
+    msg << "I am a string"s;
+    msg.seal();
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([&msg]()
+        {
+            for (int j = 0; j < 10'000; ++j)
+            {
+                sdbus::PlainMessage copy = msg;
+                sdbus::PlainMessage copyOfCopy = copy;
+                copy = std::move(copyOfCopy);
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    ASSERT_THAT(deserializeString(msg), Eq("I am a string"));
+}
+
+TEST(AMessage, CanBeCreatedConcurrentlyInMultipleThreadsAndOutliveThem)
+{
+    std::vector<std::vector<sdbus::Variant>> variants(8);
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < variants.size(); ++i)
+    {
+        threads.emplace_back([&variants, i]()
+        {
+            for (int j = 0; j < 1'000; ++j)
+                variants[i].emplace_back("I am a string"s + std::to_string(j));
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    for (const auto& threadVariants : variants)
+    {
+        ASSERT_THAT(threadVariants.size(), Eq(1'000));
+        EXPECT_THAT(threadVariants.back().get<std::string>(), Eq("I am a string999"));
+    }
+}
+
 TEST(AMessage, CreatesDeepCopyWhenEplicitlyCopied)
 {
     auto msg = sdbus::createPlainMessage();
@@ -194,6 +338,32 @@ TEST(AMessage, CreatesDeepCopyWhenEplicitlyCopied)
     ASSERT_THAT(deserializeString(msgCopy), Eq("I am a string"));
 }
 
+TEST(AMessage, CreatesDeepCopyOfNestedContainersWhenEplicitlyCopied)
+{
+    const std::vector<uint8_t> bytes(100'000, 0x5A);
+    const std::map<std::string, std::vector<double>> samples{{"a", {1.5, 2.5}}, {"b", {}}};
+    const std::vector<sdbus::Struct<int32_t, sdbus::Variant>> records{{7, sdbus::Variant{"seven"s}}, {8, sdbus::Variant{bytes}}};
+    auto msg = sdbus::createPlainMessage();
+    msg << bytes << samples << records << "tail"s;
+    msg.seal();
+
+    auto msgCopy = sdbus::createPlainMessage();
+    msg.copyTo(msgCopy, true);
+    msgCopy.seal();
+
+    std::vector<uint8_t> copiedBytes;
+    std::map<std::string, std::vector<double>> copiedSamples;
+    std::vector<sdbus::Struct<int32_t, sdbus::Variant>> copiedRecords;
+    std::string copiedTail;
+    msgCopy >> copiedBytes >> copiedSamples >> copiedRecords >> copiedTail;
+    ASSERT_THAT(copiedBytes, Eq(bytes));
+    ASSERT_THAT(copiedSamples, Eq(samples));
+    ASSERT_THAT(copiedRecords.size(), Eq(2));
+    ASSERT_THAT(copiedRecords[0].get<1>().get<std::string>(), Eq("seven"));
+    ASSERT_THAT(copiedRecords[1].get<1>().get<std::vector<uint8_t>>(), Eq(bytes));
+    ASSERT_THAT(copiedTail, Eq("tail"));
+}
+
 TEST(AMessage, IsEmptyWhenContainsNoValue)
 {
     auto msg = sdbus::createPlainMessage();
@@ -239,6 +409,21 @@ TEST(AMessage, CanCarryAStringAsAStringView)
     ASSERT_THAT(dataRead, Eq(dataWritten));
 }
 
+TEST(AMessage, CanDeserializeAStringIntoAStringViewPointingIntoTheMessage)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    const std::string dataWritten = "Hello";
+
+    msg << dataWritten;
+    msg.seal();
+
+    std::string_view dataRead;
+    msg >> dataRead;
+
+    ASSERT_THAT(dataRead, Eq(dataWritten));
+}
+
 TEST(AMessage, CanCarryAUnixFd)
 {
     auto msg = sdbus::createPlainMessage();
@@ -254,6 +439,22 @@ TEST(AMessage, CanCarryAUnixFd)
     ASSERT_THAT(dataRead.get(), Gt(dataWritten.get()));
 }
 
+TEST(AMessage, CanCarryASharedUnixFd)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    const sdbus::SharedUnixFd dataWritten{0};
+    msg << dataWritten;
+
+    msg.seal();
+
+    sdbus::SharedUnixFd dataRead;
+    msg >> dataRead;
+
+    ASSERT_TRUE(dataRead.isValid());
+    ASSERT_THAT(dataRead.get(), Gt(dataWritten.get()));
+}
+
 TEST(AMessage, CanCarryAVariant)
 {
     auto msg = sdbus::createPlainMessage();
@@ -316,6 +517,56 @@ TEST(AMessage, CanCarryDBusArrayOfNontrivialTypesGivenAsStdVector)
     ASSERT_THAT(dataRead, Eq(dataWritten));
 }
 
+TEST(AMessage, CanCarryDBusArrayOfStringsGivenAsStdVector)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    const std::vector<std::string> dataWritten{"", "Hello", "\xC3\xA9t\xC3\xA9", std::string(100, 'x')};
+
+    msg << dataWritten;
+    msg.seal();
+
+    std::vector<std::string> dataRead;
+    msg >> dataRead;
+
+    ASSERT_THAT(dataRead, Eq(dataWritten));
+}
+
+TEST(AMessage, ThrowsAndAppendsNothingWhenStringArrayContainsInvalidUtf8String)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    const std::vector<std::string> dataWritten{"Hello", "World\xC3", "!"};
+
+    ASSERT_THROW(msg << dataWritten, sdbus::Error);
+    ASSERT_TRUE(msg.isEmpty());
+}
+
+TEST(AMessage, ThrowsWhenSerializingStringViewWithEmbeddedNulCharacter)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    const std::string_view dataWritten{"Hello\0World", 11};
+
+    ASSERT_THROW(msg << dataWritten, sdbus::Error);
+}
+
+TEST(AMessage, CanCarryDBusArrayFilledInPlaceInAppendedArraySpace)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    void* space{};
+    msg.appendArraySpace('d', 3 * sizeof(double), &space);
+    auto* array = static_cast<double*>(space);
+    array[0] = 3.14; array[1] = 2.72; array[2] = 1.41;
+    msg.seal();
+
+    std::vector<double> dataRead;
+    msg >> dataRead;
+
+    ASSERT_THAT(dataRead, ElementsAre(3.14, 2.72, 1.41));
+}
+
 TEST(AMessage, CanCarryDBusArrayOfTrivialTypesGivenAsStdArray)
 {
     auto msg = sdbus::createPlainMessage();
@@ -364,6 +615,82 @@ TEST(AMessage, CanCarryDBusArrayOfTrivialTypesGivenAsStdSpan)
     ASSERT_THAT(std::vector(dataRead.begin(), dataRead.end()), Eq(std::vector(dataWritten.begin(), dataWritten.end())));
 }
 
+TEST(AMessage, CanDeserializeDBusArrayOfTrivialTypesIntoAStdSpanViewPointingIntoTheMessage)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    const std::vector<int> dataWritten{3545342, 43643532, 324325};
+
+    msg << dataWritten;
+    msg.seal();
+
+    std::span<const int> dataRead;
+    msg >> dataRead;
+
+    ASSERT_THAT(std::vector(dataRead.begin(), dataRead.end()), Eq(dataWritten));
+}
+
+TEST(AMessage, CanCarryColumnsAsStructOfArrays)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    sdbus::Columns<uint64_t, double, double> dataWritten;
+    dataWritten.push_back(1, 20.5, 1013.25);
+    dataWritten.push_back({2, 21.0, 1013.5});
+
+    msg << dataWritten;
+    msg.seal();
+
+    sdbus::Struct<std::vector<uint64_t>, std::vector<double>, std::vector<double>> dataRead;
+    msg >> dataRead;
+
+    ASSERT_THAT(std::get<0>(dataRead), ElementsAre(1u, 2u));
+    ASSERT_THAT(std::get<1>(dataRead), ElementsAre(20.5, 21.0));
+    ASSERT_THAT(std::get<2>(dataRead), ElementsAre(1013.25, 1013.5));
+}
+
+TEST(AMessage, CanDeserializeColumnsAndIterateTheirRows)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    msg << sdbus::Struct{std::vector<uint64_t>{1, 2}, std::vector<double>{20.5, 21.0}};
+    msg.seal();
+
+    sdbus::Columns<uint64_t, double> dataRead;
+    dataRead.push_back(99, 99.0); // Replaced upon deserialization
+    msg >> dataRead;
+
+    std::vector<std::tuple<uint64_t, double>> rows(dataRead.begin(), dataRead.end());
+    ASSERT_THAT(rows, ElementsAre(std::tuple{1u, 20.5}, std::tuple{2u, 21.0}));
+    ASSERT_THAT(std::vector(dataRead.column<1>().begin(), dataRead.column<1>().end()), ElementsAre(20.5, 21.0));
+}
+
+TEST(AMessage, CanDeserializeColumnsIntoAViewPointingIntoTheMessage)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    msg << sdbus::Columns<int32_t, uint8_t>{std::vector<int32_t>{-1, 2, 3}, std::vector<uint8_t>{4, 5, 6}};
+    msg.seal();
+
+    sdbus::ColumnsView<int32_t, uint8_t> dataRead;
+    msg >> dataRead;
+
+    ASSERT_THAT(dataRead.size(), Eq(3u));
+    ASSERT_THAT(dataRead[0], Eq(std::tuple{-1, uint8_t{4}}));
+    ASSERT_THAT(std::vector(dataRead.column<0>().begin(), dataRead.column<0>().end()), ElementsAre(-1, 2, 3));
+}
+
+TEST(AMessage, ThrowsWhenDeserializingColumnsOfDifferentLengths)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    msg << sdbus::Struct{std::vector<uint64_t>{1, 2}, std::vector<double>{20.5}};
+    msg.seal();
+
+    sdbus::Columns<uint64_t, double> dataRead;
+    ASSERT_THROW(msg >> dataRead, sdbus::Error);
+}
+
 TEST(AMessage, CanCarryDBusArrayOfNontrivialTypesGivenAsStdSpan)
 {
     auto msg = sdbus::createPlainMessage();
@@ -444,6 +771,48 @@ TEST(AMessage, CanCarryADictionary)
     ASSERT_THAT(dataRead, Eq(dataWritten));
 }
 
+TEST(AMessage, DeserializesNestedPmrContainersAndStringsIntoMemoryResourceOfOutermostContainer)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    std::map<std::string, std::map<std::string, sdbus::Variant>> dataWritten{ {"org.sdbuscpp.A", {{"Name", sdbus::Variant{"a string longer than short string buffer"}}}}
+                                                                            , {"org.sdbuscpp.B", {{"Count", sdbus::Variant{42}}}} };
+    msg << dataWritten;
+    msg.seal();
+
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::map<std::pmr::string, std::pmr::map<std::pmr::string, sdbus::Variant>> dataRead{&arena};
+    msg >> dataRead;
+
+    ASSERT_THAT(dataRead, SizeIs(2));
+    for (const auto& [interface, properties] : dataRead)
+    {
+        ASSERT_THAT(interface.get_allocator().resource(), Eq(&arena));
+        ASSERT_THAT(properties.get_allocator().resource(), Eq(&arena));
+        for (const auto& [name, value] : properties)
+            ASSERT_THAT(name.get_allocator().resource(), Eq(&arena));
+    }
+    ASSERT_THAT(dataRead.at("org.sdbuscpp.A").at("Name").get<std::string>(), Eq("a string longer than short string buffer"));
+    ASSERT_THAT(dataRead.at("org.sdbuscpp.B").at("Count").get<int>(), Eq(42));
+}
+
+TEST(AMessage, CanCarryDBusArrayOfPmrStrings)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    std::pmr::monotonic_buffer_resource arena;
+    const std::pmr::vector<std::pmr::string> dataWritten{{"first string longer than short string buffer", "second"}, &arena};
+
+    msg << dataWritten;
+    msg.seal();
+
+    std::pmr::vector<std::pmr::string> dataRead{&arena};
+    msg >> dataRead;
+
+    ASSERT_THAT(dataRead, Eq(dataWritten));
+    ASSERT_THAT(dataRead[0].get_allocator().resource(), Eq(&arena));
+}
+
 TEST(AMessage, CanCarryAComplexType)
 {
     auto msg = sdbus::createPlainMessage();
@@ -503,6 +872,58 @@ TEST(AMessage, CanPeekContainerContents)
     ASSERT_THAT(contents, StrEq("{is}"));
 }
 
+TEST(AMessage, CanDeserializeDBusArrayLazilyElementByElement)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    const std::vector<std::string> dataWritten{"one", "two", "three"};
+    msg << dataWritten << 42;
+    msg.seal();
+
+    std::vector<std::string> dataRead;
+    for (auto& item : msg.readArrayLazy<std::string>())
+        dataRead.push_back(std::move(item));
+    int32_t intRead{};
+    msg >> intRead;
+
+    ASSERT_THAT(dataRead, Eq(dataWritten));
+    ASSERT_THAT(intRead, Eq(42));
+}
+
+TEST(AMessage, CanDeserializeDBusDictionaryLazilyEntryByEntry)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    const std::map<int32_t, std::string> dataWritten{{1, "one"}, {2, "two"}};
+    msg << dataWritten;
+    msg.seal();
+
+    std::map<int32_t, std::string> dataRead;
+    for (auto& entry : msg.readArrayLazy<sdbus::DictEntry<int32_t, std::string>>())
+        dataRead.insert(std::move(entry));
+
+    ASSERT_THAT(dataRead, Eq(dataWritten));
+}
+
+TEST(AMessage, SkipsRestOfDBusArrayWhenLazyIterationIsAbandoned)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    const std::vector<sdbus::Struct<int32_t, std::string>> dataWritten{{1, "one"}, {2, "two"}, {3, "three"}};
+    msg << dataWritten << "end"s;
+    msg.seal();
+
+    {
+        auto array = msg.readArrayLazy<sdbus::Struct<int32_t, std::string>>();
+        auto it = array.begin();
+        ASSERT_THAT(std::get<0>(*it), Eq(1));
+    }
+    std::string strRead;
+    msg >> strRead;
+
+    ASSERT_THAT(strRead, Eq("end"));
+}
+
 TEST(AMessage, CanCarryDBusArrayGivenAsCustomType)
 {
     auto msg = sdbus::createPlainMessage();
@@ -520,6 +941,224 @@ TEST(AMessage, CanCarryDBusArrayGivenAsCustomType)
     ASSERT_THAT(dataRead, Eq(dataWritten));
 }
 
+TEST(AMessage, CanCarryArrayOfTrivialTypesInUserDefinedInlineCapacityContainer)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    my::SmallVector<int32_t, 4> dataWritten;
+    dataWritten.emplace_back(3545342);
+    dataWritten.emplace_back(43643532);
+    msg << dataWritten << std::vector<int32_t>{1, 2, 3, 4, 5};
+    msg.seal();
+
+    my::SmallVector<int32_t, 4> dataRead;
+    my::SmallVector<int32_t, 4> largeDataRead;
+    msg >> dataRead >> largeDataRead;
+
+    ASSERT_THAT(dataRead, ElementsAre(3545342, 43643532));
+    ASSERT_THAT(dataRead.allocations, Eq(0));
+    ASSERT_THAT(largeDataRead, ElementsAre(1, 2, 3, 4, 5));
+    ASSERT_THAT(largeDataRead.allocations, Eq(1));
+}
+
+TEST(AMessage, CanCarryArrayOfStringsInUserDefinedNonContiguousContainer)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    const std::deque<std::string> dataWritten{"one", "two", "three"};
+    msg << dataWritten;
+    msg.seal();
+
+    std::deque<std::string> dataRead;
+    msg >> dataRead;
+
+    ASSERT_THAT(dataRead, Eq(dataWritten));
+}
+
+TEST(AMessage, CanCarryDictionaryInUserDefinedFlatMap)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    my::FlatMap<int32_t, std::string> dataWritten;
+    const std::vector<std::pair<int32_t, std::string>> entries{{3, "three"}, {1, "one"}, {2, "two"}};
+    dataWritten.insert(entries.begin(), entries.end());
+    msg << dataWritten;
+    msg.seal();
+
+    my::FlatMap<int32_t, std::string> dataRead;
+    msg >> dataRead;
+
+    ASSERT_THAT(dataRead, ElementsAre(std::pair{1, "one"s}, std::pair{2, "two"s}, std::pair{3, "three"s}));
+    ASSERT_THAT(dataRead.insertions, Eq(1));
+}
+
+#ifdef __cpp_lib_ranges
+TEST(AMessage, CanCarryDBusArrayOfTrivialTypesGivenAsContiguousRange)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    const std::vector<int32_t> source{3545342, 43643532, 324325};
+    msg << (source | std::views::take(2));
+    msg.seal();
+
+    std::vector<int32_t> dataRead;
+    msg >> dataRead;
+
+    ASSERT_THAT(dataRead, ElementsAre(3545342, 43643532));
+}
+
+TEST(AMessage, CanCarryDBusArrayOfTrivialTypesGivenAsComputedSizedRange)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    msg << (std::views::iota(0, 4) | std::views::transform([](int i){ return i * 0.5; }));
+    msg.seal();
+
+    std::vector<double> dataRead;
+    msg >> dataRead;
+
+    ASSERT_THAT(dataRead, ElementsAre(0.0, 0.5, 1.0, 1.5));
+}
+
+TEST(AMessage, CanCarryDBusArrayGivenAsUnsizedRange)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    const std::deque<std::string> source{"one", "two", "three"};
+    msg << (source | std::views::filter([](const auto& str){ return str.size() == 3; }));
+    msg.seal();
+
+    std::vector<std::string> dataRead;
+    msg >> dataRead;
+
+    ASSERT_THAT(dataRead, ElementsAre("one", "two"));
+}
+
+TEST(AMessage, CanCarryDBusArrayOfStringsGivenAsStandardContainer)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    const std::set<std::string> dataWritten{"b", "a", "c"};
+    msg << dataWritten;
+    msg.seal();
+
+    std::vector<std::string> dataRead;
+    msg >> dataRead;
+
+    ASSERT_THAT(dataRead, ElementsAre("a", "b", "c"));
+}
+
+TEST(AMessage, CanCarryDictionaryGivenAsRangeOfPairs)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    const std::multimap<int32_t, std::string> source{{1, "one"}, {2, "two"}};
+    msg << source << (std::views::iota(3, 5) | std::views::transform([](int32_t i){ return std::pair{i, std::to_string(i)}; }));
+    msg.seal();
+
+    std::map<int32_t, std::string> dataRead;
+    std::map<int32_t, std::string> computedDataRead;
+    msg >> dataRead >> computedDataRead;
+
+    ASSERT_THAT(dataRead, Eq(std::map<int32_t, std::string>{{1, "one"}, {2, "two"}}));
+    ASSERT_THAT(computedDataRead, Eq(std::map<int32_t, std::string>{{3, "3"}, {4, "4"}}));
+}
+#endif
+
+TEST(AMessage, CanCarryCompressedBytes)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    std::vector<uint8_t> data(64 * 1024);
+    for (std::size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<uint8_t>(i % 7);
+
+    msg << sdbus::CompressedBytes{data};
+    msg.seal();
+
+    sdbus::CompressedBytes dataRead;
+    msg >> dataRead;
+
+    ASSERT_THAT(dataRead.data(), Eq(data));
+}
+
+TEST(AMessage, PassesCompressedBytesBelowThresholdUncompressed)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    const std::vector<uint8_t> data(100, 0x2A);
+
+    msg << sdbus::CompressedBytes{data, sdbus::CompressedBytes::Codec::Zstd, 1024};
+    msg.seal();
+
+    sdbus::Struct<uint32_t, uint8_t, std::vector<uint8_t>> dataRead;
+    msg >> dataRead;
+
+    EXPECT_THAT(std::get<0>(dataRead), Eq(data.size()));
+    EXPECT_THAT(std::get<1>(dataRead), Eq(static_cast<uint8_t>(sdbus::CompressedBytes::Codec::None)));
+    EXPECT_THAT(std::get<2>(dataRead), Eq(data));
+}
+
+TEST(AMessage, CompressesCompressedBytesByAvailableCodec)
+{
+    for (auto codec : {sdbus::CompressedBytes::Codec::Lz4, sdbus::CompressedBytes::Codec::Zstd})
+    {
+        if (!sdbus::CompressedBytes::isCodecAvailable(codec))
+            continue;
+
+        auto msg = sdbus::createPlainMessage();
+        const std::vector<uint8_t> data(64 * 1024, 0x2A);
+
+        msg << sdbus::CompressedBytes{data, codec};
+        msg.seal();
+
+        sdbus::Struct<uint32_t, uint8_t, std::vector<uint8_t>> dataRead;
+        msg >> dataRead;
+
+        EXPECT_THAT(std::get<0>(dataRead), Eq(data.size()));
+        EXPECT_THAT(std::get<1>(dataRead), Eq(static_cast<uint8_t>(codec)));
+        EXPECT_THAT(std::get<2>(dataRead).size(), Lt(data.size()));
+    }
+}
+
+TEST(AMessage, ThrowsWhenDeserializingCompressedBytesOfUnavailableCodec)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    msg << sdbus::Struct<uint32_t, uint8_t, std::vector<uint8_t>>{10u, uint8_t{99}, std::vector<uint8_t>(5)};
+    msg.seal();
+
+    sdbus::CompressedBytes dataRead;
+    ASSERT_THROW(msg >> dataRead, sdbus::Error);
+}
+
+TEST(AMessage, ThrowsWhenDeserializingCompressedBytesAnnouncingOriginalSizeBeyondTheirCodecRatio)
+{
+    for (auto codec : {sdbus::CompressedBytes::Codec::Lz4, sdbus::CompressedBytes::Codec::Zstd})
+    {
+        if (!sdbus::CompressedBytes::isCodecAvailable(codec))
+            continue;
+
+        auto msg = sdbus::createPlainMessage();
+        msg << sdbus::Struct<uint32_t, uint8_t, std::vector<uint8_t>>{512u * 1024 * 1024, static_cast<uint8_t>(codec), std::vector<uint8_t>(8)};
+        msg.seal();
+
+        sdbus::CompressedBytes dataRead;
+        ASSERT_THROW(msg >> dataRead, sdbus::Error);
+    }
+}
+
+TEST(AMessage, ThrowsWhenDeserializingUncompressedBytesNotMatchingTheirAnnouncedSize)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    msg << sdbus::Struct<uint32_t, uint8_t, std::vector<uint8_t>>{10u, uint8_t{0}, std::vector<uint8_t>(5)};
+    msg.seal();
+
+    sdbus::CompressedBytes dataRead;
+    ASSERT_THROW(msg >> dataRead, sdbus::Error);
+}
+
 TEST(AMessage, CanCarryUserDefinedStruct)
 {
     auto msg = sdbus::createPlainMessage();
@@ -550,6 +1189,66 @@ TEST(AMessage, CanCarryNestedUserDefinedStruct)
     ASSERT_THAT(dataRead, Eq(dataWritten));
 }
 
+TEST(AMessage, CanCarryArrayOfStructsOfFixedSizeBasicTypes)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    using TrivialStruct = sdbus::Struct<uint8_t, int16_t, uint16_t, int32_t, uint32_t, int64_t, uint64_t, double>;
+    const std::vector<TrivialStruct> dataWritten{ {255, -32768, 65535, -2147483647, 4294967295u, INT64_MIN, UINT64_MAX, 3.14}
+                                                , {1, 2, 3, 4, 5, 6, 7, 8.5} };
+
+    msg << dataWritten;
+    msg.seal();
+
+    std::vector<TrivialStruct> dataRead;
+    msg >> dataRead;
+
+    ASSERT_THAT(dataRead, Eq(dataWritten));
+}
+
+TEST(AMessage, CanCarryArrayOfUserDefinedStructsOfFixedSizeBasicTypes)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    const std::vector<my::Sample> dataWritten{{1, 0.5, 1000}, {2, 1.5, 2000}, {3, 2.5, 3000}};
+
+    msg << dataWritten;
+    msg.seal();
+
+    std::vector<my::Sample> dataRead;
+    msg >> dataRead;
+
+    ASSERT_THAT(dataRead, Eq(dataWritten));
+}
+
+TEST(AMessage, ThrowsWhenDestinationArrayIsTooShortForStructsOfFixedSizeBasicTypes)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    const std::vector<my::Sample> dataWritten{{1, 0.5, 1000}, {2, 1.5, 2000}, {3, 2.5, 3000}};
+
+    msg << dataWritten;
+    msg.seal();
+
+    std::array<my::Sample, 2> dataRead;
+    ASSERT_THROW(msg >> dataRead, sdbus::Error);
+}
+
+TEST(AMessage, DeserializesStructOfFixedSizeBasicTypesSerializedFieldByField)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    msg.openStruct("idt");
+    msg << int32_t{7} << 2.5 << uint64_t{123456789};
+    msg.closeStruct();
+    msg.seal();
+
+    my::Sample dataRead{};
+    msg >> dataRead;
+
+    ASSERT_THAT(dataRead, Eq(my::Sample{7, 2.5, 123456789}));
+}
+
 TEST(AMessage, CanSerializeUserDefinedStructAsDictionaryOfStringsToVariants)
 {
     auto msg = sdbus::createPlainMessage();
@@ -645,10 +1344,134 @@ TEST(AMessage, DeserializesDictionaryIntoStructWithMissingMembersSuccessfullyIfR
     ASSERT_THAT(dataRead, Eq(my::RelaxedStruct{{}, {}, {3.14, 2.4568546}, my::Enum::Value2}));
 }
 
+TEST(AMessage, SkipsDictionaryEntriesWithoutStructMemberWhenDeserializingFromRelaxedDictionaryEvenIfStructIsStrict)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    std::map<std::string, sdbus::Variant> dataWritten{ {"i", sdbus::Variant{3545342}}
+                                                     , {"nonexistent", sdbus::Variant{"hello"s}}
+                                                     , {"l", sdbus::Variant{std::list<double>{3.14, 2.4568546}}} };
+
+    msg << dataWritten << 42;
+    msg.seal();
+
+    my::Struct dataRead{0, "kept"s, {}, my::Enum::Value3};
+    sdbus::from_relaxed_dictionary relaxedDataRead{dataRead};
+    int trailingValue{};
+    msg >> relaxedDataRead >> trailingValue;
+
+    ASSERT_THAT(dataRead, Eq(my::Struct{3545342, "kept"s, {3.14, 2.4568546}, my::Enum::Value3}));
+    ASSERT_THAT(trailingValue, Eq(42));
+}
+
+TEST(AMessage, CanDeserializeRecursivelySerializedUserDefinedStructFromDictionaryOfStringsToVariants)
+{
+    auto msg = sdbus::createPlainMessage();
+
+    const my::NestedStruct dataWritten{3545342, "hello"s, my::Enum::Value2, {12, "world"s, {3.14, 2.4568546}, my::Enum::Value3}};
+
+    msg << sdbus::as_dictionary{dataWritten} << 42;
+    msg.seal();
+
+    my::NestedStruct dataRead{};
+    int trailingValue{};
+    msg >> dataRead >> trailingValue;
+
+    ASSERT_THAT(dataRead, Eq(dataWritten));
+    ASSERT_THAT(trailingValue, Eq(42));
+}
+
 class AMessage : public ::testing::TestWithParam<std::variant<int32_t, std::string, my::Struct>>
 {
 };
 
+TEST(ADynamicBody, DecodesMessageBodyIntoValueTree)
+{
+    auto msg = sdbus::createPlainMessage();
+    msg << int32_t{-7} << "hello"s << std::vector<uint16_t>{1, 2, 3} << std::vector<std::string>{"a", "b"}
+        << std::map<std::string, sdbus::Variant>{{"k", sdbus::Variant{3.5}}} << sdbus::Struct<bool, sdbus::ObjectPath>{true, "/a/b"};
+    msg.seal();
+
+    sdbus::DynamicBody body(msg);
+
+    ASSERT_THAT(body.getSignature(), Eq("isaqasa{sv}(bo)"));
+    ASSERT_THAT(body.size(), Eq(6));
+    ASSERT_THAT(body[0].get<int32_t>(), Eq(-7));
+    ASSERT_THAT(body[1].get<std::string_view>(), Eq("hello"));
+    ASSERT_THAT(body[2].getType(), Eq('a'));
+    ASSERT_THAT(body[2].size(), Eq(3));
+    ASSERT_THAT(body[2][2].get<uint16_t>(), Eq(3));
+    ASSERT_THAT(body[3][1].get<std::string_view>(), Eq("b"));
+    auto entry = body[4][0];
+    ASSERT_THAT(entry.getType(), Eq('e'));
+    ASSERT_THAT(entry.getSignature(), Eq("{sv}"));
+    ASSERT_THAT(entry[0].get<std::string_view>(), Eq("k"));
+    ASSERT_THAT(entry[1].getType(), Eq('v'));
+    ASSERT_THAT(entry[1][0].get<double>(), DoubleEq(3.5));
+    ASSERT_THAT(body[5].getType(), Eq('r'));
+    ASSERT_TRUE(body[5][0].get<bool>());
+    ASSERT_THAT(body[5][1].get<std::string_view>(), Eq("/a/b"));
+}
+
+TEST(ADynamicBody, DecodesEmptyArraysAndIteratesOverValues)
+{
+    auto msg = sdbus::createPlainMessage();
+    msg << std::vector<std::vector<int32_t>>{{}, {1, 2}, {}} << std::vector<std::string>{} << std::vector<bool>{true, false};
+    msg.seal();
+
+    sdbus::DynamicBody body(msg);
+
+    ASSERT_THAT(body.size(), Eq(3));
+    std::vector<std::size_t> sizes;
+    for (auto array : body[0])
+        sizes.push_back(array.size());
+    ASSERT_THAT(sizes, ElementsAre(0, 2, 0));
+    ASSERT_THAT(body[0][1][1].get<int32_t>(), Eq(2));
+    ASSERT_TRUE(body[1].empty());
+    ASSERT_FALSE(body[2][1].get<bool>());
+}
+
+TEST(ADynamicBody, ThrowsWhenValueIsGotAsAnotherType)
+{
+    auto msg = sdbus::createPlainMessage();
+    msg << int32_t{42};
+    msg.seal();
+
+    sdbus::DynamicBody body(msg);
+
+    ASSERT_THROW(body[0].get<uint32_t>(), sdbus::Error);
+}
+
+TEST(ADynamicBody, ReusesItselfForDecodingAnotherMessage)
+{
+    auto msg1 = sdbus::createPlainMessage();
+    msg1 << "first"s << "second"s;
+    msg1.seal();
+    auto msg2 = sdbus::createPlainMessage();
+    msg2 << uint64_t{42};
+    msg2.seal();
+
+    sdbus::DynamicBody body(msg1);
+    body.decode(msg2);
+
+    ASSERT_THAT(body.size(), Eq(1));
+    ASSERT_THAT(body[0].get<uint64_t>(), Eq(42));
+}
+
+TEST(AMessage, WritesBodyAsJson)
+{
+    auto msg = sdbus::createPlainMessage();
+    msg << int32_t{-7} << "a \"quoted\"\n\x01 text"s << std::vector<uint8_t>{1, 2} << std::vector<bool>{true}
+        << std::map<int32_t, sdbus::Variant>{{1, sdbus::Variant{"one"s}}, {2, sdbus::Variant{std::vector<double>{0.5}}}}
+        << sdbus::Struct<bool, sdbus::ObjectPath>{false, "/a/b"} << std::vector<std::vector<std::string>>{{}, {"x"}};
+    msg.seal();
+
+    std::string json;
+    sdbus::writeJson(msg, json);
+
+    ASSERT_THAT(json, Eq(R"([-7,"a \"quoted\"\n\u0001 text",[1,2],[true],{"1":"one","2":[0.5]},[false,"/a/b"],[[],["x"]]])"));
+}
+
 TEST_P(AMessage, CanCarryDBusVariantGivenAsStdVariant)
 {
     auto msg = sdbus::createPlainMessage();
@@ -0,0 +1,214 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file MethodCallScheduler_test.cpp
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MethodCallScheduler.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <optional>
+#include <vector>
+
+using ::testing::Eq;
+using ::testing::ElementsAre;
+using ::testing::Optional;
+using ::sdbus::internal::MethodCallScheduler;
+using Limits = sdbus::IConnection::MethodCallAdmissionLimits;
+using Policy = sdbus::IConnection::MethodCallOverloadPolicy;
+using namespace std::chrono_literals;
+
+namespace {
+std::vector<int> takeAll(MethodCallScheduler<int>& scheduler, std::chrono::nanoseconds now)
+{
+    std::vector<int> calls;
+    while (auto call = scheduler.next(now))
+        calls.push_back(*call);
+    return calls;
+}
+}
+
+/*-------------------------------------*/
+/* --          TEST CASES           -- */
+/*-------------------------------------*/
+
+TEST(AMethodCallScheduler, TakesCallsOfOneSenderInOrderOfArrival)
+{
+    MethodCallScheduler<int> scheduler;
+    scheduler.setLimits({16, 0.0, 1, Policy::Reject, {}});
+
+    for (int i = 1; i <= 3; ++i)
+        ASSERT_THAT(scheduler.submit(":1.1", "org.sdbuscpp.A", i, 0s), Eq(std::nullopt));
+
+    EXPECT_THAT(takeAll(scheduler, 0s), ElementsAre(1, 2, 3));
+    EXPECT_THAT(scheduler.size(), Eq(0));
+}
+
+TEST(AMethodCallScheduler, AlternatesBetweenSendersRegardlessOfTheirQueuedCalls)
+{
+    MethodCallScheduler<int> scheduler;
+    scheduler.setLimits({16, 0.0, 1, Policy::Reject, {}});
+
+    for (int i = 1; i <= 4; ++i)
+        (void)scheduler.submit(":1.1", "org.sdbuscpp.A", i, 0s);
+    (void)scheduler.submit(":1.2", "org.sdbuscpp.A", 10, 0s);
+    (void)scheduler.submit(":1.2", "org.sdbuscpp.A", 20, 0s);
+
+    EXPECT_THAT(takeAll(scheduler, 0s), ElementsAre(1, 10, 2, 20, 3, 4));
+}
+
+TEST(AMethodCallScheduler, GivesCallsOnHeavierInterfacesMoreOfSendersTurn)
+{
+    MethodCallScheduler<int> scheduler;
+    scheduler.setLimits({16, 0.0, 1, Policy::Reject, {{"org.sdbuscpp.Fast", 2}}});
+
+    for (int i = 1; i <= 4; ++i)
+        (void)scheduler.submit(":1.1", "org.sdbuscpp.Fast", i, 0s);
+    for (int i = 10; i <= 30; i += 10)
+        (void)scheduler.submit(":1.2", "org.sdbuscpp.Slow", i, 0s);
+
+    EXPECT_THAT(takeAll(scheduler, 0s), ElementsAre(1, 2, 10, 3, 4, 20, 30));
+}
+
+TEST(AMethodCallScheduler, RejectsCallsOverSendersRateLimitWithRejectPolicy)
+{
+    MethodCallScheduler<int> scheduler;
+    scheduler.setLimits({16, 10.0, 2, Policy::Reject, {}});
+
+    EXPECT_THAT(scheduler.submit(":1.1", "org.sdbuscpp.A", 1, 0s), Eq(std::nullopt));
+    EXPECT_THAT(scheduler.submit(":1.1", "org.sdbuscpp.A", 2, 0s), Eq(std::nullopt));
+    EXPECT_THAT(scheduler.submit(":1.1", "org.sdbuscpp.A", 3, 0s), Optional(3));
+    EXPECT_THAT(scheduler.submit(":1.2", "org.sdbuscpp.A", 10, 0s), Eq(std::nullopt));
+    EXPECT_THAT(scheduler.submit(":1.1", "org.sdbuscpp.A", 4, 100ms), Eq(std::nullopt));
+    EXPECT_THAT(takeAll(scheduler, 100ms), ElementsAre(1, 10, 2, 4));
+}
+
+TEST(AMethodCallScheduler, DoesNotChargeSenderForCallRejectedForFullScheduler)
+{
+    MethodCallScheduler<int> scheduler;
+    scheduler.setLimits({2, 10.0, 3, Policy::Reject, {}});
+    (void)scheduler.submit(":1.1", "org.sdbuscpp.A", 1, 0s);
+    (void)scheduler.submit(":1.1", "org.sdbuscpp.A", 2, 0s);
+    ASSERT_THAT(scheduler.submit(":1.1", "org.sdbuscpp.A", 3, 0s), Optional(3));
+    ASSERT_THAT(scheduler.next(0s), Optional(1));
+
+    EXPECT_THAT(scheduler.submit(":1.1", "org.sdbuscpp.A", 4, 0s), Eq(std::nullopt));
+    EXPECT_THAT(takeAll(scheduler, 0s), ElementsAre(2, 4));
+}
+
+TEST(AMethodCallScheduler, KeepsRateLimitOfSenderWhoseQueueRanEmpty)
+{
+    MethodCallScheduler<int> scheduler;
+    scheduler.setLimits({16, 10.0, 1, Policy::Reject, {}});
+
+    (void)scheduler.submit(":1.1", "org.sdbuscpp.A", 1, 0s);
+    (void)takeAll(scheduler, 0s);
+
+    EXPECT_THAT(scheduler.submit(":1.1", "org.sdbuscpp.A", 2, 50ms), Optional(2));
+}
+
+TEST(AMethodCallScheduler, DefersCallsOverSendersRateLimitWithDeferPolicy)
+{
+    MethodCallScheduler<int> scheduler;
+    scheduler.setLimits({16, 10.0, 1, Policy::Defer, {}});
+
+    EXPECT_THAT(scheduler.submit(":1.1", "org.sdbuscpp.A", 1, 0s), Eq(std::nullopt));
+    EXPECT_THAT(scheduler.submit(":1.1", "org.sdbuscpp.A", 2, 0s), Eq(std::nullopt));
+
+    EXPECT_THAT(takeAll(scheduler, 0s), ElementsAre(1));
+    EXPECT_THAT(scheduler.nextReadyTime(0s), Eq(100ms));
+    EXPECT_THAT(takeAll(scheduler, 100ms), ElementsAre(2));
+    EXPECT_THAT(scheduler.nextReadyTime(100ms), Eq(std::chrono::nanoseconds::max()));
+}
+
+TEST(AMethodCallScheduler, PushesOutNewestCallOfLongestQueueWhenFull)
+{
+    MethodCallScheduler<int> scheduler;
+    scheduler.setLimits({3, 0.0, 1, Policy::Defer, {}});
+    (void)scheduler.submit(":1.1", "org.sdbuscpp.A", 1, 0s);
+    (void)scheduler.submit(":1.1", "org.sdbuscpp.A", 2, 0s);
+    (void)scheduler.submit(":1.1", "org.sdbuscpp.A", 3, 0s);
+    ASSERT_TRUE(scheduler.isFull());
+
+    EXPECT_THAT(scheduler.submit(":1.2", "org.sdbuscpp.A", 10, 0s), Optional(3));
+    EXPECT_THAT(scheduler.submit(":1.2", "org.sdbuscpp.A", 20, 0s), Optional(2));
+    EXPECT_THAT(scheduler.submit(":1.2", "org.sdbuscpp.A", 30, 0s), Optional(30));
+    EXPECT_THAT(takeAll(scheduler, 0s), ElementsAre(1, 10, 20));
+}
+
+TEST(AMethodCallScheduler, TakesHighPriorityCallsAheadOfOthersInOrderOfArrival)
+{
+    MethodCallScheduler<int> scheduler;
+    scheduler.setLimits({16, 0.0, 1, Policy::Reject, {}});
+    (void)scheduler.submit(":1.1", "org.sdbuscpp.A", 1, 0s);
+    (void)scheduler.submit(":1.2", "org.sdbuscpp.A", 10, 0s);
+    (void)scheduler.submit(":1.1", "org.sdbuscpp.A", 100, 0s, true);
+    (void)scheduler.submit(":1.2", "org.sdbuscpp.A", 200, 0s, true);
+
+    EXPECT_TRUE(scheduler.hasHighPriorityCalls());
+    EXPECT_THAT(takeAll(scheduler, 0s), ElementsAre(100, 200, 1, 10));
+}
+
+TEST(AMethodCallScheduler, DoesNotRateLimitHighPriorityCalls)
+{
+    MethodCallScheduler<int> scheduler;
+    scheduler.setLimits({16, 10.0, 1, Policy::Reject, {}});
+
+    EXPECT_THAT(scheduler.submit(":1.1", "org.sdbuscpp.A", 1, 0s), Eq(std::nullopt));
+    EXPECT_THAT(scheduler.submit(":1.1", "org.sdbuscpp.A", 2, 0s), Optional(2));
+    EXPECT_THAT(scheduler.submit(":1.1", "org.sdbuscpp.A", 3, 0s, true), Eq(std::nullopt));
+    EXPECT_THAT(takeAll(scheduler, 0s), ElementsAre(3, 1));
+}
+
+TEST(AMethodCallScheduler, PushesOutNewestCallOfLongestQueueForHighPriorityCallWhenFull)
+{
+    MethodCallScheduler<int> scheduler;
+    scheduler.setLimits({2, 0.0, 1, Policy::Defer, {}});
+    (void)scheduler.submit(":1.1", "org.sdbuscpp.A", 1, 0s);
+    (void)scheduler.submit(":1.1", "org.sdbuscpp.A", 2, 0s);
+
+    EXPECT_THAT(scheduler.submit(":1.1", "org.sdbuscpp.A", 10, 0s, true), Optional(2));
+    EXPECT_THAT(scheduler.submit(":1.1", "org.sdbuscpp.A", 20, 0s, true), Optional(1));
+    EXPECT_THAT(scheduler.submit(":1.1", "org.sdbuscpp.A", 30, 0s, true), Optional(30));
+    EXPECT_THAT(takeAll(scheduler, 0s), ElementsAre(10, 20));
+}
+
+TEST(AMethodCallScheduler, RemovesQueuedCallsSatisfyingPredicateAndKeepsTheRestInOrder)
+{
+    MethodCallScheduler<int> scheduler;
+    scheduler.setLimits({16, 0.0, 1, Policy::Reject, {}});
+    (void)scheduler.submit(":1.1", "org.sdbuscpp.A", 1, 0s);
+    (void)scheduler.submit(":1.1", "org.sdbuscpp.A", 2, 0s);
+    (void)scheduler.submit(":1.2", "org.sdbuscpp.A", 12, 0s);
+    (void)scheduler.submit(":1.3", "org.sdbuscpp.A", 3, 0s);
+    (void)scheduler.submit(":1.1", "org.sdbuscpp.A", 100, 0s, true);
+    (void)scheduler.submit(":1.1", "org.sdbuscpp.A", 101, 0s, true);
+
+    auto removed = scheduler.removeIf([](int call){ return call % 2 == 0; }, 0s);
+
+    EXPECT_THAT(removed, ElementsAre(100, 2, 12));
+    EXPECT_THAT(scheduler.size(), Eq(3));
+    EXPECT_THAT(takeAll(scheduler, 0s), ElementsAre(101, 1, 3));
+}
@@ -0,0 +1,113 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file StartupProfiler_test.cpp
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StartupProfiler.h"
+
+#include "sdbus-c++/Error.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using ::testing::Eq;
+using ::testing::IsEmpty;
+using ::testing::SizeIs;
+using ::sdbus::internal::StartupProfiler;
+using StartupPhase = StartupProfiler::StartupPhase;
+using namespace std::chrono_literals;
+
+/*-------------------------------------*/
+/* --          TEST CASES           -- */
+/*-------------------------------------*/
+
+TEST(AStartupProfiler, IsDisabledByDefault)
+{
+    StartupProfiler profiler;
+
+    auto result = profiler.measure(StartupPhase::NameRequest, "", [](){ return 42; });
+
+    EXPECT_FALSE(profiler.isEnabled());
+    EXPECT_THAT(result, Eq(42));
+    EXPECT_THAT(profiler.getProfile().phases[static_cast<std::size_t>(StartupPhase::NameRequest)].count, Eq(0));
+    EXPECT_THAT(profiler.getProfile().objects, IsEmpty());
+}
+
+TEST(AStartupProfiler, AttributesVTableDurationsToTheirPhasesAndObjects)
+{
+    StartupProfiler profiler;
+    profiler.enable(true);
+
+    profiler.record(StartupPhase::VTablePreparation, "/org/sdbuscpp/device", 3us);
+    profiler.record(StartupPhase::VTablePreparation, "/org/sdbuscpp/device", 5us);
+    profiler.record(StartupPhase::VTableRegistration, "/org/sdbuscpp/device", 10us);
+    profiler.record(StartupPhase::VTablePreparation, "/org/sdbuscpp/battery", 1us);
+    profiler.record(StartupPhase::VTableRegistration, "", 20us);
+
+    auto profile = profiler.getProfile();
+
+    ASSERT_THAT(profile.phases, SizeIs(4));
+    EXPECT_THAT(profile.phases[0].phase, Eq(StartupPhase::VTablePreparation));
+    EXPECT_THAT(profile.phases[0].count, Eq(3));
+    EXPECT_THAT(profile.phases[0].duration, Eq(9us));
+    EXPECT_THAT(profile.phases[1].phase, Eq(StartupPhase::VTableRegistration));
+    EXPECT_THAT(profile.phases[1].count, Eq(2));
+    EXPECT_THAT(profile.phases[1].duration, Eq(30us));
+    ASSERT_THAT(profile.objects, SizeIs(2));
+    EXPECT_THAT(profile.objects[0].objectPath, Eq("/org/sdbuscpp/battery"));
+    const auto& device = profile.objects[1];
+    EXPECT_THAT(device.objectPath, Eq("/org/sdbuscpp/device"));
+    EXPECT_THAT(device.vtables, Eq(2));
+    EXPECT_THAT(device.vtablePreparationDuration, Eq(8us));
+    EXPECT_THAT(device.vtableRegistrationDuration, Eq(10us));
+}
+
+TEST(AStartupProfiler, DoesNotAttributeNameRequestsAndMatchesToObjects)
+{
+    StartupProfiler profiler;
+    profiler.enable(true);
+
+    profiler.record(StartupPhase::NameRequest, "/org/sdbuscpp/device", 7us);
+    profiler.record(StartupPhase::SignalMatchInstallation, "/org/sdbuscpp/device", 2us);
+
+    auto profile = profiler.getProfile();
+
+    EXPECT_THAT(profile.phases[2].count, Eq(1));
+    EXPECT_THAT(profile.phases[3].duration, Eq(2us));
+    EXPECT_THAT(profile.objects, IsEmpty());
+}
+
+TEST(AStartupProfiler, DoesNotRecordFailedSteps)
+{
+    StartupProfiler profiler;
+    profiler.enable(true);
+
+    ASSERT_THROW(profiler.measure(StartupPhase::VTablePreparation, "/org/sdbuscpp/device", []()
+    {
+        throw sdbus::Error(sdbus::Error::Name{"org.sdbuscpp.Error"}, "Failed");
+    }), sdbus::Error);
+
+    EXPECT_THAT(profiler.getProfile().phases[0].count, Eq(0));
+    EXPECT_THAT(profiler.getProfile().objects, IsEmpty());
+}
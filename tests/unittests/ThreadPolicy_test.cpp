@@ -0,0 +1,120 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file ThreadPolicy_test.cpp
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ThreadPolicy.h"
+
+#include "sdbus-c++/Error.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <pthread.h>
+#include <sched.h>
+#include <string>
+#include <vector>
+
+using ::testing::Eq;
+using ::testing::ElementsAre;
+using ::sdbus::ThreadAttributes;
+using ::sdbus::ThreadRole;
+using ::sdbus::internal::startThread;
+
+namespace {
+class AThreadCreationPolicy : public ::testing::Test
+{
+protected:
+    ~AThreadCreationPolicy() override
+    {
+        sdbus::setThreadCreationPolicy({});
+    }
+};
+}
+
+/*-------------------------------------*/
+/* --          TEST CASES           -- */
+/*-------------------------------------*/
+
+TEST_F(AThreadCreationPolicy, IsNotConsultedWhenNotSet)
+{
+    bool ran{};
+
+    auto thread = startThread(ThreadRole::EventLoop, [&](){ ran = true; });
+    thread.join();
+
+    EXPECT_TRUE(ran);
+}
+
+TEST_F(AThreadCreationPolicy, IsAskedForAttributesOfThreadOfGivenRole)
+{
+    std::vector<ThreadRole> roles;
+    sdbus::setThreadCreationPolicy([&](ThreadRole role){ roles.push_back(role); return ThreadAttributes{}; });
+
+    startThread(ThreadRole::EventLoop, [](){}).join();
+    startThread(ThreadRole::MethodCallDispatch, [](){}).join();
+
+    EXPECT_THAT(roles, ElementsAre(ThreadRole::EventLoop, ThreadRole::MethodCallDispatch));
+}
+
+TEST_F(AThreadCreationPolicy, NamesThreadBeforeItStartsItsWork)
+{
+    sdbus::setThreadCreationPolicy([](ThreadRole){ return ThreadAttributes{"sdbus-event-loop-thread", {}, {}, 0}; });
+    std::string name;
+
+    auto thread = startThread(ThreadRole::EventLoop, [&]()
+    {
+        char buffer[16]{};
+        pthread_getname_np(pthread_self(), buffer, sizeof(buffer));
+        name = buffer;
+    });
+    thread.join();
+
+    EXPECT_THAT(name, Eq("sdbus-event-loo"));
+}
+
+TEST_F(AThreadCreationPolicy, PinsThreadToGivenCpus)
+{
+    // Pick a CPU we are allowed to run on
+    cpu_set_t cpus;
+    pthread_getaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    unsigned int cpu{};
+    while (!CPU_ISSET(cpu, &cpus))
+        ++cpu;
+    sdbus::setThreadCreationPolicy([cpu](ThreadRole){ return ThreadAttributes{{}, {cpu}, {}, 0}; });
+
+    auto thread = startThread(ThreadRole::EventLoop, [&](){ pthread_getaffinity_np(pthread_self(), sizeof(cpus), &cpus); });
+    thread.join();
+
+    EXPECT_THAT(CPU_COUNT(&cpus), Eq(1));
+    EXPECT_TRUE(CPU_ISSET(cpu, &cpus));
+}
+
+TEST_F(AThreadCreationPolicy, ThrowsAndDoesNotRunThreadFunctionWhenAttributesCannotBeApplied)
+{
+    sdbus::setThreadCreationPolicy([](ThreadRole){ return ThreadAttributes{{}, {}, SCHED_FIFO, 1000}; });
+    bool ran{};
+
+    ASSERT_THROW(startThread(ThreadRole::EventLoop, [&](){ ran = true; }), sdbus::Error);
+    EXPECT_FALSE(ran);
+}
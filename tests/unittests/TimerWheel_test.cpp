@@ -0,0 +1,157 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file TimerWheel_test.cpp
+ *
+ * Created on: Oct 14, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TimerWheel.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <vector>
+
+using ::testing::Eq;
+using ::testing::ElementsAre;
+using ::testing::IsNull;
+using ::sdbus::internal::TimerWheel;
+using namespace std::chrono_literals;
+
+namespace {
+std::vector<TimerWheel::Timer*> popAllExpired(TimerWheel& wheel)
+{
+    std::vector<TimerWheel::Timer*> expired;
+    while (auto* timer = wheel.popExpired())
+        expired.push_back(timer);
+    return expired;
+}
+}
+
+/*-------------------------------------*/
+/* --          TEST CASES           -- */
+/*-------------------------------------*/
+
+TEST(ATimerWheel, IsEmptyAfterConstruction)
+{
+    TimerWheel wheel{1s};
+
+    EXPECT_THAT(wheel.size(), Eq(0));
+    EXPECT_THAT(wheel.nextDeadline(), Eq(std::chrono::nanoseconds::max()));
+    EXPECT_THAT(wheel.popExpired(), IsNull());
+}
+
+TEST(ATimerWheel, DoesNotExpireTimerBeforeItsDeadline)
+{
+    TimerWheel wheel{1s};
+    TimerWheel::Timer timer;
+    wheel.schedule(timer, 1s + 10ms + 500us);
+
+    wheel.advance(1s + 10ms);
+
+    EXPECT_THAT(wheel.popExpired(), IsNull());
+    EXPECT_TRUE(timer.isScheduled());
+    EXPECT_THAT(wheel.nextDeadline(), Eq(1s + 11ms));
+}
+
+TEST(ATimerWheel, ExpiresTimersInOrderOfTheirDeadlines)
+{
+    TimerWheel wheel{1s};
+    TimerWheel::Timer timer1, timer2, timer3;
+    wheel.schedule(timer3, 1s + 30ms);
+    wheel.schedule(timer1, 1s + 10ms);
+    wheel.schedule(timer2, 1s + 20ms);
+
+    wheel.advance(1s + 10ms);
+    auto expired = popAllExpired(wheel);
+    wheel.advance(1s + 30ms);
+    auto expiredLater = popAllExpired(wheel);
+
+    EXPECT_THAT(expired, ElementsAre(&timer1));
+    EXPECT_THAT(expiredLater, ElementsAre(&timer2, &timer3));
+    EXPECT_THAT(wheel.size(), Eq(0));
+    EXPECT_FALSE(timer1.isScheduled());
+}
+
+TEST(ATimerWheel, ExpiresTimerWithPassedDeadlineRightAway)
+{
+    TimerWheel wheel{1s};
+    TimerWheel::Timer timer;
+    wheel.schedule(timer, 500ms);
+
+    EXPECT_THAT(wheel.nextDeadline(), Eq(0ns));
+    EXPECT_THAT(wheel.popExpired(), Eq(&timer));
+}
+
+TEST(ATimerWheel, DoesNotExpireCancelledTimer)
+{
+    TimerWheel wheel{1s};
+    TimerWheel::Timer timer;
+    wheel.schedule(timer, 1s + 10ms);
+
+    wheel.cancel(timer);
+    wheel.advance(2s);
+
+    EXPECT_THAT(wheel.popExpired(), IsNull());
+    EXPECT_THAT(wheel.size(), Eq(0));
+    EXPECT_FALSE(timer.isScheduled());
+}
+
+TEST(ATimerWheel, ExpiresFarTimersAfterRedistributingThemFromUpperLevels)
+{
+    TimerWheel wheel{1s};
+    TimerWheel::Timer timer1, timer2, timer3;
+    wheel.schedule(timer1, 1s + 100ms);
+    wheel.schedule(timer2, 1s + 25s + 3ms);
+    wheel.schedule(timer3, 1s + 10h);
+
+    wheel.advance(1s + 25s + 2ms);
+    auto expired = popAllExpired(wheel);
+    wheel.advance(1s + 25s + 3ms);
+    auto expiredLater = popAllExpired(wheel);
+    wheel.advance(1s + 10h);
+    auto expiredLast = popAllExpired(wheel);
+
+    EXPECT_THAT(expired, ElementsAre(&timer1));
+    EXPECT_THAT(expiredLater, ElementsAre(&timer2));
+    EXPECT_THAT(expiredLast, ElementsAre(&timer3));
+}
+
+TEST(ATimerWheel, ReportsNextDeadlineNoLaterThanEarliestTimer)
+{
+    TimerWheel wheel{1s};
+    TimerWheel::Timer timer1, timer2;
+    wheel.schedule(timer1, 1s + 5s);
+    wheel.schedule(timer2, 1s + 1h);
+
+    EXPECT_THAT(wheel.nextDeadline() <= 1s + 5s, Eq(true));
+
+    // Following the reported deadlines eventually expires the earliest timer exactly at its deadline
+    while (wheel.nextDeadline() < 1s + 5s)
+    {
+        wheel.advance(wheel.nextDeadline());
+        EXPECT_THAT(wheel.popExpired(), IsNull());
+    }
+    wheel.advance(wheel.nextDeadline());
+    EXPECT_THAT(wheel.popExpired(), Eq(&timer1));
+    wheel.cancel(timer2);
+}
@@ -0,0 +1,194 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file TrafficCapture_test.cpp
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TrafficCapture.h"
+
+#include "sdbus-c++/Error.h"
+#include "sdbus-c++/Message.h"
+#include "sdbus-c++/Types.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <map>
+#include <string>
+#include <vector>
+
+using ::testing::Eq;
+using ::testing::IsEmpty;
+using ::testing::Le;
+using ::sdbus::CapturedMessage;
+using ::sdbus::TrafficCaptureReader;
+using ::sdbus::internal::TrafficRecorder;
+using namespace std::string_literals;
+
+namespace
+{
+    class TrafficCaptureFile : public ::testing::Test
+    {
+    protected:
+        void TearDown() override
+        {
+            std::filesystem::remove(path_);
+        }
+
+        const std::string path_{(std::filesystem::temp_directory_path() / "sdbus-c++-unit-test-capture.bin").string()};
+    };
+
+    CapturedMessage captureArguments(sdbus::PlainMessage& msg)
+    {
+        msg.seal();
+        CapturedMessage captured;
+        sdbus::internal::encodeCapturedArguments(msg, captured.signature, captured.body);
+        return captured;
+    }
+}
+
+/*-------------------------------------*/
+/* --          TEST CASES           -- */
+/*-------------------------------------*/
+
+TEST(ACapturedMessage, CarriesSignatureOfItsArguments)
+{
+    auto msg = sdbus::createPlainMessage();
+    msg << int32_t{1} << "a"s << std::vector<double>{} << std::map<std::string, sdbus::Variant>{{"k", sdbus::Variant{true}}};
+    msg << sdbus::Struct{sdbus::ObjectPath{"/"}, false} << sdbus::Variant{uint16_t{3}};
+
+    auto captured = captureArguments(msg);
+
+    EXPECT_THAT(captured.signature, Eq("isada{sv}(ob)v"));
+}
+
+TEST(ACapturedMessage, ReproducesArgumentsOfTheOriginalMessage)
+{
+    const std::vector<double> samples{1.5, -2.25, 1e10};
+    const std::map<std::string, sdbus::Variant> properties{{"name", sdbus::Variant{"device"s}}, {"ratio", sdbus::Variant{0.5}}};
+    const std::vector<sdbus::Struct<uint8_t, std::string>> entries{{1, "one"}, {2, "two"}};
+    auto msg = sdbus::createPlainMessage();
+    msg << int32_t{-42} << "Hello"s << samples << properties << entries;
+    msg << sdbus::Struct{sdbus::ObjectPath{"/org/sdbuscpp/device"}, true, sdbus::Signature{"a{sv}"}};
+    msg << std::vector<bool>{true, false} << std::vector<std::string>{};
+    auto captured = captureArguments(msg);
+
+    auto replayed = sdbus::createPlainMessage();
+    sdbus::appendCapturedArguments(replayed, captured);
+    replayed.seal();
+
+    int32_t i{};
+    std::string s;
+    std::vector<double> ad;
+    std::map<std::string, sdbus::Variant> asv;
+    std::vector<sdbus::Struct<uint8_t, std::string>> ays;
+    sdbus::Struct<sdbus::ObjectPath, bool, sdbus::Signature> obg;
+    std::vector<bool> ab;
+    std::vector<std::string> as;
+    replayed >> i >> s >> ad >> asv >> ays >> obg >> ab >> as;
+    ASSERT_TRUE(replayed);
+    EXPECT_THAT(i, Eq(-42));
+    EXPECT_THAT(s, Eq("Hello"));
+    EXPECT_THAT(ad, Eq(samples));
+    EXPECT_THAT(asv.at("name").get<std::string>(), Eq("device"));
+    EXPECT_THAT(asv.at("ratio").get<double>(), Eq(0.5));
+    EXPECT_THAT(ays, Eq(entries));
+    EXPECT_THAT(std::get<0>(obg), Eq("/org/sdbuscpp/device"));
+    EXPECT_TRUE(std::get<1>(obg));
+    EXPECT_THAT(std::get<2>(obg), Eq("a{sv}"));
+    EXPECT_THAT(ab, Eq(std::vector<bool>{true, false}));
+    EXPECT_THAT(as, IsEmpty());
+}
+
+TEST(ACapturedMessage, ThrowsWhenItsBodyDoesNotMatchItsSignature)
+{
+    CapturedMessage captured{.signature = "u", .body = "\x01\x02"s};
+    auto msg = sdbus::createPlainMessage();
+
+    ASSERT_THROW(sdbus::appendCapturedArguments(msg, captured), sdbus::Error);
+}
+
+TEST_F(TrafficCaptureFile, ReadsBackRecordedMessagesInOrder)
+{
+    {
+        TrafficRecorder recorder{path_};
+        auto first = sdbus::createPlainMessage();
+        first << uint64_t{7} << "first"s;
+        first.seal();
+        auto second = sdbus::createPlainMessage();
+        second.seal();
+        recorder.record(first, CapturedMessage::Type::MethodCall);
+        recorder.record(second, CapturedMessage::Type::Signal);
+
+        uint64_t u{}; // The recorded message is left rewound for the dispatch
+        first >> u;
+        EXPECT_THAT(u, Eq(7));
+    }
+
+    TrafficCaptureReader reader{path_};
+    auto first = reader.next();
+    auto second = reader.next();
+
+    ASSERT_TRUE(first.has_value());
+    EXPECT_THAT(first->type, Eq(CapturedMessage::Type::MethodCall));
+    EXPECT_THAT(first->signature, Eq("ts"));
+    ASSERT_TRUE(second.has_value());
+    EXPECT_THAT(second->type, Eq(CapturedMessage::Type::Signal));
+    EXPECT_THAT(second->signature, IsEmpty());
+    EXPECT_THAT(first->timestamp, Le(second->timestamp));
+    EXPECT_FALSE(reader.next().has_value());
+
+    auto replayed = sdbus::createPlainMessage();
+    sdbus::appendCapturedArguments(replayed, *first);
+    replayed.seal();
+    uint64_t u{};
+    std::string s;
+    replayed >> u >> s;
+    EXPECT_THAT(u, Eq(7));
+    EXPECT_THAT(s, Eq("first"));
+}
+
+TEST_F(TrafficCaptureFile, EndsAtRecordTruncatedByInterruptedCapture)
+{
+    {
+        TrafficRecorder recorder{path_};
+        auto msg = sdbus::createPlainMessage();
+        msg << "truncated"s;
+        msg.seal();
+        recorder.record(msg, CapturedMessage::Type::MethodCall);
+    }
+    std::filesystem::resize_file(path_, std::filesystem::file_size(path_) - 1);
+
+    TrafficCaptureReader reader{path_};
+
+    EXPECT_FALSE(reader.next().has_value());
+}
+
+TEST_F(TrafficCaptureFile, IsRejectedByReaderWhenNotCapture)
+{
+    std::ofstream{path_} << "Definitely not a traffic capture";
+
+    ASSERT_THROW(TrafficCaptureReader{path_}, sdbus::Error);
+}
@@ -29,9 +29,29 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
 #include <type_traits>
+#include <vector>
 
 using ::testing::Eq;
+using ::testing::IsNull;
+using ::testing::IsEmpty;
+using namespace std::string_literals;
+
+namespace reuse {
+    struct Record
+    {
+        int32_t id;
+        std::string name;
+        std::vector<double> values;
+        std::map<std::string, int32_t> counts;
+    };
+}
+
+SDBUSCPP_REGISTER_STRUCT(reuse::Record, id, name, values, counts);
 
 namespace
 {
@@ -94,8 +114,11 @@ namespace
     TYPE(sdbus::Variant)HAS_DBUS_TYPE_SIGNATURE("v")
     TYPE(std::variant<int16_t, std::string>)HAS_DBUS_TYPE_SIGNATURE("v")
     TYPE(sdbus::UnixFd)HAS_DBUS_TYPE_SIGNATURE("h")
+    TYPE(sdbus::SharedUnixFd)HAS_DBUS_TYPE_SIGNATURE("h")
     TYPE(sdbus::Struct<bool>)HAS_DBUS_TYPE_SIGNATURE("(b)")
     TYPE(sdbus::Struct<uint16_t, double, std::string, sdbus::Variant>)HAS_DBUS_TYPE_SIGNATURE("(qdsv)")
+    TYPE(sdbus::Columns<uint64_t, double, double>)HAS_DBUS_TYPE_SIGNATURE("(atadad)")
+    TYPE(sdbus::ColumnsView<int32_t, uint8_t>)HAS_DBUS_TYPE_SIGNATURE("(aiay)")
     TYPE(std::vector<int16_t>)HAS_DBUS_TYPE_SIGNATURE("an")
     TYPE(std::array<int16_t, 3>)HAS_DBUS_TYPE_SIGNATURE("an")
 #ifdef __cpp_lib_span
@@ -152,8 +175,11 @@ namespace
                             , sdbus::Variant
                             , std::variant<int16_t, std::string>
                             , sdbus::UnixFd
+                            , sdbus::SharedUnixFd
                             , sdbus::Struct<bool>
                             , sdbus::Struct<uint16_t, double, std::string, sdbus::Variant>
+                            , sdbus::Columns<uint64_t, double, double>
+                            , sdbus::ColumnsView<int32_t, uint8_t>
                             , std::vector<int16_t>
                             , std::array<int16_t, 3>
 #ifdef __cpp_lib_span
@@ -183,6 +209,75 @@ TYPED_TEST(Type2DBusTypeSignatureConversion, ConvertsTypeToProperDBusSignature)
     ASSERT_THAT(signature.data(), Eq(this->dbusTypeSignature_));
 }
 
+namespace
+{
+    template <typename _Element>
+    struct SomeInlineVector { using value_type = _Element; };
+
+    template <typename _Key, typename _Value>
+    struct SomeFlatMap { using key_type = _Key; using mapped_type = _Value; };
+}
+
+template <typename _Element>
+constexpr bool sdbus::dbus_array_container_v<SomeInlineVector<_Element>> = true;
+template <typename _Key, typename _Value>
+constexpr bool sdbus::dbus_dictionary_container_v<SomeFlatMap<_Key, _Value>> = true;
+
+TEST(AContainerTypeTrait, GivesUserDefinedContainersSignaturesOfArraysAndDictionaries)
+{
+    ASSERT_THAT(sdbus::as_null_terminated(sdbus::signature_of_v<SomeInlineVector<int16_t>>).data(), Eq("an"s));
+    ASSERT_THAT(sdbus::as_null_terminated(sdbus::signature_of_v<SomeInlineVector<std::string>>).data(), Eq("as"s));
+    ASSERT_THAT(sdbus::as_null_terminated(sdbus::signature_of_v<SomeFlatMap<int32_t, sdbus::Variant>>).data(), Eq("a{iv}"s));
+    ASSERT_THAT(sdbus::as_null_terminated(sdbus::signature_of_v<std::vector<SomeFlatMap<std::string, SomeInlineVector<double>>>>).data(), Eq("aa{sad}"s));
+}
+
+TEST(AStructTypeTrait, DetectsStructsOfFixedSizeBasicTypes)
+{
+    static_assert(sdbus::is_trivial_dbus_struct_v<sdbus::Struct<int32_t, double, uint64_t>>, "Struct of fixed-size basic types not detected as trivial");
+    static_assert(sdbus::is_trivial_dbus_struct_v<sdbus::Struct<const uint8_t&, int16_t&>>, "Struct of references to fixed-size basic types not detected as trivial");
+    static_assert(!sdbus::is_trivial_dbus_struct_v<sdbus::Struct<int32_t, bool>>, "Struct with a bool incorrectly detected as trivial");
+    static_assert(!sdbus::is_trivial_dbus_struct_v<sdbus::Struct<int32_t, std::string>>, "Struct with a string incorrectly detected as trivial");
+    static_assert(!sdbus::is_trivial_dbus_struct_v<sdbus::Struct<int32_t, sdbus::Struct<double>>>, "Struct with a nested struct incorrectly detected as trivial");
+    static_assert(!sdbus::is_trivial_dbus_struct_v<std::tuple<int32_t, double>>, "Tuple incorrectly detected as trivial struct");
+}
+
+TEST(ClearForReuse, ClearsContainersKeepingTheirCapacity)
+{
+    std::vector<double> values(100, 3.14);
+    const auto capacity = values.capacity();
+
+    sdbus::detail::clear_for_reuse(values);
+
+    ASSERT_THAT(values, IsEmpty());
+    ASSERT_THAT(values.capacity(), Eq(capacity));
+}
+
+TEST(ClearForReuse, ClearsStructsAndTuplesFieldByField)
+{
+    auto values = std::make_tuple(7, "seven"s, sdbus::make_struct(std::vector<int16_t>{1, 2}, 7.0));
+
+    sdbus::detail::clear_for_reuse(values);
+
+    ASSERT_THAT(std::get<0>(values), Eq(0));
+    ASSERT_THAT(std::get<1>(values), IsEmpty());
+    ASSERT_THAT(std::get<0>(std::get<2>(values)), IsEmpty());
+    ASSERT_THAT(std::get<1>(std::get<2>(values)), Eq(0.0));
+}
+
+TEST(ClearForReuse, ClearsRegisteredStructsMemberByMemberKeepingCapacityOfTheirContainers)
+{
+    reuse::Record record{7, "seven", std::vector<double>(100, 3.14), {{"key", 1}}};
+    const auto capacity = record.values.capacity();
+
+    sdbus::detail::clear_for_reuse(record);
+
+    ASSERT_THAT(record.id, Eq(0));
+    ASSERT_THAT(record.name, IsEmpty());
+    ASSERT_THAT(record.values, IsEmpty());
+    ASSERT_THAT(record.values.capacity(), Eq(capacity));
+    ASSERT_THAT(record.counts, IsEmpty());
+}
+
 TEST(FreeFunctionTypeTraits, DetectsTraitsOfTrivialSignatureFunction)
 {
     void f();
@@ -221,3 +316,66 @@ TEST(FreeFunctionTypeTraits, DetectsTraitsOfAsyncFunction)
     static_assert(sdbus::function_argument_count_v<Fnc> == 3, "Incorrectly detected free function parameter count");
     static_assert(std::is_same<sdbus::function_result_t<Fnc>, std::tuple<char, int>>::value, "Incorrectly detected free function return type");
 }
+
+namespace
+{
+    struct CopyCounter
+    {
+        CopyCounter() = default;
+        CopyCounter(const CopyCounter& other) : copies(other.copies + 1) {}
+        CopyCounter(CopyCounter&& other) noexcept : copies(other.copies) {}
+        CopyCounter& operator=(const CopyCounter&) = delete;
+        CopyCounter& operator=(CopyCounter&&) = delete;
+        int copies{};
+    };
+}
+
+TEST(ApplyMoving, MovesTupleValuesIntoByValueParameters)
+{
+    std::tuple<CopyCounter, std::string> args{CopyCounter{}, std::string(100, 'x')};
+
+    auto result = sdbus::apply_moving([](CopyCounter counter, std::string str){ return std::tuple{counter.copies, str.size()}; }, args);
+
+    ASSERT_THAT(std::get<0>(result), Eq(0));
+    ASSERT_THAT(std::get<1>(result), Eq(100));
+}
+
+TEST(ApplyMoving, MovesTupleValuesIntoMoveOnlyParameters)
+{
+    std::tuple<std::unique_ptr<int>> args{std::make_unique<int>(42)};
+
+    auto result = sdbus::apply_moving([](std::unique_ptr<int> ptr){ return *ptr; }, args);
+
+    ASSERT_THAT(result, Eq(42));
+    ASSERT_THAT(std::get<0>(args), IsNull());
+}
+
+TEST(ApplyMoving, DoesNotCopyTupleValuesIntoConstReferenceParameters)
+{
+    std::tuple<CopyCounter> args;
+
+    auto result = sdbus::apply_moving([](const CopyCounter& counter){ return counter.copies; }, args);
+
+    ASSERT_THAT(result, Eq(0));
+}
+
+TEST(ApplyMoving, PassesTupleValuesAsLvaluesToFunctionTakingNonConstReferenceParameters)
+{
+    std::tuple<CopyCounter, int> args;
+
+    auto result = sdbus::apply_moving([](CopyCounter counter, int& value){ value = 42; return counter.copies; }, args);
+
+    ASSERT_THAT(result, Eq(1));
+    ASSERT_THAT(std::get<1>(args), Eq(42));
+}
+
+TEST(ApplyMoving, ReturnsEmptyTupleForVoidFunction)
+{
+    std::tuple<std::string> args{"hello"};
+    std::string received;
+
+    auto result = sdbus::apply_moving([&](std::string str){ received = std::move(str); }, args);
+
+    static_assert(std::is_same_v<decltype(result), std::tuple<>>, "Void function shall give an empty tuple");
+    ASSERT_THAT(received, Eq("hello"));
+}
@@ -28,17 +28,30 @@
 #include "MessageUtils.h"
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <optional>
+#include <span>
+#include <sys/mman.h>
 #include <sys/eventfd.h>
+#include <vector>
 
 using ::testing::Eq;
+using ::testing::Ge;
 using ::testing::Gt;
+using ::testing::Ne;
+using ::testing::StrEq;
 using namespace std::string_literals;
 
 namespace
 {
     constexpr const uint64_t ANY_UINT64 = 84578348354;
     constexpr const double ANY_DOUBLE = 3.14;
+
+    template <typename... _Callables>
+    struct overloaded : _Callables... { using _Callables::operator()...; };
 }
 
 /*-------------------------------------*/
@@ -143,6 +156,49 @@ TEST(AVariant, ReturnsTrueWhenAskedIfItContainsTheTypeItReallyContains)
     ASSERT_TRUE(variant.containsValueOfType<ComplexType>());
 }
 
+TEST(AVariant, TellsContainedTypeApartFromTypesWithSimilarSignatures)
+{
+    sdbus::Variant variant(std::vector<std::string>{"hello"s});
+
+    ASSERT_TRUE(variant.containsValueOfType<std::vector<std::string>>());
+    ASSERT_FALSE(variant.containsValueOfType<std::string>());
+    ASSERT_FALSE(variant.containsValueOfType<std::vector<sdbus::ObjectPath>>());
+    ASSERT_FALSE((variant.containsValueOfType<std::map<std::string, std::vector<std::string>>>()));
+}
+
+TEST(AVariant, DecodesCachedValueOnlyOnce)
+{
+    std::map<std::string, int32_t> value{{"hello"s, 1}, {"world"s, 2}};
+    sdbus::Variant variant(value);
+
+    const auto& firstRead = variant.getCached<std::map<std::string, int32_t>>();
+    const auto& secondRead = variant.getCached<std::map<std::string, int32_t>>();
+
+    ASSERT_THAT(firstRead, Eq(value));
+    ASSERT_THAT(&secondRead, Eq(&firstRead));
+}
+
+TEST(AVariant, InvokesVisitorWithValueOfContainedType)
+{
+    sdbus::Variant variant(std::vector<std::string>{"hello"s, "world"s});
+
+    std::size_t visitedSize{};
+    auto visited = variant.visit<int32_t, std::vector<std::string>>(overloaded{ [](int32_t){ FAIL(); }
+                                                                              , [&](const std::vector<std::string>& v){ visitedSize = v.size(); } });
+
+    ASSERT_TRUE(visited);
+    ASSERT_THAT(visitedSize, Eq(2));
+}
+
+TEST(AVariant, DoesNotInvokeVisitorIfItContainsNoneOfTheGivenTypes)
+{
+    sdbus::Variant variant(3.14);
+
+    auto visited = variant.visit<int32_t, std::string>([](const auto&){ FAIL(); });
+
+    ASSERT_FALSE(visited);
+}
+
 TEST(AVariant, CanBeConvertedIntoAnStdVariant)
 {
     using ComplexType = std::vector<sdbus::Struct<std::string, double>>;
@@ -176,6 +232,42 @@ TEST(ASimpleVariant, ReturnsFalseWhenAskedIfItContainsTypeItDoesntReallyContain)
     ASSERT_FALSE(variant.containsValueOfType<double>());
 }
 
+TEST(ASimpleVariant, ThrowsWhenAskedForValueOfTypeItDoesntReallyContain)
+{
+    sdbus::Variant variant(5);
+
+    ASSERT_THROW(variant.get<double>(), sdbus::Error);
+}
+
+TEST(ASimpleVariant, CanBeConvertedIntoAnStdVariant)
+{
+    using StdVariantType = std::variant<std::string, uint64_t, double>;
+    sdbus::Variant sdbusVariant{ANY_UINT64};
+    StdVariantType stdVariant{sdbusVariant};
+
+    ASSERT_TRUE(std::holds_alternative<uint64_t>(stdVariant));
+    ASSERT_THAT(std::get<uint64_t>(stdVariant), Eq(ANY_UINT64));
+}
+
+TEST(ASimpleVariant, SerializesToAndDeserializesFromAMessageSuccessfully)
+{
+    sdbus::Variant variant1(ANY_DOUBLE);
+    sdbus::Variant variant2(true);
+
+    auto msg = sdbus::createPlainMessage();
+    variant1.serializeTo(msg);
+    variant2.serializeTo(msg);
+    msg.seal();
+    sdbus::Variant receivedVariant1, receivedVariant2;
+    receivedVariant1.deserializeFrom(msg);
+    receivedVariant2.deserializeFrom(msg);
+
+    ASSERT_TRUE(receivedVariant1.containsValueOfType<double>());
+    ASSERT_THAT(receivedVariant1.get<double>(), Eq(ANY_DOUBLE));
+    ASSERT_TRUE(receivedVariant2.containsValueOfType<bool>());
+    ASSERT_TRUE(receivedVariant2.get<bool>());
+}
+
 TEST(AVariant, CanContainOtherEmbeddedVariants)
 {
     using TypeWithVariants = std::vector<sdbus::Struct<sdbus::Variant, double>>;
@@ -324,6 +416,86 @@ TEST(ASignature, CanBeMovedLikeAStdString)
     ASSERT_THAT(sdbus::Signature{std::move(oSignature)}, Eq(sdbus::Signature(std::move(aSignature))));
 }
 
+TEST(ANameView, IsConstexprConstructibleFromValidNameLiteral)
+{
+    static constexpr sdbus::ObjectPathView path{"/org/sdbuscpp/object_1"};
+    static constexpr sdbus::InterfaceNameView interface{"org.sdbuscpp.Interface"};
+    static constexpr sdbus::MemberNameView member{"doSomething"};
+
+    ASSERT_THAT(path.view(), Eq("/org/sdbuscpp/object_1"));
+    ASSERT_THAT(interface.size(), Eq(22));
+    ASSERT_THAT(std::strlen(member.c_str()), Eq(member.size()));
+}
+
+TEST(ANameView, ValidatesNamesAtCompileTime)
+{
+    static_assert(sdbus::detail::isValidObjectPath("/"));
+    static_assert(sdbus::detail::isValidObjectPath("/a/b_2/3"));
+    static_assert(!sdbus::detail::isValidObjectPath("a/b"));
+    static_assert(!sdbus::detail::isValidObjectPath("/a//b"));
+    static_assert(!sdbus::detail::isValidObjectPath("/a/"));
+    static_assert(sdbus::detail::isValidInterfaceName("org.sdbuscpp.Interface"));
+    static_assert(!sdbus::detail::isValidInterfaceName("org"));
+    static_assert(!sdbus::detail::isValidInterfaceName("org.2sdbuscpp"));
+    static_assert(sdbus::detail::isValidBusName(":1.42"));
+    static_assert(sdbus::detail::isValidBusName("org.sdbus-cpp.service"));
+    static_assert(!sdbus::detail::isValidBusName("org..service"));
+    static_assert(sdbus::detail::isValidMemberName("Get_All2"));
+    static_assert(!sdbus::detail::isValidMemberName("Get.All"));
+    static_assert(!sdbus::detail::isValidMemberName("2GetAll"));
+    static_assert(sdbus::detail::isValidSignature("a{sv}(ii)"));
+    static_assert(!sdbus::detail::isValidSignature("z"));
+}
+
+TEST(ANameView, ValidatesSignaturesAgainstTheTypeGrammar)
+{
+    static_assert(sdbus::detail::isValidSignature(""));
+    static_assert(sdbus::detail::isValidSignature("aa{sa(iv)}a{oa{sv}}"));
+    static_assert(sdbus::detail::isValidSignature("((((y))))"));
+    static_assert(!sdbus::detail::isValidSignature("a"));
+    static_assert(!sdbus::detail::isValidSignature("()"));
+    static_assert(!sdbus::detail::isValidSignature("(ii"));
+    static_assert(!sdbus::detail::isValidSignature("ii)"));
+    static_assert(!sdbus::detail::isValidSignature("{sv}"));
+    static_assert(!sdbus::detail::isValidSignature("a{vs}"));
+    static_assert(!sdbus::detail::isValidSignature("a{s}"));
+    static_assert(!sdbus::detail::isValidSignature("a{sii}"));
+    static_assert(!sdbus::detail::isValidSignature("aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaay")); // 33 nested arrays
+    static_assert(sdbus::detail::isValidSignature("aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaay"));
+}
+
+TEST(ANameView, ComparesByContents)
+{
+    const sdbus::InterfaceName name{"org.sdbuscpp.Interface"};
+    const sdbus::InterfaceNameView view{name};
+    const std::string otherCopy{"org.sdbuscpp.Interface"};
+
+    ASSERT_TRUE(view == "org.sdbuscpp.Interface");
+    ASSERT_TRUE(view == otherCopy);
+    ASSERT_TRUE(view == sdbus::InterfaceNameView{"org.sdbuscpp.Interface"});
+    ASSERT_FALSE(view == "org.sdbuscpp.Other");
+}
+
+TEST(ANameView, ConvertsToOwningNameAndCString)
+{
+    const sdbus::ObjectPathView view{"/org/sdbuscpp/object"};
+
+    const char* cString = view;
+    ASSERT_THAT(sdbus::ObjectPath{view}, Eq("/org/sdbuscpp/object"));
+    ASSERT_THAT(cString, StrEq("/org/sdbuscpp/object"));
+}
+
+TEST(AnInternedName, SharesStorageWithEqualNames)
+{
+    auto interned1 = sdbus::intern(sdbus::InterfaceName{"org.sdbuscpp.Interned"});
+    auto interned2 = sdbus::intern(sdbus::InterfaceName{std::string{"org.sdbuscpp."} + "Interned"});
+    auto interned3 = sdbus::intern(sdbus::InterfaceName{"org.sdbuscpp.Other"});
+
+    ASSERT_THAT(interned1.c_str(), Eq(interned2.c_str()));
+    ASSERT_THAT(interned1.c_str(), ::testing::Ne(interned3.c_str()));
+    ASSERT_TRUE(interned1 == "org.sdbuscpp.Interned");
+}
+
 TEST(AUnixFd, DuplicatesAndOwnsFdUponStandardConstruction)
 {
     auto fd = ::eventfd(0, EFD_SEMAPHORE | EFD_NONBLOCK);
@@ -425,6 +597,114 @@ TEST(AUnixFd, TakesOverNewFdAndClosesOriginalFdOnAdoptingReset)
     EXPECT_THAT(::close(fd), Eq(-1));
 }
 
+TEST(ASharedUnixFd, SharesFdAmongCopiesWithoutDuplicatingIt)
+{
+    sdbus::SharedUnixFd sharedFd(::eventfd(0, EFD_SEMAPHORE | EFD_NONBLOCK), sdbus::adopt_fd);
+
+    sdbus::SharedUnixFd sharedFdCopy{sharedFd};
+    std::vector<sdbus::SharedUnixFd> sharedFds(3, sharedFdCopy);
+
+    EXPECT_THAT(sharedFdCopy.get(), Eq(sharedFd.get()));
+    EXPECT_THAT(sharedFds.back().get(), Eq(sharedFd.get()));
+}
+
+TEST(ASharedUnixFd, ClosesFdUponDestructionOfTheLastCopy)
+{
+    auto fd = ::eventfd(0, EFD_SEMAPHORE | EFD_NONBLOCK);
+    std::optional<sdbus::SharedUnixFd> sharedFd{sdbus::SharedUnixFd{fd, sdbus::adopt_fd}};
+    auto sharedFdCopy = *sharedFd;
+
+    sharedFd.reset();
+    EXPECT_THAT(::fcntl(fd, F_GETFD), Ge(0));
+    sharedFdCopy.reset();
+
+    EXPECT_FALSE(sharedFdCopy.isValid());
+    EXPECT_THAT(::close(fd), Eq(-1));
+}
+
+TEST(ASharedUnixFd, DuplicatesFdIntoAnOwningUnixFdOnRequest)
+{
+    sdbus::SharedUnixFd sharedFd(::eventfd(0, EFD_SEMAPHORE | EFD_NONBLOCK), sdbus::adopt_fd);
+
+    auto unixFd = sharedFd.duplicate();
+
+    EXPECT_THAT(unixFd.get(), Ne(sharedFd.get()));
+    EXPECT_TRUE(unixFd.isValid());
+}
+
+TEST(ASharedBuffer, HoldsCopyOfTheDataItWasCreatedFrom)
+{
+    const std::string payload{"Hello shared world"};
+    auto bytes = std::as_bytes(std::span{payload});
+
+    sdbus::SharedBuffer buffer{bytes};
+
+    ASSERT_TRUE(buffer.isValid());
+    ASSERT_THAT(buffer.size(), Eq(payload.size()));
+    EXPECT_THAT(std::memcmp(buffer.data().data(), payload.data(), payload.size()), Eq(0));
+}
+
+TEST(ASharedBuffer, IsFilledInPlaceByTheFillFunction)
+{
+    sdbus::SharedBuffer buffer{4, [](std::span<std::byte> data){ std::fill(data.begin(), data.end(), std::byte{0x2A}); }};
+
+    ASSERT_THAT(buffer.size(), Eq(4u));
+    for (auto byte : buffer.data())
+        EXPECT_THAT(byte, Eq(std::byte{0x2A}));
+}
+
+TEST(ASharedBuffer, SealsItsMemfdAgainstModifications)
+{
+    sdbus::SharedBuffer buffer{16, [](std::span<std::byte>){}};
+
+    auto seals = ::fcntl(buffer.getFd().get(), F_GET_SEALS);
+
+    EXPECT_TRUE(seals & F_SEAL_WRITE);
+    EXPECT_TRUE(seals & F_SEAL_SHRINK);
+    EXPECT_TRUE(seals & F_SEAL_GROW);
+}
+
+TEST(ASharedBuffer, CanBeCreatedUponASealedMemfdOfAnotherBuffer)
+{
+    const std::string payload{"payload"};
+    sdbus::SharedBuffer buffer{std::as_bytes(std::span{payload})};
+
+    sdbus::SharedBuffer received{buffer.getFd(), buffer.size()};
+
+    ASSERT_THAT(received.size(), Eq(payload.size()));
+    EXPECT_THAT(std::memcmp(received.data().data(), payload.data(), payload.size()), Eq(0));
+}
+
+TEST(ASharedBuffer, ThrowsWhenCreatedUponAnUnsealedMemfd)
+{
+    sdbus::UnixFd fd{::memfd_create("unsealed", MFD_CLOEXEC | MFD_ALLOW_SEALING), sdbus::adopt_fd};
+    ASSERT_THAT(::ftruncate(fd.get(), 8), Eq(0));
+
+    EXPECT_THROW(sdbus::SharedBuffer(fd, 8), sdbus::Error);
+}
+
+TEST(ASharedBuffer, ThrowsWhenAnnouncedSizeExceedsTheMemfd)
+{
+    sdbus::SharedBuffer buffer{8, [](std::span<std::byte>){}};
+
+    EXPECT_THROW(sdbus::SharedBuffer(buffer.getFd(), 16), sdbus::Error);
+}
+
+TEST(ASharedBuffer, SerializesToAndDeserializesFromAMessageSuccessfully)
+{
+    const std::string payload{"bulk payload"};
+    sdbus::SharedBuffer buffer{std::as_bytes(std::span{payload})};
+    auto msg = sdbus::createPlainMessage();
+
+    msg << buffer;
+    msg.seal();
+    sdbus::SharedBuffer deserialized;
+    msg >> deserialized;
+
+    ASSERT_THAT(deserialized.size(), Eq(payload.size()));
+    EXPECT_THAT(std::memcmp(deserialized.data().data(), payload.data(), payload.size()), Eq(0));
+}
+
 TEST(AnError, CanBeConstructedFromANameAndAMessage)
 {
     auto error = sdbus::Error(sdbus::Error::Name{"org.sdbuscpp.error"}, "message");
@@ -0,0 +1,104 @@
+/**
+ * (C) 2016 - 2021 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ * (C) 2016 - 2024 Stanislav Angelovic <stanislav.angelovic@protonmail.com>
+ *
+ * @file Utf8Validation_test.cpp
+ *
+ * Created on: Oct 15, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Utf8Validation.h"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+
+using ::sdbus::internal::isValidUtf8String;
+using namespace std::string_literals;
+
+/*-------------------------------------*/
+/* --          TEST CASES           -- */
+/*-------------------------------------*/
+
+TEST(AUtf8Validation, AcceptsEmptyString)
+{
+    EXPECT_TRUE(isValidUtf8String(""));
+}
+
+TEST(AUtf8Validation, AcceptsPlainAsciiStringsOfAnyLength)
+{
+    for (std::size_t length = 1; length <= 100; ++length)
+        EXPECT_TRUE(isValidUtf8String(std::string(length, 'x'))) << "length " << length;
+}
+
+TEST(AUtf8Validation, AcceptsMultiByteSequences)
+{
+    EXPECT_TRUE(isValidUtf8String("\xC3\xA9"));             // U+00E9
+    EXPECT_TRUE(isValidUtf8String("\xE2\x82\xAC"));         // U+20AC
+    EXPECT_TRUE(isValidUtf8String("\xF0\x9F\x98\x80"));     // U+1F600
+    EXPECT_TRUE(isValidUtf8String("\xF4\x8F\xBF\xBD"));     // U+10FFFD
+}
+
+TEST(AUtf8Validation, AcceptsMultiByteSequencesAtAnyPositionInLongString)
+{
+    for (std::size_t position = 0; position <= 70; ++position)
+    {
+        auto str = std::string(position, 'x') + "\xF0\x9F\x98\x80" + std::string(70 - position, 'x');
+        EXPECT_TRUE(isValidUtf8String(str)) << "position " << position;
+    }
+}
+
+TEST(AUtf8Validation, RejectsEmbeddedNulCharacter)
+{
+    EXPECT_FALSE(isValidUtf8String("abc\0def"s));
+    EXPECT_FALSE(isValidUtf8String(std::string(40, 'x') + '\0' + std::string(40, 'x')));
+}
+
+TEST(AUtf8Validation, RejectsMalformedSequences)
+{
+    EXPECT_FALSE(isValidUtf8String("\x80"));                // Stray continuation byte
+    EXPECT_FALSE(isValidUtf8String("\xC3"));                // Truncated sequence
+    EXPECT_FALSE(isValidUtf8String("\xE2\x82x"));           // Missing continuation byte
+    EXPECT_FALSE(isValidUtf8String("\xF8\x88\x80\x80\x80")); // Five-byte form
+}
+
+TEST(AUtf8Validation, RejectsCodePointsDisallowedBySdBus)
+{
+    EXPECT_FALSE(isValidUtf8String("\xC0\x80"));            // Overlong NUL
+    EXPECT_FALSE(isValidUtf8String("\xE0\x80\xAF"));        // Overlong '/'
+    EXPECT_FALSE(isValidUtf8String("\xED\xA0\x80"));        // Surrogate U+D800
+    EXPECT_FALSE(isValidUtf8String("\xEF\xB7\x90"));        // Noncharacter U+FDD0
+    EXPECT_FALSE(isValidUtf8String("\xEF\xBF\xBE"));        // Noncharacter U+FFFE
+    EXPECT_FALSE(isValidUtf8String("\xF4\x90\x80\x80"));    // Beyond U+10FFFF
+}
+
+TEST(AUtf8Validation, RejectsInvalidSequenceAtAnyPositionInLongString)
+{
+    for (std::size_t position = 0; position <= 70; ++position)
+    {
+        auto str = std::string(position, 'x') + "\xE2\x82" + std::string(70 - position, 'x');
+        EXPECT_FALSE(isValidUtf8String(str)) << "position " << position;
+    }
+}
+
+TEST(AUtf8Validation, RejectsSequenceTruncatedByEndOfString)
+{
+    EXPECT_FALSE(isValidUtf8String(std::string(31, 'x') + "\xF0\x9F\x98"));
+}
@@ -37,10 +37,14 @@ class SdBusMock : public sdbus::internal::ISdBus
 public:
     MOCK_METHOD1(sd_bus_message_ref, sd_bus_message*(sd_bus_message *m));
     MOCK_METHOD1(sd_bus_message_unref, sd_bus_message*(sd_bus_message *m));
+    MOCK_METHOD2(sd_bus_message_ref_many, void(sd_bus_message **m, std::size_t count));
 
     MOCK_METHOD3(sd_bus_send, int(sd_bus *bus, sd_bus_message *m, uint64_t *cookie));
+    MOCK_METHOD3(sd_bus_send_many, int(sd_bus *bus, sd_bus_message **m, std::size_t count));
     MOCK_METHOD5(sd_bus_call, int(sd_bus *bus, sd_bus_message *m, uint64_t usec, sd_bus_error *ret_error, sd_bus_message **reply));
     MOCK_METHOD6(sd_bus_call_async, int(sd_bus *bus, sd_bus_slot **slot, sd_bus_message *m, sd_bus_message_handler_t callback, void *userdata, uint64_t usec));
+    MOCK_METHOD8(sd_bus_call_async_get_n_queued, int(sd_bus *bus, sd_bus_slot **slot, sd_bus_message *m, sd_bus_message_handler_t callback, void *userdata, uint64_t usec, sd_bus_message **call, uint64_t *queued));
+    MOCK_METHOD9(sd_bus_call_async_many, int(sd_bus *bus, sd_bus_slot **slots, sd_bus_message **m, sd_bus_message_handler_t callback, void **userdata, uint64_t usec, std::size_t count, sd_bus_message **calls, uint64_t *queued));
 
     MOCK_METHOD3(sd_bus_message_new, int(sd_bus *bus, sd_bus_message **m, uint8_t type));
     MOCK_METHOD6(sd_bus_message_new_method_call, int(sd_bus *bus, sd_bus_message **m, const char *destination, const char *path, const char *interface, const char *member));
@@ -56,6 +60,8 @@ public:
     MOCK_METHOD2(sd_bus_emit_object_removed, int(sd_bus *bus, const char *path));
     MOCK_METHOD3(sd_bus_emit_interfaces_added_strv, int(sd_bus *bus, const char *path, char **interfaces));
     MOCK_METHOD3(sd_bus_emit_interfaces_removed_strv, int(sd_bus *bus, const char *path, char **interfaces));
+    MOCK_METHOD7(sd_bus_add_objects, int(sd_bus *bus, const ObjectVTable *vtables, sd_bus_slot **slots, std::size_t count, const char **paths, char ***interfaces, std::size_t pathCount));
+    MOCK_METHOD5(sd_bus_remove_objects, int(sd_bus *bus, const char *const *paths, std::size_t pathCount, sd_bus_slot *const *slots, std::size_t count));
 
     MOCK_METHOD1(sd_bus_open, int(sd_bus **ret));
     MOCK_METHOD1(sd_bus_open_system, int(sd_bus **ret));
@@ -68,17 +74,26 @@ public:
     MOCK_METHOD3(sd_bus_request_name, int(sd_bus *bus, const char *name, uint64_t flags));
     MOCK_METHOD2(sd_bus_release_name, int(sd_bus *bus, const char *name));
     MOCK_METHOD2(sd_bus_get_unique_name, int(sd_bus *bus, const char **name));
+    MOCK_METHOD1(sd_bus_is_trusted, int(sd_bus *bus));
     MOCK_METHOD6(sd_bus_add_object_vtable, int(sd_bus *bus, sd_bus_slot **slot, const char *path, const char *interface, const sd_bus_vtable *vtable, void *userdata));
+    MOCK_METHOD7(sd_bus_add_fallback_vtable, int(sd_bus *bus, sd_bus_slot **slot, const char *prefix, const char *interface, const sd_bus_vtable *vtable, sd_bus_object_find_t find, void *userdata));
+    MOCK_METHOD5(sd_bus_add_node_enumerator, int(sd_bus *bus, sd_bus_slot **slot, const char *path, sd_bus_node_enumerator_t callback, void *userdata));
+    MOCK_METHOD5(sd_bus_add_fallback, int(sd_bus *bus, sd_bus_slot **slot, const char *prefix, sd_bus_message_handler_t callback, void *userdata));
     MOCK_METHOD3(sd_bus_add_object_manager, int(sd_bus *bus, sd_bus_slot **slot, const char *path));
     MOCK_METHOD5(sd_bus_add_match, int(sd_bus *bus, sd_bus_slot **slot, const char *match, sd_bus_message_handler_t callback, void *userdata));
     MOCK_METHOD6(sd_bus_add_match_async, int(sd_bus *bus, sd_bus_slot **slot, const char *match, sd_bus_message_handler_t callback, sd_bus_message_handler_t install_callback, void *userdata));
+    MOCK_METHOD4(sd_bus_add_filter, int(sd_bus *bus, sd_bus_slot **slot, sd_bus_message_handler_t callback, void *userdata));
     MOCK_METHOD8(sd_bus_match_signal, int(sd_bus *bus, sd_bus_slot **ret, const char *sender, const char *path, const char *interface, const char *member, sd_bus_message_handler_t callback, void *userdata));
+    MOCK_METHOD9(sd_bus_match_signal_async, int(sd_bus *bus, sd_bus_slot **ret, const char *sender, const char *path, const char *interface, const char *member, sd_bus_message_handler_t callback, sd_bus_message_handler_t install_callback, void *userdata));
     MOCK_METHOD1(sd_bus_slot_unref, sd_bus_slot*(sd_bus_slot *slot));
+    MOCK_METHOD3(sd_bus_unref_many, void(sd_bus_slot **slots, sd_bus_message **messages, std::size_t count));
 
     MOCK_METHOD1(sd_bus_new, int(sd_bus **ret));
     MOCK_METHOD1(sd_bus_start, int(sd_bus *bus));
 
     MOCK_METHOD2(sd_bus_process, int(sd_bus *bus, sd_bus_message **r));
+    MOCK_METHOD2(sd_bus_process_locally, int(sd_bus *bus, const std::function<int()>& callback));
+    MOCK_CONST_METHOD0(isProcessingInCurrentThread, bool());
     MOCK_METHOD1(sd_bus_get_current_message, sd_bus_message*(sd_bus *bus));
     MOCK_METHOD2(sd_bus_get_poll_data, int(sd_bus *bus, PollData* data));
     MOCK_METHOD3(sd_bus_get_n_queued, int(sd_bus *bus, uint64_t *read, uint64_t* write));
@@ -87,6 +102,9 @@ public:
     MOCK_METHOD1(sd_bus_close_unref, sd_bus *(sd_bus *bus));
 
     MOCK_METHOD2(sd_bus_message_set_destination, int(sd_bus_message *m, const char *destination));
+    MOCK_METHOD1(sd_bus_message_get_sender, const char*(sd_bus_message *m));
+    MOCK_METHOD2(sd_bus_message_set_sender, int(sd_bus_message *m, const char *sender));
+    MOCK_METHOD3(sd_bus_message_seal, int(sd_bus_message *m, uint64_t cookie, uint64_t timeout_usec));
 
     MOCK_METHOD3(sd_bus_query_sender_creds, int(sd_bus_message *, uint64_t, sd_bus_creds **));
     MOCK_METHOD1(sd_bus_creds_ref, sd_bus_creds*(sd_bus_creds *));
@@ -99,6 +117,10 @@ public:
     MOCK_METHOD2(sd_bus_creds_get_egid, int(sd_bus_creds *, gid_t *));
     MOCK_METHOD2(sd_bus_creds_get_supplementary_gids, int(sd_bus_creds *, const gid_t **));
     MOCK_METHOD2(sd_bus_creds_get_selinux_context, int(sd_bus_creds *, const char **));
+
+    MOCK_METHOD2(enableLockProfiling, void(bool, uint32_t));
+    MOCK_CONST_METHOD0(getLockProfiles, std::vector<sdbus::IConnection::Metrics::BusLockProfile>());
+    MOCK_METHOD0(resetLockProfiles, void());
 };
 
 #endif //SDBUS_CXX_SDBUS_MOCK_H
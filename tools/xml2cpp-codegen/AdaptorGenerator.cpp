@@ -42,6 +42,11 @@ using sdbuscpp::xml::Document;
 using sdbuscpp::xml::Node;
 using sdbuscpp::xml::Nodes;
 
+void AdaptorGenerator::setStaticVTables(bool staticVTables)
+{
+    staticVTables_ = staticVTables;
+}
+
 /**
  * Generate adaptor code - server glue
  */
@@ -82,7 +87,7 @@ std::string AdaptorGenerator::processInterface(Node& interface) const
     body << "class " << className << endl
             << "{" << endl
             << "public:" << endl
-            << tab << "static constexpr const char* INTERFACE_NAME = \"" << ifaceName << "\";" << endl << endl
+            << tab << "static constexpr const char* INTERFACE_NAME = sdbus::InterfaceNameView{\"" << ifaceName << "\"};" << endl << endl
             << "protected:" << endl
             << tab << className << "(sdbus::IObject& object)" << endl
             << tab << tab << ": m_object(object)" << endl
@@ -125,19 +130,44 @@ std::string AdaptorGenerator::processInterface(Node& interface) const
         annotationRegistration = str.str();
     }
 
+    // Static vtables take a getter for each property, so interfaces with write-only properties are registered the usual way
+    bool staticVTable = staticVTables_;
+    for (const auto& property : properties)
+    {
+        if (staticVTable && property->get("access") == "write")
+        {
+            std::cerr << "Node: " << ifaceName << ": "
+                      << "Static vtable not supported for interfaces with write-only properties! Option ignored..." << std::endl;
+            staticVTable = false;
+        }
+    }
+
     std::vector<std::string> methodRegistrations;
+    std::vector<std::string> methodHandlers;
     std::string methodDeclaration;
-    std::tie(methodRegistrations, methodDeclaration) = processMethods(methods);
+    std::tie(methodRegistrations, methodHandlers, methodDeclaration) = processMethods(methods, staticVTable);
 
     std::vector<std::string> signalRegistrations;
     std::string signalMethods;
     std::tie(signalRegistrations, signalMethods) = processSignals(signals);
 
     std::vector<std::string> propertyRegistrations;
+    std::vector<std::string> propertyHandlers;
     std::string propertyAccessorDeclaration;
-    std::tie(propertyRegistrations, propertyAccessorDeclaration) = processProperties(properties);
+    std::tie(propertyRegistrations, propertyHandlers, propertyAccessorDeclaration) = processProperties(properties, staticVTable);
 
-    auto vtableRegistration = createVTableRegistration(annotationRegistration, methodRegistrations, signalRegistrations, propertyRegistrations);
+    std::string vtableRegistration, staticVTableDefinition;
+    if (staticVTable)
+    {
+        auto handlers = methodHandlers;
+        handlers.insert(handlers.end(), propertyHandlers.begin(), propertyHandlers.end());
+        std::tie(vtableRegistration, staticVTableDefinition)
+            = createStaticVTableRegistration(annotationRegistration, methodRegistrations, signalRegistrations, propertyRegistrations, handlers);
+    }
+    else
+    {
+        vtableRegistration = createVTableRegistration(annotationRegistration, methodRegistrations, signalRegistrations, propertyRegistrations);
+    }
 
     body << tab << "void registerAdaptor()" << endl
          << tab << "{" << endl
@@ -159,6 +189,11 @@ std::string AdaptorGenerator::processInterface(Node& interface) const
         body << "private:" << endl << propertyAccessorDeclaration << endl;
     }
 
+    if (!staticVTableDefinition.empty())
+    {
+        body << "private:" << endl << staticVTableDefinition << endl;
+    }
+
     body << "private:" << endl
             << tab << "sdbus::IObject& m_object;" << endl
             << "};" << endl << endl
@@ -168,11 +203,12 @@ std::string AdaptorGenerator::processInterface(Node& interface) const
 }
 
 
-std::tuple<std::vector<std::string>, std::string> AdaptorGenerator::processMethods(const Nodes& methods) const
+std::tuple<std::vector<std::string>, std::vector<std::string>, std::string> AdaptorGenerator::processMethods(const Nodes& methods, bool staticVTable) const
 {
     std::ostringstream declarationSS;
 
     std::vector<std::string> methodRegistrations;
+    std::vector<std::string> methodHandlers;
 
     for (const auto& method : methods)
     {
@@ -183,6 +219,8 @@ std::tuple<std::vector<std::string>, std::string> AdaptorGenerator::processMetho
 
         auto annotations = getAnnotations(*method);
         bool async{false};
+        bool coroutine{false};
+        bool zeroCopy{false};
         std::string annotationRegistration;
         for (const auto& annotation : annotations)
         {
@@ -209,6 +247,16 @@ std::tuple<std::vector<std::string>, std::string> AdaptorGenerator::processMetho
                 if (annotationValue == "true")
                     annotationRegistration += ".markAsPrivileged()";
             }
+            else if (annotationName == "org.freedesktop.DBus.Method.ZeroCopy")
+            {
+                if (annotationValue == "true")
+                    zeroCopy = true;
+            }
+            else if (annotationName == "org.sdbuscpp.Method.Coroutine")
+            {
+                if (annotationValue == "true")
+                    coroutine = true;
+            }
             else if (annotationName != "org.freedesktop.DBus.Method.Timeout") // Whatever else...
             {
                 std::cerr << "Node: " << methodName << ": "
@@ -220,30 +268,90 @@ std::tuple<std::vector<std::string>, std::string> AdaptorGenerator::processMetho
         Nodes inArgs = args.select("direction" , "in");
         Nodes outArgs = args.select("direction" , "out");
 
-        std::string argStr, argTypeStr, argStringsStr, outArgStringsStr;
-        std::tie(argStr, argTypeStr, std::ignore, argStringsStr) = argsToNamesAndTypes(inArgs, async);
+        std::string argStr, argTypeStr, typeStr, argStringsStr, outArgStringsStr;
+        if (coroutine)
+        {
+            // Coroutine methods take precedence over Result-based async methods, they send the reply themselves once they complete
+            async = false;
+        }
+        if (zeroCopy && (async || coroutine))
+        {
+            std::cerr << "Node: " << methodName << ": "
+                      << "Option 'org.freedesktop.DBus.Method.ZeroCopy' not supported for async methods, whose arguments must outlive the call! Option ignored..." << std::endl;
+            zeroCopy = false;
+        }
+
+        // Coroutine parameters are taken by value, since they must outlive the first suspension of the coroutine
+        std::tie(argStr, argTypeStr, typeStr, argStringsStr) = argsToNamesAndTypes(inArgs, async || coroutine, zeroCopy);
         std::tie(std::ignore, std::ignore, std::ignore, outArgStringsStr) = argsToNamesAndTypes(outArgs);
 
         using namespace std::string_literals;
 
-        registrationSS << "sdbus::registerMethod(\""
-                << methodName << "\")"
-                << (!argStringsStr.empty() ? (".withInputParamNames(" + argStringsStr + ")") : "")
-                << (!outArgStringsStr.empty() ? (".withOutputParamNames(" + outArgStringsStr + ")") : "")
-                << ".implementedAs("
-                << "[this]("
-                << (async ? "sdbus::Result<" + outArgsToType(outArgs, true) + ">&& result" + (argTypeStr.empty() ? "" : ", ") : "")
-                << argTypeStr
-                << "){ " << (async ? "" : "return ") << "this->" << methodNameSafe << "("
-                << (async ? "std::move(result)"s + (argTypeStr.empty() ? "" : ", ") : "")
-                << argStr << "); })"
-                << annotationRegistration;
+        if (fastPath_ && !async && !coroutine)
+        {
+            // The vtable item is filled in directly, with a handler that deserializes input arguments in place
+            // and serializes results straight into the reply, bypassing the convenience builder chain
+            std::ostringstream inArgDefinitionSS, inArgDeserializationSS;
+            for (size_t i = 0; i < inArgs.size(); ++i)
+            {
+                auto argName = inArgs.at(i)->get("name");
+                auto argNameSafe = mangle_name(argName.empty() ? "arg" + std::to_string(i) : argName);
+                auto viewType = argToViewType(*inArgs.at(i), false, zeroCopy);
+                inArgDefinitionSS << (viewType.empty() ? argToType(*inArgs.at(i)) : viewType) << " " << argNameSafe << "; ";
+                inArgDeserializationSS << " >> " << argNameSafe;
+            }
+
+            std::ostringstream callbackSS;
+            callbackSS << "[this](sdbus::MethodCall call){ "
+                    << inArgDefinitionSS.str()
+                    << (inArgs.size() > 0 ? "call" + inArgDeserializationSS.str() + "; " : "")
+                    << (outArgs.size() > 0 ? "auto result = " : "") << "this->" << methodNameSafe << "(" << argStr << "); "
+                    << "auto reply = call.createReply(); "
+                    << (outArgs.size() > 0 ? "reply << result; " : "")
+                    << "reply.send(); }";
+
+            registrationSS << "sdbus::MethodVTableItem{sdbus::MethodName{\"" << methodName << "\"}"
+                    << ", sdbus::Signature{\"" << argsToSignature(inArgs) << "\"}, {" << argStringsStr << "}"
+                    << ", sdbus::Signature{\"" << argsToSignature(outArgs) << "\"}, {" << outArgStringsStr << "}"
+                    << ", " << (staticVTable ? "{}" : callbackSS.str()) << ", {}}"
+                    << annotationRegistration;
+
+            if (staticVTable)
+                methodHandlers.push_back("sdbus::VTableHandler{" + callbackSS.str() + "}");
+        }
+        else
+        {
+            std::ostringstream callbackSS;
+            callbackSS << "[this]("
+                    << (async ? "sdbus::Result<" + outArgsToType(outArgs, true) + ">&& result" + (argTypeStr.empty() ? "" : ", ") : "")
+                    << argTypeStr
+                    << "){ " << (async ? "" : "return ") << "this->" << methodNameSafe << "("
+                    << (async ? "std::move(result)"s + (argTypeStr.empty() ? "" : ", ") : "")
+                    << argStr << "); }";
+
+            // Static vtable layouts take the signatures from the type of the callback, which is provided by each object
+            std::ostringstream callbackTypeSS;
+            callbackTypeSS << (async ? "void" : coroutine ? "sdbus::Task<" + outArgsToType(outArgs, true) + ">" : outArgsToType(outArgs))
+                    << "("
+                    << (async ? "sdbus::Result<" + outArgsToType(outArgs, true) + ">&&" + (typeStr.empty() ? "" : ", ") : "")
+                    << typeStr << ")";
+
+            registrationSS << "sdbus::registerMethod(\""
+                    << methodName << "\")"
+                    << (!argStringsStr.empty() ? (".withInputParamNames(" + argStringsStr + ")") : "")
+                    << (!outArgStringsStr.empty() ? (".withOutputParamNames(" + outArgStringsStr + ")") : "")
+                    << (staticVTable ? ".withSignatureOf<" + callbackTypeSS.str() + ">()" : ".implementedAs(" + callbackSS.str() + ")")
+                    << annotationRegistration;
+
+            if (staticVTable)
+                methodHandlers.push_back("sdbus::implementMethod(" + callbackSS.str() + ")");
+        }
 
         methodRegistrations.push_back(registrationSS.str());
 
         declarationSS << tab
                 << "virtual "
-                << (async ? "void" : outArgsToType(outArgs))
+                << (async ? "void" : coroutine ? "sdbus::Task<" + outArgsToType(outArgs, true) + ">" : outArgsToType(outArgs))
                 << " " << methodNameSafe
                 << "("
                 << (async ? "sdbus::Result<" + outArgsToType(outArgs, true) + ">&& result" + (argTypeStr.empty() ? "" : ", ") : "")
@@ -251,7 +359,7 @@ std::tuple<std::vector<std::string>, std::string> AdaptorGenerator::processMetho
                 << ") = 0;" << endl;
     }
 
-    return std::make_tuple(methodRegistrations, declarationSS.str());
+    return std::make_tuple(methodRegistrations, methodHandlers, declarationSS.str());
 }
 
 
@@ -303,7 +411,7 @@ std::tuple<std::vector<std::string>, std::string> AdaptorGenerator::processSigna
 
         signalMethodSS << tab << "void emit" << nameWithCapFirstLetter << "(" << argTypeStr << ")" << endl
                 << tab << "{" << endl
-                << tab << tab << "m_object.emitSignal(\"" << name << "\")"
+                << tab << tab << "m_object.emitSignal(sdbus::SignalNameView{\"" << name << "\"})"
                         ".onInterface(INTERFACE_NAME)";
 
         if (!argStr.empty())
@@ -319,11 +427,12 @@ std::tuple<std::vector<std::string>, std::string> AdaptorGenerator::processSigna
 }
 
 
-std::tuple<std::vector<std::string>, std::string> AdaptorGenerator::processProperties(const Nodes& properties) const
+std::tuple<std::vector<std::string>, std::vector<std::string>, std::string> AdaptorGenerator::processProperties(const Nodes& properties, bool staticVTable) const
 {
     std::ostringstream declarationSS;
 
     std::vector<std::string> propertyRegistrations;
+    std::vector<std::string> propertyHandlers;
 
     for (const auto& property : properties)
     {
@@ -359,16 +468,28 @@ std::tuple<std::vector<std::string>, std::string> AdaptorGenerator::processPrope
         registrationSS << "sdbus::registerProperty(\""
                 << propertyName << "\")";
 
+        std::string getter, setter;
         if (propertyAccess == "read" || propertyAccess == "readwrite")
         {
-            registrationSS << ".withGetter([this](){ return this->" << propertyNameSafe << "(); })";
+            getter = "[this](){ return this->" + propertyNameSafe + "(); }";
         }
 
         if (propertyAccess == "readwrite" || propertyAccess == "write")
         {
-            registrationSS
-                << ".withSetter([this](" << propertyTypeArg << ")"
-                   "{ this->" << propertyNameSafe << "(" << propertyArg << "); })";
+            setter = "[this](" + propertyTypeArg + "){ this->" + propertyNameSafe + "(" + propertyArg + "); }";
+        }
+
+        if (staticVTable)
+        {
+            registrationSS << ".withValueType<" << propertyType << ">()" << (!setter.empty() ? ".markAsWritable()" : "");
+            propertyHandlers.push_back("sdbus::implementProperty(" + getter + (!setter.empty() ? ", " + setter : "") + ")");
+        }
+        else
+        {
+            if (!getter.empty())
+                registrationSS << ".withGetter(" << getter << ")";
+            if (!setter.empty())
+                registrationSS << ".withSetter(" << setter << ")";
         }
 
         registrationSS << annotationRegistration;
@@ -381,7 +502,7 @@ std::tuple<std::vector<std::string>, std::string> AdaptorGenerator::processPrope
             declarationSS << tab << "virtual void " << propertyNameSafe << "(" << propertyTypeArg << ") = 0;" << endl;
     }
 
-    return std::make_tuple(propertyRegistrations, declarationSS.str());
+    return std::make_tuple(propertyRegistrations, propertyHandlers, declarationSS.str());
 }
 
 std::string AdaptorGenerator::createVTableRegistration(const std::string& annotationRegistration,
@@ -415,6 +536,55 @@ std::string AdaptorGenerator::createVTableRegistration(const std::string& annota
     return registrationSS.str();
 }
 
+std::tuple<std::string, std::string> AdaptorGenerator::createStaticVTableRegistration(const std::string& annotationRegistration,
+                                                                                    const std::vector<std::string>& methodRegistrations,
+                                                                                    const std::vector<std::string>& signalRegistrations,
+                                                                                    const std::vector<std::string>& propertyRegistrations,
+                                                                                    const std::vector<std::string>& handlers) const
+{
+    std::vector<std::string> allRegistrations;
+    if (!annotationRegistration.empty())
+        allRegistrations.push_back(annotationRegistration);
+    allRegistrations.insert(allRegistrations.end(), methodRegistrations.begin(), methodRegistrations.end());
+    allRegistrations.insert(allRegistrations.end(), signalRegistrations.begin(), signalRegistrations.end());
+    allRegistrations.insert(allRegistrations.end(), propertyRegistrations.begin(), propertyRegistrations.end());
+
+    // The layout is prepared once, upon registration of the first adaptor instance, and shared by all instances
+    std::ostringstream definitionSS;
+    definitionSS << tab << "static const sdbus::StaticVTable& staticVTable()" << endl
+                 << tab << "{" << endl
+                 << tab << tab << "static const sdbus::StaticVTable vtable{ sdbus::InterfaceName{INTERFACE_NAME}" << endl;
+    if (allRegistrations.empty())
+    {
+        definitionSS << tab << tab << "                                       , {} };" << endl;
+    }
+    else
+    {
+        definitionSS << tab << tab << "                                       , { " << allRegistrations[0] << endl;
+        for (size_t i = 1; i < allRegistrations.size(); ++i)
+            definitionSS << tab << tab << "                                         , " << allRegistrations[i] << endl;
+        definitionSS << tab << tab << "                                         } };" << endl;
+    }
+    definitionSS << tab << tab << "return vtable;" << endl
+                 << tab << "}" << endl;
+
+    std::ostringstream registrationSS;
+    if (handlers.empty())
+    {
+        registrationSS << tab << tab << "m_object.addVTable(staticVTable(), {});";
+    }
+    else
+    {
+        registrationSS     << tab << tab << "m_object.addVTable( staticVTable()" << endl;
+        registrationSS     << tab << tab << "                  , { " << handlers[0] << endl;
+        for (size_t i = 1; i < handlers.size(); ++i)
+            registrationSS << tab << tab << "                    , " << handlers[i] << endl;
+        registrationSS     << tab << tab << "                    } );";
+    }
+
+    return std::make_tuple(registrationSS.str(), definitionSS.str());
+}
+
 std::map<std::string, std::string> AdaptorGenerator::getAnnotations( sdbuscpp::xml::Node& node) const
 {
     std::map<std::string, std::string> result;
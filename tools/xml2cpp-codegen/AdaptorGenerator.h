@@ -37,6 +37,13 @@
 
 class AdaptorGenerator : public BaseGenerator
 {
+public:
+    /**
+     * Generate adaptors registering a static vtable layout, shared by all their instances, along with their handlers
+     * @param staticVTables
+     */
+    void setStaticVTables(bool staticVTables);
+
 protected:
     /**
      * Transform xml to adaptor code
@@ -57,9 +64,10 @@ private:
     /**
      * Generate source code for methods
      * @param methods
-     * @return tuple: registration of methods, declaration of abstract methods
+     * @param staticVTable whether methods are registered as static vtable layout items with separate handlers
+     * @return tuple: registration of methods, handlers of methods (static vtable only), declaration of abstract methods
      */
-    std::tuple<std::vector<std::string>, std::string> processMethods(const sdbuscpp::xml::Nodes& methods) const;
+    std::tuple<std::vector<std::string>, std::vector<std::string>, std::string> processMethods(const sdbuscpp::xml::Nodes& methods, bool staticVTable) const;
 
     /**
      * Generate source code for signals
@@ -71,15 +79,26 @@ private:
     /**
      * Generate source code for properties
      * @param properties
-     * @return tuple: registration of properties, declaration of property accessor virtual methods
+     * @param staticVTable whether properties are registered as static vtable layout items with separate handlers
+     * @return tuple: registration of properties, handlers of properties (static vtable only), declaration of property accessor virtual methods
      */
-    std::tuple<std::vector<std::string>, std::string> processProperties(const sdbuscpp::xml::Nodes& properties) const;
+    std::tuple<std::vector<std::string>, std::vector<std::string>, std::string> processProperties(const sdbuscpp::xml::Nodes& properties, bool staticVTable) const;
 
     std::string createVTableRegistration(const std::string& annotationRegistration,
                                          const std::vector<std::string>& methodRegistrations,
                                          const std::vector<std::string>& signalRegistrations,
                                          const std::vector<std::string>& propertyRegistrations) const;
 
+    /**
+     * Generate definition of the static vtable of the interface and registration of adaptor's handlers for it
+     * @return tuple: registration of handlers, definition of the static vtable accessor
+     */
+    std::tuple<std::string, std::string> createStaticVTableRegistration(const std::string& annotationRegistration,
+                                                                        const std::vector<std::string>& methodRegistrations,
+                                                                        const std::vector<std::string>& signalRegistrations,
+                                                                        const std::vector<std::string>& propertyRegistrations,
+                                                                        const std::vector<std::string>& handlers) const;
+
     /**
      * Get annotations listed for a given node
      * @param node
@@ -93,6 +112,8 @@ private:
      * @return flag
      */
     std::string propertyAnnotationToFlag(const std::string& annotationValue) const;
+
+    bool staticVTables_{false};
 };
 
 
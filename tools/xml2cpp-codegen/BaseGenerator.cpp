@@ -49,6 +49,11 @@ int BaseGenerator::transformXmlToFile(const Document& doc, const char* filename)
     return transformXmlToFileImpl(doc, filename);
 }
 
+void BaseGenerator::setFastPath(bool fastPath)
+{
+    fastPath_ = fastPath;
+}
+
 
 int BaseGenerator::writeToFile(const char* filename, const std::string& data) const
 {
@@ -106,7 +111,7 @@ std::tuple<unsigned, std::string> BaseGenerator::generateNamespaces(const std::s
 }
 
 
-std::tuple<std::string, std::string, std::string, std::string> BaseGenerator::argsToNamesAndTypes(const Nodes& args, bool async) const
+std::tuple<std::string, std::string, std::string, std::string> BaseGenerator::argsToNamesAndTypes(const Nodes& args, bool async, bool zeroCopy) const
 {
     std::ostringstream argSS, argTypeSS, typeSS, argStringsSS;
 
@@ -127,9 +132,17 @@ std::tuple<std::string, std::string, std::string, std::string> BaseGenerator::ar
             argName = "arg" + std::to_string(i);
         }
         auto argNameSafe = mangle_name(argName);
-        auto type = signature_to_type(arg->get("type"));
+        auto type = argToType(*arg);
         argStringsSS << "\"" << argName << "\"";
-        if (!async)
+        auto viewType = argToViewType(*arg, async, zeroCopy);
+        if (!viewType.empty())
+        {
+            // Views are cheap to copy, and point straight into the message being processed
+            type = viewType;
+            argSS << argNameSafe;
+            argTypeSS << type << " " << argNameSafe;
+        }
+        else if (!async)
         {
             argSS << argNameSafe;
             argTypeSS << "const " << type << "& " << argNameSafe;
@@ -162,7 +175,7 @@ std::string BaseGenerator::outArgsToType(const Nodes& args, bool bareList) const
     else if (args.size() == 1)
     {
         const auto& arg = *args.begin();
-        retTypeSS << signature_to_type(arg->get("type"));
+        retTypeSS << argToType(*arg);
     }
     else if (args.size() >= 2)
     {
@@ -173,7 +186,7 @@ std::string BaseGenerator::outArgsToType(const Nodes& args, bool bareList) const
         for (const auto& arg : args)
         {
             if (firstArg) firstArg = false; else retTypeSS << ", ";
-            retTypeSS << signature_to_type(arg->get("type"));
+            retTypeSS << argToType(*arg);
         }
 
         if (!bareList)
@@ -182,3 +195,95 @@ std::string BaseGenerator::outArgsToType(const Nodes& args, bool bareList) const
 
     return retTypeSS.str();
 }
+
+/**
+ *
+ */
+std::string BaseGenerator::argToType(Node& arg) const
+{
+    const auto signature = arg.get("type");
+
+    // Large payloads can be passed in sealed shared memory instead of being copied through the bus
+    if (signature == "(ht)")
+    {
+        for (const auto& annotation : arg["annotation"])
+        {
+            if (annotation->get("name") == "org.sdbuscpp.SharedBuffer" && annotation->get("value") == "true")
+                return "sdbus::SharedBuffer";
+        }
+    }
+
+    // Large byte blocks can be compressed for slow links, e.g. remote bus connections
+    if (signature == "(uyay)")
+    {
+        for (const auto& annotation : arg["annotation"])
+        {
+            if (annotation->get("name") == "org.sdbuscpp.CompressedBytes" && annotation->get("value") == "true")
+                return "sdbus::CompressedBytes";
+        }
+    }
+
+    // Fds passed around a lot can be shared by copies instead of being duplicated by each of them
+    if (signature == "h")
+    {
+        for (const auto& annotation : arg["annotation"])
+        {
+            if (annotation->get("name") == "org.sdbuscpp.SharedUnixFd" && annotation->get("value") == "true")
+                return "sdbus::SharedUnixFd";
+        }
+    }
+
+    // High-rate batches of rows can be passed column by column, each column in a single step
+    if (isColumnsArg(arg))
+    {
+        if (auto type = signature_to_columns_type(signature); !type.empty())
+            return type;
+    }
+
+    return signature_to_type(signature);
+}
+
+bool BaseGenerator::isColumnsArg(Node& arg) const
+{
+    for (const auto& annotation : arg["annotation"])
+    {
+        if (annotation->get("name") == "org.sdbuscpp.Columns" && annotation->get("value") == "true")
+            return true;
+    }
+
+    return false;
+}
+
+std::string BaseGenerator::argToViewType(Node& arg, bool async, bool zeroCopy) const
+{
+    if (async)
+        return {};
+
+    bool view = zeroCopy;
+    if (!view && arg.get("direction") == "in")
+    {
+        for (const auto& annotation : arg["annotation"])
+        {
+            if (annotation->get("name") == "org.sdbuscpp.Arg.View" && annotation->get("value") == "true")
+                view = true;
+        }
+    }
+
+    if (!view)
+        return {};
+
+    if (isColumnsArg(arg))
+        return signature_to_columns_type(arg.get("type"), true);
+
+    return signature_to_view_type(arg.get("type"));
+}
+
+std::string BaseGenerator::argsToSignature(const Nodes& args) const
+{
+    std::string signature;
+
+    for (const auto& arg : args)
+        signature += arg->get("type");
+
+    return signature;
+}
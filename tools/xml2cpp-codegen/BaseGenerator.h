@@ -40,6 +40,12 @@ class BaseGenerator
 public:
     int transformXmlToFile(const sdbuscpp::xml::Document& doc, const char* filename) const;
 
+    /**
+     * Generate direct-serialization code for synchronous methods instead of the convenience builder chains
+     * @param fastPath
+     */
+    void setFastPath(bool fastPath);
+
 protected:
     enum class StubType
     {
@@ -86,9 +92,12 @@ protected:
     /**
      * Transform arguments into source code
      * @param args
+     * @param async whether arguments are taken by value to be moved
+     * @param zeroCopy whether string and trivial array arguments are taken as views into the message
+     *                 (in-args annotated with org.sdbuscpp.Arg.View are taken as views unless async)
      * @return tuple: argument names, argument types and names, argument types
      */
-    std::tuple<std::string, std::string, std::string, std::string> argsToNamesAndTypes(const sdbuscpp::xml::Nodes& args, bool async = false) const;
+    std::tuple<std::string, std::string, std::string, std::string> argsToNamesAndTypes(const sdbuscpp::xml::Nodes& args, bool async = false, bool zeroCopy = false) const;
 
     /**
      * Output arguments to return type
@@ -97,6 +106,40 @@ protected:
      */
     std::string outArgsToType(const sdbuscpp::xml::Nodes& args, bool bareList = false) const;
 
+    /**
+     * C++ type of an argument, honoring the org.sdbuscpp.SharedBuffer annotation of (ht) arguments,
+     * the org.sdbuscpp.CompressedBytes annotation of (uyay) arguments and the org.sdbuscpp.SharedUnixFd
+     * annotation of h arguments, and the org.sdbuscpp.Columns annotation of struct of arrays arguments like (atadad)
+     * @param arg
+     * @return argument type
+     */
+    std::string argToType(sdbuscpp::xml::Node& arg) const;
+
+    /**
+     * Whether the argument is annotated with org.sdbuscpp.Columns, i.e. passed as a column-oriented batch of rows
+     * @param arg
+     * @return true if the argument is passed as sdbus::Columns
+     */
+    bool isColumnsArg(sdbuscpp::xml::Node& arg) const;
+
+    /**
+     * View type of an argument taken as a view into the message, honoring the org.sdbuscpp.Arg.View annotation of in-args
+     * @param arg
+     * @param async whether the argument is taken by value to be moved, in which case it can't be a view
+     * @param zeroCopy whether all string and trivial array arguments are taken as views
+     * @return view type, or empty string if the argument is not taken as a view
+     */
+    std::string argToViewType(sdbuscpp::xml::Node& arg, bool async, bool zeroCopy) const;
+
+    /**
+     * D-Bus signature of the arguments, i.e. their signatures concatenated
+     * @param args
+     * @return signature
+     */
+    std::string argsToSignature(const sdbuscpp::xml::Nodes& args) const;
+
+    bool fastPath_{false};
+
 };
 
 
@@ -81,10 +81,19 @@ std::string ProxyGenerator::processInterface(Node& interface) const
     body << "class " << className << endl
             << "{" << endl
             << "public:" << endl
-            << tab << "static constexpr const char* INTERFACE_NAME = \"" << ifaceName << "\";" << endl << endl
+            << tab << "static constexpr const char* INTERFACE_NAME = sdbus::InterfaceNameView{\"" << ifaceName << "\"};" << endl << endl
             << "protected:" << endl
             << tab << className << "(sdbus::IProxy& proxy)" << endl
-            << tab << tab << ": m_proxy(proxy)" << endl
+            << tab << tab << ": m_proxy(proxy)" << endl;
+
+    Nodes methods = interface["method"];
+    Nodes signals = interface["signal"];
+    Nodes properties = interface["property"];
+
+    std::string methodDefinitions, asyncDeclarationsMethods, preparedCallInitializations, preparedCallDeclarations;
+    std::tie(methodDefinitions, asyncDeclarationsMethods, preparedCallInitializations, preparedCallDeclarations) = processMethods(methods);
+
+    body << preparedCallInitializations
             << tab << "{" << endl
             << tab << "}" << endl << endl;
 
@@ -96,10 +105,6 @@ std::string ProxyGenerator::processInterface(Node& interface) const
 
     body << tab << "~" << className << "() = default;" << endl << endl;
 
-    Nodes methods = interface["method"];
-    Nodes signals = interface["signal"];
-    Nodes properties = interface["property"];
-
     std::string registration, declaration;
     std::tie(registration, declaration) = processSignals(signals);
 
@@ -111,8 +116,6 @@ std::string ProxyGenerator::processInterface(Node& interface) const
     if (!declaration.empty())
         body << declaration << endl;
 
-    std::string methodDefinitions, asyncDeclarationsMethods;
-    std::tie(methodDefinitions, asyncDeclarationsMethods) = processMethods(methods);
     std::string propertyDefinitions, asyncDeclarationsProperties;
     std::tie(propertyDefinitions, asyncDeclarationsProperties) = processProperties(properties);
 
@@ -137,17 +140,18 @@ std::string ProxyGenerator::processInterface(Node& interface) const
 
     body << "private:" << endl
             << tab << "sdbus::IProxy& m_proxy;" << endl
+            << preparedCallDeclarations
             << "};" << endl << endl
             << std::string(namespacesCount, '}') << " // namespaces" << endl << endl;
 
     return body.str();
 }
 
-std::tuple<std::string, std::string> ProxyGenerator::processMethods(const Nodes& methods) const
+std::tuple<std::string, std::string, std::string, std::string> ProxyGenerator::processMethods(const Nodes& methods) const
 {
     const std::regex patternTimeout{R"(^(\d+)(min|s|ms|us)?$)"};
 
-    std::ostringstream definitionSS, asyncDeclarationSS;
+    std::ostringstream definitionSS, asyncDeclarationSS, preparedCallInitializationSS, preparedCallDeclarationSS;
 
     for (const auto& method : methods)
     {
@@ -160,8 +164,11 @@ std::tuple<std::string, std::string> ProxyGenerator::processMethods(const Nodes&
         bool dontExpectReply{false};
         bool async{false};
         bool future{false}; // Async methods implemented by means of either std::future or callbacks
+        bool coroutine{false}; // Async methods returning an awaitable, taking precedence over the above
         std::string timeoutValue;
         std::smatch smTimeout;
+        std::string cacheValue; // "true" for results cached until the service owner changes, or a time-to-live
+        std::smatch smCacheTtl;
 
         Nodes annotations = (*method)["annotation"];
         for (const auto& annotation : annotations)
@@ -180,9 +187,13 @@ std::tuple<std::string, std::string> ProxyGenerator::processMethods(const Nodes&
                     future = false;
                 else if (annotationName == "org.freedesktop.DBus.Method.Async.ClientImpl" && (annotationValue == "future" || annotationValue == "std::future"))
                     future = true;
+                else if (annotationName == "org.sdbuscpp.Method.Coroutine" && annotationValue == "true")
+                    coroutine = true;
             }
             if (annotationName == "org.freedesktop.DBus.Method.Timeout")
                 timeoutValue = annotationValue;
+            else if (annotationName == "org.sdbuscpp.Method.Cacheable" && annotationValue != "false")
+                cacheValue = annotationValue;
         }
         if (dontExpectReply && outArgs.size() > 0)
         {
@@ -190,6 +201,16 @@ std::tuple<std::string, std::string> ProxyGenerator::processMethods(const Nodes&
             std::cerr << "Option 'org.freedesktop.DBus.Method.NoReply' not allowed for methods with 'out' variables! Option ignored..." << std::endl;
             dontExpectReply = false;
         }
+        if (coroutine && dontExpectReply)
+        {
+            std::cerr << "Function: " << name << ": ";
+            std::cerr << "Option 'org.sdbuscpp.Method.Coroutine' not allowed for 'NoReply' methods! Option ignored..." << std::endl;
+            coroutine = false;
+        }
+        if (coroutine)
+        {
+            async = true;
+        }
         if (!timeoutValue.empty() && dontExpectReply)
         {
             std::cerr << "Function: " << name << ": ";
@@ -204,6 +225,20 @@ std::tuple<std::string, std::string> ProxyGenerator::processMethods(const Nodes&
             timeoutValue.clear();
         }
 
+        if (!cacheValue.empty() && (async || outArgs.size() == 0))
+        {
+            std::cerr << "Function: " << name << ": ";
+            std::cerr << "Option 'org.sdbuscpp.Method.Cacheable' allowed only for synchronous methods with 'out' variables! Option ignored..." << std::endl;
+            cacheValue.clear();
+        }
+
+        if (!cacheValue.empty() && cacheValue != "true" && !std::regex_match(cacheValue, smCacheTtl, patternTimeout))
+        {
+            std::cerr << "Function: " << name << ": ";
+            std::cerr << "Option 'org.sdbuscpp.Method.Cacheable' has unsupported time-to-live value! Option ignored..." << std::endl;
+            cacheValue.clear();
+        }
+
         auto retType = outArgsToType(outArgs);
         auto retTypeBare = outArgsToType(outArgs, true);
         std::string inArgStr, inArgTypeStr;
@@ -211,22 +246,67 @@ std::tuple<std::string, std::string> ProxyGenerator::processMethods(const Nodes&
         std::string outArgStr, outArgTypeStr;
         std::tie(outArgStr, outArgTypeStr, std::ignore, std::ignore) = argsToNamesAndTypes(outArgs);
 
-        const std::string realRetType = (async && !dontExpectReply ? (future ? "std::future<" + retType + ">" : "sdbus::PendingAsyncCall") : async ? "void" : retType);
+        const std::string realRetType = (async && !dontExpectReply ? (coroutine ? "sdbus::AsyncCallAwaitable<" + retTypeBare + ">" : future ? "std::future<" + retType + ">" : "sdbus::PendingAsyncCall") : async ? "void" : retType);
         definitionSS << tab << realRetType << " " << nameSafe << "(" << inArgTypeStr << ")" << endl
                 << tab << "{" << endl;
 
-        if (!timeoutValue.empty())
+        if (!timeoutValue.empty() || (!cacheValue.empty() && cacheValue != "true"))
         {
             definitionSS << tab << tab << "using namespace std::chrono_literals;" << endl;
         }
 
+        // Calls with cached results go through the convenience API, which serves them from the proxy's result cache
+        if (fastPath_ && !async && cacheValue.empty())
+        {
+            // Synchronous calls work directly on a method call message created from a prepared method call,
+            // bypassing the convenience builder chain, with arguments and results (de)serialized in place
+            const auto preparedCallName = "m_" + nameSafe + "Call";
+            preparedCallInitializationSS << tab << tab << ", " << preparedCallName << "(proxy.prepareMethodCall("
+                                         << "sdbus::InterfaceName{INTERFACE_NAME}, sdbus::MethodName{\"" << name << "\"}))" << endl;
+            preparedCallDeclarationSS << tab << "sdbus::PreparedMethodCall " << preparedCallName << ";" << endl;
+
+            definitionSS << tab << tab << "auto method = " << preparedCallName << ".createMethodCall();" << endl;
+
+            if (inArgs.size() > 0)
+            {
+                definitionSS << tab << tab << "method << " << std::regex_replace(inArgStr, std::regex{", "}, " << ") << ";" << endl;
+            }
+
+            if (dontExpectReply)
+            {
+                definitionSS << tab << tab << "method.dontExpectReply();" << endl
+                             << tab << tab << "m_proxy.callMethod(method);" << endl;
+            }
+            else
+            {
+                definitionSS << tab << tab << (outArgs.size() > 0 ? "auto reply = " : "") << "m_proxy.callMethod(method";
+                if (!timeoutValue.empty())
+                {
+                    const auto val = smTimeout.str(1);
+                    const auto unit = smTimeout.str(2);
+                    definitionSS << ", " << val << (unit.empty() ? "us" : unit);
+                }
+                definitionSS << ");" << endl;
+
+                if (outArgs.size() > 0)
+                {
+                    definitionSS << tab << tab << retType << " result;" << endl
+                                 << tab << tab << "reply >> result;" << endl
+                                 << tab << tab << "return result;" << endl;
+                }
+            }
+
+            definitionSS << tab << "}" << endl << endl;
+            continue;
+        }
+
         if (outArgs.size() > 0 && !async)
         {
             definitionSS << tab << tab << retType << " result;" << endl;
         }
 
         definitionSS << tab << tab << (async && !dontExpectReply ? "return " : "")
-                     << "m_proxy.callMethod" << (async ? "Async" : "") << "(\"" << name << "\").onInterface(INTERFACE_NAME)";
+                     << "m_proxy.callMethod" << (async ? "Async" : "") << "(sdbus::MethodNameView{\"" << name << "\"}).onInterface(INTERFACE_NAME)";
 
         if (!timeoutValue.empty())
         {
@@ -235,6 +315,17 @@ std::tuple<std::string, std::string> ProxyGenerator::processMethods(const Nodes&
             definitionSS << ".withTimeout(" << val << (unit.empty() ? "us" : unit) << ")";
         }
 
+        if (cacheValue == "true")
+        {
+            definitionSS << ".cacheResults()";
+        }
+        else if (!cacheValue.empty())
+        {
+            const auto val = smCacheTtl.str(1);
+            const auto unit = smCacheTtl.str(2);
+            definitionSS << ".cacheResultsFor(" << val << (unit.empty() ? "us" : unit) << ")";
+        }
+
         if (inArgs.size() > 0)
         {
             definitionSS << ".withArguments(" << inArgStr << ")";
@@ -245,7 +336,11 @@ std::tuple<std::string, std::string> ProxyGenerator::processMethods(const Nodes&
             auto nameBigFirst = name;
             nameBigFirst[0] = islower(nameBigFirst[0]) ? nameBigFirst[0] + 'A' - 'a' : nameBigFirst[0];
 
-            if (future) // Async methods implemented through future
+            if (coroutine) // Async methods implemented through awaitable
+            {
+                definitionSS << ".getResultAsAwaitable<" << retTypeBare << ">()";
+            }
+            else if (future) // Async methods implemented through future
             {
                 definitionSS << ".getResultAsFuture<" << retTypeBare << ">()";
             }
@@ -271,7 +366,7 @@ std::tuple<std::string, std::string> ProxyGenerator::processMethods(const Nodes&
         definitionSS << ";" << endl << tab << "}" << endl << endl;
     }
 
-    return std::make_tuple(definitionSS.str(), asyncDeclarationSS.str());
+    return std::make_tuple(definitionSS.str(), asyncDeclarationSS.str(), preparedCallInitializationSS.str(), preparedCallDeclarationSS.str());
 }
 
 std::tuple<std::string, std::string> ProxyGenerator::processSignals(const Nodes& signals) const
@@ -290,7 +385,7 @@ std::tuple<std::string, std::string> ProxyGenerator::processSignals(const Nodes&
         std::tie(argStr, argTypeStr, std::ignore, std::ignore) = argsToNamesAndTypes(args);
 
         registrationSS << tab << tab << "m_proxy"
-                ".uponSignal(\"" << name << "\")"
+                ".uponSignal(sdbus::SignalNameView{\"" << name << "\"})"
                 ".onInterface(INTERFACE_NAME)"
                 ".call([this](" << argTypeStr << ")"
                 "{ this->on" << nameBigFirst << "(" << argStr << "); });" << endl;
@@ -346,7 +441,7 @@ std::tuple<std::string, std::string> ProxyGenerator::processProperties(const Nod
 
             propertySS << tab << realRetType << " " << propertyNameSafe << "()" << endl
                     << tab << "{" << endl;
-            propertySS << tab << tab << "return m_proxy.getProperty" << (asyncGet ? "Async" : "") << "(\"" << propertyName << "\")"
+            propertySS << tab << tab << "return m_proxy.getProperty" << (asyncGet ? "Async" : "") << "(sdbus::PropertyNameView{\"" << propertyName << "\"})"
                             ".onInterface(INTERFACE_NAME)";
             if (!asyncGet)
             {
@@ -383,7 +478,7 @@ std::tuple<std::string, std::string> ProxyGenerator::processProperties(const Nod
             propertySS << tab << realRetType << " " << propertyNameSafe << "(" << propertyTypeArg << ")" << endl
                        << tab << "{" << endl;
             propertySS << tab << tab << (asyncSet ? "return " : "") << "m_proxy.setProperty" << (asyncSet ? "Async" : "")
-                       << "(\"" << propertyName << "\")"
+                       << "(sdbus::PropertyNameView{\"" << propertyName << "\"})"
                             ".onInterface(INTERFACE_NAME)"
                             ".toValue(" << propertyArg << ")";
 
@@ -57,9 +57,10 @@ private:
     /**
      * Generate method calls
      * @param methods
-     * @return tuple: definition of methods, declaration of virtual async reply handlers
+     * @return tuple: definition of methods, declaration of virtual async reply handlers,
+     *         initialization and declaration of prepared method calls (fast path only)
      */
-    std::tuple<std::string, std::string> processMethods(const sdbuscpp::xml::Nodes& methods) const;
+    std::tuple<std::string, std::string, std::string, std::string> processMethods(const sdbuscpp::xml::Nodes& methods) const;
 
     /**
      * Generate code for handling signals
@@ -153,6 +153,37 @@ std::string signature_to_type(const std::string& signature)
     return type;
 }
 
+std::string signature_to_view_type(const std::string& signature)
+{
+    if (signature == "s")
+        return "std::string_view";
+
+    // Arrays of fixed-size D-Bus types, except bool, are laid out contiguously in the message
+    if (signature.length() == 2 && signature[0] == 'a' && std::string{"ynqiuxtd"}.find(signature[1]) != std::string::npos)
+        return std::string{"std::span<const "} + atomic_type_to_string(signature[1]) + ">";
+
+    return {};
+}
+
+std::string signature_to_columns_type(const std::string& signature, bool view)
+{
+    if (signature.length() < 4 || signature.length() % 2 != 0 || signature.front() != '(' || signature.back() != ')')
+        return {};
+
+    std::string type = view ? "sdbus::ColumnsView<" : "sdbus::Columns<";
+    for (std::size_t i = 1; i + 1 < signature.length(); i += 2)
+    {
+        // Each column is an array of a fixed-size D-Bus type except bool
+        if (signature[i] != 'a' || std::string{"ynqiuxtd"}.find(signature[i + 1]) == std::string::npos)
+            return {};
+        if (i > 1)
+            type += ", ";
+        type += atomic_type_to_string(signature[i + 1]);
+    }
+
+    return type + ">";
+}
+
 std::string mangle_name(const std::string& name)
 {
     if (reserved_names.find(name) != reserved_names.end())
@@ -15,6 +15,13 @@ std::string stub_name(const std::string& name);
 
 std::string signature_to_type(const std::string& signature);
 
+// Returns a view type (std::string_view, std::span<const T>) for a string or an array of trivial type signature, empty string otherwise
+std::string signature_to_view_type(const std::string& signature);
+
+// Returns a column-oriented batch type (sdbus::Columns, or sdbus::ColumnsView if view) for a struct of arrays
+// of trivial types signature, e.g. (atadad), empty string otherwise
+std::string signature_to_columns_type(const std::string& signature, bool view = false);
+
 std::string underscorize(const std::string& str);
 
 constexpr const char* getHeaderComment() noexcept { return "\n/*\n * This file was automatically generated by sdbus-c++-xml2cpp; DO NOT EDIT!\n */\n\n"; }
@@ -49,6 +49,10 @@ void usage(std::ostream& output, const char* programName)
             "Available options:" << endl <<
             "      --proxy=FILE     Generate header file FILE with proxy class (client)" << endl <<
             "      --adaptor=FILE   Generate header file FILE with stub class (server)" << endl <<
+            "      --fast-path      Generate synchronous methods that (de)serialize arguments" << endl <<
+            "                       directly, bypassing the convenience builder chains" << endl <<
+            "      --static-vtables Generate adaptors registering a vtable layout prepared once" << endl <<
+            "                       for all their instances, along with their handlers" << endl <<
             "  -h, --help           " << endl <<
             "      --verbose        Explain what is being done" << endl <<
             "  -v, --version        Prints out sdbus-c++ version used by the tool" << endl <<
@@ -77,6 +81,8 @@ int main(int argc, char **argv)
     const char* adaptor = nullptr;
     const char* xmlFile = nullptr;
     bool verbose = false;
+    bool fastPath = false;
+    bool staticVTables = false;
 
     while (argc > 0)
     {
@@ -114,6 +120,14 @@ int main(int argc, char **argv)
         {
             verbose = true;
         }
+        else if (!strcmp(*argv, "--fast-path"))
+        {
+            fastPath = true;
+        }
+        else if (!strcmp(*argv, "--static-vtables"))
+        {
+            staticVTables = true;
+        }
         else if (**argv == '-')
         {
             std::cerr << "Unknown option " << *argv << endl;
@@ -192,6 +206,7 @@ int main(int argc, char **argv)
             std::cerr << "Generating proxy header " << proxy << endl;
         }
         ProxyGenerator pg;
+        pg.setFastPath(fastPath);
         if(pg.transformXmlToFile(doc, proxy)) {
             std::cerr << "Failed to generate proxy header" << endl;
             return 1;
@@ -205,6 +220,8 @@ int main(int argc, char **argv)
             std::cerr << "Generating adaptor header " << adaptor << endl;
         }
         AdaptorGenerator ag;
+        ag.setFastPath(fastPath);
+        ag.setStaticVTables(staticVTables);
         if(ag.transformXmlToFile(doc, adaptor)) {
             std::cerr << "Failed to generate adaptor header" << endl;
             return 1;